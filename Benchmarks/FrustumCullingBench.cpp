@@ -0,0 +1,198 @@
+/**
+ * @file FrustumCullingBench.cpp
+ * @brief Microbenchmark of the batched frustum culling (FrustumCulling.h) against its one-lane path and the per-box test.
+ * @details Random boxes around a camera are culled by CullAABBs (widest lanes, with and without a CullingCache),
+ * CullAABBsScalar, PerBoxCull (a copy of Frustum::IntersectsAABB on Plane::DistanceToPoint) and CullAABBs split in
+ * ranges over the ThreadPool, as SimpleSpatialPartition::Query does for large scenes. Every mask must be the same bit
+ * for bit : the kernel uses the same multiplies and adds as Plane::DistanceToPoint.
+ * The process fails when they disagree, so ctest runs it as a check too.
+ * Usage : FrustumCullingBench [boxes] [iterations]
+ * @note built without floating point contraction (see CMakeLists.txt) : a fused multiply add in one path only
+ * would break the exact comparison of the boxes touching a plane.
+ * @version 0.1
+ * @date 2025-12-14
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+#include "PulseEngine/core/Math/Frustum/FrustumCulling.h"
+#include "PulseEngine/core/Threading/ThreadPool.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+using namespace PulseEngine;
+using namespace PulseEngine::Culling;
+
+namespace
+{
+    // bounds per ParallelFor job, a multiple of 32 : same as SimpleSpatial.cpp
+    constexpr std::size_t BOUNDS_PER_CHUNK = 8192;
+
+    /**
+     * @brief Planes of a perspective camera at the origin turned by yaw degrees around Y, inside is positive.
+     * @details left, right, top, bottom, near, far as Frustum stores them. Written out instead of extracted from a
+     * matrix : Frustum is a PulseObject and would pull the reflection in.
+     */
+    CullingPlanes CameraPlanes(float yawDegrees)
+    {
+        constexpr float PI = 3.14159265f;
+        const float halfY = 30.0f * PI / 180.0f;
+        const float halfX = std::atan(std::tan(halfY) * 16.0f / 9.0f);
+        const float nearDistance = 0.1f, farDistance = 500.0f;
+
+        // looking down -Z before the yaw
+        const Vector3 normals[CullingPlanes::COUNT] = {
+            Vector3(std::cos(halfX), 0.0f, -std::sin(halfX)),
+            Vector3(-std::cos(halfX), 0.0f, -std::sin(halfX)),
+            Vector3(0.0f, -std::cos(halfY), -std::sin(halfY)),
+            Vector3(0.0f, std::cos(halfY), -std::sin(halfY)),
+            Vector3(0.0f, 0.0f, -1.0f),
+            Vector3(0.0f, 0.0f, 1.0f)
+        };
+        const float distances[CullingPlanes::COUNT] = { 0.0f, 0.0f, 0.0f, 0.0f, -nearDistance, farDistance };
+
+        const float yaw = yawDegrees * PI / 180.0f;
+        CullingPlanes planes;
+        for (int p = 0; p < CullingPlanes::COUNT; ++p)
+        {
+            planes.nx[p] = normals[p].x * std::cos(yaw) + normals[p].z * std::sin(yaw);
+            planes.ny[p] = normals[p].y;
+            planes.nz[p] = -normals[p].x * std::sin(yaw) + normals[p].z * std::cos(yaw);
+            planes.d[p] = distances[p];
+        }
+        return planes;
+    }
+
+    void FillRandomBoxes(BoundsArray& bounds, std::size_t count)
+    {
+        std::mt19937 random(42);
+        std::uniform_real_distribution<float> position(-600.0f, 600.0f);
+        std::uniform_real_distribution<float> extent(0.5f, 20.0f);
+
+        bounds.Reserve(count);
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            const Vector3 center(position(random), position(random) * 0.1f, position(random));
+            const Vector3 half(extent(random), extent(random), extent(random));
+            bounds.Add(AABB(center - half, center + half));
+        }
+        // boxes touching a plane : where a fused multiply add would give another answer
+        for (int i = 0; i < 32; ++i)
+        {
+            const float z = -(float)(i + 1) * 10.0f;
+            bounds.Add(AABB(Vector3(-1.0f, -1.0f, z), Vector3(1.0f, 1.0f, z + 2.0f)));
+            bounds.Add(AABB(Vector3(-1.0f, -1.0f, -500.0f - (float)i), Vector3(1.0f, 1.0f, -500.0f)));
+        }
+    }
+
+    /// @brief Frustum::IntersectsAABB for every box, with Plane::DistanceToPoint written out.
+    void PerBoxCull(const CullingPlanes& planes, const BoundsArray& bounds, uint32_t* outVisible)
+    {
+        std::fill(outVisible, outVisible + VisibilityMaskWords(bounds.Size()), 0u);
+        for (std::size_t i = 0; i < bounds.Size(); ++i)
+        {
+            bool inside = true;
+            for (int p = 0; p < CullingPlanes::COUNT && inside; ++p)
+            {
+                const Vector3 normal(planes.nx[p], planes.ny[p], planes.nz[p]);
+                const Vector3 positive(normal.x >= 0.0f ? bounds.maxX[i] : bounds.minX[i],
+                                       normal.y >= 0.0f ? bounds.maxY[i] : bounds.minY[i],
+                                       normal.z >= 0.0f ? bounds.maxZ[i] : bounds.minZ[i]);
+                inside = normal.Dot(positive) + planes.d[p] >= 0.0f;
+            }
+            if (inside) outVisible[i >> 5] |= 1u << (i & 31);
+        }
+    }
+
+    void SplitCull(const CullingPlanes& planes, const BoundsArray& bounds, uint32_t* outVisible, CullingCache& cache)
+    {
+        const std::size_t count = bounds.Size();
+        const std::size_t chunks = (count + BOUNDS_PER_CHUNK - 1) / BOUNDS_PER_CHUNK;
+        Threading::ThreadPool::GetInstance().ParallelFor(chunks, [&](std::size_t chunk)
+        {
+            const std::size_t begin = chunk * BOUNDS_PER_CHUNK;
+            CullAABBs(planes, bounds, begin, std::min(count, begin + BOUNDS_PER_CHUNK), outVisible, &cache);
+        });
+    }
+
+    /// @brief Bounds whose bit differs.
+    std::size_t CountDifferences(const std::vector<uint32_t>& a, const std::vector<uint32_t>& b, std::size_t count)
+    {
+        std::size_t differences = 0;
+        for (std::size_t i = 0; i < count; ++i)
+            differences += IsVisible(a.data(), i) == IsVisible(b.data(), i) ? 0 : 1;
+        return differences;
+    }
+
+    template <typename Cull>
+    double TimePerBox(Cull cull, std::size_t boxCount, int iterations)
+    {
+        const auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < iterations; ++i) cull(i);
+        const auto end = std::chrono::steady_clock::now();
+        return std::chrono::duration<double, std::nano>(end - start).count() / ((double)boxCount * iterations);
+    }
+}
+
+int main(int argc, char** argv)
+{
+    const std::size_t boxCount = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 200000;
+    const int iterations = argc > 2 ? std::atoi(argv[2]) : 50;
+
+    BoundsArray bounds;
+    FillRandomBoxes(bounds, boxCount);
+    const std::size_t count = bounds.Size();
+    const std::size_t words = VisibilityMaskWords(count);
+
+    std::vector<uint32_t> wide(words), cached(words), scalar(words), perBox(words), split(words);
+    CullingCache cache, splitCache;
+    std::size_t mismatches = 0;
+    std::size_t visible = 0;
+    // the camera turns : the cache guesses from the previous view
+    for (float yaw = 0.0f; yaw < 360.0f; yaw += 45.0f)
+    {
+        const CullingPlanes planes = CameraPlanes(yaw);
+        CullAABBs(planes, bounds, 0, count, wide.data());
+        cache.Resize(count);
+        CullAABBs(planes, bounds, 0, count, cached.data(), &cache);
+        CullAABBsScalar(planes, bounds, scalar.data());
+        PerBoxCull(planes, bounds, perBox.data());
+        splitCache.Resize(count);
+        SplitCull(planes, bounds, split.data(), splitCache);
+
+        mismatches += CountDifferences(wide, scalar, count) + CountDifferences(cached, scalar, count)
+                    + CountDifferences(perBox, scalar, count) + CountDifferences(split, scalar, count);
+        for (std::size_t i = 0; i < count; ++i) visible += IsVisible(scalar.data(), i) ? 1 : 0;
+    }
+
+    // a new yaw each iteration, as a camera turning
+    auto planesAt = [](int i) { return CameraPlanes((float)(i % 360)); };
+    const double wideTime = TimePerBox([&](int i) { CullAABBs(planesAt(i), bounds, 0, count, wide.data()); }, count, iterations);
+    const double cachedTime = TimePerBox([&](int i) { CullAABBs(planesAt(i), bounds, 0, count, cached.data(), &cache); }, count, iterations);
+    const double scalarTime = TimePerBox([&](int i) { CullAABBsScalar(planesAt(i), bounds, scalar.data()); }, count, iterations);
+    const double perBoxTime = TimePerBox([&](int i) { PerBoxCull(planesAt(i), bounds, perBox.data()); }, count, iterations);
+    const double splitTime = TimePerBox([&](int i) { SplitCull(planesAt(i), bounds, split.data(), splitCache); }, count, iterations);
+
+    std::printf("%zu boxes, %zu visible over 8 views\n", count, visible);
+    std::printf("%-8s %7.2f ns/box\n", GetCullingKernelName(), wideTime);
+    std::printf("%-8s %7.2f ns/box (plane cache)\n", GetCullingKernelName(), cachedTime);
+    std::printf("%-8s %7.2f ns/box\n", "Scalar", scalarTime);
+    std::printf("%-8s %7.2f ns/box\n", "PerBox", perBoxTime);
+    std::printf("%-8s %7.2f ns/box (%zu workers + caller, %zu bounds per job)\n", "Split", splitTime,
+                Threading::ThreadPool::GetInstance().GetWorkerCount(), BOUNDS_PER_CHUNK);
+    std::printf("speedup  %7.2fx over Scalar, %.2fx over PerBox, split %.2fx over one thread\n",
+                scalarTime / wideTime, perBoxTime / wideTime, cachedTime / splitTime);
+
+    if (mismatches > 0)
+    {
+        std::printf("FAILED : %zu bits differ from the scalar path\n", mismatches);
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,245 @@
+/**
+ * @file MathSimdBench.cpp
+ * @brief Accuracy check and microbenchmark of the SSE math paths (MatrixSimd.h) against the scalar ones (MatrixScalar.h).
+ * @details Each operation runs on the same random inputs through both paths :
+ * - Mat4 multiply, Mat4 * Vector4, transpose, ComposeMatrix and quaternion multiply must give the same floats
+ *   (compared with ==, so only the sign of a zero may differ, see MatrixSimd.h),
+ * - the inverse uses another method : every element must be within INVERSE_TOLERANCE of the scalar one, relative to
+ *   the largest element of the scalar inverse, and both must agree on singular matrices.
+ * Then both paths are timed. The process fails when a check fails, so ctest runs it as a test.
+ * Usage : MathSimdBench [iterations]
+ * @note built without floating point contraction (see CMakeLists.txt) : a fused multiply add in the scalar code only
+ * would break the exact comparison.
+ * @version 0.1
+ * @date 2025-12-14
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+#include "PulseEngine/core/Math/Simd/MatrixSimd.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+using namespace PulseEngine::Simd;
+
+#ifdef PULSE_SIMD_SSE
+
+namespace
+{
+    constexpr std::size_t SAMPLE_COUNT = 4096;
+    // 2x2 block method against cofactors : a few ulp on well conditioned matrices
+    constexpr float INVERSE_TOLERANCE = 1e-5f;
+
+    struct Samples
+    {
+        std::vector<float> matricesA, matricesB;    ///< 16 floats each
+        std::vector<float> affines;                 ///< ComposeMatrix results : the matrices the engine inverts most
+        std::vector<float> dominant;                ///< matricesA with a diagonal large enough to be well conditioned
+        std::vector<float> vectors;                 ///< 4 floats each
+        std::vector<float> quaternionsA, quaternionsB, positions, scales;
+    };
+
+    void FillSamples(Samples& samples)
+    {
+        std::mt19937 random(42);
+        std::uniform_real_distribution<float> value(-10.0f, 10.0f);
+        std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+        std::uniform_real_distribution<float> scale(0.1f, 10.0f);
+
+        auto fill = [&](std::vector<float>& out, std::size_t size, auto& distribution)
+        {
+            out.resize(size);
+            for (float& v : out) v = distribution(random);
+        };
+        fill(samples.matricesA, SAMPLE_COUNT * 16, value);
+        fill(samples.matricesB, SAMPLE_COUNT * 16, value);
+        fill(samples.vectors, SAMPLE_COUNT * 4, value);
+        fill(samples.positions, SAMPLE_COUNT * 3, value);
+        fill(samples.scales, SAMPLE_COUNT * 3, scale);
+
+        auto fillQuaternions = [&](std::vector<float>& out)
+        {
+            fill(out, SAMPLE_COUNT * 4, unit);
+            for (std::size_t i = 0; i < SAMPLE_COUNT; ++i)
+            {
+                float* q = &out[i * 4];
+                const float length = std::sqrt(q[0] * q[0] + q[1] * q[1] + q[2] * q[2] + q[3] * q[3]);
+                for (int c = 0; c < 4; ++c) q[c] /= std::max(length, 1e-3f);
+            }
+        };
+        fillQuaternions(samples.quaternionsA);
+        fillQuaternions(samples.quaternionsB);
+
+        // |diagonal| >= 30 >= sum of the other |elements| of its row : far from singular, the tolerance means something
+        samples.dominant = samples.matricesA;
+        for (std::size_t i = 0; i < SAMPLE_COUNT; ++i)
+            for (int d = 0; d < 4; ++d) samples.dominant[i * 16 + d * 5] += 40.0f;
+
+        samples.affines.resize(SAMPLE_COUNT * 16);
+        for (std::size_t i = 0; i < SAMPLE_COUNT; ++i)
+            ComposeMatrixScalar(&samples.positions[i * 3], &samples.quaternionsA[i * 4], &samples.scales[i * 3], &samples.affines[i * 16]);
+    }
+
+    int failures = 0;
+
+    void Report(const char* name, std::size_t mismatches, std::size_t count)
+    {
+        std::printf("%-20s %s (%zu / %zu differ)\n", name, mismatches == 0 ? "ok" : "FAILED", mismatches, count);
+        if (mismatches > 0) failures++;
+    }
+
+    /// @brief Elements that differ between a and b, -0.0f == 0.0f.
+    std::size_t CountDifferences(const float* a, const float* b, std::size_t count)
+    {
+        std::size_t differences = 0;
+        for (std::size_t i = 0; i < count; ++i) differences += a[i] == b[i] ? 0 : 1;
+        return differences;
+    }
+
+    /**
+     * @brief Run the SSE and the scalar version of a 2 inputs operation on every sample and compare them.
+     */
+    template <typename Simd, typename Scalar>
+    void CheckExact(const char* name, Simd simd, Scalar scalar, const std::vector<float>& a, std::size_t strideA,
+                    const std::vector<float>& b, std::size_t strideB, std::size_t outSize)
+    {
+        std::vector<float> simdOut(SAMPLE_COUNT * outSize), scalarOut(SAMPLE_COUNT * outSize);
+        for (std::size_t i = 0; i < SAMPLE_COUNT; ++i)
+        {
+            simd(&a[i * strideA], &b[i * strideB], &simdOut[i * outSize]);
+            scalar(&a[i * strideA], &b[i * strideB], &scalarOut[i * outSize]);
+        }
+        Report(name, CountDifferences(simdOut.data(), scalarOut.data(), simdOut.size()), simdOut.size());
+    }
+
+    void CheckInverse(const char* name, const std::vector<float>& matrices)
+    {
+        std::size_t mismatches = 0;
+        float worst = 0.0f;
+        for (std::size_t i = 0; i < SAMPLE_COUNT; ++i)
+        {
+            float simdOut[16], scalarOut[16];
+            const bool simdInverted = InverseSSE(&matrices[i * 16], simdOut);
+            const bool scalarInverted = InverseScalar(&matrices[i * 16], scalarOut);
+            if (simdInverted != scalarInverted)
+            {
+                mismatches++;
+                continue;
+            }
+            if (!scalarInverted) continue;
+
+            float largest = 0.0f;
+            for (float v : scalarOut) largest = std::max(largest, std::abs(v));
+            for (int e = 0; e < 16; ++e)
+            {
+                const float error = std::abs(simdOut[e] - scalarOut[e]) / std::max(largest, 1e-30f);
+                worst = std::max(worst, error);
+                if (error > INVERSE_TOLERANCE) mismatches++;
+            }
+        }
+        std::printf("%-20s %s (%zu differ, worst relative error %.2e, tolerance %.0e)\n", name,
+                    mismatches == 0 ? "ok" : "FAILED", mismatches, worst, INVERSE_TOLERANCE);
+        if (mismatches > 0) failures++;
+    }
+
+    template <typename Run>
+    double TimePerCall(Run run, int iterations)
+    {
+        const auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < iterations; ++i) run();
+        const auto end = std::chrono::steady_clock::now();
+        return std::chrono::duration<double, std::nano>(end - start).count() / ((double)SAMPLE_COUNT * iterations);
+    }
+
+    // written after each timed loop so the compiler keeps it
+    volatile float sink = 0.0f;
+
+    template <typename Simd, typename Scalar>
+    void Time(const char* name, Simd simd, Scalar scalar, const std::vector<float>& a, std::size_t strideA,
+              const std::vector<float>& b, std::size_t strideB, std::size_t outSize, int iterations)
+    {
+        std::vector<float> out(SAMPLE_COUNT * outSize);
+        auto runWith = [&](auto function)
+        {
+            return TimePerCall([&]()
+            {
+                for (std::size_t i = 0; i < SAMPLE_COUNT; ++i)
+                    function(&a[i * strideA], &b[i * strideB], &out[i * outSize]);
+                sink = sink + out[0];
+            }, iterations);
+        };
+        const double simdTime = runWith(simd);
+        const double scalarTime = runWith(scalar);
+        std::printf("%-20s SSE %7.2f ns  Scalar %7.2f ns  speedup %5.2fx\n", name, simdTime, scalarTime, scalarTime / simdTime);
+    }
+}
+
+int main(int argc, char** argv)
+{
+    const int iterations = argc > 1 ? std::atoi(argv[1]) : 200;
+
+    Samples samples;
+    FillSamples(samples);
+
+    // the functions take 3 arguments : the 2 inputs ones are wrapped to share the check and the timing
+    auto transformSSE = [](const float* m, const float* v, float* out) { Mat4TransformSSE(m, v, out); };
+    auto transformScalar = [](const float* m, const float* v, float* out) { Mat4TransformScalar(m, v, out); };
+    auto transposeSSE = [](const float* m, const float*, float* out) { TransposeSSE(m, out); };
+    auto transposeScalar = [](const float* m, const float*, float* out) { TransposeScalar(m, out); };
+    auto inverseSSE = [](const float* m, const float*, float* out) { InverseSSE(m, out); };
+    auto inverseScalar = [](const float* m, const float*, float* out) { InverseScalar(m, out); };
+    // position and scale are read at the same index as the quaternion
+    const float* positions = samples.positions.data();
+    const float* scales = samples.scales.data();
+    const float* quaternions = samples.quaternionsA.data();
+    auto composeSSE = [=](const float* q, const float*, float* out)
+    {
+        const std::size_t i = (std::size_t)(q - quaternions) / 4;
+        ComposeMatrixSSE(positions + i * 3, q, scales + i * 3, out);
+    };
+    auto composeScalar = [=](const float* q, const float*, float* out)
+    {
+        const std::size_t i = (std::size_t)(q - quaternions) / 4;
+        ComposeMatrixScalar(positions + i * 3, q, scales + i * 3, out);
+    };
+
+    std::printf("accuracy, %zu samples\n", SAMPLE_COUNT);
+    CheckExact("Mat4 multiply", Mat4MultiplySSE, Mat4MultiplyScalar, samples.matricesA, 16, samples.matricesB, 16, 16);
+    CheckExact("Mat4 * Vector4", transformSSE, transformScalar, samples.matricesA, 16, samples.vectors, 4, 4);
+    CheckExact("Transpose", transposeSSE, transposeScalar, samples.matricesA, 16, samples.matricesA, 16, 16);
+    CheckExact("ComposeMatrix", composeSSE, composeScalar, samples.quaternionsA, 4, samples.quaternionsA, 4, 16);
+    CheckExact("Quaternion multiply", QuaternionMultiplySSE, QuaternionMultiplyScalar, samples.quaternionsA, 4, samples.quaternionsB, 4, 4);
+    CheckInverse("Inverse affine", samples.affines);
+    CheckInverse("Inverse general", samples.dominant);
+
+    // a zero row : singular for both
+    float singular[16] = { 1, 2, 3, 4, 0, 0, 0, 0, 5, 6, 7, 8, 9, 10, 11, 12 };
+    float singularOut[16];
+    Report("Inverse singular", InverseSSE(singular, singularOut) == InverseScalar(singular, singularOut) ? 0 : 1, 1);
+
+    std::printf("\ntiming, per call, %d iterations\n", iterations);
+    Time("Mat4 multiply", Mat4MultiplySSE, Mat4MultiplyScalar, samples.matricesA, 16, samples.matricesB, 16, 16, iterations);
+    Time("Mat4 * Vector4", transformSSE, transformScalar, samples.matricesA, 16, samples.vectors, 4, 4, iterations);
+    Time("Transpose", transposeSSE, transposeScalar, samples.matricesA, 16, samples.matricesA, 16, 16, iterations);
+    Time("Inverse", inverseSSE, inverseScalar, samples.affines, 16, samples.affines, 16, 16, iterations);
+    Time("ComposeMatrix", composeSSE, composeScalar, samples.quaternionsA, 4, samples.quaternionsA, 4, 16, iterations);
+    Time("Quaternion multiply", QuaternionMultiplySSE, QuaternionMultiplyScalar, samples.quaternionsA, 4, samples.quaternionsB, 4, 4, iterations);
+
+    return failures == 0 ? 0 : 1;
+}
+
+#else
+
+int main()
+{
+    std::printf("built without the SSE path (PULSE_DISABLE_SIMD or no SSE2) : nothing to compare\n");
+    return 0;
+}
+
+#endif
@@ -0,0 +1,282 @@
+/**
+ * @file OBBBatchBench.cpp
+ * @brief Microbenchmark of the batched OBB narrowphase (OBBBatch.h) against its one-lane path and the per-pair SAT
+ * BoxCollider::SAT_MinimumTranslation used before it.
+ * @details Random boxes are gathered in one OBBArray, paired by FindOBBCandidatePairs, then tested with TestOBBPairs
+ * (widest lanes), TestOBBPairsScalar and OriginalPairSAT, a copy of the old per-pair code. The old code had two
+ * quirks the kernel doesn't keep (a 0.01 slack on the axes of A, edge axes half normalized) : its verdicts are
+ * reported, and the same code without the quirks must give the kernel results.
+ * Results are compared first : the process fails when they disagree, so ctest runs it as a check too.
+ * Usage : OBBBatchBench [boxes] [iterations]
+ * @version 0.1
+ * @date 2025-12-14
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+#include "PulseEngine/core/Physics/Collider/OBBBatch.h"
+
+#include <cfloat>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+using namespace PulseEngine;
+using namespace PulseEngine::Physics;
+
+namespace
+{
+    // depths are a few multiplications and one division apart : same value up to the rounding of a fused multiply add
+    constexpr float DEPTH_TOLERANCE = 1e-4f;
+
+    /// @brief Rotation of a box in degrees, what BoxCollider stores.
+    struct EulerBox
+    {
+        Vector3 center;
+        Vector3 half;
+        Vector3 rotation;
+    };
+
+    /// @brief Local axis index of R = Z * Y * X.
+    Vector3 RotationAxis(const Vector3& degrees, int index)
+    {
+        const float toRadians = 3.14159265f / 180.0f;
+        const float cx = std::cos(degrees.x * toRadians), sx = std::sin(degrees.x * toRadians);
+        const float cy = std::cos(degrees.y * toRadians), sy = std::sin(degrees.y * toRadians);
+        const float cz = std::cos(degrees.z * toRadians), sz = std::sin(degrees.z * toRadians);
+        switch (index)
+        {
+            case 0: return Vector3(cz * cy, sz * cy, -sy);
+            case 1: return Vector3(cz * sy * sx - sz * cx, sz * sy * sx + cz * cx, cy * sx);
+            default: return Vector3(cz * sy * cx + sz * sx, sz * sy * cx - cz * sx, cy * cx);
+        }
+    }
+
+    void FillRandomBoxes(OBBArray& boxes, std::vector<EulerBox>& eulerBoxes, std::size_t count)
+    {
+        std::mt19937 random(1234);
+        // about one candidate pair per box, less than half of them touching
+        const float extent = std::cbrt((float)count) * 1.5f;
+        std::uniform_real_distribution<float> position(-extent, extent);
+        std::uniform_real_distribution<float> half(0.25f, 1.0f);
+        std::uniform_real_distribution<float> angle(0.0f, 360.0f);
+
+        boxes.Clear();
+        boxes.Reserve(count);
+        eulerBoxes.clear();
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            EulerBox box;
+            box.center = Vector3(position(random), position(random), position(random));
+            box.half = Vector3(half(random), half(random), half(random));
+            box.rotation = Vector3(angle(random), angle(random), angle(random));
+            eulerBoxes.push_back(box);
+
+            // one rotation for the three axes, as BoxCollider::GetOBB
+            const Vector3 axes[3] = { RotationAxis(box.rotation, 0), RotationAxis(box.rotation, 1), RotationAxis(box.rotation, 2) };
+            boxes.Add(box.center, box.half, axes);
+        }
+    }
+
+    /**
+     * @brief BoxCollider::SAT_MinimumTranslation before the batched kernel, one pair per call.
+     * @details Same code, BoxCollider replaced by EulerBox : every axis is rebuilt from the rotation as GetAxis did.
+     * The shortcut for boxes of same rotation is left out, it returned without an axis nor a depth.
+     * @param legacy keep the two quirks of the old code : overlap + 0.01 on the axes of A, and on the edge axes the
+     * extents projected on the raw cross product while the distance is projected on the normalized one.
+     * @param outAxisIndex same numbering as OBBContact::axisIndex
+     */
+    bool OriginalPairSAT(const EulerBox& A, const EulerBox& B, bool legacy, Vector3& outAxis, float& outDepth, int& outAxisIndex)
+    {
+        Vector3 Aaxes[3] = { RotationAxis(A.rotation, 0), RotationAxis(A.rotation, 1), RotationAxis(A.rotation, 2) };
+        Vector3 Baxes[3] = { RotationAxis(B.rotation, 0), RotationAxis(B.rotation, 1), RotationAxis(B.rotation, 2) };
+
+        const Vector3 halfA = A.half;
+        const Vector3 halfB = B.half;
+
+        float R[3][3];
+        float AbsR[3][3];
+        const float EPS = 1e-6f;
+        for (int i = 0; i < 3; ++i)
+        {
+            for (int j = 0; j < 3; ++j)
+            {
+                R[i][j] = Aaxes[i].Dot(Baxes[j]);
+                AbsR[i][j] = std::abs(R[i][j]) + EPS;
+            }
+        }
+
+        const Vector3 tWorld = B.center - A.center;
+        const Vector3 t(tWorld.Dot(Aaxes[0]), tWorld.Dot(Aaxes[1]), tWorld.Dot(Aaxes[2]));
+
+        float minPen = FLT_MAX;
+        Vector3 minAxis(0.0f);
+        int minIndex = 0;
+        const float faceSlack = legacy ? 0.01f : 0.0f;
+
+        for (int i = 0; i < 3; ++i)
+        {
+            float ra = halfA[i];
+            float rb = halfB.x * AbsR[i][0] + halfB.y * AbsR[i][1] + halfB.z * AbsR[i][2];
+            float overlap = ra + rb - std::abs(t[i]) + faceSlack;
+            if (overlap < 0.0f) return false;
+            if (overlap < minPen) { minPen = overlap; minAxis = Aaxes[i]; minIndex = i; }
+        }
+
+        for (int i = 0; i < 3; ++i)
+        {
+            float ra = halfA.x * AbsR[0][i] + halfA.y * AbsR[1][i] + halfA.z * AbsR[2][i];
+            float rb = halfB[i];
+            float dist = std::abs(t[0] * R[0][i] + t[1] * R[1][i] + t[2] * R[2][i]);
+            float overlap = ra + rb - dist;
+            if (overlap < 0.0f) return false;
+            if (overlap < minPen) { minPen = overlap; minAxis = Baxes[i]; minIndex = 3 + i; }
+        }
+
+        for (int i = 0; i < 3; ++i)
+        {
+            for (int j = 0; j < 3; ++j)
+            {
+                Vector3 axis = Aaxes[i].Cross(Baxes[j]);
+                float axisLen2 = axis.x * axis.x + axis.y * axis.y + axis.z * axis.z;
+                float threshold = 1e-3f * (halfA.GetMagnitude() + halfB.GetMagnitude());
+                if (axisLen2 < threshold * threshold) continue;
+
+                Vector3 axisN = axis / std::sqrt(axisLen2);
+                // legacy : ra and rb stay scaled by |axis| = sin(A[i], B[j])
+                const Vector3& projected = legacy ? axis : axisN;
+                Vector3 axisAframe(projected.Dot(Aaxes[0]), projected.Dot(Aaxes[1]), projected.Dot(Aaxes[2]));
+                Vector3 axisBframe(projected.Dot(Baxes[0]), projected.Dot(Baxes[1]), projected.Dot(Baxes[2]));
+                float tProj = std::abs(tWorld.Dot(axisN));
+
+                float ra = halfA.x * std::abs(axisAframe.x) + halfA.y * std::abs(axisAframe.y) + halfA.z * std::abs(axisAframe.z);
+                float rb = halfB.x * std::abs(axisBframe.x) + halfB.y * std::abs(axisBframe.y) + halfB.z * std::abs(axisBframe.z);
+
+                float overlap = ra + rb - tProj;
+                if (overlap < 0.0f) return false;
+                if (overlap < minPen) { minPen = overlap; minAxis = axis; minIndex = 6 + i * 3 + j; }
+            }
+        }
+
+        float len = minAxis.GetMagnitude();
+        if (len < 1e-6f) return false;
+
+        outAxis = minAxis * (1.0f / len);
+        outDepth = minPen;
+        outAxisIndex = minIndex;
+        return true;
+    }
+
+    std::vector<OBBContact> RunOriginal(const std::vector<EulerBox>& eulerBoxes, const std::vector<OBBPair>& pairs, bool legacy)
+    {
+        std::vector<OBBContact> contacts(pairs.size());
+        for (std::size_t i = 0; i < pairs.size(); ++i)
+        {
+            OBBContact& contact = contacts[i];
+            int axisIndex = 0;
+            contact.intersect = OriginalPairSAT(eulerBoxes[pairs[i].a], eulerBoxes[pairs[i].b], legacy, contact.axis, contact.depth, axisIndex);
+            contact.axisIndex = (uint8_t)axisIndex;
+        }
+        return contacts;
+    }
+
+    /// @brief Mismatching pairs, a pair touching within the tolerance can go either way.
+    std::size_t CompareContacts(const std::vector<OBBContact>& tested, const std::vector<OBBContact>& reference)
+    {
+        std::size_t mismatches = 0;
+        for (std::size_t i = 0; i < tested.size(); ++i)
+        {
+            const OBBContact& w = tested[i];
+            const OBBContact& s = reference[i];
+            if (w.intersect != s.intersect)
+            {
+                if (std::abs(w.depth) > DEPTH_TOLERANCE || std::abs(s.depth) > DEPTH_TOLERANCE) mismatches++;
+                continue;
+            }
+            if (!w.intersect) continue;
+            if (std::abs(w.depth - s.depth) > DEPTH_TOLERANCE * (1.0f + std::abs(s.depth))) mismatches++;
+            // the old code doesn't orient its axis : parallel is enough
+            else if (w.axisIndex == s.axisIndex && std::abs(w.axis.Dot(s.axis)) < 0.999f) mismatches++;
+        }
+        return mismatches;
+    }
+
+    /// @brief Contacts found by one side only.
+    void CountVerdicts(const std::vector<OBBContact>& tested, const std::vector<OBBContact>& reference, std::size_t& testedOnly, std::size_t& referenceOnly)
+    {
+        testedOnly = referenceOnly = 0;
+        for (std::size_t i = 0; i < tested.size(); ++i)
+        {
+            if (tested[i].intersect && !reference[i].intersect) testedOnly++;
+            if (!tested[i].intersect && reference[i].intersect) referenceOnly++;
+        }
+    }
+
+    template <typename Test>
+    double TimePerPair(Test test, std::size_t pairCount, int iterations)
+    {
+        const auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < iterations; ++i) test();
+        const auto end = std::chrono::steady_clock::now();
+        return std::chrono::duration<double, std::nano>(end - start).count() / ((double)pairCount * iterations);
+    }
+}
+
+int main(int argc, char** argv)
+{
+    const std::size_t boxCount = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 20000;
+    const int iterations = argc > 2 ? std::atoi(argv[2]) : 50;
+
+    OBBArray boxes;
+    std::vector<EulerBox> eulerBoxes;
+    FillRandomBoxes(boxes, eulerBoxes, boxCount);
+
+    std::vector<OBBPair> pairs;
+    FindOBBCandidatePairs(boxes, pairs);
+    if (pairs.empty())
+    {
+        std::printf("no candidate pair for %zu boxes\n", boxCount);
+        return 1;
+    }
+
+    std::vector<OBBContact> wide(pairs.size()), scalar(pairs.size());
+    TestOBBPairs(boxes, pairs.data(), pairs.size(), wide.data());
+    TestOBBPairsScalar(boxes, pairs.data(), pairs.size(), scalar.data());
+    std::vector<OBBContact> original = RunOriginal(eulerBoxes, pairs, true);
+    const std::vector<OBBContact> originalFixed = RunOriginal(eulerBoxes, pairs, false);
+
+    std::size_t contacts = 0, originalContacts = 0;
+    for (const OBBContact& contact : scalar) contacts += contact.intersect ? 1 : 0;
+    for (const OBBContact& contact : original) originalContacts += contact.intersect ? 1 : 0;
+    const std::size_t wideMismatches = CompareContacts(wide, scalar);
+    const std::size_t originalMismatches = CompareContacts(scalar, originalFixed);
+    std::size_t batchedOnly = 0, originalOnly = 0;
+    CountVerdicts(scalar, original, batchedOnly, originalOnly);
+
+    const double wideTime = TimePerPair([&]() { TestOBBPairs(boxes, pairs.data(), pairs.size(), wide.data()); }, pairs.size(), iterations);
+    const double scalarTime = TimePerPair([&]() { TestOBBPairsScalar(boxes, pairs.data(), pairs.size(), scalar.data()); }, pairs.size(), iterations);
+    const double originalTime = TimePerPair([&]() { original = RunOriginal(eulerBoxes, pairs, true); }, pairs.size(), iterations);
+
+    std::printf("%zu boxes, %zu candidate pairs, %zu contacts (%zu with the per-pair SAT)\n", boxCount, pairs.size(), contacts, originalContacts);
+    std::printf("%-8s %8.2f ns/pair\n", GetOBBKernelName(), wideTime);
+    std::printf("%-8s %8.2f ns/pair\n", "Scalar", scalarTime);
+    std::printf("%-8s %8.2f ns/pair\n", "PerPair", originalTime);
+    std::printf("speedup  %8.2fx over Scalar, %.2fx over PerPair\n", scalarTime / wideTime, originalTime / wideTime);
+    std::printf("per-pair quirks : %zu contacts found by the kernel only, %zu by the per-pair SAT only\n", batchedOnly, originalOnly);
+
+    int result = 0;
+    if (wideMismatches > 0)
+    {
+        std::printf("FAILED : %zu pairs differ from the scalar path\n", wideMismatches);
+        result = 1;
+    }
+    if (originalMismatches > 0)
+    {
+        std::printf("FAILED : %zu pairs differ from the per-pair SAT without its quirks\n", originalMismatches);
+        result = 1;
+    }
+    return result;
+}
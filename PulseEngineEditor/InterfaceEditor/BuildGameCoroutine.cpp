@@ -35,11 +35,28 @@ bool BuildGameCoroutine::Update(float deltaTime)
             case Step2:
                 if (timer >= 0.5f)
                 {
-                    editor->ChangePorgressIn("Building Game", 0.4f);
+                    editor->ChangePorgressIn("Building Game", 0.2f);
                     editor->ChangeProgressContent([]() {
-                        ImGui::Text("Copying assets...");
+                        ImGui::Text("Building assets...");
                     }, "Building Game");
-                    topbar->CopyAssetForWindow();
+                    assetBuilder.Start(topbar->GetAssetBuildSettings());
+                    currentStep = Assets;
+                    timer = 0;
+                }
+                break;
+
+            case Assets:
+                if (assetBuilder.IsRunning())
+                {
+                    // only the modified assets are hashed and cooked, on every core
+                    editor->ChangePorgressIn("Building Game", 0.2f + 0.4f * assetBuilder.GetProgress());
+                    editor->ChangeProgressContent([status = assetBuilder.GetStatus()]() {
+                        ImGui::Text("%s...", status.c_str());
+                    }, "Building Game");
+                }
+                else
+                {
+                    assetBuilder.Wait();
                     EDITOR_LOG("Step 2 done\n");
                     currentStep = Step3;
                     timer = 0;
@@ -3,6 +3,7 @@
 
 #include "PulseEngine/core/coroutine/Coroutine.h"
 #include "Common/common.h"
+#include "PulseEngine/core/AssetPipeline/AssetBuilder.h"
 
 class PulseEngineBackend;
 class InterfaceEditor;
@@ -12,11 +13,14 @@ class BuildGameCoroutine : public Coroutine
 {
 private:
     enum Step {
-        Init, Step1, Step2, Step3, Step4, Compile, Done
+        Init, Step1, Step2, Assets, Step3, Step4, Compile, Done
     } currentStep = Init;
 
     float timer = 0.0f;
 
+    /// @brief Incremental asset build, runs on its own thread while the popup shows its progress.
+    PulseEngine::AssetPipeline::AssetBuilder assetBuilder;
+
 public:
     PulseEngineBackend *engine; 
     InterfaceEditor* editor;
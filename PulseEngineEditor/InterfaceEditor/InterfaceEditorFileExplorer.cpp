@@ -1,5 +1,6 @@
 #include "InterfaceEditor.h"
 #include "PulseEngine/core/SceneLoader/SceneLoader.h"
+#include "PulseEngine/core/SceneLoader/WorldStreaming/WorldStreamer.h"
 #include "PulseEngineEditor/InterfaceEditor/TopBar.h"
 #include "PulseEngine/core/Entity/Entity.h"
 #include "PulseEngine/CustomScripts/IScripts.h"
@@ -155,7 +156,7 @@ void InterfaceEditor::ShowFileGrid(const fs::path &currentDir, fs::path &selecte
             // special function that are already known because its game engine basis
             {
                 std::string fullPath = entry.path().string();
-                if (fullPath.size() >= 5 && fullPath.substr(fullPath.size() - 5) == ".pmap")
+                if ((fullPath.size() >= 5 && fullPath.substr(fullPath.size() - 5) == ".pmap") || WorldStreamer::IsWorldFile(fullPath))
                 {
                     if (ImGui::Selectable("Load Scene"))
                     {
@@ -19,6 +19,7 @@
 #include "PulseEngine/core/GUID/GuidCollection.h"
 #include "PulseEngine/core/FileManager/Archive/Archive.h"
 #include "PulseEngine/core/FileManager/Archive/DiskArchive.h"
+#include "PulseEngine/core/SceneLoader/SceneFile/SceneFile.h"
 #include "PulseEngine/core/Material/ShaderManager.h"
 #include <glm/gtc/type_ptr.hpp>
 
@@ -143,8 +144,18 @@ void NewFileManager::RenderPopup(const std::filesystem::path &currentDir, std::f
                     uniform bool hasSkeleton;
                     uniform float internalClock;
                     
-                    #define MAX_BONES 128
-                    uniform mat4 u_BoneMatrices[MAX_BONES];
+                    // bone palettes of the frame, 4 texels per matrix, this mesh from boneOffset (see basic.vert)
+                    uniform samplerBuffer boneMatrices;
+                    uniform int boneOffset;
+                    
+                    mat4 BoneMatrix(int bone)
+                    {
+                        int texel = (boneOffset + bone) * 4;
+                        return mat4(texelFetch(boneMatrices, texel),
+                                    texelFetch(boneMatrices, texel + 1),
+                                    texelFetch(boneMatrices, texel + 2),
+                                    texelFetch(boneMatrices, texel + 3));
+                    }
                     
                     void main()
                     {
@@ -158,10 +169,10 @@ void NewFileManager::RenderPopup(const std::filesystem::path &currentDir, std::f
                         if(hasSkeleton)
                         {
                             skinMatrix = 
-                                a_BoneWeights.x * u_BoneMatrices[int(a_BoneIDs.x)] +
-                                a_BoneWeights.y * u_BoneMatrices[int(a_BoneIDs.y)] +
-                                a_BoneWeights.z * u_BoneMatrices[int(a_BoneIDs.z)] +
-                                a_BoneWeights.w * u_BoneMatrices[int(a_BoneIDs.w)];
+                                a_BoneWeights.x * BoneMatrix(a_BoneIDs.x) +
+                                a_BoneWeights.y * BoneMatrix(a_BoneIDs.y) +
+                                a_BoneWeights.z * BoneMatrix(a_BoneIDs.z) +
+                                a_BoneWeights.w * BoneMatrix(a_BoneIDs.w);
                     
                             vec4 skinnedPos = skinMatrix * vec4(aPos, 1.0);
                             gl_Position = projection * view * model * skinnedPos;
@@ -246,15 +257,10 @@ void NewFileManager::RenderPopup(const std::filesystem::path &currentDir, std::f
 
                 if (extension == ".pmap")
                 {
-                    DiskArchive *ar = new DiskArchive((sanitizedDir / (fileNameStr + extension)).string(), Archive::Mode::Saving);
-                    int entityCount = 0;
-                    std::string receivedMapName = fileNameStr;
-                    ar->Serialize("sceneName", receivedMapName);
-                    uint64_t g = static_cast<uint64_t>(guid);
-                    ar->Serialize("guid", g);
-                    ar->Serialize("entitiesCount", entityCount);
-                    ar->Finalize();
-                    delete ar;
+                    PulseEngine::SceneFormat::SceneFileDesc scene;
+                    scene.sceneName = fileNameStr;
+                    scene.guid = static_cast<uint64_t>(guid);
+                    PulseEngine::SceneFormat::WriteSceneFile((sanitizedDir / (fileNameStr + extension)).string(), scene);
                 }
                 if (extension == ".widget")
                 {
@@ -24,6 +24,7 @@
 #include "PulseEngine/core/GUID/GuidReader.h"
 #include "PulseEngine/core/GUID/GuidCollection.h"
 #include "PulseEngine/core/SceneLoader/SceneLoader.h"
+#include "PulseEngine/core/SceneLoader/WorldStreaming/WorldStreamer.h"
 #include "PulseEngineEditor/InterfaceEditor/InterfaceEditor.h"
 #include <glm/glm.hpp>
 #include <glm/gtc/matrix_transform.hpp>
@@ -33,6 +34,8 @@
 #include "PulseEngine/core/coroutine/CoroutineManager.h"
 #include "PulseEngineEditor/InterfaceEditor/BuildGameCoroutine.h"
 #include "PulseEngine/CustomScripts/ScriptsLoader.h"
+#include "PulseEngine/core/FileManager/Pak/PakManager.h"
+#include "PulseEngine/core/Meshes/Cooking/CookedMesh.h"
 #include <windows.h>
 #include <commdlg.h>
 using namespace PulseEngine::FileSystem;
@@ -76,6 +79,15 @@ void TopBar::UpdateBar(PulseEngineBackend* engine, InterfaceEditor* editor)
             {
                 SceneLoader::SaveSceneToFile(engine->actualMapName, engine->actualMapPath, engine);
             }
+            if (ImGui::MenuItem("Save as streamed world", nullptr, false, !WorldStreamer::IsWorldFile(engine->actualMapPath)))
+            {
+                // "Scenes/island.pmap" -> "Scenes/island.pworld", split in cells next to it
+                std::string worldPath = engine->actualMapPath;
+                const std::size_t dot = worldPath.find_last_of('.');
+                if (dot != std::string::npos) worldPath = worldPath.substr(0, dot);
+                worldPath += WorldStreamer::WORLD_EXTENSION;
+                WorldStreamer::GetInstance().SaveWorld(engine->actualMapName, worldPath, engine);
+            }
             ImGui::EndMenu();
         }
         if (ImGui::BeginMenu("Build"))
@@ -303,6 +315,11 @@ void TopBar::ImportMesh(InterfaceEditor *editor, std::string &name, std::string
     CopyFileA(std::string(filePath).c_str(), meshPath.c_str(), FALSE); 
 
     DeletePrefix(meshPath, prefix, meshPath);
+
+    // import-time cook : the meshes using it read the imported .pmdl instead of running Assimp
+    PulseEngine::Cooking::CookedMesh cooked;
+    PulseEngine::Cooking::LoadMeshAsset(meshPath, cooked);
+
     std::ofstream guidFile(fileStr);
     nlohmann::json_abi_v3_12_0::json guidJson;
     guidJson["Guid"] = PulseEngineInstance->guidCollections["guidCollectionMeshes.puid"]->GetGuidFromFilePath(guidPath);
@@ -515,10 +532,25 @@ void TopBar::CopyDllForWindow()
 }
 
 
-void TopBar::CopyAssetForWindow()
+PulseEngine::AssetPipeline::AssetBuildSettings TopBar::GetAssetBuildSettings()
 {
-    system("xcopy PulseEngineEditor \"Build\\PulseEngineEditor\" /E /I /Y");
-    system("xcopy \"Modules\" \"Build\\Modules\" /E /I /Y");
+    using namespace PulseEngine::AssetPipeline;
+
+    AssetBuildSettings settings;
+    settings.roots.push_back({ "PulseEngineEditor", "Build/PulseEngineEditor", true, true });
+    settings.roots.push_back({ "Modules", "Build/Modules", false, false });
+    settings.manifestPath = "Build/.assetmanifest";
+    settings.cacheDirectory = "BuildCache";
+    settings.pakPath = "Build/" + DEFAULT_PAK_PATH;
+
+    // copied here : the build runs on its own thread while the editor keeps using the collections
+    for (const auto& [name, collection] : PulseEngineInstance->guidCollections)
+    {
+        if (!collection) continue;
+        for (const auto& [guid, path] : collection->GetFiles())
+            settings.guidByPath[NormalizePakPath(path)] = std::strtoull(guid.c_str(), nullptr, 10);
+    }
+    return settings;
 }
 
 void TopBar::GenerateWindowsDirectory()
@@ -18,6 +18,7 @@
 
 #include "Common/common.h"
 #include "Common/dllExport.h"
+#include "PulseEngine/core/AssetPipeline/AssetBuilder.h"
 
 class PulseEngineBackend;
 
@@ -38,7 +39,7 @@ public:
     void AnalyzeEntry(const std::filesystem::directory_entry &entry, std::string &sources);
     void GenerateExecutableForWindow(PulseEngineBackend *engine);
     void CopyDllForWindow();
-    void CopyAssetForWindow();
+    PulseEngine::AssetPipeline::AssetBuildSettings GetAssetBuildSettings();
     void GenerateWindowsDirectory();
 };
 
@@ -12,9 +12,23 @@ out vec4 FragColor;
 uniform vec3 viewPos;
 uniform vec3 objectColor;
 
+#ifdef BATCHED_MATERIALS
+// MaterialBatcher : the maps of the materials of a batch are layers of the same arrays
+uniform sampler2DArray albedoMap;
+uniform sampler2DArray normalMap;
+uniform sampler2DArray roughnessMap;
+flat in vec3 materialLayers;
+#define SAMPLE_ALBEDO(uv) texture(albedoMap, vec3(uv, materialLayers.x))
+#define SAMPLE_NORMAL(uv) texture(normalMap, vec3(uv, materialLayers.y))
+#define SAMPLE_ROUGHNESS(uv) texture(roughnessMap, vec3(uv, materialLayers.z))
+#else
 uniform sampler2D albedoMap;
 uniform sampler2D normalMap;
 uniform sampler2D roughnessMap;
+#define SAMPLE_ALBEDO(uv) texture(albedoMap, uv)
+#define SAMPLE_NORMAL(uv) texture(normalMap, uv)
+#define SAMPLE_ROUGHNESS(uv) texture(roughnessMap, uv)
+#endif
 
 // === LIGHT ===
 struct DirectionalLight
@@ -26,75 +40,103 @@ struct DirectionalLight
     bool castsShadow;
     float near;
     float far;
-    sampler2D shadowMap;
     vec3 position;
 };
 
 uniform DirectionalLight dirLight;
 
-// === MATRIX HELPERS ===
-mat4 makeLookAt(vec3 eye, vec3 center, vec3 up)
+// === SHADOW CASCADES ===
+// DirectionalLight::RenderShadowMap splits the view in cascadeCount slices, cascade i ends at the view depth cascadeSplits[i].
+#define MAX_CASCADES 4
+
+uniform int cascadeCount;
+uniform float cascadeSplits[MAX_CASCADES];
+uniform mat4 cascadeMatrices[MAX_CASCADES];
+uniform sampler2D cascadeShadowMaps[MAX_CASCADES];
+
+// === CLUSTERED POINT LIGHTS ===
+// LightManager::PrepareView bins the point lights in a froxel grid once per view (LightClusterGrid),
+// a pixel only loops over the lights of its cluster.
+#define MAX_SHADOWED_POINT_LIGHTS 4
+
+uniform mat4 view;
+
+uniform samplerBuffer pointLightData;      // 3 texels per light : position + range, color + intensity, attenuation + farPlane + shadowIndex
+uniform usamplerBuffer lightClusters;      // (offset, count) in lightIndices, per cluster
+uniform usamplerBuffer lightIndices;
+uniform samplerCube pointShadowMaps[MAX_SHADOWED_POINT_LIGHTS];
+
+uniform int clusterCountX;
+uniform int clusterCountY;
+uniform int clusterCountZ;
+uniform float clusterSliceScale;           // slice = log(viewDepth) * scale + bias
+uniform float clusterSliceBias;
+uniform float clusterTileWidth;            // pixels
+uniform float clusterTileHeight;
+
+// === SHADOW CALC ===
+float SampleCascadeShadowMap(int index, vec2 uv)
 {
-    vec3 f = normalize(center - eye);
-    vec3 s = normalize(cross(f, up));
-    vec3 u = cross(s, f);
-
-    mat4 m = mat4(1.0);
-    m[0][0] =  s.x; m[1][0] =  s.y; m[2][0] =  s.z;
-    m[0][1] =  u.x; m[1][1] =  u.y; m[2][1] =  u.z;
-    m[0][2] = -f.x; m[1][2] = -f.y; m[2][2] = -f.z;
-    m[3][0] = -dot(s, eye);
-    m[3][1] = -dot(u, eye);
-    m[3][2] =  dot(f, eye);
-    return m;
+    // GLSL 3.30 only indexes sampler arrays with constants
+    if (index == 0) return textureLod(cascadeShadowMaps[0], uv, 0.0).r;
+    if (index == 1) return textureLod(cascadeShadowMaps[1], uv, 0.0).r;
+    if (index == 2) return textureLod(cascadeShadowMaps[2], uv, 0.0).r;
+    return textureLod(cascadeShadowMaps[3], uv, 0.0).r;
 }
 
-mat4 makeOrtho(float left, float right, float bottom, float top, float near, float far)
+float CalculateDirectionalShadow(DirectionalLight light, vec3 fragPos, vec3 normal, float viewDepth)
 {
-    mat4 m = mat4(1.0);
-    m[0][0] = 2.0 / (right - left);
-    m[1][1] = 2.0 / (top - bottom);
-    m[2][2] = -2.0 / (far - near);
-    m[3][0] = -(right + left) / (right - left);
-    m[3][1] = -(top + bottom) / (top - bottom);
-    m[3][2] = -(far + near) / (far - near);
-    return m;
+    // normal-dependent bias, a far cascade has bigger texels
+    float slope = 1.0 - dot(normal, -light.direction);
+
+    for (int i = 0; i < cascadeCount; ++i)
+    {
+        if (viewDepth > cascadeSplits[i])
+            continue;
+
+        vec4 fragPosLightSpace = cascadeMatrices[i] * vec4(fragPos, 1.0);
+        vec3 projCoords = fragPosLightSpace.xyz / fragPosLightSpace.w;
+        projCoords = projCoords * 0.5 + 0.5;
+
+        // outside this cascade (a far cascade drawn a few frames ago) : the next one covers it
+        if (projCoords.x < 0.0 || projCoords.x > 1.0 ||
+            projCoords.y < 0.0 || projCoords.y > 1.0 ||
+            projCoords.z > 1.0)
+            continue;
+
+        float closestDepth = SampleCascadeShadowMap(i, projCoords.xy);
+        float bias = max(0.0005 * slope, 0.00005) * float(i + 1);
+        return projCoords.z - bias > closestDepth ? 1.0 : 0.0;
+    }
+
+    // past the shadow distance
+    return 0.0;
 }
 
-// === SHADOW CALC ===
-float CalculateDirectionalShadow(DirectionalLight light, vec3 fragPos, vec3 normal)
+float SamplePointShadowMap(int index, vec3 direction)
 {
-    vec3 up = vec3(0.0, 1.0, 0.0);
-    mat4 lightView = makeLookAt(light.position, light.target, up);
-    mat4 lightProj = makeOrtho(-10.0, 10.0, -10.0, 10.0, 0.1, 40.0);
-    mat4 lightSpaceMatrix = lightProj * lightView;
-
-    vec4 fragPosLightSpace = lightSpaceMatrix * vec4(fragPos, 1.0);
-    vec3 projCoords = fragPosLightSpace.xyz / fragPosLightSpace.w;
-    projCoords = projCoords * 0.5 + 0.5;
-
-    // outside light frustum
-    if (projCoords.x < 0.0 || projCoords.x > 1.0 ||
-        projCoords.y < 0.0 || projCoords.y > 1.0 ||
-        projCoords.z > 1.0)
-        return 0.0;
-
-    float closestDepth = texture(light.shadowMap, projCoords.xy).r;
-    float currentDepth = projCoords.z;
-
-    // normal-dependent bias
-    vec3 lightDir = normalize(light.target - light.position);
-    float bias = max(0.0005 * (1.0 - dot(normal, lightDir)), 0.00005);
-
-    float shadow = currentDepth - bias > closestDepth ? 1.0 : 0.0;
-    return shadow;
+    // GLSL 3.30 only indexes sampler arrays with constants, lod 0 : no derivatives inside the light loop
+    if (index == 0) return textureLod(pointShadowMaps[0], direction, 0.0).r;
+    if (index == 1) return textureLod(pointShadowMaps[1], direction, 0.0).r;
+    if (index == 2) return textureLod(pointShadowMaps[2], direction, 0.0).r;
+    return textureLod(pointShadowMaps[3], direction, 0.0).r;
+}
+
+float CalculatePointShadow(int index, vec3 lightPos, float farPlane, vec3 fragPos)
+{
+    vec3 fragToLight = fragPos - lightPos;
+    float closestDepth = SamplePointShadowMap(index, fragToLight) * farPlane;
+    float currentDepth = length(fragToLight);
+
+    float bias = 0.05;
+    return currentDepth - bias > closestDepth ? 1.0 : 0.0;
 }
 
 // === NORMAL MAPPING ===
 vec3 GetNormalFromMap(vec3 normal, vec3 tangent, vec3 bitangent)
 {
     // Tangent space normal (RGB → [-1,1])
-    vec3 tangentNormal = texture(normalMap, TexCoords).rgb * 2.0 - 1.0;
+    vec3 tangentNormal = SAMPLE_NORMAL(TexCoords).rgb * 2.0 - 1.0;
 
     // Construct TBN matrix
     vec3 N = normalize(normal);
@@ -106,10 +148,9 @@ vec3 GetNormalFromMap(vec3 normal, vec3 tangent, vec3 bitangent)
 }
 
 // === LIGHTING ===
-vec3 ComputeDirectionalLight(DirectionalLight light, vec3 normal, vec3 viewDir, vec3 fragPos, float roughness)
+vec3 ComputeDirectionalLight(DirectionalLight light, vec3 normal, vec3 viewDir, vec3 fragPos, float viewDepth, float roughness)
 {
-    vec3 lightDir = normalize(light.target - light.position);
-    lightDir = normalize(-lightDir);
+    vec3 lightDir = -light.direction;
     float NdotL = max(dot(normal, lightDir), 0.0);
 
     // diffuse
@@ -122,16 +163,65 @@ vec3 ComputeDirectionalLight(DirectionalLight light, vec3 normal, vec3 viewDir,
     float spec = pow(max(dot(normal, halfway), 0.0), specPower);
     vec3 specular = spec * light.color;
 
-    float shadow = light.castsShadow ? CalculateDirectionalShadow(light, fragPos, normal) : 0.0;
+    float shadow = light.castsShadow ? CalculateDirectionalShadow(light, fragPos, normal, viewDepth) : 0.0;
     return shadow < 1.0 ? (1.0 - shadow) * (specular + diffuse) : vec3(0.05, 0.05, 0.05);
 }
 
+vec3 ComputePointLight(int index, vec3 normal, vec3 viewDir, vec3 fragPos, float roughness)
+{
+    vec4 positionRange = texelFetch(pointLightData, index * 3);
+    vec4 colorIntensity = texelFetch(pointLightData, index * 3 + 1);
+    vec4 params = texelFetch(pointLightData, index * 3 + 2);
+
+    vec3 toLight = positionRange.xyz - fragPos;
+    float distance = length(toLight);
+    if (distance >= positionRange.w)
+        return vec3(0.0);
+
+    vec3 lightDir = toLight / distance;
+    float NdotL = max(dot(normal, lightDir), 0.0);
+
+    // inverse square falloff, windowed to reach 0 at the range the light was binned with
+    float falloff = 1.0 / (1.0 + params.x * distance * distance);
+    float window = clamp(1.0 - pow(distance / positionRange.w, 4.0), 0.0, 1.0);
+    float strength = colorIntensity.w * falloff * window * window;
+
+    vec3 diffuse = colorIntensity.rgb * NdotL;
+
+    float gloss = pow(1.0 - roughness, 2.0);
+    float specPower = mix(2.0, 256.0, gloss);
+    vec3 halfway = normalize(lightDir + viewDir);
+    float spec = pow(max(dot(normal, halfway), 0.0), specPower);
+    vec3 specular = spec * colorIntensity.rgb;
+
+    int shadowIndex = int(params.z);
+    float shadow = shadowIndex >= 0 ? CalculatePointShadow(shadowIndex, positionRange.xyz, params.y, fragPos) : 0.0;
+    return (1.0 - shadow) * strength * (diffuse + specular);
+}
+
+vec3 ComputeClusteredPointLights(vec3 normal, vec3 viewDir, vec3 fragPos, float viewDepth, float roughness)
+{
+    int slice = clamp(int(log(max(viewDepth, 1e-4)) * clusterSliceScale + clusterSliceBias), 0, clusterCountZ - 1);
+    int tileX = clamp(int(gl_FragCoord.x / clusterTileWidth), 0, clusterCountX - 1);
+    int tileY = clamp(int(gl_FragCoord.y / clusterTileHeight), 0, clusterCountY - 1);
+
+    uvec2 cluster = texelFetch(lightClusters, tileX + clusterCountX * (tileY + clusterCountY * slice)).xy;
+
+    vec3 result = vec3(0.0);
+    for (uint i = 0u; i < cluster.y; ++i)
+    {
+        int lightIndex = int(texelFetch(lightIndices, int(cluster.x + i)).r);
+        result += ComputePointLight(lightIndex, normal, viewDir, fragPos, roughness);
+    }
+    return result;
+}
+
 // === MAIN ===
 void main()
 {
     // sample textures
-    vec4 albedoColor = texture(albedoMap, TexCoords);
-    float roughness = texture(roughnessMap, TexCoords).r;
+    vec4 albedoColor = SAMPLE_ALBEDO(TexCoords);
+    float roughness = SAMPLE_ROUGHNESS(TexCoords).r;
 
     // view direction
     vec3 viewDir = normalize(viewPos - FragPos);
@@ -140,7 +230,9 @@ void main()
     vec3 norm = GetNormalFromMap(Normal, Tangent, Bitangent);
 
     // lighting
-    vec3 lightResult = ComputeDirectionalLight(dirLight, norm, viewDir, FragPos, roughness);
+    float viewDepth = -(view * vec4(FragPos, 1.0)).z;
+    vec3 lightResult = ComputeDirectionalLight(dirLight, norm, viewDir, FragPos, viewDepth, roughness);
+    lightResult += ComputeClusteredPointLights(norm, viewDir, FragPos, viewDepth, roughness);
 
     // final shading
     vec3 color = lightResult * albedoColor.rgb;
@@ -14,17 +14,43 @@ out vec2 TexCoords;
 out vec3 Tangent;
 out vec3 Bitangent;
 
+#ifdef BATCHED_MATERIALS
+// MaterialBatcher : one instance per object, 5 texels each from drawBase : model columns, then the layers of its maps
+#define DRAW_PARAMETER_TEXELS 5
+uniform samplerBuffer drawParameters;
+uniform int drawBase;
+flat out vec3 materialLayers;
+#else
 uniform mat4 model;
+#endif
 uniform mat4 view;
 uniform mat4 projection;
 
 uniform bool hasSkeleton;
 
-#define MAX_BONES 128
-uniform mat4 u_BoneMatrices[MAX_BONES];
+// SkinningStage : the palettes of every skinned mesh of the frame, 4 texels (columns) per matrix, this one from boneOffset
+uniform samplerBuffer boneMatrices;
+uniform int boneOffset;
+
+mat4 BoneMatrix(int bone)
+{
+    int texel = (boneOffset + bone) * 4;
+    return mat4(texelFetch(boneMatrices, texel),
+                texelFetch(boneMatrices, texel + 1),
+                texelFetch(boneMatrices, texel + 2),
+                texelFetch(boneMatrices, texel + 3));
+}
 
 void main()
 {
+#ifdef BATCHED_MATERIALS
+    int parameters = (drawBase + gl_InstanceID) * DRAW_PARAMETER_TEXELS;
+    mat4 model = mat4(texelFetch(drawParameters, parameters),
+                      texelFetch(drawParameters, parameters + 1),
+                      texelFetch(drawParameters, parameters + 2),
+                      texelFetch(drawParameters, parameters + 3));
+    materialLayers = texelFetch(drawParameters, parameters + 4).xyz;
+#endif
     mat4 skinMatrix = mat4(1.0);
     FragPos = vec3(model * vec4(aPos, 1.0));
     Normal = normalize(mat3(transpose(inverse(model))) * aNormal);
@@ -35,10 +61,10 @@ void main()
     if(hasSkeleton)
     {
         skinMatrix = 
-            a_BoneWeights.x * u_BoneMatrices[int(a_BoneIDs.x)] +
-            a_BoneWeights.y * u_BoneMatrices[int(a_BoneIDs.y)] +
-            a_BoneWeights.z * u_BoneMatrices[int(a_BoneIDs.z)] +
-            a_BoneWeights.w * u_BoneMatrices[int(a_BoneIDs.w)];
+            a_BoneWeights.x * BoneMatrix(a_BoneIDs.x) +
+            a_BoneWeights.y * BoneMatrix(a_BoneIDs.y) +
+            a_BoneWeights.z * BoneMatrix(a_BoneIDs.z) +
+            a_BoneWeights.w * BoneMatrix(a_BoneIDs.w);
 
         vec4 skinnedPos = skinMatrix * vec4(aPos, 1.0);
         gl_Position = projection * view * model * skinnedPos;
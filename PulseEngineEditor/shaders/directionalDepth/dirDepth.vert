@@ -9,72 +9,36 @@ layout(location = 5) in vec4 a_BoneWeights;
 layout(location = 6) in vec3 aBitangent;
 
 uniform mat4 model;
-uniform vec3 lightPos;
-uniform vec3 target;
+uniform mat4 lightSpaceMatrix;   // cascade being drawn, see DirectionalLight::RenderShadowMap
 
-#define MAX_BONES 128
-uniform mat4 u_BoneMatrices[MAX_BONES];
+// SkinningStage : same palettes as basic.vert, the static meshes have no bone attributes
+uniform bool hasSkeleton;
+uniform samplerBuffer boneMatrices;
+uniform int boneOffset;
 
-mat4 makeLookAt(vec3 eye, vec3 center, vec3 up)
+mat4 BoneMatrix(int bone)
 {
-    vec3 f = normalize(center - eye);
-    vec3 s = normalize(cross(f, up));
-    vec3 u = cross(s, f);
-
-    mat4 m = mat4(1.0);
-    m[0][0] =  s.x; m[1][0] =  s.y; m[2][0] =  s.z;
-    m[0][1] =  u.x; m[1][1] =  u.y; m[2][1] =  u.z;
-    m[0][2] = -f.x; m[1][2] = -f.y; m[2][2] = -f.z;
-    m[3][0] = -dot(s, eye);
-    m[3][1] = -dot(u, eye);
-    m[3][2] =  dot(f, eye);
-    return m;
-}
-
-mat4 makeOrtho(float left, float right, float bottom, float top, float near, float far)
-{
-    mat4 m = mat4(1.0);
-    m[0][0] = 2.0 / (right - left);
-    m[1][1] = 2.0 / (top - bottom);
-    m[2][2] = -2.0 / (far - near);
-    m[3][0] = -(right + left) / (right - left);
-    m[3][1] = -(top + bottom) / (top - bottom);
-    m[3][2] = -(far + near) / (far - near);
-    return m;
+    int texel = (boneOffset + bone) * 4;
+    return mat4(texelFetch(boneMatrices, texel),
+                texelFetch(boneMatrices, texel + 1),
+                texelFetch(boneMatrices, texel + 2),
+                texelFetch(boneMatrices, texel + 3));
 }
 
 void main()
 {
-    // View/Projection pour la light
-    vec3 up = vec3(0.0, 1.0, 0.0);
-    mat4 lightView = makeLookAt(lightPos, target, up);
-    mat4 lightProj = makeOrtho(-10.0, 10.0, -10.0, 10.0, 0.1, 40.0);
-    mat4 fakeShadowMatrix = lightProj * lightView;
-
-    // --- Skinning universel ---
-    // Par défaut : identité → mesh statique
-    mat4 skinMatrix = mat4(1.0);
-
-    // Si l'objet a des bones valides, le CPU aura rempli u_BoneMatrices
-    // (sinon elles sont toutes identité, aucun coût de test)
-    float totalWeight = 
-    abs(a_BoneWeights.x) + abs(a_BoneWeights.y) +
-    abs(a_BoneWeights.z) + abs(a_BoneWeights.w);
-
-    if (totalWeight > 0.999 && totalWeight <= 1.001)
+    if (hasSkeleton)
     {
-        skinMatrix =
-            a_BoneWeights.x * u_BoneMatrices[clamp(a_BoneIDs.x, 0, MAX_BONES - 1)] +
-            a_BoneWeights.y * u_BoneMatrices[clamp(a_BoneIDs.y, 0, MAX_BONES - 1)] +
-            a_BoneWeights.z * u_BoneMatrices[clamp(a_BoneIDs.z, 0, MAX_BONES - 1)] +
-            a_BoneWeights.w * u_BoneMatrices[clamp(a_BoneIDs.w, 0, MAX_BONES - 1)];
+        mat4 skinMatrix =
+            a_BoneWeights.x * BoneMatrix(a_BoneIDs.x) +
+            a_BoneWeights.y * BoneMatrix(a_BoneIDs.y) +
+            a_BoneWeights.z * BoneMatrix(a_BoneIDs.z) +
+            a_BoneWeights.w * BoneMatrix(a_BoneIDs.w);
         vec4 skinnedPos = skinMatrix * vec4(aPos, 1.0);
-        gl_Position = fakeShadowMatrix * model * skinnedPos;
+        gl_Position = lightSpaceMatrix * model * skinnedPos;
     }
     else
     {
-        gl_Position = fakeShadowMatrix * model * vec4(aPos, 1.0);
-
+        gl_Position = lightSpaceMatrix * model * vec4(aPos, 1.0);
     }
-    // Position finale
 }
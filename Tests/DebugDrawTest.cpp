@@ -0,0 +1,88 @@
+/**
+ * @file DebugDrawTest.cpp
+ * @brief Checks of the DebugDraw submission without a GPU : vertices appended per primitive and per depth stream.
+ * @details Box, Sphere and Frustum must cut into the number of lines their documentation gives, in the stream of
+ * their DebugDepthMode only, and Clear must empty both streams. Flush is not built here (DebugDrawFlush.cpp).
+ * @version 0.1
+ * @date 2025-12-14
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+#include "PulseEngine/core/Graphics/DebugDraw/DebugDraw.h"
+
+#include <cstdio>
+
+using namespace PulseEngine::Graphics;
+
+namespace
+{
+    int failures = 0;
+
+    void Check(bool condition, const char* what)
+    {
+        if (condition) return;
+        std::printf("FAILED : %s\n", what);
+        failures++;
+    }
+
+    // 12 edges, 2 vertices each
+    constexpr std::size_t BOX_VERTICES = 24;
+
+    const PulseEngine::Color WHITE(1.0f, 1.0f, 1.0f, 1.0f);
+
+    /// @brief Vertices primitive adds to the stream of depth, nothing to the other one.
+    template <typename Primitive>
+    std::size_t Submitted(DebugDepthMode depth, Primitive primitive)
+    {
+        const DebugDepthMode other = depth == DEBUG_DEPTH_TEST ? DEBUG_ON_TOP : DEBUG_DEPTH_TEST;
+        const std::size_t before = DebugDraw::GetPendingVertexCount(depth);
+        const std::size_t otherBefore = DebugDraw::GetPendingVertexCount(other);
+        primitive();
+        Check(DebugDraw::GetPendingVertexCount(other) == otherBefore, "submitted to the other depth stream");
+        return DebugDraw::GetPendingVertexCount(depth) - before;
+    }
+
+    void TestPrimitives(DebugDepthMode depth)
+    {
+        const PulseEngine::Vector3 center(1.0f, 2.0f, 3.0f);
+
+        Check(Submitted(depth, [&]() { DebugDraw::Line(center, PulseEngine::Vector3(0.0f), WHITE, depth); }) == 2, "Line vertex count");
+        Check(Submitted(depth, [&]() { DebugDraw::Box(PulseEngine::Mat4(1.0f), WHITE, depth); }) == BOX_VERTICES, "Box (matrix) vertex count");
+        Check(Submitted(depth, [&]() { DebugDraw::Box(AABB(PulseEngine::Vector3(-1.0f), center), WHITE, depth); }) == BOX_VERTICES, "Box (AABB) vertex count");
+
+        // three circles of segments lines
+        Check(Submitted(depth, [&]() { DebugDraw::Sphere(center, 2.0f, WHITE, depth); }) == 3 * 24 * 2, "Sphere vertex count");
+        Check(Submitted(depth, [&]() { DebugDraw::Sphere(center, 2.0f, WHITE, depth, 8); }) == 3 * 8 * 2, "Sphere (8 segments) vertex count");
+        Check(Submitted(depth, [&]() { DebugDraw::Sphere(center, 2.0f, WHITE, depth, 1); }) == 3 * 4 * 2, "Sphere segments not clamped to 4");
+
+        // the clip cube through the inverse : the same edges as a box
+        PulseEngine::Mat4 viewProjection(1.0f);
+        viewProjection.data[0][0] = 0.5f;
+        viewProjection.data[2][3] = -1.0f;
+        viewProjection.data[3][3] = 0.0f;
+        viewProjection.data[3][2] = -0.2f;
+        Check(Submitted(depth, [&]() { DebugDraw::Frustum(viewProjection, WHITE, depth); }) == BOX_VERTICES, "Frustum vertex count");
+    }
+}
+
+int main()
+{
+    Check(DebugDraw::GetPendingVertexCount(DEBUG_DEPTH_TEST) == 0 && DebugDraw::GetPendingVertexCount(DEBUG_ON_TOP) == 0, "streams not empty at start");
+
+    TestPrimitives(DEBUG_DEPTH_TEST);
+    TestPrimitives(DEBUG_ON_TOP);
+    Check(DebugDraw::GetPendingVertexCount(DEBUG_DEPTH_TEST) == DebugDraw::GetPendingVertexCount(DEBUG_ON_TOP), "streams differ for the same primitives");
+
+    DebugDraw::Clear();
+    Check(DebugDraw::GetPendingVertexCount(DEBUG_DEPTH_TEST) == 0, "Clear left the depth tested lines");
+    Check(DebugDraw::GetPendingVertexCount(DEBUG_ON_TOP) == 0, "Clear left the lines on top");
+
+    // submitting after a Clear starts from an empty stream
+    DebugDraw::Box(PulseEngine::Mat4(1.0f), WHITE, DEBUG_ON_TOP);
+    Check(DebugDraw::GetPendingVertexCount(DEBUG_ON_TOP) == BOX_VERTICES, "stream after Clear");
+    DebugDraw::Clear();
+
+    if (failures == 0) std::printf("debug draw : all checks passed\n");
+    return failures == 0 ? 0 : 1;
+}
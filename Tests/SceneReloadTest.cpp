@@ -0,0 +1,152 @@
+/**
+ * @file SceneReloadTest.cpp
+ * @brief Regression check of the deferred entity deletion (DeferredDeleteQueue.h) when a scene is loaded twice.
+ * @details Replays the frame order of PulseEngineBackend without the engine : the scene is cleared as ClearScene does
+ * (entities and lights, an editor light being in both lists), reloaded, and every frame the front snapshot is "drawn"
+ * by checking that each pointer it holds is still alive. Fails on a use after free, a double delete or a leak.
+ * @version 0.1
+ * @date 2025-12-14
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+#include "PulseEngine/core/Threading/DeferredDeleteQueue.h"
+
+#include <cstdio>
+#include <unordered_set>
+#include <vector>
+
+using PulseEngine::Threading::DeferredDeleteQueue;
+
+namespace
+{
+    int failures = 0;
+
+    void Check(bool condition, const char* what)
+    {
+        if (condition) return;
+        std::printf("FAILED : %s\n", what);
+        failures++;
+    }
+
+    std::unordered_set<const void*> alive;
+    std::size_t created = 0;
+    std::size_t destroyed = 0;
+
+    struct FakeEntity
+    {
+        FakeEntity() { alive.insert(this); created++; }
+        virtual ~FakeEntity()
+        {
+            Check(alive.erase(this) == 1, "entity deleted twice");
+            destroyed++;
+        }
+    };
+    struct FakeLight : FakeEntity {};
+
+    /// @brief What PulseEngineBackend owns and draws, with its two render snapshots.
+    struct FakeBackend
+    {
+        std::vector<FakeEntity*> entities;
+        std::vector<FakeLight*> lights;
+        std::vector<const FakeEntity*> snapshots[2];
+        int front = 0;
+        DeferredDeleteQueue<FakeEntity> deleted;
+
+        void ClearScene()
+        {
+            deleted.PushAll(entities);
+            deleted.PushAll(lights);
+        }
+
+        void LoadScene(int entityCount, int lightCount)
+        {
+            for (int i = 0; i < entityCount; ++i) entities.push_back(new FakeEntity);
+            // SceneLoader::SerializeLights : in the lights only
+            for (int i = 0; i < lightCount; ++i) lights.push_back(new FakeLight);
+            // added from the editor : in both
+            lights.push_back(new FakeLight);
+            entities.push_back(lights.back());
+        }
+
+        void DeleteEntity(FakeEntity* entity)
+        {
+            for (auto it = entities.begin(); it != entities.end(); ++it)
+            {
+                if (*it != entity) continue;
+                entities.erase(it);
+                for (auto light = lights.begin(); light != lights.end(); ++light)
+                {
+                    if (*light != entity) continue;
+                    lights.erase(light);
+                    break;
+                }
+                deleted.Push(entity);
+                return;
+            }
+        }
+
+        void Simulate()
+        {
+            deleted.MarkCaptured();
+            std::vector<const FakeEntity*>& back = snapshots[1 - front];
+            back.assign(entities.begin(), entities.end());
+            back.insert(back.end(), lights.begin(), lights.end());
+        }
+
+        void DrawFront()
+        {
+            for (const FakeEntity* entity : snapshots[front])
+                Check(alive.count(entity) == 1, "the front snapshot shows a deleted entity");
+        }
+
+        void Swap()
+        {
+            front = 1 - front;
+            deleted.Release([](FakeEntity* entity) { delete entity; });
+        }
+
+        /// @brief Update (loads), simulation, Render (draws the last frame, then swaps), overlays.
+        void Frame(bool reload, FakeEntity* deletedByOverlay = nullptr)
+        {
+            if (reload)
+            {
+                ClearScene();
+                LoadScene(20, 3);
+            }
+            Simulate();
+            DrawFront();
+            Swap();
+            DrawFront();
+            // a script or the editor, after the swap : the new front snapshot still shows it
+            if (deletedByOverlay) DeleteEntity(deletedByOverlay);
+        }
+    };
+}
+
+int main()
+{
+    FakeBackend backend;
+    backend.Frame(true);
+    backend.Frame(false);
+
+    // load the scene twice in a row, then once more after a few frames
+    backend.Frame(true);
+    Check(backend.lights.size() == 4, "the lights of the previous scene are kept");
+    backend.Frame(true);
+    Check(backend.lights.size() == 4, "the lights of the previous scene are kept");
+    backend.Frame(false, backend.entities.front());
+    backend.Frame(false);
+    backend.Frame(true);
+    backend.Frame(false, backend.entities.back());
+    for (int i = 0; i < 3; ++i) backend.Frame(false);
+
+    // what is still in the scene goes the same way
+    backend.ClearScene();
+    for (int i = 0; i < 2; ++i) backend.Frame(false);
+
+    Check(backend.deleted.GetPendingCount() == 0, "entities left in the queue");
+    Check(destroyed == created, "entities never deleted");
+    std::printf("%zu entities created, %zu deleted\n", created, destroyed);
+    return failures == 0 ? 0 : 1;
+}
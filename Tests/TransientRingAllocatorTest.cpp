@@ -0,0 +1,199 @@
+/**
+ * @file TransientRingAllocatorTest.cpp
+ * @brief Checks of TransientRingAllocator without a GPU : the fences are recorded by the callbacks.
+ * @details Covers the wrap-around of the parts, the reuse of a part only once its fence is waited, the spill of a full
+ * frame into the next part, the requests larger than a part and the growth between two frames.
+ * @version 0.1
+ * @date 2025-12-14
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+#include "PulseEngine/core/Graphics/TransientRing/TransientRingAllocator.h"
+
+#include <cstdio>
+#include <vector>
+
+using PulseEngine::Graphics::TransientRingAllocator;
+
+namespace
+{
+    int failures = 0;
+
+    void Check(bool condition, const char* what)
+    {
+        if (condition) return;
+        std::printf("FAILED : %s\n", what);
+        failures++;
+    }
+
+    constexpr std::size_t PART = 1024;
+    constexpr std::uint32_t PARTS = 3;
+
+    /// @brief The GPU side : a fence per part, signaled when waited.
+    struct FakeFences
+    {
+        std::vector<int> pending = std::vector<int>(PARTS, 0);
+        std::vector<std::uint32_t> placed;
+        std::vector<std::uint32_t> waited;
+
+        void Initialize(TransientRingAllocator& ring, std::size_t capacity = PART * PARTS)
+        {
+            ring.Initialize(capacity, PARTS,
+                [this](std::uint32_t part) { pending[part]++; placed.push_back(part); },
+                [this](std::uint32_t part)
+                {
+                    Check(pending[part] > 0, "waited a part without fence");
+                    pending[part] = 0;
+                    waited.push_back(part);
+                });
+        }
+    };
+
+    bool InPart(std::size_t offset, std::size_t size, std::uint32_t part, std::size_t partSize = PART)
+    {
+        return offset >= part * partSize && offset + size <= (part + 1) * partSize;
+    }
+
+    void TestWrapAround()
+    {
+        TransientRingAllocator ring;
+        FakeFences fences;
+        fences.Initialize(ring);
+
+        for (std::uint32_t frame = 0; frame < 7; ++frame)
+        {
+            const std::uint32_t part = frame % PARTS;
+            Check(ring.GetCurrentPartition() == part, "frames don't go through the parts in order");
+
+            const std::size_t a = ring.Allocate(100, 16);
+            const std::size_t b = ring.Allocate(24, 12);
+            Check(a % 16 == 0 && b % 12 == 0, "offset not aligned");
+            Check(InPart(a, 100, part) && InPart(b, 24, part), "allocation outside the part of the frame");
+            Check(b >= a + 100, "allocations overlap");
+            ring.BeginFrame();
+        }
+        Check(fences.placed.size() == 7, "a fence per frame written");
+        Check(ring.GetLastFrameStats().allocations == 2, "stats of the last frame");
+    }
+
+    void TestFenceReuse()
+    {
+        TransientRingAllocator ring;
+        FakeFences fences;
+        fences.Initialize(ring);
+
+        // parts 0, 1 written, part 2 left empty : no fence for it
+        ring.Allocate(64);
+        ring.BeginFrame();
+        ring.Allocate(64);
+        ring.BeginFrame();
+        ring.BeginFrame();
+        Check(fences.placed == std::vector<std::uint32_t>({ 0, 1 }), "fenced an empty frame");
+        Check(fences.waited == std::vector<std::uint32_t>({ 0 }), "part 0 reused before its fence was waited");
+        Check(ring.GetFrameStats().fenceWaits == 1, "fence wait not counted");
+
+        // the fence of part 0 is gone : its next reuse doesn't wait again
+        ring.BeginFrame();
+        ring.BeginFrame();
+        ring.BeginFrame();
+        Check(fences.waited == std::vector<std::uint32_t>({ 0, 1 }), "waited a fence twice");
+
+        // closed frame : nothing allocated until the next one
+        ring.EndFrame();
+        Check(ring.Allocate(16) == TransientRingAllocator::INVALID_OFFSET, "allocated outside a frame");
+    }
+
+    void TestSpill()
+    {
+        TransientRingAllocator ring;
+        FakeFences fences;
+        fences.Initialize(ring);
+
+        // frame 0 in part 0, frame 1 in part 1 : frame 2 spills over part 0, which frame 0 fenced
+        ring.Allocate(PART);
+        ring.BeginFrame();
+        ring.Allocate(PART);
+        ring.BeginFrame();
+
+        const std::size_t a = ring.Allocate(PART - 100);
+        const std::size_t b = ring.Allocate(200, 8);
+        Check(InPart(a, PART - 100, 2), "first allocation outside part 2");
+        Check(InPart(b, 200, 0), "spilled allocation outside part 0");
+        Check(fences.waited == std::vector<std::uint32_t>({ 0 }), "spilled before the fence of part 0 was waited");
+        Check(ring.GetFrameStats().spilledParts == 1, "spill not counted");
+
+        // part 1 is the last free one, then the frame would write over its own part 2
+        Check(ring.Allocate(PART) != TransientRingAllocator::INVALID_OFFSET, "second spill refused");
+        Check(ring.Allocate(PART) == TransientRingAllocator::INVALID_OFFSET, "the frame wrote over its first part");
+        Check(ring.GetFrameStats().overflowBytes == PART, "overflow not counted");
+
+        // every part taken is fenced, the next frame starts after the last one
+        fences.placed.clear();
+        ring.BeginFrame();
+        Check(fences.placed == std::vector<std::uint32_t>({ 2, 0, 1 }), "the spilled parts were not fenced");
+        Check(ring.GetCurrentPartition() == 2, "next frame doesn't follow the last part taken");
+    }
+
+    void TestOversized()
+    {
+        TransientRingAllocator ring;
+        FakeFences fences;
+        fences.Initialize(ring);
+
+        ring.Allocate(16);
+        Check(ring.Allocate(PART + 1) == TransientRingAllocator::INVALID_OFFSET, "allocated more than a part");
+        Check(ring.GetFrameStats().overflowBytes == PART + 1, "oversized request not counted");
+        Check(ring.GetFrameStats().spilledParts == 0, "spilled for a request no part can take");
+
+        // an empty part doesn't take it either
+        ring.BeginFrame();
+        Check(ring.Allocate(PART + 1) == TransientRingAllocator::INVALID_OFFSET, "allocated more than a part");
+        Check(ring.Allocate(PART, 1) != TransientRingAllocator::INVALID_OFFSET, "a whole part refused");
+        Check(ring.Allocate(0) == TransientRingAllocator::INVALID_OFFSET, "allocated nothing");
+    }
+
+    void TestGrowth()
+    {
+        TransientRingAllocator ring;
+        FakeFences fences;
+        fences.Initialize(ring);
+
+        ring.Allocate(600);
+        ring.EndFrame();
+        Check(ring.GetGrowthSize(64 * PART) == 0, "grew a frame that fit");
+        ring.BeginFrame();
+
+        ring.Allocate(600);
+        ring.Allocate(600);
+        ring.Allocate(3000);
+        ring.EndFrame();
+        // 1200 written, 3000 refused : the next power of two
+        Check(ring.GetGrowthSize(64 * PART) == 8 * PART, "growth size");
+        Check(ring.GetGrowthSize(2 * PART) == 2 * PART, "growth above the maximum");
+
+        fences.waited.clear();
+        ring.Resize(ring.GetGrowthSize(64 * PART));
+        Check(fences.waited.size() == 3, "resized before every fence was waited");
+        Check(ring.GetCapacity() == 8 * PART * PARTS, "capacity after growth");
+        Check(ring.GetGrowthCount() == 1, "growth not counted");
+
+        ring.BeginFrame();
+        Check(ring.GetCurrentPartition() == 0, "first frame after growth not in part 0");
+        const std::size_t offset = ring.Allocate(3000);
+        Check(offset != TransientRingAllocator::INVALID_OFFSET && InPart(offset, 3000, 0, 8 * PART), "grown part refused the request");
+        Check(ring.GetLastFrameStats().overflowBytes == 3000, "stats of the frame that overflowed");
+    }
+}
+
+int main()
+{
+    TestWrapAround();
+    TestFenceReuse();
+    TestSpill();
+    TestOversized();
+    TestGrowth();
+
+    if (failures == 0) std::printf("transient ring : all checks passed\n");
+    return failures == 0 ? 0 : 1;
+}
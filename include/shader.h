@@ -16,6 +16,8 @@ class PULSE_ENGINE_DLL_API Shader {
 public:
     Shader(const std::string& vertexPath, const std::string& fragmentPath, IGraphicsAPI* graphicApi);
     Shader(const std::string& vertexPath, const std::string& fragmentPath, const std::string& geometryPath, IGraphicsAPI* graphicApi);
+    /// @brief A variant compiled with each of defines declared, see IGraphicsAPI::CreateShader.
+    Shader(const std::string& vertexPath, const std::string& fragmentPath, IGraphicsAPI* graphicApi, const std::vector<std::string>& defines);
     ~Shader();
     
     unsigned int getProgramID() const { return shaderID; }
@@ -33,6 +35,8 @@ public:
 
     std::string shaderName;
     std::string guid;
+    std::string vertexPath;     ///< the sources it was compiled from, for its variants
+    std::string fragmentPath;
 private:
     unsigned int shaderID;
 
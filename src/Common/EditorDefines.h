@@ -138,9 +138,11 @@
 #ifdef PULSE_PROFILING 
     #define PROFILE_TIMER_SCOPE(name) ProfileTimer profileTimer##__LINE__(name)
     #define PROFILE_TIMER_FUNCTION PROFILE_TIMER_SCOPE(__func__)
+    #define PROFILE_COUNTER(name, ...) Profiler::GetInstance().AddCounter(name, __VA_ARGS__)
 #else
     #define PROFILE_TIMER_SCOPE(name) 
     #define PROFILE_TIMER_FUNCTION 
+    #define PROFILE_COUNTER(name, ...)
 #endif
 
 
@@ -85,3 +85,27 @@ void PulseEngine::EntityApi::AddAngularVelocity(const PulseEngine::Vector3 & a)
 {
     entity->collider->angularVelocity += a;
 };
+
+const std::vector<ContactEvent>& PulseEngine::EntityApi::GetContacts()
+{
+    return PulseEngineInstance->physicManager->GetContactEvents(entity);
+};
+
+bool PulseEngine::EntityApi::IsTouching()
+{
+    for (const ContactEvent& contact : GetContacts())
+    {
+        if (contact.type != ContactEventType::END) return true;
+    }
+    return false;
+};
+
+ContactSubscriptionId PulseEngine::EntityApi::SubscribeContacts(ContactCallback callback)
+{
+    return PulseEngineInstance->physicManager->SubscribeContacts(std::move(callback), entity);
+};
+
+void PulseEngine::EntityApi::UnsubscribeContacts(ContactSubscriptionId id)
+{
+    PulseEngineInstance->physicManager->UnsubscribeContacts(id);
+};
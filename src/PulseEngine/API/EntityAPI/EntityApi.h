@@ -5,6 +5,8 @@
 #include "Common/dllExport.h"
 #include "PulseEngine/CustomScripts/IScripts.h"
 #include "PulseEngine/API/PhysicAPI/PhysicAPI.h"
+#include "PulseEngine/core/Physics/ContactEvent/ContactEvent.h"
+#include <vector>
 class MaterialApi;
 
 namespace PulseEngine
@@ -215,6 +217,31 @@ namespace PulseEngine
         bool IsVelocityLowerThan(float value);
 
         void AddAngularVelocity(const PulseEngine::Vector3& a);
+
+        /**
+         * @brief Returns the contact events of the last physic step involving this entity.
+         * @return Events where this entity is "self" (begin, persist and end).
+         */
+        const std::vector<ContactEvent>& GetContacts();
+
+        /**
+         * @brief Checks whether the entity was touching another body during the last physic step.
+         * @return True if at least one begin or persist contact was reported.
+         */
+        bool IsTouching();
+
+        /**
+         * @brief Registers a callback receiving every contact event of this entity.
+         * @param callback Called on the main thread after each physic step.
+         * @return Subscription id to give to UnsubscribeContacts().
+         */
+        ContactSubscriptionId SubscribeContacts(ContactCallback callback);
+
+        /**
+         * @brief Removes a callback registered with SubscribeContacts().
+         * @param id Subscription id.
+         */
+        void UnsubscribeContacts(ContactSubscriptionId id);
     };
 }
 
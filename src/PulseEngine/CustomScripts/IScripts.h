@@ -17,6 +17,8 @@ namespace PulseEngine
     class EntityApi;
 }
 
+struct ContactEvent;
+
 struct ExposedVariable
 {
     enum class Type
@@ -47,6 +49,11 @@ public:
 
     virtual void OnEditorDisplay() = 0;
 
+    /**
+     * @brief Called after each physic step for every contact where the owner entity is "self".
+     */
+    virtual void OnContact(const ContactEvent& contact) {}
+
     virtual ~IScript() = default;
     virtual const char* GetName() const = 0;
     std::vector<ExposedVariable> GetExposedVariables() {return exposedVariables; }
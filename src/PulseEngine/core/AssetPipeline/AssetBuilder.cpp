@@ -0,0 +1,612 @@
+#include "AssetBuilder.h"
+#include "Common/EditorDefines.h"
+#include "PulseEngine/core/AssetPipeline/AssetManifest.h"
+#include "PulseEngine/core/FileManager/Pak/PakWriter.h"
+#include "PulseEngine/core/GUID/GuidGenerator.h"
+#include "PulseEngine/core/Material/Cooking/CookedMaterial.h"
+#include "PulseEngine/core/Material/Cooking/CookedTexture.h"
+#include "PulseEngine/core/Meshes/Cooking/CookedMesh.h"
+#include "PulseEngine/core/Threading/ThreadPool.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <unordered_set>
+
+namespace fs = std::filesystem;
+using namespace PulseEngine::AssetPipeline;
+
+namespace
+{
+    constexpr uint64_t HASH_SEED = 14695981039346656037ull;
+
+    enum class AssetRule : uint8_t
+    {
+        Copy,
+        Texture,
+        Material,
+        Mesh
+    };
+
+    enum class AssetResult : uint8_t
+    {
+        UpToDate,
+        FromCache,
+        Cooked,
+        Copied,
+        Failed
+    };
+
+    struct AssetWork
+    {
+        std::string key;                    ///< root source + "|" + normalized relative path
+        std::size_t root = 0;
+        fs::path source;
+        fs::path relative;
+        AssetRule rule = AssetRule::Copy;
+        AssetRecord record;
+        std::vector<std::string> previousOutputs;
+        bool known = false;                 ///< found in the previous manifest
+        bool needsHash = true;
+        bool dirty = false;
+        AssetResult result = AssetResult::UpToDate;
+        std::string error;
+    };
+
+    uint64_t Hash(const std::string& text, uint64_t seed = HASH_SEED)
+    {
+        return PulseEngine::Registry::HashContent(text.data(), text.size(), seed);
+    }
+
+    uint64_t Combine(uint64_t hash, uint64_t value)
+    {
+        return PulseEngine::Registry::HashContent(&value, sizeof(value), hash);
+    }
+
+    std::string ToHex(uint64_t value)
+    {
+        char text[17];
+        std::snprintf(text, sizeof(text), "%016llx", (unsigned long long)value);
+        return text;
+    }
+
+    /**
+     * @brief Same value as HashContent over the whole file, read 1 MB at a time.
+     */
+    bool HashFile(const fs::path& path, uint64_t& outHash)
+    {
+        std::ifstream file(path, std::ios::binary);
+        if (!file.is_open()) return false;
+
+        std::vector<char> chunk(1 << 20);
+        uint64_t hash = HASH_SEED;
+        while (file)
+        {
+            file.read(chunk.data(), (std::streamsize)chunk.size());
+            const std::streamsize count = file.gcount();
+            if (count > 0) hash = PulseEngine::Registry::HashContent(chunk.data(), (std::size_t)count, hash);
+        }
+        outHash = hash;
+        return !file.bad();
+    }
+
+    AssetRule GetRule(const AssetBuildRoot& root, const fs::path& path)
+    {
+        if (!root.cook) return AssetRule::Copy;
+        const std::string extension = path.extension().string();
+        if (PulseEngine::Cooking::IsCookableTexture(extension)) return AssetRule::Texture;
+        if (extension == ".mat") return AssetRule::Material;
+        if (PulseEngine::Cooking::IsCookableMesh(extension)) return AssetRule::Mesh;
+        return AssetRule::Copy;
+    }
+
+    /**
+     * @brief Everything that changes the output of a rule besides the source : format versions and options.
+     */
+    uint64_t GetSettingsHash(AssetRule rule, const AssetBuildSettings& settings)
+    {
+        const PulseEngine::Cooking::TextureCookOptions& options = settings.textureOptions;
+        switch (rule)
+        {
+            case AssetRule::Texture:
+                return Hash("texture|" + std::to_string(PulseEngine::Cooking::COOKED_TEXTURE_VERSION) + "|" + std::to_string((int)options.compression)
+                            + "|" + std::to_string(options.generateMips) + "|" + std::to_string(options.flip));
+            case AssetRule::Material:
+                return Hash("material|" + std::to_string(PulseEngine::Cooking::COOKED_MATERIAL_VERSION));
+            case AssetRule::Mesh:
+                return Hash("mesh|" + std::to_string(PulseEngine::Cooking::COOKED_MESH_VERSION));
+            default:
+                return Hash("copy");
+        }
+    }
+
+    struct BuildContext
+    {
+        const AssetBuildSettings& settings;
+        std::unordered_map<std::string, AssetWork*> byKey;
+
+        std::string GetKey(std::size_t root, const std::string& relativePath) const
+        {
+            return settings.roots[root].source + "|" + PulseEngine::FileSystem::NormalizePakPath(relativePath);
+        }
+
+        uint64_t GetGuid(const std::string& assetPath) const
+        {
+            auto it = settings.guidByPath.find(PulseEngine::FileSystem::NormalizePakPath(assetPath));
+            return it != settings.guidByPath.end() ? it->second : 0;
+        }
+
+        /**
+         * @brief A dependency changes the output when its GUID or its content changes.
+         */
+        uint64_t GetDependencySignature(std::size_t root, const std::string& dependency) const
+        {
+            const std::string key = GetKey(root, dependency);
+            uint64_t signature = Combine(Hash(key), GetGuid(dependency));
+            auto it = byKey.find(key);
+            if (it != byKey.end()) signature = Combine(signature, it->second->record.contentHash);
+            return signature;
+        }
+
+        /**
+         * @brief Key of the cache entry : content and settings, the dependencies are checked on restore.
+         */
+        uint64_t GetCacheKey(const AssetWork& work) const
+        {
+            uint64_t key = Combine(Combine(Combine(Hash("rule"), (uint64_t)work.rule), work.record.contentHash), GetSettingsHash(work.rule, settings));
+            // the import flags depend on where the mesh is (primitives), not only on its content
+            if (work.rule == AssetRule::Mesh) key = Combine(key, PulseEngine::Cooking::GetMeshImportFlags(work.relative.generic_string()));
+            return key;
+        }
+
+        uint64_t GetBuildKey(const AssetWork& work) const
+        {
+            uint64_t key = GetCacheKey(work);
+            for (const std::string& dependency : work.record.dependencies)
+                key = Combine(key, GetDependencySignature(work.root, dependency));
+            return key;
+        }
+
+        std::string GetOutputPath(const AssetWork& work, AssetRule rule) const
+        {
+            const std::string destination = (fs::path(settings.roots[work.root].output) / work.relative).generic_string();
+            switch (rule)
+            {
+                case AssetRule::Texture: return PulseEngine::Cooking::GetCookedTexturePath(destination);
+                case AssetRule::Material: return PulseEngine::Cooking::GetCookedMaterialPath(destination);
+                case AssetRule::Mesh: return PulseEngine::Cooking::GetCookedMeshPath(destination);
+                default: return destination;
+            }
+        }
+    };
+
+    bool OutputsExist(const std::vector<std::string>& outputs)
+    {
+        std::error_code ec;
+        for (const std::string& output : outputs)
+        {
+            if (!fs::is_regular_file(output, ec)) return false;
+        }
+        return true;
+    }
+
+    /**
+     * @brief Copy through a temporary file, two jobs writing the same cache entry never leave a half written file.
+     */
+    bool CopyAtomically(const fs::path& from, const fs::path& to)
+    {
+        std::error_code ec;
+        const fs::path temporary = to.string() + ".tmp" + ToHex(std::hash<std::thread::id>()(std::this_thread::get_id()));
+        if (!fs::copy_file(from, temporary, fs::copy_options::overwrite_existing, ec)) return false;
+        fs::rename(temporary, to, ec);
+        if (ec) fs::remove(temporary, ec);
+        return !ec;
+    }
+
+    bool RestoreFromCache(const BuildContext& context, AssetWork& work, const fs::path& entry)
+    {
+        std::ifstream dependencies(entry / "dependencies");
+        if (!dependencies.is_open()) return false;
+
+        std::vector<std::string> paths;
+        std::string line;
+        while (std::getline(dependencies, line))
+        {
+            const std::size_t space = line.find(' ');
+            if (space == std::string::npos) return false;
+            const std::string path = line.substr(space + 1);
+            if (line.substr(0, space) != ToHex(context.GetDependencySignature(work.root, path))) return false;
+            paths.push_back(path);
+        }
+
+        const std::string output = context.GetOutputPath(work, work.rule);
+        std::error_code ec;
+        fs::create_directories(fs::path(output).parent_path(), ec);
+        if (!fs::copy_file(entry / fs::path(output).filename(), output, fs::copy_options::overwrite_existing, ec)) return false;
+
+        work.record.outputs = { output };
+        work.record.dependencies = std::move(paths);
+        return true;
+    }
+
+    void StoreInCache(const BuildContext& context, const AssetWork& work, const fs::path& entry)
+    {
+        std::error_code ec;
+        fs::create_directories(entry, ec);
+        for (const std::string& output : work.record.outputs)
+        {
+            if (!CopyAtomically(output, entry / fs::path(output).filename())) return;
+        }
+
+        // written last : an entry without this file is incomplete and never restored
+        const fs::path temporary = entry / ("dependencies.tmp" + ToHex(std::hash<std::thread::id>()(std::this_thread::get_id())));
+        {
+            std::ofstream file(temporary, std::ios::trunc);
+            for (const std::string& dependency : work.record.dependencies)
+                file << ToHex(context.GetDependencySignature(work.root, dependency)) << ' ' << dependency << '\n';
+        }
+        fs::rename(temporary, entry / "dependencies", ec);
+        if (ec) fs::remove(temporary, ec);
+    }
+
+    bool Cook(const BuildContext& context, AssetWork& work)
+    {
+        const std::string output = context.GetOutputPath(work, work.rule);
+        if (work.rule == AssetRule::Texture)
+        {
+            const PulseEngine::Cooking::TextureCookResult result = PulseEngine::Cooking::CookTexture(work.source.string(), output, context.settings.textureOptions);
+            if (!result.success)
+            {
+                work.error = result.error;
+                return false;
+            }
+        }
+        else if (work.rule == AssetRule::Mesh)
+        {
+            const unsigned int importFlags = PulseEngine::Cooking::GetMeshImportFlags(work.relative.generic_string());
+            if (!PulseEngine::Cooking::CookMesh(work.source.string(), output, importFlags, work.error)) return false;
+        }
+        else
+        {
+            auto resolve = [&context](const std::string& texturePath) { return context.GetGuid(texturePath); };
+            if (!PulseEngine::Cooking::CookMaterial(work.source.string(), output, resolve, work.error, &work.record.dependencies)) return false;
+        }
+        work.record.outputs = { output };
+        return true;
+    }
+
+    void ProcessAsset(const BuildContext& context, AssetWork& work)
+    {
+        work.record.outputs.clear();
+        work.record.dependencies.clear();
+
+        if (work.rule != AssetRule::Copy)
+        {
+            const fs::path entry = fs::path(context.settings.cacheDirectory) / ToHex(context.GetCacheKey(work));
+            if (RestoreFromCache(context, work, entry))
+            {
+                work.result = AssetResult::FromCache;
+                return;
+            }
+            work.record.dependencies.clear();
+            if (Cook(context, work))
+            {
+                StoreInCache(context, work, entry);
+                work.result = AssetResult::Cooked;
+                return;
+            }
+            work.record.dependencies.clear();
+            work.error += ", copying the source instead";
+        }
+
+        const std::string output = context.GetOutputPath(work, AssetRule::Copy);
+        std::error_code ec;
+        fs::create_directories(fs::path(output).parent_path(), ec);
+        if (!fs::copy_file(work.source, output, fs::copy_options::overwrite_existing, ec))
+        {
+            work.error = "can't copy " + work.source.string() + ": " + ec.message();
+            work.result = AssetResult::Failed;
+            return;
+        }
+        work.record.outputs = { output };
+        work.result = AssetResult::Copied;
+    }
+
+    /**
+     * @brief Rank of a packed file : the pack is written in the order the game reads it.
+     */
+    int GetLoadRank(const std::string& pakPath)
+    {
+        const std::string extension = fs::path(pakPath).extension().string();
+        if (pakPath.rfind("engineconfig/", 0) == 0) return 0;
+        if (extension == ".pmap" || extension == ".pworld") return 1;
+        if (extension == ".pmat") return 2;
+        if (extension == ".ptex") return 4;
+        return 3;
+    }
+
+    bool WritePak(const BuildContext& context, const std::vector<AssetWork>& works)
+    {
+        using namespace PulseEngine::FileSystem;
+
+        struct PackedFile
+        {
+            std::string source;
+            std::string pakPath;
+            uint64_t guid = 0;
+            bool compress = true;
+            int rank = 0;
+        };
+
+        std::vector<PackedFile> files;
+        for (const AssetWork& work : works)
+        {
+            const AssetBuildRoot& root = context.settings.roots[work.root];
+            if (!root.pack) continue;
+
+            for (const std::string& output : work.record.outputs)
+            {
+                PackedFile file;
+                file.source = output;
+                file.pakPath = fs::path(output).lexically_relative(root.output).generic_string();
+                // cooked files take the GUID of their source
+                file.guid = context.GetGuid(work.relative.generic_string());
+                // cooked textures are uploaded from the mapping, block compressed data barely compresses anyway
+                file.compress = fs::path(output).extension() != ".ptex";
+                file.rank = GetLoadRank(NormalizePakPath(file.pakPath));
+                files.push_back(std::move(file));
+            }
+        }
+        std::stable_sort(files.begin(), files.end(), [](const PackedFile& a, const PackedFile& b) { return a.rank < b.rank; });
+
+        PakWriter writer;
+        for (const PackedFile& file : files)
+        {
+            if (!writer.AddFile(file.source, file.pakPath, file.guid, file.compress) && !writer.AddFile(file.source, file.pakPath, 0, file.compress))
+                EDITOR_WARN("[PAK] " << file.pakPath << " is already in the pack");
+        }
+
+        const PakWriteResult result = writer.Write(context.settings.pakPath);
+        if (!result.success)
+        {
+            EDITOR_ERROR("[PAK] " << result.error);
+            return false;
+        }
+        EDITOR_LOG("[PAK] " << result.entryCount << " assets packed (" << result.compressedCount << " compressed), "
+                   << result.sourceBytes / 1024 << " KB -> " << result.pakBytes / 1024 << " KB");
+        return true;
+    }
+}
+
+AssetBuilder::~AssetBuilder()
+{
+    Wait();
+}
+
+bool AssetBuilder::Start(AssetBuildSettings settings)
+{
+    if (running) return false;
+    Wait();
+
+    running = true;
+    thread = std::thread([this, settings = std::move(settings)]()
+    {
+        Build(settings);
+        running = false;
+    });
+    return true;
+}
+
+void AssetBuilder::Wait()
+{
+    if (thread.joinable()) thread.join();
+}
+
+float AssetBuilder::GetProgress() const
+{
+    const std::size_t total = phaseTotal;
+    return total == 0 ? 0.0f : std::min(1.0f, (float)phaseDone / (float)total);
+}
+
+std::string AssetBuilder::GetStatus() const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return status;
+}
+
+AssetBuildStats AssetBuilder::GetStats() const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return lastStats;
+}
+
+void AssetBuilder::BeginPhase(const std::string& name, std::size_t count)
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        status = name;
+    }
+    phaseDone = 0;
+    phaseTotal = count;
+}
+
+AssetBuildStats AssetBuilder::Build(const AssetBuildSettings& settings)
+{
+    const auto start = std::chrono::steady_clock::now();
+    AssetBuildStats stats;
+
+    AssetManifest previous;
+    previous.Load(settings.manifestPath);
+
+    // === scan : size and write time only ===
+    BeginPhase("Scanning assets", 0);
+    std::vector<AssetWork> works;
+    for (std::size_t r = 0; r < settings.roots.size(); ++r)
+    {
+        const AssetBuildRoot& root = settings.roots[r];
+        std::error_code ec;
+        for (auto it = fs::recursive_directory_iterator(root.source, fs::directory_options::skip_permission_denied, ec);
+             !ec && it != fs::recursive_directory_iterator(); it.increment(ec))
+        {
+            if (!it->is_regular_file(ec)) continue;
+
+            AssetWork work;
+            work.root = r;
+            work.source = it->path();
+            work.relative = it->path().lexically_relative(root.source);
+            work.key = root.source + "|" + PulseEngine::FileSystem::NormalizePakPath(work.relative.generic_string());
+            work.rule = GetRule(root, work.source);
+            work.record.size = (uint64_t)it->file_size(ec);
+            work.record.writeTime = (int64_t)it->last_write_time(ec).time_since_epoch().count();
+
+            auto known = previous.records.find(work.key);
+            if (known != previous.records.end())
+            {
+                work.known = true;
+                work.previousOutputs = known->second.outputs;
+                work.record.dependencies = known->second.dependencies;
+                work.needsHash = known->second.size != work.record.size || known->second.writeTime != work.record.writeTime;
+                if (!work.needsHash) work.record.contentHash = known->second.contentHash;
+            }
+            works.push_back(std::move(work));
+        }
+        if (ec) EDITOR_WARN("[BUILD] error while scanning " << root.source << ": " << ec.message());
+    }
+    std::sort(works.begin(), works.end(), [](const AssetWork& a, const AssetWork& b) { return a.key < b.key; });
+    stats.scanned = works.size();
+
+    BuildContext context{ settings, {} };
+    for (AssetWork& work : works) context.byKey[work.key] = &work;
+
+    const std::size_t workerCount = settings.workerCount ? settings.workerCount : std::max(1u, std::thread::hardware_concurrency());
+    PulseEngine::Threading::ThreadPool pool(workerCount);
+
+    // === hash what was touched since the last build ===
+    std::vector<AssetWork*> toHash;
+    for (AssetWork& work : works)
+    {
+        if (work.needsHash) toHash.push_back(&work);
+    }
+    BeginPhase("Hashing modified assets", toHash.size());
+    for (AssetWork* work : toHash)
+    {
+        pool.Submit([this, work]()
+        {
+            if (!HashFile(work->source, work->record.contentHash)) work->record.contentHash = 0;
+            ++phaseDone;
+        });
+    }
+    pool.WaitIdle();
+    stats.hashed = toHash.size();
+
+    // === dirty : new build key or missing outputs ===
+    std::vector<AssetWork*> toBuild;
+    for (AssetWork& work : works)
+    {
+        const uint64_t buildKey = context.GetBuildKey(work);
+        auto known = previous.records.find(work.key);
+        work.dirty = !work.known || work.record.contentHash == 0 || known->second.buildKey != buildKey || !OutputsExist(known->second.outputs);
+        if (work.dirty)
+        {
+            toBuild.push_back(&work);
+        }
+        else
+        {
+            work.record.buildKey = buildKey;
+            work.record.outputs = known->second.outputs;
+            ++stats.upToDate;
+        }
+    }
+
+    BeginPhase("Cooking and copying assets", toBuild.size());
+    for (AssetWork* work : toBuild)
+    {
+        pool.Submit([this, &context, work]()
+        {
+            try
+            {
+                ProcessAsset(context, *work);
+            }
+            catch (const std::exception& e)
+            {
+                work->error = e.what();
+                work->result = AssetResult::Failed;
+            }
+            ++phaseDone;
+        });
+    }
+    pool.WaitIdle();
+
+    // materials learn their dependencies while cooking, the key is computed once they are known
+    for (AssetWork* work : toBuild)
+    {
+        switch (work->result)
+        {
+            case AssetResult::FromCache: ++stats.fromCache; break;
+            case AssetResult::Cooked: ++stats.cooked; break;
+            case AssetResult::Copied: ++stats.copied; break;
+            default: ++stats.failed; break;
+        }
+        if (!work->error.empty())
+        {
+            EDITOR_WARN("[BUILD] " << work->relative.string() << ": " << work->error);
+        }
+        work->record.buildKey = work->result == AssetResult::Failed ? 0 : context.GetBuildKey(*work);
+    }
+
+    // === outputs of deleted sources, and the ones a rebuilt asset does not produce anymore ===
+    std::unordered_set<std::string> liveOutputs;
+    for (const AssetWork& work : works) liveOutputs.insert(work.record.outputs.begin(), work.record.outputs.end());
+    for (const auto& [key, record] : previous.records)
+    {
+        for (const std::string& output : record.outputs)
+        {
+            std::error_code ec;
+            if (!liveOutputs.count(output) && fs::remove(output, ec)) ++stats.removed;
+        }
+    }
+
+    // === pack ===
+    AssetManifest next;
+    if (!settings.pakPath.empty())
+    {
+        BeginPhase("Packing assets", 1);
+        uint64_t pakKey = Hash("pak|" + std::to_string(PulseEngine::FileSystem::PAK_VERSION));
+        for (const AssetWork& work : works)
+        {
+            if (!settings.roots[work.root].pack) continue;
+            for (const std::string& output : work.record.outputs)
+                pakKey = Combine(Combine(Hash(output, pakKey), work.record.buildKey), context.GetGuid(work.relative.generic_string()));
+        }
+
+        std::error_code ec;
+        next.pakKey = pakKey;
+        if (pakKey != previous.pakKey || !fs::is_regular_file(settings.pakPath, ec))
+        {
+            stats.pakWritten = WritePak(context, works);
+            if (!stats.pakWritten) next.pakKey = 0;
+        }
+        phaseDone = 1;
+    }
+
+    for (AssetWork& work : works) next.records[work.key] = std::move(work.record);
+    if (!next.Save(settings.manifestPath))
+    {
+        EDITOR_ERROR("[BUILD] can't write the asset manifest " << settings.manifestPath);
+    }
+
+    stats.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    EDITOR_LOG("[BUILD] " << stats.scanned << " assets in " << stats.seconds << " s : " << stats.upToDate << " up to date, "
+               << stats.hashed << " hashed, " << stats.cooked << " cooked, " << stats.fromCache << " from cache, "
+               << stats.copied << " copied, " << stats.failed << " failed, " << stats.removed << " removed"
+               << (stats.pakWritten ? ", pack written" : ""));
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        status = "Done";
+        lastStats = stats;
+    }
+    return stats;
+}
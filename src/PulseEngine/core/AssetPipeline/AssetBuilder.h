@@ -0,0 +1,113 @@
+/**
+ * @file AssetBuilder.h
+ * @brief Incremental asset build of the game : cook, copy and pack only what changed since the last build.
+ * @details Each source file gets a build key = content hash + cook settings + its dependencies (the textures a
+ * material references...). The previous build is described by an AssetManifest :
+ * - same size and write time as last time : the file is not even read, its outputs are kept if they still exist.
+ * - otherwise the file is hashed, and cooked again only when its build key changed.
+ * Cooked results are also stored in a local cache keyed by content and settings (outside of Build/, survives a clean
+ * or a branch switch) : a cache hit is a file copy instead of a cook.
+ * Hashing and cooking run on every core, the whole build runs on its own thread (Start) so the editor keeps drawing.
+ * @version 0.1
+ * @date 2025-12-12
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+#ifndef ASSETBUILDER_H
+#define ASSETBUILDER_H
+
+#include "Common/dllExport.h"
+#include "PulseEngine/core/Material/Cooking/TextureCooker.h"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace PulseEngine::AssetPipeline
+{
+    struct AssetBuildRoot
+    {
+        std::string source;     ///< "PulseEngineEditor"
+        std::string output;     ///< "Build/PulseEngineEditor"
+        bool cook = true;       ///< false : every file is copied as it is
+        bool pack = false;      ///< outputs are written into the .pak
+    };
+
+    struct AssetBuildSettings
+    {
+        std::vector<AssetBuildRoot> roots;
+        std::string manifestPath = "Build/.assetmanifest";
+        std::string cacheDirectory = "BuildCache";
+        std::string pakPath;                                    ///< empty : no pack
+        PulseEngine::Cooking::TextureCookOptions textureOptions;
+        std::unordered_map<std::string, uint64_t> guidByPath;   ///< NormalizePakPath(asset path) -> GUID, copy of the guid collections
+        std::size_t workerCount = 0;                            ///< 0 : one per core
+    };
+
+    struct AssetBuildStats
+    {
+        std::size_t scanned = 0;
+        std::size_t hashed = 0;         ///< size or write time changed
+        std::size_t upToDate = 0;
+        std::size_t fromCache = 0;
+        std::size_t cooked = 0;
+        std::size_t copied = 0;
+        std::size_t failed = 0;
+        std::size_t removed = 0;        ///< outputs of deleted sources
+        bool pakWritten = false;
+        double seconds = 0.0;
+    };
+
+    class PULSE_ENGINE_DLL_API AssetBuilder
+    {
+    public:
+        AssetBuilder() = default;
+        ~AssetBuilder();
+
+        AssetBuilder(const AssetBuilder&) = delete;
+        AssetBuilder& operator=(const AssetBuilder&) = delete;
+
+        /**
+         * @brief Run Build on a background thread. False if a build is already running.
+         */
+        bool Start(AssetBuildSettings settings);
+        bool IsRunning() const { return running; }
+        void Wait();
+
+        /**
+         * @brief Progress of the current phase (hashing, cooking...), 0 to 1.
+         */
+        float GetProgress() const;
+        std::string GetStatus() const;
+
+        /**
+         * @brief Result of the last build, complete once IsRunning() is false.
+         */
+        AssetBuildStats GetStats() const;
+
+        /**
+         * @brief The whole build on the calling thread.
+         */
+        AssetBuildStats Build(const AssetBuildSettings& settings);
+
+    private:
+        void BeginPhase(const std::string& name, std::size_t count);
+
+        std::thread thread;
+        std::atomic<bool> running{ false };
+        std::atomic<std::size_t> phaseDone{ 0 };
+        std::atomic<std::size_t> phaseTotal{ 0 };
+
+        mutable std::mutex mutex;
+        std::string status;
+        AssetBuildStats lastStats;
+    };
+}
+
+#endif // ASSETBUILDER_H
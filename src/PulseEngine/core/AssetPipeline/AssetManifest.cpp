@@ -0,0 +1,140 @@
+#include "AssetManifest.h"
+
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+
+using namespace PulseEngine::AssetPipeline;
+
+namespace
+{
+    struct ManifestWriter
+    {
+        std::vector<char> buffer;
+
+        template <typename T>
+        void Write(const T& value)
+        {
+            const char* bytes = reinterpret_cast<const char*>(&value);
+            buffer.insert(buffer.end(), bytes, bytes + sizeof(T));
+        }
+
+        void WriteString(const std::string& value)
+        {
+            Write((uint32_t)value.size());
+            buffer.insert(buffer.end(), value.begin(), value.end());
+        }
+
+        void WriteStrings(const std::vector<std::string>& values)
+        {
+            Write((uint32_t)values.size());
+            for (const std::string& value : values) WriteString(value);
+        }
+    };
+
+    struct ManifestReader
+    {
+        const std::vector<char>& buffer;
+        std::size_t cursor = 0;
+        bool failed = false;
+
+        template <typename T>
+        T Read()
+        {
+            T value{};
+            if (cursor + sizeof(T) > buffer.size()) { failed = true; return value; }
+            std::memcpy(&value, buffer.data() + cursor, sizeof(T));
+            cursor += sizeof(T);
+            return value;
+        }
+
+        std::string ReadString()
+        {
+            const uint32_t length = Read<uint32_t>();
+            if (failed || length > buffer.size() - cursor) { failed = true; return std::string(); }
+            std::string value(buffer.data() + cursor, length);
+            cursor += length;
+            return value;
+        }
+
+        std::vector<std::string> ReadStrings()
+        {
+            const uint32_t count = Read<uint32_t>();
+            std::vector<std::string> values;
+            for (uint32_t i = 0; i < count && !failed; ++i) values.push_back(ReadString());
+            return values;
+        }
+    };
+}
+
+bool AssetManifest::Load(const std::string& path)
+{
+    pakKey = 0;
+    records.clear();
+
+    std::ifstream file(path, std::ios::binary);
+    if (!file.is_open()) return false;
+    const std::vector<char> buffer((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+    ManifestReader reader{ buffer };
+    if (reader.Read<uint32_t>() != MAGIC || reader.Read<uint16_t>() != VERSION) return false;
+
+    pakKey = reader.Read<uint64_t>();
+    const uint32_t count = reader.Read<uint32_t>();
+    records.reserve(count);
+    for (uint32_t i = 0; i < count && !reader.failed; ++i)
+    {
+        const std::string key = reader.ReadString();
+        AssetRecord record;
+        record.size = reader.Read<uint64_t>();
+        record.writeTime = reader.Read<int64_t>();
+        record.contentHash = reader.Read<uint64_t>();
+        record.buildKey = reader.Read<uint64_t>();
+        record.outputs = reader.ReadStrings();
+        record.dependencies = reader.ReadStrings();
+        records[key] = std::move(record);
+    }
+
+    if (reader.failed)
+    {
+        pakKey = 0;
+        records.clear();
+        return false;
+    }
+    return true;
+}
+
+bool AssetManifest::Save(const std::string& path) const
+{
+    ManifestWriter writer;
+    writer.Write(MAGIC);
+    writer.Write(VERSION);
+    writer.Write(pakKey);
+    writer.Write((uint32_t)records.size());
+    for (const auto& [key, record] : records)
+    {
+        writer.WriteString(key);
+        writer.Write(record.size);
+        writer.Write(record.writeTime);
+        writer.Write(record.contentHash);
+        writer.Write(record.buildKey);
+        writer.WriteStrings(record.outputs);
+        writer.WriteStrings(record.dependencies);
+    }
+
+    std::error_code ec;
+    const std::filesystem::path destination(path);
+    if (destination.has_parent_path()) std::filesystem::create_directories(destination.parent_path(), ec);
+
+    // written next to the old one then swapped : an interrupted build keeps the previous manifest
+    const std::string temporary = path + ".tmp";
+    {
+        std::ofstream file(temporary, std::ios::binary | std::ios::trunc);
+        if (!file.is_open()) return false;
+        file.write(writer.buffer.data(), (std::streamsize)writer.buffer.size());
+        if (!file.good()) return false;
+    }
+    std::filesystem::rename(temporary, path, ec);
+    return !ec;
+}
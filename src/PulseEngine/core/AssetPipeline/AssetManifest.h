@@ -0,0 +1,51 @@
+/**
+ * @file AssetManifest.h
+ * @brief What the last asset build produced, read back by the next one to skip the unchanged assets.
+ * @details One record per source file : size and write time (a no-op build compares those only, without reading
+ * the file), content hash, the build key of its outputs (content + cook settings + dependencies) and the outputs.
+ * Binary file : magic "PABM", uint16 version, uint64 pakKey, uint32 record count, records.
+ * @version 0.1
+ * @date 2025-12-12
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+#ifndef ASSETMANIFEST_H
+#define ASSETMANIFEST_H
+
+#include "Common/dllExport.h"
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace PulseEngine::AssetPipeline
+{
+    struct AssetRecord
+    {
+        uint64_t size = 0;
+        int64_t writeTime = 0;
+        uint64_t contentHash = 0;
+        uint64_t buildKey = 0;
+        std::vector<std::string> outputs;       ///< paths from the working directory
+        std::vector<std::string> dependencies;  ///< source keys read by the cook (textures of a material...)
+    };
+
+    struct PULSE_ENGINE_DLL_API AssetManifest
+    {
+        static constexpr uint32_t MAGIC = 0x4D424150; // "PABM"
+        static constexpr uint16_t VERSION = 1;
+
+        uint64_t pakKey = 0;    ///< hash of every packed output, the pack is rewritten when it changes
+        std::unordered_map<std::string, AssetRecord> records;  ///< by source key "root|relative/path"
+
+        /**
+         * @brief False (and empty manifest) when the file is missing or from another version : everything is rebuilt.
+         */
+        bool Load(const std::string& path);
+        bool Save(const std::string& path) const;
+    };
+}
+
+#endif // ASSETMANIFEST_H
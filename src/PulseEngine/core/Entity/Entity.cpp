@@ -39,10 +39,13 @@ void Entity::Serialize(Archive &ar)
     // {
     //     collider->Serialize(ar);
     // }
+}
 
-        bodyID = PulseEngineInstance->physicManager->CreateBox(JPH::Vec3(transform.position.x, transform.position.y, transform.position.z), JPH::Vec3(0.5f,0.5f,0.5f), false);
-
-    }
+void Entity::CreatePhysicBody()
+{
+    bodyID = PulseEngineInstance->physicManager->CreateBox(JPH::Vec3(transform.position.x, transform.position.y, transform.position.z), JPH::Vec3(0.5f,0.5f,0.5f), false);
+    PulseEngineInstance->physicManager->RegisterBodyOwner(bodyID, this);
+}
 
 void Entity::Deserialize(Archive &ar)
 {
@@ -323,22 +326,7 @@ void Entity::CalculateMeshMatrix(RenderableMesh* const & mesh) const
 
 void Entity::BindTexturesToShader() const
 {
-    if (auto albedoTex = material->GetTexture("albedo"))
-    {
-        albedoTex->Bind(6);
-        material->GetShader()->SetInt("albedoMap", 6);
-    }
-
-    if (auto normalTex = material->GetTexture("normal"))
-    {
-        normalTex->Bind(7);
-        material->GetShader()->SetInt("normalMap", 7);
-    }
-    if (auto normalTex = material->GetTexture("roughness"))
-    {
-        normalTex->Bind(8);
-        material->GetShader()->SetInt("roughnessMap", 8);
-    }
+    material->BindTextures(material->GetShader());
 }
 
 void Entity::DrawMeshWithShader(Shader* shader) const
@@ -347,7 +335,7 @@ void Entity::DrawMeshWithShader(Shader* shader) const
     {        
         shader->SetMat4("model", mesh->matrix);
         BindTexturesToShader();
-        mesh->Render(material->GetShader());
+        mesh->Render(shader);
     }
 }
 HierarchyNode<RenderableMesh>* Entity::AddMesh(RenderableMesh *mesh, RenderableMesh *parent)
@@ -378,6 +366,14 @@ HierarchyNode<RenderableMesh>* Entity::AddMesh(RenderableMesh *mesh, RenderableM
     return newHier;
 }
 
+void Entity::ReleaseMeshes()
+{
+    for (HierarchyNode<RenderableMesh>* rootNode : meshHierarchy) delete rootNode;
+    meshHierarchy.clear();
+
+    for (RenderableMesh* mesh : meshes) delete mesh;
+    meshes.clear();
+}
 
 void Entity::AddScript(IScript *script)
 {
@@ -425,6 +421,20 @@ bool Entity::HasTag(const std::string & tag) const
     return std::find(tags.begin(), tags.end(), tag) != tags.end();
 }
 
+AABB Entity::GetWorldBounds() const
+{
+    // the mesh matrices already hold the entity transform (their transform has it as parent), as drawn
+    AABB bounds;
+    bool hasMeshBounds = false;
+    for (const RenderableMesh* mesh : meshes)
+        hasMeshBounds |= mesh->ExpandWorldBounds(bounds);
+    if (hasMeshBounds) return bounds;
+
+    // no mesh, or not loaded yet : box around the sphere enclosing the unit cube scaled by the entity
+    float radius = std::max(0.5f, 0.5f * transform.scale.GetMagnitude());
+    return AABB(transform.position - PulseEngine::Vector3(radius), transform.position + PulseEngine::Vector3(radius));
+}
+
 void Entity::Move(const PulseEngine::Vector3 &direction)
 {
     transform.position = transform.position + (direction * PulseEngineInstance->GetDeltaTime());
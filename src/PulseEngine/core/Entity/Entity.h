@@ -24,6 +24,7 @@
 #include "PulseEngine/core/PulseObject/TypeRegister/TypeRegister.h"
 #include "PulseEngine/core/SceneManager/HierarchyNode.h"
 #include "PulseEngine/core/Math/Transform/Transform.h"
+#include "PulseEngine/core/Math/Frustum/AABB.h"
 
 #include <string>
 #include <vector>
@@ -165,6 +166,11 @@ public:
     const PulseEngine::Vector3& GetRotation() const {return transform.rotation;}
     const PulseEngine::Vector3& GetScale() const {return transform.scale; }
     const PulseEngine::Mat4& GetMatrix() const { return entityMatrix; }
+    /**
+     * @brief World bounds used for culling : box around the bounding sphere of each mesh, at its world matrix.
+     * @note without mesh vertices : box around the sphere enclosing the unit cube scaled by the entity.
+     */
+    AABB GetWorldBounds() const;
     const std::size_t& GetGuid() const {return guid;}
     /**
      * @brief The Muid is a unique identifier for the entity within the map.
@@ -178,6 +184,10 @@ public:
     std::vector<RenderableMesh*>& GetMeshes() {return meshes; }
     std::vector<HierarchyNode<RenderableMesh>*>& GetMeshesHierarchy() {return meshHierarchy; }
     HierarchyNode<RenderableMesh>* AddMeshHierarchy(RenderableMesh* mesh, HierarchyNode<RenderableMesh>* parent);
+    /**
+     * @brief Delete the meshes of the entity (and their GPU buffers), done before deleting it (PulseEngineBackend::SwapRenderSnapshots).
+     */
+    void ReleaseMeshes();
 
     // ------------------------------------------------------------------------
     // Setters
@@ -193,6 +203,12 @@ public:
     BoxCollider* collider = nullptr;
     JPH::BodyID bodyID;
 
+    /**
+     * @brief Create the physic body of the entity at its position.
+     * @note Serialize does not make it : the scene loaders call it once the entity enters the scene.
+     */
+    void CreatePhysicBody();
+
     void AddTag(const std::string& tag);
     void RemoveTag(const std::string& tag);
 
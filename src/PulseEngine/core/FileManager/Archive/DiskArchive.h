@@ -6,6 +6,7 @@
 #include "common/common.h"
 #include "common/dllExport.h"
 
+#include <memory>
 #include <vector>
 #include <string>
 #include <cstring>
@@ -23,11 +24,11 @@ class PULSE_ENGINE_DLL_API DiskArchive : public Archive
 {
 public:
     explicit DiskArchive(const std::string& path, Mode mode)
-        : Archive(mode), fileReader(path), cursor(0)
+        : Archive(mode), fileReader(std::make_unique<FileReader>(path)), cursor(0)
     {
         if (IsLoading())
         {
-            buffer = fileReader.ReadAll();
+            buffer = fileReader->ReadAll();
             if (buffer.empty())
             {
                 EDITOR_WARN("DiskArchive: unable to read file or empty buffer (" << path << ")");
@@ -41,21 +42,33 @@ public:
         // (Optionnel) Magic header/version
         if (IsSaving())
         {
-            const uint32_t magic = 0x504C5345; // "PLSE"
-            AppendToBuffer(reinterpret_cast<const char*>(&magic), sizeof(magic));
+            WriteMagic();
         }
         else
         {
-            uint32_t magic = 0;
-            ReadFromBuffer(reinterpret_cast<char*>(&magic), sizeof(magic));
-            if (magic != 0x504C5345)
-            {
-                EDITOR_WARN("DiskArchive: invalid or incompatible file format (" << path << ")");
-                cursor = 0; // tente quand même de continuer
-            }
+            ReadMagic(path);
         }
     }
 
+    /**
+     * @brief Saving archive kept in memory, GetBuffer gives the bytes (lights block of the scene files).
+     */
+    DiskArchive()
+        : Archive(Mode::Saving), cursor(0)
+    {
+        WriteMagic();
+    }
+
+    /**
+     * @brief Loading archive over bytes already read (ReadAssetFile), no file is opened.
+     * @note SceneLoader reads the maps on a worker thread this way.
+     */
+    DiskArchive(std::vector<char>&& bytes, const std::string& path)
+        : Archive(Mode::Loading), buffer(std::move(bytes)), cursor(0)
+    {
+        ReadMagic(path);
+    }
+
     // =========================================================================
     // Sérialisation type-safe
     // =========================================================================
@@ -111,21 +124,40 @@ public:
     // =========================================================================
     void Finalize()
     {
-        if (IsSaving())
+        if (IsSaving() && fileReader)
         {
-            fileReader.WriteAll(buffer);
+            fileReader->WriteAll(buffer);
             EDITOR_LOG("DiskArchive: wrote " << buffer.size() << " bytes to disk.");
         }
     }
 
-    bool IsArchiveOpen() {return fileReader.IsOpen();}
+    const std::vector<char>& GetBuffer() const { return buffer; }
+
+    bool IsArchiveOpen() {return fileReader ? fileReader->IsOpen() : !buffer.empty();}
     bool IsArchiveEmpty() {return buffer.empty();}
 
 private:
-    FileReader fileReader;
+    std::unique_ptr<FileReader> fileReader;  ///< nullptr for an archive over bytes
     std::vector<char> buffer;
     size_t cursor;
 
+    void WriteMagic()
+    {
+        const uint32_t magic = 0x504C5345; // "PLSE"
+        AppendToBuffer(reinterpret_cast<const char*>(&magic), sizeof(magic));
+    }
+
+    void ReadMagic(const std::string& path)
+    {
+        uint32_t magic = 0;
+        ReadFromBuffer(reinterpret_cast<char*>(&magic), sizeof(magic));
+        if (magic != 0x504C5345)
+        {
+            EDITOR_WARN("DiskArchive: invalid or incompatible file format (" << path << ")");
+            cursor = 0; // tente quand même de continuer
+        }
+    }
+
     // =========================================================================
     // Fonctions internes
     // =========================================================================
@@ -103,7 +103,7 @@ FileType FileManager::GetFileType(const std::string &fileName)
     {
         return FileType::PULSE_ENTITY;
     }
-    else if (EndsWith(fileName, ".pmap"))
+    else if (EndsWith(fileName, ".pmap") || EndsWith(fileName, ".pworld"))
     {
         return FileType::MAP;
     }
@@ -1,4 +1,5 @@
 #include "FileReader.h"
+#include "PulseEngine/core/FileManager/Pak/PakManager.h"
 using namespace PulseEngine::FileSystem;
 
 FileReader::FileReader(const std::string &path)
@@ -24,10 +25,11 @@ FileReader::FileReader(const std::string &path)
 
     filePath = normalizedPath;
     std::string definePath = std::string(ASSET_PATH) + normalizedPath;
+    inPak = PakManager::GetInstance().Contains(normalizedPath);
 
 #ifdef PULSE_WINDOWS
     std::filesystem::path p(definePath);
-    if (!std::filesystem::exists(p))
+    if (!inPak && !std::filesystem::exists(p))
     {
         EDITOR_LOG("File at path " + definePath + " does not exist. Creating it");
 
@@ -53,6 +55,18 @@ FileReader::~FileReader()
 
 nlohmann::json FileReader::ToJson()
 {
+    if (inPak)
+    {
+        std::vector<char> buffer = ReadAll();
+        nlohmann::json js;
+        try {
+            js = nlohmann::json::parse(buffer.begin(), buffer.end());
+        } catch (const std::exception& e) {
+            EDITOR_LOG(std::string("JSON parse error: ") + e.what());
+        }
+        return js;
+    }
+
 #ifdef PULSE_WINDOWS
     std::ifstream* file = ReinterprateFileType<std::ifstream>();
     nlohmann::json js;
@@ -83,6 +97,8 @@ void FileReader::SaveJson(const nlohmann::json &js)
 
 bool FileReader::IsOpen()
 {
+    if (inPak) return true;
+
 #ifdef PULSE_WINDOWS
     std::ifstream* file = ReinterprateFileType<std::ifstream>();
     return file->is_open();
@@ -102,6 +118,13 @@ void FileReader::Close()
 
 std::vector<char> FileReader::ReadAll()
 {
+    if (inPak)
+    {
+        std::vector<char> buffer;
+        PakManager::GetInstance().Read(filePath, buffer);
+        return buffer;
+    }
+
 #ifdef PULSE_WINDOWS
     std::ifstream* file = new std::ifstream(std::string(ASSET_PATH) + filePath, std::ios::binary);
     
@@ -29,6 +29,7 @@ namespace PulseEngine::FileSystem
      * @brief This class is used for an easy to use files reading regardless of the platform.
      * It currently supports reading files as JSON objects using the nlohmann::json library.
      * @note the path to use is relative to "PulseEngineEditor/". so your file 'Assets/myfile.pconfig' will be search at 'PulseEngineEditor/Assets/myfile.pconfig'
+     * @note files found in a mounted .pak (see PakManager) are read from the pack, writes still go to the disk.
      */
     class PULSE_ENGINE_DLL_API FileReader
     {
@@ -48,6 +49,7 @@ namespace PulseEngine::FileSystem
         private:
             void* fileData;
             std::string filePath;
+            bool inPak = false;
     
             /**
              * @brief This function reinterprate the void* fileData to the final type wanted.
@@ -0,0 +1,178 @@
+#include "Lz4Block.h"
+
+#include <cstring>
+#include <vector>
+
+namespace
+{
+    constexpr std::size_t MIN_MATCH = 4;
+    constexpr std::size_t LAST_LITERALS = 5;   ///< the block always ends with 5 literals
+    constexpr std::size_t MF_LIMIT = 12;       ///< no match starts in the last 12 bytes
+    constexpr std::size_t MAX_OFFSET = 65535;
+    constexpr int HASH_BITS = 14;
+    constexpr uint32_t EMPTY_SLOT = 0xFFFFFFFFu;
+
+    uint32_t Read32(const uint8_t* p)
+    {
+        uint32_t value;
+        std::memcpy(&value, p, sizeof(value));
+        return value;
+    }
+
+    uint32_t Hash(uint32_t sequence)
+    {
+        return (sequence * 2654435761u) >> (32 - HASH_BITS);
+    }
+
+    /**
+     * @brief 15 in the token nibble, then the rest in bytes of 255.
+     */
+    bool WriteLength(uint8_t*& op, const uint8_t* end, std::size_t length)
+    {
+        while (length >= 255)
+        {
+            if (op >= end) return false;
+            *op++ = 255;
+            length -= 255;
+        }
+        if (op >= end) return false;
+        *op++ = (uint8_t)length;
+        return true;
+    }
+
+    bool ReadLength(const uint8_t*& ip, const uint8_t* end, std::size_t& length)
+    {
+        uint8_t byte;
+        do
+        {
+            if (ip >= end) return false;
+            byte = *ip++;
+            length += byte;
+        } while (byte == 255);
+        return true;
+    }
+
+    /**
+     * @brief Write one sequence : literals then a match, matchLength 0 for the last sequence of the block.
+     */
+    bool WriteSequence(uint8_t*& op, const uint8_t* end, const uint8_t* literals, std::size_t literalLength, std::size_t offset, std::size_t matchLength)
+    {
+        if (op >= end) return false;
+        uint8_t* token = op++;
+        *token = (uint8_t)((literalLength >= 15 ? 15 : literalLength) << 4);
+        if (literalLength >= 15 && !WriteLength(op, end, literalLength - 15)) return false;
+
+        if ((std::size_t)(end - op) < literalLength) return false;
+        if (literalLength > 0) std::memcpy(op, literals, literalLength);
+        op += literalLength;
+
+        if (matchLength == 0) return true;
+
+        if (end - op < 2) return false;
+        *op++ = (uint8_t)(offset & 0xFF);
+        *op++ = (uint8_t)(offset >> 8);
+
+        const std::size_t length = matchLength - MIN_MATCH;
+        *token |= (uint8_t)(length >= 15 ? 15 : length);
+        return length < 15 || WriteLength(op, end, length - 15);
+    }
+}
+
+std::size_t PulseEngine::FileSystem::Lz4::CompressBound(std::size_t size)
+{
+    return size + size / 255 + 16;
+}
+
+std::size_t PulseEngine::FileSystem::Lz4::Compress(const uint8_t* source, std::size_t size, uint8_t* destination, std::size_t capacity)
+{
+    uint8_t* op = destination;
+    const uint8_t* end = destination + capacity;
+    std::size_t anchor = 0;
+
+    if (size > MF_LIMIT)
+    {
+        std::vector<uint32_t> table((std::size_t)1 << HASH_BITS, EMPTY_SLOT);
+        const std::size_t matchLimit = size - LAST_LITERALS;
+        const std::size_t searchLimit = size - MF_LIMIT;
+
+        std::size_t ip = 0;
+        while (ip < searchLimit)
+        {
+            const uint32_t sequence = Read32(source + ip);
+            const uint32_t h = Hash(sequence);
+            std::size_t reference = table[h];
+            table[h] = (uint32_t)ip;
+
+            if (reference == EMPTY_SLOT || ip - reference > MAX_OFFSET || Read32(source + reference) != sequence)
+            {
+                // incompressible data is skipped faster and faster
+                ip += 1 + ((ip - anchor) >> 6);
+                continue;
+            }
+
+            while (ip > anchor && reference > 0 && source[ip - 1] == source[reference - 1])
+            {
+                --ip;
+                --reference;
+            }
+
+            std::size_t length = MIN_MATCH;
+            while (ip + length < matchLimit && source[ip + length] == source[reference + length]) ++length;
+
+            if (!WriteSequence(op, end, source + anchor, ip - anchor, ip - reference, length)) return 0;
+
+            ip += length;
+            anchor = ip;
+            if (ip - 2 < searchLimit) table[Hash(Read32(source + ip - 2))] = (uint32_t)(ip - 2);
+        }
+    }
+
+    if (!WriteSequence(op, end, source + anchor, size - anchor, 0, 0)) return 0;
+    return (std::size_t)(op - destination);
+}
+
+bool PulseEngine::FileSystem::Lz4::Decompress(const uint8_t* source, std::size_t sourceSize, uint8_t* destination, std::size_t destinationSize)
+{
+    const uint8_t* ip = source;
+    const uint8_t* iend = source + sourceSize;
+    uint8_t* op = destination;
+    uint8_t* oend = destination + destinationSize;
+
+    while (ip < iend)
+    {
+        const uint8_t token = *ip++;
+
+        std::size_t literalLength = token >> 4;
+        if (literalLength == 15 && !ReadLength(ip, iend, literalLength)) return false;
+        if (literalLength > (std::size_t)(iend - ip) || literalLength > (std::size_t)(oend - op)) return false;
+        if (literalLength > 0) std::memcpy(op, ip, literalLength);
+        ip += literalLength;
+        op += literalLength;
+
+        // the last sequence has no match
+        if (ip == iend) return op == oend;
+
+        if (iend - ip < 2) return false;
+        const std::size_t offset = (std::size_t)ip[0] | ((std::size_t)ip[1] << 8);
+        ip += 2;
+        if (offset == 0 || offset > (std::size_t)(op - destination)) return false;
+
+        std::size_t matchLength = token & 15;
+        if (matchLength == 15 && !ReadLength(ip, iend, matchLength)) return false;
+        matchLength += MIN_MATCH;
+        if (matchLength > (std::size_t)(oend - op)) return false;
+
+        const uint8_t* match = op - offset;
+        if (offset >= matchLength)
+        {
+            std::memcpy(op, match, matchLength);
+            op += matchLength;
+        }
+        else
+        {
+            // overlapping copy repeats the pattern
+            for (std::size_t i = 0; i < matchLength; ++i) *op++ = match[i];
+        }
+    }
+    return false;
+}
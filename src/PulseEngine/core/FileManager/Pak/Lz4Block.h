@@ -0,0 +1,40 @@
+/**
+ * @file Lz4Block.h
+ * @brief LZ4 block format (no frame, no checksum) used by the .pak entries.
+ * @details Greedy single hash table compressor : fast to build, decompression runs at memory speed.
+ * The output follows the LZ4 block specification, so the data can be read by the reference library as well.
+ * @version 0.1
+ * @date 2025-12-11
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+#ifndef LZ4BLOCK_H
+#define LZ4BLOCK_H
+
+#include "Common/dllExport.h"
+
+#include <cstddef>
+#include <cstdint>
+
+namespace PulseEngine::FileSystem::Lz4
+{
+    /**
+     * @brief Worst case size of Compress for size input bytes.
+     */
+    PULSE_ENGINE_DLL_API std::size_t CompressBound(std::size_t size);
+
+    /**
+     * @brief Compress size bytes of source into destination.
+     * @return the compressed size, 0 when destination is too small.
+     */
+    PULSE_ENGINE_DLL_API std::size_t Compress(const uint8_t* source, std::size_t size, uint8_t* destination, std::size_t capacity);
+
+    /**
+     * @brief Decompress a block into exactly destinationSize bytes.
+     * @return false on corrupted data or a size mismatch, never reads or writes out of the buffers.
+     */
+    PULSE_ENGINE_DLL_API bool Decompress(const uint8_t* source, std::size_t sourceSize, uint8_t* destination, std::size_t destinationSize);
+}
+
+#endif // LZ4BLOCK_H
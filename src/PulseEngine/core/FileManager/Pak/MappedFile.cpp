@@ -0,0 +1,138 @@
+#include "MappedFile.h"
+
+#ifdef PULSE_WINDOWS
+    #ifndef WIN32_LEAN_AND_MEAN
+    #define WIN32_LEAN_AND_MEAN
+    #endif
+    #ifndef NOMINMAX
+    #define NOMINMAX
+    #endif
+    #include <windows.h>
+#else
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+using namespace PulseEngine::FileSystem;
+
+MappedFile::~MappedFile()
+{
+    Close();
+}
+
+#ifdef PULSE_WINDOWS
+
+bool MappedFile::Open(const std::string& path)
+{
+    Close();
+
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                              FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    if (file == INVALID_HANDLE_VALUE) return false;
+
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart == 0)
+    {
+        CloseHandle(file);
+        return false;
+    }
+
+    HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (!mapping)
+    {
+        CloseHandle(file);
+        return false;
+    }
+
+    const void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    if (!view)
+    {
+        CloseHandle(mapping);
+        CloseHandle(file);
+        return false;
+    }
+
+    fileHandle = file;
+    mappingHandle = mapping;
+    data = static_cast<const uint8_t*>(view);
+    size = (std::size_t)fileSize.QuadPart;
+    return true;
+}
+
+void MappedFile::Close()
+{
+    if (data) UnmapViewOfFile(data);
+    if (mappingHandle) CloseHandle(mappingHandle);
+    if (fileHandle) CloseHandle(fileHandle);
+    data = nullptr;
+    size = 0;
+    mappingHandle = nullptr;
+    fileHandle = nullptr;
+}
+
+void MappedFile::Prefetch(std::size_t offset, std::size_t length) const
+{
+#if defined(_WIN32_WINNT) && _WIN32_WINNT >= 0x0602
+    if (!data || offset >= size) return;
+    WIN32_MEMORY_RANGE_ENTRY range;
+    range.VirtualAddress = const_cast<uint8_t*>(data + offset);
+    range.NumberOfBytes = length < size - offset ? length : size - offset;
+    PrefetchVirtualMemory(GetCurrentProcess(), 1, &range, 0);
+#else
+    (void)offset;
+    (void)length;
+#endif
+}
+
+#else
+
+bool MappedFile::Open(const std::string& path)
+{
+    Close();
+
+    const int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0) return false;
+
+    struct stat info;
+    if (fstat(fd, &info) != 0 || info.st_size == 0)
+    {
+        close(fd);
+        return false;
+    }
+
+    void* view = mmap(nullptr, (std::size_t)info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (view == MAP_FAILED)
+    {
+        close(fd);
+        return false;
+    }
+
+    fileDescriptor = fd;
+    data = static_cast<const uint8_t*>(view);
+    size = (std::size_t)info.st_size;
+    return true;
+}
+
+void MappedFile::Close()
+{
+    if (data) munmap(const_cast<uint8_t*>(data), size);
+    if (fileDescriptor >= 0) close(fileDescriptor);
+    data = nullptr;
+    size = 0;
+    fileDescriptor = -1;
+}
+
+void MappedFile::Prefetch(std::size_t offset, std::size_t length) const
+{
+    if (!data || offset >= size) return;
+
+    // madvise wants a page aligned address
+    const std::size_t page = (std::size_t)sysconf(_SC_PAGESIZE);
+    const std::size_t begin = offset - offset % page;
+    const std::size_t end = length < size - offset ? offset + length : size;
+    madvise(const_cast<uint8_t*>(data + begin), end - begin, MADV_WILLNEED);
+}
+
+#endif
@@ -0,0 +1,59 @@
+/**
+ * @file MappedFile.h
+ * @brief Read-only memory mapping of a whole file.
+ * @details The pages are loaded by the OS on first access, the same bytes are shared by every reader and thread.
+ * @version 0.1
+ * @date 2025-12-11
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+#ifndef MAPPEDFILE_H
+#define MAPPEDFILE_H
+
+#include "Common/dllExport.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace PulseEngine::FileSystem
+{
+    class PULSE_ENGINE_DLL_API MappedFile
+    {
+    public:
+        MappedFile() = default;
+        ~MappedFile();
+
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+
+        /**
+         * @brief Map the file at path (relative to the working directory). False when missing or empty.
+         */
+        bool Open(const std::string& path);
+        void Close();
+
+        /**
+         * @brief Ask the OS to read [offset, offset + size) ahead, in one sequential pass.
+         */
+        void Prefetch(std::size_t offset, std::size_t size) const;
+
+        bool IsOpen() const { return data != nullptr; }
+        const uint8_t* Data() const { return data; }
+        std::size_t Size() const { return size; }
+
+    private:
+        const uint8_t* data = nullptr;
+        std::size_t size = 0;
+
+    #ifdef PULSE_WINDOWS
+        void* fileHandle = nullptr;
+        void* mappingHandle = nullptr;
+    #else
+        int fileDescriptor = -1;
+    #endif
+    };
+}
+
+#endif // MAPPEDFILE_H
@@ -0,0 +1,170 @@
+#include "PakArchive.h"
+#include "Common/EditorDefines.h"
+#include "PulseEngine/core/FileManager/Pak/Lz4Block.h"
+#include "PulseEngine/core/GUID/GuidGenerator.h"
+
+#include <cstring>
+
+using namespace PulseEngine::FileSystem;
+
+std::string PulseEngine::FileSystem::NormalizePakPath(const std::string& path)
+{
+    std::string normalized;
+    normalized.reserve(path.size());
+    for (char c : path)
+    {
+        char lower = c == '\\' ? '/' : c;
+        if (lower >= 'A' && lower <= 'Z') lower = (char)(lower - 'A' + 'a');
+        if (lower == '/' && (normalized.empty() || normalized.back() == '/')) continue;
+        normalized.push_back(lower);
+    }
+
+    // paths given from the project root instead of ASSET_PATH
+    const std::string prefix = "pulseengineeditor/";
+    if (normalized.rfind(prefix, 0) == 0) normalized.erase(0, prefix.size());
+    return normalized;
+}
+
+uint64_t PulseEngine::FileSystem::HashPakPath(const std::string& path)
+{
+    const std::string normalized = NormalizePakPath(path);
+    return PulseEngine::Registry::HashContent(normalized.data(), normalized.size());
+}
+
+bool PakArchive::Open(const std::string& path)
+{
+    Close();
+    if (!file.Open(path)) return false;
+
+    const uint8_t* base = file.Data();
+    const std::size_t size = file.Size();
+
+    auto fail = [&](const char* reason)
+    {
+        EDITOR_ERROR("Invalid pak " << path << ": " << reason);
+        Close();
+        return false;
+    };
+
+    if (size < sizeof(PakHeader)) return fail("truncated header");
+    header = reinterpret_cast<const PakHeader*>(base);
+    if (header->magic != PAK_MAGIC) return fail("bad magic");
+    if (header->version != PAK_VERSION) return fail("unsupported version");
+    if (header->slotCount == 0 || (header->slotCount & (header->slotCount - 1)) != 0 || header->slotCount < header->entryCount)
+        return fail("bad slot count");
+
+    const uint64_t entriesEnd = sizeof(PakHeader) + (uint64_t)header->entryCount * sizeof(PakEntry);
+    const uint64_t slotsEnd = entriesEnd + 2ull * header->slotCount * sizeof(uint32_t);
+    if (slotsEnd > size || header->stringsOffset < slotsEnd || header->stringsOffset + header->stringsSize > size)
+        return fail("truncated table of contents");
+    if (header->dataOffset > size || header->dataSize > size - header->dataOffset) return fail("truncated data");
+
+    entries = reinterpret_cast<const PakEntry*>(base + sizeof(PakHeader));
+    guidSlots = reinterpret_cast<const uint32_t*>(base + entriesEnd);
+    pathSlots = guidSlots + header->slotCount;
+    strings = reinterpret_cast<const char*>(base + header->stringsOffset);
+
+    for (uint32_t i = 0; i < header->entryCount; ++i)
+    {
+        const PakEntry& entry = entries[i];
+        if (entry.offset > size || entry.storedSize > size - entry.offset) return fail("entry out of the file");
+        if ((uint64_t)entry.pathOffset + entry.pathLength > header->stringsSize) return fail("entry path out of the string table");
+        if (entry.codec == (uint8_t)PakCodec::Stored && entry.storedSize != entry.size) return fail("stored entry size mismatch");
+        if (entry.codec > (uint8_t)PakCodec::LZ4) return fail("unknown codec");
+    }
+
+    pakPath = path;
+    EDITOR_LOG("Mounted pak " << path << " (" << header->entryCount << " entries, " << size / 1024 << " KB)");
+    return true;
+}
+
+void PakArchive::Close()
+{
+    file.Close();
+    pakPath.clear();
+    header = nullptr;
+    entries = nullptr;
+    guidSlots = nullptr;
+    pathSlots = nullptr;
+    strings = nullptr;
+}
+
+const PakEntry* PakArchive::Find(const uint32_t* slots, uint64_t key, bool byGuid) const
+{
+    if (!header) return nullptr;
+
+    const uint32_t mask = header->slotCount - 1;
+    for (uint32_t probe = 0, slot = (uint32_t)key & mask; probe < header->slotCount; ++probe, slot = (slot + 1) & mask)
+    {
+        const uint32_t index = slots[slot];
+        if (index == 0 || index > header->entryCount) return nullptr;
+
+        const PakEntry& entry = entries[index - 1];
+        if ((byGuid ? entry.guid : entry.pathHash) == key) return &entry;
+    }
+    return nullptr;
+}
+
+const PakEntry* PakArchive::FindByGuid(uint64_t guid) const
+{
+    return Find(guidSlots, guid, true);
+}
+
+const PakEntry* PakArchive::FindByPath(const std::string& path) const
+{
+    return Find(pathSlots, HashPakPath(path), false);
+}
+
+bool PakArchive::Read(const PakEntry& entry, uint8_t* destination) const
+{
+    if (!header) return false;
+
+    const uint8_t* stored = file.Data() + entry.offset;
+    if (entry.codec == (uint8_t)PakCodec::Stored)
+    {
+        if (entry.size > 0) std::memcpy(destination, stored, (std::size_t)entry.size);
+        return true;
+    }
+
+    if (!Lz4::Decompress(stored, (std::size_t)entry.storedSize, destination, (std::size_t)entry.size))
+    {
+        EDITOR_ERROR("Corrupted pak entry " << GetEntryPath(entry) << " in " << pakPath);
+        return false;
+    }
+    return true;
+}
+
+bool PakArchive::Read(const PakEntry& entry, std::vector<char>& out) const
+{
+    out.resize((std::size_t)entry.size);
+    if (Read(entry, reinterpret_cast<uint8_t*>(out.data()))) return true;
+    out.clear();
+    return false;
+}
+
+bool PakArchive::Read(const PakEntry& entry, std::vector<uint8_t>& out) const
+{
+    out.resize((std::size_t)entry.size);
+    if (Read(entry, out.data())) return true;
+    out.clear();
+    return false;
+}
+
+const uint8_t* PakArchive::GetView(const PakEntry& entry) const
+{
+    if (!header || entry.codec != (uint8_t)PakCodec::Stored) return nullptr;
+    return file.Data() + entry.offset;
+}
+
+std::string PakArchive::GetEntryPath(const PakEntry& entry) const
+{
+    if (!strings) return std::string();
+    return std::string(strings + entry.pathOffset, entry.pathLength);
+}
+
+void PakArchive::PrefetchData(std::size_t maxBytes) const
+{
+    if (!header) return;
+    const std::size_t size = header->dataSize < maxBytes ? (std::size_t)header->dataSize : maxBytes;
+    file.Prefetch((std::size_t)header->dataOffset, size);
+}
@@ -0,0 +1,132 @@
+/**
+ * @file PakArchive.h
+ * @brief Packed asset archive (.pak) : every asset of the game build in one memory mapped file.
+ * @details Layout, little endian :
+ * - PakHeader
+ * - PakEntry[entryCount]
+ * - uint32 guidSlots[slotCount], uint32 pathSlots[slotCount] : open addressing tables (entry index + 1, 0 = empty),
+ *   linear probing from (key & (slotCount - 1))
+ * - path strings
+ * - entry data, each entry starting on PAK_DATA_ALIGNMENT so stored (uncompressed) data can be handed to the GPU in place
+ *
+ * The table of contents sits at the front of the file : opening a pack touches a few pages, then the entries
+ * are read in the order the build wrote them (one sequential pass on a cold disk instead of one open per file).
+ * Entries are keyed twice : by asset GUID (guidCollection*.puid, or the path hash for files without a GUID)
+ * and by path (relative to ASSET_PATH, case insensitive) so the existing loaders keep working with paths.
+ * @version 0.1
+ * @date 2025-12-11
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+#ifndef PAKARCHIVE_H
+#define PAKARCHIVE_H
+
+#include "Common/dllExport.h"
+#include "PulseEngine/core/FileManager/Pak/MappedFile.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace PulseEngine::FileSystem
+{
+    constexpr uint32_t PAK_MAGIC = 0x4B415050; // "PPAK"
+    constexpr uint16_t PAK_VERSION = 1;
+    constexpr uint64_t PAK_DATA_ALIGNMENT = 256;
+
+    enum class PakCodec : uint8_t
+    {
+        Stored = 0,
+        LZ4 = 1
+    };
+
+#pragma pack(push, 1)
+    struct PakHeader
+    {
+        uint32_t magic = PAK_MAGIC;
+        uint16_t version = PAK_VERSION;
+        uint16_t flags = 0;
+        uint32_t entryCount = 0;
+        uint32_t slotCount = 0;         ///< power of two, at least twice entryCount
+        uint64_t stringsOffset = 0;
+        uint64_t stringsSize = 0;
+        uint64_t dataOffset = 0;        ///< first entry data, everything before is the table of contents
+        uint64_t dataSize = 0;
+    };
+
+    struct PakEntry
+    {
+        uint64_t guid = 0;
+        uint64_t pathHash = 0;
+        uint64_t contentHash = 0;       ///< HashContent of the uncompressed bytes
+        uint64_t offset = 0;            ///< from the start of the file
+        uint64_t storedSize = 0;
+        uint64_t size = 0;              ///< uncompressed
+        uint32_t pathOffset = 0;        ///< in the string table
+        uint16_t pathLength = 0;
+        uint8_t codec = 0;              ///< PakCodec
+        uint8_t reserved = 0;
+    };
+#pragma pack(pop)
+
+    /**
+     * @brief "PulseEngineEditor\\Materials//cube.mat" -> "materials/cube.mat", the form hashed in the table.
+     */
+    PULSE_ENGINE_DLL_API std::string NormalizePakPath(const std::string& path);
+    PULSE_ENGINE_DLL_API uint64_t HashPakPath(const std::string& path);
+
+    /**
+     * @brief Read-only view over a .pak file. Lookups and reads are const and safe from any thread.
+     */
+    class PULSE_ENGINE_DLL_API PakArchive
+    {
+    public:
+        bool Open(const std::string& path);
+        void Close();
+        bool IsOpen() const { return file.IsOpen(); }
+
+        const PakEntry* FindByGuid(uint64_t guid) const;
+        const PakEntry* FindByPath(const std::string& path) const;
+
+        /**
+         * @brief Uncompressed content of an entry (decompressed when needed).
+         */
+        bool Read(const PakEntry& entry, std::vector<char>& out) const;
+        bool Read(const PakEntry& entry, std::vector<uint8_t>& out) const;
+
+        /**
+         * @brief Uncompressed content of an entry into destination (entry.size bytes).
+         */
+        bool Read(const PakEntry& entry, uint8_t* destination) const;
+
+        /**
+         * @brief Bytes of a stored entry, in place in the mapping (PAK_DATA_ALIGNMENT aligned). nullptr if compressed.
+         */
+        const uint8_t* GetView(const PakEntry& entry) const;
+
+        std::string GetEntryPath(const PakEntry& entry) const;
+        const PakEntry* GetEntries() const { return entries; }
+        uint32_t GetEntryCount() const { return header ? header->entryCount : 0; }
+        const std::string& GetPath() const { return pakPath; }
+
+        /**
+         * @brief Read the first maxBytes of the data section ahead, done at mount so the first loads hit memory.
+         */
+        void PrefetchData(std::size_t maxBytes) const;
+
+    private:
+        const PakEntry* Find(const uint32_t* slots, uint64_t key, bool byGuid) const;
+
+        MappedFile file;
+        std::string pakPath;
+        const PakHeader* header = nullptr;
+        const PakEntry* entries = nullptr;
+        const uint32_t* guidSlots = nullptr;
+        const uint32_t* pathSlots = nullptr;
+        const char* strings = nullptr;
+    };
+}
+
+#endif // PAKARCHIVE_H
@@ -0,0 +1,126 @@
+#include "PakManager.h"
+#include "Common/EditorDefines.h"
+
+#include <filesystem>
+#include <fstream>
+#include <mutex>
+
+using namespace PulseEngine::FileSystem;
+
+PakManager& PakManager::GetInstance()
+{
+    static PakManager instance;
+    return instance;
+}
+
+bool PakManager::Mount(const std::string& pakPath, std::size_t prefetchBytes)
+{
+    auto pak = std::make_unique<PakArchive>();
+    if (!pak->Open(pakPath)) return false;
+    if (prefetchBytes > 0) pak->PrefetchData(prefetchBytes);
+
+    std::unique_lock<std::shared_mutex> lock(mutex);
+    paks.push_back(std::move(pak));
+    return true;
+}
+
+void PakManager::UnmountAll()
+{
+    std::unique_lock<std::shared_mutex> lock(mutex);
+    paks.clear();
+}
+
+bool PakManager::Contains(const std::string& assetPath) const
+{
+    std::shared_lock<std::shared_mutex> lock(mutex);
+    for (auto it = paks.rbegin(); it != paks.rend(); ++it)
+    {
+        if ((*it)->FindByPath(assetPath)) return true;
+    }
+    return false;
+}
+
+bool PakManager::ContainsGuid(uint64_t guid) const
+{
+    std::shared_lock<std::shared_mutex> lock(mutex);
+    for (auto it = paks.rbegin(); it != paks.rend(); ++it)
+    {
+        if ((*it)->FindByGuid(guid)) return true;
+    }
+    return false;
+}
+
+template <typename Buffer>
+bool PakManager::ReadPath(const std::string& assetPath, Buffer& out) const
+{
+    std::shared_lock<std::shared_mutex> lock(mutex);
+    for (auto it = paks.rbegin(); it != paks.rend(); ++it)
+    {
+        if (const PakEntry* entry = (*it)->FindByPath(assetPath)) return (*it)->Read(*entry, out);
+    }
+    return false;
+}
+
+bool PakManager::Read(const std::string& assetPath, std::vector<char>& out) const
+{
+    return ReadPath(assetPath, out);
+}
+
+bool PakManager::Read(const std::string& assetPath, std::vector<uint8_t>& out) const
+{
+    return ReadPath(assetPath, out);
+}
+
+bool PakManager::ReadGuid(uint64_t guid, std::vector<char>& out) const
+{
+    std::shared_lock<std::shared_mutex> lock(mutex);
+    for (auto it = paks.rbegin(); it != paks.rend(); ++it)
+    {
+        if (const PakEntry* entry = (*it)->FindByGuid(guid)) return (*it)->Read(*entry, out);
+    }
+    return false;
+}
+
+std::size_t PakManager::GetMountedCount() const
+{
+    std::shared_lock<std::shared_mutex> lock(mutex);
+    return paks.size();
+}
+
+namespace
+{
+    template <typename Buffer>
+    bool ReadAsset(const std::string& assetPath, Buffer& out)
+    {
+        if (PakManager::GetInstance().Read(assetPath, out)) return true;
+
+        std::ifstream file(std::string(ASSET_PATH) + assetPath, std::ios::binary);
+        if (!file.is_open()) return false;
+
+        file.seekg(0, std::ios::end);
+        const std::streamsize size = file.tellg();
+        file.seekg(0, std::ios::beg);
+        if (size < 0) return false;
+
+        out.resize((std::size_t)size);
+        if (size > 0) file.read(reinterpret_cast<char*>(out.data()), size);
+        return file.good() || file.eof();
+    }
+}
+
+bool PulseEngine::FileSystem::ReadAssetFile(const std::string& assetPath, std::vector<char>& out)
+{
+    return ReadAsset(assetPath, out);
+}
+
+bool PulseEngine::FileSystem::ReadAssetFile(const std::string& assetPath, std::vector<uint8_t>& out)
+{
+    return ReadAsset(assetPath, out);
+}
+
+bool PulseEngine::FileSystem::AssetExists(const std::string& assetPath)
+{
+    if (PakManager::GetInstance().Contains(assetPath)) return true;
+    std::error_code ec;
+    return std::filesystem::is_regular_file(std::string(ASSET_PATH) + assetPath, ec);
+}
@@ -0,0 +1,67 @@
+/**
+ * @file PakManager.h
+ * @brief Mounted .pak files and the asset read path shared by the loaders.
+ * @details ReadAssetFile looks in the mounted packs first (last mounted wins), then on disk under ASSET_PATH :
+ * the editor keeps working on loose files, the game build reads everything from its pack.
+ * @version 0.1
+ * @date 2025-12-11
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+#ifndef PAKMANAGER_H
+#define PAKMANAGER_H
+
+#include "Common/dllExport.h"
+#include "PulseEngine/core/FileManager/Pak/PakArchive.h"
+
+#include <cstdint>
+#include <memory>
+#include <shared_mutex>
+#include <string>
+#include <vector>
+
+namespace PulseEngine::FileSystem
+{
+    /// @brief Pack written by the game build, relative to the game working directory.
+    static const std::string DEFAULT_PAK_PATH = "assets/PulseEngine.pak";
+
+    class PULSE_ENGINE_DLL_API PakManager
+    {
+    public:
+        static PakManager& GetInstance();
+
+        /**
+         * @brief Map a pack and read up to prefetchBytes of it ahead.
+         */
+        bool Mount(const std::string& pakPath, std::size_t prefetchBytes = 256ull * 1024 * 1024);
+        void UnmountAll();
+
+        bool Contains(const std::string& assetPath) const;
+        bool ContainsGuid(uint64_t guid) const;
+
+        bool Read(const std::string& assetPath, std::vector<char>& out) const;
+        bool Read(const std::string& assetPath, std::vector<uint8_t>& out) const;
+        bool ReadGuid(uint64_t guid, std::vector<char>& out) const;
+
+        std::size_t GetMountedCount() const;
+
+    private:
+        PakManager() = default;
+
+        template <typename Buffer>
+        bool ReadPath(const std::string& assetPath, Buffer& out) const;
+
+        mutable std::shared_mutex mutex;
+        std::vector<std::unique_ptr<PakArchive>> paks;
+    };
+
+    /**
+     * @brief Content of an asset (path relative to ASSET_PATH), from a mounted pack or from the disk.
+     */
+    PULSE_ENGINE_DLL_API bool ReadAssetFile(const std::string& assetPath, std::vector<char>& out);
+    PULSE_ENGINE_DLL_API bool ReadAssetFile(const std::string& assetPath, std::vector<uint8_t>& out);
+    PULSE_ENGINE_DLL_API bool AssetExists(const std::string& assetPath);
+}
+
+#endif // PAKMANAGER_H
@@ -0,0 +1,165 @@
+#include "PakWriter.h"
+#include "PulseEngine/core/FileManager/Pak/Lz4Block.h"
+#include "PulseEngine/core/GUID/GuidGenerator.h"
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+
+using namespace PulseEngine::FileSystem;
+
+namespace
+{
+    uint64_t AlignUp(uint64_t value, uint64_t alignment)
+    {
+        return (value + alignment - 1) / alignment * alignment;
+    }
+
+    /**
+     * @brief Insert entry index into an open addressing table, the reader probes the same way.
+     */
+    void InsertSlot(std::vector<uint32_t>& slots, uint64_t key, uint32_t index)
+    {
+        const uint32_t mask = (uint32_t)slots.size() - 1;
+        uint32_t slot = (uint32_t)key & mask;
+        while (slots[slot] != 0) slot = (slot + 1) & mask;
+        slots[slot] = index + 1;
+    }
+}
+
+bool PakWriter::AddFile(const std::string& sourcePath, const std::string& pakPath, uint64_t guid, bool allowCompression)
+{
+    PendingFile file;
+    file.sourcePath = sourcePath;
+    file.pakPath = pakPath;
+    file.pathHash = HashPakPath(pakPath);
+    file.guid = guid != 0 ? guid : file.pathHash;
+    file.allowCompression = allowCompression;
+
+    if (usedPaths.count(file.pathHash) || usedGuids.count(file.guid)) return false;
+    usedPaths.insert(file.pathHash);
+    usedGuids.insert(file.guid);
+
+    files.push_back(std::move(file));
+    return true;
+}
+
+PakWriteResult PakWriter::Write(const std::string& destinationPath) const
+{
+    PakWriteResult result;
+    if (files.size() > 0xFFFFFFFEull)
+    {
+        result.error = "too many files";
+        return result;
+    }
+
+    PakHeader header;
+    header.entryCount = (uint32_t)files.size();
+    header.slotCount = 16;
+    while (header.slotCount < header.entryCount * 2) header.slotCount *= 2;
+
+    std::vector<PakEntry> entries(files.size());
+    std::vector<uint32_t> guidSlots(header.slotCount, 0);
+    std::vector<uint32_t> pathSlots(header.slotCount, 0);
+    std::string strings;
+
+    for (std::size_t i = 0; i < files.size(); ++i)
+    {
+        const std::string stored = NormalizePakPath(files[i].pakPath);
+        entries[i].guid = files[i].guid;
+        entries[i].pathHash = files[i].pathHash;
+        entries[i].pathOffset = (uint32_t)strings.size();
+        entries[i].pathLength = (uint16_t)std::min<std::size_t>(stored.size(), 0xFFFF);
+        strings.append(stored, 0, entries[i].pathLength);
+
+        InsertSlot(guidSlots, entries[i].guid, (uint32_t)i);
+        InsertSlot(pathSlots, entries[i].pathHash, (uint32_t)i);
+    }
+
+    header.stringsOffset = sizeof(PakHeader) + entries.size() * sizeof(PakEntry) + 2ull * header.slotCount * sizeof(uint32_t);
+    header.stringsSize = strings.size();
+    header.dataOffset = AlignUp(header.stringsOffset + header.stringsSize, PAK_DATA_ALIGNMENT);
+
+    std::error_code ec;
+    const std::filesystem::path destination(destinationPath);
+    if (destination.has_parent_path()) std::filesystem::create_directories(destination.parent_path(), ec);
+
+    std::ofstream out(destinationPath, std::ios::binary | std::ios::trunc);
+    if (!out.is_open())
+    {
+        result.error = "can't write " + destinationPath;
+        return result;
+    }
+
+    // the table of contents is written last, once the offsets are known
+    uint64_t cursor = header.dataOffset;
+    out.seekp((std::streamoff)cursor);
+
+    std::vector<uint8_t> compressed;
+    for (std::size_t i = 0; i < files.size(); ++i)
+    {
+        std::ifstream in(files[i].sourcePath, std::ios::binary);
+        if (!in.is_open())
+        {
+            result.error = "can't read " + files[i].sourcePath;
+            return result;
+        }
+        const std::vector<uint8_t> bytes((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+
+        PakEntry& entry = entries[i];
+        entry.size = bytes.size();
+        entry.contentHash = PulseEngine::Registry::HashContent(bytes.data(), bytes.size());
+        entry.codec = (uint8_t)PakCodec::Stored;
+
+        const uint8_t* data = bytes.data();
+        std::size_t dataSize = bytes.size();
+
+        if (files[i].allowCompression && bytes.size() >= 64)
+        {
+            compressed.resize(Lz4::CompressBound(bytes.size()));
+            const std::size_t packed = Lz4::Compress(bytes.data(), bytes.size(), compressed.data(), compressed.size());
+            if (packed != 0 && packed <= bytes.size() - bytes.size() / 8)
+            {
+                entry.codec = (uint8_t)PakCodec::LZ4;
+                data = compressed.data();
+                dataSize = packed;
+                ++result.compressedCount;
+            }
+        }
+
+        entry.offset = cursor;
+        entry.storedSize = dataSize;
+        out.write(reinterpret_cast<const char*>(data), (std::streamsize)dataSize);
+
+        const uint64_t next = AlignUp(cursor + dataSize, PAK_DATA_ALIGNMENT);
+        const std::vector<char> padding((std::size_t)(next - cursor - dataSize), 0);
+        out.write(padding.data(), (std::streamsize)padding.size());
+        cursor = next;
+
+        result.sourceBytes += bytes.size();
+    }
+    header.dataSize = cursor - header.dataOffset;
+
+    out.seekp(0);
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    out.write(reinterpret_cast<const char*>(entries.data()), (std::streamsize)(entries.size() * sizeof(PakEntry)));
+    out.write(reinterpret_cast<const char*>(guidSlots.data()), (std::streamsize)(guidSlots.size() * sizeof(uint32_t)));
+    out.write(reinterpret_cast<const char*>(pathSlots.data()), (std::streamsize)(pathSlots.size() * sizeof(uint32_t)));
+    out.write(strings.data(), (std::streamsize)strings.size());
+
+    const uint64_t tocEnd = header.stringsOffset + header.stringsSize;
+    const std::vector<char> padding((std::size_t)(header.dataOffset - tocEnd), 0);
+    out.write(padding.data(), (std::streamsize)padding.size());
+
+    if (!out.good())
+    {
+        result.error = "write error on " + destinationPath;
+        return result;
+    }
+
+    result.success = true;
+    result.entryCount = header.entryCount;
+    result.pakBytes = cursor;
+    return result;
+}
@@ -0,0 +1,70 @@
+/**
+ * @file PakWriter.h
+ * @brief Builds a .pak file (see PakArchive.h) from files on disk.
+ * @details Entries are written in the order they were added : add them in the order the game loads them.
+ * Each entry is compressed with LZ4 and kept compressed only when it saves at least 1/8 of the size
+ * (block compressed textures and already compressed sources are usually stored as is).
+ * @version 0.1
+ * @date 2025-12-11
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+#ifndef PAKWRITER_H
+#define PAKWRITER_H
+
+#include "Common/dllExport.h"
+#include "PulseEngine/core/FileManager/Pak/PakArchive.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+namespace PulseEngine::FileSystem
+{
+    struct PakWriteResult
+    {
+        bool success = false;
+        std::string error;
+        uint32_t entryCount = 0;
+        uint32_t compressedCount = 0;
+        uint64_t sourceBytes = 0;
+        uint64_t pakBytes = 0;
+    };
+
+    class PULSE_ENGINE_DLL_API PakWriter
+    {
+    public:
+        /**
+         * @brief Queue a file for the pack.
+         * @param sourcePath file to read when writing.
+         * @param pakPath path the game asks for, relative to ASSET_PATH.
+         * @param guid asset GUID, 0 to use the path hash.
+         * @param allowCompression false for data meant to be used in place (GetView).
+         * @return false when pakPath (or the guid) is already in the pack.
+         */
+        bool AddFile(const std::string& sourcePath, const std::string& pakPath, uint64_t guid = 0, bool allowCompression = true);
+
+        PakWriteResult Write(const std::string& destinationPath) const;
+
+        std::size_t GetFileCount() const { return files.size(); }
+
+    private:
+        struct PendingFile
+        {
+            std::string sourcePath;
+            std::string pakPath;
+            uint64_t guid = 0;
+            uint64_t pathHash = 0;
+            bool allowCompression = true;
+        };
+
+        std::vector<PendingFile> files;
+        std::unordered_set<uint64_t> usedPaths;
+        std::unordered_set<uint64_t> usedGuids;
+    };
+}
+
+#endif // PAKWRITER_H
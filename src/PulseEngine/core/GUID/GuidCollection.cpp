@@ -1,18 +1,17 @@
 #include "GuidCollection.h"
 #include "GuidGenerator.h"
+#include "PulseEngine/core/FileManager/Pak/PakManager.h"
 
 GuidCollection::GuidCollection(const std::string &collectionPath)
 {
-    std::ifstream file(std::string(ASSET_PATH) + "EngineConfig/" + collectionPath);
-    if (!file.is_open())
+    std::vector<char> content;
+    if (!PulseEngine::FileSystem::ReadAssetFile("EngineConfig/" + collectionPath, content))
     {
         EDITOR_ERROR("Could not open GUID collection file: " + collectionPath);
         return;
     }
 
-    nlohmann::json_abi_v3_12_0::json jsonData;
-    file >> jsonData;
-    file.close();
+    nlohmann::json_abi_v3_12_0::json jsonData = nlohmann::json_abi_v3_12_0::json::parse(content.begin(), content.end());
 
     collectionName = collectionPath;
 
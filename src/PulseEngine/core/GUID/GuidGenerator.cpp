@@ -42,4 +42,16 @@ namespace PulseEngine::Registry
     
         return currentHash;  // returns same value every time for the same path
     }
+
+    std::uint64_t PULSE_ENGINE_DLL_API HashContent(const void* data, std::size_t size, std::uint64_t seed)
+    {
+        const unsigned char* bytes = static_cast<const unsigned char*>(data);
+        std::uint64_t hash = seed;
+        for (std::size_t i = 0; i < size; ++i)
+        {
+            hash ^= bytes[i];
+            hash *= 1099511628211ull;
+        }
+        return hash ? hash : 1;  // 0 is kept for "no content"
+    }
 }
@@ -34,6 +34,7 @@
 // #include "Common/common.h"
 #include "Common/dllExport.h"
 #include <string>
+#include <cstdint>
 
 namespace PulseEngine::Registry
 {
@@ -62,5 +63,18 @@ namespace PulseEngine::Registry
      */
     std::size_t PULSE_ENGINE_DLL_API GenerateGUIDFromPathAndMap(const std::string& filepath, const std::string& mapName);
 
+    /**
+     * @brief Deterministic 64 bit hash (FNV-1a) of a file content.
+     * 
+     * @param data Bytes of the file.
+     * @param size Number of bytes.
+     * @param seed Previous hash, to chain several buffers.
+     * @return The hash, never 0.
+     * 
+     * @note Unlike the path GUIDs, two files with the same bytes get the same hash :
+     * used to share identical assets and to detect the ones that did not change since the last build.
+     */
+    std::uint64_t PULSE_ENGINE_DLL_API HashContent(const void* data, std::size_t size, std::uint64_t seed = 14695981039346656037ull);
+
 }
 #endif // GUIDGENERATOR_H
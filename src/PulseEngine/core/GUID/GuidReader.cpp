@@ -11,11 +11,15 @@
 #include "PulseEngine/CustomScripts/IScripts.h"
 #include "PulseEngine/core/Material/Material.h"
 #include "PulseEngine/core/Material/Texture.h"
+#include "PulseEngine/core/Material/TextureManager.h"
 #include "PulseEngine/core/Material/MaterialManager.h"
 #include "PulseEngine/API/EntityAPI/EntityApi.h"
 #include "PulseEngine/core/Meshes/RenderableMesh.h"
 #include "PulseEngine/core/Meshes/StaticMesh.h"
 #include "PulseEngine/core/Meshes/SkeletalMesh.h"
+#include "PulseEngine/core/Meshes/Cooking/CookedMesh.h"
+#include "PulseEngine/core/FileManager/Pak/PakManager.h"
+#include "PulseEngine/core/GUID/GuidCollection.h"
 
 #include <assimp/Importer.hpp>      // Assimp::Importer
 #include <assimp/scene.h>           // aiScene
@@ -26,46 +30,76 @@ using namespace PulseEngine::FileSystem;
 
 Entity *GuidReader::GetEntityFromGuid(std::size_t guid)
 {
-    
+    nlohmann::json guidCollection;
+    if (!ReadEntityCollection(guidCollection))
+    {
+        return nullptr;
+    }
+
+    nlohmann::json entityData;
+    if (!ReadEntityData(guidCollection, guid, entityData))
+    {
+        return nullptr;
+    }
+
+    return GetEntityFromGuid(guid, entityData);
+}
+
+Entity* GuidReader::GetEntityFromGuid(std::size_t guid, nlohmann::json& entityData, const MeshProvider& meshProvider)
+{
     static int count = 0;
     std::string name = "Entity_" + std::to_string(count++);
     Entity* entity = new Entity(name, PulseEngine::Vector3(0.0f), nullptr, MaterialManager::loadMaterial("Materials/cube.mat"));
 
-    nlohmann::json guidCollection;
-    std::ifstream guidColFile(std::string(ASSET_PATH) +"EngineConfig/Guid/guidCollectionEntities.puid");
-    if(!guidColFile.is_open())
+    return GetEntityFromJson(entityData, entity, meshProvider);
+}
+
+bool GuidReader::ReadEntityCollection(nlohmann::json& outCollection)
+{
+    const std::string collectionPath = "EngineConfig/Guid/guidCollectionEntities.puid";
+    std::vector<char> content;
+    if (!ReadAssetFile(collectionPath, content))
     {
-        EDITOR_ERROR("Guid collection file for entities couldn't be open : " + std::string(ASSET_PATH) +"EngineConfig/Guid/guidCollectionEntities.puid")
-        delete entity;
-        return nullptr;
+        EDITOR_ERROR("Guid collection file for entities couldn't be open : " + std::string(ASSET_PATH) + collectionPath)
+        return false;
     }
-    
-    guidColFile >> guidCollection;
 
-    if(guidCollection.contains(std::to_string(guid)))
+    outCollection = nlohmann::json::parse(content.begin(), content.end(), nullptr, false);
+    if (!outCollection.is_object())
     {
-        
-        nlohmann::json entityData;
-        std::ifstream entityFile(std::string(ASSET_PATH) + std::string(guidCollection[std::to_string(guid)]));
-        if(!entityFile.is_open())
-        {
-            EDITOR_ERROR("Entity guid file couldn't be open : " + std::string(ASSET_PATH) + std::string(guidCollection[std::to_string(guid)]))
-            delete entity;
-            return nullptr;
-        }
-        
-        entityFile >> entityData;
-        return GetEntityFromJson(entityData, entity);
+        EDITOR_ERROR("Guid collection file for entities is not valid : " + std::string(ASSET_PATH) + collectionPath)
+        return false;
     }
-    else
+    return true;
+}
+
+bool GuidReader::ReadEntityData(const nlohmann::json& collection, std::size_t guid, nlohmann::json& outEntityData)
+{
+    auto it = collection.find(std::to_string(guid));
+    if (it == collection.end() || !it->is_string())
     {
-        EDITOR_ERROR("Guid " + std::to_string(guid) + " not found in guid collection file for entities : " + std::string(ASSET_PATH) +"Guid/guidCollectionEntities.puid")
-        delete entity;
-        return nullptr;
+        EDITOR_ERROR("Guid " + std::to_string(guid) + " not found in guid collection file for entities : " + std::string(ASSET_PATH) +"EngineConfig/Guid/guidCollectionEntities.puid")
+        return false;
+    }
+
+    const std::string entityPath = it->get<std::string>();
+    std::vector<char> content;
+    if (!ReadAssetFile(entityPath, content))
+    {
+        EDITOR_ERROR("Entity guid file couldn't be open : " + std::string(ASSET_PATH) + entityPath)
+        return false;
     }
+
+    outEntityData = nlohmann::json::parse(content.begin(), content.end(), nullptr, false);
+    if (outEntityData.is_discarded())
+    {
+        EDITOR_ERROR("Entity guid file is not valid json : " + std::string(ASSET_PATH) + entityPath)
+        return false;
+    }
+    return true;
 }
 
-Entity* GuidReader::GetEntityFromJson(nlohmann::json& entityData, Entity* entity)
+Entity* GuidReader::GetEntityFromJson(nlohmann::json& entityData, Entity* entity, const MeshProvider& meshProvider)
 {
     if (entityData.contains("Guid"))
     {
@@ -91,7 +125,7 @@ Entity* GuidReader::GetEntityFromJson(nlohmann::json& entityData, Entity* entity
         else if (meshJson["Guid"].is_number_unsigned())
             meshGuid = meshJson["Guid"].get<std::size_t>();
 
-        RenderableMesh* mesh = GetMeshFromGuid(meshGuid);
+        RenderableMesh* mesh = meshProvider ? meshProvider(meshGuid) : GetMeshFromGuid(meshGuid);
         if (!mesh)
         {
             EDITOR_ERROR("Failed to load mesh with GUID: " + std::to_string(meshGuid))
@@ -184,17 +218,8 @@ Entity* GuidReader::GetEntityFromJson(nlohmann::json& entityData, Entity* entity
     // ------------------------------
     if (entityData.contains("Material"))
     {
-        Material* mat = nullptr;
-        for (auto& material : GuidReader::GetAllAvailableFiles("guidCollectionMaterials.puid"))
-        {
-            if (material.first == entityData["Material"].get<std::string>())
-            {
-                // EDITOR_SUCCESS("Material guid[" << material.first << "] found.")
-                mat = MaterialManager::loadMaterial(material.second);
-                break;
-            }
-        }
-        entity->SetMaterial(mat);
+        // cached by guid, the collection file is not read again for every entity
+        entity->SetMaterial(MaterialManager::GetMaterialFromGuid(entityData["Material"].get<std::string>()));
     }
 
     EDITOR_LOG("Entity has material: " << (entity->GetMaterial() ? entity->GetMaterial()->GetName() : "None"))
@@ -226,8 +251,7 @@ Material* GuidReader::GetMaterialFromJson(nlohmann::json_abi_v3_12_0::json &mate
 
         if (key.size() >= 4 && key.compare(0, 4, "txt_") == 0)
         {
-            std::shared_ptr<Texture> txt = std::make_shared<Texture>(it.value().get<std::string>(), PulseEngineGraphicsAPI);
-            mat->SetTexture(key.substr(4), txt);
+            mat->SetTexture(key.substr(4), TextureManager::GetInstance().GetTexture(it.value().get<std::string>(), false));
         }
     } 
 
@@ -237,133 +261,92 @@ Material* GuidReader::GetMaterialFromJson(nlohmann::json_abi_v3_12_0::json &mate
 
 RenderableMesh* GuidReader::GetMeshFromGuid(std::size_t guid)
 {
-    std::string path = "";
-    std::string meshPath = "";
-    Assimp::Importer* importer = new Assimp::Importer();
-
-    nlohmann::json guidCollection;
-    std::ifstream guidColFile(std::string(ASSET_PATH) +"EngineConfig/Guid/guidCollectionMeshes.puid");
-    if(!guidColFile.is_open())
+    std::string meshPath;
+    if (!GetMeshPathFromGuid(guid, meshPath))
     {
-        EDITOR_ERROR("Guid collection file for meshes couldn't be open : " + std::string(ASSET_PATH) +"EngineConfig/Guid/guidCollectionMeshes.puid")
-         return nullptr;
+        return nullptr;
     }
-    guidColFile >> guidCollection;
-    
-    if(guidCollection.contains(std::to_string(guid)))
+
+    // cooked .pmdl in the game, imported copy in the editor : Assimp only runs when the source changed
+    PulseEngine::Cooking::CookedMesh cooked;
+    if (!PulseEngine::Cooking::LoadMeshAsset(meshPath, cooked))
     {
-        path = guidCollection[std::to_string(guid)].get<std::string>();
-        if (path.empty())
-        {
-            EDITOR_ERROR("Path for GUID " + std::to_string(guid) + " is empty.")
-            return nullptr;
-        }
-        path = std::string(ASSET_PATH) + path;
-        std::ifstream file(path);
-        if(file.is_open())
-        {
-            nlohmann::json fileData;
-            file >> fileData;
-            if(fileData.contains("MeshPath"))
-            {
-                meshPath = fileData["MeshPath"].get<std::string>();
-                if(meshPath.empty())
-                {
-                    EDITOR_ERROR("Mesh path for GUID " + std::to_string(guid) + " is empty.")
-                    return nullptr;
-                }
-                meshPath = std::string(ASSET_PATH) + meshPath;
-            }
-            else
-            {
-                EDITOR_ERROR("MeshPath not found in JSON for GUID " + std::to_string(guid) + ".")
-                return nullptr;
-            }
-        }
+        return nullptr;
     }
-    else
+
+    return CreateMeshFromCooked(guid, meshPath, cooked);
+}
+
+bool GuidReader::GetMeshPathFromGuid(std::size_t guid, std::string& outMeshPath)
+{
+    auto collection = PulseEngineInstance->guidCollections.find("guidCollectionMeshes.puid");
+    if (collection == PulseEngineInstance->guidCollections.end() || !collection->second)
     {
-        EDITOR_ERROR("Guid " + std::to_string(guid) + " not found in guid collection file for meshes : " + std::string(ASSET_PATH) +"EngineConfig/Guid/guidCollectionMeshes.puid")
-        return nullptr;
+        EDITOR_ERROR("Guid collection for meshes isn't loaded : guidCollectionMeshes.puid")
+        return false;
     }
-    //onced shared system implemented, we will use importer->ReadFileFromMemory() instead
-    // it will be needed to have a method in our shared system that sent back a vector of char from the .pak
-    //the importer will read the object from the .pak like this :
-    //std::vector<char> fileData = LoadFromPak("assets/model.fbx");
-    //Assimp::Importer importer;
-    //
-    //const aiScene* scene = importer.ReadFileFromMemory(
-    //    fileData.data(),                   // pointer to memory
-    //    fileData.size(),                   // size
-    //    aiProcess_Triangulate |
-    //    aiProcess_FlipUVs |
-    //    aiProcess_GenNormals |
-    //    aiProcess_CalcTangentSpace,
-    //    "fbx"                              // file extension/hint
-    //);
-    const aiScene* scene = importer->ReadFile(
-        meshPath,
-    aiProcess_Triangulate | 
-    aiProcess_GenSmoothNormals |
-    aiProcess_CalcTangentSpace | 
-    aiProcess_JoinIdenticalVertices |
-    aiProcess_ImproveCacheLocality |
-    aiProcess_LimitBoneWeights |
-    aiProcess_OptimizeMeshes |
-    aiProcess_OptimizeGraph
-    );
 
-    if (!scene || scene->mFlags & AI_SCENE_FLAGS_INCOMPLETE || !scene->mRootNode)
+    const std::string path = collection->second->GetFilePathFromGuid(std::to_string(guid));
+    if (path.empty())
     {
-        EDITOR_ERROR("Erreur Assimp: " << importer->GetErrorString())
-        return nullptr;
+        EDITOR_ERROR("Guid " + std::to_string(guid) + " not found in guid collection file for meshes : guidCollectionMeshes.puid")
+        return false;
     }
 
-    EDITOR_LOG("number of meshes " << scene->mNumMeshes);
+    std::vector<char> content;
+    if (!ReadAssetFile(path, content))
+    {
+        EDITOR_ERROR("Mesh file for GUID " + std::to_string(guid) + " couldn't be open : " + path)
+        return false;
+    }
 
-    RenderableMesh* meshsObj = nullptr;
+    nlohmann::json fileData = nlohmann::json::parse(content.begin(), content.end(), nullptr, false);
+    if (!fileData.is_object() || !fileData.contains("MeshPath") || !fileData["MeshPath"].is_string())
+    {
+        EDITOR_ERROR("MeshPath not found in JSON for GUID " + std::to_string(guid) + ".")
+        return false;
+    }
 
-    if(scene->mNumAnimations > 0)
+    outMeshPath = fileData["MeshPath"].get<std::string>();
+    if (outMeshPath.empty())
     {
-        meshsObj = new SkeletalMesh(scene->mName.C_Str());
-        SkeletalMesh* cst = dynamic_cast<SkeletalMesh*>(meshsObj);
+        EDITOR_ERROR("Mesh path for GUID " + std::to_string(guid) + " is empty.")
+        return false;
+    }
+    return true;
+}
 
-        LoadSkeletonFromAssimp(cst, scene);
+RenderableMesh* GuidReader::CreateMeshFromCooked(std::size_t guid, const std::string& meshPath, PulseEngine::Cooking::CookedMesh& cooked)
+{
+    EDITOR_LOG("number of meshes " << cooked.meshes.size());
 
-        // for (unsigned int i = 0; i < scene->mNumAnimations; i++)
-        // {
-        //     const aiAnimation* anim = scene->mAnimations[i];
-        //     AnimationClip clip = SkeletalMesh::LoadAnimationSimplified(anim);
-        //     cst->animations.push_back(clip);
-        // }
+    const std::string meshName = std::string(ASSET_PATH) + meshPath;
+    RenderableMesh* meshsObj = nullptr;
 
-        LoadAnimationsFromAssimp(cst, scene);
+    if(!cooked.animations.empty())
+    {
+        SkeletalMesh* cst = new SkeletalMesh(cooked.name);
+        meshsObj = cst;
 
-        for (unsigned int i = 0; i < scene->mNumMeshes; i++)
+        cst->skeleton = std::move(cooked.bones);
+        cst->animations = std::move(cooked.animations);
+        for (const Bone& bone : cst->skeleton)
         {
-            Mesh* msh = Mesh::LoadFromAssimp(scene->mMeshes[i], scene, cst); // OK: importer toujours vivant ici
-
-            msh->importer = importer;
-            msh->SetGuid(guid);
-            msh->SetName(meshPath);
-            meshsObj->AddMesh(msh);
+            cst->boneNameToIndex[bone.name] = bone.index;
         }
-
-
-        cst->finalBoneMatrices.resize(cst->skeleton.size(), PulseEngine::Mat4(1.0f));
+        cst->BindAnimations();
     }
     else
     {
-        meshsObj = new StaticMesh(scene->mName.C_Str());
-        for (unsigned int i = 0; i < scene->mNumMeshes; i++)
-        {
-            Mesh* msh = Mesh::LoadFromAssimp(scene->mMeshes[i], scene, nullptr); // OK: importer toujours vivant ici
+        meshsObj = new StaticMesh(cooked.name);
+    }
 
-            msh->importer = importer;
-            msh->SetGuid(guid);
-            msh->SetName(meshPath);
-            meshsObj->AddMesh(msh);
-        }
+    for (PulseEngine::Cooking::CookedSubMesh& subMesh : cooked.meshes)
+    {
+        Mesh* msh = Mesh::CreateFromBuffers(std::move(subMesh.vertices), std::move(subMesh.indices), std::move(subMesh.lods), std::move(subMesh.skin));
+        msh->SetGuid(guid);
+        msh->SetName(meshName);
+        meshsObj->AddMesh(msh);
     }
 
     return meshsObj;
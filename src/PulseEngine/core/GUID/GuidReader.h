@@ -18,11 +18,14 @@
 #include <assimp/scene.h>           // aiScene
 #include <assimp/postprocess.h>     // postprocessing flags
 
+#include <functional>
+
 class Entity;
 class Mesh;
 class Material;
 class RenderableMesh;
 class SkeletalMesh;
+namespace PulseEngine::Cooking { struct CookedMesh; }
 
 
 class PULSE_ENGINE_DLL_API GuidReader
@@ -36,6 +39,38 @@ class PULSE_ENGINE_DLL_API GuidReader
          * @return Entity* a new entity from your wanted one.
          */
         static Entity* GetEntityFromGuid(std::size_t Guid);
+
+        /**
+         * @brief Gives the mesh of a mesh GUID found in an entity file, GetMeshFromGuid when none is given.
+         * @note SceneLoader::LoadSceneAsync gives the meshes its workers already read.
+         */
+        using MeshProvider = std::function<RenderableMesh*(std::size_t meshGuid)>;
+
+        /**
+         * @brief Same as GetEntityFromGuid, with the entity file already read (see ReadEntityData). Main thread.
+         */
+        static Entity* GetEntityFromGuid(std::size_t guid, nlohmann::json_abi_v3_12_0::json& entityData, const MeshProvider& meshProvider = nullptr);
+
+        /**
+         * @brief Read the entity collection (EngineConfig/Guid/guidCollectionEntities.puid).
+         * @note No engine state is touched : safe on a worker thread, like ReadEntityData and GetMeshPathFromGuid.
+         */
+        static bool ReadEntityCollection(nlohmann::json_abi_v3_12_0::json& outCollection);
+
+        /**
+         * @brief Read the entity file of guid, found in a collection given by ReadEntityCollection.
+         */
+        static bool ReadEntityData(const nlohmann::json_abi_v3_12_0::json& collection, std::size_t guid, nlohmann::json_abi_v3_12_0::json& outEntityData);
+
+        /**
+         * @brief Source path of a mesh GUID (relative to ASSET_PATH), read from its mesh file.
+         */
+        static bool GetMeshPathFromGuid(std::size_t guid, std::string& outMeshPath);
+
+        /**
+         * @brief GPU part of GetMeshFromGuid : a static or skeletal mesh from a cooked mesh, whose buffers are moved. Main thread.
+         */
+        static RenderableMesh* CreateMeshFromCooked(std::size_t guid, const std::string& meshPath, PulseEngine::Cooking::CookedMesh& cooked);
         /**
          * @brief If you already have the GUID of the mesh wanted to be loaded.
          * @note The GUID is the one generated from the engine and saved inside the collection.
@@ -52,7 +87,7 @@ class PULSE_ENGINE_DLL_API GuidReader
          * @param entity the entity to fill with the data from the json.
          * @return Entity* its the same as the one pass to the function.
          */
-        static Entity *GetEntityFromJson(nlohmann::json_abi_v3_12_0::json &entityData, Entity *entity);
+        static Entity *GetEntityFromJson(nlohmann::json_abi_v3_12_0::json &entityData, Entity *entity, const MeshProvider& meshProvider = nullptr);
         /**
          * @brief Get the content of a material via the actual json (.material) from the engine material saved file.
          * 
@@ -0,0 +1,139 @@
+#include "DebugDraw.h"
+#include "PulseEngine/core/Graphics/IGraphicsApi.h"
+#include "PulseEngine/core/Math/MathUtils.h"
+
+#include <algorithm>
+#include <cmath>
+#include <mutex>
+#include <vector>
+
+using namespace PulseEngine::Graphics;
+
+namespace
+{
+    // the unit cube of DebugDraw::Box, and the clip cube of DebugDraw::Frustum (z from -1 to 1, GL convention)
+    const PulseEngine::Vector3 CUBE_CORNERS[8] = {
+        {-1.0f, -1.0f, -1.0f}, { 1.0f, -1.0f, -1.0f}, { 1.0f,  1.0f, -1.0f}, {-1.0f,  1.0f, -1.0f},
+        {-1.0f, -1.0f,  1.0f}, { 1.0f, -1.0f,  1.0f}, { 1.0f,  1.0f,  1.0f}, {-1.0f,  1.0f,  1.0f}
+    };
+    const int CUBE_EDGES[24] = {
+        0,1, 1,2, 2,3, 3,0,
+        4,5, 5,6, 6,7, 7,4,
+        0,4, 1,5, 2,6, 3,7
+    };
+
+    std::mutex pendingMutex;
+    std::vector<LineVertex> pending[2];     ///< by DebugDepthMode
+
+    std::uint32_t PackColor(const PulseEngine::Color& color)
+    {
+        auto channel = [](float value) { return static_cast<std::uint32_t>(std::clamp(value, 0.0f, 1.0f) * 255.0f + 0.5f); };
+        return channel(color.r) | (channel(color.g) << 8) | (channel(color.b) << 16) | (channel(color.a) << 24);
+    }
+
+    // Mat4 is data[col][row] : column major, translation in the last column, w divided
+    PulseEngine::Vector3 TransformPoint(const PulseEngine::Mat4& m, const PulseEngine::Vector3& p)
+    {
+        float out[4];
+        for (int row = 0; row < 4; ++row)
+            out[row] = m.data[0][row] * p.x + m.data[1][row] * p.y + m.data[2][row] * p.z + m.data[3][row];
+        const float invW = std::fabs(out[3]) > 1e-8f ? 1.0f / out[3] : 1.0f;
+        return PulseEngine::Vector3(out[0] * invW, out[1] * invW, out[2] * invW);
+    }
+
+    void AppendEdges(const PulseEngine::Vector3 corners[8], std::uint32_t color, DebugDepthMode depth)
+    {
+        std::lock_guard<std::mutex> lock(pendingMutex);
+        std::vector<LineVertex>& stream = pending[depth];
+        for (int edge : CUBE_EDGES)
+            stream.push_back({corners[edge], color});
+    }
+}
+
+void DebugDraw::Line(const PulseEngine::Vector3 &start, const PulseEngine::Vector3 &end, const PulseEngine::Color &color, DebugDepthMode depth)
+{
+    const std::uint32_t packed = PackColor(color);
+    std::lock_guard<std::mutex> lock(pendingMutex);
+    pending[depth].push_back({start, packed});
+    pending[depth].push_back({end, packed});
+}
+
+void DebugDraw::Box(const PulseEngine::Mat4 &model, const PulseEngine::Color &color, DebugDepthMode depth)
+{
+    PulseEngine::Vector3 corners[8];
+    for (int i = 0; i < 8; ++i)
+        corners[i] = TransformPoint(model, CUBE_CORNERS[i] * 0.5f);
+    AppendEdges(corners, PackColor(color), depth);
+}
+
+void DebugDraw::Box(const AABB &box, const PulseEngine::Color &color, DebugDepthMode depth)
+{
+    const PulseEngine::Vector3 center = box.Center();
+    const PulseEngine::Vector3 extents = box.Extents();
+    PulseEngine::Vector3 corners[8];
+    for (int i = 0; i < 8; ++i)
+    {
+        const PulseEngine::Vector3& c = CUBE_CORNERS[i];
+        corners[i] = PulseEngine::Vector3(center.x + c.x * extents.x, center.y + c.y * extents.y, center.z + c.z * extents.z);
+    }
+    AppendEdges(corners, PackColor(color), depth);
+}
+
+void DebugDraw::Sphere(const PulseEngine::Vector3 &center, float radius, const PulseEngine::Color &color, DebugDepthMode depth, int segments)
+{
+    segments = std::max(segments, 4);
+    const std::uint32_t packed = PackColor(color);
+    const float step = 2.0f * 3.14159265358979f / static_cast<float>(segments);
+
+    std::lock_guard<std::mutex> lock(pendingMutex);
+    std::vector<LineVertex>& stream = pending[depth];
+    stream.reserve(stream.size() + static_cast<std::size_t>(segments) * 6);
+    for (int axis = 0; axis < 3; ++axis)
+    {
+        auto point = [&](int i)
+        {
+            const float s = std::sin(step * i) * radius;
+            const float c = std::cos(step * i) * radius;
+            if (axis == 0) return PulseEngine::Vector3(center.x, center.y + c, center.z + s);
+            if (axis == 1) return PulseEngine::Vector3(center.x + c, center.y, center.z + s);
+            return PulseEngine::Vector3(center.x + c, center.y + s, center.z);
+        };
+        for (int i = 0; i < segments; ++i)
+        {
+            stream.push_back({point(i), packed});
+            stream.push_back({point(i + 1), packed});
+        }
+    }
+}
+
+void DebugDraw::Frustum(const PulseEngine::Mat4 &viewProjection, const PulseEngine::Color &color, DebugDepthMode depth)
+{
+    const PulseEngine::Mat4 inverse = PulseEngine::MathUtils::Matrix::Inverse(viewProjection);
+    PulseEngine::Vector3 corners[8];
+    for (int i = 0; i < 8; ++i)
+        corners[i] = TransformPoint(inverse, CUBE_CORNERS[i]);
+    AppendEdges(corners, PackColor(color), depth);
+}
+
+void DebugDraw::Clear()
+{
+    std::lock_guard<std::mutex> lock(pendingMutex);
+    pending[DEBUG_DEPTH_TEST].clear();
+    pending[DEBUG_ON_TOP].clear();
+}
+
+std::size_t DebugDraw::GetPendingVertexCount(DebugDepthMode depth)
+{
+    std::lock_guard<std::mutex> lock(pendingMutex);
+    return pending[depth].size();
+}
+
+void DebugDraw::TakePending(std::vector<LineVertex> streams[2])
+{
+    std::lock_guard<std::mutex> lock(pendingMutex);
+    for (int i = 0; i < 2; ++i)
+    {
+        streams[i].swap(pending[i]);
+        pending[i].clear();
+    }
+}
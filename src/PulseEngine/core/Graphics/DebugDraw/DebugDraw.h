@@ -0,0 +1,91 @@
+/**
+ * @file DebugDraw.h
+ * @brief Immediate-mode debug lines (collider boxes, casts, light volumes, frusta) : submitted from anywhere during
+ * the frame, drawn once at its end.
+ * @details Every primitive is cut in lines and appended, already in world space, to one of two vertex streams : the
+ * lines tested against the depth buffer, and the lines drawn on top of everything. Flush sends each stream with a
+ * single IGraphicsAPI::DrawLineBatch, under one shader and one pipeline state : a scene with a thousand colliders
+ * costs two draws instead of one shader bind, three uniforms and one draw per box.
+ * - Submitting takes a lock : the scripts of the simulation thread and the overlays of the graphics thread can both
+ *   draw. The lines wait for the next Flush, on the graphics thread.
+ * - Colors are 0..1 like Color everywhere else, packed to RGBA8 at submission.
+ * - DebugDraw.cpp is the submission and builds without the backend, DebugDrawFlush.cpp the drawing.
+ * @version 0.1
+ * @date 2025-12-14
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+#ifndef DEBUGDRAW_H
+#define DEBUGDRAW_H
+
+#include "Common/dllExport.h"
+#include "PulseEngine/core/Math/Vector.h"
+#include "PulseEngine/core/Math/Mat4.h"
+#include "PulseEngine/core/Math/Color.h"
+#include "PulseEngine/core/Math/Frustum/AABB.h"
+
+#include <cstddef>
+#include <vector>
+
+struct LineVertex;
+
+namespace PulseEngine::Graphics
+{
+    enum DebugDepthMode
+    {
+        DEBUG_DEPTH_TEST,       ///< hidden by the scene in front of it
+        DEBUG_ON_TOP            ///< always visible
+    };
+
+    struct DebugDrawStats
+    {
+        std::size_t lines = 0;          ///< drawn by the last Flush
+        std::size_t draws = 0;          ///< batches drawn, 0 to 2
+    };
+
+    class PULSE_ENGINE_DLL_API DebugDraw
+    {
+    public:
+        static void Line(const PulseEngine::Vector3& start, const PulseEngine::Vector3& end, const PulseEngine::Color& color,
+                         DebugDepthMode depth = DEBUG_DEPTH_TEST);
+
+        /**
+         * @brief The 12 edges of the unit cube (corners at +-0.5) transformed by model : an oriented box is its
+         * translation, rotation and scale.
+         */
+        static void Box(const PulseEngine::Mat4& model, const PulseEngine::Color& color, DebugDepthMode depth = DEBUG_DEPTH_TEST);
+        static void Box(const AABB& box, const PulseEngine::Color& color, DebugDepthMode depth = DEBUG_DEPTH_TEST);
+
+        /**
+         * @brief Three circles, one around each axis.
+         */
+        static void Sphere(const PulseEngine::Vector3& center, float radius, const PulseEngine::Color& color,
+                           DebugDepthMode depth = DEBUG_DEPTH_TEST, int segments = 24);
+
+        /**
+         * @brief The 12 edges of what viewProjection (projection * view) sees : the clip cube through its inverse.
+         */
+        static void Frustum(const PulseEngine::Mat4& viewProjection, const PulseEngine::Color& color, DebugDepthMode depth = DEBUG_DEPTH_TEST);
+
+        /**
+         * @brief Draw and clear the lines submitted since the last Flush, on the graphics thread, in the bound
+         * framebuffer. Leaves the default PipelineState.
+         */
+        static void Flush(const PulseEngine::Mat4& view, const PulseEngine::Mat4& projection);
+
+        /// @brief Drop the pending lines without drawing them (scene change).
+        static void Clear();
+
+        /// @brief Vertices waiting for the next Flush in the stream of depth, two per line.
+        static std::size_t GetPendingVertexCount(DebugDepthMode depth);
+
+        static const DebugDrawStats& GetStats();
+
+    private:
+        /// @brief Swap the pending streams (by DebugDepthMode) with streams, and empty them : Flush draws without the lock.
+        static void TakePending(std::vector<LineVertex> streams[2]);
+    };
+}
+
+#endif // DEBUGDRAW_H
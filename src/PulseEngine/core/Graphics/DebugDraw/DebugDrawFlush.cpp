@@ -0,0 +1,73 @@
+#include "DebugDraw.h"
+#include "common/common.h"
+#include "PulseEngine/core/PulseEngineBackend.h"
+#include "PulseEngine/core/Graphics/IGraphicsApi.h"
+#include "shader.h"
+
+#include <vector>
+
+using namespace PulseEngine::Graphics;
+
+// the GPU side of DebugDraw : the submission (DebugDraw.cpp) builds without the backend, for Tests/DebugDrawTest.cpp
+namespace
+{
+    std::vector<LineVertex> flushing[2];    ///< swapped with the pending streams : their lock isn't held while drawing
+    DebugDrawStats stats;
+    Shader* lineShader = nullptr;
+    bool droppedLinesReported = false;
+}
+
+void DebugDraw::Flush(const PulseEngine::Mat4 &view, const PulseEngine::Mat4 &projection)
+{
+    PROFILE_TIMER_FUNCTION;
+    TakePending(flushing);
+
+    stats = DebugDrawStats();
+    IGraphicsAPI* gAPI = PulseEngineGraphicsAPI;
+    if (!gAPI || (flushing[DEBUG_DEPTH_TEST].empty() && flushing[DEBUG_ON_TOP].empty())) return;
+
+    if (!lineShader)
+    {
+        lineShader = new Shader(
+            std::string(ASSET_PATH) + "EngineConfig/shaders/debugLine.vert",
+            std::string(ASSET_PATH) + "EngineConfig/shaders/debugLine.frag",
+            gAPI
+        );
+    }
+    lineShader->Use();
+    lineShader->SetMat4("view", view);
+    lineShader->SetMat4("projection", projection);
+
+    // tested first : the lines on top are drawn over them too
+    PipelineState state;
+    state.depthWrite = false;
+    for (int mode = DEBUG_DEPTH_TEST; mode <= DEBUG_ON_TOP; ++mode)
+    {
+        std::vector<LineVertex>& stream = flushing[mode];
+        if (stream.empty()) continue;
+
+        state.depthTest = mode == DEBUG_DEPTH_TEST;
+        gAPI->SetPipelineState(state);
+        const std::size_t drawn = gAPI->DrawLineBatch(stream.data(), stream.size());
+
+        stats.lines += drawn / 2;
+        if (drawn > 0) stats.draws++;
+        if (drawn < stream.size() && !droppedLinesReported)
+        {
+            droppedLinesReported = true;
+            EDITOR_WARN("DebugDraw : " << (stream.size() - drawn) / 2 << " lines of " << stream.size() / 2 << " could not be drawn")
+        }
+        stream.clear();
+    }
+    gAPI->SetPipelineState(PipelineState());
+
+    PROFILE_COUNTER("Debug lines", {
+        {"lines", (double)stats.lines},
+        {"draws", (double)stats.draws}
+    });
+}
+
+const DebugDrawStats &DebugDraw::GetStats()
+{
+    return stats;
+}
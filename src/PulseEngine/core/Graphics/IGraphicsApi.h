@@ -58,6 +58,8 @@
 #include "Common/dllExport.h"
 #include <string>
 #include <vector>
+#include <cstddef>
+#include <cstdint>
 
 #include "PulseEngine/ModuleLoader/IModule/IModule.h"
 #include "PulseEngine/core/Math/Color.h"
@@ -65,13 +67,16 @@
 #include "PulseEngine/core/Math/Vector.h"
 #include "PulseEngine/core/Math/Mat4.h"
 #include "PulseEngine/core/Math/Mat3.h"
+#include "PulseEngine/core/Graphics/PipelineState.h"
 #include "shader.h"
 
 
 
 class PulseEngineBackend;
 class Vertex;
+struct SkinWeights;
 class ITextRenderer;
+namespace PulseEngine::Cooking { struct CookedTexture; }
 
 /**
  * @enum TextureType
@@ -80,7 +85,42 @@ class ITextRenderer;
 enum TextureType
 {
     TEXTURE_2D,
-    TEXTURE_CUBE_MAP
+    TEXTURE_CUBE_MAP,
+    TEXTURE_BUFFER,
+    TEXTURE_2D_ARRAY
+};
+
+/**
+ * @enum TextureBufferFormat
+ * @brief Texel format of a buffer texture, as the shader reads it with texelFetch.
+ */
+enum TextureBufferFormat
+{
+    TEXTURE_BUFFER_RGBA32F,     ///< samplerBuffer, 4 floats per texel
+    TEXTURE_BUFFER_RG32UI,      ///< usamplerBuffer, 2 uints per texel
+    TEXTURE_BUFFER_R32UI        ///< usamplerBuffer, 1 uint per texel
+};
+
+/**
+ * @struct LineVertex
+ * @brief A vertex of DrawLineBatch, two consecutive ones make a line (see DebugDraw).
+ */
+struct LineVertex
+{
+    PulseEngine::Vector3 position;
+    std::uint32_t color = 0xFFFFFFFF;   ///< RGBA8, red in the low byte
+};
+
+/**
+ * @struct TextureArraySlot
+ * @brief Layer of a texture array holding a copy of a texture, see IGraphicsAPI::GetTextureArraySlot.
+ */
+struct TextureArraySlot
+{
+    unsigned int array = 0;
+    int layer = -1;
+
+    bool IsValid() const { return layer >= 0; }
 };
 
 /**
@@ -205,6 +245,10 @@ public:
 
     virtual unsigned int CreateShader(const std::string& vertexPath, const std::string& fragmentPath) = 0;
     virtual unsigned int CreateShader(const std::string& vertexPath, const std::string& fragmentPath, const std::string& geometryPath) = 0;
+    /**
+     * @brief A variant of a shader : each define is declared (#define NAME) right after the #version line of both stages.
+     */
+    virtual unsigned int CreateShader(const std::string& vertexPath, const std::string& fragmentPath, const std::vector<std::string>& defines) = 0;
 
     virtual void GenerateFrameBuffer(unsigned int* previewFBO, unsigned int* previewTexture, unsigned int* rbo, unsigned int previewWidth,unsigned int previewHeight) = 0;
 
@@ -236,15 +280,94 @@ public:
     virtual bool IsFrameBufferComplete() const = 0;
     virtual void InitCubeMapFaceForRender(unsigned int* CubeMap, unsigned int faceIndex) const = 0;
     virtual void GenerateTextureMap(unsigned int* textureID, const std::string& filePath, bool hasFlip) const = 0;
+    /**
+     * @brief Create a mipmapped 2D texture from decoded pixels (1 to 4 8-bit channels, rows tightly packed).
+     */
+    virtual void UploadTexture(unsigned int* textureID, const unsigned char* pixels, int width, int height, int channels) const = 0;
+    /**
+     * @brief Upload every level of a cooked texture as it is (see TextureCooker), no decoding and no mip generation.
+     * @return false, no texture created, when the GPU can't sample its format or rejects the upload : the caller then
+     * loads the source image.
+     */
+    virtual bool UploadCookedTexture(unsigned int* textureID, const PulseEngine::Cooking::CookedTexture& texture) const = 0;
+    virtual void DeleteTexture(unsigned int textureID) const = 0;
+    /**
+     * @brief Create a buffer texture : a flat array of texels the shaders read with texelFetch, far larger than a
+     * uniform array. Bound like any texture, ActivateTexture then BindTexture(TEXTURE_BUFFER, textureID).
+     */
+    virtual void CreateTextureBuffer(unsigned int* buffer, unsigned int* textureID, TextureBufferFormat format) const = 0;
+    /**
+     * @brief Replace the whole content of a buffer texture, size in bytes. The previous storage is orphaned, a frame
+     * still reading it on the GPU doesn't stall the upload.
+     */
+    virtual void UploadTextureBuffer(unsigned int buffer, const void* data, std::size_t size) const = 0;
+    virtual void DeleteTextureBuffer(unsigned int buffer, unsigned int textureID) const = 0;
     virtual void GenerateShadowMap(unsigned int* shadowMap, unsigned int* FBO, int width, int height) const = 0;
-    virtual void BindShadowFramebuffer(unsigned int* FBO) const = 0;
+    /**
+     * @brief Bind a shadow map framebuffer for the depth pass. clear = false keeps its depth, to draw over it.
+     */
+    virtual void BindShadowFramebuffer(unsigned int* FBO, bool clear = true) const = 0;
+    /**
+     * @brief Copy the depth of a shadow map into another of the same size and format, the 6 faces when cubeMap
+     * (a cached static layer under the moving casters).
+     */
+    virtual void CopyShadowMap(unsigned int sourceTexture, unsigned int targetTexture, int size, bool cubeMap) const = 0;
     virtual void UnbindShadowFramebuffer() const = 0;
     virtual void ActivateTexture(unsigned int textureID) const = 0;
     virtual void BindTexture(TextureType type, unsigned int textureID) const = 0;
-    virtual void SetupMesh(unsigned int* VAO, unsigned int* VBO, unsigned int* EBO, const std::vector<Vertex>& vertices, const std::vector<unsigned int>& indices) const = 0;
+    /**
+     * @brief Upload a mesh. skin : bone data, one per vertex, after the vertices in the same buffer (attributes 2 and
+     * 5). Empty for a static mesh, whose vertices don't carry any.
+     */
+    virtual void SetupMesh(unsigned int* VAO, unsigned int* VBO, unsigned int* EBO, const std::vector<Vertex>& vertices,
+                           const std::vector<SkinWeights>& skin, const std::vector<unsigned int>& indices) const = 0;
     virtual void RenderMesh(unsigned int* VAO, unsigned int* VBO, const std::vector<Vertex>& vertices, const std::vector<unsigned int>& indices) const = 0;
+    /**
+     * @brief Draw indexCount indices of the element buffer of VAO, from indexOffset (one LOD of a mesh).
+     */
+    virtual void RenderMeshRange(unsigned int* VAO, unsigned int indexOffset, unsigned int indexCount) const = 0;
+    /**
+     * @brief RenderMeshRange instanceCount times in one call, the shader tells them apart with gl_InstanceID.
+     */
+    virtual void RenderMeshRangeInstanced(unsigned int* VAO, unsigned int indexOffset, unsigned int indexCount, unsigned int instanceCount) const = 0;
 
     virtual void RenderLineMesh(unsigned int* VAO, unsigned int* VBO, const std::vector<PulseEngine::Vector3>& vertices, const std::vector<unsigned int>& indices) = 0;
+    /**
+     * @brief Draw count / 2 lines in one call, with the shader in use : position at location 0, color at location 1
+     * (normalized vec4). The vertices are copied, the caller can reuse them right away.
+     * @return vertices drawn, less than count when some could not be uploaded (or count is odd).
+     */
+    virtual std::size_t DrawLineBatch(const LineVertex* vertices, std::size_t count) const = 0;
+
+    // ============================================================================
+    //  Pipeline State
+    // ============================================================================
+    // Depth, blend, cull and polygon mode of the next draws, set at once. A backend
+    // keeps what is bound and only sends what changed, for its program, vertex
+    // array, texture, framebuffer and viewport calls too.
+
+    virtual void SetPipelineState(const PipelineState& state) const = 0;
+    /**
+     * @brief State calls of the last frame swapped, and the ones skipped as already in place.
+     */
+    virtual StateCacheCounters GetStateCacheCounters() const { return StateCacheCounters(); }
+    /**
+     * @brief Forget what is bound, the next calls are all sent : after code that talks to the driver directly.
+     */
+    virtual void InvalidateStateCache() const {}
+
+    // ============================================================================
+    //  Material Batching
+    // ============================================================================
+    // The material maps of the same size and format are copied in texture arrays :
+    // objects of different materials then sample the same textures, and are drawn
+    // together (see MaterialBatcher).
+
+    /**
+     * @brief Layer of a texture array holding a copy of textureID (every level), packed on the first call.
+     * @return an invalid slot when the backend can't pack it : the caller binds textureID per draw.
+     */
+    virtual TextureArraySlot GetTextureArraySlot(unsigned int textureID) const { return TextureArraySlot(); }
 
     // ============================================================================
     //  Mesh & Vertex Management
@@ -0,0 +1,299 @@
+#include "MaterialBatcher.h"
+#include "common/common.h"
+#include "PulseEngine/core/PulseEngineBackend.h"
+#include "PulseEngine/core/Graphics/IGraphicsApi.h"
+#include "PulseEngine/core/Graphics/RenderSnapshot/RenderSnapshot.h"
+#include "PulseEngine/core/Lights/LightManager.h"
+#include "PulseEngine/core/Material/Material.h"
+#include "PulseEngine/core/Meshes/Mesh.h"
+#include "PulseEngine/core/Meshes/RenderableMesh.h"
+#include "PulseEngine/core/Meshes/Skinning/SkinningStage.h"
+#include "Common/EditorDefines.h"
+#include "shader.h"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <memory>
+#include <string>
+#include <tuple>
+#include <unordered_map>
+
+using namespace PulseEngine::Graphics;
+
+bool MaterialBatcher::enabled = true;
+
+namespace
+{
+    // texture units : 5 draw parameters, 6-8 the maps, as Material::BindTextures (see LightManager.cpp for the others)
+    constexpr unsigned int DRAW_PARAMETERS_UNIT = 5;
+    constexpr unsigned int FIRST_MAP_UNIT = 6;
+    constexpr int MAP_COUNT = RENDER_MAP_COUNT;
+    const char* const MAP_SAMPLERS[MAP_COUNT] = { "albedoMap", "normalMap", "roughnessMap" };
+
+    // basic.vert : 4 texels of model matrix, 1 of layers
+    constexpr std::size_t DRAW_PARAMETER_FLOATS = 20;
+
+    struct BatchItem
+    {
+        Shader* shader = nullptr;           ///< the BATCHED_MATERIALS variant
+        std::uint32_t pipeline = 0;         ///< PipelineState, packed
+        unsigned int arrays[MAP_COUNT] = {};
+        std::uint64_t geometry = 0;         ///< mesh guid, the Mesh itself when it has none
+        std::uint32_t subMesh = 0;
+        std::uint32_t lod = 0;
+
+        const PipelineState* state = nullptr;
+        Mesh* mesh = nullptr;
+        const PulseEngine::Mat4* matrix = nullptr;
+        float layers[MAP_COUNT] = {};
+
+        auto Key() const { return std::tie(shader, pipeline, arrays[0], arrays[1], arrays[2], geometry, subMesh, lod); }
+    };
+
+    /// @brief The batched variant of a material shader, once its sources were checked.
+    struct ShaderVariant
+    {
+        std::string sources;                ///< paths it was made from : a program ID freed and given to another shader
+        Shader* shader = nullptr;           ///< nullptr : the sources have no BATCHED_MATERIALS path
+    };
+
+    struct BatcherState
+    {
+        unsigned int parameterBuffer = 0;
+        unsigned int parameterTexture = 0;
+        std::unordered_map<unsigned int, ShaderVariant> variants;  ///< by program ID of the material shader
+        std::vector<BatchItem> items;
+        std::vector<MeshDraw> draws;
+        std::vector<float> parameters;
+        std::vector<const Material*> unbatchedMaterials;
+        MaterialBatchStats stats;
+    };
+
+    BatcherState& GetState()
+    {
+        static BatcherState state;
+        return state;
+    }
+
+    std::uint32_t PackPipelineState(const PipelineState& state)
+    {
+        return (state.depthTest ? 1u : 0u) | (state.depthWrite ? 2u : 0u) | (state.wireframe ? 4u : 0u)
+            | (static_cast<std::uint32_t>(state.depthFunction) << 3) | (static_cast<std::uint32_t>(state.blend) << 8)
+            | (static_cast<std::uint32_t>(state.cull) << 12);
+    }
+
+    bool DeclaresBatching(const std::string& path)
+    {
+        std::ifstream file(path);
+        const std::string code((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+        return code.find("BATCHED_MATERIALS") != std::string::npos;
+    }
+
+    /**
+     * @brief The batched variant of the material shader, nullptr when its sources don't handle BATCHED_MATERIALS.
+     * @details Any shader reading drawParameters and the map arrays under that define is batched (basic.vert/frag do),
+     * the sources are read once per program.
+     */
+    Shader* GetVariant(BatcherState& state, Shader* shader)
+    {
+        if (!shader || shader->vertexPath.empty() || shader->fragmentPath.empty()) return nullptr;
+
+        ShaderVariant& variant = state.variants[shader->getProgramID()];
+        const std::string sources = shader->vertexPath + "|" + shader->fragmentPath;
+        if (variant.sources == sources) return variant.shader;
+
+        delete variant.shader;
+        variant.shader = nullptr;
+        variant.sources = sources;
+        if (DeclaresBatching(shader->vertexPath) && DeclaresBatching(shader->fragmentPath))
+        {
+            variant.shader = new Shader(shader->vertexPath, shader->fragmentPath, PulseEngineGraphicsAPI, {"BATCHED_MATERIALS"});
+        }
+        else
+        {
+            EDITOR_LOG("Material batching : " << shader->vertexPath << " has no BATCHED_MATERIALS path, its materials are drawn per object")
+        }
+        return variant.shader;
+    }
+
+    /// @brief Distinct materials of the objects drawn per object, sorts materials.
+    std::size_t CountMaterials(std::vector<const Material*>& materials)
+    {
+        std::sort(materials.begin(), materials.end());
+        return std::unique(materials.begin(), materials.end()) - materials.begin();
+    }
+
+    void ReportStats(const MaterialBatchStats& stats)
+    {
+        PROFILE_COUNTER("Material batching", {
+            {"batchedObjects", (double)stats.batchedObjects},
+            {"fallbackObjects", (double)stats.fallbackObjects},
+            {"unbatchedMaterials", (double)stats.unbatchedMaterials},
+            {"instances", (double)stats.instances},
+            {"batches", (double)stats.batches}
+        });
+    }
+
+    /// @brief The layers of the three maps, false when one is missing, loading or can't be packed.
+    bool GetMapSlots(const RenderObject& object, TextureArraySlot slots[MAP_COUNT])
+    {
+        if (!object.mapsReady) return false;
+        for (int i = 0; i < MAP_COUNT; ++i)
+        {
+            slots[i] = PulseEngineGraphicsAPI->GetTextureArraySlot(object.maps[i]);
+            if (!slots[i].IsValid()) return false;
+        }
+        return true;
+    }
+
+    void UseVariant(Shader* shader, const RenderView& camera, unsigned int parameterTexture)
+    {
+        shader->Use();
+        shader->SetMat4("projection", camera.projection);
+        shader->SetMat4("view", camera.view);
+        shader->SetVec3("viewPos", camera.position);
+        LightManager::BindLightsToShader(shader, PulseEngine::Vector3(1.0f));
+
+        PulseEngineGraphicsAPI->ActivateTexture(DRAW_PARAMETERS_UNIT);
+        PulseEngineGraphicsAPI->BindTexture(TEXTURE_BUFFER, parameterTexture);
+        shader->SetInt("drawParameters", DRAW_PARAMETERS_UNIT);
+        for (int i = 0; i < MAP_COUNT; ++i) shader->SetInt(MAP_SAMPLERS[i], FIRST_MAP_UNIT + i);
+        // never skinned : the skinned objects are drawn per object
+        SkinningStage::UnbindPalette(shader);
+    }
+}
+
+void MaterialBatcher::Render(const RenderSnapshot &snapshot, std::vector<std::uint32_t> &fallback)
+{
+    PROFILE_TIMER_FUNCTION;
+    BatcherState& state = GetState();
+    state.stats = MaterialBatchStats();
+    state.items.clear();
+    state.unbatchedMaterials.clear();
+    fallback.clear();
+
+    IGraphicsAPI* gAPI = PulseEngineGraphicsAPI;
+    if (!enabled || !gAPI)
+    {
+        fallback = snapshot.visible;
+        state.stats.fallbackObjects = fallback.size();
+        return;
+    }
+
+    for (std::uint32_t index : snapshot.visible)
+    {
+        const RenderObject& object = snapshot.objects[index];
+        Shader* variant = object.material && !object.skinned ? GetVariant(state, object.material->GetShader()) : nullptr;
+
+        TextureArraySlot slots[MAP_COUNT];
+        if (!variant || object.meshCount == 0 || !GetMapSlots(object, slots))
+        {
+            fallback.push_back(index);
+            if (object.material) state.unbatchedMaterials.push_back(object.material);
+            continue;
+        }
+
+        state.draws.clear();
+        const std::size_t firstItem = state.items.size();
+        bool collected = true;
+        for (std::uint32_t i = 0; i < object.meshCount && collected; ++i)
+        {
+            const RenderMeshInstance& instance = snapshot.meshes[object.firstMesh + i];
+            const std::size_t first = state.draws.size();
+            collected = instance.firstBone < 0 && instance.mesh->CollectDraws(instance.matrix, snapshot.view, state.draws);
+            if (!collected) break;
+
+            for (std::size_t d = first; d < state.draws.size(); ++d)
+            {
+                const MeshDraw& draw = state.draws[d];
+                BatchItem item;
+                item.shader = variant;
+                item.pipeline = PackPipelineState(object.pipelineState);
+                item.geometry = draw.mesh->GetGuid() ? draw.mesh->GetGuid() : reinterpret_cast<std::uintptr_t>(draw.mesh);
+                item.subMesh = draw.subMesh;
+                item.lod = draw.lod;
+                item.state = &object.pipelineState;
+                item.mesh = draw.mesh;
+                item.matrix = &instance.matrix;
+                for (int m = 0; m < MAP_COUNT; ++m)
+                {
+                    item.arrays[m] = slots[m].array;
+                    item.layers[m] = static_cast<float>(slots[m].layer);
+                }
+                state.items.push_back(item);
+            }
+        }
+        // a mesh without index buffer or with bones : the whole object is drawn per object
+        if (!collected)
+        {
+            state.items.resize(firstItem);
+            fallback.push_back(index);
+            if (object.material) state.unbatchedMaterials.push_back(object.material);
+            continue;
+        }
+        state.stats.batchedObjects++;
+    }
+    state.stats.fallbackObjects = fallback.size();
+    state.stats.unbatchedMaterials = CountMaterials(state.unbatchedMaterials);
+    if (state.items.empty())
+    {
+        ReportStats(state.stats);
+        return;
+    }
+
+    // same shader, state, arrays and geometry next to each other : each run is one draw
+    std::stable_sort(state.items.begin(), state.items.end(),
+        [](const BatchItem& a, const BatchItem& b) { return a.Key() < b.Key(); });
+
+    state.parameters.resize(state.items.size() * DRAW_PARAMETER_FLOATS);
+    float* parameters = state.parameters.data();
+    for (const BatchItem& item : state.items)
+    {
+        // Mat4 is column major : a column per texel, as mat4() takes them
+        std::memcpy(parameters, &item.matrix->data[0][0], 16 * sizeof(float));
+        parameters[16] = item.layers[0];
+        parameters[17] = item.layers[1];
+        parameters[18] = item.layers[2];
+        parameters[19] = 0.0f;
+        parameters += DRAW_PARAMETER_FLOATS;
+    }
+
+    if (!state.parameterTexture) gAPI->CreateTextureBuffer(&state.parameterBuffer, &state.parameterTexture, TEXTURE_BUFFER_RGBA32F);
+    gAPI->UploadTextureBuffer(state.parameterBuffer, state.parameters.data(), state.parameters.size() * sizeof(float));
+
+    Shader* bound = nullptr;
+    for (std::size_t first = 0; first < state.items.size();)
+    {
+        const BatchItem& batch = state.items[first];
+        std::size_t end = first + 1;
+        while (end < state.items.size() && state.items[end].Key() == batch.Key()) ++end;
+
+        if (batch.shader != bound)
+        {
+            UseVariant(batch.shader, snapshot.view, state.parameterTexture);
+            bound = batch.shader;
+        }
+        gAPI->SetPipelineState(*batch.state);
+        for (int m = 0; m < MAP_COUNT; ++m)
+        {
+            gAPI->ActivateTexture(FIRST_MAP_UNIT + m);
+            gAPI->BindTexture(TEXTURE_2D_ARRAY, batch.arrays[m]);
+        }
+        batch.shader->SetInt("drawBase", static_cast<int>(first));
+        batch.mesh->DrawInstanced(batch.lod, static_cast<unsigned int>(end - first));
+
+        state.stats.instances += end - first;
+        state.stats.batches++;
+        first = end;
+    }
+    gAPI->SetPipelineState(PipelineState());
+
+    ReportStats(state.stats);
+}
+
+const MaterialBatchStats &MaterialBatcher::GetStats()
+{
+    return GetState().stats;
+}
@@ -0,0 +1,61 @@
+/**
+ * @file MaterialBatcher.h
+ * @brief Draws the visible objects of different materials together : one instanced draw per mesh asset, pipeline
+ * state and set of texture arrays, instead of one draw and three texture binds per object.
+ * @details The albedo, normal and roughness maps of a material are copied in texture arrays by the backend
+ * (IGraphicsAPI::GetTextureArraySlot) : materials whose maps share size and format sample the same arrays, a layer each.
+ * Every batched object writes its model matrix and its layers in one buffer texture, uploaded once per frame, that
+ * the BATCHED_MATERIALS variant of the material shader reads at gl_InstanceID.
+ * - Objects are batched by the program of their material shader : any shader whose sources handle BATCHED_MATERIALS
+ *   (basic.vert/frag do) gets a variant, the others are drawn per object and counted in unbatchedMaterials.
+ * - Objects are drawn together when their meshes come from the same asset (mesh guid) : entities don't share their
+ *   GPU buffers, the first one of the batch is drawn for all of them.
+ * - Anything else goes back to the caller, drawn per object with its own bindings : skinned meshes, shaders without
+ *   BATCHED_MATERIALS, a map missing or still loading, or a backend without texture arrays.
+ * @version 0.1
+ * @date 2025-12-14
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+#ifndef MATERIALBATCHER_H
+#define MATERIALBATCHER_H
+
+#include "Common/dllExport.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+class RenderSnapshot;
+
+namespace PulseEngine::Graphics
+{
+    struct MaterialBatchStats
+    {
+        std::size_t batchedObjects = 0;
+        std::size_t fallbackObjects = 0;    ///< drawn per object by the caller
+        std::size_t unbatchedMaterials = 0; ///< distinct materials of the fallback objects
+        std::size_t instances = 0;          ///< sub-meshes drawn in the batches
+        std::size_t batches = 0;            ///< instanced draws
+    };
+
+    class PULSE_ENGINE_DLL_API MaterialBatcher
+    {
+    public:
+        /// @brief false : every object is given back to the per object path.
+        static bool enabled;
+
+        /**
+         * @brief Draw the visible objects of snapshot that can be batched, on the graphics thread, after
+         * LightManager::PrepareView. Leaves the default PipelineState.
+         * @param fallback cleared, then filled with the indices (in snapshot.objects) of the visible objects left to
+         * draw, in their draw order
+         */
+        static void Render(const RenderSnapshot& snapshot, std::vector<std::uint32_t>& fallback);
+
+        static const MaterialBatchStats& GetStats();
+    };
+}
+
+#endif // MATERIALBATCHER_H
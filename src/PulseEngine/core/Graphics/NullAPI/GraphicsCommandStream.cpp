@@ -0,0 +1,127 @@
+#include "GraphicsCommandStream.h"
+
+#include <cstring>
+
+using namespace PulseEngine::Graphics;
+
+GraphicsCounters& GraphicsCounters::operator+=(const GraphicsCounters& other)
+{
+    frames += other.frames;
+    commands += other.commands;
+    drawCalls += other.drawCalls;
+    indices += other.indices;
+    lineDraws += other.lineDraws;
+    shaderBinds += other.shaderBinds;
+    redundantShaderBinds += other.redundantShaderBinds;
+    textureBinds += other.textureBinds;
+    redundantTextureBinds += other.redundantTextureBinds;
+    framebufferBinds += other.framebufferBinds;
+    redundantFramebufferBinds += other.redundantFramebufferBinds;
+    pipelineStates += other.pipelineStates;
+    redundantPipelineStates += other.redundantPipelineStates;
+    uniformSets += other.uniformSets;
+    uniformBytes += other.uniformBytes;
+    meshUploads += other.meshUploads;
+    textureUploads += other.textureUploads;
+    bufferUploads += other.bufferUploads;
+    uploadedBytes += other.uploadedBytes;
+    return *this;
+}
+
+void GraphicsCommandStream::Record(GraphicsCommandType type, uint32_t a, uint32_t b, uint32_t c)
+{
+    GraphicsCommand command;
+    command.type = type;
+    command.a = a;
+    command.b = b;
+    command.c = c;
+    commands.push_back(command);
+}
+
+void GraphicsCommandStream::RecordUniform(uint32_t shader, const std::string& name, UniformKind kind, const void* data, std::size_t size)
+{
+    GraphicsCommand command;
+    command.type = GraphicsCommandType::SetUniform;
+    command.a = shader;
+    command.b = InternName(name);
+    command.c = static_cast<uint32_t>(kind);
+    command.payloadOffset = static_cast<uint32_t>(payload.size());
+    command.payloadSize = static_cast<uint32_t>(size);
+    if (size > 0)
+    {
+        payload.resize(payload.size() + size);
+        std::memcpy(payload.data() + command.payloadOffset, data, size);
+    }
+    commands.push_back(command);
+}
+
+void GraphicsCommandStream::Clear()
+{
+    commands.clear();
+    payload.clear();
+}
+
+void GraphicsCommandStream::MoveTo(GraphicsCommandStream& target)
+{
+    target.commands.swap(commands);
+    target.payload.swap(payload);
+    for (std::size_t i = target.names.size(); i < names.size(); ++i)
+    {
+        target.nameIds.emplace(names[i], static_cast<uint32_t>(i));
+        target.names.push_back(names[i]);
+    }
+    Clear();
+}
+
+void GraphicsCommandStream::Replay(const Visitor& visitor) const
+{
+    for (const GraphicsCommand& command : commands)
+    {
+        visitor(command, command.payloadSize > 0 ? payload.data() + command.payloadOffset : nullptr);
+    }
+}
+
+uint32_t GraphicsCommandStream::InternName(const std::string& name)
+{
+    auto it = nameIds.find(name);
+    if (it != nameIds.end()) return it->second;
+
+    const uint32_t id = static_cast<uint32_t>(names.size());
+    names.push_back(name);
+    nameIds.emplace(name, id);
+    return id;
+}
+
+const char* GraphicsCommandStream::ToString(GraphicsCommandType type)
+{
+    switch (type)
+    {
+        case GraphicsCommandType::StartFrame: return "StartFrame";
+        case GraphicsCommandType::EndFrame: return "EndFrame";
+        case GraphicsCommandType::UseShader: return "UseShader";
+        case GraphicsCommandType::SetUniform: return "SetUniform";
+        case GraphicsCommandType::ActivateTexture: return "ActivateTexture";
+        case GraphicsCommandType::BindTexture: return "BindTexture";
+        case GraphicsCommandType::BindFramebuffer: return "BindFramebuffer";
+        case GraphicsCommandType::InitCubeMapFace: return "InitCubeMapFace";
+        case GraphicsCommandType::CreateShader: return "CreateShader";
+        case GraphicsCommandType::CreateFramebuffer: return "CreateFramebuffer";
+        case GraphicsCommandType::UploadMesh: return "UploadMesh";
+        case GraphicsCommandType::DeleteMesh: return "DeleteMesh";
+        case GraphicsCommandType::UploadTexture: return "UploadTexture";
+        case GraphicsCommandType::DeleteTexture: return "DeleteTexture";
+        case GraphicsCommandType::CreateBuffer: return "CreateBuffer";
+        case GraphicsCommandType::UploadBuffer: return "UploadBuffer";
+        case GraphicsCommandType::DeleteBuffer: return "DeleteBuffer";
+        case GraphicsCommandType::CopyTexture: return "CopyTexture";
+        case GraphicsCommandType::DrawMesh: return "DrawMesh";
+        case GraphicsCommandType::DrawMeshInstanced: return "DrawMeshInstanced";
+        case GraphicsCommandType::DrawLines: return "DrawLines";
+        case GraphicsCommandType::DrawGrid: return "DrawGrid";
+        case GraphicsCommandType::DrawText: return "DrawText";
+        case GraphicsCommandType::SetWireframe: return "SetWireframe";
+        case GraphicsCommandType::SetBackCull: return "SetBackCull";
+        case GraphicsCommandType::SetPipelineState: return "SetPipelineState";
+    }
+    return "Unknown";
+}
@@ -0,0 +1,149 @@
+/**
+ * @file GraphicsCommandStream.h
+ * @brief Compact record of the IGraphicsAPI calls of a frame, written by NullGraphicsAPI.
+ * @details A command is 24 bytes : its type and up to three handles or counts. Uniform names are interned once in a
+ * name table, uniform values go to a payload buffer the command points into. Replay walks the commands in order, to
+ * diff two frames, rebuild counters, or feed another tool.
+ * @version 0.1
+ * @date 2025-12-14
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+#ifndef GRAPHICSCOMMANDSTREAM_H
+#define GRAPHICSCOMMANDSTREAM_H
+
+#include "Common/dllExport.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace PulseEngine::Graphics
+{
+    enum class GraphicsCommandType : uint8_t
+    {
+        StartFrame,             ///< a = framebuffer (0 : default), b c = size
+        EndFrame,               ///< a = onlyUnbind
+        UseShader,              ///< a = shader
+        SetUniform,             ///< a = shader, b = name, c = UniformKind, payload = values
+        ActivateTexture,        ///< a = unit
+        BindTexture,            ///< a = TextureType, b = texture
+        BindFramebuffer,        ///< a = framebuffer (0 : default)
+        InitCubeMapFace,        ///< a = cube map, b = face
+        CreateShader,           ///< a = shader
+        CreateFramebuffer,      ///< a = framebuffer, b = color or depth texture
+        UploadMesh,             ///< a = VAO, b = vertex count, c = index count
+        DeleteMesh,             ///< a = VAO
+        UploadTexture,          ///< a = texture, b = bytes
+        DeleteTexture,          ///< a = texture
+        CreateBuffer,           ///< a = buffer, b = buffer texture, c = TextureBufferFormat
+        UploadBuffer,           ///< a = buffer, b = bytes
+        DeleteBuffer,           ///< a = buffer, b = buffer texture
+        CopyTexture,            ///< a = source, b = target, c = faces
+        DrawMesh,               ///< a = VAO, b = index offset, c = index count
+        DrawMeshInstanced,      ///< a = VAO, b = index count, c = instance count
+        DrawLines,              ///< a = VAO (0 : immediate line), c = index count
+        DrawGrid,
+        DrawText,               ///< c = glyph count
+        SetWireframe,           ///< a = enabled
+        SetBackCull,
+        SetPipelineState        ///< a = depth test | depth write << 1 | wireframe << 2 | depth function << 3, b = blend, c = cull
+    };
+
+    enum class UniformKind : uint8_t
+    {
+        Mat4, Mat3, Vec3, Float, Bool, Int, IntArray, Vec3Array, FloatArray, Mat4Array
+    };
+
+    struct GraphicsCommand
+    {
+        GraphicsCommandType type;
+        uint32_t a = 0;
+        uint32_t b = 0;
+        uint32_t c = 0;
+        uint32_t payloadOffset = 0;     ///< bytes, in GetPayload()
+        uint32_t payloadSize = 0;
+    };
+    static_assert(sizeof(GraphicsCommand) == 24, "GraphicsCommand is meant to stay 24 bytes");
+
+    /**
+     * @brief What a frame cost the CPU side of the renderer. Redundant : same shader, texture or framebuffer again.
+     */
+    struct GraphicsCounters
+    {
+        std::uint64_t frames = 0;
+        std::uint64_t commands = 0;
+        std::uint64_t drawCalls = 0;
+        std::uint64_t indices = 0;
+        std::uint64_t lineDraws = 0;
+        std::uint64_t shaderBinds = 0;
+        std::uint64_t redundantShaderBinds = 0;
+        std::uint64_t textureBinds = 0;
+        std::uint64_t redundantTextureBinds = 0;
+        std::uint64_t framebufferBinds = 0;
+        std::uint64_t redundantFramebufferBinds = 0;
+        std::uint64_t pipelineStates = 0;
+        std::uint64_t redundantPipelineStates = 0;
+        std::uint64_t uniformSets = 0;
+        std::uint64_t uniformBytes = 0;
+        std::uint64_t meshUploads = 0;
+        std::uint64_t textureUploads = 0;
+        std::uint64_t bufferUploads = 0;
+        std::uint64_t uploadedBytes = 0;
+
+        /// @brief Binds that changed the pipeline state : what a real driver pays for.
+        std::uint64_t GetStateChanges() const
+        {
+            return shaderBinds - redundantShaderBinds + textureBinds - redundantTextureBinds + framebufferBinds - redundantFramebufferBinds
+                + pipelineStates - redundantPipelineStates;
+        }
+
+        GraphicsCounters& operator+=(const GraphicsCounters& other);
+    };
+
+    class PULSE_ENGINE_DLL_API GraphicsCommandStream
+    {
+    public:
+        using Visitor = std::function<void(const GraphicsCommand& command, const char* payload)>;
+
+        void Record(GraphicsCommandType type, uint32_t a = 0, uint32_t b = 0, uint32_t c = 0);
+        void RecordUniform(uint32_t shader, const std::string& name, UniformKind kind, const void* data, std::size_t size);
+
+        /**
+         * @brief Commands and payload are dropped, the name table is kept (ids stay valid across frames).
+         */
+        void Clear();
+
+        /**
+         * @brief target gets the commands and the payload, this stream is cleared. The names target misses are
+         * copied, so the ids resolve in both. The recycled buffers keep their capacity.
+         */
+        void MoveTo(GraphicsCommandStream& target);
+
+        /**
+         * @brief Visit every command in recording order, payload is nullptr for the commands without one.
+         */
+        void Replay(const Visitor& visitor) const;
+
+        const std::vector<GraphicsCommand>& GetCommands() const { return commands; }
+        const std::vector<char>& GetPayload() const { return payload; }
+        const std::string& GetName(uint32_t id) const { return names[id]; }
+        std::size_t GetMemorySize() const { return commands.size() * sizeof(GraphicsCommand) + payload.size(); }
+
+        static const char* ToString(GraphicsCommandType type);
+
+    private:
+        uint32_t InternName(const std::string& name);
+
+        std::vector<GraphicsCommand> commands;
+        std::vector<char> payload;
+        std::vector<std::string> names;
+        std::unordered_map<std::string, uint32_t> nameIds;
+    };
+}
+
+#endif // GRAPHICSCOMMANDSTREAM_H
@@ -0,0 +1,487 @@
+#include "PulseEngine/core/Graphics/NullAPI/NullGraphicsApi.h"
+#include "PulseEngine/core/Graphics/TextRenderer.h"
+#include "PulseEngine/core/Material/Cooking/CookedTexture.h"
+#include "PulseEngine/core/Meshes/Vertex.h"
+#include "Common/common.h"
+
+#include <algorithm>
+
+using namespace PulseEngine::Graphics;
+
+namespace
+{
+    class NullTextRenderer : public ITextRenderer
+    {
+    public:
+        explicit NullTextRenderer(NullGraphicsAPI* api) : api(api) {}
+
+        bool Init() override { return true; }
+        void SetScreenSize(int w, int h) override {}
+
+        void RenderText(const std::string& text, float x, float y, float size, const PulseEngine::Vector3& color) override
+        {
+            glyphs += text.size();
+        }
+
+        void Render() override
+        {
+            api->RecordText(glyphs);
+            glyphs = 0;
+        }
+
+    private:
+        NullGraphicsAPI* api;
+        std::size_t glyphs = 0;
+    };
+
+    void LogCounters(const char* label, const GraphicsCounters& counters)
+    {
+        EDITOR_INFO("Null graphics " << label << " : " << counters.frames << " frames, " << counters.drawCalls << " draw calls, "
+            << counters.indices << " indices, " << counters.GetStateChanges() << " state changes ("
+            << counters.redundantShaderBinds + counters.redundantTextureBinds + counters.redundantFramebufferBinds
+            + counters.redundantPipelineStates << " redundant binds), "
+            << counters.uniformSets << " uniform sets, " << counters.uploadedBytes << " bytes uploaded")
+    }
+}
+
+bool NullGraphicsAPI::InitializeApi(const char *title, int *width, int *height)
+{
+    this->width = width;
+    this->height = height;
+    boundTextures.assign(32, 0);
+    EDITOR_INFO("Headless graphics (" << title << "), " << *width << "x" << *height
+        << ", frame limit " << settings.frameLimit << ", commands " << (settings.recordCommands ? "recorded" : "counted only"))
+    return true;
+}
+
+void NullGraphicsAPI::ShutdownApi()
+{
+    LogCounters("total", totalCounters);
+    if (totalCounters.frames > 0)
+    {
+        const double frames = (double)totalCounters.frames;
+        EDITOR_INFO("Null graphics per frame : " << totalCounters.drawCalls / frames << " draw calls, "
+            << totalCounters.GetStateChanges() / frames << " state changes, " << totalCounters.uniformSets / frames << " uniform sets")
+    }
+    current.Clear();
+    lastFrame.Clear();
+}
+
+void NullGraphicsAPI::SwapBuffers() const
+{
+    counters.frames++;
+    frameIndex++;
+    time += settings.frameTime;
+
+    PROFILE_COUNTER("Null graphics", {
+        {"drawCalls", (double)counters.drawCalls},
+        {"indices", (double)counters.indices},
+        {"stateChanges", (double)counters.GetStateChanges()},
+        {"uniformSets", (double)counters.uniformSets},
+        {"commandsKB", (double)current.GetMemorySize() / 1024.0}
+    });
+
+    lastFrameCounters = counters;
+    totalCounters += counters;
+    counters = GraphicsCounters();
+    current.MoveTo(lastFrame);
+}
+
+bool NullGraphicsAPI::ShouldClose() const
+{
+    return settings.frameLimit != 0 && frameIndex >= settings.frameLimit;
+}
+
+void NullGraphicsAPI::ResetCounters()
+{
+    counters = GraphicsCounters();
+    lastFrameCounters = GraphicsCounters();
+    totalCounters = GraphicsCounters();
+}
+
+void NullGraphicsAPI::Record(GraphicsCommandType type, uint32_t a, uint32_t b, uint32_t c) const
+{
+    counters.commands++;
+    if (settings.recordCommands) current.Record(type, a, b, c);
+}
+
+void NullGraphicsAPI::RecordUniform(const Shader *shader, const std::string &name, UniformKind kind, const void *data, std::size_t size) const
+{
+    counters.commands++;
+    counters.uniformSets++;
+    counters.uniformBytes += size;
+    if (settings.recordCommands) current.RecordUniform(shader ? shader->getProgramID() : 0, name, kind, data, size);
+}
+
+void NullGraphicsAPI::BindFramebuffer(unsigned int framebuffer) const
+{
+    counters.framebufferBinds++;
+    if (framebuffer == boundFramebuffer) counters.redundantFramebufferBinds++;
+    boundFramebuffer = framebuffer;
+    Record(GraphicsCommandType::BindFramebuffer, framebuffer);
+}
+
+void NullGraphicsAPI::DrawGridQuad(PulseEngine::Mat4 viewCam, const PulseEngine::Mat4 &specificProjection, IGraphicsAPI *graphicsAPI)
+{
+    counters.drawCalls++;
+    counters.indices += 6;
+    Record(GraphicsCommandType::DrawGrid);
+}
+
+void NullGraphicsAPI::DrawLine(const PulseEngine::Vector3 &start, const PulseEngine::Vector3 &end, const PulseEngine::Color &color)
+{
+    counters.drawCalls++;
+    counters.lineDraws++;
+    counters.indices += 2;
+    Record(GraphicsCommandType::DrawLines, 0, 0, 2);
+}
+
+void NullGraphicsAPI::SetWindowSize(int width, int height) const
+{
+    *this->width = width;
+    *this->height = height;
+}
+
+unsigned int NullGraphicsAPI::CreateShader(const std::string &vertexPath, const std::string &fragmentPath)
+{
+    const unsigned int shader = NewHandle();
+    Record(GraphicsCommandType::CreateShader, shader);
+    return shader;
+}
+
+unsigned int NullGraphicsAPI::CreateShader(const std::string &vertexPath, const std::string &fragmentPath, const std::string &geometryPath)
+{
+    return CreateShader(vertexPath, fragmentPath);
+}
+
+unsigned int NullGraphicsAPI::CreateShader(const std::string &vertexPath, const std::string &fragmentPath, const std::vector<std::string> &defines)
+{
+    return CreateShader(vertexPath, fragmentPath);
+}
+
+void NullGraphicsAPI::UseShader(unsigned int shaderID) const
+{
+    counters.shaderBinds++;
+    if (shaderID == boundShader) counters.redundantShaderBinds++;
+    boundShader = shaderID;
+    Record(GraphicsCommandType::UseShader, shaderID);
+}
+
+void NullGraphicsAPI::SetShaderMat4(const Shader *shader, const std::string &name, const PulseEngine::Mat4 &mat) const
+{
+    float values[16];
+    for (int column = 0; column < 4; ++column)
+        for (int row = 0; row < 4; ++row)
+            values[column * 4 + row] = mat[column][row];
+    RecordUniform(shader, name, UniformKind::Mat4, values, sizeof(values));
+}
+
+void NullGraphicsAPI::SetShaderMat3(const Shader *shader, const std::string &name, const PulseEngine::Mat3 &mat) const
+{
+    float values[9];
+    for (int column = 0; column < 3; ++column)
+        for (int row = 0; row < 3; ++row)
+            values[column * 3 + row] = mat[column][row];
+    RecordUniform(shader, name, UniformKind::Mat3, values, sizeof(values));
+}
+
+void NullGraphicsAPI::SetShaderVec3(const Shader *shader, const std::string &name, const PulseEngine::Vector3 &vec) const
+{
+    const float values[3] = { vec.x, vec.y, vec.z };
+    RecordUniform(shader, name, UniformKind::Vec3, values, sizeof(values));
+}
+
+void NullGraphicsAPI::SetShaderFloat(const Shader *shader, const std::string &name, float value) const
+{
+    RecordUniform(shader, name, UniformKind::Float, &value, sizeof(value));
+}
+
+void NullGraphicsAPI::SetShaderBool(const Shader *shader, const std::string &name, bool value) const
+{
+    const int asInt = value ? 1 : 0;
+    RecordUniform(shader, name, UniformKind::Bool, &asInt, sizeof(asInt));
+}
+
+void NullGraphicsAPI::SetShaderInt(const Shader *shader, const std::string &name, int value) const
+{
+    RecordUniform(shader, name, UniformKind::Int, &value, sizeof(value));
+}
+
+void NullGraphicsAPI::SetShaderIntArray(const Shader *shader, const std::string &name, const int *values, int count) const
+{
+    RecordUniform(shader, name, UniformKind::IntArray, values, sizeof(int) * std::max(count, 0));
+}
+
+void NullGraphicsAPI::SetShaderVec3Array(const Shader *shader, const std::string &name, const std::vector<PulseEngine::Vector3> &vecArray) const
+{
+    std::vector<float> values;
+    values.reserve(vecArray.size() * 3);
+    for (const PulseEngine::Vector3& v : vecArray)
+    {
+        values.push_back(v.x);
+        values.push_back(v.y);
+        values.push_back(v.z);
+    }
+    RecordUniform(shader, name, UniformKind::Vec3Array, values.data(), values.size() * sizeof(float));
+}
+
+void NullGraphicsAPI::SetShaderFloatArray(const Shader *shader, const std::string &name, const std::vector<float> &floatArray) const
+{
+    RecordUniform(shader, name, UniformKind::FloatArray, floatArray.data(), floatArray.size() * sizeof(float));
+}
+
+void NullGraphicsAPI::SetShaderMat4Array(const Shader *shader, const std::string &name, const std::vector<PulseEngine::Mat4> &array) const
+{
+    // same cap as the GL backend
+    const std::size_t count = std::min<std::size_t>(array.size(), 128);
+    RecordUniform(shader, name, UniformKind::Mat4Array, array.data(), count * sizeof(PulseEngine::Mat4));
+}
+
+void NullGraphicsAPI::ActivateTexture(unsigned int textureID) const
+{
+    activeUnit = textureID;
+    if (activeUnit >= boundTextures.size()) boundTextures.resize(activeUnit + 1, 0);
+    Record(GraphicsCommandType::ActivateTexture, textureID);
+}
+
+void NullGraphicsAPI::BindTexture(TextureType type, unsigned int textureID) const
+{
+    if (activeUnit >= boundTextures.size()) boundTextures.resize(activeUnit + 1, 0);
+    counters.textureBinds++;
+    if (boundTextures[activeUnit] == textureID) counters.redundantTextureBinds++;
+    boundTextures[activeUnit] = textureID;
+    Record(GraphicsCommandType::BindTexture, static_cast<uint32_t>(type), textureID);
+}
+
+void NullGraphicsAPI::GenerateDepthCubeMap(unsigned int *FBO, unsigned int *depthCubeMap) const
+{
+    *FBO = NewHandle();
+    *depthCubeMap = NewHandle();
+    Record(GraphicsCommandType::CreateFramebuffer, *FBO, *depthCubeMap);
+}
+
+void NullGraphicsAPI::InitCubeMapFaceForRender(unsigned int *CubeMap, unsigned int faceIndex) const
+{
+    Record(GraphicsCommandType::InitCubeMapFace, *CubeMap, faceIndex);
+}
+
+void NullGraphicsAPI::GenerateTextureMap(unsigned int *textureID, const std::string &filePath, bool hasFlip) const
+{
+    *textureID = NewHandle();
+    counters.textureUploads++;
+    Record(GraphicsCommandType::UploadTexture, *textureID);
+}
+
+void NullGraphicsAPI::UploadTexture(unsigned int *textureID, const unsigned char *pixels, int width, int height, int channels) const
+{
+    *textureID = NewHandle();
+    const std::uint64_t bytes = (std::uint64_t)width * (std::uint64_t)height * (std::uint64_t)channels;
+    counters.textureUploads++;
+    counters.uploadedBytes += bytes;
+    Record(GraphicsCommandType::UploadTexture, *textureID, static_cast<uint32_t>(bytes));
+}
+
+bool NullGraphicsAPI::UploadCookedTexture(unsigned int *textureID, const PulseEngine::Cooking::CookedTexture &texture) const
+{
+    *textureID = NewHandle();
+    std::uint64_t bytes = 0;
+    for (const PulseEngine::Cooking::CookedMipEntry& mip : texture.mips) bytes += mip.size;
+    counters.textureUploads++;
+    counters.uploadedBytes += bytes;
+    Record(GraphicsCommandType::UploadTexture, *textureID, static_cast<uint32_t>(bytes));
+    return true;
+}
+
+void NullGraphicsAPI::DeleteTexture(unsigned int textureID) const
+{
+    std::replace(boundTextures.begin(), boundTextures.end(), textureID, 0u);
+    Record(GraphicsCommandType::DeleteTexture, textureID);
+}
+
+void NullGraphicsAPI::CreateTextureBuffer(unsigned int *buffer, unsigned int *textureID, TextureBufferFormat format) const
+{
+    *buffer = NewHandle();
+    *textureID = NewHandle();
+    Record(GraphicsCommandType::CreateBuffer, *buffer, *textureID, static_cast<uint32_t>(format));
+}
+
+void NullGraphicsAPI::UploadTextureBuffer(unsigned int buffer, const void *data, std::size_t size) const
+{
+    if (!buffer || size == 0) return;
+    counters.bufferUploads++;
+    counters.uploadedBytes += size;
+    Record(GraphicsCommandType::UploadBuffer, buffer, static_cast<uint32_t>(size));
+}
+
+void NullGraphicsAPI::DeleteTextureBuffer(unsigned int buffer, unsigned int textureID) const
+{
+    std::replace(boundTextures.begin(), boundTextures.end(), textureID, 0u);
+    Record(GraphicsCommandType::DeleteBuffer, buffer, textureID);
+}
+
+void NullGraphicsAPI::GenerateShadowMap(unsigned int *shadowMap, unsigned int *FBO, int width, int height) const
+{
+    *shadowMap = NewHandle();
+    *FBO = NewHandle();
+    Record(GraphicsCommandType::CreateFramebuffer, *FBO, *shadowMap);
+}
+
+void NullGraphicsAPI::BindShadowFramebuffer(unsigned int *FBO, bool clear) const
+{
+    BindFramebuffer(*FBO);
+}
+
+void NullGraphicsAPI::CopyShadowMap(unsigned int sourceTexture, unsigned int targetTexture, int size, bool cubeMap) const
+{
+    Record(GraphicsCommandType::CopyTexture, sourceTexture, targetTexture, cubeMap ? 6u : 1u);
+}
+
+void NullGraphicsAPI::UnbindShadowFramebuffer() const
+{
+    BindFramebuffer(0);
+}
+
+void NullGraphicsAPI::SetupSimpleSquare(unsigned int *VAO, unsigned int *VBO, unsigned int *EBO) const
+{
+    *VAO = NewHandle();
+    *VBO = NewHandle();
+    *EBO = NewHandle();
+    counters.meshUploads++;
+    Record(GraphicsCommandType::UploadMesh, *VAO, 4, 6);
+}
+
+void NullGraphicsAPI::DeleteMesh(unsigned int *VAO, unsigned int *VBO, unsigned int *EBO) const
+{
+    Record(GraphicsCommandType::DeleteMesh, *VAO);
+    *VAO = 0;
+    *VBO = 0;
+    *EBO = 0;
+}
+
+void NullGraphicsAPI::SetupMesh(unsigned int *VAO, unsigned int *VBO, unsigned int *EBO, const std::vector<Vertex> &vertices,
+                                const std::vector<SkinWeights> &skin, const std::vector<unsigned int> &indices) const
+{
+    *VAO = NewHandle();
+    *VBO = NewHandle();
+    *EBO = NewHandle();
+    counters.meshUploads++;
+    counters.uploadedBytes += vertices.size() * sizeof(Vertex) + skin.size() * sizeof(SkinWeights) + indices.size() * sizeof(unsigned int);
+    Record(GraphicsCommandType::UploadMesh, *VAO, static_cast<uint32_t>(vertices.size()), static_cast<uint32_t>(indices.size()));
+}
+
+void NullGraphicsAPI::RenderMesh(unsigned int *VAO, unsigned int *VBO, const std::vector<Vertex> &vertices, const std::vector<unsigned int> &indices) const
+{
+    RenderMeshRange(VAO, 0, static_cast<unsigned int>(indices.size()));
+}
+
+void NullGraphicsAPI::RenderMeshRange(unsigned int *VAO, unsigned int indexOffset, unsigned int indexCount) const
+{
+    counters.drawCalls++;
+    counters.indices += indexCount;
+    Record(GraphicsCommandType::DrawMesh, *VAO, indexOffset, indexCount);
+}
+
+void NullGraphicsAPI::RenderMeshRangeInstanced(unsigned int *VAO, unsigned int indexOffset, unsigned int indexCount, unsigned int instanceCount) const
+{
+    counters.drawCalls++;
+    counters.indices += static_cast<std::uint64_t>(indexCount) * instanceCount;
+    Record(GraphicsCommandType::DrawMeshInstanced, *VAO, indexCount, instanceCount);
+}
+
+void NullGraphicsAPI::StartFrame() const
+{
+    BindFramebuffer(0);
+    Record(GraphicsCommandType::StartFrame, 0, static_cast<uint32_t>(*width), static_cast<uint32_t>(*height));
+}
+
+void NullGraphicsAPI::SpecificStartFrame(int specificVBO, const PulseEngine::Vector2 &frameSize) const
+{
+    BindFramebuffer(static_cast<unsigned int>(specificVBO));
+    Record(GraphicsCommandType::StartFrame, static_cast<uint32_t>(specificVBO), static_cast<uint32_t>(frameSize.x), static_cast<uint32_t>(frameSize.y));
+}
+
+void NullGraphicsAPI::EndFrame(bool onlyUnbind) const
+{
+    BindFramebuffer(0);
+    Record(GraphicsCommandType::EndFrame, onlyUnbind ? 1 : 0);
+}
+
+void NullGraphicsAPI::ActivateBackCull() const
+{
+    Record(GraphicsCommandType::SetBackCull);
+}
+
+void NullGraphicsAPI::GenerateFrameBuffer(unsigned int *previewFBO, unsigned int *previewTexture, unsigned int *rbo, unsigned int previewWidth, unsigned int previewHeight)
+{
+    *previewFBO = NewHandle();
+    *previewTexture = NewHandle();
+    *rbo = NewHandle();
+    Record(GraphicsCommandType::CreateFramebuffer, *previewFBO, *previewTexture);
+}
+
+void NullGraphicsAPI::RenderLineMesh(unsigned int *VAO, unsigned int *VBO, const std::vector<PulseEngine::Vector3> &vertices, const std::vector<unsigned int> &indices)
+{
+    const std::size_t count = indices.empty() ? vertices.size() : indices.size();
+    counters.drawCalls++;
+    counters.lineDraws++;
+    counters.indices += count;
+    Record(GraphicsCommandType::DrawLines, *VAO, 0, static_cast<uint32_t>(count));
+}
+
+std::size_t NullGraphicsAPI::DrawLineBatch(const LineVertex *vertices, std::size_t count) const
+{
+    count -= count % 2;
+    if (count == 0) return 0;
+    counters.drawCalls++;
+    counters.lineDraws++;
+    counters.indices += count;
+    counters.uploadedBytes += count * sizeof(LineVertex);
+    Record(GraphicsCommandType::DrawLines, 0, 0, static_cast<uint32_t>(count));
+    return count;
+}
+
+void NullGraphicsAPI::ActivateWireframe()
+{
+    Record(GraphicsCommandType::SetWireframe, 1);
+}
+
+void NullGraphicsAPI::DesactivateWireframe()
+{
+    Record(GraphicsCommandType::SetWireframe, 0);
+}
+
+void NullGraphicsAPI::SetPipelineState(const PipelineState &state) const
+{
+    counters.pipelineStates++;
+    if (state == boundPipelineState) counters.redundantPipelineStates++;
+    boundPipelineState = state;
+    const uint32_t flags = (state.depthTest ? 1u : 0u) | (state.depthWrite ? 2u : 0u) | (state.wireframe ? 4u : 0u)
+        | (static_cast<uint32_t>(state.depthFunction) << 3);
+    Record(GraphicsCommandType::SetPipelineState, flags, static_cast<uint32_t>(state.blend), static_cast<uint32_t>(state.cull));
+}
+
+StateCacheCounters NullGraphicsAPI::GetStateCacheCounters() const
+{
+    const GraphicsCounters& frame = lastFrameCounters;
+    StateCacheCounters cache;
+    cache.requested = frame.shaderBinds + frame.textureBinds + frame.framebufferBinds + frame.pipelineStates;
+    cache.skippedPrograms = frame.redundantShaderBinds;
+    cache.skippedTextures = frame.redundantTextureBinds;
+    cache.skippedFramebuffers = frame.redundantFramebufferBinds;
+    cache.skippedPipelineStates = frame.redundantPipelineStates;
+    cache.skipped = cache.skippedPrograms + cache.skippedTextures + cache.skippedFramebuffers + cache.skippedPipelineStates;
+    return cache;
+}
+
+ITextRenderer *NullGraphicsAPI::CreateNewText()
+{
+    return new NullTextRenderer(this);
+}
+
+void NullGraphicsAPI::RecordText(std::size_t glyphCount)
+{
+    if (glyphCount == 0) return;
+    counters.drawCalls++;
+    counters.indices += glyphCount * 6;
+    Record(GraphicsCommandType::DrawText, 0, 0, static_cast<uint32_t>(glyphCount));
+}
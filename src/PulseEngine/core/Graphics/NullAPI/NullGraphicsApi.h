@@ -0,0 +1,161 @@
+/**
+ * @file NullGraphicsApi.h
+ * @brief Headless IGraphicsAPI : no window and no GPU, every call is recorded in a GraphicsCommandStream and counted.
+ * @details Runs the whole CPU side of the renderer (Update, RenderShadow, Render, SceneManager) on machines without
+ * a GL context, so draw calls, state changes and frame time of real scenes can be measured and compared in CI.
+ * - Handles (shaders, meshes, textures, framebuffers) are plain increasing ids, no file is read.
+ * - GetTime advances by frameTime at each SwapBuffers : a headless run is deterministic.
+ * - The counters and the commands of the last frame are kept at SwapBuffers, totals since InitializeApi are logged
+ *   by ShutdownApi.
+ * Selected by PulseEngineBackend::SetHeadless, "--headless" on the command line.
+ * @version 0.1
+ * @date 2025-12-14
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+#ifndef NULLGRAPHICSAPI_H
+#define NULLGRAPHICSAPI_H
+
+#include "PulseEngine/core/Graphics/IGraphicsApi.h"
+#include "PulseEngine/core/Graphics/NullAPI/GraphicsCommandStream.h"
+
+#include <cstdint>
+
+struct NullGraphicsSettings
+{
+    float frameTime = 1.0f / 60.0f;     ///< seconds added to GetTime per frame
+    std::uint64_t frameLimit = 0;       ///< ShouldClose after this many frames, 0 : never
+    bool recordCommands = true;         ///< false : counters only, nothing is stored
+};
+
+class PULSE_ENGINE_DLL_API NullGraphicsAPI : public IGraphicsAPI
+{
+public:
+    explicit NullGraphicsAPI(const NullGraphicsSettings& settings = NullGraphicsSettings()) : settings(settings) {}
+    ~NullGraphicsAPI() override = default;
+
+    bool InitializeApi(const char* title, int* width, int* height) override;
+    void ShutdownApi() override;
+
+    void PollEvents() const override {}
+    void SwapBuffers() const override;
+    bool ShouldClose() const override;
+
+    void DrawGridQuad(PulseEngine::Mat4 viewCam, const PulseEngine::Mat4& specificProjection, IGraphicsAPI* graphicsAPI) override;
+    void DrawLine(const PulseEngine::Vector3& start, const PulseEngine::Vector3& end, const PulseEngine::Color& color) override;
+
+    void SetWindowSize(int width, int height) const override;
+    void SetWindowTitle(const char* title) const override {}
+
+    void* GetNativeHandle() const override { return nullptr; }
+    std::string GetApiName() const override { return "Null"; }
+
+    unsigned int CreateShader(const std::string& vertexPath, const std::string& fragmentPath) override;
+    unsigned int CreateShader(const std::string& vertexPath, const std::string& fragmentPath, const std::string& geometryPath) override;
+    unsigned int CreateShader(const std::string& vertexPath, const std::string& fragmentPath, const std::vector<std::string>& defines) override;
+
+    void UseShader(unsigned int shaderID) const override;
+    void SetShaderMat4(const Shader* shader, const std::string& name, const PulseEngine::Mat4& mat) const override;
+    void SetShaderMat3(const Shader* shader, const std::string& name, const PulseEngine::Mat3& mat) const override;
+    void SetShaderVec3(const Shader* shader, const std::string& name, const PulseEngine::Vector3& vec) const override;
+    void SetShaderFloat(const Shader* shader, const std::string& name, float value) const override;
+    void SetShaderBool(const Shader* shader, const std::string& name, bool value) const override;
+    void SetShaderInt(const Shader* shader, const std::string& name, int value) const override;
+    void SetShaderIntArray(const Shader* shader, const std::string& name, const int* values, int count) const override;
+    void SetShaderVec3Array(const Shader* shader, const std::string& name, const std::vector<PulseEngine::Vector3>& vecArray) const override;
+    void SetShaderFloatArray(const Shader* shader, const std::string& name, const std::vector<float>& floatArray) const override;
+    void SetShaderMat4Array(const Shader* shader, const std::string& name, const std::vector<PulseEngine::Mat4>& array) const override;
+    void ActivateTexture(unsigned int textureID) const override;
+    void BindTexture(TextureType type, unsigned int textureID) const override;
+
+    void GenerateDepthCubeMap(unsigned int* FBO, unsigned int* depthCubeMap) const override;
+    bool IsFrameBufferComplete() const override { return true; }
+    void InitCubeMapFaceForRender(unsigned int* CubeMap, unsigned int faceIndex) const override;
+    void GenerateTextureMap(unsigned int* textureID, const std::string& filePath, bool hasFlip) const override;
+    void UploadTexture(unsigned int* textureID, const unsigned char* pixels, int width, int height, int channels) const override;
+    bool UploadCookedTexture(unsigned int* textureID, const PulseEngine::Cooking::CookedTexture& texture) const override;
+    void DeleteTexture(unsigned int textureID) const override;
+    void CreateTextureBuffer(unsigned int* buffer, unsigned int* textureID, TextureBufferFormat format) const override;
+    void UploadTextureBuffer(unsigned int buffer, const void* data, std::size_t size) const override;
+    void DeleteTextureBuffer(unsigned int buffer, unsigned int textureID) const override;
+    void GenerateShadowMap(unsigned int* shadowMap, unsigned int* FBO, int width, int height) const override;
+    void BindShadowFramebuffer(unsigned int* FBO, bool clear = true) const override;
+    void CopyShadowMap(unsigned int sourceTexture, unsigned int targetTexture, int size, bool cubeMap) const override;
+    void UnbindShadowFramebuffer() const override;
+
+    void SetupSimpleSquare(unsigned int* VAO, unsigned int* VBO, unsigned int* EBO) const override;
+
+    void DeleteMesh(unsigned int* VAO, unsigned int* VBO, unsigned int* EBO) const override;
+    void SetupMesh(unsigned int* VAO, unsigned int* VBO, unsigned int* EBO, const std::vector<Vertex>& vertices,
+                   const std::vector<SkinWeights>& skin, const std::vector<unsigned int>& indices) const override;
+    void RenderMesh(unsigned int* VAO, unsigned int* VBO, const std::vector<Vertex>& vertices, const std::vector<unsigned int>& indices) const override;
+    void RenderMeshRange(unsigned int* VAO, unsigned int indexOffset, unsigned int indexCount) const override;
+    void RenderMeshRangeInstanced(unsigned int* VAO, unsigned int indexOffset, unsigned int indexCount, unsigned int instanceCount) const override;
+
+    float GetTime() const override { return time; }
+
+    void StartFrame() const override;
+    void SpecificStartFrame(int specificVBO, const PulseEngine::Vector2& frameSize) const override;
+
+    void EndFrame(bool onlyUnbind) const override;
+    void ActivateBackCull() const override;
+
+    void GenerateFrameBuffer(unsigned int* previewFBO, unsigned int* previewTexture, unsigned int* rbo, unsigned int previewWidth, unsigned int previewHeight) override;
+    void RenderLineMesh(unsigned int* VAO, unsigned int* VBO, const std::vector<PulseEngine::Vector3>& vertices, const std::vector<unsigned int>& indices) override;
+    std::size_t DrawLineBatch(const LineVertex* vertices, std::size_t count) const override;
+    void ActivateWireframe() override;
+    void DesactivateWireframe() override;
+
+    void SetPipelineState(const PipelineState& state) const override;
+    /// @brief The redundant binds of the last frame : what the OpenGL backend would have skipped.
+    StateCacheCounters GetStateCacheCounters() const override;
+
+    ITextRenderer* CreateNewText() override;
+
+    /**
+     * @brief Text renderers of this backend report their glyphs here.
+     */
+    void RecordText(std::size_t glyphCount);
+
+    NullGraphicsSettings& GetSettings() { return settings; }
+
+    /// @brief The frame being recorded, since the last SwapBuffers.
+    const PulseEngine::Graphics::GraphicsCommandStream& GetCurrentCommands() const { return current; }
+    /// @brief Commands of the last frame swapped, empty when recordCommands is off.
+    const PulseEngine::Graphics::GraphicsCommandStream& GetLastFrameCommands() const { return lastFrame; }
+    const PulseEngine::Graphics::GraphicsCounters& GetLastFrameCounters() const { return lastFrameCounters; }
+    /// @brief Every frame swapped since InitializeApi.
+    const PulseEngine::Graphics::GraphicsCounters& GetTotalCounters() const { return totalCounters; }
+
+    /**
+     * @brief Counters back to zero, the handles, the bound state and the frame limit are kept (warm-up frames).
+     */
+    void ResetCounters();
+
+private:
+    void Record(PulseEngine::Graphics::GraphicsCommandType type, uint32_t a = 0, uint32_t b = 0, uint32_t c = 0) const;
+    void RecordUniform(const Shader* shader, const std::string& name, PulseEngine::Graphics::UniformKind kind, const void* data, std::size_t size) const;
+    void BindFramebuffer(unsigned int framebuffer) const;
+    unsigned int NewHandle() const { return nextHandle++; }
+
+    NullGraphicsSettings settings;
+
+    // the interface is const for the GL calls, the recording state changes under it
+    mutable PulseEngine::Graphics::GraphicsCommandStream current;
+    mutable PulseEngine::Graphics::GraphicsCommandStream lastFrame;
+    mutable PulseEngine::Graphics::GraphicsCounters counters;
+    mutable PulseEngine::Graphics::GraphicsCounters lastFrameCounters;
+    mutable PulseEngine::Graphics::GraphicsCounters totalCounters;
+
+    mutable unsigned int nextHandle = 1;
+    mutable unsigned int boundShader = 0;
+    mutable unsigned int boundFramebuffer = 0;
+    mutable unsigned int activeUnit = 0;
+    mutable std::vector<unsigned int> boundTextures;    ///< by texture unit
+    mutable PipelineState boundPipelineState;
+    mutable float time = 0.0f;
+    mutable std::uint64_t frameIndex = 0;      ///< frames swapped, ResetCounters keeps it
+};
+
+#endif // NULLGRAPHICSAPI_H
@@ -5,6 +5,7 @@
 #include <iostream>
 #include <fstream>
 #include <sstream>
+#include <algorithm>
 
 #define STB_IMAGE_IMPLEMENTATION
 #include "stb_image.h" 
@@ -13,9 +14,104 @@
 #include "PulseEngine/core/Math/Mat4.h"
 #include "PulseEngine/core/Math/Vector.h"
 
+#include "PulseEngine/core/Material/Cooking/CookedTexture.h"
+
 #include "Common/EditorDefines.h"
 #include "OpenGLApi.h"
 
+// S3TC is an extension, glad only loads the core enums
+#ifndef GL_COMPRESSED_RGB_S3TC_DXT1_EXT
+#define GL_COMPRESSED_RGB_S3TC_DXT1_EXT 0x83F0
+#endif
+#ifndef GL_COMPRESSED_RGBA_S3TC_DXT5_EXT
+#define GL_COMPRESSED_RGBA_S3TC_DXT5_EXT 0x83F3
+#endif
+#ifndef GL_COMPRESSED_RGBA_BPTC_UNORM
+#define GL_COMPRESSED_RGBA_BPTC_UNORM 0x8E8C
+#endif
+// glTexBufferRange is core since 4.3, glad only loads 3.3
+#ifndef GL_TEXTURE_BUFFER_OFFSET_ALIGNMENT
+#define GL_TEXTURE_BUFFER_OFFSET_ALIGNMENT 0x919F
+#endif
+
+namespace
+{
+    bool HasExtension(const char* extension)
+    {
+        GLint count = 0;
+        glGetIntegerv(GL_NUM_EXTENSIONS, &count);
+        for (GLint i = 0; i < count; ++i)
+        {
+            const char* name = reinterpret_cast<const char*>(glGetStringi(GL_EXTENSIONS, i));
+            if (name && std::string(name) == extension) return true;
+        }
+        return false;
+    }
+
+    bool HasS3TCSupport()
+    {
+        static const bool supported = HasExtension("GL_EXT_texture_compression_s3tc");
+        return supported;
+    }
+
+    // the context can be older than 4.2 : glad targets 3.3
+    bool HasBPTCSupport()
+    {
+        static const bool supported = []()
+        {
+            GLint major = 0, minor = 0;
+            glGetIntegerv(GL_MAJOR_VERSION, &major);
+            glGetIntegerv(GL_MINOR_VERSION, &minor);
+            return major > 4 || (major == 4 && minor >= 2) || HasExtension("GL_ARB_texture_compression_bptc");
+        }();
+        return supported;
+    }
+
+    typedef void (APIENTRYP TexBufferRangeProc)(GLenum target, GLenum internalFormat, GLuint buffer, GLintptr offset, GLsizeiptr size);
+    TexBufferRangeProc texBufferRange = nullptr;    ///< nullptr : the buffer textures keep their own storage
+
+    GLenum ToInternalFormat(TextureBufferFormat format)
+    {
+        if (format == TEXTURE_BUFFER_RG32UI) return GL_RG32UI;
+        if (format == TEXTURE_BUFFER_R32UI) return GL_R32UI;
+        return GL_RGBA32F;
+    }
+
+    // texture arrays are filled by copying the uploaded textures : glCopyImageSubData and glTexStorage3D are 4.3 and 4.2
+    typedef void (APIENTRYP CopyImageSubDataProc)(GLuint srcName, GLenum srcTarget, GLint srcLevel, GLint srcX, GLint srcY, GLint srcZ,
+                                                  GLuint dstName, GLenum dstTarget, GLint dstLevel, GLint dstX, GLint dstY, GLint dstZ,
+                                                  GLsizei width, GLsizei height, GLsizei depth);
+    typedef void (APIENTRYP TexStorage3DProc)(GLenum target, GLsizei levels, GLenum internalFormat, GLsizei width, GLsizei height, GLsizei depth);
+    CopyImageSubDataProc copyImageSubData = nullptr;
+    TexStorage3DProc texStorage3D = nullptr;
+
+    // glTexStorage3D only takes sized formats, an image uploaded as GL_RGB can report its unsized format
+    GLenum ToSizedFormat(GLint format)
+    {
+        switch (format)
+        {
+            case GL_RED: return GL_R8;
+            case GL_RG: return GL_RG8;
+            case GL_RGB: return GL_RGB8;
+            case GL_RGBA: return GL_RGBA8;
+            default: return static_cast<GLenum>(format);
+        }
+    }
+
+    std::string InjectDefines(const std::string& code, const std::vector<std::string>& defines)
+    {
+        // #version has to stay the first line
+        std::string header;
+        for (const std::string& define : defines) header += "#define " + define + "\n";
+
+        const std::size_t version = code.find("#version");
+        if (version == std::string::npos) return header + code;
+        const std::size_t lineEnd = code.find('\n', version);
+        if (lineEnd == std::string::npos) return code + "\n" + header;
+        return code.substr(0, lineEnd + 1) + header + code.substr(lineEnd + 1);
+    }
+}
+
 
 bool OpenGLAPI::InitializeApi(const char* title, int* width, int* height)
 {
@@ -48,21 +144,71 @@ bool OpenGLAPI::InitializeApi(const char* title, int* width, int* height)
         EDITOR_ERROR("Error while initializing GLAD.");
         return -1;
     }
-    glEnable(GL_DEPTH_TEST);
+    glfwSetWindowUserPointer(window, this);
+
+    // a new context : nothing is known, every state is sent once
+    InvalidateStateCache();
+    SetPipelineState(PipelineState());
+
+    transientRing.Initialize(TRANSIENT_FRAME_SIZE, 3, TRANSIENT_FRAME_MAX_SIZE);
+    if (GLVersion.major > 4 || (GLVersion.major == 4 && GLVersion.minor >= 3))
+    {
+        texBufferRange = reinterpret_cast<TexBufferRangeProc>(glfwGetProcAddress("glTexBufferRange"));
+        glGetIntegerv(GL_TEXTURE_BUFFER_OFFSET_ALIGNMENT, &textureBufferAlignment);
+
+        copyImageSubData = reinterpret_cast<CopyImageSubDataProc>(glfwGetProcAddress("glCopyImageSubData"));
+        texStorage3D = reinterpret_cast<TexStorage3DProc>(glfwGetProcAddress("glTexStorage3D"));
+    }
+    if (copyImageSubData && texStorage3D)
+    {
+        textureArrays.Initialize(TEXTURE_ARRAY_BUDGET, TEXTURE_ARRAY_MAX_LAYERS,
+            [this](const PulseEngine::Graphics::TextureArrayFormat& format, int layers) -> unsigned int
+            {
+                GLuint array = 0;
+                glGenTextures(1, &array);
+                BindTextureTarget(TEXTURE_2D_ARRAY, array);
+                texStorage3D(GL_TEXTURE_2D_ARRAY, format.levels, format.internalFormat, format.width, format.height, layers);
+                // the sampling of UploadTexture and UploadCookedTexture
+                glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_S, GL_REPEAT);
+                glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_T, GL_REPEAT);
+                glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, format.levels > 1 ? GL_LINEAR_MIPMAP_LINEAR : GL_LINEAR);
+                glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+                return array;
+            },
+            [](unsigned int texture, const PulseEngine::Graphics::TextureArrayFormat& format, unsigned int array, int layer)
+            {
+                // GPU to GPU, the pixels don't come back to the CPU
+                for (int level = 0; level < format.levels; ++level)
+                {
+                    const GLsizei width = std::max(format.width >> level, 1);
+                    const GLsizei height = std::max(format.height >> level, 1);
+                    copyImageSubData(texture, GL_TEXTURE_2D, level, 0, 0, 0, array, GL_TEXTURE_2D_ARRAY, level, 0, 0, layer, width, height, 1);
+                }
+            },
+            [this](unsigned int array)
+            {
+                ForgetTexture(array);
+                glDeleteTextures(1, &array);
+            });
+    }
+    else
+    {
+        EDITOR_WARN("No glCopyImageSubData : materials are bound per draw, not batched")
+    }
 
     glfwMakeContextCurrent(window);
     glEnable(GL_MULTISAMPLE);
 
         // Create texture to render to
     glGenTextures(1, &fboTexture);
-    glBindTexture(GL_TEXTURE_2D, fboTexture);
+    BindTextureTarget(TEXTURE_2D, fboTexture);
     glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, fboWidth, fboHeight, 0, GL_RGBA, GL_UNSIGNED_BYTE, NULL);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
 
     // Create framebuffer
     glGenFramebuffers(1, &fbo);
-    glBindFramebuffer(GL_FRAMEBUFFER, fbo);
+    BindFramebuffer(fbo);
     glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, fboTexture, 0);
 
     // Create Renderbuffer for depth and stencil
@@ -76,7 +222,7 @@ bool OpenGLAPI::InitializeApi(const char* title, int* width, int* height)
     {
         EDITOR_ERROR("ERROR::FRAMEBUFFER:: Framebuffer is not complete!");
     }
-    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    BindFramebuffer(0);
     EDITOR_INFO("OpenGL API initialized successfully.")
     EDITOR_INFO("OpenGL Version: " << glGetString(GL_VERSION))
     return true;
@@ -84,6 +230,12 @@ bool OpenGLAPI::InitializeApi(const char* title, int* width, int* height)
 
 void OpenGLAPI::ShutdownApi()
 {
+    if (lineVertexArray) glDeleteVertexArrays(1, &lineVertexArray);
+    if (lineBatchVertexArray) glDeleteVertexArrays(1, &lineBatchVertexArray);
+    lineVertexArray = 0;
+    lineBatchVertexArray = 0;
+    transientRing.Shutdown();
+    textureArrays.Shutdown();
     if (window)
     {
         glfwDestroyWindow(window);
@@ -94,8 +246,7 @@ void OpenGLAPI::ShutdownApi()
 
 void OpenGLAPI::UseShader(unsigned int shaderID) const
 {
-    
-    glUseProgram(shaderID);
+    BindProgram(shaderID);
 }
 
 void OpenGLAPI::SetShaderMat4(const Shader* shader, const std::string &name, const PulseEngine::Mat4 &mat) const
@@ -198,23 +349,12 @@ void OpenGLAPI::SetShaderMat4Array(const Shader* shader, const std::string& name
 
 void OpenGLAPI::ActivateTexture(unsigned int textureID) const
 {
-    glActiveTexture(GL_TEXTURE0 + textureID);
-    
+    SetActiveUnit(textureID);
 }
 
 void OpenGLAPI::BindTexture(TextureType type, unsigned int textureID) const
 {
-    switch (type)
-    {
-        case TEXTURE_2D:
-            glBindTexture(GL_TEXTURE_2D, textureID);
-            break;
-        case TEXTURE_CUBE_MAP:
-            glBindTexture(GL_TEXTURE_CUBE_MAP, textureID);
-        default:
-            EDITOR_ERROR("Unknown texture type.");
-            break;
-    }
+    BindTextureTarget(type, textureID);
 }
 
 void OpenGLAPI::GenerateDepthCubeMap(unsigned int *FBO, unsigned int *depthCubeMap) const
@@ -222,7 +362,7 @@ void OpenGLAPI::GenerateDepthCubeMap(unsigned int *FBO, unsigned int *depthCubeM
     glGenFramebuffers(1, FBO);
 
     glGenTextures(1, depthCubeMap);
-    glBindTexture(GL_TEXTURE_CUBE_MAP, *depthCubeMap);
+    BindTextureTarget(TEXTURE_CUBE_MAP, *depthCubeMap);
     for (unsigned int i = 0; i < 6; ++i)
     {
         glTexImage2D(GL_TEXTURE_CUBE_MAP_POSITIVE_X + i, 0, GL_DEPTH_COMPONENT24,
@@ -234,7 +374,7 @@ void OpenGLAPI::GenerateDepthCubeMap(unsigned int *FBO, unsigned int *depthCubeM
     glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
     glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_R, GL_CLAMP_TO_EDGE);
 
-    glBindFramebuffer(GL_FRAMEBUFFER, *FBO);
+    BindFramebuffer(*FBO);
     glFramebufferTexture(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, *depthCubeMap, 0);
     glDrawBuffer(GL_NONE);
     glReadBuffer(GL_NONE);
@@ -242,7 +382,7 @@ void OpenGLAPI::GenerateDepthCubeMap(unsigned int *FBO, unsigned int *depthCubeM
     {
         std::cerr << "PointLight: Initial framebuffer is not complete!" << std::endl;
     }
-    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    BindFramebuffer(0);
 }
 
 bool OpenGLAPI::IsFrameBufferComplete() const
@@ -257,9 +397,37 @@ void OpenGLAPI::InitCubeMapFaceForRender(unsigned int *CubeMap, unsigned int fac
 }
 
 void OpenGLAPI::GenerateTextureMap(unsigned int *textureID, const std::string &filePath, bool hasFlip) const
+{
+    // cooked by the game build : the levels are uploaded as they are
+    PulseEngine::Cooking::CookedTexture cooked;
+    if (PulseEngine::Cooking::LoadCookedTexture(PulseEngine::Cooking::GetCookedTexturePath(filePath), cooked)
+        && (cooked.IsFlipped() == hasFlip || PulseEngine::Cooking::FlipCookedTexture(cooked))
+        && UploadCookedTexture(textureID, cooked))
+    {
+        return;
+    }
+
+    int width, height, nrChannels;
+    stbi_set_flip_vertically_on_load_thread(hasFlip);
+    unsigned char* data = stbi_load((filePath).c_str(), &width, &height, &nrChannels, 0);
+
+    if (data)
+    {
+        UploadTexture(textureID, data, width, height, nrChannels);
+    }
+    else
+    {
+        EDITOR_ERROR("Failed to load texture: " + (filePath));
+        UploadTexture(textureID, nullptr, 0, 0, 3);
+    }
+
+    stbi_image_free(data);
+}
+
+void OpenGLAPI::UploadTexture(unsigned int *textureID, const unsigned char *pixels, int width, int height, int channels) const
 {
     glGenTextures(1, textureID);
-    glBindTexture(GL_TEXTURE_2D, *textureID);
+    BindTextureTarget(TEXTURE_2D, *textureID);
 
     // Paramètres de texture
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);  
@@ -267,26 +435,150 @@ void OpenGLAPI::GenerateTextureMap(unsigned int *textureID, const std::string &f
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
 
-    int width, height, nrChannels;
-    stbi_set_flip_vertically_on_load(hasFlip);
-    unsigned char* data = stbi_load((filePath).c_str(), &width, &height, &nrChannels, 0);
+    if (!pixels) return;
 
-    if (data)
+    GLenum format = GL_RGB;
+    if (channels == 1) format = GL_RED;
+    else if (channels == 2) format = GL_RG;
+    else if (channels == 3) format = GL_RGB;
+    else if (channels == 4) format = GL_RGBA;
+
+    // stb rows are tightly packed, a RGB row is not always a multiple of 4 bytes
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    glTexImage2D(GL_TEXTURE_2D, 0, format, width, height, 0, format, GL_UNSIGNED_BYTE, pixels);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+    glGenerateMipmap(GL_TEXTURE_2D);
+}
+
+bool OpenGLAPI::UploadCookedTexture(unsigned int *textureID, const PulseEngine::Cooking::CookedTexture &texture) const
+{
+    using PulseEngine::Cooking::CookedTextureFormat;
+
+    GLenum internalFormat = GL_RGBA8;
+    switch (texture.format)
     {
-        GLenum format = GL_RGB;
-        if (nrChannels == 1) format = GL_RED;
-        else if (nrChannels == 3) format = GL_RGB;
-        else if (nrChannels == 4) format = GL_RGBA;
+        case CookedTextureFormat::RGBA8: internalFormat = GL_RGBA8; break;
+        case CookedTextureFormat::BC1: internalFormat = GL_COMPRESSED_RGB_S3TC_DXT1_EXT; break;
+        case CookedTextureFormat::BC3: internalFormat = GL_COMPRESSED_RGBA_S3TC_DXT5_EXT; break;
+        case CookedTextureFormat::BC5: internalFormat = GL_COMPRESSED_RG_RGTC2; break;     // core since 3.0
+        case CookedTextureFormat::BC7: internalFormat = GL_COMPRESSED_RGBA_BPTC_UNORM; break; // core since 4.2
+    }
+    if ((texture.format == CookedTextureFormat::BC1 || texture.format == CookedTextureFormat::BC3) && !HasS3TCSupport())
+        return false;
+    if (texture.format == CookedTextureFormat::BC7 && !HasBPTCSupport())
+        return false;
+
+    // an error left by an earlier call must not fail this upload
+    while (glGetError() != GL_NO_ERROR) {}
+
+    glGenTextures(1, textureID);
+    BindTextureTarget(TEXTURE_2D, *textureID);
+
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, texture.mips.size() > 1 ? GL_LINEAR_MIPMAP_LINEAR : GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_BASE_LEVEL, 0);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, (GLint)texture.mips.size() - 1);
 
-        glTexImage2D(GL_TEXTURE_2D, 0, format, width, height, 0, format, GL_UNSIGNED_BYTE, data);
-        glGenerateMipmap(GL_TEXTURE_2D);
+    for (std::size_t level = 0; level < texture.mips.size(); ++level)
+    {
+        const PulseEngine::Cooking::CookedMipEntry& mip = texture.mips[level];
+        if (PulseEngine::Cooking::IsBlockCompressed(texture.format))
+        {
+            glCompressedTexImage2D(GL_TEXTURE_2D, (GLint)level, internalFormat, (GLsizei)mip.width, (GLsizei)mip.height, 0,
+                                   (GLsizei)mip.size, texture.GetMipData(level));
+        }
+        else
+        {
+            glTexImage2D(GL_TEXTURE_2D, (GLint)level, GL_RGBA8, (GLsizei)mip.width, (GLsizei)mip.height, 0,
+                         GL_RGBA, GL_UNSIGNED_BYTE, texture.GetMipData(level));
+        }
     }
-    else
+
+    // rejected by the driver (format or size) : the caller loads the source image instead
+    if (glGetError() != GL_NO_ERROR)
     {
-        EDITOR_ERROR("Failed to load texture: " + (filePath));
+        while (glGetError() != GL_NO_ERROR) {}
+        ForgetTexture(*textureID);
+        glDeleteTextures(1, textureID);
+        *textureID = 0;
+        return false;
     }
+    return true;
+}
 
-    stbi_image_free(data);
+void OpenGLAPI::DeleteTexture(unsigned int textureID) const
+{
+    if (!textureID) return;
+    // its id can be given to the next texture created : it must not find this layer
+    textureArrays.Release(textureID);
+    ForgetTexture(textureID);
+    glDeleteTextures(1, &textureID);
+}
+
+void OpenGLAPI::CreateTextureBuffer(unsigned int *buffer, unsigned int *textureID, TextureBufferFormat format) const
+{
+    const GLenum internalFormat = ToInternalFormat(format);
+
+    // glTexBuffer needs a data store, the real size comes with the first upload
+    glGenBuffers(1, buffer);
+    glBindBuffer(GL_TEXTURE_BUFFER, *buffer);
+    glBufferData(GL_TEXTURE_BUFFER, 16, nullptr, GL_STREAM_DRAW);
+
+    glGenTextures(1, textureID);
+    BindTextureTarget(TEXTURE_BUFFER, *textureID);
+    glTexBuffer(GL_TEXTURE_BUFFER, internalFormat, *buffer);
+
+    BindTextureTarget(TEXTURE_BUFFER, 0);
+    glBindBuffer(GL_TEXTURE_BUFFER, 0);
+
+    TextureBufferView& view = textureBuffers[*buffer];
+    view.texture = *textureID;
+    view.format = internalFormat;
+}
+
+void OpenGLAPI::UploadTextureBuffer(unsigned int buffer, const void *data, std::size_t size) const
+{
+    if (!buffer || size == 0) return;
+
+    // rewritten every frame : a range of the transient ring, the buffer texture is pointed at it
+    auto view = textureBuffers.find(buffer);
+    if (view != textureBuffers.end() && texBufferRange)
+    {
+        const std::size_t offset = transientRing.Write(data, size, static_cast<std::size_t>(textureBufferAlignment));
+        if (offset == GLTransientRing::INVALID_OFFSET)
+        {
+            // counted in the ring overflow, the next frames get larger parts
+            if (!ringOverflowReported)
+            {
+                ringOverflowReported = true;
+                EDITOR_WARN("Transient ring : a texture buffer of " << size / 1024 << " KB did not fit, not updated this frame")
+            }
+            return;
+        }
+        BindTextureTarget(TEXTURE_BUFFER, view->second.texture);
+        texBufferRange(GL_TEXTURE_BUFFER, view->second.format, transientRing.GetBuffer(),
+                       static_cast<GLintptr>(offset), static_cast<GLsizeiptr>(size));
+        return;
+    }
+
+    // no glTexBufferRange (before GL 4.3) : the buffer's own storage
+    glBindBuffer(GL_TEXTURE_BUFFER, buffer);
+    glBufferData(GL_TEXTURE_BUFFER, static_cast<GLsizeiptr>(size), nullptr, GL_STREAM_DRAW);
+    glBufferSubData(GL_TEXTURE_BUFFER, 0, static_cast<GLsizeiptr>(size), data);
+    glBindBuffer(GL_TEXTURE_BUFFER, 0);
+}
+
+void OpenGLAPI::DeleteTextureBuffer(unsigned int buffer, unsigned int textureID) const
+{
+    textureBuffers.erase(buffer);
+    if (textureID)
+    {
+        ForgetTexture(textureID);
+        glDeleteTextures(1, &textureID);
+    }
+    if (buffer) glDeleteBuffers(1, &buffer);
 }
 
 void OpenGLAPI::GenerateShadowMap(unsigned int *shadowMap, unsigned int *FBO, int width, int height) const
@@ -294,7 +586,7 @@ void OpenGLAPI::GenerateShadowMap(unsigned int *shadowMap, unsigned int *FBO, in
     glGenFramebuffers(1, FBO);
 
     glGenTextures(1, shadowMap);
-    glBindTexture(GL_TEXTURE_2D, *shadowMap);
+    BindTextureTarget(TEXTURE_2D, *shadowMap);
     glTexImage2D(GL_TEXTURE_2D, 0, GL_DEPTH_COMPONENT, width, height, 0, GL_DEPTH_COMPONENT, GL_FLOAT, nullptr);
 
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
@@ -302,7 +594,7 @@ void OpenGLAPI::GenerateShadowMap(unsigned int *shadowMap, unsigned int *FBO, in
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT); 
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT); 
 
-    glBindFramebuffer(GL_FRAMEBUFFER, *FBO);
+    BindFramebuffer(*FBO);
     glFramebufferTexture2D(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_TEXTURE_2D, *shadowMap, 0);
 
     if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE)
@@ -312,21 +604,49 @@ void OpenGLAPI::GenerateShadowMap(unsigned int *shadowMap, unsigned int *FBO, in
 
     glDrawBuffer(GL_NONE);
     glReadBuffer(GL_NONE);
-    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    BindFramebuffer(0);
+}
+
+void OpenGLAPI::BindShadowFramebuffer(unsigned int *FBO, bool clear) const
+{
+    BindFramebuffer(*FBO);
+    SetViewport(0, 0, 2048, 2048);
+    if (clear) glClear(GL_DEPTH_BUFFER_BIT);
+    SetCullFace(GL_FRONT);
 }
 
-void OpenGLAPI::BindShadowFramebuffer(unsigned int *FBO) const
+void OpenGLAPI::CopyShadowMap(unsigned int sourceTexture, unsigned int targetTexture, int size, bool cubeMap) const
 {
-    glBindFramebuffer(GL_FRAMEBUFFER, *FBO);
-    glViewport(0, 0, 2048, 2048);
-    glClear(GL_DEPTH_BUFFER_BIT);
-     glCullFace(GL_FRONT); 
+    if (!copyFramebuffers[0])
+    {
+        glGenFramebuffers(2, copyFramebuffers);
+        glBindFramebuffer(GL_READ_FRAMEBUFFER, copyFramebuffers[0]);
+        glReadBuffer(GL_NONE);
+        glBindFramebuffer(GL_DRAW_FRAMEBUFFER, copyFramebuffers[1]);
+        glDrawBuffer(GL_NONE);
+    }
+
+    // a blit only reads the first layer of a layered attachment : one face at a time
+    const int faces = cubeMap ? 6 : 1;
+    for (int face = 0; face < faces; ++face)
+    {
+        const GLenum target = cubeMap ? GL_TEXTURE_CUBE_MAP_POSITIVE_X + face : GL_TEXTURE_2D;
+        glBindFramebuffer(GL_READ_FRAMEBUFFER, copyFramebuffers[0]);
+        glFramebufferTexture2D(GL_READ_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, target, sourceTexture, 0);
+        glBindFramebuffer(GL_DRAW_FRAMEBUFFER, copyFramebuffers[1]);
+        glFramebufferTexture2D(GL_DRAW_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, target, targetTexture, 0);
+        glBlitFramebuffer(0, 0, size, size, 0, 0, size, size, GL_DEPTH_BUFFER_BIT, GL_NEAREST);
+    }
+
+    // read and draw framebuffers were bound apart, the cached one is neither
+    stateCache.framebuffer = UNKNOWN_BINDING;
+    BindFramebuffer(0);
 }
 
 void OpenGLAPI::UnbindShadowFramebuffer() const
 {
-     glCullFace(GL_BACK); 
-    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    SetCullFace(GL_BACK);
+    BindFramebuffer(0);
 }
 
 void OpenGLAPI::SetupSimpleSquare(unsigned int* VAO, unsigned int* VBO , unsigned int* EBO) const
@@ -347,7 +667,7 @@ void OpenGLAPI::SetupSimpleSquare(unsigned int* VAO, unsigned int* VBO , unsigne
     glGenBuffers(1, VBO);
     glGenBuffers(1, EBO);
 
-    glBindVertexArray(*VAO);
+    BindVertexArray(*VAO);
 
     glBindBuffer(GL_ARRAY_BUFFER, *VBO);
     glBufferData(GL_ARRAY_BUFFER, sizeof(vertices), vertices, GL_STATIC_DRAW);
@@ -362,27 +682,33 @@ void OpenGLAPI::SetupSimpleSquare(unsigned int* VAO, unsigned int* VBO , unsigne
     glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, 5 * sizeof(float), (void*)(3 * sizeof(float)));
     glEnableVertexAttribArray(1);
 
-    glBindVertexArray(0);
+    BindVertexArray(0);
 }
 
 void OpenGLAPI::DeleteMesh(unsigned int* VAO, unsigned int* VBO, unsigned int* EBO) const
 {
+    if (stateCache.vertexArray == *VAO) stateCache.vertexArray = 0;
     glDeleteVertexArrays(1, VAO);
     glDeleteBuffers(1, VBO);
     glDeleteBuffers(1, EBO);
 }
 
-void OpenGLAPI::SetupMesh(unsigned int *VAO, unsigned int *VBO, unsigned int* EBO, const std::vector<Vertex> &vertices, const std::vector<unsigned int> &indices) const
+void OpenGLAPI::SetupMesh(unsigned int *VAO, unsigned int *VBO, unsigned int* EBO, const std::vector<Vertex> &vertices,
+                          const std::vector<SkinWeights> &skin, const std::vector<unsigned int> &indices) const
 {
     glGenVertexArrays(1, VAO);
     glGenBuffers(1, VBO);
     glGenBuffers(1, EBO);
 
-    glBindVertexArray(*VAO);
+    BindVertexArray(*VAO);
 
-    // Envoie des données des sommets
+    // Envoie des données des sommets, puis des bones (maillages animés seulement) dans le même buffer
+    const std::size_t vertexBytes = vertices.size() * sizeof(Vertex);
+    const std::size_t skinBytes = skin.size() * sizeof(SkinWeights);
     glBindBuffer(GL_ARRAY_BUFFER, *VBO);
-    glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(Vertex), vertices.data(), GL_STATIC_DRAW);
+    glBufferData(GL_ARRAY_BUFFER, vertexBytes + skinBytes, nullptr, GL_STATIC_DRAW);
+    glBufferSubData(GL_ARRAY_BUFFER, 0, vertexBytes, vertices.data());
+    if (skinBytes) glBufferSubData(GL_ARRAY_BUFFER, vertexBytes, skinBytes, skin.data());
 
     // Envoie des indices
     glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, *EBO);
@@ -396,29 +722,32 @@ void OpenGLAPI::SetupMesh(unsigned int *VAO, unsigned int *VBO, unsigned int* EB
     glEnableVertexAttribArray(1);
     glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, Normal));
 
-    // Attribut 2 : BoneIDs (ivec4) → glVertexAttribIPointer !
-    glEnableVertexAttribArray(2);
-    glVertexAttribIPointer(2, 4, GL_INT, sizeof(Vertex), (void*)offsetof(Vertex, BoneIDs));
-
-    glEnableVertexAttribArray(3);
-    glVertexAttribPointer(3, 4, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, Tangent));
+    // Attribut 3 : Tangent (vec3), 6 : Bitangent (vec3)
     glEnableVertexAttribArray(3);
+    glVertexAttribPointer(3, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, Tangent));
+    glEnableVertexAttribArray(6);
     glVertexAttribPointer(6, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, Bitangent));
 
-    // Attribut 3 : Weights (vec4)
-    glEnableVertexAttribArray(5);
-    glVertexAttribPointer(5, 4, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, Weights));
-
     // Attribut 4 : TexCoords (vec2)
     glEnableVertexAttribArray(4);
     glVertexAttribPointer(4, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, TexCoords));
 
-    glBindVertexArray(0);
+    // Attribut 2 : BoneIDs (ivec4) → glVertexAttribIPointer !, 5 : Weights (vec4)
+    // static mesh : left disabled, the shaders only read them when hasSkeleton
+    if (skinBytes)
+    {
+        glEnableVertexAttribArray(2);
+        glVertexAttribIPointer(2, 4, GL_INT, sizeof(SkinWeights), (void*)(vertexBytes + offsetof(SkinWeights, BoneIDs)));
+        glEnableVertexAttribArray(5);
+        glVertexAttribPointer(5, 4, GL_FLOAT, GL_FALSE, sizeof(SkinWeights), (void*)(vertexBytes + offsetof(SkinWeights, Weights)));
+    }
+
+    BindVertexArray(0);
 }
 
 void OpenGLAPI::RenderMesh(unsigned int *VAO, unsigned int *VBO, const std::vector<Vertex> &vertices, const std::vector<unsigned int> &indices) const
 {
-     glBindVertexArray(*VAO);
+    BindVertexArray(*VAO);
     if (!indices.empty())
     {
         glDrawElements(GL_TRIANGLES, static_cast<GLsizei>(indices.size()), GL_UNSIGNED_INT, 0);
@@ -427,8 +756,64 @@ void OpenGLAPI::RenderMesh(unsigned int *VAO, unsigned int *VBO, const std::vect
     {
         glDrawArrays(GL_TRIANGLES, 0, static_cast<GLsizei>(vertices.size()));
     }
+}
 
-    glBindVertexArray(0);
+void OpenGLAPI::RenderMeshRange(unsigned int *VAO, unsigned int indexOffset, unsigned int indexCount) const
+{
+    BindVertexArray(*VAO);
+    glDrawElements(GL_TRIANGLES, static_cast<GLsizei>(indexCount), GL_UNSIGNED_INT, (void*)(static_cast<std::size_t>(indexOffset) * sizeof(unsigned int)));
+}
+
+void OpenGLAPI::RenderMeshRangeInstanced(unsigned int *VAO, unsigned int indexOffset, unsigned int indexCount, unsigned int instanceCount) const
+{
+    if (instanceCount == 0) return;
+    BindVertexArray(*VAO);
+    glDrawElementsInstanced(GL_TRIANGLES, static_cast<GLsizei>(indexCount), GL_UNSIGNED_INT,
+                            (void*)(static_cast<std::size_t>(indexOffset) * sizeof(unsigned int)), static_cast<GLsizei>(instanceCount));
+}
+
+TextureArraySlot OpenGLAPI::GetTextureArraySlot(unsigned int textureID) const
+{
+    if (!textureID || !textureArrays.IsInitialized()) return TextureArraySlot();
+
+    const TextureArraySlot slot = textureArrays.Find(textureID);
+    if (slot.IsValid()) return slot;
+
+    const PulseEngine::Graphics::TextureArrayFormat format = ReadTextureArrayFormat(textureID);
+    if (format.width <= 0 || format.height <= 0) return TextureArraySlot();
+    return textureArrays.Pack(textureID, format);
+}
+
+PulseEngine::Graphics::TextureArrayFormat OpenGLAPI::ReadTextureArrayFormat(GLuint texture) const
+{
+    PulseEngine::Graphics::TextureArrayFormat format;
+    BindTextureTarget(TEXTURE_2D, texture);
+
+    GLint internalFormat = 0;
+    GLint compressed = GL_FALSE;
+    glGetTexLevelParameteriv(GL_TEXTURE_2D, 0, GL_TEXTURE_WIDTH, &format.width);
+    glGetTexLevelParameteriv(GL_TEXTURE_2D, 0, GL_TEXTURE_HEIGHT, &format.height);
+    glGetTexLevelParameteriv(GL_TEXTURE_2D, 0, GL_TEXTURE_INTERNAL_FORMAT, &internalFormat);
+    glGetTexLevelParameteriv(GL_TEXTURE_2D, 0, GL_TEXTURE_COMPRESSED, &compressed);
+    format.internalFormat = ToSizedFormat(internalFormat);
+
+    // glGenerateMipmap goes down to 1x1, a cooked texture stops at its last mip
+    format.levels = 1;
+    format.layerBytes = 0;
+    for (GLint level = 0; level < 16; ++level)
+    {
+        GLint width = 0;
+        glGetTexLevelParameteriv(GL_TEXTURE_2D, level, GL_TEXTURE_WIDTH, &width);
+        if (width <= 0) break;
+        format.levels = level + 1;
+
+        GLint height = 0;
+        glGetTexLevelParameteriv(GL_TEXTURE_2D, level, GL_TEXTURE_HEIGHT, &height);
+        GLint bytes = width * height * 4;
+        if (compressed) glGetTexLevelParameteriv(GL_TEXTURE_2D, level, GL_TEXTURE_COMPRESSED_IMAGE_SIZE, &bytes);
+        format.layerBytes += static_cast<std::size_t>(bytes);
+    }
+    return format;
 }
 
 float OpenGLAPI::GetTime() const
@@ -438,7 +823,10 @@ float OpenGLAPI::GetTime() const
 
 void OpenGLAPI::FramebufferSizeCallback(GLFWwindow *window, int width, int height)
 {
-    glViewport(0, 0, width, height);
+    if (const OpenGLAPI* api = static_cast<const OpenGLAPI*>(glfwGetWindowUserPointer(window)))
+        api->SetViewport(0, 0, width, height);
+    else
+        glViewport(0, 0, width, height);
 }
 
 // void OpenGLAPI::PollEvents() const
@@ -451,7 +839,39 @@ void OpenGLAPI::FramebufferSizeCallback(GLFWwindow *window, int width, int heigh
 
 void OpenGLAPI::SwapBuffers() const
 {
+    // the fence follows the last draw reading the frame part
+    transientRing.EndFrame();
     glfwSwapBuffers(window);
+    transientRing.BeginFrame();
+
+    const PulseEngine::Graphics::TransientRingStats& ring = transientRing.GetAllocator().GetLastFrameStats();
+    PROFILE_COUNTER("Transient ring", {
+        {"allocations", (double)ring.allocations},
+        {"usedKB", (double)ring.allocatedBytes / 1024.0},
+        {"failedAllocations", (double)ring.failedAllocations},
+        {"overflowKB", (double)ring.overflowBytes / 1024.0},
+        {"spilledParts", (double)ring.spilledParts},
+        {"fenceWaits", (double)ring.fenceWaits},
+        {"frameKB", (double)transientRing.GetAllocator().GetPartitionSize() / 1024.0}
+    });
+
+    const PulseEngine::Graphics::TextureArrayStats& arrays = textureArrays.GetStats();
+    PROFILE_COUNTER("Texture arrays", {
+        {"arrays", (double)arrays.arrays},
+        {"packedTextures", (double)arrays.packedTextures},
+        {"layers", (double)arrays.layers},
+        {"MB", (double)arrays.bytes / (1024.0 * 1024.0)}
+    });
+
+    PROFILE_COUNTER("GL state cache", {
+        {"requested", (double)counters.requested},
+        {"skipped", (double)counters.skipped},
+        {"skippedPrograms", (double)counters.skippedPrograms},
+        {"skippedTextures", (double)counters.skippedTextures},
+        {"skippedVertexArrays", (double)counters.skippedVertexArrays}
+    });
+    lastFrameCounters = counters;
+    counters = StateCacheCounters();
 }
 
 bool OpenGLAPI::ShouldClose() const
@@ -479,7 +899,7 @@ void OpenGLAPI::DrawGridQuad(PulseEngine::Mat4 viewCam,const PulseEngine::Mat4&
     //     };
     //     glGenVertexArrays(1, &quadVAO);
     //     glGenBuffers(1, &quadVBO);
-    //     glBindVertexArray(quadVAO);
+    //     BindVertexArray(quadVAO);
     //     glBindBuffer(GL_ARRAY_BUFFER, quadVBO);
     //     glBufferData(GL_ARRAY_BUFFER, sizeof(quadVertices), quadVertices, GL_STATIC_DRAW);
     //     glEnableVertexAttribArray(0);
@@ -507,41 +927,35 @@ void OpenGLAPI::DrawGridQuad(PulseEngine::Mat4 viewCam,const PulseEngine::Mat4&
     // glEnable(GL_DEPTH_TEST);     
     // glDepthMask(GL_FALSE);       
 
-    // glBindVertexArray(quadVAO);
+    // BindVertexArray(quadVAO);
     // glDrawArrays(GL_TRIANGLE_FAN, 0, 4);
-    // glBindVertexArray(0);
+    // BindVertexArray(0);
 
     // glDepthMask(GL_TRUE);       
     // glDisable(GL_BLEND);
 }
 
 void OpenGLAPI::DrawLine(const PulseEngine::Vector3 &start, const PulseEngine::Vector3 &end, const PulseEngine::Color &color)
-{   
-    // GPU buffer for the two endpoints
-    static GLuint vao, vbo;
-    glGenVertexArrays(1, &vao);
-    glGenBuffers(1, &vbo);
-
+{
+    // the two endpoints go to the transient ring, the line is drawn from there
     const glm::vec3 vertices[2] = { glm::vec3(start.x, start.y, start.z), glm::vec3(end.x, end.y, end.z)};
+    const std::size_t offset = transientRing.Write(vertices, sizeof(vertices), sizeof(glm::vec3));
+    if (offset == GLTransientRing::INVALID_OFFSET) return;
 
-    glBindVertexArray(vao);
-    glBindBuffer(GL_ARRAY_BUFFER, vbo);
-    glBufferData(GL_ARRAY_BUFFER, sizeof(vertices), vertices, GL_STATIC_DRAW);
-
-    glEnableVertexAttribArray(0);
-    glVertexAttribPointer(
-        0,                    // attribute location
-        3,                    // vec3
-        GL_FLOAT,
-        GL_FALSE,
-        sizeof(glm::vec3),
-        (void*)0
-    );
-    glDrawArrays(GL_LINES, 0, 2);
+    // set again when the ring buffer grew
+    if (!lineVertexArray || lineRingGeneration != transientRing.GetGeneration())
+    {
+        if (!lineVertexArray) glGenVertexArrays(1, &lineVertexArray);
+        BindVertexArray(lineVertexArray);
+        glBindBuffer(GL_ARRAY_BUFFER, transientRing.GetBuffer());
+        glEnableVertexAttribArray(0);
+        glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(glm::vec3), (void*)0);
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+        lineRingGeneration = transientRing.GetGeneration();
+    }
 
-    glDisableVertexAttribArray(0);
-    glBindBuffer(GL_ARRAY_BUFFER, 0);
-    glBindVertexArray(0);
+    BindVertexArray(lineVertexArray);
+    glDrawArrays(GL_LINES, static_cast<GLint>(offset / sizeof(glm::vec3)), 2);
 }
 
 void OpenGLAPI::SetWindowSize(int width, int height) const
@@ -568,8 +982,8 @@ void OpenGLAPI::StartFrame() const
 {
 
         glfwGetFramebufferSize(window, width, height);
-        glBindFramebuffer(GL_FRAMEBUFFER, 0);
-        glViewport(0, 0, *width, *height);
+        BindFramebuffer(0);
+        SetViewport(0, 0, *width, *height);
         glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
         glClearColor(0.52f, 0.8f, 0.92f, 1.0f);
     
@@ -577,19 +991,19 @@ void OpenGLAPI::StartFrame() const
 
 void OpenGLAPI::SpecificStartFrame(int specificVBO, const PulseEngine::Vector2& frameSize) const
 {        
-    glBindFramebuffer(GL_FRAMEBUFFER, specificVBO);
-    glViewport(0, 0, frameSize.x, frameSize.y);
+    BindFramebuffer(specificVBO);
+    SetViewport(0, 0, frameSize.x, frameSize.y);
     glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
     glClearColor(0.52f, 0.8f, 0.92f, 1.0f);
 }
 
 void OpenGLAPI::EndFrame(bool onlyUnbind) const
 {
-        glBindFramebuffer(GL_FRAMEBUFFER, 0);
+        BindFramebuffer(0);
     EDITOR_ONLY( // Go back to default framebuffer
         if(!onlyUnbind)
         {
-            glViewport(0, 0, 1920, 1080); // Reset to default screen size
+            SetViewport(0, 0, 1920, 1080); // Reset to default screen size
             glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
             glClearColor(0.1f, 0.1f, 0.3f, 1.0f);
         }
@@ -598,26 +1012,32 @@ void OpenGLAPI::EndFrame(bool onlyUnbind) const
 
 void OpenGLAPI::ActivateBackCull() const
 {
-    glCullFace(GL_BACK); 
+    SetCullFace(GL_BACK);
 }
 
 void OpenGLAPI::GenerateFrameBuffer(unsigned int* previewFBO, unsigned int* previewTexture, unsigned int* rbo, unsigned int previewWidth, unsigned int previewHeight)
 {
     // Delete old texture if it exists
     if(*previewTexture != 0)
+    {
+        ForgetTexture(*previewTexture);
         glDeleteTextures(1, previewTexture);
+    }
 
     if(*rbo != 0)
         glDeleteRenderbuffers(1, rbo);
 
     if(*previewFBO != 0)
+    {
+        if (stateCache.framebuffer == *previewFBO) stateCache.framebuffer = 0;
         glDeleteFramebuffers(1, previewFBO);
+    }
 
     glGenFramebuffers(1, previewFBO);
-    glBindFramebuffer(GL_FRAMEBUFFER, *previewFBO);
+    BindFramebuffer(*previewFBO);
 
     glGenTextures(1, previewTexture);
-    glBindTexture(GL_TEXTURE_2D, *previewTexture);
+    BindTextureTarget(TEXTURE_2D, *previewTexture);
     glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB, previewWidth, previewHeight, 0, GL_RGB, GL_UNSIGNED_BYTE, nullptr);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
@@ -631,12 +1051,12 @@ void OpenGLAPI::GenerateFrameBuffer(unsigned int* previewFBO, unsigned int* prev
     if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE)
         std::cerr << "Preview framebuffer not complete!" << std::endl;
 
-    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    BindFramebuffer(0);
 }
 
 void OpenGLAPI::RenderLineMesh(unsigned int *VAO, unsigned int *VBO, const std::vector<PulseEngine::Vector3> &vertices, const std::vector<unsigned int> &indices)
-{     
-    glBindVertexArray(*VAO);
+{
+    BindVertexArray(*VAO);
 
     if (!indices.empty())
     {
@@ -646,25 +1066,209 @@ void OpenGLAPI::RenderLineMesh(unsigned int *VAO, unsigned int *VBO, const std::
     {
         glDrawArrays(GL_LINES, 0, static_cast<GLsizei>(vertices.size()));
     }
+}
 
-    glBindVertexArray(0);
+std::size_t OpenGLAPI::DrawLineBatch(const LineVertex *vertices, std::size_t count) const
+{
+    count -= count % 2;
+    if (count == 0) return 0;
+
+    // a vertex array reading LineVertex from the ring, set again when the ring buffer grew
+    if (!lineBatchVertexArray || lineBatchRingGeneration != transientRing.GetGeneration())
+    {
+        if (!lineBatchVertexArray) glGenVertexArrays(1, &lineBatchVertexArray);
+        BindVertexArray(lineBatchVertexArray);
+        glBindBuffer(GL_ARRAY_BUFFER, transientRing.GetBuffer());
+        glEnableVertexAttribArray(0);
+        glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(LineVertex), (void*)offsetof(LineVertex, position));
+        glEnableVertexAttribArray(1);
+        glVertexAttribPointer(1, 4, GL_UNSIGNED_BYTE, GL_TRUE, sizeof(LineVertex), (void*)offsetof(LineVertex, color));
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+        lineBatchRingGeneration = transientRing.GetGeneration();
+    }
+    BindVertexArray(lineBatchVertexArray);
+
+    // split in uploads of at most one frame part (alignment padding included) : a full part spills in the next one
+    const std::size_t partSize = transientRing.GetAllocator().GetPartitionSize();
+    std::size_t chunkCount = partSize >= sizeof(LineVertex) ? (partSize - (sizeof(LineVertex) - 1)) / sizeof(LineVertex) : 0;
+    chunkCount -= chunkCount % 2;
+    if (chunkCount == 0) return 0;
+
+    std::size_t drawn = 0;
+    while (drawn < count)
+    {
+        const std::size_t chunk = std::min(count - drawn, chunkCount);
+        const std::size_t offset = transientRing.Write(vertices + drawn, chunk * sizeof(LineVertex), sizeof(LineVertex));
+        // every part is taken : the rest is counted in the ring overflow, the next frames get larger parts
+        if (offset == GLTransientRing::INVALID_OFFSET) break;
+
+        glDrawArrays(GL_LINES, static_cast<GLint>(offset / sizeof(LineVertex)), static_cast<GLsizei>(chunk));
+        drawn += chunk;
+    }
+    return drawn;
 }
 
 void OpenGLAPI::ActivateWireframe()
 {
-    glPolygonMode(GL_FRONT_AND_BACK, GL_LINE);
-    glLineWidth(1.5f);
+    SetWireframe(true);
 }
 
 void OpenGLAPI::DesactivateWireframe()
 {
-    glPolygonMode(GL_FRONT_AND_BACK, GL_FILL);
+    SetWireframe(false);
+}
+
+void OpenGLAPI::SetPipelineState(const PipelineState& state) const
+{
+    PipelineState& current = stateCache.pipeline;
+    const bool known = stateCache.pipelineKnown;
+    if (SkipCall(known && current == state, counters.skippedPipelineStates)) return;
+
+    if (!known || state.depthTest != current.depthTest)
+    {
+        if (state.depthTest) glEnable(GL_DEPTH_TEST);
+        else glDisable(GL_DEPTH_TEST);
+    }
+    if (!known || state.depthWrite != current.depthWrite)
+        glDepthMask(state.depthWrite ? GL_TRUE : GL_FALSE);
+    if (!known || state.depthFunction != current.depthFunction)
+    {
+        switch (state.depthFunction)
+        {
+            case DEPTH_LESS: glDepthFunc(GL_LESS); break;
+            case DEPTH_LEQUAL: glDepthFunc(GL_LEQUAL); break;
+            case DEPTH_ALWAYS: glDepthFunc(GL_ALWAYS); break;
+        }
+    }
+    if (!known || state.blend != current.blend)
+    {
+        if (state.blend == BLEND_NONE) glDisable(GL_BLEND);
+        else glEnable(GL_BLEND);
+        if (state.blend == BLEND_ALPHA) glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+        else if (state.blend == BLEND_ADDITIVE) glBlendFunc(GL_ONE, GL_ONE);
+    }
+    if (!known || state.cull != current.cull)
+    {
+        if (state.cull == CULL_NONE) glDisable(GL_CULL_FACE);
+        else glEnable(GL_CULL_FACE);
+    }
+    if (state.cull != CULL_NONE) SetCullFace(state.cull == CULL_FRONT ? GL_FRONT : GL_BACK);
+
+    SetWireframe(state.wireframe);
+
+    current = state;
+    stateCache.pipelineKnown = true;
+}
+
+void OpenGLAPI::InvalidateStateCache() const
+{
+    stateCache = GLStateCache();
+    for (auto& unit : stateCache.textures)
+        for (GLuint& texture : unit) texture = UNKNOWN_BINDING;
+}
+
+bool OpenGLAPI::SkipCall(bool alreadyInPlace, std::uint64_t& skippedKind) const
+{
+    counters.requested++;
+    if (!alreadyInPlace) return false;
+    counters.skipped++;
+    skippedKind++;
+    return true;
+}
+
+void OpenGLAPI::BindProgram(GLuint program) const
+{
+    if (SkipCall(stateCache.program == program, counters.skippedPrograms)) return;
+    glUseProgram(program);
+    stateCache.program = program;
+}
+
+void OpenGLAPI::BindVertexArray(GLuint vertexArray) const
+{
+    if (SkipCall(stateCache.vertexArray == vertexArray, counters.skippedVertexArrays)) return;
+    glBindVertexArray(vertexArray);
+    stateCache.vertexArray = vertexArray;
+}
+
+void OpenGLAPI::BindFramebuffer(GLuint framebuffer) const
+{
+    if (SkipCall(stateCache.framebuffer == framebuffer, counters.skippedFramebuffers)) return;
+    glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+    stateCache.framebuffer = framebuffer;
+}
+
+void OpenGLAPI::SetActiveUnit(GLuint unit) const
+{
+    if (SkipCall(stateCache.activeUnit == unit, counters.skippedTextures)) return;
+    glActiveTexture(GL_TEXTURE0 + unit);
+    stateCache.activeUnit = unit;
+}
+
+void OpenGLAPI::BindTextureTarget(TextureType type, GLuint texture) const
+{
+    GLenum target = GL_TEXTURE_2D;
+    switch (type)
+    {
+        case TEXTURE_2D: target = GL_TEXTURE_2D; break;
+        case TEXTURE_CUBE_MAP: target = GL_TEXTURE_CUBE_MAP; break;
+        case TEXTURE_BUFFER: target = GL_TEXTURE_BUFFER; break;
+        case TEXTURE_2D_ARRAY: target = GL_TEXTURE_2D_ARRAY; break;
+        default:
+            EDITOR_ERROR("Unknown texture type.");
+            return;
+    }
+
+    const GLuint unit = stateCache.activeUnit;
+    if (unit >= CACHED_TEXTURE_UNITS)
+    {
+        counters.requested++;
+        glBindTexture(target, texture);
+        return;
+    }
+    if (SkipCall(stateCache.textures[unit][type] == texture, counters.skippedTextures)) return;
+    glBindTexture(target, texture);
+    stateCache.textures[unit][type] = texture;
+}
+
+void OpenGLAPI::SetViewport(GLint x, GLint y, GLsizei width, GLsizei height) const
+{
+    GLint* viewport = stateCache.viewport;
+    const bool same = viewport[0] == x && viewport[1] == y && viewport[2] == width && viewport[3] == height;
+    if (SkipCall(same, counters.skippedPipelineStates)) return;
+    glViewport(x, y, width, height);
+    viewport[0] = x;
+    viewport[1] = y;
+    viewport[2] = width;
+    viewport[3] = height;
+}
+
+void OpenGLAPI::SetCullFace(GLenum face) const
+{
+    if (stateCache.cullFace == face) return;
+    glCullFace(face);
+    stateCache.cullFace = face;
+}
+
+void OpenGLAPI::SetWireframe(bool enabled) const
+{
+    if (stateCache.pipelineKnown && stateCache.pipeline.wireframe == enabled) return;
+    glPolygonMode(GL_FRONT_AND_BACK, enabled ? GL_LINE : GL_FILL);
+    if (enabled) glLineWidth(1.5f);
+    stateCache.pipeline.wireframe = enabled;
+}
+
+void OpenGLAPI::ForgetTexture(GLuint texture) const
+{
+    for (auto& unit : stateCache.textures)
+        for (GLuint& bound : unit)
+            if (bound == texture) bound = 0;
 }
 
 ITextRenderer *OpenGLAPI::CreateNewText()
 {
-    GLTextRenderer* tr = new GLTextRenderer();
+    GLTextRenderer* tr = new GLTextRenderer(this);
     tr->Init();
+    InvalidateStateCache();
     return tr;
 }
 
@@ -719,6 +1323,16 @@ unsigned int OpenGLAPI::CreateShader(const std::string &vertexPath,
 }
 
 
+unsigned int OpenGLAPI::CreateShader(const std::string &vertexPath, const std::string &fragmentPath, const std::vector<std::string> &defines)
+{
+    std::string vertexCode = InjectDefines(LoadShaderCode(vertexPath), defines);
+    std::string fragmentCode = InjectDefines(LoadShaderCode(fragmentPath), defines);
+
+    unsigned int vertexShader = CompileShader(GL_VERTEX_SHADER, vertexCode.c_str());
+    unsigned int fragmentShader = CompileShader(GL_FRAGMENT_SHADER, fragmentCode.c_str());
+    return LinkProgram(vertexShader, fragmentShader);
+}
+
 std::string OpenGLAPI::LoadShaderCode(const std::string& path)
 {
     std::ifstream shaderFile(path);
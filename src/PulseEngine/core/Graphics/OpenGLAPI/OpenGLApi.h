@@ -14,6 +14,8 @@
 #define OPENGLWINDOW_H
 
 #include "PulseEngine/core/Graphics/IGraphicsApi.h"
+#include "PulseEngine/core/Graphics/OpenGLAPI/TransientRingGl.h"
+#include "PulseEngine/core/Graphics/TextureArrays/TextureArrayPacker.h"
 #include <glad.h>                       // OpenGL function loader
 #include <GLFW/glfw3.h>                 // Cross-platform windowing/input
 #include <glm/glm.hpp>                  // GLM core
@@ -21,6 +23,8 @@
 #include <glm/gtc/matrix_transform.hpp> // GLM transformation helpers
 #include <GL/gl.h>                      // OpenGL headers
 
+#include <unordered_map>
+
 class GLTextRenderer;
 
 class OpenGLAPI : public IGraphicsAPI
@@ -47,6 +51,7 @@ public:
 
         unsigned int CreateShader(const std::string& vertexPath, const std::string& fragmentPath) override;
         unsigned int CreateShader(const std::string& vertexPath, const std::string& fragmentPath, const std::string& geometryPath) override;
+        unsigned int CreateShader(const std::string& vertexPath, const std::string& fragmentPath, const std::vector<std::string>& defines) override;
     std::string LoadShaderCode(const std::string& path);
     unsigned int CompileShader(unsigned int type, const char* source);
     unsigned int LinkProgram(unsigned int vertexShader, unsigned int fragmentShader);
@@ -69,15 +74,25 @@ public:
     bool IsFrameBufferComplete() const override;
     void InitCubeMapFaceForRender(unsigned int* CubeMap, unsigned int faceIndex) const override;
     void GenerateTextureMap(unsigned int* textureID, const std::string& filePath, bool hasFlip) const override;
+    void UploadTexture(unsigned int* textureID, const unsigned char* pixels, int width, int height, int channels) const override;
+    bool UploadCookedTexture(unsigned int* textureID, const PulseEngine::Cooking::CookedTexture& texture) const override;
+    void DeleteTexture(unsigned int textureID) const override;
+    void CreateTextureBuffer(unsigned int* buffer, unsigned int* textureID, TextureBufferFormat format) const override;
+    void UploadTextureBuffer(unsigned int buffer, const void* data, std::size_t size) const override;
+    void DeleteTextureBuffer(unsigned int buffer, unsigned int textureID) const override;
     void GenerateShadowMap(unsigned int* shadowMap, unsigned int* FBO, int width, int height) const override;
-    void BindShadowFramebuffer(unsigned int* FBO) const override;
+    void BindShadowFramebuffer(unsigned int* FBO, bool clear = true) const override;
+    void CopyShadowMap(unsigned int sourceTexture, unsigned int targetTexture, int size, bool cubeMap) const override;
     void UnbindShadowFramebuffer() const override;
 
     void SetupSimpleSquare(unsigned int* VAO, unsigned int* VBO , unsigned int* EBO) const override;
 
     void DeleteMesh(unsigned int* VAO, unsigned int* VBO, unsigned int* EBO) const override;
-    void SetupMesh(unsigned int* VAO, unsigned int* VBO, unsigned int* EBO, const std::vector<Vertex>& vertices, const std::vector<unsigned int>& indices) const override;
+    void SetupMesh(unsigned int* VAO, unsigned int* VBO, unsigned int* EBO, const std::vector<Vertex>& vertices,
+                   const std::vector<SkinWeights>& skin, const std::vector<unsigned int>& indices) const override;
     void RenderMesh(unsigned int* VAO, unsigned int* VBO, const std::vector<Vertex>& vertices, const std::vector<unsigned int>& indices) const override;
+    void RenderMeshRange(unsigned int* VAO, unsigned int indexOffset, unsigned int indexCount) const override;
+    void RenderMeshRangeInstanced(unsigned int* VAO, unsigned int indexOffset, unsigned int indexCount, unsigned int instanceCount) const override;
 
     float GetTime() const override;
     
@@ -91,17 +106,90 @@ public:
 
     void GenerateFrameBuffer(unsigned int* previewFBO, unsigned int* previewTexture, unsigned int* rbo, unsigned int previewWidth,unsigned int previewHeight) override;
     void RenderLineMesh(unsigned int* VAO, unsigned int* VBO, const std::vector<PulseEngine::Vector3>& vertices, const std::vector<unsigned int>& indices) override;
+    std::size_t DrawLineBatch(const LineVertex* vertices, std::size_t count) const override;
     void ActivateWireframe() override;
     void DesactivateWireframe() override;
 
-    
+    void SetPipelineState(const PipelineState& state) const override;
+    StateCacheCounters GetStateCacheCounters() const override { return lastFrameCounters; }
+    void InvalidateStateCache() const override;
+
+    TextureArraySlot GetTextureArraySlot(unsigned int textureID) const override;
+
     ITextRenderer* CreateNewText() override;
 
+    /**
+     * @brief Where the data drawn once goes (glyph quads, debug lines, light clusters), see TransientRingGl.h.
+     */
+    GLTransientRing& GetTransientRing() const { return transientRing; }
+
     GLFWwindow* window = nullptr;
     GLuint fbo, fboTexture, rbo;
     int fboWidth = 1024;
     int fboHeight = 720;
 private:
+    static constexpr GLuint UNKNOWN_BINDING = 0xFFFFFFFFu;    ///< after InvalidateStateCache : the next bind is sent
+    static constexpr unsigned int CACHED_TEXTURE_UNITS = 16;  ///< units above are bound without the cache
+    static constexpr unsigned int TEXTURE_TYPE_COUNT = 4;     ///< of TextureType
+
+    // every bind goes through these : they skip what the driver already has and keep stateCache up to date
+    void BindProgram(GLuint program) const;
+    void BindVertexArray(GLuint vertexArray) const;
+    void BindFramebuffer(GLuint framebuffer) const;
+    void BindTextureTarget(TextureType type, GLuint texture) const;
+    void SetActiveUnit(GLuint unit) const;
+    void SetViewport(GLint x, GLint y, GLsizei width, GLsizei height) const;
+    void SetCullFace(GLenum face) const;
+    void SetWireframe(bool enabled) const;
+    void ForgetTexture(GLuint texture) const;
+    /// @brief Count a state call, true when it changes nothing and is to be skipped.
+    bool SkipCall(bool alreadyInPlace, std::uint64_t& skippedKind) const;
+
+    /**
+     * @brief What the driver has bound, as far as this API knows (ImGui restores what it changes, the text renderer
+     * invalidates it).
+     */
+    struct GLStateCache
+    {
+        GLuint program = UNKNOWN_BINDING;
+        GLuint vertexArray = UNKNOWN_BINDING;
+        GLuint framebuffer = UNKNOWN_BINDING;
+        GLuint activeUnit = UNKNOWN_BINDING;
+        GLuint textures[CACHED_TEXTURE_UNITS][TEXTURE_TYPE_COUNT] = {};  ///< by unit, by TextureType
+        GLint viewport[4] = { -1, -1, -1, -1 };
+        GLenum cullFace = 0;
+        PipelineState pipeline;
+        bool pipelineKnown = false;
+    };
+
+    static constexpr std::size_t TRANSIENT_FRAME_SIZE = 4 * 1024 * 1024;   ///< bytes of transient data per frame
+    static constexpr std::size_t TRANSIENT_FRAME_MAX_SIZE = 64 * 1024 * 1024;  ///< the ring grows up to it
+    static constexpr std::size_t TEXTURE_ARRAY_BUDGET = 64 * 1024 * 1024;  ///< bytes of one texture array, at least a layer
+    static constexpr int TEXTURE_ARRAY_MAX_LAYERS = 64;
+
+    /// @brief Size and sized format of a 2D texture, levels counted down to the last one defined.
+    PulseEngine::Graphics::TextureArrayFormat ReadTextureArrayFormat(GLuint texture) const;
+
+    /// @brief A buffer texture, pointed at a range of the transient ring by UploadTextureBuffer when it can.
+    struct TextureBufferView
+    {
+        GLuint texture = 0;
+        GLenum format = 0;
+    };
+
+    mutable GLuint copyFramebuffers[2] = { 0, 0 };  ///< read / draw, of CopyShadowMap
+    mutable GLTransientRing transientRing;
+    mutable GLuint lineVertexArray = 0;             ///< DrawLine, reads the transient ring
+    mutable GLuint lineBatchVertexArray = 0;        ///< DrawLineBatch, reads the transient ring
+    mutable std::uint32_t lineRingGeneration = 0;       ///< of the ring buffer lineVertexArray reads
+    mutable std::uint32_t lineBatchRingGeneration = 0;  ///< of the ring buffer lineBatchVertexArray reads
+    mutable std::unordered_map<GLuint, TextureBufferView> textureBuffers;  ///< by buffer
+    mutable bool ringOverflowReported = false;      ///< UploadTextureBuffer warns once, the profiler counts every one
+    mutable PulseEngine::Graphics::TextureArrayPacker textureArrays;        ///< initialized with GL 4.3 only
+    GLint textureBufferAlignment = 256;             ///< of the ranges given to glTexBufferRange
+    mutable GLStateCache stateCache;
+    mutable StateCacheCounters counters;            ///< of the frame being drawn
+    mutable StateCacheCounters lastFrameCounters;
 };
 
 #endif // OPENGLAPI_H
@@ -9,6 +9,9 @@ GLTextRenderer::~GLTextRenderer()
 
 bool GLTextRenderer::Init()
 {
+    // the glyph quads are read from the transient ring of the API
+    if (!api) return false;
+
     // Load TTF file
     FILE *fp = fopen("Roboto-Regular.ttf", "rb");
     if (!fp)
@@ -36,12 +39,19 @@ bool GLTextRenderer::Init()
                  GL_RED, GL_UNSIGNED_BYTE, atlasBitmap.data());
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
 
-    // VAO + VBO
+    // VAO on the transient ring, the quads of a frame are drawn at the offset they were written to
     glGenVertexArrays(1, &vao);
-    glGenBuffers(1, &vbo);
+    BindRingBuffer();
+
+    shader = CompileShader();
 
+    return true;
+}
+
+void GLTextRenderer::BindRingBuffer()
+{
     glBindVertexArray(vao);
-    glBindBuffer(GL_ARRAY_BUFFER, vbo);
+    glBindBuffer(GL_ARRAY_BUFFER, api->GetTransientRing().GetBuffer());
 
     glEnableVertexAttribArray(0); // pos
     glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE,
@@ -54,10 +64,8 @@ bool GLTextRenderer::Init()
                           (void*)offsetof(TextVert, u));
 
     glBindVertexArray(0);
-
-    shader = CompileShader();
-
-    return true;
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    ringGeneration = api->GetTransientRing().GetGeneration();
 }
 
 void GLTextRenderer::SetScreenSize(int w, int h)
@@ -107,6 +115,19 @@ void GLTextRenderer::RenderText(const std::string &text,
 
 void GLTextRenderer::Render()
 {
+    if (quads.empty()) return;
+
+    // every glyph of the frame in one upload
+    vertices.clear();
+    for (const Quad& q : quads) vertices.insert(vertices.end(), q.v, q.v + 4);
+    const std::size_t offset = api->GetTransientRing().Write(vertices.data(), vertices.size() * sizeof(Vert), sizeof(Vert));
+    if (offset == GLTransientRing::INVALID_OFFSET)
+    {
+        quads.clear();
+        return;
+    }
+    GLint first = static_cast<GLint>(offset / sizeof(Vert));
+
     glEnable(GL_BLEND);
     glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
 
@@ -115,24 +136,24 @@ void GLTextRenderer::Render()
     glUniform2f(glGetUniformLocation(shader, "uScreen"),
                 (float)screenW, (float)screenH);
 
+    // the ring buffer grew since the last frame
+    if (ringGeneration != api->GetTransientRing().GetGeneration()) BindRingBuffer();
     glBindVertexArray(vao);
-    glBindBuffer(GL_ARRAY_BUFFER, vbo);
 
     glActiveTexture(GL_TEXTURE0);
     glBindTexture(GL_TEXTURE_2D, fontTex);
+    glUniform1i(glGetUniformLocation(shader, "uTex"), 0);
 
+    const GLint colorLocation = glGetUniformLocation(shader, "uColor");
     for (const auto &q : quads)
     {
-        // Push quad into VBO
-        glBufferData(GL_ARRAY_BUFFER, sizeof(q.v), q.v, GL_DYNAMIC_DRAW);
-
-        glUniform3fv(glGetUniformLocation(shader, "uColor"), 1, &q.color.x);
-        glUniform1i(glGetUniformLocation(shader, "uTex"), 0);
-
-        glDrawArrays(GL_TRIANGLE_FAN, 0, 4);
+        glUniform3fv(colorLocation, 1, &q.color.x);
+        glDrawArrays(GL_TRIANGLE_FAN, first, 4);
+        first += 4;
     }
 
     quads.clear();
+    if (api) api->InvalidateStateCache();
 }
 
 GLuint GLTextRenderer::CompileShader()
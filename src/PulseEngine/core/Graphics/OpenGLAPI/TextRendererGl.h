@@ -14,6 +14,8 @@ struct TextVert {
 class PULSE_ENGINE_DLL_API GLTextRenderer : public ITextRenderer
 {
 public:
+    /// @param api its state cache is invalidated after the text is drawn with plain GL calls
+    explicit GLTextRenderer(const OpenGLAPI* api = nullptr) : api(api) {}
     ~GLTextRenderer();
     bool Init() override;
     void SetScreenSize(int w, int h) override;
@@ -30,8 +32,12 @@ private:
     struct Quad { Vert v[4]; glm::vec3 color; };
 
     std::vector<Quad> quads;
+    std::vector<Vert> vertices;     ///< the quads of a frame, before their upload
 
-    GLuint vao=0, vbo=0, shader=0, fontTex=0;
+
+    const OpenGLAPI* api = nullptr;
+    GLuint vao=0, shader=0, fontTex=0;
+    std::uint32_t ringGeneration = 0;   ///< of the transient ring buffer vao reads
     int screenW=1, screenH=1;
 
     static constexpr int ATLAS_W = 512;
@@ -43,4 +49,6 @@ private:
 
 private:
     GLuint CompileShader();
+    /// @brief Point vao at the transient ring buffer.
+    void BindRingBuffer();
 };
\ No newline at end of file
@@ -0,0 +1,139 @@
+#include "TransientRingGl.h"
+#include <GLFW/glfw3.h>
+
+#include "Common/EditorDefines.h"
+
+#include <cstring>
+
+// glad is generated for 3.3 : the 4.4 storage entry point and flags are loaded here
+#ifndef GL_MAP_PERSISTENT_BIT
+#define GL_MAP_PERSISTENT_BIT 0x0040
+#endif
+#ifndef GL_MAP_COHERENT_BIT
+#define GL_MAP_COHERENT_BIT 0x0080
+#endif
+
+namespace
+{
+    typedef void (APIENTRYP BufferStorageProc)(GLenum target, GLsizeiptr size, const void* data, GLbitfield flags);
+
+    BufferStorageProc LoadBufferStorage()
+    {
+        const bool supported = GLVersion.major > 4 || (GLVersion.major == 4 && GLVersion.minor >= 4)
+            || glfwExtensionSupported("GL_ARB_buffer_storage");
+        if (!supported) return nullptr;
+        return reinterpret_cast<BufferStorageProc>(glfwGetProcAddress("glBufferStorage"));
+    }
+}
+
+void GLTransientRing::Initialize(std::size_t frameSize, std::uint32_t frames, std::size_t maxFrameSize)
+{
+    this->maxFrameSize = maxFrameSize;
+    fences.assign(frames, nullptr);
+
+    allocator.Initialize(frameSize * frames, frames,
+        [this](std::uint32_t partition)
+        {
+            fences[partition] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+        },
+        [this](std::uint32_t partition)
+        {
+            GLsync fence = fences[partition];
+            if (!fence) return;
+            // flush once, then block : the GPU is frames behind only when it is the bottleneck
+            GLenum status = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 0);
+            while (status == GL_TIMEOUT_EXPIRED)
+                status = glClientWaitSync(fence, 0, 1000000); // 1 ms
+            glDeleteSync(fence);
+            fences[partition] = nullptr;
+        });
+    CreateBuffer();
+}
+
+void GLTransientRing::CreateBuffer()
+{
+    const std::size_t capacity = allocator.GetCapacity();
+    glGenBuffers(1, &buffer);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, buffer);
+
+    if (BufferStorageProc bufferStorage = LoadBufferStorage())
+    {
+        const GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+        bufferStorage(GL_COPY_WRITE_BUFFER, static_cast<GLsizeiptr>(capacity), nullptr, flags);
+        mapped = static_cast<unsigned char*>(glMapBufferRange(GL_COPY_WRITE_BUFFER, 0, static_cast<GLsizeiptr>(capacity), flags));
+    }
+    if (!mapped)
+    {
+        glBufferData(GL_COPY_WRITE_BUFFER, static_cast<GLsizeiptr>(capacity), nullptr, GL_STREAM_DRAW);
+        if (generation == 0)
+        {
+            EDITOR_WARN("Transient ring : no persistent mapping, written with glBufferSubData")
+        }
+    }
+    glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+    generation++;
+}
+
+void GLTransientRing::DeleteBuffer()
+{
+    if (!buffer) return;
+    if (mapped)
+    {
+        glBindBuffer(GL_COPY_WRITE_BUFFER, buffer);
+        glUnmapBuffer(GL_COPY_WRITE_BUFFER);
+        glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+        mapped = nullptr;
+    }
+    glDeleteBuffers(1, &buffer);
+    buffer = 0;
+}
+
+void GLTransientRing::Shutdown()
+{
+    for (GLsync& fence : fences)
+    {
+        if (fence) glDeleteSync(fence);
+        fence = nullptr;
+    }
+    DeleteBuffer();
+}
+
+void GLTransientRing::EndFrame()
+{
+    if (buffer) allocator.EndFrame();
+}
+
+void GLTransientRing::BeginFrame()
+{
+    if (!buffer) return;
+
+    // between two frames, once every fence is signaled : no draw reads the old buffer anymore
+    if (const std::size_t frameSize = allocator.GetGrowthSize(maxFrameSize))
+    {
+        allocator.Resize(frameSize);
+        DeleteBuffer();
+        CreateBuffer();
+        EDITOR_LOG("Transient ring : " << frameSize / 1024 << " KB per frame")
+    }
+    allocator.BeginFrame();
+}
+
+std::size_t GLTransientRing::Write(const void* data, std::size_t size, std::size_t alignment)
+{
+    if (!buffer) return INVALID_OFFSET;
+    const std::size_t offset = allocator.Allocate(size, alignment);
+    if (offset == INVALID_OFFSET) return INVALID_OFFSET;
+
+    if (mapped)
+    {
+        std::memcpy(mapped + offset, data, size);
+    }
+    else
+    {
+        // the copy target isn't part of a vertex array : this leaves the bound geometry alone
+        glBindBuffer(GL_COPY_WRITE_BUFFER, buffer);
+        glBufferSubData(GL_COPY_WRITE_BUFFER, static_cast<GLintptr>(offset), static_cast<GLsizeiptr>(size), data);
+        glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+    }
+    return offset;
+}
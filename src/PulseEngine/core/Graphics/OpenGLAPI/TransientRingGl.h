@@ -0,0 +1,68 @@
+/**
+ * @file TransientRingGl.h
+ * @brief The OpenGL buffer behind TransientRingAllocator : every transient upload of OpenGLAPI is written here
+ * instead of re-specifying a buffer with glBufferData at each draw.
+ * @details With GL 4.4 or ARB_buffer_storage the buffer is immutable and mapped once, persistent and coherent : a
+ * write is a memcpy, the draws read the offset it returned. Without it the same ring is written with glBufferSubData,
+ * still without orphaning. glFenceSync guards the reuse of a frame part in both cases.
+ * A frame that needed more than a part makes the next BeginFrame wait the GPU and replace the buffer with a larger one :
+ * GetBuffer changes, the vertex arrays reading it are set again when GetGeneration does.
+ * @version 0.1
+ * @date 2025-12-14
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+#ifndef TRANSIENTRINGGL_H
+#define TRANSIENTRINGGL_H
+
+#include "PulseEngine/core/Graphics/TransientRing/TransientRingAllocator.h"
+#include <glad.h>
+
+#include <cstddef>
+#include <vector>
+
+class GLTransientRing
+{
+public:
+    /**
+     * @brief Create the buffer, on the thread of the GL context, once glad is loaded.
+     * @param frameSize bytes one frame can write
+     * @param frames frames in flight, the buffer holds frameSize * frames bytes
+     * @param maxFrameSize the parts grow up to this size
+     */
+    void Initialize(std::size_t frameSize, std::uint32_t frames = 3, std::size_t maxFrameSize = 64 * 1024 * 1024);
+    void Shutdown();
+
+    /// @brief At the frame swap : fence the frame drawn, grow the buffer if the frame needed it, open the next part.
+    void EndFrame();
+    void BeginFrame();
+
+    /**
+     * @brief Copy size bytes in the open frame, at most GetPartitionSize() bytes.
+     * @return their offset in GetBuffer(), a multiple of alignment, or INVALID_OFFSET when the frame has no room left.
+     */
+    std::size_t Write(const void* data, std::size_t size, std::size_t alignment = 1);
+
+    GLuint GetBuffer() const { return buffer; }
+    /// @brief Incremented when the buffer is replaced.
+    std::uint32_t GetGeneration() const { return generation; }
+    bool IsPersistent() const { return mapped != nullptr; }
+    const PulseEngine::Graphics::TransientRingAllocator& GetAllocator() const { return allocator; }
+
+    static constexpr std::size_t INVALID_OFFSET = PulseEngine::Graphics::TransientRingAllocator::INVALID_OFFSET;
+
+private:
+    /// @brief The buffer of the allocator capacity, persistent when it can.
+    void CreateBuffer();
+    void DeleteBuffer();
+
+    PulseEngine::Graphics::TransientRingAllocator allocator;
+    std::size_t maxFrameSize = 0;
+    std::uint32_t generation = 0;
+    GLuint buffer = 0;
+    unsigned char* mapped = nullptr;    ///< persistent mapping of the whole buffer, nullptr : glBufferSubData
+    std::vector<GLsync> fences;         ///< by frame part
+};
+
+#endif // TRANSIENTRINGGL_H
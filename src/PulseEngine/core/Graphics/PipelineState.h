@@ -0,0 +1,69 @@
+/**
+ * @file PipelineState.h
+ * @brief Fixed-function state of a draw (depth, blend, cull, polygon mode), set at once with
+ * IGraphicsAPI::SetPipelineState, and the counters of the state calls a backend didn't send.
+ * @details A material keeps its PipelineState, the renderer sets it before each object. The backends keep what is
+ * bound (program, vertex array, textures, framebuffer, viewport and this state) and skip the calls that change
+ * nothing : consecutive objects sharing a shader or a material cost no driver call.
+ * @version 0.1
+ * @date 2025-12-14
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+#ifndef PIPELINESTATE_H
+#define PIPELINESTATE_H
+
+#include <cstdint>
+
+enum DepthFunction
+{
+    DEPTH_LESS,
+    DEPTH_LEQUAL,
+    DEPTH_ALWAYS
+};
+
+enum BlendMode
+{
+    BLEND_NONE,
+    BLEND_ALPHA,        ///< src alpha, one minus src alpha
+    BLEND_ADDITIVE      ///< one, one
+};
+
+enum CullMode
+{
+    CULL_NONE,
+    CULL_BACK,
+    CULL_FRONT
+};
+
+/**
+ * @brief The default is what the renderer always drew with : opaque, depth tested and written, no culling.
+ */
+struct PipelineState
+{
+    bool depthTest = true;
+    bool depthWrite = true;
+    DepthFunction depthFunction = DEPTH_LESS;
+    BlendMode blend = BLEND_NONE;
+    CullMode cull = CULL_NONE;
+    bool wireframe = false;
+
+    bool operator==(const PipelineState& other) const = default;
+};
+
+/**
+ * @brief State calls of a frame, and how many were already in place : a backend doesn't send those to the driver.
+ */
+struct StateCacheCounters
+{
+    std::uint64_t requested = 0;            ///< programs, vertex arrays, textures, framebuffers, pipeline states, viewports
+    std::uint64_t skipped = 0;
+    std::uint64_t skippedPrograms = 0;
+    std::uint64_t skippedVertexArrays = 0;
+    std::uint64_t skippedTextures = 0;      ///< texture binds and texture unit switches
+    std::uint64_t skippedFramebuffers = 0;
+    std::uint64_t skippedPipelineStates = 0;///< whole SetPipelineState calls, and the viewports
+};
+
+#endif // PIPELINESTATE_H
@@ -0,0 +1,120 @@
+#include "RenderSnapshot.h"
+#include "PulseEngine/core/PulseEngineBackend.h"
+#include "PulseEngine/core/Entity/Entity.h"
+#include "PulseEngine/core/Graphics/IGraphicsApi.h"
+#include "PulseEngine/core/Lights/Lights.h"
+#include "PulseEngine/core/Material/Material.h"
+#include "PulseEngine/core/Material/Texture.h"
+#include "PulseEngine/core/Meshes/RenderableMesh.h"
+#include "shader.h"
+
+namespace
+{
+    // same names and units as Material::BindTextures
+    const char* const MAP_TYPES[RENDER_MAP_COUNT] = { "albedo", "normal", "roughness" };
+    const char* const MAP_SAMPLERS[RENDER_MAP_COUNT] = { "albedoMap", "normalMap", "roughnessMap" };
+    constexpr unsigned int FIRST_MAP_UNIT = 6;
+}
+
+void RenderSnapshot::Capture(const RenderView& camera, const std::vector<Entity*>& shadowCasters, const std::vector<Entity*>& visibleEntities,
+                             const std::vector<LightData*>& sceneLights)
+{
+    PROFILE_TIMER_FUNCTION;
+
+    view = camera;
+    objects.clear();
+    visible.clear();
+    meshes.clear();
+    lights.clear();
+    objectIndices.clear();
+    skinningJobs.clear();
+
+    for (Entity* entity : shadowCasters)
+    {
+        if (entity->GetMeshes().empty() || dynamic_cast<LightData*>(entity)) continue;
+        AddObject(entity);
+    }
+    casterCount = static_cast<std::uint32_t>(objects.size());
+
+    for (Entity* entity : visibleEntities)
+    {
+        if (dynamic_cast<LightData*>(entity)) continue; // a light cant be rendered to scene (for now)
+        auto it = objectIndices.find(entity);
+        visible.push_back(it != objectIndices.end() ? it->second : AddObject(entity));
+    }
+
+    // only the meshes kept here are posed, the off screen ones just advance their clock
+    bones.resize(skinningJobs.empty() ? 0 : skinningJobs.back().firstBone + skinningJobs.back().mesh->GetBoneCount());
+    SkinningStage::EvaluatePoses(skinningJobs, bones);
+
+    lights.reserve(sceneLights.size());
+    for (LightData* light : sceneLights)
+    {
+        RenderLight& params = lights.emplace_back();
+        params.light = light;
+        light->CaptureRenderLight(params);
+    }
+}
+
+std::uint32_t RenderSnapshot::AddObject(Entity* entity)
+{
+    const std::uint32_t index = static_cast<std::uint32_t>(objects.size());
+    objectIndices.emplace(entity, index);
+
+    RenderObject& object = objects.emplace_back();
+    object.entity = entity;
+    object.material = entity->GetMaterial();
+    object.color = object.material ? object.material->color : PulseEngine::Vector3(1.0f, 1.0f, 1.0f);
+    if (object.material)
+    {
+        // the editor can change them while the frame is drawn
+        object.pipelineState = object.material->pipelineState;
+        object.mapsReady = true;
+        for (int i = 0; i < RENDER_MAP_COUNT; ++i)
+        {
+            std::shared_ptr<Texture> texture = object.material->GetTexture(MAP_TYPES[i]);
+            object.maps[i] = texture ? texture->id : 0;
+            object.mapsReady = object.mapsReady && texture && texture->IsReady();
+        }
+    }
+    object.matrix = entity->GetMatrix();
+    object.worldBounds = entity->GetWorldBounds();
+    object.firstMesh = static_cast<std::uint32_t>(meshes.size());
+
+    for (RenderableMesh* mesh : entity->GetMeshes())
+    {
+        RenderMeshInstance& instance = meshes.emplace_back();
+        instance.mesh = mesh;
+        instance.matrix = mesh->matrix;
+
+        const std::uint32_t boneCount = mesh->GetBoneCount();
+        if (boneCount == 0) continue;
+        const std::uint32_t firstBone = skinningJobs.empty() ? 0 : skinningJobs.back().firstBone + skinningJobs.back().mesh->GetBoneCount();
+        skinningJobs.push_back({mesh, firstBone});
+        instance.firstBone = static_cast<std::int32_t>(firstBone);
+        object.skinned = true;
+    }
+    object.meshCount = static_cast<std::uint32_t>(meshes.size()) - object.firstMesh;
+    return index;
+}
+
+void RenderSnapshot::DrawObject(const RenderObject& object, Shader* shader, bool bindMaterial) const
+{
+    for (int i = 0; bindMaterial && i < RENDER_MAP_COUNT; ++i)
+    {
+        if (!object.maps[i]) continue;
+        PulseEngineGraphicsAPI->ActivateTexture(FIRST_MAP_UNIT + i);
+        PulseEngineGraphicsAPI->BindTexture(TEXTURE_2D, object.maps[i]);
+        shader->SetInt(MAP_SAMPLERS[i], FIRST_MAP_UNIT + i);
+    }
+
+    for (std::uint32_t i = 0; i < object.meshCount; ++i)
+    {
+        const RenderMeshInstance& instance = meshes[object.firstMesh + i];
+        if (instance.firstBone >= 0) SkinningStage::BindPalette(shader, bones, static_cast<std::uint32_t>(instance.firstBone), frame);
+        else SkinningStage::UnbindPalette(shader);
+
+        shader->SetMat4("model", instance.matrix);
+        instance.mesh->Draw(shader, instance.matrix, view);
+    }
+}
@@ -0,0 +1,136 @@
+/**
+ * @file RenderSnapshot.h
+ * @brief Everything the graphics thread reads to draw a frame, copied at the end of the simulation : camera, shadow
+ * casters and visible entities with their matrices and bone palettes, lights.
+ * @details The game runs the simulation of frame N+1 on its own thread while the main thread draws frame N from its
+ * snapshot (see PulseEngineBackend::Update). PulseEngineBackend keeps two of them : the simulation fills the back
+ * one, they are swapped when both threads meet. A snapshot is not changed once captured, so it is read without lock.
+ * - Matrices, bounds, colors, light parameters and the material state (pipeline state, texture ids) are copies, the
+ *   scene and its materials can change right after the capture.
+ * - Meshes, materials, shaders and lights are kept as pointers for their GPU resources only (buffers, shaders, shadow
+ *   maps), which only the graphics thread creates and deletes (see GraphicsThread.h).
+ * @version 0.1
+ * @date 2025-12-14
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+#ifndef RENDERSNAPSHOT_H
+#define RENDERSNAPSHOT_H
+
+#include "Common/dllExport.h"
+#include "PulseEngine/core/Math/Vector.h"
+#include "PulseEngine/core/Math/Mat4.h"
+#include "PulseEngine/core/Math/Frustum/AABB.h"
+#include "PulseEngine/core/Graphics/PipelineState.h"
+#include "PulseEngine/core/Meshes/Skinning/SkinningStage.h"
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+class Entity;
+class LightData;
+class Material;
+class RenderableMesh;
+class Shader;
+
+/**
+ * @brief The camera of a snapshot, what the shaders and the LOD selection get.
+ */
+struct RenderView
+{
+    PulseEngine::Mat4 view;
+    PulseEngine::Mat4 projection;
+    PulseEngine::Vector3 position;
+    int width = 0;      ///< viewport, in pixels
+    int height = 0;
+};
+
+struct RenderMeshInstance
+{
+    const RenderableMesh* mesh = nullptr;
+    PulseEngine::Mat4 matrix;
+    std::int32_t firstBone = -1;        ///< palette start in RenderSnapshot::bones, -1 : not skinned
+};
+
+/// @brief The maps of Material::BindTextures, in a RenderObject.
+enum RenderMaterialMap
+{
+    RENDER_MAP_ALBEDO,
+    RENDER_MAP_NORMAL,
+    RENDER_MAP_ROUGHNESS,
+    RENDER_MAP_COUNT
+};
+
+struct RenderObject
+{
+    /// identity for the shadow caster tracking, and the overlays drawn once the simulation waits (collider, scripts)
+    Entity* entity = nullptr;
+    Material* material = nullptr;       ///< for its shader only, GetShader can create it on the graphics thread
+    PipelineState pipelineState;        ///< of the material
+    unsigned int maps[RENDER_MAP_COUNT] = {};   ///< texture ids of the material, 0 : none (the placeholder while loading)
+    bool mapsReady = false;             ///< the three maps are there and uploaded
+    PulseEngine::Mat4 matrix;
+    AABB worldBounds;
+    PulseEngine::Vector3 color;
+    std::uint32_t firstMesh = 0;        ///< in RenderSnapshot::meshes
+    std::uint32_t meshCount = 0;
+    bool skinned = false;
+};
+
+struct RenderLight
+{
+    LightData* light = nullptr;         ///< shadow maps and caster caches, graphics thread side
+    PulseEngine::Vector3 position;
+    PulseEngine::Vector3 color;
+    float intensity = 0.0f;
+    float attenuation = 0.0f;
+    float nearPlane = 0.0f;
+    float farPlane = 0.0f;
+    bool castsShadow = false;
+
+    // directional light
+    PulseEngine::Vector3 target;
+    int cascadeCount = 0;
+    float shadowDistance = 0.0f;
+    float cascadeSplitLambda = 0.0f;
+};
+
+class PULSE_ENGINE_DLL_API RenderSnapshot
+{
+public:
+    /**
+     * @brief Copy the frame, on the thread that owns the scene.
+     * @param shadowCasters entities drawn in the shadow maps
+     * @param visibleEntities entities drawn in the view, in this order
+     */
+    void Capture(const RenderView& camera, const std::vector<Entity*>& shadowCasters, const std::vector<Entity*>& visibleEntities,
+                 const std::vector<LightData*>& sceneLights);
+
+    /**
+     * @brief Draw the meshes of object with shader, already in use : model matrix, bones, and the material maps copied
+     * at the capture when bindMaterial (not needed by the depth passes).
+     */
+    void DrawObject(const RenderObject& object, Shader* shader, bool bindMaterial = true) const;
+
+    std::uint64_t frame = 0;            ///< simulation frame captured
+    RenderView view;
+
+    std::vector<RenderObject> objects;  ///< the casterCount shadow casters first, then the visible entities that aren't
+    std::uint32_t casterCount = 0;
+    std::vector<std::uint32_t> visible; ///< in objects, draw order
+
+    std::vector<RenderMeshInstance> meshes;
+    /// every bone palette one after the other, posed on the workers at the capture and uploaded once (SkinningStage)
+    std::vector<PulseEngine::Mat4> bones;
+    std::vector<RenderLight> lights;
+
+private:
+    std::uint32_t AddObject(Entity* entity);
+
+    std::unordered_map<const Entity*, std::uint32_t> objectIndices;
+    std::vector<SkinningJob> skinningJobs;
+};
+
+#endif // RENDERSNAPSHOT_H
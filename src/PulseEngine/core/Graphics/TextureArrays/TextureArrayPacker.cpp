@@ -0,0 +1,99 @@
+#include "TextureArrayPacker.h"
+
+#include <algorithm>
+
+using namespace PulseEngine::Graphics;
+
+void TextureArrayPacker::Initialize(std::size_t arrayBudget, int maxLayers, CreateArrayCallback createArray, CopyLayerCallback copyLayer,
+                                    DeleteArrayCallback deleteArray)
+{
+    this->arrayBudget = arrayBudget;
+    this->maxLayers = std::max(maxLayers, 1);
+    this->createArray = std::move(createArray);
+    this->copyLayer = std::move(copyLayer);
+    this->deleteArray = std::move(deleteArray);
+}
+
+void TextureArrayPacker::Shutdown()
+{
+    if (deleteArray)
+    {
+        for (const PackedArray& array : arrays) deleteArray(array.handle);
+    }
+    arrays.clear();
+    slots.clear();
+    arrayIndices.clear();
+    stats = TextureArrayStats();
+}
+
+TextureArraySlot TextureArrayPacker::Find(unsigned int texture) const
+{
+    auto it = slots.find(texture);
+    return it != slots.end() ? it->second : TextureArraySlot();
+}
+
+TextureArraySlot TextureArrayPacker::Pack(unsigned int texture, const TextureArrayFormat &format)
+{
+    TextureArraySlot slot = Find(texture);
+    if (slot.IsValid() || !createArray || !copyLayer) return slot;
+
+    PackedArray* target = nullptr;
+    for (PackedArray& array : arrays)
+    {
+        if (array.format == format && (!array.freeLayers.empty() || array.used < array.layers))
+        {
+            target = &array;
+            break;
+        }
+    }
+
+    if (!target)
+    {
+        // a big format gets few layers : an array is allocated whole, used or not
+        const std::size_t fit = format.layerBytes > 0 ? arrayBudget / format.layerBytes : static_cast<std::size_t>(maxLayers);
+        const int layers = static_cast<int>(std::clamp<std::size_t>(fit, 1, static_cast<std::size_t>(maxLayers)));
+        const unsigned int handle = createArray(format, layers);
+        if (!handle) return TextureArraySlot();
+
+        PackedArray array;
+        array.format = format;
+        array.handle = handle;
+        array.layers = layers;
+        arrayIndices[handle] = arrays.size();
+        arrays.push_back(array);
+        target = &arrays.back();
+
+        stats.arrays++;
+        stats.layers += static_cast<std::size_t>(layers);
+        stats.bytes += format.layerBytes * static_cast<std::size_t>(layers);
+    }
+
+    int layer = 0;
+    if (!target->freeLayers.empty())
+    {
+        layer = target->freeLayers.back();
+        target->freeLayers.pop_back();
+    }
+    else
+    {
+        layer = target->used++;
+    }
+
+    copyLayer(texture, format, target->handle, layer);
+    slot.array = target->handle;
+    slot.layer = layer;
+    slots[texture] = slot;
+    stats.packedTextures++;
+    return slot;
+}
+
+void TextureArrayPacker::Release(unsigned int texture)
+{
+    auto it = slots.find(texture);
+    if (it == slots.end()) return;
+
+    auto array = arrayIndices.find(it->second.array);
+    if (array != arrayIndices.end()) arrays[array->second].freeLayers.push_back(it->second.layer);
+    slots.erase(it);
+    stats.packedTextures--;
+}
@@ -0,0 +1,107 @@
+/**
+ * @file TextureArrayPacker.h
+ * @brief Which layer of which texture array holds a copy of a texture : the material maps of the same size and format
+ * share an array, so the objects sampling them can be drawn together (see MaterialBatcher).
+ * @details The arrays are grouped by TextureArrayFormat. A format gets a new array when its arrays are full, its
+ * layer count fits arrayBudget bytes (at least 1, at most maxLayers) : the storage is allocated once and not
+ * resized. A released texture gives its layer back to its array.
+ * - No GPU call here : the backend creates the arrays and copies the layers through the callbacks (see OpenGLAPI).
+ * @version 0.1
+ * @date 2025-12-14
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+#ifndef TEXTUREARRAYPACKER_H
+#define TEXTUREARRAYPACKER_H
+
+#include "Common/dllExport.h"
+#include "PulseEngine/core/Graphics/IGraphicsApi.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <unordered_map>
+#include <vector>
+
+namespace PulseEngine::Graphics
+{
+    /**
+     * @brief Size and format of every layer of an array, as the backend reads them from the texture.
+     */
+    struct TextureArrayFormat
+    {
+        int width = 0;
+        int height = 0;
+        unsigned int internalFormat = 0;    ///< backend enum, sized
+        int levels = 1;
+        std::size_t layerBytes = 0;         ///< every level of one layer
+
+        bool operator==(const TextureArrayFormat& other) const
+        {
+            return width == other.width && height == other.height && internalFormat == other.internalFormat && levels == other.levels;
+        }
+    };
+
+    struct TextureArrayStats
+    {
+        std::size_t arrays = 0;
+        std::size_t packedTextures = 0;
+        std::size_t layers = 0;             ///< allocated, used or not
+        std::size_t bytes = 0;
+    };
+
+    class PULSE_ENGINE_DLL_API TextureArrayPacker
+    {
+    public:
+        /// @brief Create an array of layers layers, returns its handle, 0 on failure.
+        using CreateArrayCallback = std::function<unsigned int(const TextureArrayFormat& format, int layers)>;
+        /// @brief Copy every level of texture in the layer of array.
+        using CopyLayerCallback = std::function<void(unsigned int texture, const TextureArrayFormat& format, unsigned int array, int layer)>;
+        using DeleteArrayCallback = std::function<void(unsigned int array)>;
+
+        void Initialize(std::size_t arrayBudget, int maxLayers, CreateArrayCallback createArray, CopyLayerCallback copyLayer,
+                        DeleteArrayCallback deleteArray);
+        /// @brief Delete every array, the textures are to be packed again.
+        void Shutdown();
+
+        bool IsInitialized() const { return static_cast<bool>(createArray); }
+
+        /// @brief The slot of a texture already packed, invalid otherwise.
+        TextureArraySlot Find(unsigned int texture) const;
+
+        /**
+         * @brief Copy texture in a free layer of an array of its format (a new one when they are full).
+         * @return its slot, invalid when the array couldn't be created.
+         */
+        TextureArraySlot Pack(unsigned int texture, const TextureArrayFormat& format);
+
+        /// @brief The texture is deleted : its layer is free again. Nothing when it wasn't packed.
+        void Release(unsigned int texture);
+
+        const TextureArrayStats& GetStats() const { return stats; }
+
+    private:
+        struct PackedArray
+        {
+            TextureArrayFormat format;
+            unsigned int handle = 0;
+            int layers = 0;
+            int used = 0;                   ///< layers handed out once, from 0
+            std::vector<int> freeLayers;    ///< released, reused first
+        };
+
+        std::size_t arrayBudget = 0;
+        int maxLayers = 1;
+        CreateArrayCallback createArray;
+        CopyLayerCallback copyLayer;
+        DeleteArrayCallback deleteArray;
+
+        std::vector<PackedArray> arrays;
+        std::unordered_map<unsigned int, TextureArraySlot> slots;          ///< by texture
+        std::unordered_map<unsigned int, std::size_t> arrayIndices;        ///< in arrays, by handle
+        TextureArrayStats stats;
+    };
+}
+
+#endif // TEXTUREARRAYPACKER_H
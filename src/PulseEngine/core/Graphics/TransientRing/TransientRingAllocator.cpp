@@ -0,0 +1,121 @@
+#include "TransientRingAllocator.h"
+
+using namespace PulseEngine::Graphics;
+
+void TransientRingAllocator::Initialize(std::size_t capacity, std::uint32_t partitionCount, FenceCallback placeFence, FenceCallback waitFence)
+{
+    this->partitionCount = partitionCount > 0 ? partitionCount : 1;
+    partitionSize = capacity / this->partitionCount;
+    this->placeFence = std::move(placeFence);
+    this->waitFence = std::move(waitFence);
+
+    fenced.assign(this->partitionCount, false);
+    first = 0;
+    current = 0;
+    head = 0;
+    frameOpen = true;
+    growths = 0;
+    frameStats = TransientRingStats();
+    lastFrameStats = TransientRingStats();
+}
+
+void TransientRingAllocator::BeginFrame()
+{
+    if (partitionCount == 0) return;
+    if (frameOpen) EndFrame();
+
+    lastFrameStats = frameStats;
+    frameStats = TransientRingStats();
+
+    current = (current + 1) % partitionCount;
+    first = current;
+    Reclaim(current);
+    head = 0;
+    frameOpen = true;
+}
+
+void TransientRingAllocator::EndFrame()
+{
+    if (!frameOpen) return;
+    frameOpen = false;
+
+    // a part nothing was written to has nothing for the GPU to finish
+    if (frameStats.allocations == 0) return;
+    for (std::uint32_t part = first; ; part = (part + 1) % partitionCount)
+    {
+        if (placeFence) placeFence(part);
+        fenced[part] = true;
+        if (part == current) break;
+    }
+}
+
+std::size_t TransientRingAllocator::Allocate(std::size_t size, std::size_t alignment)
+{
+    if (!frameOpen || size == 0)
+    {
+        frameStats.failedAllocations++;
+        return INVALID_OFFSET;
+    }
+    if (alignment == 0) alignment = 1;
+
+    for (;;)
+    {
+        // aligned in the whole buffer : the parts don't start on a multiple of every alignment
+        const std::size_t base = static_cast<std::size_t>(current) * partitionSize;
+        const std::size_t offset = (base + head + alignment - 1) / alignment * alignment;
+        const std::size_t end = offset - base + size;
+        if (end <= partitionSize)
+        {
+            frameStats.allocations++;
+            frameStats.allocatedBytes += end - head;
+            head = end;
+            return offset;
+        }
+
+        // larger than a part, or the frame would write over its own first part
+        const std::uint32_t next = (current + 1) % partitionCount;
+        if (head == 0 || size > partitionSize || next == first)
+        {
+            frameStats.failedAllocations++;
+            frameStats.overflowBytes += size;
+            return INVALID_OFFSET;
+        }
+        Reclaim(next);
+        current = next;
+        head = 0;
+        frameStats.spilledParts++;
+    }
+}
+
+std::size_t TransientRingAllocator::GetGrowthSize(std::size_t maxPartitionSize) const
+{
+    if (frameStats.spilledParts == 0 && frameStats.overflowBytes == 0) return 0;
+
+    const std::uint64_t needed = frameStats.allocatedBytes + frameStats.overflowBytes;
+    std::size_t size = partitionSize > 0 ? partitionSize : 1;
+    while (size < needed && size < maxPartitionSize) size *= 2;
+    if (size > maxPartitionSize) size = maxPartitionSize;
+    return size > partitionSize ? size : 0;
+}
+
+void TransientRingAllocator::Resize(std::size_t partitionSize)
+{
+    if (frameOpen || partitionCount == 0) return;
+
+    // the GPU may still read any part : done with all of them before the backend drops its buffer
+    for (std::uint32_t part = 0; part < partitionCount; ++part) Reclaim(part);
+
+    this->partitionSize = partitionSize;
+    current = partitionCount - 1;
+    first = current;
+    head = 0;
+    growths++;
+}
+
+void TransientRingAllocator::Reclaim(std::uint32_t part)
+{
+    if (!fenced[part]) return;
+    if (waitFence) waitFence(part);
+    fenced[part] = false;
+    frameStats.fenceWaits++;
+}
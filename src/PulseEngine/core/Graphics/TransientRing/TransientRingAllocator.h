@@ -0,0 +1,115 @@
+/**
+ * @file TransientRingAllocator.h
+ * @brief Frame partitioned ring of a GPU buffer : the offsets of the data written once and read by the draws of one
+ * frame (glyph quads, debug lines, per frame shader data).
+ * @details The buffer is cut in partitionCount equal parts, one per frame in flight. A frame allocates forward in its
+ * part, nothing is freed : BeginFrame moves to the next part and starts it empty. The GPU may still read a part the
+ * frames before wrote, so EndFrame asks the backend to place a fence after the last draw of the frame, and BeginFrame
+ * waits for the fence of the part it reuses.
+ * - No GPU call here : the backend places and waits the fences through the callbacks, and writes the bytes at the
+ *   returned offset (see GLTransientRing). The allocation and fencing logic runs the same without a GPU.
+ * - A frame that fills its part spills into the next one, once its fence is waited : the allocations don't cross a
+ *   part, the end of the full one stays unused. INVALID_OFFSET only comes when every part is taken by the frame or
+ *   the request is larger than a part (counted in overflowBytes).
+ * - A frame that spilled or overflowed asks for larger parts (GetGrowthSize) : the backend calls Resize between two
+ *   frames and makes a new buffer, nothing is reallocated in the middle of a frame.
+ * @version 0.1
+ * @date 2025-12-14
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+#ifndef TRANSIENTRINGALLOCATOR_H
+#define TRANSIENTRINGALLOCATOR_H
+
+#include "Common/dllExport.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+namespace PulseEngine::Graphics
+{
+    struct TransientRingStats
+    {
+        std::uint64_t allocations = 0;
+        std::uint64_t allocatedBytes = 0;       ///< alignment padding included
+        std::uint64_t failedAllocations = 0;
+        std::uint64_t overflowBytes = 0;        ///< requested by the allocations that failed for lack of room
+        std::uint64_t spilledParts = 0;         ///< parts taken after the first one of the frame
+        std::uint64_t fenceWaits = 0;           ///< parts the frame had to wait for before writing them
+    };
+
+    class PULSE_ENGINE_DLL_API TransientRingAllocator
+    {
+    public:
+        static constexpr std::size_t INVALID_OFFSET = static_cast<std::size_t>(-1);
+        using FenceCallback = std::function<void(std::uint32_t partition)>;
+
+        /**
+         * @brief Cut capacity bytes in partitionCount parts, the first frame is open on part 0.
+         * @param placeFence called by EndFrame : the GPU signals it once it is done with the part
+         * @param waitFence called by BeginFrame before a fenced part is reused, returns once it is signaled
+         */
+        void Initialize(std::size_t capacity, std::uint32_t partitionCount, FenceCallback placeFence, FenceCallback waitFence);
+
+        /**
+         * @brief Open the next part, once its fence is waited. Closes the current frame if EndFrame wasn't called.
+         */
+        void BeginFrame();
+
+        /**
+         * @brief Fence the part of the frame, no allocation until the next BeginFrame.
+         */
+        void EndFrame();
+
+        /**
+         * @return the offset in the whole buffer, a multiple of alignment (any value, not only powers of two : a vertex
+         * stride works), INVALID_OFFSET when no frame is open, when size (aligned) is larger than a part, or when the
+         * frame already took every part.
+         */
+        std::size_t Allocate(std::size_t size, std::size_t alignment = 1);
+
+        /**
+         * @brief Between EndFrame and BeginFrame : the part size the frame just closed needed, a power of two up to
+         * maxPartitionSize, 0 when it fit in one part or the parts are already that large.
+         */
+        std::size_t GetGrowthSize(std::size_t maxPartitionSize) const;
+
+        /**
+         * @brief Between EndFrame and BeginFrame : wait every fence, then cut partitionSize * partitionCount bytes.
+         * The backend replaces its buffer, the next BeginFrame opens part 0.
+         */
+        void Resize(std::size_t partitionSize);
+
+        std::size_t GetCapacity() const { return partitionSize * partitionCount; }
+        std::size_t GetPartitionSize() const { return partitionSize; }
+        std::uint32_t GetCurrentPartition() const { return current; }
+        std::uint32_t GetGrowthCount() const { return growths; }
+
+        const TransientRingStats& GetFrameStats() const { return frameStats; }
+        const TransientRingStats& GetLastFrameStats() const { return lastFrameStats; }
+
+    private:
+        std::size_t partitionSize = 0;
+        std::uint32_t partitionCount = 0;
+        std::uint32_t first = 0;                ///< part the frame started in
+        std::uint32_t current = 0;              ///< last part the frame took
+        std::size_t head = 0;                   ///< in the current part
+        bool frameOpen = false;
+        std::uint32_t growths = 0;
+        std::vector<bool> fenced;               ///< by part : a fence was placed and not waited yet
+
+        FenceCallback placeFence;
+        FenceCallback waitFence;
+
+        /// @brief Wait the fence of part if it has one.
+        void Reclaim(std::uint32_t part);
+
+        TransientRingStats frameStats;
+        TransientRingStats lastFrameStats;
+    };
+}
+
+#endif // TRANSIENTRINGALLOCATOR_H
@@ -1,43 +1,146 @@
 #include "DirectionalLight.h"
+#include "ShadowCascades.h"
 #include "PulseEngine/core/Entity/Entity.h"
 #include "PulseEngine/core/Math/MathUtils.h"
+#include "PulseEngine/core/Math/Frustum/Frustum.h"
 #include "PulseEngine/core/Graphics/IGraphicsApi.h"
 #include "PulseEngine/core/FileManager/Archive/Archive.h"
+#include "PulseEngine/core/Threading/GraphicsThread.h"
+
+#include <algorithm>
 
 PULSE_REGISTER_CLASS_CPP(DirectionalLight)
 
-void DirectionalLight::InitShadowMap(int resolution)
+namespace
 {
-    PulseEngineGraphicsAPI->GenerateShadowMap(&depthMapTex, &depthMapFBO, DEFAULT_SHADOW_MAP_RES, DEFAULT_SHADOW_MAP_RES);
+    const char* const CASCADE_MATRIX_NAMES[DirectionalLight::MAX_CASCADES] = {
+        "cascadeMatrices[0]", "cascadeMatrices[1]", "cascadeMatrices[2]", "cascadeMatrices[3]"
+    };
+    const char* const CASCADE_SPLIT_NAMES[DirectionalLight::MAX_CASCADES] = {
+        "cascadeSplits[0]", "cascadeSplits[1]", "cascadeSplits[2]", "cascadeSplits[3]"
+    };
 }
 
-void DirectionalLight::RenderShadowMap(Shader &shader, PulseEngineBackend &scene)
+void DirectionalLight::InitShadowMap(int resolution, int count)
 {
-    PulseEngineGraphicsAPI->BindShadowFramebuffer(&depthMapFBO);
-    RecalculateLightSpaceMatrix();
-    shader.SetVec3("lightPos", transform.position);
-    shader.SetVec3("target", target);
-    for (Entity* obj : scene.entities)
+    shadowResolution = resolution;
+    if (!PulseEngine::Threading::IsGraphicsThread()) return;
+    for (int i = 0; i < std::clamp(count, 1, MAX_CASCADES); ++i)
     {
-        obj->DrawMeshWithShader(&shader);
+        ShadowCascade& cascade = cascades[i];
+        if (cascade.depthMapFBO) continue;
+        PulseEngineGraphicsAPI->GenerateShadowMap(&cascade.depthMapTex, &cascade.depthMapFBO, resolution, resolution);
     }
+}
+
+void DirectionalLight::RenderShadowMap(Shader &shader, const RenderSnapshot& snapshot, const RenderLight& params)
+{
+    if (!params.castsShadow) return;
+
+    const int count = std::clamp(params.cascadeCount, 1, MAX_CASCADES);
+    InitShadowMap(shadowResolution, count);
+
+    const PulseEngine::Vector3 lightDirection = (params.target - params.position).Normalized();
+    const PulseEngine::Mat4& cameraView = snapshot.view.view;
+    const PulseEngine::Mat4& cameraProjection = snapshot.view.projection;
+    const float casterDistance = params.farPlane;
+    float cameraNear, cameraFar;
+    PulseEngine::ShadowCascades::GetPerspectivePlanes(cameraProjection, cameraNear, cameraFar);
+    const std::vector<float> splits = PulseEngine::ShadowCascades::ComputeSplits(count, cameraNear, cameraFar, params.shadowDistance, params.cascadeSplitLambda);
+
+    // the point lights use their own shader between two directional lights
+    shader.Use();
+
+    const std::uint64_t frame = shadowFrame++;
+    float splitNear = cameraNear;
+    for (int i = 0; i < count; ++i)
+    {
+        ShadowCascade& cascade = cascades[i];
+        const float splitFar = splits[i];
+        const float sliceNear = splitNear;
+        splitNear = splitFar;
+
+        // a far cascade covers more ground with the same texels : drawn one frame out of 2^i, staggered.
+        // The shader keeps the split and the matrix the map was drawn with until then.
+        if (cascade.splitFar > 0.0f && (frame + i) % (1ull << i) != 0) continue;
+
+        const PulseEngine::ShadowCascades::CascadeBounds bounds = PulseEngine::ShadowCascades::ComputeCascade(
+            cameraView, cameraProjection, sliceNear, splitFar, lightDirection, shadowResolution, casterDistance);
+
+        Frustum lightVolume;
+        lightVolume.ExtractFromMatrix(bounds.viewProjection);
+        auto inCascade = [&lightVolume](const AABB& worldBounds) { return lightVolume.IntersectsAABB(worldBounds); };
 
-    PulseEngineGraphicsAPI->UnbindShadowFramebuffer();
+        // the snapped center only moves a texel at a time : a still camera redraws nothing
+        const std::uint64_t key = ShadowCasterCache::HashFloats({ bounds.grid.x, bounds.grid.y, bounds.grid.z, bounds.radius,
+                                                                  lightDirection.x, lightDirection.y, lightDirection.z, casterDistance });
+        cascade.splitFar = splitFar;
+        cascade.lightSpaceMatrix = bounds.viewProjection;
+        if (!cascade.casters.Update(snapshot, key, inCascade)) continue;
+
+        const bool layered = cascade.casters.UsesStaticLayer();
+        if (layered && !cascade.staticLayerFBO)
+        {
+            PulseEngineGraphicsAPI->GenerateShadowMap(&cascade.staticLayerTex, &cascade.staticLayerFBO, shadowResolution, shadowResolution);
+        }
+
+        shader.SetMat4("lightSpaceMatrix", cascade.lightSpaceMatrix);
+
+        if (cascade.casters.NeedsStaticRebuild())
+        {
+            PulseEngineGraphicsAPI->BindShadowFramebuffer(layered ? &cascade.staticLayerFBO : &cascade.depthMapFBO);
+            for (const RenderObject* caster : cascade.casters.GetStaticCasters())
+            {
+                snapshot.DrawObject(*caster, &shader, false);
+            }
+            PulseEngineGraphicsAPI->UnbindShadowFramebuffer();
+        }
+
+        if (layered)
+        {
+            PulseEngineGraphicsAPI->CopyShadowMap(cascade.staticLayerTex, cascade.depthMapTex, shadowResolution, false);
+            PulseEngineGraphicsAPI->BindShadowFramebuffer(&cascade.depthMapFBO, false);
+            for (const RenderObject* caster : cascade.casters.GetDynamicCasters())
+            {
+                snapshot.DrawObject(*caster, &shader, false);
+            }
+            PulseEngineGraphicsAPI->UnbindShadowFramebuffer();
+        }
+    }
 }
 
-void DirectionalLight::BindToShader(Shader &shader, int index)
+void DirectionalLight::BindToShader(Shader &shader, const RenderLight& params, int index)
 {
     
-    PulseEngine::Vector3 direction = (target - transform.position).Normalized();
+    PulseEngine::Vector3 direction = (params.target - params.position).Normalized();
     
     shader.SetVec3("dirLight.direction", direction);
-    shader.SetVec3("dirLight.color", PulseEngine::Vector3(color.r, color.g, color.b));
-    shader.SetFloat("dirLight.intensity", intensity);
-    shader.SetBool("dirLight.castsShadow", true);
-    shader.SetVec3("dirLight.target", target);
-    shader.SetVec3("dirLight.position", transform.position);
-    shader.SetFloat("dirLight.near", nearPlane);
-    shader.SetFloat("dirLight.far", farPlane);
+    shader.SetVec3("dirLight.color", params.color);
+    shader.SetFloat("dirLight.intensity", params.intensity);
+    shader.SetBool("dirLight.castsShadow", params.castsShadow);
+    shader.SetVec3("dirLight.target", params.target);
+    shader.SetVec3("dirLight.position", params.position);
+    shader.SetFloat("dirLight.near", params.nearPlane);
+    shader.SetFloat("dirLight.far", params.farPlane);
+
+    const int count = std::clamp(params.cascadeCount, 1, MAX_CASCADES);
+    shader.SetInt("cascadeCount", count);
+    for (int i = 0; i < count; ++i)
+    {
+        shader.SetMat4(CASCADE_MATRIX_NAMES[i], cascades[i].lightSpaceMatrix);
+        shader.SetFloat(CASCADE_SPLIT_NAMES[i], cascades[i].splitFar);
+    }
+}
+
+void DirectionalLight::CaptureRenderLight(RenderLight& params) const
+{
+    LightData::CaptureRenderLight(params);
+    params.target = target;
+    params.nearPlane = nearPlane;
+    params.farPlane = farPlane;
+    params.cascadeCount = cascadeCount;
+    params.shadowDistance = shadowDistance;
+    params.cascadeSplitLambda = cascadeSplitLambda;
 }
 
 void DirectionalLight::RecalculateLightSpaceMatrix()
@@ -10,7 +10,8 @@
  * light-space transformation calculations.
  * 
  * Features:
- * - Orthographic shadow mapping support.
+ * - Cascaded shadow maps : the camera frustum is split in cascadeCount slices up to shadowDistance, each with its
+ *   own texel snapped orthographic map (see ShadowCascades.h), far cascades drawn again less often.
  * - Configurable near and far plane for shadow frustum.
  * - Automatic computation of the light-space matrix based on direction and target.
  * 
@@ -28,8 +29,10 @@
  *      0.0f                                    // Attenuation (unused for directional lights)
  *  );
  *  
- *  sun.RenderShadowMap(shader, scene);
- *  sun.BindToShader(shader, 0);
+ *  RenderLight params;
+ *  sun.CaptureRenderLight(params);
+ *  sun.RenderShadowMap(shader, snapshot, params);
+ *  sun.BindToShader(shader, params, 0);
  * @endcode
  * 
  * @note Directional lights do not attenuate with distance and are defined
@@ -56,6 +59,8 @@
 #include "PulseEngine/core/Lights/Lights.h"
 #include "Common/dllExport.h"
 
+#include <array>
+
 class PulseEngineBackend;
 
 /**
@@ -74,11 +79,30 @@ class PULSE_ENGINE_DLL_API DirectionalLight : public LightData
 public:
     PulseEngine::Vector3 direction; ///< Light direction vector, normalized.
 
-    unsigned int depthMapFBO; ///< Framebuffer object used for shadow map rendering.
-    unsigned int depthMapTex; ///< Texture handle for the depth map.
+    static constexpr int MAX_CASCADES = 4; ///< must match basic.frag
+
+    /**
+     * @brief One slice of the camera frustum and its shadow map.
+     */
+    struct ShadowCascade
+    {
+        unsigned int depthMapFBO = 0;     ///< Framebuffer object used for shadow map rendering.
+        unsigned int depthMapTex = 0;     ///< Texture handle for the depth map.
+        unsigned int staticLayerFBO = 0;  ///< Static casters only, created with the first dynamic caster in range.
+        unsigned int staticLayerTex = 0;  ///< Depth of the static layer, copied under the dynamic casters.
+
+        PulseEngine::Mat4 lightSpaceMatrix; ///< The map was drawn with it : the shader samples with it too.
+        float splitFar = 0.0f;              ///< View depth where the cascade ends.
+        ShadowCasterCache casters;          ///< Culled against the box of the cascade.
+    };
 
-    float nearPlane; ///< Near plane distance for shadow projection.
-    float farPlane;  ///< Far plane distance for shadow projection.
+    std::array<ShadowCascade, MAX_CASCADES> cascades;
+    int cascadeCount = 3;               ///< 1 to MAX_CASCADES.
+    float shadowDistance = 100.0f;      ///< No shadow past this view depth.
+    float cascadeSplitLambda = 0.75f;   ///< 0 : uniform splits, 1 : logarithmic splits.
+
+    float nearPlane = 0.1f; ///< Near plane distance for shadow projection.
+    float farPlane = 40.0f; ///< Casters this far before a cascade, toward the light, still throw their shadow in it.
     PulseEngine::Vector3 target; ///< Target point the light is oriented toward.
 
     /**
@@ -102,40 +126,50 @@ public:
         float a
     ) : LightData(p, c, i, a), nearPlane(np), farPlane(fp), target(t)
     {
-        InitShadowMap(2048);
+        InitShadowMap(2048, cascadeCount);
         RecalculateLightSpaceMatrix();
         SetName("Directional Light");
     }
 
     DirectionalLight() : LightData() 
     {
-        InitShadowMap(2048);
+        InitShadowMap(2048, cascadeCount);
         RecalculateLightSpaceMatrix();
         SetName("Directional Light");
     }
 
     /**
-     * @brief Initializes the shadow map resources (FBO and depth texture).
+     * @brief Initializes the shadow map resources (FBO and depth texture) of the first count cascades, the
+     * others are created when cascadeCount grows. Off the graphics thread only the resolution is kept, the maps
+     * are created by the first shadow pass.
      * 
      * @param resolution Shadow map resolution (e.g., 1024, 2048).
      */
-    void InitShadowMap(int resolution);
+    void InitShadowMap(int resolution, int count);
 
     /**
-     * @brief Renders the depth map from the light's perspective.
+     * @brief Renders the depth map of each cascade from the light's perspective, around the camera of the
+     * snapshot. Cascade i is drawn again one frame out of 2^i.
      * 
      * @param shader The shader used for shadow pass rendering.
-     * @param scene Reference to the scene backend for geometry traversal.
+     * @param snapshot The frame to draw : camera and shadow casters.
+     * @param params This light, as captured in snapshot.
      */
-    void RenderShadowMap(Shader& shader, PulseEngineBackend& scene) override;
+    void RenderShadowMap(Shader& shader, const RenderSnapshot& snapshot, const RenderLight& params) override;
 
     /**
      * @brief Binds light properties and shadow map to the provided shader.
      * 
      * @param shader Target shader program.
+     * @param params This light, as captured in the render snapshot.
      * @param index Light index in shader uniform array.
      */
-    void BindToShader(Shader& shader, int index) override;
+    void BindToShader(Shader& shader, const RenderLight& params, int index) override;
+
+    /**
+     * @brief Copies the light and its cascade settings in the render snapshot.
+     */
+    void CaptureRenderLight(RenderLight& params) const override;
 
     /**
      * @brief Recalculates the light-space transformation matrix.
@@ -145,6 +179,10 @@ public:
      * projection space and is used during shadow map rendering.
      */
     void RecalculateLightSpaceMatrix() override;
+
+private:
+    int shadowResolution = 0;           ///< set by InitShadowMap
+    std::uint64_t shadowFrame = 0;
 };
 
 #endif // DIRECTIONAL_LIGHT_H
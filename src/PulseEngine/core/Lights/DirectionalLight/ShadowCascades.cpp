@@ -0,0 +1,104 @@
+#include "ShadowCascades.h"
+#include "PulseEngine/core/Math/MathUtils.h"
+
+#include <algorithm>
+#include <cmath>
+
+using PulseEngine::Mat4;
+using PulseEngine::Vector3;
+
+namespace
+{
+    // data[column][row], the layout the shaders get
+    Vector3 TransformPoint(const Mat4& matrix, const Vector3& point)
+    {
+        return Vector3(
+            matrix.data[0][0] * point.x + matrix.data[1][0] * point.y + matrix.data[2][0] * point.z + matrix.data[3][0],
+            matrix.data[0][1] * point.x + matrix.data[1][1] * point.y + matrix.data[2][1] * point.z + matrix.data[3][1],
+            matrix.data[0][2] * point.x + matrix.data[1][2] * point.y + matrix.data[2][2] * point.z + matrix.data[3][2]);
+    }
+
+    // the radius is rounded up so the float noise of the corners doesn't change the texel size between frames
+    constexpr float RADIUS_STEP = 1.0f / 16.0f;
+}
+
+void PulseEngine::ShadowCascades::GetPerspectivePlanes(const Mat4& projection, float& nearPlane, float& farPlane)
+{
+    const float p22 = projection.data[2][2];
+    const float p32 = projection.data[3][2];
+    nearPlane = p32 / (p22 - 1.0f);
+    farPlane = p32 / (p22 + 1.0f);
+}
+
+std::vector<float> PulseEngine::ShadowCascades::ComputeSplits(int count, float nearPlane, float farPlane, float shadowDistance, float lambda)
+{
+    std::vector<float> splits(std::max(count, 0));
+    const float last = std::max(std::min(farPlane, shadowDistance), nearPlane);
+
+    for (int i = 0; i < count; ++i)
+    {
+        const float ratio = static_cast<float>(i + 1) / static_cast<float>(count);
+        const float logarithmic = nearPlane * std::pow(last / nearPlane, ratio);
+        const float uniform = nearPlane + (last - nearPlane) * ratio;
+        splits[i] = lambda * logarithmic + (1.0f - lambda) * uniform;
+    }
+    return splits;
+}
+
+PulseEngine::ShadowCascades::CascadeBounds PulseEngine::ShadowCascades::ComputeCascade(const Mat4& cameraView, const Mat4& cameraProjection,
+                                                                                       float splitNear, float splitFar, const Vector3& lightDirection,
+                                                                                       int resolution, float casterDistance)
+{
+    const Mat4 inverseView = PulseEngine::MathUtils::Matrix::Inverse(cameraView);
+    const float p00 = cameraProjection.data[0][0];
+    const float p11 = cameraProjection.data[1][1];
+    const float p20 = cameraProjection.data[2][0];
+    const float p21 = cameraProjection.data[2][1];
+
+    // the 8 corners of the slice : ndc = proj * v / depth - offset, so v = (ndc + offset) * depth / proj
+    Vector3 corners[8];
+    int cornerCount = 0;
+    for (float depth : { splitNear, splitFar })
+    {
+        for (float nx : { -1.0f, 1.0f })
+        {
+            for (float ny : { -1.0f, 1.0f })
+            {
+                const Vector3 viewCorner((nx + p20) * depth / p00, (ny + p21) * depth / p11, -depth);
+                corners[cornerCount++] = TransformPoint(inverseView, viewCorner);
+            }
+        }
+    }
+
+    Vector3 center(0.0f);
+    for (const Vector3& corner : corners) center = center + corner;
+    center = center * (1.0f / 8.0f);
+
+    float radius = 0.0f;
+    for (const Vector3& corner : corners) radius = std::max(radius, (corner - center).GetMagnitude());
+
+    // snapping moves the center up to a texel on each axis : 1.5 texels of margin keep the sphere in the box
+    const float texels = static_cast<float>(std::max(resolution, 4));
+    radius = std::ceil(radius * texels / (texels - 3.0f) / RADIUS_STEP) * RADIUS_STEP;
+
+    // fixed basis of the light, the center moves on its texel grid only
+    const Vector3 forward = lightDirection.Normalized();
+    const Vector3 upReference = std::fabs(forward.y) > 0.99f ? Vector3(0.0f, 0.0f, 1.0f) : Vector3(0.0f, 1.0f, 0.0f);
+    const Vector3 side = forward.Cross(upReference).Normalized();
+    const Vector3 up = side.Cross(forward);
+
+    // the depth is snapped too : a camera moving less than a texel gives the same matrix, the cache keeps the map
+    const float texelSize = 2.0f * radius / texels;
+    CascadeBounds cascade;
+    cascade.grid = Vector3(std::floor(center.Dot(side) / texelSize),
+                           std::floor(center.Dot(up) / texelSize),
+                           std::floor(center.Dot(forward) / texelSize));
+    cascade.center = (side * cascade.grid.x + up * cascade.grid.y + forward * cascade.grid.z) * texelSize;
+    cascade.radius = radius;
+
+    const Vector3 eye = cascade.center - forward * (radius + casterDistance);
+    const Mat4 lightView = PulseEngine::MathUtils::Matrix::LookAt(eye, cascade.center, upReference);
+    const Mat4 lightProjection = PulseEngine::MathUtils::Matrix::Orthographic(-radius, radius, -radius, radius, 0.0f, 2.0f * radius + casterDistance);
+    cascade.viewProjection = lightProjection * lightView;
+    return cascade;
+}
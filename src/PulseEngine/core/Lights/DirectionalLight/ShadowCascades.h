@@ -0,0 +1,55 @@
+/**
+ * @file ShadowCascades.h
+ * @brief Split the camera frustum in depth slices and fit one stable orthographic shadow map on each (cascaded
+ * shadow maps of DirectionalLight).
+ * @details
+ * - Splits : the practical scheme, a blend of uniform and logarithmic distances (lambda), up to shadowDistance.
+ * - Each cascade wraps the bounding sphere of its slice, so its size doesn't change when the camera turns, and its
+ *   center is snapped to the texel grid of the light : a moving camera doesn't make the shadow edges shimmer.
+ * - The orthographic box starts casterDistance before the sphere, toward the light, for the casters out of view.
+ * @version 0.1
+ * @date 2025-12-14
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+#ifndef SHADOWCASCADES_H
+#define SHADOWCASCADES_H
+
+#include "Common/dllExport.h"
+#include "PulseEngine/core/Math/Vector.h"
+#include "PulseEngine/core/Math/Mat4.h"
+
+#include <vector>
+
+namespace PulseEngine::ShadowCascades
+{
+    struct CascadeBounds
+    {
+        PulseEngine::Mat4 viewProjection;   ///< world to light clip space, what the depth pass and the shader use
+        PulseEngine::Vector3 center;        ///< snapped, world space
+        PulseEngine::Vector3 grid;          ///< center in whole texels along the light axes : exact, a cache key
+        float radius = 0.0f;
+    };
+
+    /**
+     * @brief View depth where each cascade ends, count values. near and far are the camera planes, far is clamped
+     * to shadowDistance.
+     * @param lambda 0 : uniform splits, 1 : logarithmic splits
+     */
+    PULSE_ENGINE_DLL_API std::vector<float> ComputeSplits(int count, float nearPlane, float farPlane, float shadowDistance, float lambda);
+
+    /**
+     * @brief Fit the cascade covering the view depths [splitNear, splitFar] of the camera.
+     * @param lightDirection from the light toward the scene
+     * @param resolution of the shadow map, in texels, for the snapping
+     */
+    PULSE_ENGINE_DLL_API CascadeBounds ComputeCascade(const PulseEngine::Mat4& cameraView, const PulseEngine::Mat4& cameraProjection,
+                                                      float splitNear, float splitFar, const PulseEngine::Vector3& lightDirection,
+                                                      int resolution, float casterDistance);
+
+    /// @brief Camera near and far planes read back from a perspective projection.
+    PULSE_ENGINE_DLL_API void GetPerspectivePlanes(const PulseEngine::Mat4& projection, float& nearPlane, float& farPlane);
+}
+
+#endif // SHADOWCASCADES_H
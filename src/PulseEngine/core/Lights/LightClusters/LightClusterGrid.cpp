@@ -0,0 +1,226 @@
+#include "LightClusterGrid.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+using PulseEngine::Mat4;
+using PulseEngine::Vector3;
+
+namespace
+{
+    std::uint32_t TileOf(float ndc, std::uint32_t count)
+    {
+        const float tile = std::floor((ndc * 0.5f + 0.5f) * static_cast<float>(count));
+        if (tile <= 0.0f) return 0;
+        return std::min(static_cast<std::uint32_t>(tile), count - 1);
+    }
+}
+
+LightClusterGrid::LightClusterGrid()
+{
+    bounds.resize(CLUSTER_COUNT);
+    clusters.assign(CLUSTER_COUNT * 2, 0u);
+    counts.resize(CLUSTER_COUNT);
+    cursor.resize(CLUSTER_COUNT);
+}
+
+Vector3 LightClusterGrid::ToViewSpace(const Mat4& view, const Vector3& point)
+{
+    // data[column][row], the layout the shaders get
+    return Vector3(
+        view.data[0][0] * point.x + view.data[1][0] * point.y + view.data[2][0] * point.z + view.data[3][0],
+        view.data[0][1] * point.x + view.data[1][1] * point.y + view.data[2][1] * point.z + view.data[3][1],
+        view.data[0][2] * point.x + view.data[1][2] * point.y + view.data[2][2] * point.z + view.data[3][2]);
+}
+
+std::uint32_t LightClusterGrid::SliceOf(float viewDepth) const
+{
+    if (viewDepth <= nearPlane) return 0;
+    const float slice = std::log(viewDepth) * sliceScale + sliceBias;
+    if (slice <= 0.0f) return 0;
+    return std::min(static_cast<std::uint32_t>(slice), COUNT_Z - 1);
+}
+
+void LightClusterGrid::UpdateClusterBounds(const Mat4& projection, int viewportWidth, int viewportHeight)
+{
+    const float p00 = projection.data[0][0];
+    const float p11 = projection.data[1][1];
+    const float p20 = projection.data[2][0];
+    const float p21 = projection.data[2][1];
+    const float p22 = projection.data[2][2];
+    const float p32 = projection.data[3][2];
+    const float newNear = p32 / (p22 - 1.0f);
+    const float newFar = p32 / (p22 + 1.0f);
+
+    if (p00 == projX && p11 == projY && p20 == offsetX && p21 == offsetY &&
+        newNear == nearPlane && newFar == farPlane && viewportWidth == width && viewportHeight == height)
+        return;
+
+    projX = p00;
+    projY = p11;
+    offsetX = p20;
+    offsetY = p21;
+    nearPlane = newNear;
+    farPlane = newFar;
+    width = viewportWidth;
+    height = viewportHeight;
+
+    tileWidth = static_cast<float>(width) / static_cast<float>(COUNT_X);
+    tileHeight = static_cast<float>(height) / static_cast<float>(COUNT_Y);
+
+    const float logRatio = std::log(farPlane / nearPlane);
+    sliceScale = static_cast<float>(COUNT_Z) / logRatio;
+    sliceBias = -static_cast<float>(COUNT_Z) * std::log(nearPlane) / logRatio;
+
+    for (std::uint32_t z = 0; z < COUNT_Z; ++z)
+    {
+        const float depths[2] = {
+            nearPlane * std::pow(farPlane / nearPlane, static_cast<float>(z) / COUNT_Z),
+            nearPlane * std::pow(farPlane / nearPlane, static_cast<float>(z + 1) / COUNT_Z)
+        };
+
+        for (std::uint32_t y = 0; y < COUNT_Y; ++y)
+        {
+            const float ndcY[2] = { -1.0f + 2.0f * y / COUNT_Y, -1.0f + 2.0f * (y + 1) / COUNT_Y };
+
+            for (std::uint32_t x = 0; x < COUNT_X; ++x)
+            {
+                const float ndcX[2] = { -1.0f + 2.0f * x / COUNT_X, -1.0f + 2.0f * (x + 1) / COUNT_X };
+
+                // the 8 corners of the froxel : ndc = proj * v / depth - offset, so v = (ndc + offset) * depth / proj
+                ClusterBounds& cluster = bounds[x + COUNT_X * (y + COUNT_Y * z)];
+                cluster.min = Vector3( std::numeric_limits<float>::max());
+                cluster.max = Vector3(-std::numeric_limits<float>::max());
+                for (float depth : depths)
+                {
+                    for (float nx : ndcX)
+                    {
+                        for (float ny : ndcY)
+                        {
+                            const Vector3 corner((nx + p20) * depth / p00, (ny + p21) * depth / p11, -depth);
+                            cluster.min = cluster.min.Min(corner);
+                            cluster.max = cluster.max.Max(corner);
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
+
+void LightClusterGrid::Build(const std::vector<ClusterLight>& lights, const Mat4& view, const Mat4& projection, int viewportWidth, int viewportHeight)
+{
+    stats = LightClusterStats();
+    stats.lights = static_cast<std::uint32_t>(lights.size());
+    lightData.clear();
+    lightIndices.clear();
+    hits.clear();
+    std::fill(clusters.begin(), clusters.end(), 0u);
+    std::fill(counts.begin(), counts.end(), 0u);
+
+    // only a perspective projection has froxels, anything else leaves the grid empty
+    const float p22 = projection.data[2][2];
+    const float p32 = projection.data[3][2];
+    if (projection.data[2][3] != -1.0f || viewportWidth <= 0 || viewportHeight <= 0) return;
+    const float newNear = p32 / (p22 - 1.0f);
+    const float newFar = p32 / (p22 + 1.0f);
+    if (!(newNear > 0.0f) || !(newFar > newNear)) return;
+
+    UpdateClusterBounds(projection, viewportWidth, viewportHeight);
+
+    for (const ClusterLight& light : lights)
+    {
+        if (light.range <= 0.0f || light.intensity <= 0.0f) continue;
+
+        const Vector3 center = ToViewSpace(view, light.position);
+        const float radius = light.range;
+        const float depth = -center.z;
+
+        float minDepth = depth - radius;
+        float maxDepth = depth + radius;
+        if (maxDepth <= nearPlane || minDepth >= farPlane) continue;
+        minDepth = std::max(minDepth, nearPlane);
+        maxDepth = std::min(maxDepth, farPlane);
+
+        // screen rectangle of the box around the sphere : monotonic in x and in 1 / depth, the extremes are corners
+        float ndcMinX = std::numeric_limits<float>::max(), ndcMaxX = -std::numeric_limits<float>::max();
+        float ndcMinY = std::numeric_limits<float>::max(), ndcMaxY = -std::numeric_limits<float>::max();
+        for (float d : { minDepth, maxDepth })
+        {
+            for (float side : { -radius, radius })
+            {
+                const float nx = projX * (center.x + side) / d - offsetX;
+                const float ny = projY * (center.y + side) / d - offsetY;
+                ndcMinX = std::min(ndcMinX, nx);
+                ndcMaxX = std::max(ndcMaxX, nx);
+                ndcMinY = std::min(ndcMinY, ny);
+                ndcMaxY = std::max(ndcMaxY, ny);
+            }
+        }
+        if (ndcMaxX < -1.0f || ndcMinX > 1.0f || ndcMaxY < -1.0f || ndcMinY > 1.0f) continue;
+
+        const std::uint32_t x0 = TileOf(ndcMinX, COUNT_X), x1 = TileOf(ndcMaxX, COUNT_X);
+        const std::uint32_t y0 = TileOf(ndcMinY, COUNT_Y), y1 = TileOf(ndcMaxY, COUNT_Y);
+        const std::uint32_t z0 = SliceOf(minDepth), z1 = SliceOf(maxDepth);
+
+        const std::uint32_t lightIndex = stats.visibleLights;
+        const float radiusSq = radius * radius;
+        bool touched = false;
+
+        for (std::uint32_t z = z0; z <= z1; ++z)
+        {
+            for (std::uint32_t y = y0; y <= y1; ++y)
+            {
+                for (std::uint32_t x = x0; x <= x1; ++x)
+                {
+                    const std::uint32_t cluster = x + COUNT_X * (y + COUNT_Y * z);
+                    const ClusterBounds& box = bounds[cluster];
+
+                    const float dx = std::max(std::max(box.min.x - center.x, 0.0f), center.x - box.max.x);
+                    const float dy = std::max(std::max(box.min.y - center.y, 0.0f), center.y - box.max.y);
+                    const float dz = std::max(std::max(box.min.z - center.z, 0.0f), center.z - box.max.z);
+                    if (dx * dx + dy * dy + dz * dz > radiusSq) continue;
+
+                    if (counts[cluster] == MAX_LIGHTS_PER_CLUSTER)
+                    {
+                        stats.dropped++;
+                        continue;
+                    }
+                    counts[cluster]++;
+                    hits.push_back(cluster);
+                    hits.push_back(lightIndex);
+                    touched = true;
+                }
+            }
+        }
+
+        if (!touched) continue;
+        stats.visibleLights++;
+
+        // the shader lights in world space, like FragPos
+        const float texels[TEXELS_PER_LIGHT * 4] = {
+            light.position.x, light.position.y, light.position.z, light.range,
+            light.color.x, light.color.y, light.color.z, light.intensity,
+            light.attenuation, light.farPlane, static_cast<float>(light.shadowIndex), 0.0f
+        };
+        lightData.insert(lightData.end(), texels, texels + TEXELS_PER_LIGHT * 4);
+    }
+
+    std::uint32_t offset = 0;
+    for (std::uint32_t cluster = 0; cluster < CLUSTER_COUNT; ++cluster)
+    {
+        clusters[cluster * 2] = offset;
+        clusters[cluster * 2 + 1] = counts[cluster];
+        cursor[cluster] = offset;
+        offset += counts[cluster];
+        stats.maxPerCluster = std::max(stats.maxPerCluster, counts[cluster]);
+    }
+
+    lightIndices.resize(offset);
+    for (std::size_t i = 0; i < hits.size(); i += 2)
+    {
+        lightIndices[cursor[hits[i]]++] = hits[i + 1];
+    }
+    stats.indices = offset;
+}
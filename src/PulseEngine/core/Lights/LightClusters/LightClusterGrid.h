@@ -0,0 +1,126 @@
+/**
+ * @file LightClusterGrid.h
+ * @brief Clustered forward lighting : the point lights are binned once per view in a grid of froxels, a pixel only
+ * loops over the lights of its cluster.
+ * @details The view frustum is cut in COUNT_X x COUNT_Y screen tiles and COUNT_Z depth slices. The slices are
+ * exponential in view depth (slice k starts at near * (far / near)^(k / COUNT_Z)), so the clusters stay close to cubes
+ * from the near plane to the far plane. Build, once per view :
+ * - the view space AABB of every cluster, kept while the projection and the viewport don't change,
+ * - per light, the tile and slice range its bounding sphere can touch, then a sphere / cluster AABB test,
+ * - a count pass, a prefix sum and a scatter in a single index list : cluster i uses lightIndices[offset, offset + count).
+ * The three tables are flat arrays, LightManager uploads them as buffer textures and basic.frag finds its cluster from
+ * gl_FragCoord and its view depth.
+ * @version 0.1
+ * @date 2025-12-14
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+#ifndef LIGHTCLUSTERGRID_H
+#define LIGHTCLUSTERGRID_H
+
+#include "Common/dllExport.h"
+#include "PulseEngine/core/Math/Vector.h"
+#include "PulseEngine/core/Math/Mat4.h"
+
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief What the grid needs of a point light, filled by LightManager.
+ */
+struct ClusterLight
+{
+    PulseEngine::Vector3 position;      ///< world space
+    float range = 0.0f;                 ///< the light is 0 past it, radius of the binned sphere
+    PulseEngine::Vector3 color;
+    float intensity = 0.0f;
+    float attenuation = 0.0f;
+    float farPlane = 0.0f;              ///< of the shadow cube map
+    int shadowIndex = -1;               ///< shadow cube map slot in the shader, -1 : no shadow
+};
+
+struct LightClusterStats
+{
+    std::uint32_t lights = 0;           ///< given to Build
+    std::uint32_t visibleLights = 0;    ///< touching at least one cluster, the ones uploaded
+    std::uint32_t indices = 0;          ///< light references over all the clusters
+    std::uint32_t maxPerCluster = 0;
+    std::uint32_t dropped = 0;          ///< references past MAX_LIGHTS_PER_CLUSTER
+};
+
+class PULSE_ENGINE_DLL_API LightClusterGrid
+{
+public:
+    static constexpr std::uint32_t COUNT_X = 16;
+    static constexpr std::uint32_t COUNT_Y = 9;
+    static constexpr std::uint32_t COUNT_Z = 24;
+    static constexpr std::uint32_t CLUSTER_COUNT = COUNT_X * COUNT_Y * COUNT_Z;
+    /// RGBA32F texels per light : position + range, color + intensity, attenuation + farPlane + shadowIndex
+    static constexpr std::uint32_t TEXELS_PER_LIGHT = 3;
+    /// bounds the loop of a pixel, the lights past it in a cluster are dropped (and counted in the stats)
+    static constexpr std::uint32_t MAX_LIGHTS_PER_CLUSTER = 128;
+
+    LightClusterGrid();
+
+    /**
+     * @brief Bin the lights for this camera. view and projection are the matrices given to the shaders, the viewport
+     * is the size of the target in pixels. The tables are rebuilt, their capacity is kept.
+     */
+    void Build(const std::vector<ClusterLight>& lights, const PulseEngine::Mat4& view, const PulseEngine::Mat4& projection, int viewportWidth, int viewportHeight);
+
+    /// @brief TEXELS_PER_LIGHT RGBA32F texels per visible light, indexed by GetLightIndices.
+    const std::vector<float>& GetLightData() const { return lightData; }
+    /// @brief RG32UI, (offset, count) in GetLightIndices for each cluster, x fastest then y then z.
+    const std::vector<std::uint32_t>& GetClusters() const { return clusters; }
+    /// @brief R32UI, light of each reference.
+    const std::vector<std::uint32_t>& GetLightIndices() const { return lightIndices; }
+
+    /// @brief slice = log(viewDepth) * scale + bias
+    float GetSliceScale() const { return sliceScale; }
+    float GetSliceBias() const { return sliceBias; }
+    /// @brief Size of a screen tile in pixels.
+    float GetTileWidth() const { return tileWidth; }
+    float GetTileHeight() const { return tileHeight; }
+    float GetNear() const { return nearPlane; }
+    float GetFar() const { return farPlane; }
+
+    const LightClusterStats& GetStats() const { return stats; }
+
+    static PulseEngine::Vector3 ToViewSpace(const PulseEngine::Mat4& view, const PulseEngine::Vector3& point);
+
+private:
+    struct ClusterBounds
+    {
+        PulseEngine::Vector3 min;
+        PulseEngine::Vector3 max;
+    };
+
+    void UpdateClusterBounds(const PulseEngine::Mat4& projection, int viewportWidth, int viewportHeight);
+    std::uint32_t SliceOf(float viewDepth) const;
+
+    std::vector<ClusterBounds> bounds;
+    std::vector<float> lightData;
+    std::vector<std::uint32_t> clusters;
+    std::vector<std::uint32_t> lightIndices;
+
+    // scratch of Build, kept for its capacity
+    std::vector<std::uint32_t> counts;
+    std::vector<std::uint32_t> hits;        ///< (cluster, visible light) pairs
+    std::vector<std::uint32_t> cursor;
+
+    // projection the bounds were built for
+    float projX = 0.0f, projY = 0.0f, offsetX = 0.0f, offsetY = 0.0f;
+    int width = 0, height = 0;
+
+    float nearPlane = 0.1f;
+    float farPlane = 1000.0f;
+    float sliceScale = 0.0f;
+    float sliceBias = 0.0f;
+    float tileWidth = 1.0f;
+    float tileHeight = 1.0f;
+
+    LightClusterStats stats;
+};
+
+#endif // LIGHTCLUSTERGRID_H
@@ -3,55 +3,235 @@
 #include "PulseEngine/core/PulseEngineBackend.h"
 #include "PulseEngine/core/Lights/PointLight/PointLight.h"
 #include "PulseEngine/core/Lights/DirectionalLight/DirectionalLight.h"
+#include "PulseEngine/core/Lights/LightClusters/LightClusterGrid.h"
+#include "PulseEngine/core/Graphics/RenderSnapshot/RenderSnapshot.h"
 #include "PulseEngine/core/Graphics/IGraphicsApi.h"
 #include "PulseEngine/core/Entity/Entity.h"
 #include "PulseEngine/core/Material/Material.h"
 
-void LightManager::BindLightsToShader(Shader *shader, PulseEngineBackend* scene, Entity* entity)
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <unordered_map>
+
+namespace
 {
+    // texture units : 0-3 point light cube maps, 4 bone palettes (SkinningStage), 5 draw parameters (MaterialBatcher),
+    // 6-8 material (Material::BindTextures), 9-11 clusters, 12-15 directional shadow cascades
+    constexpr int MAX_SHADOWED_POINT_LIGHTS = 4;    // must match basic.frag
+    constexpr int LIGHT_DATA_UNIT = 9;
+    constexpr int CLUSTERS_UNIT = 10;
+    constexpr int LIGHT_INDICES_UNIT = 11;
+    constexpr int CASCADE_SHADOW_UNIT = 12;
 
-    // Bind entity-specific uniforms
-    shader->SetVec3("objectColor", entity->GetMaterial()->color);
+    // a light is cut where it falls under 1/256 of a color step
+    constexpr float LIGHT_CUTOFF = 1.0f / 256.0f;
 
-    int maxPointLights = 4; // must match shader array size
-    int boundPointLights = 0;
+    const char* const POINT_SHADOW_MAP_NAMES[MAX_SHADOWED_POINT_LIGHTS] = {
+        "pointShadowMaps[0]", "pointShadowMaps[1]", "pointShadowMaps[2]", "pointShadowMaps[3]"
+    };
+    const char* const CASCADE_SHADOW_MAP_NAMES[DirectionalLight::MAX_CASCADES] = {
+        "cascadeShadowMaps[0]", "cascadeShadowMaps[1]", "cascadeShadowMaps[2]", "cascadeShadowMaps[3]"
+    };
 
-    for (size_t i = 0; i < scene->lights.size() && boundPointLights < maxPointLights; ++i)
+    struct TextureBuffer
     {
-        PointLight* pLight = dynamic_cast<PointLight*>(scene->lights[i]);
-        if (!pLight)
-            continue;
+        unsigned int buffer = 0;
+        unsigned int texture = 0;
+    };
 
-        // Bind PointLight uniforms
-        pLight->BindToShader(*shader, boundPointLights);
+    struct BoundShader
+    {
+        unsigned int program = 0;
+        std::uint64_t view = 0;
+    };
 
-        PulseEngineGraphicsAPI->ActivateTexture(boundPointLights);
-        PulseEngineGraphicsAPI->BindTexture(TEXTURE_CUBE_MAP, pLight->depthCubeMap);
+    struct ShadowedLight
+    {
+        const RenderLight* params = nullptr;
+        PointLight* light = nullptr;
+    };
+
+    struct ViewLights
+    {
+        LightClusterGrid grid;
+        std::vector<ClusterLight> lights;
+        std::vector<ShadowedLight> shadowCasters;
+        PointLight* shadowed[MAX_SHADOWED_POINT_LIGHTS] = {};
+        DirectionalLight* directional = nullptr;
+        RenderLight directionalParams;      ///< copy : the snapshot of a side view doesn't outlive PrepareView
 
-        std::string baseName = "pointLights[" + std::to_string(boundPointLights) + "]";
-        shader->SetInt((baseName + ".depthMap"), boundPointLights);
+        TextureBuffer lightData;
+        TextureBuffer clusters;
+        TextureBuffer lightIndices;
 
-        boundPointLights++;
+        std::uint64_t view = 0;                                     ///< PrepareView count
+        std::unordered_map<const Shader*, BoundShader> boundShaders;
+    };
+
+    ViewLights& GetViewLights()
+    {
+        static ViewLights viewLights;
+        return viewLights;
+    }
+
+    float LightRange(const RenderLight& light)
+    {
+        // intensity / (1 + attenuation * d²) < cutoff past this distance, and the shadow stops at farPlane anyway
+        if (light.attenuation <= 0.0f) return light.farPlane;
+        const float rangeSq = (light.intensity / LIGHT_CUTOFF - 1.0f) / light.attenuation;
+        if (rangeSq <= 0.0f) return 0.0f;
+        return std::min(std::sqrt(rangeSq), light.farPlane);
     }
-    // Bind directional light if found
-    for (size_t i = 0; i < scene->lights.size(); ++i)
+
+    void CreateTextureBuffers(ViewLights& state)
     {
-        DirectionalLight* dLight = dynamic_cast<DirectionalLight*>(scene->lights[i]);
-        if (!dLight)
+        if (state.lightData.texture) return;
+        PulseEngineGraphicsAPI->CreateTextureBuffer(&state.lightData.buffer, &state.lightData.texture, TEXTURE_BUFFER_RGBA32F);
+        PulseEngineGraphicsAPI->CreateTextureBuffer(&state.clusters.buffer, &state.clusters.texture, TEXTURE_BUFFER_RG32UI);
+        PulseEngineGraphicsAPI->CreateTextureBuffer(&state.lightIndices.buffer, &state.lightIndices.texture, TEXTURE_BUFFER_R32UI);
+    }
+}
+
+const LightClusterGrid& LightManager::GetClusterGrid()
+{
+    return GetViewLights().grid;
+}
+
+void LightManager::PrepareView(const RenderSnapshot& snapshot)
+{
+    PROFILE_TIMER_FUNCTION;
+
+    const PulseEngine::Mat4& view = snapshot.view.view;
+    ViewLights& state = GetViewLights();
+    state.view++;
+    state.lights.clear();
+    state.shadowCasters.clear();
+    std::fill(std::begin(state.shadowed), std::end(state.shadowed), nullptr);
+    state.directional = nullptr;
+
+    for (const RenderLight& params : snapshot.lights)
+    {
+        if (PointLight* pLight = dynamic_cast<PointLight*>(params.light))
+        {
+            if (params.castsShadow) state.shadowCasters.push_back({ &params, pLight });
             continue;
-    
-        dLight->BindToShader(*shader, -1);
-    
-        if (dLight->castsShadow)
-        {            PulseEngineGraphicsAPI->ActivateTexture(maxPointLights);
-            PulseEngineGraphicsAPI->BindTexture(TEXTURE_2D, dLight->depthMapTex);
-        
-            shader->SetInt("dirLight.shadowMap", maxPointLights);
         }
-    
-        break; // Only one directional light supported
+        if (state.directional) continue; // Only one directional light supported
+        state.directional = dynamic_cast<DirectionalLight*>(params.light);
+        if (state.directional) state.directionalParams = params;
     }
 
+    // the cube maps go to the shadow casters closest to the camera, the other lights are still lit, without shadow
+    const std::size_t shadowCount = std::min<std::size_t>(state.shadowCasters.size(), MAX_SHADOWED_POINT_LIGHTS);
+    std::partial_sort(state.shadowCasters.begin(), state.shadowCasters.begin() + shadowCount, state.shadowCasters.end(),
+        [&view](const ShadowedLight& a, const ShadowedLight& b)
+        {
+            return LightClusterGrid::ToViewSpace(view, a.params->position).GetMagnitude() <
+                   LightClusterGrid::ToViewSpace(view, b.params->position).GetMagnitude();
+        });
+    for (std::size_t i = 0; i < shadowCount; ++i) state.shadowed[i] = state.shadowCasters[i].light;
+
+    for (const RenderLight& params : snapshot.lights)
+    {
+        PointLight* pLight = dynamic_cast<PointLight*>(params.light);
+        if (!pLight) continue;
 
-    shader->SetInt("numPointLights", boundPointLights);
-}
\ No newline at end of file
+        ClusterLight clusterLight;
+        clusterLight.position = params.position;
+        clusterLight.range = LightRange(params);
+        clusterLight.color = params.color;
+        clusterLight.intensity = params.intensity;
+        clusterLight.attenuation = params.attenuation;
+        clusterLight.farPlane = params.farPlane;
+        for (int i = 0; i < MAX_SHADOWED_POINT_LIGHTS; ++i)
+        {
+            if (state.shadowed[i] == pLight) clusterLight.shadowIndex = i;
+        }
+        state.lights.push_back(clusterLight);
+    }
+
+    state.grid.Build(state.lights, view, snapshot.view.projection, snapshot.view.width, snapshot.view.height);
+
+    CreateTextureBuffers(state);
+    const std::vector<float>& lightData = state.grid.GetLightData();
+    const std::vector<std::uint32_t>& clusters = state.grid.GetClusters();
+    const std::vector<std::uint32_t>& lightIndices = state.grid.GetLightIndices();
+    PulseEngineGraphicsAPI->UploadTextureBuffer(state.lightData.buffer, lightData.data(), lightData.size() * sizeof(float));
+    PulseEngineGraphicsAPI->UploadTextureBuffer(state.clusters.buffer, clusters.data(), clusters.size() * sizeof(std::uint32_t));
+    PulseEngineGraphicsAPI->UploadTextureBuffer(state.lightIndices.buffer, lightIndices.data(), lightIndices.size() * sizeof(std::uint32_t));
+
+    const LightClusterStats& stats = state.grid.GetStats();
+    PROFILE_COUNTER("Light clusters", {
+        {"pointLights", (double)stats.lights},
+        {"visibleLights", (double)stats.visibleLights},
+        {"indices", (double)stats.indices},
+        {"maxPerCluster", (double)stats.maxPerCluster},
+        {"dropped", (double)stats.dropped}
+    });
+}
+
+void LightManager::BindLightsToShader(Shader *shader, const PulseEngine::Vector3& objectColor)
+{
+    // Bind entity-specific uniforms
+    shader->SetVec3("objectColor", objectColor);
+
+    ViewLights& state = GetViewLights();
+
+    // texture units are shared with the materials and the text between two draws, they are bound each time
+    for (int i = 0; i < MAX_SHADOWED_POINT_LIGHTS; ++i)
+    {
+        PulseEngineGraphicsAPI->ActivateTexture(i);
+        PulseEngineGraphicsAPI->BindTexture(TEXTURE_CUBE_MAP, state.shadowed[i] ? state.shadowed[i]->depthCubeMap : 0);
+    }
+    if (state.directional && state.directionalParams.castsShadow)
+    {
+        for (int i = 0; i < DirectionalLight::MAX_CASCADES; ++i)
+        {
+            PulseEngineGraphicsAPI->ActivateTexture(CASCADE_SHADOW_UNIT + i);
+            PulseEngineGraphicsAPI->BindTexture(TEXTURE_2D, state.directional->cascades[i].depthMapTex);
+        }
+    }
+    PulseEngineGraphicsAPI->ActivateTexture(LIGHT_DATA_UNIT);
+    PulseEngineGraphicsAPI->BindTexture(TEXTURE_BUFFER, state.lightData.texture);
+    PulseEngineGraphicsAPI->ActivateTexture(CLUSTERS_UNIT);
+    PulseEngineGraphicsAPI->BindTexture(TEXTURE_BUFFER, state.clusters.texture);
+    PulseEngineGraphicsAPI->ActivateTexture(LIGHT_INDICES_UNIT);
+    PulseEngineGraphicsAPI->BindTexture(TEXTURE_BUFFER, state.lightIndices.texture);
+
+    // the light uniforms are program state : once per shader and per view
+    BoundShader& bound = state.boundShaders[shader];
+    if (bound.program == shader->getProgramID() && bound.view == state.view) return;
+    bound.program = shader->getProgramID();
+    bound.view = state.view;
+
+    const LightClusterGrid& grid = state.grid;
+    shader->SetInt("pointLightData", LIGHT_DATA_UNIT);
+    shader->SetInt("lightClusters", CLUSTERS_UNIT);
+    shader->SetInt("lightIndices", LIGHT_INDICES_UNIT);
+    shader->SetInt("clusterCountX", LightClusterGrid::COUNT_X);
+    shader->SetInt("clusterCountY", LightClusterGrid::COUNT_Y);
+    shader->SetInt("clusterCountZ", LightClusterGrid::COUNT_Z);
+    shader->SetFloat("clusterSliceScale", grid.GetSliceScale());
+    shader->SetFloat("clusterSliceBias", grid.GetSliceBias());
+    shader->SetFloat("clusterTileWidth", grid.GetTileWidth());
+    shader->SetFloat("clusterTileHeight", grid.GetTileHeight());
+    for (int i = 0; i < MAX_SHADOWED_POINT_LIGHTS; ++i)
+    {
+        shader->SetInt(POINT_SHADOW_MAP_NAMES[i], i);
+    }
+
+    // the samplers keep their unit even without shadow, unit 0 holds a cube map
+    for (int i = 0; i < DirectionalLight::MAX_CASCADES; ++i)
+    {
+        shader->SetInt(CASCADE_SHADOW_MAP_NAMES[i], CASCADE_SHADOW_UNIT + i);
+    }
+    if (state.directional)
+    {
+        state.directional->BindToShader(*shader, state.directionalParams, -1);
+    }
+    else
+    {
+        shader->SetFloat("dirLight.intensity", 0.0f);
+    }
+}
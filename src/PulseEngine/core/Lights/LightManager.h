@@ -14,6 +14,8 @@
 #include "Common/common.h"
 #include "Common/dllExport.h"
 class LightData;
+class LightClusterGrid;
+class RenderSnapshot;
 
 /**
  * @brief LightManager is responsible for managing all lights in the scene.
@@ -23,7 +25,20 @@ class PULSE_ENGINE_DLL_API LightManager
 {
     public:    
         void RenderAllShadowsMap(PulseEngineBackend& scene);
-        static void BindLightsToShader(Shader* shader, PulseEngineBackend* scene, Entity* entity);
+
+        /**
+         * @brief Bin the point lights of the snapshot in the clusters of its camera (see LightClusterGrid) and upload
+         * the tables. Once per view, before its entities : the light uniforms are then bound once per shader for the
+         * view, not once per entity. snapshot.view is the one given to the shaders.
+         */
+        static void PrepareView(const RenderSnapshot& snapshot);
+
+        /**
+         * @brief Object color, and the lights of the last PrepareView if this shader didn't get them yet.
+         */
+        static void BindLightsToShader(Shader* shader, const PulseEngine::Vector3& objectColor);
+
+        static const LightClusterGrid& GetClusterGrid();
 
 };
 
@@ -11,6 +11,15 @@ void LightData::Serialize(Archive &ar)
 }
 
 
+void LightData::CaptureRenderLight(RenderLight& params) const
+{
+    params.position = transform.position;
+    params.color = PulseEngine::Vector3(color.r, color.g, color.b);
+    params.intensity = intensity;
+    params.attenuation = attenuation;
+    params.castsShadow = castsShadow;
+}
+
 void LightData::Deserialize(Archive& ar)
 {
 
@@ -18,6 +18,8 @@
 #include "Common/common.h"
 #include "Common/dllExport.h"
 #include "PulseEngine/core/Entity/Entity.h"
+#include "PulseEngine/core/Lights/ShadowCache/ShadowCasterCache.h"
+#include "PulseEngine/core/Graphics/RenderSnapshot/RenderSnapshot.h"
 
 
 class PulseEngineBackend;
@@ -36,26 +38,34 @@ class PULSE_ENGINE_DLL_API LightData: public Entity
         float intensity;
         float attenuation;
         bool castsShadow;
+        /// casters in range of the light and its cached static layer, see ShadowCasterCache
+        ShadowCasterCache shadowCache;
 
         /**
          * @brief Bind the light data to a shader.
          * 
          * @param shader usage of the shader class is needed to easily bind the light to fragment and vertex, depending on the graphic api.
+         * @param params the light as captured in the render snapshot, not the live one.
          * @param index some light (like pointlight) can have multiple instances, so we need to bind them to the shader with an index (position in the list of accepted lights), the position in the shader will be like "lights[0].position", "lights[1].position", etc.
          */
-        virtual void BindToShader(Shader& shader, int index) = 0;
+        virtual void BindToShader(Shader& shader, const RenderLight& params, int index) = 0;
         /**
          * @brief Render the shadow map for the light.
          * @brief This method will render the scene from the light's perspective to create a depth map, which is used for shadow mapping.
          * 
          * @param shader usage of the shader class is needed to easily bind the light to fragment and vertex, depending on the graphic api.
-         * @param scene the scene where the light is rendered, used to access entities and render them in the shadow map.
+         * @param snapshot the frame to draw : camera and shadow casters, see RenderSnapshot.
+         * @param params this light in snapshot.
          */
-        virtual void RenderShadowMap(Shader &shader, PulseEngineBackend& scene) = 0;
+        virtual void RenderShadowMap(Shader &shader, const RenderSnapshot& snapshot, const RenderLight& params) = 0;
+        /**
+         * @brief Copy what the graphics thread reads of the light in the render snapshot, on the simulation side.
+         */
+        virtual void CaptureRenderLight(RenderLight& params) const;
         virtual void RecalculateLightSpaceMatrix() = 0;
     
         LightData(PulseEngine::Vector3 position, PulseEngine::Color color, float intensity, float attenuation) : Entity("Light", position), color(color), intensity(intensity), attenuation(attenuation), castsShadow(true) {}
-        LightData() : Entity() {}
+        LightData() : Entity(), castsShadow(true) {}
     };
 
 #endif
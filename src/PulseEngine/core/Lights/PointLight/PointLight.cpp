@@ -2,28 +2,41 @@
 #include "PulseEngine/core/Entity/Entity.h"
 #include "PulseEngine/core/Graphics/IGraphicsApi.h"
 #include "PulseEngine/core/Math/MathUtils.h"
+#include "PulseEngine/core/PulseEngineBackend.h"
+#include "PulseEngine/core/Threading/GraphicsThread.h"
+
+namespace
+{
+    const char* const SHADOW_MATRIX_NAMES[6] = {
+        "shadowMatrices[0]", "shadowMatrices[1]", "shadowMatrices[2]",
+        "shadowMatrices[3]", "shadowMatrices[4]", "shadowMatrices[5]"
+    };
+
+    void ComputeShadowTransforms(const PulseEngine::Vector3& pos, float farPlane, std::array<PulseEngine::Mat4, 6>& transforms)
+    {
+        PulseEngine::Mat4 shadowProj = PulseEngine::MathUtils::PerspectiveMat(PulseEngine::MathUtils::ToRadians(90.0f), 1.0f, 0.1f, farPlane);
+
+        transforms[0] = shadowProj * PulseEngine::MathUtils::Matrix::LookAt(pos, pos + PulseEngine::Vector3( 1, 0, 0), PulseEngine::Vector3(0, -1, 0));
+        transforms[1] = shadowProj * PulseEngine::MathUtils::Matrix::LookAt(pos, pos + PulseEngine::Vector3(-1, 0, 0), PulseEngine::Vector3(0, -1, 0));
+        transforms[2] = shadowProj * PulseEngine::MathUtils::Matrix::LookAt(pos, pos + PulseEngine::Vector3(0, 1, 0), PulseEngine::Vector3(0, 0, 1));
+        transforms[3] = shadowProj * PulseEngine::MathUtils::Matrix::LookAt(pos, pos + PulseEngine::Vector3(0,-1, 0), PulseEngine::Vector3(0, 0,-1));
+        transforms[4] = shadowProj * PulseEngine::MathUtils::Matrix::LookAt(pos, pos + PulseEngine::Vector3(0, 0, 1), PulseEngine::Vector3(0, -1, 0));
+        transforms[5] = shadowProj * PulseEngine::MathUtils::Matrix::LookAt(pos, pos + PulseEngine::Vector3(0, 0,-1), PulseEngine::Vector3(0, -1, 0));
+    }
+}
 
 PointLight::PointLight(PulseEngine::Vector3 position, PulseEngine::Color color, float intensity, float attenuation, float farPlane, int shadowResolution)
     : LightData(position, color, intensity, attenuation),
       farPlane(farPlane),
       shadowResolution(DEFAULT_SHADOW_MAP_RES)
 {
-    PulseEngineGraphicsAPI->GenerateDepthCubeMap(&depthMapFBO, &depthCubeMap);
+    if (PulseEngine::Threading::IsGraphicsThread()) PulseEngineGraphicsAPI->GenerateDepthCubeMap(&depthMapFBO, &depthCubeMap);
     RecalculateLightSpaceMatrix();
 }
 
 void PointLight::RecalculateLightSpaceMatrix()
 {
-    PulseEngine::Mat4 shadowProj = PulseEngine::MathUtils::PerspectiveMat(PulseEngine::MathUtils::ToRadians(90.0f), 1.0f, 0.1f, farPlane);
-    PulseEngine::Vector3 pos(transform.position.x, transform.position.y, transform.position.z);
-
-    
-    shadowTransforms[0] = shadowProj * PulseEngine::MathUtils::Matrix::LookAt(pos, pos + PulseEngine::Vector3( 1, 0, 0), PulseEngine::Vector3(0, -1, 0));
-    shadowTransforms[1] = shadowProj * PulseEngine::MathUtils::Matrix::LookAt(pos, pos + PulseEngine::Vector3(-1, 0, 0), PulseEngine::Vector3(0, -1, 0));
-    shadowTransforms[2] = shadowProj * PulseEngine::MathUtils::Matrix::LookAt(pos, pos + PulseEngine::Vector3(0, 1, 0), PulseEngine::Vector3(0, 0, 1));
-    shadowTransforms[3] = shadowProj * PulseEngine::MathUtils::Matrix::LookAt(pos, pos + PulseEngine::Vector3(0,-1, 0), PulseEngine::Vector3(0, 0,-1));
-    shadowTransforms[4] = shadowProj * PulseEngine::MathUtils::Matrix::LookAt(pos, pos + PulseEngine::Vector3(0, 0, 1), PulseEngine::Vector3(0, -1, 0));
-    shadowTransforms[5] = shadowProj * PulseEngine::MathUtils::Matrix::LookAt(pos, pos + PulseEngine::Vector3(0, 0,-1), PulseEngine::Vector3(0, -1, 0));
+    ComputeShadowTransforms(transform.position, farPlane, shadowTransforms);
 }
 
 const std::array<PulseEngine::Mat4, 6>& PointLight::GetShadowTransforms() const
@@ -31,43 +44,82 @@ const std::array<PulseEngine::Mat4, 6>& PointLight::GetShadowTransforms() const
     return shadowTransforms;
 }
 
-void PointLight::BindToShader(Shader& shader, int index)
+void PointLight::CaptureRenderLight(RenderLight& params) const
+{
+    LightData::CaptureRenderLight(params);
+    params.farPlane = farPlane;
+}
+
+void PointLight::BindToShader(Shader& shader, const RenderLight& params, int index)
 {
     std::string prefix = "pointLights[" + std::to_string(index) + "].";
 
-    shader.SetVec3(prefix + "position", transform.position);
-    shader.SetVec3(prefix + "color", PulseEngine::Vector3(color.r, color.g, color.b));
-    shader.SetFloat(prefix + "intensity", intensity);
-    shader.SetFloat(prefix + "attenuation", attenuation);
+    shader.SetVec3(prefix + "position", params.position);
+    shader.SetVec3(prefix + "color", params.color);
+    shader.SetFloat(prefix + "intensity", params.intensity);
+    shader.SetFloat(prefix + "attenuation", params.attenuation);
     shader.SetInt(prefix + "castsShadow", 1); // 1 for true, 0 for false
-    shader.SetFloat(prefix + "farPlane", farPlane);
+    shader.SetFloat(prefix + "farPlane", params.farPlane);
 }
 
-void PointLight::RenderShadowMap(Shader &shader, PulseEngineBackend& scene)
+void PointLight::RenderShadowMap(Shader &shader, const RenderSnapshot& snapshot, const RenderLight& params)
 {
-    // if (!castsShadow) return;
+    if (!params.castsShadow) return;
+    if (!depthMapFBO) PulseEngineGraphicsAPI->GenerateDepthCubeMap(&depthMapFBO, &depthCubeMap);
 
-    PulseEngineGraphicsAPI->SpecificStartFrame(depthMapFBO, PulseEngine::Vector2(2048, 2048));
+    const PulseEngine::Vector3 position = params.position;
+    const float farPlane = params.farPlane;
+    const float rangeSq = farPlane * farPlane;
+    auto inRange = [&](const AABB& bounds)
+    {
+        // squared distance from the light to the box
+        const PulseEngine::Vector3 closest = position.Max(bounds.min).Min(bounds.max);
+        const PulseEngine::Vector3 offset = closest - position;
+        return offset.Dot(offset) <= rangeSq;
+    };
+
+    const std::uint64_t key = ShadowCasterCache::HashFloats({ position.x, position.y, position.z, farPlane });
+    if (!shadowCache.Update(snapshot, key, inRange)) return;
+
+    const bool layered = shadowCache.UsesStaticLayer();
+    if (layered && !staticLayerFBO)
+    {
+        PulseEngineGraphicsAPI->GenerateDepthCubeMap(&staticLayerFBO, &staticLayerCubeMap);
+    }
 
-    scene.pointLightShadowShader->Use();
-    scene.pointLightShadowShader->SetVec3("lightPos", transform.position);
-    scene.pointLightShadowShader->SetFloat("farPlane", farPlane);
+    // from the captured position : the live transform belongs to the simulation
+    std::array<PulseEngine::Mat4, 6> transforms;
+    ComputeShadowTransforms(position, farPlane, transforms);
+
+    Shader* depthShader = PulseEngineInstance->pointLightShadowShader;
+    depthShader->Use();
+    depthShader->SetVec3("lightPos", position);
+    depthShader->SetFloat("farPlane", farPlane);
 
     // upload all 6 shadow matrices
     for (int i = 0; i < 6; i++)
     {
-        std::string name = "shadowMatrices[" + std::to_string(i) + "]";
-        scene.pointLightShadowShader->SetMat4(name, shadowTransforms[i]);
+        depthShader->SetMat4(SHADOW_MATRIX_NAMES[i], transforms[i]);
     }
-    
-    // then render all objects once
-    for (Entity* obj : scene.entities)
+
+    if (shadowCache.NeedsStaticRebuild())
     {
-        scene.pointLightShadowShader->SetMat4("model", obj->GetMatrix());
-    
-        obj->DrawMeshWithShader(scene.pointLightShadowShader);
+        PulseEngineGraphicsAPI->BindShadowFramebuffer(layered ? &staticLayerFBO : &depthMapFBO);
+        for (const RenderObject* caster : shadowCache.GetStaticCasters())
+        {
+            snapshot.DrawObject(*caster, depthShader, false);
+        }
+        PulseEngineGraphicsAPI->UnbindShadowFramebuffer();
     }
 
-    PulseEngineGraphicsAPI->ActivateBackCull();
-    PulseEngineGraphicsAPI->EndFrame();
+    if (layered)
+    {
+        PulseEngineGraphicsAPI->CopyShadowMap(staticLayerCubeMap, depthCubeMap, 2048, true);
+        PulseEngineGraphicsAPI->BindShadowFramebuffer(&depthMapFBO, false);
+        for (const RenderObject* caster : shadowCache.GetDynamicCasters())
+        {
+            snapshot.DrawObject(*caster, depthShader, false);
+        }
+        PulseEngineGraphicsAPI->UnbindShadowFramebuffer();
+    }
 }
@@ -24,14 +24,17 @@ class PULSE_ENGINE_DLL_API PointLight : public LightData
 {
 public:
     float farPlane;
-    unsigned int depthMapFBO;
-    unsigned int depthCubeMap;
+    unsigned int depthMapFBO = 0;           ///< created by the first shadow pass when the light comes from the simulation thread
+    unsigned int depthCubeMap = 0;
+    unsigned int staticLayerFBO = 0;        ///< static casters only, created with the first dynamic caster in range
+    unsigned int staticLayerCubeMap = 0;
     int shadowResolution;
 
     PointLight(PulseEngine::Vector3 position, PulseEngine::Color color, float intensity, float attenuation, float farPlane, int shadowResolution = DEFAULT_SHADOW_MAP_RES);
 
-    void BindToShader(Shader& shader, int index) override;
-    void RenderShadowMap(Shader &shader, PulseEngineBackend& scene) override;
+    void BindToShader(Shader& shader, const RenderLight& params, int index) override;
+    void RenderShadowMap(Shader &shader, const RenderSnapshot& snapshot, const RenderLight& params) override;
+    void CaptureRenderLight(RenderLight& params) const override;
     void RecalculateLightSpaceMatrix() override;
 
     const std::array<PulseEngine::Mat4, 6>& GetShadowTransforms() const;
@@ -0,0 +1,140 @@
+#include "ShadowCasterCache.h"
+#include "PulseEngine/core/Graphics/RenderSnapshot/RenderSnapshot.h"
+
+#include <cstring>
+
+namespace
+{
+    std::uint64_t Mix(std::uint64_t value)
+    {
+        // splitmix64 finalizer
+        value += 0x9E3779B97F4A7C15ull;
+        value = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9ull;
+        value = (value ^ (value >> 27)) * 0x94D049BB133111EBull;
+        return value ^ (value >> 31);
+    }
+}
+
+ShadowCasterTracker& ShadowCasterTracker::GetInstance()
+{
+    static ShadowCasterTracker instance;
+    return instance;
+}
+
+void ShadowCasterTracker::Update(const RenderSnapshot& snapshot)
+{
+    frame++;
+    stats = ShadowFrameStats();
+
+    for (std::uint32_t i = 0; i < snapshot.casterCount; ++i)
+    {
+        const RenderObject& caster = snapshot.objects[i];
+        auto [it, inserted] = casters.try_emplace(caster.entity);
+        CasterState& state = it->second;
+        state.lastSeen = frame;
+
+        const PulseEngine::Mat4& matrix = caster.matrix;
+        if (inserted)
+        {
+            // a new entity is level geometry until it moves : a loaded level doesn't start with a layer per light
+            state.matrix = matrix;
+            state.stillFrames = caster.skinned ? 0 : STATIC_FRAMES;
+            continue;
+        }
+        if (std::memcmp(&state.matrix, &matrix, sizeof(PulseEngine::Mat4)) != 0)
+        {
+            state.matrix = matrix;
+            state.stillFrames = 0;
+            continue;
+        }
+
+        if (state.stillFrames >= STATIC_FRAMES) continue;
+
+        // a skinned mesh changes its shadow without moving : never static
+        if (state.stillFrames + 1 == STATIC_FRAMES && caster.skinned) continue;
+        state.stillFrames++;
+    }
+
+    // entities deleted or streamed out since the last frame
+    for (auto it = casters.begin(); it != casters.end();)
+    {
+        if (it->second.lastSeen != frame) it = casters.erase(it);
+        else ++it;
+    }
+}
+
+bool ShadowCasterTracker::IsStatic(const Entity* entity) const
+{
+    auto it = casters.find(entity);
+    return it != casters.end() && it->second.stillFrames >= STATIC_FRAMES;
+}
+
+std::uint64_t ShadowCasterCache::HashFloats(std::initializer_list<float> values)
+{
+    std::uint64_t hash = 0xCBF29CE484222325ull;
+    for (float value : values)
+    {
+        std::uint32_t bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        hash = Mix(hash ^ bits);
+    }
+    return hash;
+}
+
+bool ShadowCasterCache::Update(const RenderSnapshot& snapshot, std::uint64_t key, const RangeTest& inRange)
+{
+    ShadowCasterTracker& tracker = ShadowCasterTracker::GetInstance();
+    ShadowFrameStats& stats = tracker.GetStats();
+    stats.lights++;
+
+    staticCasters.clear();
+    dynamicCasters.clear();
+
+    // a static caster that moves becomes dynamic, the set of static casters is enough to know the layer changed.
+    // Order independent : the scene list can be reordered without redrawing anything.
+    std::uint64_t newStaticKey = 0;
+    for (std::uint32_t i = 0; i < snapshot.casterCount; ++i)
+    {
+        const RenderObject& caster = snapshot.objects[i];
+        if (!inRange(caster.worldBounds))
+        {
+            stats.culledCasters++;
+            continue;
+        }
+
+        if (tracker.IsStatic(caster.entity))
+        {
+            staticCasters.push_back(&caster);
+            newStaticKey += Mix(reinterpret_cast<std::uintptr_t>(caster.entity));
+        }
+        else
+        {
+            dynamicCasters.push_back(&caster);
+        }
+    }
+    newStaticKey ^= Mix(staticCasters.size());
+
+    const bool layered = UsesStaticLayer();
+
+    // the static casters are drawn again when they changed, or when they must move between the layer and the map
+    // (the map still holds the dynamic casters of the last frame, or the layer was never filled)
+    rebuildStatic = !valid || key != lightKey || newStaticKey != staticKey || layered != staticInLayer;
+
+    const bool render = rebuildStatic || layered;
+
+    valid = true;
+    lightKey = key;
+    staticKey = newStaticKey;
+    staticInLayer = layered;
+
+    if (!render) return false;
+
+    stats.renderedLights++;
+    if (rebuildStatic)
+    {
+        stats.staticRebuilds++;
+        stats.staticCasters += static_cast<std::uint32_t>(staticCasters.size());
+    }
+    stats.dynamicCasters += static_cast<std::uint32_t>(dynamicCasters.size());
+    return true;
+}
@@ -0,0 +1,119 @@
+/**
+ * @file ShadowCasterCache.h
+ * @brief Per light shadow caster culling and a cached static layer : a shadow map is only drawn again when something
+ * it shows has moved.
+ * @details ShadowCasterTracker::Update runs once per frame before the shadow pass, on the render snapshot. It compares
+ * the matrix of every caster with the previous frame : a new entity, or one still again for STATIC_FRAMES frames, is
+ * a static caster.
+ * The others are dynamic, and so are the skinned meshes. Each light owns a ShadowCasterCache :
+ * - the casters are culled against the light volume (ortho box of a shadow cascade, sphere of a point light),
+ * - the static casters are drawn once in a static layer, again only when the light or the static casters in its
+ *   range change,
+ * - the dynamic casters are drawn each frame over a copy of that layer.
+ * A light without dynamic casters draws its static casters straight in its map and then skips its shadow pass.
+ * @version 0.1
+ * @date 2025-12-14
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+#ifndef SHADOWCASTERCACHE_H
+#define SHADOWCASTERCACHE_H
+
+#include "Common/dllExport.h"
+#include "PulseEngine/core/Math/Mat4.h"
+#include "PulseEngine/core/Math/Frustum/AABB.h"
+
+#include <cstdint>
+#include <functional>
+#include <initializer_list>
+#include <unordered_map>
+#include <vector>
+
+class Entity;
+class RenderSnapshot;
+struct RenderObject;
+
+/**
+ * @brief What the shadow pass of a frame did, reset by ShadowCasterTracker::Update.
+ */
+struct ShadowFrameStats
+{
+    std::uint32_t lights = 0;           ///< shadow casting lights
+    std::uint32_t renderedLights = 0;   ///< lights whose map was drawn this frame
+    std::uint32_t staticRebuilds = 0;   ///< static layers drawn again
+    std::uint32_t staticCasters = 0;    ///< drawn this frame
+    std::uint32_t dynamicCasters = 0;   ///< drawn this frame
+    std::uint32_t culledCasters = 0;    ///< out of the light volume
+};
+
+class PULSE_ENGINE_DLL_API ShadowCasterTracker
+{
+public:
+    /// frames without moving before a caster that moved joins the static layers again
+    static constexpr std::uint32_t STATIC_FRAMES = 30;
+
+    static ShadowCasterTracker& GetInstance();
+
+    /**
+     * @brief Once per frame, before the shadow maps : compare the matrices of the casters of snapshot with the last
+     * frame, forget the entities gone from the scene and reset the stats.
+     */
+    void Update(const RenderSnapshot& snapshot);
+
+    bool IsStatic(const Entity* entity) const;
+
+    ShadowFrameStats& GetStats() { return stats; }
+
+private:
+    struct CasterState
+    {
+        PulseEngine::Mat4 matrix;
+        std::uint32_t stillFrames = 0;
+        std::uint64_t lastSeen = 0;
+    };
+
+    std::unordered_map<const Entity*, CasterState> casters;
+    std::uint64_t frame = 0;
+    ShadowFrameStats stats;
+};
+
+class PULSE_ENGINE_DLL_API ShadowCasterCache
+{
+public:
+    using RangeTest = std::function<bool(const AABB& worldBounds)>;
+
+    /**
+     * @brief Cull and sort the casters of snapshot, and decide what the light has to draw.
+     * @param lightKey hash of what the map depends on in the light (see HashFloats), a new key redraws everything
+     * @param inRange true when a caster can throw a shadow in the map
+     * @return false : the map is up to date, nothing to draw
+     */
+    bool Update(const RenderSnapshot& snapshot, std::uint64_t lightKey, const RangeTest& inRange);
+
+    /// @brief The static casters are drawn this frame : in the layer when UsesStaticLayer, else in the map.
+    bool NeedsStaticRebuild() const { return rebuildStatic; }
+    /// @brief Dynamic casters in range : the map is a copy of the static layer with the dynamic casters over it.
+    bool UsesStaticLayer() const { return !dynamicCasters.empty(); }
+
+    /// @brief In the snapshot given to Update, valid until the next one.
+    const std::vector<const RenderObject*>& GetStaticCasters() const { return staticCasters; }
+    const std::vector<const RenderObject*>& GetDynamicCasters() const { return dynamicCasters; }
+
+    /// @brief The next Update draws everything again (the map was lost or resized).
+    void Invalidate() { valid = false; }
+
+    static std::uint64_t HashFloats(std::initializer_list<float> values);
+
+private:
+    std::vector<const RenderObject*> staticCasters;
+    std::vector<const RenderObject*> dynamicCasters;
+
+    std::uint64_t lightKey = 0;
+    std::uint64_t staticKey = 0;
+    bool staticInLayer = false;     ///< where the static casters were drawn last, also : the map holds dynamic casters
+    bool rebuildStatic = false;
+    bool valid = false;
+};
+
+#endif // SHADOWCASTERCACHE_H
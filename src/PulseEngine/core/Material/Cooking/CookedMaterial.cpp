@@ -0,0 +1,200 @@
+#include "CookedMaterial.h"
+
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+
+using namespace PulseEngine::Cooking;
+
+namespace
+{
+    const char* TEXTURE_SLOTS[] = { "albedo", "normal", "height", "roughness" };
+
+    struct BinaryWriter
+    {
+        std::vector<char> buffer;
+
+        template <typename T>
+        void Write(const T& value)
+        {
+            const char* bytes = reinterpret_cast<const char*>(&value);
+            buffer.insert(buffer.end(), bytes, bytes + sizeof(T));
+        }
+
+        void WriteString(const std::string& value)
+        {
+            Write((uint32_t)value.size());
+            buffer.insert(buffer.end(), value.begin(), value.end());
+        }
+    };
+
+    struct BinaryReader
+    {
+        const std::vector<char>& buffer;
+        std::size_t cursor = 0;
+        bool failed = false;
+
+        template <typename T>
+        T Read()
+        {
+            T value{};
+            if (cursor + sizeof(T) > buffer.size()) { failed = true; return value; }
+            std::memcpy(&value, buffer.data() + cursor, sizeof(T));
+            cursor += sizeof(T);
+            return value;
+        }
+
+        std::string ReadString()
+        {
+            const uint32_t length = Read<uint32_t>();
+            if (failed || cursor + length > buffer.size()) { failed = true; return std::string(); }
+            std::string value(buffer.data() + cursor, length);
+            cursor += length;
+            return value;
+        }
+    };
+}
+
+bool PulseEngine::Cooking::ParseMaterialJson(const nlohmann::json& json, CookedMaterial& out, std::string& error)
+{
+    try
+    {
+        out.name = json.value("name", std::string("new material"));
+        out.guid = json.value("guid", std::string());
+        out.shaderGuid = json.value("shader", std::string("0"));
+        out.specular = json.value("specular", 10.0f);
+        out.hasFlip = json.contains("flip");
+        out.flip = json.value("flip", true);
+
+        if (json.contains("color"))
+        {
+            const nlohmann::json& color = json["color"];
+            if (!color.is_array() || color.size() != 3)
+            {
+                error = "invalid format for 'color'";
+                return false;
+            }
+            for (int i = 0; i < 3; ++i) out.color[i] = color[i].get<float>();
+        }
+
+        out.textures.clear();
+        for (const char* slot : TEXTURE_SLOTS)
+        {
+            if (json.contains(slot))
+                out.textures.push_back({ slot, 0, json[slot].get<std::string>() });
+        }
+    }
+    catch (const std::exception& e)
+    {
+        error = e.what();
+        return false;
+    }
+    return true;
+}
+
+std::string PulseEngine::Cooking::GetCookedMaterialPath(const std::string& sourcePath)
+{
+    return sourcePath + ".pmat";
+}
+
+bool PulseEngine::Cooking::WriteCookedMaterial(const std::string& path, const CookedMaterial& material)
+{
+    BinaryWriter writer;
+    writer.Write(COOKED_MATERIAL_MAGIC);
+    writer.Write(COOKED_MATERIAL_VERSION);
+    writer.WriteString(material.name);
+    writer.WriteString(material.guid);
+    writer.WriteString(material.shaderGuid);
+    for (float channel : material.color) writer.Write(channel);
+    writer.Write(material.specular);
+    writer.Write((uint8_t)material.flip);
+    writer.Write((uint8_t)material.hasFlip);
+    writer.Write((uint32_t)material.textures.size());
+    for (const CookedMaterialTexture& texture : material.textures)
+    {
+        writer.WriteString(texture.slot);
+        writer.Write(texture.guid);
+        writer.WriteString(texture.path);
+    }
+
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (!file.is_open()) return false;
+    file.write(writer.buffer.data(), (std::streamsize)writer.buffer.size());
+    return file.good();
+}
+
+bool PulseEngine::Cooking::ReadCookedMaterial(const std::string& path, CookedMaterial& out)
+{
+    std::ifstream file(path, std::ios::binary);
+    if (!file.is_open()) return false;
+    const std::vector<char> buffer((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    return ReadCookedMaterial(buffer, out);
+}
+
+bool PulseEngine::Cooking::ReadCookedMaterial(const std::vector<char>& buffer, CookedMaterial& out)
+{
+    BinaryReader reader{ buffer };
+    if (reader.Read<uint32_t>() != COOKED_MATERIAL_MAGIC || reader.Read<uint16_t>() != COOKED_MATERIAL_VERSION) return false;
+
+    out.name = reader.ReadString();
+    out.guid = reader.ReadString();
+    out.shaderGuid = reader.ReadString();
+    for (float& channel : out.color) channel = reader.Read<float>();
+    out.specular = reader.Read<float>();
+    out.flip = reader.Read<uint8_t>() != 0;
+    out.hasFlip = reader.Read<uint8_t>() != 0;
+
+    const uint32_t textureCount = reader.Read<uint32_t>();
+    out.textures.clear();
+    for (uint32_t i = 0; i < textureCount && !reader.failed; ++i)
+    {
+        CookedMaterialTexture texture;
+        texture.slot = reader.ReadString();
+        texture.guid = reader.Read<uint64_t>();
+        texture.path = reader.ReadString();
+        out.textures.push_back(texture);
+    }
+    return !reader.failed;
+}
+
+bool PulseEngine::Cooking::CookMaterial(const std::string& sourcePath, const std::string& destinationPath, const TextureGuidResolver& resolveTexture,
+                                        std::string& error, std::vector<std::string>* outTextures)
+{
+    std::ifstream file(sourcePath);
+    if (!file.is_open())
+    {
+        error = "can't open " + sourcePath;
+        return false;
+    }
+
+    CookedMaterial material;
+    try
+    {
+        nlohmann::json json;
+        file >> json;
+        if (!ParseMaterialJson(json, material, error)) return false;
+    }
+    catch (const std::exception& e)
+    {
+        error = sourcePath + ": " + e.what();
+        return false;
+    }
+
+    for (CookedMaterialTexture& texture : material.textures)
+    {
+        if (resolveTexture) texture.guid = resolveTexture(texture.path);
+        if (outTextures) outTextures->push_back(texture.path);
+    }
+
+    std::error_code ec;
+    const std::filesystem::path destination(destinationPath);
+    if (destination.has_parent_path()) std::filesystem::create_directories(destination.parent_path(), ec);
+
+    if (!WriteCookedMaterial(destinationPath, material))
+    {
+        error = "can't write " + destinationPath;
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,79 @@
+/**
+ * @file CookedMaterial.h
+ * @brief Material description shared by the .mat (json, editor) and .pmat (binary, cooked) files.
+ * @details The game build cooks "Materials/cube.mat" into "Materials/cube.mat.pmat" : shader GUID, scalar parameters
+ * and texture references in a few hundred bytes, read without any json parsing.
+ * Textures are stored by GUID (guidCollectionTextures.puid) when they are registered, the path is kept as fallback.
+ *
+ * Layout (little endian) : magic "PMAT", uint16 version, then the fields in declaration order,
+ * strings as uint32 length + bytes.
+ * @version 0.1
+ * @date 2025-12-10
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+#ifndef COOKEDMATERIAL_H
+#define COOKEDMATERIAL_H
+
+#include "Common/dllExport.h"
+#include "json.hpp"
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace PulseEngine::Cooking
+{
+    constexpr uint32_t COOKED_MATERIAL_MAGIC = 0x54414D50; // "PMAT"
+    constexpr uint16_t COOKED_MATERIAL_VERSION = 1;
+
+    struct CookedMaterialTexture
+    {
+        std::string slot;       ///< "albedo", "normal", "height", "roughness"
+        uint64_t guid = 0;      ///< 0 when the texture is not in the texture collection
+        std::string path;
+    };
+
+    struct CookedMaterial
+    {
+        std::string name;
+        std::string guid;
+        std::string shaderGuid = "0";
+        float color[3] = { 1.0f, 1.0f, 1.0f };
+        float specular = 10.0f;
+        bool flip = true;
+        bool hasFlip = false;   ///< "flip" written in the source, applied to the material
+        std::vector<CookedMaterialTexture> textures;
+    };
+
+    /**
+     * @brief Fill a description from the json of a .mat file. False when a field has the wrong type.
+     */
+    PULSE_ENGINE_DLL_API bool ParseMaterialJson(const nlohmann::json& json, CookedMaterial& out, std::string& error);
+
+    PULSE_ENGINE_DLL_API bool ReadCookedMaterial(const std::vector<char>& bytes, CookedMaterial& out);
+    PULSE_ENGINE_DLL_API bool ReadCookedMaterial(const std::string& path, CookedMaterial& out);
+    PULSE_ENGINE_DLL_API bool WriteCookedMaterial(const std::string& path, const CookedMaterial& material);
+
+    /**
+     * @brief "Materials/cube.mat" -> "Materials/cube.mat.pmat"
+     */
+    PULSE_ENGINE_DLL_API std::string GetCookedMaterialPath(const std::string& sourcePath);
+
+    /**
+     * @brief Texture path (as written in the .mat) -> GUID, 0 when the texture is not registered.
+     */
+    using TextureGuidResolver = std::function<uint64_t(const std::string& texturePath)>;
+
+    /**
+     * @brief Cook a .mat file into a .pmat file.
+     * @param resolveTexture may be empty, the textures are then referenced by path only.
+     * @param outTextures optional, receives the texture paths the material uses (build dependencies).
+     */
+    PULSE_ENGINE_DLL_API bool CookMaterial(const std::string& sourcePath, const std::string& destinationPath, const TextureGuidResolver& resolveTexture,
+                                           std::string& error, std::vector<std::string>* outTextures = nullptr);
+}
+
+#endif // COOKEDMATERIAL_H
@@ -0,0 +1,203 @@
+#include "CookedTexture.h"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+
+using namespace PulseEngine::Cooking;
+
+namespace
+{
+    void FlipColorBlock(uint8_t* block, uint32_t rows)
+    {
+        // 4 bytes of endpoints, then one byte of 2 bit indices per row
+        std::reverse(block + 4, block + 4 + rows);
+    }
+
+    void FlipAlphaBlock(uint8_t* block, uint32_t rows)
+    {
+        // 2 bytes of endpoints, then 16 indices of 3 bits : 12 bits per row
+        uint64_t bits = 0;
+        std::memcpy(&bits, block + 2, 6);
+
+        uint64_t flipped = bits;
+        for (uint32_t r = 0; r < rows; ++r)
+        {
+            const uint64_t row = (bits >> (12 * r)) & 0xFFFu;
+            const uint32_t target = rows - 1 - r;
+            flipped &= ~(0xFFFull << (12 * target));
+            flipped |= row << (12 * target);
+        }
+        std::memcpy(block + 2, &flipped, 6);
+    }
+
+    void FlipBlock(CookedTextureFormat format, uint8_t* block, uint32_t rows)
+    {
+        switch (format)
+        {
+            case CookedTextureFormat::BC1:
+                FlipColorBlock(block, rows);
+                break;
+            case CookedTextureFormat::BC3:
+                FlipAlphaBlock(block, rows);
+                FlipColorBlock(block + 8, rows);
+                break;
+            case CookedTextureFormat::BC5:
+                FlipAlphaBlock(block, rows);
+                FlipAlphaBlock(block + 8, rows);
+                break;
+            default:
+                break;
+        }
+    }
+}
+
+bool PulseEngine::Cooking::IsBlockCompressed(CookedTextureFormat format)
+{
+    return format != CookedTextureFormat::RGBA8;
+}
+
+std::size_t PulseEngine::Cooking::GetBlockBytes(CookedTextureFormat format)
+{
+    switch (format)
+    {
+        case CookedTextureFormat::BC1: return 8;
+        case CookedTextureFormat::BC3:
+        case CookedTextureFormat::BC5:
+        case CookedTextureFormat::BC7: return 16;
+        default: return 4;
+    }
+}
+
+std::size_t PulseEngine::Cooking::GetMipSize(CookedTextureFormat format, uint32_t width, uint32_t height)
+{
+    if (!IsBlockCompressed(format)) return (std::size_t)width * height * 4;
+    return (std::size_t)((width + 3) / 4) * ((height + 3) / 4) * GetBlockBytes(format);
+}
+
+const char* PulseEngine::Cooking::GetCookedTextureFormatName(CookedTextureFormat format)
+{
+    switch (format)
+    {
+        case CookedTextureFormat::RGBA8: return "RGBA8";
+        case CookedTextureFormat::BC1: return "BC1";
+        case CookedTextureFormat::BC3: return "BC3";
+        case CookedTextureFormat::BC5: return "BC5";
+        case CookedTextureFormat::BC7: return "BC7";
+    }
+    return "Unknown";
+}
+
+std::string PulseEngine::Cooking::GetCookedTexturePath(const std::string& sourcePath)
+{
+    return sourcePath + ".ptex";
+}
+
+bool PulseEngine::Cooking::ReadCookedTexture(std::vector<uint8_t> bytes, CookedTexture& out)
+{
+    CookedTextureHeader header;
+    if (bytes.size() < sizeof(header)) return false;
+    std::memcpy(&header, bytes.data(), sizeof(header));
+
+    if (header.magic != COOKED_TEXTURE_MAGIC || header.version != COOKED_TEXTURE_VERSION) return false;
+    if (header.format > (uint16_t)CookedTextureFormat::BC7 || header.mipCount == 0 || header.mipCount > 32) return false;
+    if (bytes.size() < sizeof(header) + header.mipCount * sizeof(CookedMipEntry)) return false;
+
+    out.format = (CookedTextureFormat)header.format;
+    out.width = header.width;
+    out.height = header.height;
+    out.flags = header.flags;
+    out.sourceHash = header.sourceHash;
+    out.mips.resize(header.mipCount);
+    std::memcpy(out.mips.data(), bytes.data() + sizeof(header), header.mipCount * sizeof(CookedMipEntry));
+
+    for (const CookedMipEntry& mip : out.mips)
+    {
+        if (mip.size != GetMipSize(out.format, mip.width, mip.height)) return false;
+        if (mip.offset > bytes.size() || mip.size > bytes.size() - mip.offset) return false;
+    }
+
+    out.data = std::move(bytes);
+    return true;
+}
+
+bool PulseEngine::Cooking::LoadCookedTexture(const std::string& path, CookedTexture& out)
+{
+    std::ifstream file(path, std::ios::binary);
+    if (!file.is_open()) return false;
+
+    std::vector<uint8_t> bytes((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    return ReadCookedTexture(std::move(bytes), out);
+}
+
+bool PulseEngine::Cooking::WriteCookedTexture(const std::string& path, CookedTextureFormat format, uint32_t flags, uint64_t sourceHash,
+                                               const std::vector<CookedMipEntry>& mips, const std::vector<std::vector<uint8_t>>& mipData)
+{
+    if (mips.empty() || mips.size() != mipData.size()) return false;
+
+    CookedTextureHeader header;
+    header.format = (uint16_t)format;
+    header.width = mips[0].width;
+    header.height = mips[0].height;
+    header.mipCount = (uint32_t)mips.size();
+    header.flags = flags;
+    header.sourceHash = sourceHash;
+
+    std::vector<CookedMipEntry> entries = mips;
+    uint64_t offset = sizeof(header) + entries.size() * sizeof(CookedMipEntry);
+    for (std::size_t i = 0; i < entries.size(); ++i)
+    {
+        entries[i].offset = offset;
+        entries[i].size = mipData[i].size();
+        offset += mipData[i].size();
+    }
+
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (!file.is_open()) return false;
+
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    file.write(reinterpret_cast<const char*>(entries.data()), entries.size() * sizeof(CookedMipEntry));
+    for (const std::vector<uint8_t>& level : mipData)
+        file.write(reinterpret_cast<const char*>(level.data()), level.size());
+    return file.good();
+}
+
+bool PulseEngine::Cooking::FlipCookedTexture(CookedTexture& texture)
+{
+    if (texture.format == CookedTextureFormat::BC7) return false;
+    if (IsBlockCompressed(texture.format))
+    {
+        for (const CookedMipEntry& mip : texture.mips)
+        {
+            if (mip.height > 4 && mip.height % 4 != 0) return false;
+        }
+    }
+
+    for (const CookedMipEntry& mip : texture.mips)
+    {
+        uint8_t* level = texture.data.data() + mip.offset;
+
+        if (!IsBlockCompressed(texture.format))
+        {
+            const std::size_t rowBytes = (std::size_t)mip.width * 4;
+            for (uint32_t y = 0; y < mip.height / 2; ++y)
+                std::swap_ranges(level + y * rowBytes, level + (y + 1) * rowBytes, level + (mip.height - 1 - y) * rowBytes);
+            continue;
+        }
+
+        const std::size_t blockBytes = GetBlockBytes(texture.format);
+        const std::size_t rowBytes = (std::size_t)((mip.width + 3) / 4) * blockBytes;
+        const uint32_t blockRows = (mip.height + 3) / 4;
+        const uint32_t rowsInBlock = std::min(4u, mip.height);
+
+        for (uint32_t by = 0; by < blockRows / 2; ++by)
+            std::swap_ranges(level + by * rowBytes, level + (by + 1) * rowBytes, level + (blockRows - 1 - by) * rowBytes);
+
+        for (std::size_t offset = 0; offset < mip.size; offset += blockBytes)
+            FlipBlock(texture.format, level + offset, rowsInBlock);
+    }
+
+    texture.flags ^= COOKED_TEXTURE_FLIPPED;
+    return true;
+}
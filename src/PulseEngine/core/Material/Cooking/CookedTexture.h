@@ -0,0 +1,123 @@
+/**
+ * @file CookedTexture.h
+ * @brief Cooked texture container (.ptex) : the full mip chain, already block compressed, ready to upload.
+ * @details Written by the TextureCooker during the game build, next to where the source image was :
+ * "textures/wood.png" is cooked into "textures/wood.png.ptex", so materials keep referencing the source path.
+ *
+ * Layout (little endian) :
+ * - CookedTextureHeader
+ * - mipCount CookedMipEntry, mip 0 first
+ * - the mip data, offsets relative to the start of the file
+ *
+ * Images are stored with the rows already flipped as the engine loads them by default (hasFlip = true),
+ * FlipCookedTexture handles the other case.
+ * @version 0.1
+ * @date 2025-12-09
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+#ifndef COOKEDTEXTURE_H
+#define COOKEDTEXTURE_H
+
+#include "Common/dllExport.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace PulseEngine::Cooking
+{
+    enum class CookedTextureFormat : uint16_t
+    {
+        RGBA8 = 0,  ///< uncompressed, 4 bytes per texel
+        BC1 = 1,    ///< RGB, 8 bytes per 4x4 block
+        BC3 = 2,    ///< RGBA, 16 bytes per block
+        BC5 = 3,    ///< RG (two channel data, normal maps with a reconstructed Z), 16 bytes per block
+        BC7 = 4     ///< RGBA high quality, 16 bytes per block (needs GL 4.2 / ARB_texture_compression_bptc)
+    };
+
+    constexpr uint32_t COOKED_TEXTURE_MAGIC = 0x58455450; // "PTEX"
+    constexpr uint16_t COOKED_TEXTURE_VERSION = 1;
+    constexpr uint32_t COOKED_TEXTURE_FLIPPED = 1u << 0;
+
+#pragma pack(push, 1)
+    struct CookedTextureHeader
+    {
+        uint32_t magic = COOKED_TEXTURE_MAGIC;
+        uint16_t version = COOKED_TEXTURE_VERSION;
+        uint16_t format = 0;
+        uint32_t width = 0;
+        uint32_t height = 0;
+        uint32_t mipCount = 0;
+        uint32_t flags = 0;
+        uint64_t sourceHash = 0;    ///< hash of the source file, lets the build skip textures that did not change
+    };
+
+    struct CookedMipEntry
+    {
+        uint32_t width = 0;
+        uint32_t height = 0;
+        uint64_t offset = 0;
+        uint64_t size = 0;
+    };
+#pragma pack(pop)
+
+    /**
+     * @brief A cooked texture in memory, mips point into data.
+     */
+    struct PULSE_ENGINE_DLL_API CookedTexture
+    {
+        CookedTextureFormat format = CookedTextureFormat::RGBA8;
+        uint32_t width = 0;
+        uint32_t height = 0;
+        uint32_t flags = 0;
+        uint64_t sourceHash = 0;
+        std::vector<CookedMipEntry> mips;
+        std::vector<uint8_t> data;      ///< the whole file
+
+        const uint8_t* GetMipData(std::size_t mip) const { return data.data() + mips[mip].offset; }
+        bool IsFlipped() const { return (flags & COOKED_TEXTURE_FLIPPED) != 0; }
+    };
+
+    PULSE_ENGINE_DLL_API bool IsBlockCompressed(CookedTextureFormat format);
+    PULSE_ENGINE_DLL_API std::size_t GetBlockBytes(CookedTextureFormat format);
+
+    /**
+     * @brief Bytes of one mip level, a compressed level is padded to whole 4x4 blocks.
+     */
+    PULSE_ENGINE_DLL_API std::size_t GetMipSize(CookedTextureFormat format, uint32_t width, uint32_t height);
+
+    PULSE_ENGINE_DLL_API const char* GetCookedTextureFormatName(CookedTextureFormat format);
+
+    /**
+     * @brief "textures/wood.png" -> "textures/wood.png.ptex"
+     */
+    PULSE_ENGINE_DLL_API std::string GetCookedTexturePath(const std::string& sourcePath);
+
+    /**
+     * @brief Parse a .ptex file already in memory (takes the bytes). False if the file is invalid or truncated.
+     */
+    PULSE_ENGINE_DLL_API bool ReadCookedTexture(std::vector<uint8_t> bytes, CookedTexture& out);
+
+    /**
+     * @brief Read and parse a .ptex file, false (without error) when it does not exist.
+     */
+    PULSE_ENGINE_DLL_API bool LoadCookedTexture(const std::string& path, CookedTexture& out);
+
+    /**
+     * @brief Write a .ptex file from the mip levels, mip 0 first.
+     */
+    PULSE_ENGINE_DLL_API bool WriteCookedTexture(const std::string& path, CookedTextureFormat format, uint32_t flags, uint64_t sourceHash,
+                                                 const std::vector<CookedMipEntry>& mips, const std::vector<std::vector<uint8_t>>& mipData);
+
+    /**
+     * @brief Flip every mip vertically in place (block rows and the rows inside the blocks).
+     * @return false when it can't be done without re-encoding : BC7, or a compressed level taller than 4 texels
+     * whose height is not a multiple of 4. The caller then falls back to the source image.
+     */
+    PULSE_ENGINE_DLL_API bool FlipCookedTexture(CookedTexture& texture);
+}
+
+#endif // COOKEDTEXTURE_H
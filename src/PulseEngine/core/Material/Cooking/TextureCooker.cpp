@@ -0,0 +1,614 @@
+#include "TextureCooker.h"
+#include "PulseEngine/core/GUID/GuidGenerator.h"
+#include "stb_image.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+
+using namespace PulseEngine::Cooking;
+
+namespace
+{
+    // ---------------------------------------------------------------------
+    // Endpoint fitting, shared by BC1 (3 channels) and BC7 (4 channels)
+    // ---------------------------------------------------------------------
+
+    struct BlockTexels
+    {
+        float px[16][4];
+    };
+
+    BlockTexels ToFloat(const uint8_t* texels)
+    {
+        BlockTexels block;
+        for (int i = 0; i < 16; ++i)
+            for (int c = 0; c < 4; ++c)
+                block.px[i][c] = texels[i * 4 + c];
+        return block;
+    }
+
+    /**
+     * @brief Endpoints at both ends of the principal axis of the texels (C first channels).
+     */
+    template <int C>
+    void FitPrincipalAxis(const BlockTexels& block, float* e0, float* e1)
+    {
+        float mean[C] = {};
+        float minV[C], maxV[C];
+        for (int c = 0; c < C; ++c) { minV[c] = 255.0f; maxV[c] = 0.0f; }
+        for (int i = 0; i < 16; ++i)
+        {
+            for (int c = 0; c < C; ++c)
+            {
+                mean[c] += block.px[i][c];
+                minV[c] = std::min(minV[c], block.px[i][c]);
+                maxV[c] = std::max(maxV[c], block.px[i][c]);
+            }
+        }
+        for (int c = 0; c < C; ++c) mean[c] /= 16.0f;
+
+        float cov[C][C] = {};
+        for (int i = 0; i < 16; ++i)
+        {
+            for (int a = 0; a < C; ++a)
+                for (int b = 0; b < C; ++b)
+                    cov[a][b] += (block.px[i][a] - mean[a]) * (block.px[i][b] - mean[b]);
+        }
+
+        // power iteration, starting from the bounding box diagonal
+        float axis[C];
+        for (int c = 0; c < C; ++c) axis[c] = maxV[c] - minV[c];
+        for (int iteration = 0; iteration < 8; ++iteration)
+        {
+            float next[C] = {};
+            for (int a = 0; a < C; ++a)
+                for (int b = 0; b < C; ++b)
+                    next[a] += cov[a][b] * axis[b];
+
+            float length = 0.0f;
+            for (int c = 0; c < C; ++c) length += next[c] * next[c];
+            if (length < 1e-12f) break;
+            length = 1.0f / std::sqrt(length);
+            for (int c = 0; c < C; ++c) axis[c] = next[c] * length;
+        }
+
+        float length = 0.0f;
+        for (int c = 0; c < C; ++c) length += axis[c] * axis[c];
+        if (length < 1e-12f)
+        {
+            // flat block
+            for (int c = 0; c < C; ++c) e0[c] = e1[c] = mean[c];
+            return;
+        }
+        length = 1.0f / std::sqrt(length);
+        for (int c = 0; c < C; ++c) axis[c] *= length;
+
+        float tMin = 1e30f, tMax = -1e30f;
+        for (int i = 0; i < 16; ++i)
+        {
+            float t = 0.0f;
+            for (int c = 0; c < C; ++c) t += (block.px[i][c] - mean[c]) * axis[c];
+            tMin = std::min(tMin, t);
+            tMax = std::max(tMax, t);
+        }
+        for (int c = 0; c < C; ++c)
+        {
+            e0[c] = std::clamp(mean[c] + axis[c] * tMax, 0.0f, 255.0f);
+            e1[c] = std::clamp(mean[c] + axis[c] * tMin, 0.0f, 255.0f);
+        }
+    }
+
+    /**
+     * @brief Least squares endpoints for the chosen indices, weight[i] is the share of e1 in texel i.
+     * @return false when every texel uses the same weight (nothing to solve)
+     */
+    template <int C>
+    bool RefineEndpoints(const BlockTexels& block, const float* weight, float* e0, float* e1)
+    {
+        float a = 0.0f, b = 0.0f, c = 0.0f;
+        float rhs0[C] = {}, rhs1[C] = {};
+        for (int i = 0; i < 16; ++i)
+        {
+            const float w = weight[i];
+            a += (1.0f - w) * (1.0f - w);
+            b += (1.0f - w) * w;
+            c += w * w;
+            for (int k = 0; k < C; ++k)
+            {
+                rhs0[k] += (1.0f - w) * block.px[i][k];
+                rhs1[k] += w * block.px[i][k];
+            }
+        }
+
+        const float det = a * c - b * b;
+        if (std::fabs(det) < 1e-6f) return false;
+
+        for (int k = 0; k < C; ++k)
+        {
+            e0[k] = std::clamp((c * rhs0[k] - b * rhs1[k]) / det, 0.0f, 255.0f);
+            e1[k] = std::clamp((a * rhs1[k] - b * rhs0[k]) / det, 0.0f, 255.0f);
+        }
+        return true;
+    }
+
+    // ---------------------------------------------------------------------
+    // BC1 color block
+    // ---------------------------------------------------------------------
+
+    uint16_t Pack565(const float* color)
+    {
+        const int r = (int)std::lround(color[0] * 31.0f / 255.0f);
+        const int g = (int)std::lround(color[1] * 63.0f / 255.0f);
+        const int b = (int)std::lround(color[2] * 31.0f / 255.0f);
+        return (uint16_t)((r << 11) | (g << 5) | b);
+    }
+
+    void Unpack565(uint16_t packed, int* color)
+    {
+        const int r = (packed >> 11) & 31, g = (packed >> 5) & 63, b = packed & 31;
+        color[0] = (r << 3) | (r >> 2);
+        color[1] = (g << 2) | (g >> 4);
+        color[2] = (b << 3) | (b >> 2);
+    }
+
+    /**
+     * @brief Quantize the endpoints, pick the indices and write the block.
+     * @return squared error of the block
+     */
+    int WriteColorBlock(const BlockTexels& block, const float* e0, const float* e1, uint8_t* out, float* outWeights)
+    {
+        uint16_t c0 = Pack565(e0), c1 = Pack565(e1);
+        if (c0 < c1) std::swap(c0, c1);
+
+        int palette[4][3];
+        Unpack565(c0, palette[0]);
+        Unpack565(c1, palette[1]);
+        for (int k = 0; k < 3; ++k)
+        {
+            palette[2][k] = (2 * palette[0][k] + palette[1][k]) / 3;
+            palette[3][k] = (palette[0][k] + 2 * palette[1][k]) / 3;
+        }
+        static const float WEIGHTS[4] = { 0.0f, 1.0f, 1.0f / 3.0f, 2.0f / 3.0f };
+
+        // c0 == c1 is the 3 color mode, index 0 only
+        const int paletteSize = c0 == c1 ? 1 : 4;
+
+        uint32_t indices = 0;
+        int error = 0;
+        for (int i = 0; i < 16; ++i)
+        {
+            int best = 0, bestError = INT32_MAX;
+            for (int p = 0; p < paletteSize; ++p)
+            {
+                int e = 0;
+                for (int k = 0; k < 3; ++k)
+                {
+                    const int d = (int)block.px[i][k] - palette[p][k];
+                    e += d * d;
+                }
+                if (e < bestError) { bestError = e; best = p; }
+            }
+            indices |= (uint32_t)best << (2 * i);
+            error += bestError;
+            if (outWeights) outWeights[i] = WEIGHTS[best];
+        }
+
+        out[0] = (uint8_t)(c0 & 0xFF); out[1] = (uint8_t)(c0 >> 8);
+        out[2] = (uint8_t)(c1 & 0xFF); out[3] = (uint8_t)(c1 >> 8);
+        std::memcpy(out + 4, &indices, 4);
+        return error;
+    }
+
+    void EncodeColorBlock(const BlockTexels& block, uint8_t* out)
+    {
+        float e0[3], e1[3], weights[16];
+        FitPrincipalAxis<3>(block, e0, e1);
+        int bestError = WriteColorBlock(block, e0, e1, out, weights);
+
+        uint8_t candidate[8];
+        for (int iteration = 0; iteration < 2 && bestError > 0; ++iteration)
+        {
+            if (!RefineEndpoints<3>(block, weights, e0, e1)) break;
+            float candidateWeights[16];
+            const int error = WriteColorBlock(block, e0, e1, candidate, candidateWeights);
+            if (error >= bestError) break;
+            bestError = error;
+            std::memcpy(out, candidate, 8);
+            std::memcpy(weights, candidateWeights, sizeof(weights));
+        }
+    }
+
+    // ---------------------------------------------------------------------
+    // BC4 single channel block (BC3 alpha, BC5 red and green)
+    // ---------------------------------------------------------------------
+
+    void EncodeChannelBlock(const uint8_t* texels, int channel, uint8_t* out)
+    {
+        int minV = 255, maxV = 0;
+        for (int i = 0; i < 16; ++i)
+        {
+            minV = std::min(minV, (int)texels[i * 4 + channel]);
+            maxV = std::max(maxV, (int)texels[i * 4 + channel]);
+        }
+
+        out[0] = (uint8_t)maxV;
+        out[1] = (uint8_t)minV;
+        uint64_t bits = 0;
+
+        if (maxV != minV)
+        {
+            // a0 > a1 : 8 values mode
+            int palette[8];
+            palette[0] = maxV;
+            palette[1] = minV;
+            for (int i = 2; i < 8; ++i)
+                palette[i] = ((8 - i) * maxV + (i - 1) * minV) / 7;
+
+            for (int i = 0; i < 16; ++i)
+            {
+                const int v = texels[i * 4 + channel];
+                int best = 0, bestError = INT32_MAX;
+                for (int p = 0; p < 8; ++p)
+                {
+                    const int e = std::abs(v - palette[p]);
+                    if (e < bestError) { bestError = e; best = p; }
+                }
+                bits |= (uint64_t)best << (3 * i);
+            }
+        }
+        std::memcpy(out + 2, &bits, 6);
+    }
+
+    // ---------------------------------------------------------------------
+    // BC7 mode 6 : 7 bit RGBA endpoints + one p-bit each, 4 bit indices
+    // ---------------------------------------------------------------------
+
+    constexpr int BC7_WEIGHTS[16] = { 0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64 };
+
+    struct BC7Endpoint
+    {
+        int value[4];   ///< 7 bits
+        int pBit;
+    };
+
+    /**
+     * @brief Best 7 bit + p-bit encoding of an endpoint, the p-bit is shared by the 4 channels.
+     */
+    BC7Endpoint QuantizeBC7Endpoint(const float* e)
+    {
+        BC7Endpoint best = {};
+        float bestError = 1e30f;
+        for (int p = 0; p < 2; ++p)
+        {
+            BC7Endpoint candidate;
+            candidate.pBit = p;
+            float error = 0.0f;
+            for (int c = 0; c < 4; ++c)
+            {
+                candidate.value[c] = std::clamp((int)std::lround((e[c] - p) / 2.0f), 0, 127);
+                const float d = (float)((candidate.value[c] << 1) | p) - e[c];
+                error += d * d;
+            }
+            if (error < bestError) { bestError = error; best = candidate; }
+        }
+        return best;
+    }
+
+    struct BC7Candidate
+    {
+        BC7Endpoint endpoints[2];
+        int indices[16];
+        int error;
+    };
+
+    void PickBC7Indices(const BlockTexels& block, BC7Candidate& candidate)
+    {
+        int e[2][4];
+        for (int k = 0; k < 2; ++k)
+            for (int c = 0; c < 4; ++c)
+                e[k][c] = (candidate.endpoints[k].value[c] << 1) | candidate.endpoints[k].pBit;
+
+        int palette[16][4];
+        for (int i = 0; i < 16; ++i)
+            for (int c = 0; c < 4; ++c)
+                palette[i][c] = ((64 - BC7_WEIGHTS[i]) * e[0][c] + BC7_WEIGHTS[i] * e[1][c] + 32) >> 6;
+
+        candidate.error = 0;
+        for (int i = 0; i < 16; ++i)
+        {
+            int best = 0, bestError = INT32_MAX;
+            for (int p = 0; p < 16; ++p)
+            {
+                int err = 0;
+                for (int c = 0; c < 4; ++c)
+                {
+                    const int d = (int)block.px[i][c] - palette[p][c];
+                    err += d * d;
+                }
+                if (err < bestError) { bestError = err; best = p; }
+            }
+            candidate.indices[i] = best;
+            candidate.error += bestError;
+        }
+    }
+
+    struct BitWriter
+    {
+        uint8_t* out;
+        int position = 0;
+
+        void Write(uint32_t value, int count)
+        {
+            for (int i = 0; i < count; ++i, ++position)
+            {
+                if ((value >> i) & 1u) out[position >> 3] |= (uint8_t)(1u << (position & 7));
+            }
+        }
+    };
+
+    void EncodeBC7Mode6(const BlockTexels& block, uint8_t* out)
+    {
+        float e0[4], e1[4];
+        FitPrincipalAxis<4>(block, e0, e1);
+
+        BC7Candidate best;
+        best.endpoints[0] = QuantizeBC7Endpoint(e0);
+        best.endpoints[1] = QuantizeBC7Endpoint(e1);
+        PickBC7Indices(block, best);
+
+        for (int iteration = 0; iteration < 2 && best.error > 0; ++iteration)
+        {
+            float weights[16];
+            for (int i = 0; i < 16; ++i) weights[i] = BC7_WEIGHTS[best.indices[i]] / 64.0f;
+            if (!RefineEndpoints<4>(block, weights, e0, e1)) break;
+
+            BC7Candidate candidate;
+            candidate.endpoints[0] = QuantizeBC7Endpoint(e0);
+            candidate.endpoints[1] = QuantizeBC7Endpoint(e1);
+            PickBC7Indices(block, candidate);
+            if (candidate.error >= best.error) break;
+            best = candidate;
+        }
+
+        // the anchor index (texel 0) is stored on 3 bits : its top bit must be 0
+        if (best.indices[0] & 8)
+        {
+            std::swap(best.endpoints[0], best.endpoints[1]);
+            for (int& index : best.indices) index = 15 - index;
+        }
+
+        std::memset(out, 0, 16);
+        BitWriter writer{ out };
+        writer.Write(1u << 6, 7);   // mode 6
+        for (int c = 0; c < 4; ++c)
+        {
+            writer.Write((uint32_t)best.endpoints[0].value[c], 7);
+            writer.Write((uint32_t)best.endpoints[1].value[c], 7);
+        }
+        writer.Write((uint32_t)best.endpoints[0].pBit, 1);
+        writer.Write((uint32_t)best.endpoints[1].pBit, 1);
+        writer.Write((uint32_t)best.indices[0], 3);
+        for (int i = 1; i < 16; ++i)
+            writer.Write((uint32_t)best.indices[i], 4);
+    }
+
+    // ---------------------------------------------------------------------
+    // Levels
+    // ---------------------------------------------------------------------
+
+    std::vector<uint8_t> Downsample(const std::vector<uint8_t>& source, uint32_t width, uint32_t height, uint32_t& outWidth, uint32_t& outHeight)
+    {
+        outWidth = std::max(1u, width / 2);
+        outHeight = std::max(1u, height / 2);
+        std::vector<uint8_t> result((std::size_t)outWidth * outHeight * 4);
+
+        for (uint32_t y = 0; y < outHeight; ++y)
+        {
+            const uint32_t y0 = std::min(2 * y, height - 1), y1 = std::min(2 * y + 1, height - 1);
+            for (uint32_t x = 0; x < outWidth; ++x)
+            {
+                const uint32_t x0 = std::min(2 * x, width - 1), x1 = std::min(2 * x + 1, width - 1);
+                for (int c = 0; c < 4; ++c)
+                {
+                    const int sum = source[((std::size_t)y0 * width + x0) * 4 + c] + source[((std::size_t)y0 * width + x1) * 4 + c]
+                                  + source[((std::size_t)y1 * width + x0) * 4 + c] + source[((std::size_t)y1 * width + x1) * 4 + c];
+                    result[((std::size_t)y * outWidth + x) * 4 + c] = (uint8_t)((sum + 2) / 4);
+                }
+            }
+        }
+        return result;
+    }
+
+    std::vector<uint8_t> EncodeLevel(const std::vector<uint8_t>& rgba, uint32_t width, uint32_t height, CookedTextureFormat format)
+    {
+        if (format == CookedTextureFormat::RGBA8) return rgba;
+
+        const std::size_t blockBytes = GetBlockBytes(format);
+        const uint32_t blocksX = (width + 3) / 4, blocksY = (height + 3) / 4;
+        std::vector<uint8_t> result((std::size_t)blocksX * blocksY * blockBytes);
+
+        uint8_t texels[64];
+        for (uint32_t by = 0; by < blocksY; ++by)
+        {
+            for (uint32_t bx = 0; bx < blocksX; ++bx)
+            {
+                // the texels past the border repeat the last row / column
+                for (uint32_t ty = 0; ty < 4; ++ty)
+                {
+                    const uint32_t y = std::min(by * 4 + ty, height - 1);
+                    for (uint32_t tx = 0; tx < 4; ++tx)
+                    {
+                        const uint32_t x = std::min(bx * 4 + tx, width - 1);
+                        std::memcpy(texels + (ty * 4 + tx) * 4, rgba.data() + ((std::size_t)y * width + x) * 4, 4);
+                    }
+                }
+
+                uint8_t* block = result.data() + ((std::size_t)by * blocksX + bx) * blockBytes;
+                switch (format)
+                {
+                    case CookedTextureFormat::BC1: EncodeBC1Block(texels, block); break;
+                    case CookedTextureFormat::BC3: EncodeBC3Block(texels, block); break;
+                    case CookedTextureFormat::BC5: EncodeBC5Block(texels, block); break;
+                    case CookedTextureFormat::BC7: EncodeBC7Block(texels, block); break;
+                    default: break;
+                }
+            }
+        }
+        return result;
+    }
+
+    CookedTextureFormat ChooseFormat(const uint8_t* rgba, std::size_t texelCount, TextureCompression compression)
+    {
+        switch (compression)
+        {
+            case TextureCompression::None: return CookedTextureFormat::RGBA8;
+            case TextureCompression::BC1: return CookedTextureFormat::BC1;
+            case TextureCompression::BC3: return CookedTextureFormat::BC3;
+            case TextureCompression::BC5: return CookedTextureFormat::BC5;
+            case TextureCompression::BC7: return CookedTextureFormat::BC7;
+            case TextureCompression::Auto: break;
+        }
+
+        for (std::size_t i = 0; i < texelCount; ++i)
+        {
+            if (rgba[i * 4 + 3] != 255) return CookedTextureFormat::BC3;
+        }
+        return CookedTextureFormat::BC1;
+    }
+
+    /**
+     * @brief Hash stored in the cooked file : source bytes + everything that changes the output.
+     */
+    uint64_t HashCookSource(const std::vector<uint8_t>& bytes, const TextureCookOptions& options)
+    {
+        const uint8_t settings[4] = { (uint8_t)options.compression, (uint8_t)options.generateMips, (uint8_t)options.flip, (uint8_t)COOKED_TEXTURE_VERSION };
+        return PulseEngine::Registry::HashContent(settings, sizeof(settings), PulseEngine::Registry::HashContent(bytes.data(), bytes.size()));
+    }
+
+    bool ReadCookedHeader(const std::string& path, CookedTextureHeader& header)
+    {
+        std::ifstream file(path, std::ios::binary);
+        if (!file.is_open()) return false;
+        file.read(reinterpret_cast<char*>(&header), sizeof(header));
+        return file.gcount() == sizeof(header) && header.magic == COOKED_TEXTURE_MAGIC && header.version == COOKED_TEXTURE_VERSION;
+    }
+}
+
+void PulseEngine::Cooking::EncodeBC1Block(const uint8_t* texels, uint8_t* outBlock)
+{
+    EncodeColorBlock(ToFloat(texels), outBlock);
+}
+
+void PulseEngine::Cooking::EncodeBC3Block(const uint8_t* texels, uint8_t* outBlock)
+{
+    EncodeChannelBlock(texels, 3, outBlock);
+    EncodeColorBlock(ToFloat(texels), outBlock + 8);
+}
+
+void PulseEngine::Cooking::EncodeBC5Block(const uint8_t* texels, uint8_t* outBlock)
+{
+    EncodeChannelBlock(texels, 0, outBlock);
+    EncodeChannelBlock(texels, 1, outBlock + 8);
+}
+
+void PulseEngine::Cooking::EncodeBC7Block(const uint8_t* texels, uint8_t* outBlock)
+{
+    EncodeBC7Mode6(ToFloat(texels), outBlock);
+}
+
+bool PulseEngine::Cooking::IsCookableTexture(const std::string& extension)
+{
+    std::string ext = extension;
+    std::transform(ext.begin(), ext.end(), ext.begin(), [](unsigned char c) { return (char)std::tolower(c); });
+    return ext == ".png" || ext == ".jpg" || ext == ".jpeg" || ext == ".tga" || ext == ".bmp";
+}
+
+CookedTextureFormat PulseEngine::Cooking::CookTexturePixels(const uint8_t* rgba, uint32_t width, uint32_t height, const TextureCookOptions& options,
+                                                            std::vector<CookedMipEntry>& outMips, std::vector<std::vector<uint8_t>>& outMipData)
+{
+    const CookedTextureFormat format = ChooseFormat(rgba, (std::size_t)width * height, options.compression);
+
+    outMips.clear();
+    outMipData.clear();
+
+    std::vector<uint8_t> level(rgba, rgba + (std::size_t)width * height * 4);
+    uint32_t levelWidth = width, levelHeight = height;
+    while (true)
+    {
+        CookedMipEntry mip;
+        mip.width = levelWidth;
+        mip.height = levelHeight;
+        outMipData.push_back(EncodeLevel(level, levelWidth, levelHeight, format));
+        mip.size = outMipData.back().size();
+        outMips.push_back(mip);
+
+        if (!options.generateMips || (levelWidth == 1 && levelHeight == 1)) break;
+        level = Downsample(level, levelWidth, levelHeight, levelWidth, levelHeight);
+    }
+    return format;
+}
+
+TextureCookResult PulseEngine::Cooking::CookTexture(const std::string& sourcePath, const std::string& destinationPath, const TextureCookOptions& options)
+{
+    TextureCookResult result;
+
+    std::ifstream file(sourcePath, std::ios::binary);
+    if (!file.is_open())
+    {
+        result.error = "can't open " + sourcePath;
+        return result;
+    }
+    std::vector<uint8_t> bytes((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    result.sourceBytes = bytes.size();
+
+    const uint64_t sourceHash = HashCookSource(bytes, options);
+
+    CookedTextureHeader existing;
+    if (ReadCookedHeader(destinationPath, existing) && existing.sourceHash == sourceHash)
+    {
+        result.success = true;
+        result.upToDate = true;
+        result.format = (CookedTextureFormat)existing.format;
+        result.width = existing.width;
+        result.height = existing.height;
+        result.mipCount = existing.mipCount;
+        std::error_code ec;
+        result.cookedBytes = (std::size_t)std::filesystem::file_size(destinationPath, ec);
+        return result;
+    }
+
+    int width = 0, height = 0, channels = 0;
+    stbi_set_flip_vertically_on_load_thread(options.flip);
+    unsigned char* rgba = stbi_load_from_memory(bytes.data(), (int)bytes.size(), &width, &height, &channels, 4);
+    if (!rgba)
+    {
+        result.error = std::string("can't decode ") + sourcePath + " (" + stbi_failure_reason() + ")";
+        return result;
+    }
+
+    std::vector<CookedMipEntry> mips;
+    std::vector<std::vector<uint8_t>> mipData;
+    result.format = CookTexturePixels(rgba, (uint32_t)width, (uint32_t)height, options, mips, mipData);
+    stbi_image_free(rgba);
+
+    std::error_code ec;
+    const std::filesystem::path destination(destinationPath);
+    if (destination.has_parent_path()) std::filesystem::create_directories(destination.parent_path(), ec);
+
+    if (!WriteCookedTexture(destinationPath, result.format, options.flip ? COOKED_TEXTURE_FLIPPED : 0, sourceHash, mips, mipData))
+    {
+        result.error = "can't write " + destinationPath;
+        return result;
+    }
+
+    result.success = true;
+    result.width = (uint32_t)width;
+    result.height = (uint32_t)height;
+    result.mipCount = (uint32_t)mips.size();
+    result.cookedBytes = (std::size_t)std::filesystem::file_size(destinationPath, ec);
+    return result;
+}
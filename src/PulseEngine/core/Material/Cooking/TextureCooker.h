@@ -0,0 +1,90 @@
+/**
+ * @file TextureCooker.h
+ * @brief Offline texture cooking : source image (png, jpg...) -> .ptex with a full mip chain, block compressed on the CPU.
+ * @details Run by the game build on every texture of the project. At runtime the graphic API uploads the cooked
+ * levels as they are : no image decoding, no glGenerateMipmap, and 4 to 8 times less VRAM than RGBA8.
+ * - BC1 for opaque images, BC3 when the alpha is used (Auto), BC5 for two channel data, BC7 for the best color quality.
+ * - Mips are a 2x2 box filter of the previous level.
+ * - Encoders : principal axis endpoints refined by least squares, then the nearest palette entry per texel.
+ *   BC7 only uses mode 6 (one subset, RGBA, 16 levels) : much better than BC1 on color gradients and much simpler
+ *   than a full mode search, but BC3 stays better when the alpha does not follow the color (cutouts, icons).
+ *
+ * Cooking is thread safe, several textures can be cooked at the same time.
+ * @version 0.1
+ * @date 2025-12-09
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+#ifndef TEXTURECOOKER_H
+#define TEXTURECOOKER_H
+
+#include "Common/dllExport.h"
+#include "PulseEngine/core/Material/Cooking/CookedTexture.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace PulseEngine::Cooking
+{
+    enum class TextureCompression
+    {
+        Auto,   ///< BC1 when every texel is opaque, BC3 otherwise
+        None,   ///< RGBA8, mips only
+        BC1,
+        BC3,
+        BC5,
+        BC7
+    };
+
+    struct TextureCookOptions
+    {
+        TextureCompression compression = TextureCompression::Auto;
+        bool generateMips = true;
+        bool flip = true;   ///< same default as the materials
+    };
+
+    struct TextureCookResult
+    {
+        bool success = false;
+        bool upToDate = false;  ///< the destination was already cooked from the same source and options, nothing written
+        CookedTextureFormat format = CookedTextureFormat::RGBA8;
+        uint32_t width = 0;
+        uint32_t height = 0;
+        uint32_t mipCount = 0;
+        std::size_t sourceBytes = 0;
+        std::size_t cookedBytes = 0;
+        std::string error;
+    };
+
+    /**
+     * @brief Extensions the cooker can read (stb_image ones), with the dot : ".png".
+     */
+    PULSE_ENGINE_DLL_API bool IsCookableTexture(const std::string& extension);
+
+    /**
+     * @brief Build the mip chain of an RGBA8 image and compress every level.
+     * @param rgba width * height * 4 bytes, rows in the order they will be uploaded.
+     */
+    PULSE_ENGINE_DLL_API CookedTextureFormat CookTexturePixels(const uint8_t* rgba, uint32_t width, uint32_t height, const TextureCookOptions& options,
+                                                               std::vector<CookedMipEntry>& outMips, std::vector<std::vector<uint8_t>>& outMipData);
+
+    /**
+     * @brief Cook one image file into a .ptex file. Skipped when the destination already matches the source.
+     * @param sourcePath path of the image on disk.
+     * @param destinationPath usually GetCookedTexturePath(the copied source path).
+     */
+    PULSE_ENGINE_DLL_API TextureCookResult CookTexture(const std::string& sourcePath, const std::string& destinationPath, const TextureCookOptions& options = TextureCookOptions());
+
+    /**
+     * @brief Block encoders, 16 RGBA texels (row major) in, one block out.
+     */
+    PULSE_ENGINE_DLL_API void EncodeBC1Block(const uint8_t* texels, uint8_t* outBlock);
+    PULSE_ENGINE_DLL_API void EncodeBC3Block(const uint8_t* texels, uint8_t* outBlock);
+    PULSE_ENGINE_DLL_API void EncodeBC5Block(const uint8_t* texels, uint8_t* outBlock);
+    PULSE_ENGINE_DLL_API void EncodeBC7Block(const uint8_t* texels, uint8_t* outBlock);
+}
+
+#endif // TEXTURECOOKER_H
@@ -1,5 +1,6 @@
 #include "Material.h"
 #include "shader.h"
+#include "Texture.h"
 
 
 Shader *Material::GetShader()
@@ -12,3 +13,22 @@ void Material::SetShader(Shader * shader)
     {
         this->shader = shader;
     }
+
+void Material::BindTextures(Shader* shader) const
+{
+    if (auto albedoTex = GetTexture("albedo"))
+    {
+        albedoTex->Bind(6);
+        shader->SetInt("albedoMap", 6);
+    }
+    if (auto normalTex = GetTexture("normal"))
+    {
+        normalTex->Bind(7);
+        shader->SetInt("normalMap", 7);
+    }
+    if (auto roughnessTex = GetTexture("roughness"))
+    {
+        roughnessTex->Bind(8);
+        shader->SetInt("roughnessMap", 8);
+    }
+}
@@ -8,6 +8,7 @@
 
 #include "Common/dllExport.h"
 #include "PulseEngine/core/Math/Vector.h"
+#include "PulseEngine/core/Graphics/PipelineState.h"
 
 class Shader;
 class Texture;
@@ -27,6 +28,8 @@ public:
     float specular = 10.0f;
     std::string guid;
     PulseEngine::Vector3 color = PulseEngine::Vector3(1.0f, 1.0f, 1.0f);
+    /// @brief Depth, blend and cull of the objects drawn with this material, set in one call before them.
+    PipelineState pipelineState;
 
     // --- Textures ---
     void SetTexture(const std::string& type, std::shared_ptr<Texture> texture)
@@ -51,6 +54,9 @@ public:
         return textures;
     }
 
+    /// @brief Bind the albedo, normal and roughness maps (units 6 to 8) and point the samplers of shader at them.
+    void BindTextures(Shader* shader) const;
+
     std::string GetPath() const {return path;}
     void SetPath(const std::string& path) { this->path = path; }
 
@@ -1,112 +1,159 @@
 #include "Common/common.h"
 #include "MaterialManager.h"
 #include "Material.h"
-#include <fstream>
 #include "json.hpp"
 #include "PulseEngine/core/GUID/GuidCollection.h"
 #include "PulseEngine/core/Material/Texture.h"
+#include "PulseEngine/core/Material/TextureManager.h"
 #include "PulseEngine/core/Material/ShaderManager.h"
+#include "PulseEngine/core/Material/Cooking/CookedMaterial.h"
+#include "PulseEngine/core/FileManager/Pak/PakManager.h"
 
 std::unordered_map<std::string, Material*> MaterialManager::materials;
+std::unordered_map<std::string, Material*> MaterialManager::materialsByPath;
+std::unordered_map<std::string, Material*> MaterialManager::materialsByGuid;
 
 
 Material* MaterialManager::loadMaterial(const std::string &filePath)
 {
+    const std::string key = NormalizePath(filePath);
+    auto cached = materialsByPath.find(key);
+    if (cached != materialsByPath.end()) return cached->second;
 
-    // integrate "shared asset system" here
-    // -> hash content into a .mpak file during the building in game engine
-    // -> use the hashed filePath to load the material
+    PulseEngine::Cooking::CookedMaterial description;
+    bool loaded = false;
 
-    #ifdef ENGINE_EDITOR
-    //here we will use the std::ifstream system, because of engine
-    #else
-    //here, we are using the shared asset system to get the hashed and turn it into a readable json
-    #endif
-    std::ifstream file(std::string(ASSET_PATH) + filePath);
-    if(!file.is_open())
-    {
-        EDITOR_ERROR("Failed to open material file: " + filePath);
-        return nullptr;
-    }
-    nlohmann::json jsonData;
-    file >> jsonData;
+    std::vector<char> content;
 
-    
-    if(materials[jsonData["name"]]) return materials[jsonData["name"]];
+    #ifndef ENGINE_EDITOR
+    // game build : binary material written by the cooker, no json parsing
+    loaded = PulseEngine::FileSystem::ReadAssetFile(PulseEngine::Cooking::GetCookedMaterialPath(filePath), content)
+          && PulseEngine::Cooking::ReadCookedMaterial(content, description);
+    #endif
 
-    Shader* shader = ShaderManager::GetInstance().GetShaderInstance(jsonData.value("shader", "0"));
-    Material* material = new Material("new material", shader);
-    if (!file.is_open())
+    if (!loaded)
     {
-        throw std::runtime_error("Failed to open material file: " + filePath);
-    }
-
-    material->SetPath(filePath);
+        if(!PulseEngine::FileSystem::ReadAssetFile(filePath, content))
+        {
+            EDITOR_ERROR("Failed to open material file: " + filePath);
+            return nullptr;
+        }
 
-    if(jsonData.contains("flip"))
-    {
-        material->SetYflip(jsonData["flip"].get<bool>());
-    }
-    
-    if(jsonData.contains("name"))
-    {
-        material->SetName(jsonData["name"]);
-    }
-    if(jsonData.contains("color"))
-    {
-        if (jsonData["color"].is_array() && jsonData["color"].size() == 3)
+        std::string error;
+        try
         {
-            material->color = PulseEngine::Vector3(
-                jsonData["color"][0].get<float>(),
-                jsonData["color"][1].get<float>(),
-                jsonData["color"][2].get<float>()
-            );
+            nlohmann::json jsonData = nlohmann::json::parse(content.begin(), content.end());
+            loaded = PulseEngine::Cooking::ParseMaterialJson(jsonData, description, error);
         }
-        else
+        catch (const std::exception& e)
         {
-            throw std::runtime_error("Invalid format for 'color' in material file: " + filePath);
+            error = e.what();
+        }
+        if (!loaded)
+        {
+            EDITOR_ERROR("Invalid material file " + filePath + ": " + error);
+            return nullptr;
         }
-    }
-    if(jsonData.contains("specular"))
-    {
-        material->specular = jsonData["specular"].get<float>();
     }
 
-    if(jsonData.contains("albedo"))
+    // two files with the same material name share the first one loaded, as before the path cache
+    auto sameName = materials.find(description.name);
+    if (sameName != materials.end() && sameName->second)
     {
-        Texture* albedoTexture = new Texture(jsonData["albedo"].get<std::string>(), PulseEngineGraphicsAPI, jsonData.value("flip", true));
-        material->SetTexture("albedo", std::shared_ptr<Texture>(albedoTexture));
+        materialsByPath[key] = sameName->second;
+        return sameName->second;
     }
-    if(jsonData.contains("normal"))
+
+    Material* material = CreateMaterial(filePath, description);
+    materials[material->GetName()] = material;
+    materialsByPath[key] = material;
+    if (!material->guid.empty()) materialsByGuid[material->guid] = material;
+
+    PulseEngineInstance->guidCollections["guidCollectionMaterials.puid"]->InsertFile(filePath);
+    return material;
+}
+
+Material *MaterialManager::getMaterial(const std::string &materialName)
+{
+    auto it = materials.find(materialName);
+    if(it != materials.end()) return it->second;
+    return nullptr;
+}
+
+Material* MaterialManager::GetMaterialFromGuid(const std::string& guid)
+{
+    auto cached = materialsByGuid.find(guid);
+    if (cached != materialsByGuid.end()) return cached->second;
+
+    auto collection = PulseEngineInstance->guidCollections.find("guidCollectionMaterials.puid");
+    if (collection == PulseEngineInstance->guidCollections.end() || !collection->second) return nullptr;
+
+    const std::string path = collection->second->GetFilePathFromGuid(guid);
+    if (path.empty())
     {
-        
-        Texture* albedoTexture = new Texture(jsonData["normal"].get<std::string>(), PulseEngineGraphicsAPI, jsonData.value("flip", true));
-        material->SetTexture("normal", std::shared_ptr<Texture>(albedoTexture));
+        EDITOR_WARN("Material guid[" + guid + "] not found in guidCollectionMaterials.puid");
+        return nullptr;
     }
-    if(jsonData.contains("height"))
+
+    Material* material = loadMaterial(path);
+    if (material)
     {
-        
-        Texture* albedoTexture = new Texture(jsonData["height"].get<std::string>(), PulseEngineGraphicsAPI, jsonData.value("flip", true));
-        material->SetTexture("height", std::shared_ptr<Texture>(albedoTexture));
+        if (material->guid.empty()) material->guid = guid;
+        materialsByGuid[guid] = material;
     }
-    if(jsonData.contains("roughness"))
-    {        
-        Texture* albedoTexture = new Texture(jsonData["roughness"].get<std::string>(), PulseEngineGraphicsAPI, jsonData.value("flip", true));
-        material->SetTexture("roughness", std::shared_ptr<Texture>(albedoTexture));
-    }
-    if(jsonData.contains("guid"))
+    return material;
+}
+
+void MaterialManager::unloadMaterial(const std::string& materialName)
+{
+    auto it = materials.find(materialName);
+    if (it == materials.end()) return;
+
+    Material* material = it->second;
+    materials.erase(it);
+    std::erase_if(materialsByPath, [material](const auto& entry) { return entry.second == material; });
+    std::erase_if(materialsByGuid, [material](const auto& entry) { return entry.second == material; });
+    delete material;
+}
+
+Material* MaterialManager::CreateMaterial(const std::string& filePath, const PulseEngine::Cooking::CookedMaterial& description)
+{
+    Shader* shader = ShaderManager::GetInstance().GetShaderInstance(description.shaderGuid);
+    Material* material = new Material(description.name, shader);
+
+    material->SetPath(filePath);
+    if (description.hasFlip) material->SetYflip(description.flip);
+    material->color = PulseEngine::Vector3(description.color[0], description.color[1], description.color[2]);
+    material->specular = description.specular;
+    material->guid = description.guid;
+
+    auto collection = PulseEngineInstance->guidCollections.find("guidCollectionTextures.puid");
+    GuidCollection* textureCollection = collection != PulseEngineInstance->guidCollections.end() ? collection->second : nullptr;
+
+    // shared and decoded in the background, the material is usable right away (placeholder until the upload)
+    for (const PulseEngine::Cooking::CookedMaterialTexture& texture : description.textures)
     {
-        material->guid = jsonData["guid"];
+        std::string texturePath = texture.path;
+        if (texture.guid != 0 && textureCollection)
+        {
+            const std::string registered = textureCollection->GetFilePathFromGuid(std::to_string(texture.guid));
+            if (!registered.empty()) texturePath = registered;
+        }
+        material->SetTexture(texture.slot, TextureManager::GetInstance().GetTexture(texturePath, description.flip));
     }
 
-    materials[material->GetName()] = material;
-    file.close();
-    PulseEngineInstance->guidCollections["guidCollectionMaterials.puid"]->InsertFile(filePath);
     return material;
 }
 
-Material *MaterialManager::getMaterial(const std::string &materialName)
+std::string MaterialManager::NormalizePath(const std::string& filePath)
 {
-    if(materials[materialName]) return materials[materialName];
-    return nullptr;
+    std::string key;
+    key.reserve(filePath.size());
+    for (char c : filePath)
+    {
+        const char normalized = c == '\\' ? '/' : c;
+        if (normalized == '/' && !key.empty() && key.back() == '/') continue;
+        key.push_back(normalized);
+    }
+    return key;
 }
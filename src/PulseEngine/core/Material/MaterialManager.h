@@ -7,16 +7,38 @@
 
 class Material;
 
+namespace PulseEngine::Cooking
+{
+    struct CookedMaterial;
+}
+
+/**
+ * @brief Owns every loaded material, a material file is read once per run.
+ * @details Materials are cached by path (checked before any disk access) and by GUID.
+ * Outside of the editor the cooked "<path>.pmat" is read when it exists, the json .mat is the fallback.
+ */
 class PULSE_ENGINE_DLL_API MaterialManager 
 {
 public:
 
     static Material* loadMaterial(const std::string& filePath);
     static Material* getMaterial(const std::string& materialName);
+
+    /**
+     * @brief Material registered in guidCollectionMaterials.puid, loaded on first use.
+     * @return nullptr when the guid is unknown or the file can't be read.
+     */
+    static Material* GetMaterialFromGuid(const std::string& guid);
+
     static void unloadMaterial(const std::string& materialName);
 private:
+    static Material* CreateMaterial(const std::string& filePath, const PulseEngine::Cooking::CookedMaterial& description);
+    static std::string NormalizePath(const std::string& filePath);
+
     static std::unordered_map<std::string, Material*> materials;
+    static std::unordered_map<std::string, Material*> materialsByPath;
+    static std::unordered_map<std::string, Material*> materialsByGuid;
 };
 
 
-#endif
\ No newline at end of file
+#endif
@@ -1,5 +1,6 @@
 #include "Texture.h"
 #include "PulseEngine/core/Graphics/IGraphicsApi.h"
+#include "PulseEngine/core/Threading/GraphicsThread.h"
 #include "common/EditorDefines.h"
 
 Texture::Texture(const std::string &filePath, IGraphicsAPI* graphics, bool hasFlip)
@@ -7,6 +8,27 @@ Texture::Texture(const std::string &filePath, IGraphicsAPI* graphics, bool hasFl
     graphicsAPI = graphics;
     graphicsAPI->GenerateTextureMap(&id, std::string(ASSET_PATH) + filePath, hasFlip);
     path = filePath;
+    ready = true;
+    ownsId = true;
+}
+
+Texture::Texture(const std::string &filePath, IGraphicsAPI *graphics, unsigned int placeholderId)
+{
+    graphicsAPI = graphics;
+    id = placeholderId;
+    path = filePath;
+}
+
+Texture::~Texture()
+{
+    if (!ownsId) return;
+    if (PulseEngine::Threading::IsGraphicsThread())
+    {
+        graphicsAPI->DeleteTexture(id);
+        return;
+    }
+    // last reference dropped by the simulation thread
+    PulseEngine::Threading::RunOnGraphicsThread([api = graphicsAPI, textureId = id]() { api->DeleteTexture(textureId); });
 }
 
 
@@ -1,6 +1,7 @@
 // Texture.h
 #pragma once
 
+#include <memory>
 #include <string>
 // #include "Common/common.h"
 #include "Common/dllExport.h"
@@ -10,15 +11,38 @@ class IGraphicsAPI;
 class PULSE_ENGINE_DLL_API Texture
 {
 public:
+    /**
+     * @brief Synchronous load : decode and upload right away (main thread).
+     * @note prefer TextureManager::GetTexture, which shares the textures and decodes them in the background.
+     */
     Texture(const std::string& filePath,IGraphicsAPI* graphics, bool hasFlip = false);
+    ~Texture();
+
+    Texture(const Texture&) = delete;
+    Texture& operator=(const Texture&) = delete;
 
     void Bind(unsigned int slot = 0) const;
     void Unbind() const;
 
     std::string GetPath() const { return path; }
 
+    /**
+     * @brief False while the image is still decoding, the placeholder is bound meanwhile.
+     */
+    bool IsReady() const { return ready; }
+
     unsigned int id;
 private:
+    friend class TextureManager;
+
+    /**
+     * @brief Texture created by TextureManager, id is the placeholder until the upload.
+     */
+    Texture(const std::string& filePath, IGraphicsAPI* graphics, unsigned int placeholderId);
+
     std::string path;
     IGraphicsAPI* graphicsAPI;
+    bool ready = false;
+    bool ownsId = false;
+    std::shared_ptr<Texture> sharedImage; ///< same content loaded from another path, owns the GPU texture
 };
@@ -0,0 +1,221 @@
+#include "Common/common.h"
+#include "TextureManager.h"
+#include "Texture.h"
+#include "PulseEngine/core/PulseEngineBackend.h"
+#include "PulseEngine/core/Graphics/IGraphicsApi.h"
+#include "PulseEngine/core/Threading/ThreadPool.h"
+#include "PulseEngine/core/GUID/GuidGenerator.h"
+#include "PulseEngine/core/Material/Cooking/CookedTexture.h"
+#include "PulseEngine/core/FileManager/Pak/PakManager.h"
+#include "stb_image.h"
+
+#include <algorithm>
+
+TextureManager& TextureManager::GetInstance()
+{
+    static TextureManager instance;
+    return instance;
+}
+
+TextureManager::~TextureManager()
+{
+    for (DecodedImage& image : decoded)
+        stbi_image_free(image.pixels);
+}
+
+std::shared_ptr<Texture> TextureManager::GetTexture(const std::string& filePath, bool hasFlip)
+{
+    const std::string key = hasFlip ? filePath + "|flip" : filePath;
+
+    std::shared_ptr<Texture> texture;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if ((texture = texturesByPath[key].lock())) return texture;
+
+        texture = std::shared_ptr<Texture>(new Texture(filePath, PulseEngineGraphicsAPI, GetPlaceholder()));
+        texturesByPath[key] = texture;
+        ++loadingCount;
+    }
+
+    SubmitDecode(texture, filePath, hasFlip, true);
+    return texture;
+}
+
+void TextureManager::SubmitDecode(std::weak_ptr<Texture> texture, const std::string& filePath, bool hasFlip, bool allowCooked)
+{
+    PulseEngine::Threading::ThreadPool::GetInstance().Submit([this, texture, filePath, hasFlip, allowCooked]()
+    {
+        Decode(texture, filePath, hasFlip, allowCooked);
+    });
+}
+
+bool TextureManager::DecodeCooked(DecodedImage& image)
+{
+    auto cooked = std::make_shared<PulseEngine::Cooking::CookedTexture>();
+    std::vector<uint8_t> content;
+    if (!PulseEngine::FileSystem::ReadAssetFile(PulseEngine::Cooking::GetCookedTexturePath(image.filePath), content)) return false;
+    if (!PulseEngine::Cooking::ReadCookedTexture(std::move(content), *cooked)) return false;
+    if (cooked->IsFlipped() != image.hasFlip && !PulseEngine::Cooking::FlipCookedTexture(*cooked)) return false;
+
+    // hashed after the flip, the data is what gets uploaded
+    image.contentHash = PulseEngine::Registry::HashContent(cooked->data.data(), cooked->data.size());
+
+    std::lock_guard<std::mutex> lock(mutex);
+    auto it = texturesByContent.find(image.contentHash);
+    if (it == texturesByContent.end() || it->second.expired()) image.cooked = cooked;
+    return true;
+}
+
+void TextureManager::Decode(std::weak_ptr<Texture> texture, std::string filePath, bool hasFlip, bool allowCooked)
+{
+    DecodedImage image;
+    image.texture = texture;
+    image.filePath = filePath;
+    image.hasFlip = hasFlip;
+    image.allowCooked = allowCooked;
+
+    // released before we get there : nothing to decode
+    if (!texture.expired() && !(allowCooked && DecodeCooked(image)))
+    {
+        std::vector<unsigned char> bytes;
+        PulseEngine::FileSystem::ReadAssetFile(filePath, bytes);
+
+        if (bytes.empty())
+        {
+            EDITOR_ERROR("Failed to load texture: " + filePath);
+        }
+        else
+        {
+            // the flip is part of the key since it changes the uploaded image
+            const unsigned char flipByte = hasFlip ? 1 : 0;
+            image.contentHash = PulseEngine::Registry::HashContent(&flipByte, 1, PulseEngine::Registry::HashContent(bytes.data(), bytes.size()));
+
+            bool alreadyUploaded = false;
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                auto it = texturesByContent.find(image.contentHash);
+                alreadyUploaded = it != texturesByContent.end() && !it->second.expired();
+            }
+
+            if (!alreadyUploaded)
+            {
+                stbi_set_flip_vertically_on_load_thread(hasFlip);
+                image.pixels = stbi_load_from_memory(bytes.data(), (int)bytes.size(), &image.width, &image.height, &image.channels, 0);
+                if (!image.pixels)
+                {
+                    EDITOR_ERROR("Failed to decode texture: " + filePath + " (" + stbi_failure_reason() + ")");
+                    image.contentHash = 0;
+                }
+            }
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(mutex);
+    decoded.push_back(image);
+}
+
+void TextureManager::ProcessPendingUploads(std::size_t maxUploads)
+{
+    PROFILE_TIMER_FUNCTION;
+
+    std::vector<DecodedImage> toUpload;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        const std::size_t count = std::min(maxUploads, decoded.size());
+        if (count == 0) return;
+        toUpload.assign(decoded.begin(), decoded.begin() + count);
+        decoded.erase(decoded.begin(), decoded.begin() + count);
+    }
+
+    for (DecodedImage& image : toUpload)
+        Upload(image);
+}
+
+void TextureManager::FlushPendingUploads()
+{
+    while (GetLoadingCount() > 0)
+    {
+        PulseEngine::Threading::ThreadPool::GetInstance().WaitIdle();
+        ProcessPendingUploads(SIZE_MAX);
+    }
+}
+
+void TextureManager::Upload(DecodedImage& image)
+{
+    std::shared_ptr<Texture> texture = image.texture.lock();
+    std::unique_lock<std::mutex> lock(mutex);
+    --loadingCount;
+
+    if (!texture || image.contentHash == 0)
+    {
+        // released, or unreadable : stays on the placeholder
+        stbi_image_free(image.pixels);
+        return;
+    }
+
+    auto it = texturesByContent.find(image.contentHash);
+    std::shared_ptr<Texture> owner = it != texturesByContent.end() ? it->second.lock() : nullptr;
+    if (owner)
+    {
+        // same image under another path (or decoded twice at the same time)
+        texture->sharedImage = owner;
+        texture->id = owner->id;
+        texture->ready = true;
+        stbi_image_free(image.pixels);
+        return;
+    }
+
+    if (!image.pixels && !image.cooked)
+    {
+        // the texture we wanted to share was released meanwhile, decode it after all
+        ++loadingCount;
+        lock.unlock();
+        SubmitDecode(texture, image.filePath, image.hasFlip, image.allowCooked);
+        return;
+    }
+
+    unsigned int id = 0;
+    if (image.cooked)
+    {
+        if (!PulseEngineGraphicsAPI->UploadCookedTexture(&id, *image.cooked))
+        {
+            // format not supported by this GPU : back to the source image
+            ++loadingCount;
+            lock.unlock();
+            SubmitDecode(texture, image.filePath, image.hasFlip, false);
+            return;
+        }
+    }
+    else
+    {
+        PulseEngineGraphicsAPI->UploadTexture(&id, image.pixels, image.width, image.height, image.channels);
+        stbi_image_free(image.pixels);
+    }
+
+    texture->id = id;
+    texture->ownsId = true;
+    texture->ready = true;
+    texturesByContent[image.contentHash] = texture;
+}
+
+unsigned int TextureManager::GetPlaceholder()
+{
+    if (placeholderId == 0)
+    {
+        const unsigned char white[4] = { 255, 255, 255, 255 };
+        PulseEngineGraphicsAPI->UploadTexture(&placeholderId, white, 1, 1, 4);
+    }
+    return placeholderId;
+}
+
+std::size_t TextureManager::GetLoadingCount() const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return loadingCount;
+}
+
+std::size_t TextureManager::GetTextureCount() const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return std::count_if(texturesByPath.begin(), texturesByPath.end(), [](const auto& entry) { return !entry.second.expired(); });
+}
@@ -0,0 +1,95 @@
+/**
+ * @file TextureManager.h
+ * @brief Registry of the loaded textures : one GPU texture per image, decoded in the background.
+ * @details
+ * - Textures are shared by path (+ flip) : every material asking for "wood.png" gets the same handle.
+ *   Handles are refcounted (std::shared_ptr), the GPU texture is freed with its last user.
+ * - Files are hashed once read, two paths with the same content also end up on the same GPU texture.
+ * - A cooked version (.ptex, see TextureCooker) is used when present : its mips are uploaded as they are.
+ * - Reading, hashing and decoding run on the ThreadPool. Until the upload, the handle binds a 1x1 white
+ *   placeholder, so loading a material never waits for its images.
+ * - Uploads happen in ProcessPendingUploads, on the main thread (the one owning the graphic context).
+ * @version 0.1
+ * @date 2025-12-08
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+#ifndef TEXTUREMANAGER_H
+#define TEXTUREMANAGER_H
+
+#include "Common/dllExport.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+class Texture;
+namespace PulseEngine::Cooking { struct CookedTexture; }
+
+class PULSE_ENGINE_DLL_API TextureManager
+{
+public:
+    static TextureManager& GetInstance();
+
+    TextureManager(const TextureManager&) = delete;
+    TextureManager& operator=(const TextureManager&) = delete;
+
+    /**
+     * @brief Shared texture for filePath (relative to ASSET_PATH), decoding is started if needed. Main thread only.
+     */
+    std::shared_ptr<Texture> GetTexture(const std::string& filePath, bool hasFlip);
+
+    /**
+     * @brief Upload the decoded images to the GPU, at most maxUploads of them. Called once per frame by the engine.
+     */
+    void ProcessPendingUploads(std::size_t maxUploads = 8);
+
+    /**
+     * @brief Wait for every decode and upload them all (loading screens, build tools).
+     */
+    void FlushPendingUploads();
+
+    std::size_t GetLoadingCount() const;
+    std::size_t GetTextureCount() const;
+
+private:
+    TextureManager() = default;
+    ~TextureManager();
+
+    /**
+     * @brief Result of a worker, waiting for the main thread.
+     */
+    struct DecodedImage
+    {
+        std::weak_ptr<Texture> texture;
+        std::string filePath;
+        bool hasFlip = false;
+        bool allowCooked = true;
+        uint64_t contentHash = 0;          ///< 0 when the file could not be read or decoded
+        unsigned char* pixels = nullptr;   ///< stb allocation, nullptr when an uploaded texture has the same content
+        int width = 0;
+        int height = 0;
+        int channels = 0;
+        std::shared_ptr<PulseEngine::Cooking::CookedTexture> cooked;  ///< replaces pixels when a .ptex was found
+    };
+
+    void SubmitDecode(std::weak_ptr<Texture> texture, const std::string& filePath, bool hasFlip, bool allowCooked);
+    void Decode(std::weak_ptr<Texture> texture, std::string filePath, bool hasFlip, bool allowCooked);
+    bool DecodeCooked(DecodedImage& image);
+    void Upload(DecodedImage& image);
+    unsigned int GetPlaceholder();
+
+    mutable std::mutex mutex;
+    std::unordered_map<std::string, std::weak_ptr<Texture>> texturesByPath;
+    std::unordered_map<uint64_t, std::weak_ptr<Texture>> texturesByContent;  ///< uploaded textures owning their GPU texture
+    std::vector<DecodedImage> decoded;
+    std::size_t loadingCount = 0;
+    unsigned int placeholderId = 0;
+};
+
+#endif // TEXTUREMANAGER_H
@@ -86,6 +86,35 @@ bool Frustum::IntersectsAABB(const AABB & box) const
     return true;
 }
 
+bool Frustum::IntersectsAABB(const AABB &box, uint8_t &lastFailedPlane) const
+{
+    for (int k = 0; k < 6; ++k)
+    {
+        const int i = (lastFailedPlane + k) % 6;
+        const Plane& p = planes[i];
+        PulseEngine::Vector3 positive = box.min;
+        if (p.normal.x >= 0) positive.x = box.max.x;
+        if (p.normal.y >= 0) positive.y = box.max.y;
+        if (p.normal.z >= 0) positive.z = box.max.z;
+        if (p.DistanceToPoint(positive) < 0)
+        {
+            lastFailedPlane = (uint8_t)i;
+            return false;
+        }
+    }
+    return true;
+}
+
+bool Frustum::IntersectsSphere(const PulseEngine::Vector3 &center, float radius) const
+{
+    for (int i = 0; i < 6; ++i)
+    {
+        if (planes[i].DistanceToPoint(center) + radius < 0)
+            return false;
+    }
+    return true;
+}
+
 void Frustum::Serialize(Archive& ar)
 {
 
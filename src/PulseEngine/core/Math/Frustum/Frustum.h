@@ -11,6 +11,8 @@
 #include "PulseEngine/core/Math/Vector.h"
 #include "PulseEngine/core/Math/Mat4.h"
 
+#include <cstdint>
+
 struct PULSE_ENGINE_DLL_API Plane : public PulseObject
 {
     PULSE_GEN_BODY(Plane)
@@ -38,6 +40,14 @@ struct PULSE_ENGINE_DLL_API Frustum : public PulseObject
 
     // Check if an AABB is inside or intersecting the frustum
     bool IntersectsAABB(const AABB& box) const;
+
+    // Same, testing lastFailedPlane first and updating it when the box is outside (plane coherency between frames)
+    bool IntersectsAABB(const AABB& box, uint8_t& lastFailedPlane) const;
+
+    // Check if a sphere is inside or intersecting the frustum
+    bool IntersectsSphere(const PulseEngine::Vector3& center, float radius) const;
+
+    // many bounds at once : see FrustumCulling.h
 };
 
 
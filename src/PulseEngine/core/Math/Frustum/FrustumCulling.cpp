@@ -0,0 +1,232 @@
+#include "FrustumCulling.h"
+#include "PulseEngine/core/Math/Frustum/Frustum.h"
+#include "PulseEngine/core/Math/Simd/SimdLanes.h"
+
+#include <algorithm>
+
+using namespace PulseEngine;
+using namespace PulseEngine::Culling;
+
+namespace
+{
+    constexpr int PLANE_COUNT = CullingPlanes::COUNT;
+
+    /**
+     * @brief Signed distance of Lanes::Width points to plane p, same operations in the same order as
+     * Plane::DistanceToPoint : no MulAdd, the AVX one is fused when the build has FMA and would round differently.
+     */
+    template <typename L>
+    typename L::Float PlaneDistance(const CullingPlanes& planes, int p, const float* x, const float* y, const float* z, std::size_t i)
+    {
+        typename L::Float dot = L::Add(L::Add(L::Mul(L::Set(planes.nx[p]), L::Load(x + i)),
+                                              L::Mul(L::Set(planes.ny[p]), L::Load(y + i))),
+                                       L::Mul(L::Set(planes.nz[p]), L::Load(z + i)));
+        return L::Add(dot, L::Set(planes.d[p]));
+    }
+
+    /**
+     * @brief Test the boxes [i, i + Width) starting with the cached plane.
+     * @return bit set for each visible lane
+     */
+    template <typename L>
+    int CullAABBLanes(const CullingPlanes& planes, const BoundsArray& bounds, std::size_t i, uint8_t& firstPlane)
+    {
+        const typename L::Float zero = L::Set(0.0f);
+        typename L::Mask outside = L::False();
+
+        for (int k = 0; k < PLANE_COUNT; ++k)
+        {
+            const int p = firstPlane + k < PLANE_COUNT ? firstPlane + k : firstPlane + k - PLANE_COUNT;
+
+            // positive vertex : furthest corner along the normal, the same for every lane
+            const float* x = planes.nx[p] >= 0.0f ? bounds.maxX.data() : bounds.minX.data();
+            const float* y = planes.ny[p] >= 0.0f ? bounds.maxY.data() : bounds.minY.data();
+            const float* z = planes.nz[p] >= 0.0f ? bounds.maxZ.data() : bounds.minZ.data();
+
+            outside = L::Or(outside, L::Less(PlaneDistance<L>(planes, p, x, y, z, i), zero));
+            if (L::MoveMask(outside) == PulseEngine::Simd::AllLanesMask<L>())
+            {
+                firstPlane = (uint8_t)p;
+                return 0;
+            }
+        }
+        return ~L::MoveMask(outside) & PulseEngine::Simd::AllLanesMask<L>();
+    }
+
+    template <typename L>
+    int CullSphereLanes(const CullingPlanes& planes, const SphereArray& spheres, std::size_t i, uint8_t& firstPlane)
+    {
+        const typename L::Float radius = L::Load(spheres.radius.data() + i);
+        const typename L::Float zero = L::Set(0.0f);
+        typename L::Mask outside = L::False();
+
+        for (int k = 0; k < PLANE_COUNT; ++k)
+        {
+            const int p = firstPlane + k < PLANE_COUNT ? firstPlane + k : firstPlane + k - PLANE_COUNT;
+            typename L::Float distance = PlaneDistance<L>(planes, p, spheres.centerX.data(), spheres.centerY.data(), spheres.centerZ.data(), i);
+
+            outside = L::Or(outside, L::Less(L::Add(distance, radius), zero));
+            if (L::MoveMask(outside) == PulseEngine::Simd::AllLanesMask<L>())
+            {
+                firstPlane = (uint8_t)p;
+                return 0;
+            }
+        }
+        return ~L::MoveMask(outside) & PulseEngine::Simd::AllLanesMask<L>();
+    }
+
+    /**
+     * @brief Run a lane kernel over [begin, end) and write the visibility bits.
+     * @details Whole groups use L, the tail uses the scalar kernel. begin is a multiple of 32 so the
+     * words written here belong to this range only.
+     */
+    template <typename L, typename Bounds, typename Kernel>
+    void CullRange(const CullingPlanes& planes, const Bounds& bounds, std::size_t begin, std::size_t end, uint32_t* outVisible, CullingCache* cache, Kernel kernel)
+    {
+        constexpr std::size_t W = L::Width;
+        constexpr std::size_t CACHE_W = PulseEngine::Simd::WideLanes::Width;
+
+        std::fill(outVisible + (begin >> 5), outVisible + VisibilityMaskWords(end), 0u);
+
+        uint8_t noCache = 0;
+        std::size_t i = begin;
+        for (; i + W <= end; i += W)
+        {
+            uint8_t& firstPlane = cache ? cache->firstPlane[i / CACHE_W] : noCache;
+            uint32_t visible = (uint32_t)kernel(L(), planes, bounds, i, firstPlane);
+            outVisible[i >> 5] |= visible << (i & 31);
+        }
+        for (; i < end; ++i)
+        {
+            uint8_t& firstPlane = cache ? cache->firstPlane[i / CACHE_W] : noCache;
+            uint32_t visible = (uint32_t)kernel(PulseEngine::Simd::ScalarLanes(), planes, bounds, i, firstPlane);
+            outVisible[i >> 5] |= visible << (i & 31);
+        }
+    }
+
+    struct AABBKernel
+    {
+        template <typename L>
+        int operator()(L, const CullingPlanes& planes, const BoundsArray& bounds, std::size_t i, uint8_t& firstPlane) const
+        {
+            return CullAABBLanes<L>(planes, bounds, i, firstPlane);
+        }
+    };
+
+    struct SphereKernel
+    {
+        template <typename L>
+        int operator()(L, const CullingPlanes& planes, const SphereArray& spheres, std::size_t i, uint8_t& firstPlane) const
+        {
+            return CullSphereLanes<L>(planes, spheres, i, firstPlane);
+        }
+    };
+}
+
+CullingPlanes::CullingPlanes(const Frustum& frustum)
+{
+    for (int p = 0; p < COUNT; ++p)
+    {
+        nx[p] = frustum.planes[p].normal.x;
+        ny[p] = frustum.planes[p].normal.y;
+        nz[p] = frustum.planes[p].normal.z;
+        d[p] = frustum.planes[p].d;
+    }
+}
+
+uint32_t BoundsArray::Add(const AABB& box)
+{
+    minX.push_back(box.min.x);
+    minY.push_back(box.min.y);
+    minZ.push_back(box.min.z);
+    maxX.push_back(box.max.x);
+    maxY.push_back(box.max.y);
+    maxZ.push_back(box.max.z);
+    return (uint32_t)(minX.size() - 1);
+}
+
+void BoundsArray::Clear()
+{
+    minX.clear(); minY.clear(); minZ.clear();
+    maxX.clear(); maxY.clear(); maxZ.clear();
+}
+
+void BoundsArray::Reserve(std::size_t count)
+{
+    minX.reserve(count); minY.reserve(count); minZ.reserve(count);
+    maxX.reserve(count); maxY.reserve(count); maxZ.reserve(count);
+}
+
+uint32_t SphereArray::Add(const Vector3& center, float sphereRadius)
+{
+    centerX.push_back(center.x);
+    centerY.push_back(center.y);
+    centerZ.push_back(center.z);
+    radius.push_back(sphereRadius);
+    return (uint32_t)(centerX.size() - 1);
+}
+
+void SphereArray::Clear()
+{
+    centerX.clear(); centerY.clear(); centerZ.clear();
+    radius.clear();
+}
+
+void SphereArray::Reserve(std::size_t count)
+{
+    centerX.reserve(count); centerY.reserve(count); centerZ.reserve(count);
+    radius.reserve(count);
+}
+
+void CullingCache::Resize(std::size_t boundsCount)
+{
+    constexpr std::size_t W = PulseEngine::Simd::WideLanes::Width;
+    firstPlane.resize((boundsCount + W - 1) / W, 0);
+}
+
+void PulseEngine::Culling::CullAABBs(const Frustum& frustum, const BoundsArray& bounds, uint32_t* outVisible, CullingCache* cache)
+{
+    if (cache) cache->Resize(bounds.Size());
+    CullAABBs(frustum, bounds, 0, bounds.Size(), outVisible, cache);
+}
+
+void PulseEngine::Culling::CullAABBs(const Frustum& frustum, const BoundsArray& bounds, std::size_t begin, std::size_t end, uint32_t* outVisible, CullingCache* cache)
+{
+    CullAABBs(CullingPlanes(frustum), bounds, begin, end, outVisible, cache);
+}
+
+void PulseEngine::Culling::CullAABBs(const CullingPlanes& planes, const BoundsArray& bounds, std::size_t begin, std::size_t end, uint32_t* outVisible, CullingCache* cache)
+{
+    CullRange<PulseEngine::Simd::WideLanes>(planes, bounds, begin, end, outVisible, cache, AABBKernel());
+}
+
+void PulseEngine::Culling::CullSpheres(const Frustum& frustum, const SphereArray& spheres, uint32_t* outVisible, CullingCache* cache)
+{
+    if (cache) cache->Resize(spheres.Size());
+    CullSpheres(frustum, spheres, 0, spheres.Size(), outVisible, cache);
+}
+
+void PulseEngine::Culling::CullSpheres(const Frustum& frustum, const SphereArray& spheres, std::size_t begin, std::size_t end, uint32_t* outVisible, CullingCache* cache)
+{
+    CullSpheres(CullingPlanes(frustum), spheres, begin, end, outVisible, cache);
+}
+
+void PulseEngine::Culling::CullSpheres(const CullingPlanes& planes, const SphereArray& spheres, std::size_t begin, std::size_t end, uint32_t* outVisible, CullingCache* cache)
+{
+    CullRange<PulseEngine::Simd::WideLanes>(planes, spheres, begin, end, outVisible, cache, SphereKernel());
+}
+
+void PulseEngine::Culling::CullAABBsScalar(const Frustum& frustum, const BoundsArray& bounds, uint32_t* outVisible)
+{
+    CullAABBsScalar(CullingPlanes(frustum), bounds, outVisible);
+}
+
+void PulseEngine::Culling::CullAABBsScalar(const CullingPlanes& planes, const BoundsArray& bounds, uint32_t* outVisible)
+{
+    CullRange<PulseEngine::Simd::ScalarLanes>(planes, bounds, 0, bounds.Size(), outVisible, nullptr, AABBKernel());
+}
+
+const char* PulseEngine::Culling::GetCullingKernelName()
+{
+    return PulseEngine::Simd::WideLanes::Name;
+}
@@ -0,0 +1,121 @@
+/**
+ * @file FrustumCulling.h
+ * @brief Batched frustum culling : contiguous bounds in, one visibility bit per bound out.
+ * @details Bounds are stored in structure-of-arrays form and tested 4 or 8 at a time (see SimdLanes.h).
+ * The plane normals are the same for every lane, so the positive vertex of a box is chosen once per plane
+ * (min or max array) instead of once per box.
+ * A CullingCache remembers, per group of lanes, the plane that rejected the whole group last time and tests it first :
+ * from one frame to the next most groups are rejected by the same plane.
+ *
+ * The range versions only touch the mask words covering [begin, end), with begin a multiple of 32,
+ * so several threads can cull separate ranges of the same arrays into the same mask, from one CullingPlanes.
+ * The plane distances are separate multiplies and adds, never MulAdd : a bound exactly on a plane gets the answer
+ * Plane::DistanceToPoint gives with every instruction set, as long as the compiler doesn't contract them itself
+ * (MSVC doesn't by default, the benchmarks build with -ffp-contract=off).
+ * Benchmarks/FrustumCullingBench.cpp compares the masks with the one-lane path and times both, on one thread and split.
+ * @version 0.1
+ * @date 2025-12-06
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+#ifndef FRUSTUMCULLING_H
+#define FRUSTUMCULLING_H
+
+#include "Common/dllExport.h"
+#include "PulseEngine/core/Math/Vector.h"
+#include "PulseEngine/core/Math/Frustum/AABB.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+struct Frustum;
+
+namespace PulseEngine::Culling
+{
+    /**
+     * @brief Axis aligned boxes in structure-of-arrays layout.
+     */
+    struct PULSE_ENGINE_DLL_API BoundsArray
+    {
+        std::vector<float> minX, minY, minZ;
+        std::vector<float> maxX, maxY, maxZ;
+
+        uint32_t Add(const AABB& box);
+        void Clear();
+        void Reserve(std::size_t count);
+        std::size_t Size() const { return minX.size(); }
+    };
+
+    /**
+     * @brief Bounding spheres in structure-of-arrays layout.
+     */
+    struct PULSE_ENGINE_DLL_API SphereArray
+    {
+        std::vector<float> centerX, centerY, centerZ;
+        std::vector<float> radius;
+
+        uint32_t Add(const Vector3& center, float sphereRadius);
+        void Clear();
+        void Reserve(std::size_t count);
+        std::size_t Size() const { return centerX.size(); }
+    };
+
+    /**
+     * @brief The six planes of a frustum, unpacked once per cull and shared by the threads culling its ranges.
+     */
+    struct PULSE_ENGINE_DLL_API CullingPlanes
+    {
+        static constexpr int COUNT = 6;
+        float nx[COUNT] = {}, ny[COUNT] = {}, nz[COUNT] = {}, d[COUNT] = {};
+
+        CullingPlanes() = default;
+        explicit CullingPlanes(const Frustum& frustum);
+    };
+
+    /**
+     * @brief First plane to test for each group of lanes, kept from one cull to the next.
+     * @note only meaningful while the bounds keep the same order, a wrong guess costs nothing but the early out.
+     */
+    struct PULSE_ENGINE_DLL_API CullingCache
+    {
+        std::vector<uint8_t> firstPlane;
+
+        /**
+         * @brief Size the cache for boundsCount bounds. Done by the full-array functions,
+         * must be called once before culling ranges from several threads.
+         */
+        void Resize(std::size_t boundsCount);
+    };
+
+    inline std::size_t VisibilityMaskWords(std::size_t boundsCount) { return (boundsCount + 31) / 32; }
+    inline bool IsVisible(const uint32_t* visibleMask, std::size_t index) { return (visibleMask[index >> 5] >> (index & 31)) & 1u; }
+
+    /**
+     * @brief Write bit i of outVisible when bound i is inside or intersecting the frustum.
+     * @param outVisible VisibilityMaskWords(bounds.Size()) words.
+     * @param cache optional plane coherency cache.
+     */
+    PULSE_ENGINE_DLL_API void CullAABBs(const Frustum& frustum, const BoundsArray& bounds, uint32_t* outVisible, CullingCache* cache = nullptr);
+    PULSE_ENGINE_DLL_API void CullAABBs(const Frustum& frustum, const BoundsArray& bounds, std::size_t begin, std::size_t end, uint32_t* outVisible, CullingCache* cache = nullptr);
+
+    PULSE_ENGINE_DLL_API void CullAABBs(const CullingPlanes& planes, const BoundsArray& bounds, std::size_t begin, std::size_t end, uint32_t* outVisible, CullingCache* cache = nullptr);
+
+    PULSE_ENGINE_DLL_API void CullSpheres(const Frustum& frustum, const SphereArray& spheres, uint32_t* outVisible, CullingCache* cache = nullptr);
+    PULSE_ENGINE_DLL_API void CullSpheres(const Frustum& frustum, const SphereArray& spheres, std::size_t begin, std::size_t end, uint32_t* outVisible, CullingCache* cache = nullptr);
+    PULSE_ENGINE_DLL_API void CullSpheres(const CullingPlanes& planes, const SphereArray& spheres, std::size_t begin, std::size_t end, uint32_t* outVisible, CullingCache* cache = nullptr);
+
+    /**
+     * @brief Same as CullAABBs, but always with the one-lane code (reference for the SIMD path and for benchmarks).
+     */
+    PULSE_ENGINE_DLL_API void CullAABBsScalar(const Frustum& frustum, const BoundsArray& bounds, uint32_t* outVisible);
+    PULSE_ENGINE_DLL_API void CullAABBsScalar(const CullingPlanes& planes, const BoundsArray& bounds, uint32_t* outVisible);
+
+    /**
+     * @brief Name of the instruction set used by CullAABBs and CullSpheres ("AVX", "SSE" or "Scalar").
+     */
+    PULSE_ENGINE_DLL_API const char* GetCullingKernelName();
+}
+
+#endif // FRUSTUMCULLING_H
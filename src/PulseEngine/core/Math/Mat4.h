@@ -3,6 +3,7 @@
 
 #include <cstring> 
 #include "PulseEngine/core/Math/Vector.h"
+#include "PulseEngine/core/Math/Simd/MatrixSimd.h"
 
 namespace PulseEngine
 {
@@ -11,21 +12,20 @@ namespace PulseEngine
 
     /**
      * @brief Mat4 class represents a 4x4 matrix used for 3D transformations.
-     * 
+     * @note data is 16 bytes aligned so each row fits one SSE register (see Simd/MatrixSimd.h).
+     * Build with PULSE_DISABLE_SIMD (ENABLE_SIMD_MATH=OFF in CMake) to use the scalar code only.
      */
     struct PULSE_ENGINE_DLL_API Mat4
     {
-        float data[4][4]; 
+        alignas(16) float data[4][4]; 
         inline Vector4 operator*(const Vector4& vec) const
         {
             Vector4 result;
-            for (int row = 0; row < 4; ++row)
-            {
-                result[row] = data[row][0] * vec.x +
-                              data[row][1] * vec.y +
-                              data[row][2] * vec.z +
-                              data[row][3] * vec.a;
-            }
+        #ifdef PULSE_SIMD_SSE
+            Simd::Mat4TransformSSE(Ptr(), &vec.x, &result.x);
+        #else
+            Simd::Mat4TransformScalar(Ptr(), &vec.x, &result.x);
+        #endif
             return result;
         }
 
@@ -138,18 +138,15 @@ namespace PulseEngine
          */
         Mat4 operator*(const Mat4& other) const
         {
-            Mat4 result(0.0f);
-            for (int col = 0; col < 4; ++col)
-            {
-                for (int row = 0; row < 4; ++row)
-                {
-                    for (int i = 0; i < 4; ++i)
-                    {
-                        result.data[col][row] += data[i][row] * other.data[col][i];
-                    }
-                }
-            }
+        #ifdef PULSE_SIMD_SSE
+            Mat4 result;
+            Simd::Mat4MultiplySSE(Ptr(), other.Ptr(), result.Ptr());
+            return result;
+        #else
+            Mat4 result;
+            Simd::Mat4MultiplyScalar(Ptr(), other.Ptr(), result.Ptr());
             return result;
+        #endif
         }
         
 
@@ -289,131 +289,14 @@ namespace PulseEngine
             {
                 Mat4 result;
                 const float* m = &data[0][0];
-            
-                float inv[16], det;
-            
-                inv[0] = m[5]  * m[10] * m[15] - 
-                         m[5]  * m[11] * m[14] - 
-                         m[9]  * m[6]  * m[15] + 
-                         m[9]  * m[7]  * m[14] +
-                         m[13] * m[6]  * m[11] - 
-                         m[13] * m[7]  * m[10];
-            
-                inv[1] = -m[1]  * m[10] * m[15] + 
-                          m[1]  * m[11] * m[14] + 
-                          m[9]  * m[2] * m[15] - 
-                          m[9]  * m[3] * m[14] - 
-                          m[13] * m[2] * m[11] + 
-                          m[13] * m[3] * m[10];
-            
-                inv[2] = m[1]  * m[6] * m[15] - 
-                         m[1]  * m[7] * m[14] - 
-                         m[5]  * m[2] * m[15] + 
-                         m[5]  * m[3] * m[14] + 
-                         m[13] * m[2] * m[7] - 
-                         m[13] * m[3] * m[6];
-            
-                inv[3] = -m[1]  * m[6] * m[11] + 
-                          m[1]  * m[7] * m[10] + 
-                          m[5]  * m[2] * m[11] - 
-                          m[5]  * m[3] * m[10] - 
-                          m[9]  * m[2] * m[7] + 
-                          m[9]  * m[3] * m[6];
-            
-                inv[4] = -m[4]  * m[10] * m[15] + 
-                          m[4]  * m[11] * m[14] + 
-                          m[8]  * m[6] * m[15] - 
-                          m[8]  * m[7] * m[14] - 
-                          m[12] * m[6] * m[11] + 
-                          m[12] * m[7] * m[10];
-            
-                inv[5] = m[0]  * m[10] * m[15] - 
-                         m[0]  * m[11] * m[14] - 
-                         m[8]  * m[2] * m[15] + 
-                         m[8]  * m[3] * m[14] + 
-                         m[12] * m[2] * m[11] - 
-                         m[12] * m[3] * m[10];
-            
-                inv[6] = -m[0]  * m[6] * m[15] + 
-                          m[0]  * m[7] * m[14] + 
-                          m[4]  * m[2] * m[15] - 
-                          m[4]  * m[3] * m[14] - 
-                          m[12] * m[2] * m[7] + 
-                          m[12] * m[3] * m[6];
-            
-                inv[7] = m[0]  * m[6] * m[11] - 
-                         m[0]  * m[7] * m[10] - 
-                         m[4]  * m[2] * m[11] + 
-                         m[4]  * m[3] * m[10] + 
-                         m[8]  * m[2] * m[7] - 
-                         m[8]  * m[3] * m[6];
-            
-                inv[8] = m[4]  * m[9] * m[15] - 
-                         m[4]  * m[11] * m[13] - 
-                         m[8]  * m[5] * m[15] + 
-                         m[8]  * m[7] * m[13] + 
-                         m[12] * m[5] * m[11] - 
-                         m[12] * m[7] * m[9];
-            
-                inv[9] = -m[0]  * m[9] * m[15] + 
-                          m[0]  * m[11] * m[13] + 
-                          m[8]  * m[1] * m[15] - 
-                          m[8]  * m[3] * m[13] - 
-                          m[12] * m[1] * m[11] + 
-                          m[12] * m[3] * m[9];
-            
-                inv[10] = m[0]  * m[5] * m[15] - 
-                          m[0]  * m[7] * m[13] - 
-                          m[4]  * m[1] * m[15] + 
-                          m[4]  * m[3] * m[13] + 
-                          m[12] * m[1] * m[7] - 
-                          m[12] * m[3] * m[5];
-            
-                inv[11] = -m[0]  * m[5] * m[11] + 
-                           m[0]  * m[7] * m[9] + 
-                           m[4]  * m[1] * m[11] - 
-                           m[4]  * m[3] * m[9] - 
-                           m[8]  * m[1] * m[7] + 
-                           m[8]  * m[3] * m[5];
-            
-                inv[12] = -m[4]  * m[9] * m[14] + 
-                           m[4]  * m[10] * m[13] + 
-                           m[8]  * m[5] * m[14] - 
-                           m[8]  * m[6] * m[13] - 
-                           m[12] * m[5] * m[10] + 
-                           m[12] * m[6] * m[9];
-            
-                inv[13] = m[0]  * m[9] * m[14] - 
-                          m[0]  * m[10] * m[13] - 
-                          m[8]  * m[1] * m[14] + 
-                          m[8]  * m[2] * m[13] + 
-                          m[12] * m[1] * m[10] - 
-                          m[12] * m[2] * m[9];
-            
-                inv[14] = -m[0]  * m[5] * m[14] + 
-                           m[0]  * m[6] * m[13] + 
-                           m[4]  * m[1] * m[14] - 
-                           m[4]  * m[2] * m[13] - 
-                           m[12] * m[1] * m[6] + 
-                           m[12] * m[2] * m[5];
-            
-                inv[15] = m[0]  * m[5] * m[10] - 
-                          m[0]  * m[6] * m[9] - 
-                          m[4]  * m[1] * m[10] + 
-                          m[4]  * m[2] * m[9] + 
-                          m[8]  * m[1] * m[6] - 
-                          m[8]  * m[2] * m[5];
-            
-                det = m[0] * inv[0] + m[1] * inv[4] + m[2] * inv[8] + m[3] * inv[12];
-            
-                if (det == 0)
+
+            #ifdef PULSE_SIMD_SSE
+                const bool inverted = Simd::InverseSSE(m, result.Ptr());
+            #else
+                const bool inverted = Simd::InverseScalar(m, result.Ptr());
+            #endif
+                if (!inverted)
                     throw std::runtime_error("Matrix is singular and cannot be inverted.");
-            
-                det = 1.0f / det;
-            
-                for (int i = 0; i < 16; i++)
-                    ((float*)result.data)[i] = inv[i] * det;
-            
                 return result;
             }
 
@@ -421,13 +304,11 @@ namespace PulseEngine
             {
                 Mat4 result;
             
-                for (int i = 0; i < 4; ++i)
-                {
-                    for (int j = 0; j < 4; ++j)
-                    {
-                        result.data[i][j] = data[j][i];
-                    }
-                }
+            #ifdef PULSE_SIMD_SSE
+                Simd::TransposeSSE(data.Ptr(), result.Ptr());
+            #else
+                Simd::TransposeScalar(data.Ptr(), result.Ptr());
+            #endif
             
                 return result;
             }
@@ -451,32 +332,19 @@ namespace PulseEngine
                                                 const PulseEngine::Vector4& rotation, // quaternion
                                                 const PulseEngine::Vector3& scale)
                 {
-                    float x = rotation.x, y = rotation.y, z = rotation.z, w = rotation.a;
-                    float sx = scale.x, sy = scale.y, sz = scale.z;
-                
-                    PulseEngine::Mat4 result(1.0f);
-                
-                    result[0][0] = (1 - 2*y*y - 2*z*z) * sx;
-                    result[0][1] = (2*x*y + 2*w*z) * sx;
-                    result[0][2] = (2*x*z - 2*w*y) * sx;
-                    result[0][3] = 0.0f;
-                
-                    result[1][0] = (2*x*y - 2*w*z) * sy;
-                    result[1][1] = (1 - 2*x*x - 2*z*z) * sy;
-                    result[1][2] = (2*y*z + 2*w*x) * sy;
-                    result[1][3] = 0.0f;
-                
-                    result[2][0] = (2*x*z + 2*w*y) * sz;
-                    result[2][1] = (2*y*z - 2*w*x) * sz;
-                    result[2][2] = (1 - 2*x*x - 2*y*y) * sz;
-                    result[2][3] = 0.0f;
-                
-                    result[3][0] = position.x;
-                    result[3][1] = position.y;
-                    result[3][2] = position.z;
-                    result[3][3] = 1.0f;
-                
+                #ifdef PULSE_SIMD_SSE
+                    PulseEngine::Mat4 simdResult;
+                    const float simdPosition[3] = { position.x, position.y, position.z };
+                    const float simdScale[3] = { scale.x, scale.y, scale.z };
+                    Simd::ComposeMatrixSSE(simdPosition, &rotation.x, simdScale, simdResult.Ptr());
+                    return simdResult;
+                #else
+                    PulseEngine::Mat4 result;
+                    const float scalarPosition[3] = { position.x, position.y, position.z };
+                    const float scalarScale[3] = { scale.x, scale.y, scale.z };
+                    Simd::ComposeMatrixScalar(scalarPosition, &rotation.x, scalarScale, result.Ptr());
                     return result;
+                #endif
                 }
 
         }
@@ -2,6 +2,7 @@
 
 #include <cmath>
 #include "Common/common.h"
+#include "PulseEngine/core/Math/Simd/MatrixSimd.h"
 
 namespace PulseEngine
 {
@@ -95,12 +96,15 @@ namespace PulseEngine
         // Multiply (Quaternion * Quaternion)
         Quaternion operator*(const Quaternion& q) const
         {
-            return Quaternion(
-                w * q.w - x * q.x - y * q.y - z * q.z,
-                w * q.x + x * q.w + y * q.z - z * q.y,
-                w * q.y - x * q.z + y * q.w + z * q.x,
-                w * q.z + x * q.y - y * q.x + z * q.w
-            );
+        #ifdef PULSE_SIMD_SSE
+            Quaternion result;
+            Simd::QuaternionMultiplySSE(&w, &q.w, &result.w);
+            return result;
+        #else
+            Quaternion result;
+            Simd::QuaternionMultiplyScalar(&w, &q.w, &result.w);
+            return result;
+        #endif
         }
 
         // Rotate a vector
@@ -0,0 +1,237 @@
+/**
+ * @file MatrixScalar.h
+ * @brief Scalar implementation of the operations of MatrixSimd.h, on the same raw floats.
+ * @details Mat4, MathUtils::Matrix and Quaternion call these when PULSE_SIMD_SSE isn't defined (see SimdLanes.h).
+ * They are always compiled so the SSE code can be checked and timed against them in the same binary
+ * (Benchmarks/MathSimdBench.cpp).
+ * @version 0.1
+ * @date 2025-12-05
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+#ifndef MATRIXSCALAR_H
+#define MATRIXSCALAR_H
+
+namespace PulseEngine::Simd
+{
+    /**
+     * @brief out = a * b with the Mat4::operator* convention : out.data[col] = sum_i a.data[i] * b.data[col][i]
+     */
+    inline void Mat4MultiplyScalar(const float* a, const float* b, float* out)
+    {
+        for (int col = 0; col < 4; ++col)
+        {
+            for (int row = 0; row < 4; ++row)
+            {
+                float sum = 0.0f;
+                for (int i = 0; i < 4; ++i)
+                {
+                    sum += a[i * 4 + row] * b[col * 4 + i];
+                }
+                out[col * 4 + row] = sum;
+            }
+        }
+    }
+
+    /**
+     * @brief out[row] = dot(m.data[row], v), same as Mat4::operator*(Vector4).
+     */
+    inline void Mat4TransformScalar(const float* m, const float* v, float* out)
+    {
+        for (int row = 0; row < 4; ++row)
+        {
+            out[row] = m[row * 4 + 0] * v[0] +
+                       m[row * 4 + 1] * v[1] +
+                       m[row * 4 + 2] * v[2] +
+                       m[row * 4 + 3] * v[3];
+        }
+    }
+
+    inline void TransposeScalar(const float* m, float* out)
+    {
+        for (int i = 0; i < 4; ++i)
+        {
+            for (int j = 0; j < 4; ++j)
+            {
+                out[i * 4 + j] = m[j * 4 + i];
+            }
+        }
+    }
+
+    /**
+     * @brief General 4x4 inverse, cofactor expansion.
+     * @return false when the matrix is singular, out is left untouched.
+     */
+    inline bool InverseScalar(const float* m, float* out)
+    {
+        float inv[16];
+
+        inv[0] = m[5]  * m[10] * m[15] -
+                 m[5]  * m[11] * m[14] -
+                 m[9]  * m[6]  * m[15] +
+                 m[9]  * m[7]  * m[14] +
+                 m[13] * m[6]  * m[11] -
+                 m[13] * m[7]  * m[10];
+
+        inv[1] = -m[1]  * m[10] * m[15] +
+                  m[1]  * m[11] * m[14] +
+                  m[9]  * m[2] * m[15] -
+                  m[9]  * m[3] * m[14] -
+                  m[13] * m[2] * m[11] +
+                  m[13] * m[3] * m[10];
+
+        inv[2] = m[1]  * m[6] * m[15] -
+                 m[1]  * m[7] * m[14] -
+                 m[5]  * m[2] * m[15] +
+                 m[5]  * m[3] * m[14] +
+                 m[13] * m[2] * m[7] -
+                 m[13] * m[3] * m[6];
+
+        inv[3] = -m[1]  * m[6] * m[11] +
+                  m[1]  * m[7] * m[10] +
+                  m[5]  * m[2] * m[11] -
+                  m[5]  * m[3] * m[10] -
+                  m[9]  * m[2] * m[7] +
+                  m[9]  * m[3] * m[6];
+
+        inv[4] = -m[4]  * m[10] * m[15] +
+                  m[4]  * m[11] * m[14] +
+                  m[8]  * m[6] * m[15] -
+                  m[8]  * m[7] * m[14] -
+                  m[12] * m[6] * m[11] +
+                  m[12] * m[7] * m[10];
+
+        inv[5] = m[0]  * m[10] * m[15] -
+                 m[0]  * m[11] * m[14] -
+                 m[8]  * m[2] * m[15] +
+                 m[8]  * m[3] * m[14] +
+                 m[12] * m[2] * m[11] -
+                 m[12] * m[3] * m[10];
+
+        inv[6] = -m[0]  * m[6] * m[15] +
+                  m[0]  * m[7] * m[14] +
+                  m[4]  * m[2] * m[15] -
+                  m[4]  * m[3] * m[14] -
+                  m[12] * m[2] * m[7] +
+                  m[12] * m[3] * m[6];
+
+        inv[7] = m[0]  * m[6] * m[11] -
+                 m[0]  * m[7] * m[10] -
+                 m[4]  * m[2] * m[11] +
+                 m[4]  * m[3] * m[10] +
+                 m[8]  * m[2] * m[7] -
+                 m[8]  * m[3] * m[6];
+
+        inv[8] = m[4]  * m[9] * m[15] -
+                 m[4]  * m[11] * m[13] -
+                 m[8]  * m[5] * m[15] +
+                 m[8]  * m[7] * m[13] +
+                 m[12] * m[5] * m[11] -
+                 m[12] * m[7] * m[9];
+
+        inv[9] = -m[0]  * m[9] * m[15] +
+                  m[0]  * m[11] * m[13] +
+                  m[8]  * m[1] * m[15] -
+                  m[8]  * m[3] * m[13] -
+                  m[12] * m[1] * m[11] +
+                  m[12] * m[3] * m[9];
+
+        inv[10] = m[0]  * m[5] * m[15] -
+                  m[0]  * m[7] * m[13] -
+                  m[4]  * m[1] * m[15] +
+                  m[4]  * m[3] * m[13] +
+                  m[12] * m[1] * m[7] -
+                  m[12] * m[3] * m[5];
+
+        inv[11] = -m[0]  * m[5] * m[11] +
+                   m[0]  * m[7] * m[9] +
+                   m[4]  * m[1] * m[11] -
+                   m[4]  * m[3] * m[9] -
+                   m[8]  * m[1] * m[7] +
+                   m[8]  * m[3] * m[5];
+
+        inv[12] = -m[4]  * m[9] * m[14] +
+                   m[4]  * m[10] * m[13] +
+                   m[8]  * m[5] * m[14] -
+                   m[8]  * m[6] * m[13] -
+                   m[12] * m[5] * m[10] +
+                   m[12] * m[6] * m[9];
+
+        inv[13] = m[0]  * m[9] * m[14] -
+                  m[0]  * m[10] * m[13] -
+                  m[8]  * m[1] * m[14] +
+                  m[8]  * m[2] * m[13] +
+                  m[12] * m[1] * m[10] -
+                  m[12] * m[2] * m[9];
+
+        inv[14] = -m[0]  * m[5] * m[14] +
+                   m[0]  * m[6] * m[13] +
+                   m[4]  * m[1] * m[14] -
+                   m[4]  * m[2] * m[13] -
+                   m[12] * m[1] * m[6] +
+                   m[12] * m[2] * m[5];
+
+        inv[15] = m[0]  * m[5] * m[10] -
+                  m[0]  * m[6] * m[9] -
+                  m[4]  * m[1] * m[10] +
+                  m[4]  * m[2] * m[9] +
+                  m[8]  * m[1] * m[6] -
+                  m[8]  * m[2] * m[5];
+
+        float det = m[0] * inv[0] + m[1] * inv[4] + m[2] * inv[8] + m[3] * inv[12];
+
+        if (det == 0)
+            return false;
+
+        det = 1.0f / det;
+
+        for (int i = 0; i < 16; i++)
+            out[i] = inv[i] * det;
+        return true;
+    }
+
+    /**
+     * @brief Same layout as MathUtils::Matrix::ComposeMatrix : rotation * scale in data[0..2], position in data[3].
+     * @param q quaternion as (x, y, z, w)
+     */
+    inline void ComposeMatrixScalar(const float* position, const float* q, const float* scale, float* out)
+    {
+        float x = q[0], y = q[1], z = q[2], w = q[3];
+        float sx = scale[0], sy = scale[1], sz = scale[2];
+
+        out[0]  = (1 - 2*y*y - 2*z*z) * sx;
+        out[1]  = (2*x*y + 2*w*z) * sx;
+        out[2]  = (2*x*z - 2*w*y) * sx;
+        out[3]  = 0.0f;
+
+        out[4]  = (2*x*y - 2*w*z) * sy;
+        out[5]  = (1 - 2*x*x - 2*z*z) * sy;
+        out[6]  = (2*y*z + 2*w*x) * sy;
+        out[7]  = 0.0f;
+
+        out[8]  = (2*x*z + 2*w*y) * sz;
+        out[9]  = (2*y*z - 2*w*x) * sz;
+        out[10] = (1 - 2*x*x - 2*y*y) * sz;
+        out[11] = 0.0f;
+
+        out[12] = position[0];
+        out[13] = position[1];
+        out[14] = position[2];
+        out[15] = 1.0f;
+    }
+
+    /**
+     * @brief Hamilton product a * b, quaternions stored as (w, x, y, z) like PulseEngine::Quaternion.
+     */
+    inline void QuaternionMultiplyScalar(const float* a, const float* b, float* out)
+    {
+        const float w = a[0], x = a[1], y = a[2], z = a[3];
+        out[0] = w * b[0] - x * b[1] - y * b[2] - z * b[3];
+        out[1] = w * b[1] + x * b[0] + y * b[3] - z * b[2];
+        out[2] = w * b[2] - x * b[3] + y * b[0] + z * b[1];
+        out[3] = w * b[3] + x * b[2] - y * b[1] + z * b[0];
+    }
+}
+
+#endif // MATRIXSCALAR_H
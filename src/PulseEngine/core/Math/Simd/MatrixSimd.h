@@ -0,0 +1,232 @@
+/**
+ * @file MatrixSimd.h
+ * @brief SSE implementation of the 4x4 matrix and quaternion operations used by Mat4, MathUtils::Matrix and Quaternion.
+ * @details Every function works on raw floats (16 for a matrix, stored like Mat4::data, 4 for a vector or a quaternion)
+ * so this header doesn't depend on the math types and can be included by them.
+ * Only SSE2 is used : Mat4 is exactly four 128 bits registers, AVX wouldn't help here.
+ * The functions only exist when PULSE_SIMD_SSE is defined (see SimdLanes.h), the callers use the scalar ones of
+ * MatrixScalar.h in their #else branch.
+ *
+ * Precision against the scalar code :
+ * - Mat4MultiplySSE, Mat4TransformSSE, TransposeSSE, ComposeMatrixSSE and QuaternionMultiplySSE do the same
+ *   multiplications and additions in the same order, results are identical (except the sign of a zero).
+ * - InverseSSE uses the 2x2 block method, the result differs from the cofactor version by a few ulp.
+ * @version 0.1
+ * @date 2025-12-05
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+#ifndef MATRIXSIMD_H
+#define MATRIXSIMD_H
+
+#include "PulseEngine/core/Math/Simd/SimdLanes.h"
+#include "PulseEngine/core/Math/Simd/MatrixScalar.h"
+
+#ifdef PULSE_SIMD_SSE
+
+namespace PulseEngine::Simd
+{
+    // lane i of the result takes the lane x, y, z or w of the source (same order as _mm_setr_ps)
+    #define PULSE_SHUFFLE_MASK(x, y, z, w) ((x) | ((y) << 2) | ((z) << 4) | ((w) << 6))
+    #define PULSE_SWIZZLE(v, x, y, z, w) _mm_castsi128_ps(_mm_shuffle_epi32(_mm_castps_si128(v), PULSE_SHUFFLE_MASK(x, y, z, w)))
+    #define PULSE_SHUFFLE(a, b, x, y, z, w) _mm_shuffle_ps(a, b, PULSE_SHUFFLE_MASK(x, y, z, w))
+
+    /**
+     * @brief flip the sign of the lanes set to -0.0f in signs.
+     */
+    inline __m128 FlipSigns(__m128 v, float sx, float sy, float sz, float sw)
+    {
+        return _mm_xor_ps(v, _mm_setr_ps(sx, sy, sz, sw));
+    }
+
+    /**
+     * @brief out = a * b with the Mat4::operator* convention : out.data[col] = sum_i a.data[i] * b.data[col][i]
+     */
+    inline void Mat4MultiplySSE(const float* a, const float* b, float* out)
+    {
+        const __m128 a0 = _mm_loadu_ps(a);
+        const __m128 a1 = _mm_loadu_ps(a + 4);
+        const __m128 a2 = _mm_loadu_ps(a + 8);
+        const __m128 a3 = _mm_loadu_ps(a + 12);
+
+        for (int col = 0; col < 4; ++col)
+        {
+            const float* b_col = b + col * 4;
+            __m128 r = _mm_mul_ps(a0, _mm_set1_ps(b_col[0]));
+            r = _mm_add_ps(r, _mm_mul_ps(a1, _mm_set1_ps(b_col[1])));
+            r = _mm_add_ps(r, _mm_mul_ps(a2, _mm_set1_ps(b_col[2])));
+            r = _mm_add_ps(r, _mm_mul_ps(a3, _mm_set1_ps(b_col[3])));
+            _mm_storeu_ps(out + col * 4, r);
+        }
+    }
+
+    /**
+     * @brief out[row] = dot(m.data[row], v), same as Mat4::operator*(Vector4).
+     */
+    inline void Mat4TransformSSE(const float* m, const float* v, float* out)
+    {
+        __m128 c0 = _mm_loadu_ps(m);
+        __m128 c1 = _mm_loadu_ps(m + 4);
+        __m128 c2 = _mm_loadu_ps(m + 8);
+        __m128 c3 = _mm_loadu_ps(m + 12);
+        _MM_TRANSPOSE4_PS(c0, c1, c2, c3);
+
+        __m128 r = _mm_mul_ps(c0, _mm_set1_ps(v[0]));
+        r = _mm_add_ps(r, _mm_mul_ps(c1, _mm_set1_ps(v[1])));
+        r = _mm_add_ps(r, _mm_mul_ps(c2, _mm_set1_ps(v[2])));
+        r = _mm_add_ps(r, _mm_mul_ps(c3, _mm_set1_ps(v[3])));
+        _mm_storeu_ps(out, r);
+    }
+
+    inline void TransposeSSE(const float* m, float* out)
+    {
+        __m128 r0 = _mm_loadu_ps(m);
+        __m128 r1 = _mm_loadu_ps(m + 4);
+        __m128 r2 = _mm_loadu_ps(m + 8);
+        __m128 r3 = _mm_loadu_ps(m + 12);
+        _MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+        _mm_storeu_ps(out, r0);
+        _mm_storeu_ps(out + 4, r1);
+        _mm_storeu_ps(out + 8, r2);
+        _mm_storeu_ps(out + 12, r3);
+    }
+
+    // 2x2 matrices packed in one register as (m00, m01, m10, m11)
+    inline __m128 Mat2Multiply(__m128 a, __m128 b)
+    {
+        return _mm_add_ps(_mm_mul_ps(a, PULSE_SWIZZLE(b, 0, 3, 0, 3)),
+                          _mm_mul_ps(PULSE_SWIZZLE(a, 1, 0, 3, 2), PULSE_SWIZZLE(b, 2, 1, 2, 1)));
+    }
+
+    // adjugate(a) * b
+    inline __m128 Mat2AdjMultiply(__m128 a, __m128 b)
+    {
+        return _mm_sub_ps(_mm_mul_ps(PULSE_SWIZZLE(a, 3, 3, 0, 0), b),
+                          _mm_mul_ps(PULSE_SWIZZLE(a, 1, 1, 2, 2), PULSE_SWIZZLE(b, 2, 3, 0, 1)));
+    }
+
+    // a * adjugate(b)
+    inline __m128 Mat2MultiplyAdj(__m128 a, __m128 b)
+    {
+        return _mm_sub_ps(_mm_mul_ps(a, PULSE_SWIZZLE(b, 3, 0, 3, 0)),
+                          _mm_mul_ps(PULSE_SWIZZLE(a, 1, 0, 3, 2), PULSE_SWIZZLE(b, 2, 1, 2, 1)));
+    }
+
+    /**
+     * @brief General 4x4 inverse, block method on the four 2x2 sub matrices.
+     * @details The inverse of the transpose is the transpose of the inverse, so the storage order doesn't matter.
+     * @return false when the matrix is singular, out is left untouched.
+     */
+    inline bool InverseSSE(const float* m, float* out)
+    {
+        const __m128 r0 = _mm_loadu_ps(m);
+        const __m128 r1 = _mm_loadu_ps(m + 4);
+        const __m128 r2 = _mm_loadu_ps(m + 8);
+        const __m128 r3 = _mm_loadu_ps(m + 12);
+
+        // | A B |
+        // | C D |
+        const __m128 A = _mm_movelh_ps(r0, r1);
+        const __m128 B = _mm_movehl_ps(r1, r0);
+        const __m128 C = _mm_movelh_ps(r2, r3);
+        const __m128 D = _mm_movehl_ps(r3, r2);
+
+        // (|A|, |B|, |C|, |D|)
+        const __m128 detSub = _mm_sub_ps(
+            _mm_mul_ps(PULSE_SHUFFLE(r0, r2, 0, 2, 0, 2), PULSE_SHUFFLE(r1, r3, 1, 3, 1, 3)),
+            _mm_mul_ps(PULSE_SHUFFLE(r0, r2, 1, 3, 1, 3), PULSE_SHUFFLE(r1, r3, 0, 2, 0, 2)));
+        const __m128 detA = PULSE_SWIZZLE(detSub, 0, 0, 0, 0);
+        const __m128 detB = PULSE_SWIZZLE(detSub, 1, 1, 1, 1);
+        const __m128 detC = PULSE_SWIZZLE(detSub, 2, 2, 2, 2);
+        const __m128 detD = PULSE_SWIZZLE(detSub, 3, 3, 3, 3);
+
+        const __m128 D_C = Mat2AdjMultiply(D, C);
+        const __m128 A_B = Mat2AdjMultiply(A, B);
+
+        // adjugates of the blocks of the inverse
+        __m128 X = _mm_sub_ps(_mm_mul_ps(detD, A), Mat2Multiply(B, D_C));
+        __m128 W = _mm_sub_ps(_mm_mul_ps(detA, D), Mat2Multiply(C, A_B));
+        __m128 Y = _mm_sub_ps(_mm_mul_ps(detB, C), Mat2MultiplyAdj(D, A_B));
+        __m128 Z = _mm_sub_ps(_mm_mul_ps(detC, B), Mat2MultiplyAdj(A, D_C));
+
+        // |M| = |A||D| + |B||C| - tr((A#B)(D#C))
+        __m128 trace = _mm_mul_ps(A_B, PULSE_SWIZZLE(D_C, 0, 2, 1, 3));
+        trace = _mm_add_ps(trace, PULSE_SWIZZLE(trace, 1, 0, 3, 2));
+        trace = _mm_add_ps(trace, PULSE_SWIZZLE(trace, 2, 3, 0, 1));
+        const __m128 det = _mm_sub_ps(_mm_add_ps(_mm_mul_ps(detA, detD), _mm_mul_ps(detB, detC)), trace);
+
+        if (_mm_cvtss_f32(det) == 0.0f)
+            return false;
+
+        const __m128 invDet = _mm_div_ps(_mm_setr_ps(1.0f, -1.0f, -1.0f, 1.0f), det);
+        X = _mm_mul_ps(X, invDet);
+        Y = _mm_mul_ps(Y, invDet);
+        Z = _mm_mul_ps(Z, invDet);
+        W = _mm_mul_ps(W, invDet);
+
+        // adjugate of each block and back to rows in the same shuffle
+        _mm_storeu_ps(out,      PULSE_SHUFFLE(X, Y, 3, 1, 3, 1));
+        _mm_storeu_ps(out + 4,  PULSE_SHUFFLE(X, Y, 2, 0, 2, 0));
+        _mm_storeu_ps(out + 8,  PULSE_SHUFFLE(Z, W, 3, 1, 3, 1));
+        _mm_storeu_ps(out + 12, PULSE_SHUFFLE(Z, W, 2, 0, 2, 0));
+        return true;
+    }
+
+    /**
+     * @brief Same layout as MathUtils::Matrix::ComposeMatrix : rotation * scale in data[0..2], position in data[3].
+     * @param q quaternion as (x, y, z, w)
+     */
+    inline void ComposeMatrixSSE(const float* position, const float* q, const float* scale, float* out)
+    {
+        const __m128 qv = _mm_loadu_ps(q);
+        const __m128 q2 = _mm_add_ps(qv, qv);
+        const __m128 xyzMask = _mm_castsi128_ps(_mm_setr_epi32(-1, -1, -1, 0));
+
+        // row 0 : 1 - 2yy - 2zz, 2xy + 2wz, 2xz - 2wy
+        __m128 row0 = _mm_add_ps(_mm_setr_ps(1.0f, 0.0f, 0.0f, 0.0f),
+                                 _mm_mul_ps(FlipSigns(PULSE_SWIZZLE(qv, 1, 0, 0, 3), -0.0f, 0.0f, 0.0f, 0.0f), PULSE_SWIZZLE(q2, 1, 1, 2, 3)));
+        row0 = _mm_add_ps(row0, _mm_mul_ps(FlipSigns(PULSE_SWIZZLE(qv, 2, 3, 3, 3), -0.0f, 0.0f, -0.0f, 0.0f), PULSE_SWIZZLE(q2, 2, 2, 1, 3)));
+
+        // row 1 : 2xy - 2wz, 1 - 2xx - 2zz, 2yz + 2wx
+        __m128 row1 = _mm_add_ps(_mm_setr_ps(0.0f, 1.0f, 0.0f, 0.0f),
+                                 _mm_mul_ps(FlipSigns(PULSE_SWIZZLE(qv, 0, 0, 1, 3), 0.0f, -0.0f, 0.0f, 0.0f), PULSE_SWIZZLE(q2, 1, 0, 2, 3)));
+        row1 = _mm_add_ps(row1, _mm_mul_ps(FlipSigns(PULSE_SWIZZLE(qv, 3, 2, 3, 3), -0.0f, -0.0f, 0.0f, 0.0f), PULSE_SWIZZLE(q2, 2, 2, 0, 3)));
+
+        // row 2 : 2xz + 2wy, 2yz - 2wx, 1 - 2xx - 2yy
+        __m128 row2 = _mm_add_ps(_mm_setr_ps(0.0f, 0.0f, 1.0f, 0.0f),
+                                 _mm_mul_ps(FlipSigns(PULSE_SWIZZLE(qv, 0, 1, 0, 3), 0.0f, 0.0f, -0.0f, 0.0f), PULSE_SWIZZLE(q2, 2, 2, 0, 3)));
+        row2 = _mm_add_ps(row2, _mm_mul_ps(FlipSigns(PULSE_SWIZZLE(qv, 3, 3, 1, 3), 0.0f, -0.0f, -0.0f, 0.0f), PULSE_SWIZZLE(q2, 1, 0, 1, 3)));
+
+        _mm_storeu_ps(out,      _mm_and_ps(_mm_mul_ps(row0, _mm_set1_ps(scale[0])), xyzMask));
+        _mm_storeu_ps(out + 4,  _mm_and_ps(_mm_mul_ps(row1, _mm_set1_ps(scale[1])), xyzMask));
+        _mm_storeu_ps(out + 8,  _mm_and_ps(_mm_mul_ps(row2, _mm_set1_ps(scale[2])), xyzMask));
+        _mm_storeu_ps(out + 12, _mm_setr_ps(position[0], position[1], position[2], 1.0f));
+    }
+
+    /**
+     * @brief Hamilton product a * b, quaternions stored as (w, x, y, z) like PulseEngine::Quaternion.
+     */
+    inline void QuaternionMultiplySSE(const float* a, const float* b, float* out)
+    {
+        const __m128 qb = _mm_loadu_ps(b);
+
+        // w * (bw, bx, by, bz)
+        __m128 r = _mm_mul_ps(_mm_set1_ps(a[0]), qb);
+        // x * (-bx, bw, -bz, by)
+        r = _mm_add_ps(r, _mm_mul_ps(_mm_set1_ps(a[1]), FlipSigns(PULSE_SWIZZLE(qb, 1, 0, 3, 2), -0.0f, 0.0f, -0.0f, 0.0f)));
+        // y * (-by, bz, bw, -bx)
+        r = _mm_add_ps(r, _mm_mul_ps(_mm_set1_ps(a[2]), FlipSigns(PULSE_SWIZZLE(qb, 2, 3, 0, 1), -0.0f, 0.0f, 0.0f, -0.0f)));
+        // z * (-bz, -by, bx, bw)
+        r = _mm_add_ps(r, _mm_mul_ps(_mm_set1_ps(a[3]), FlipSigns(PULSE_SWIZZLE(qb, 3, 2, 1, 0), -0.0f, -0.0f, 0.0f, 0.0f)));
+        _mm_storeu_ps(out, r);
+    }
+
+    #undef PULSE_SWIZZLE
+    #undef PULSE_SHUFFLE
+    #undef PULSE_SHUFFLE_MASK
+}
+
+#endif // PULSE_SIMD_SSE
+
+#endif // MATRIXSIMD_H
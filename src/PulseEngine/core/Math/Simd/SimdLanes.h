@@ -0,0 +1,173 @@
+/**
+ * @file SimdLanes.h
+ * @brief Thin wrappers over the SSE/AVX registers so a kernel can be written once and compiled for 1, 4 or 8 lanes.
+ * @details The instruction set is selected at compile time :
+ * - PULSE_SIMD_AVX when the compiler targets AVX (/arch:AVX2 or -mavx2, already enabled for Jolt),
+ * - PULSE_SIMD_SSE on every x86-64 build,
+ * - ScalarLanes only otherwise, or when PULSE_DISABLE_SIMD is defined.
+ * A kernel is a template over one of the *Lanes structs, PulseEngine::Simd::WideLanes being the widest one available.
+ * @version 0.1
+ * @date 2025-12-04
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+#ifndef SIMDLANES_H
+#define SIMDLANES_H
+
+#include <cmath>
+#include <cstdint>
+#include <algorithm>
+
+#ifndef PULSE_DISABLE_SIMD
+    #if defined(__AVX__)
+        #define PULSE_SIMD_AVX 1
+    #endif
+    #if defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+        #define PULSE_SIMD_SSE 1
+    #endif
+#endif
+
+#if defined(PULSE_SIMD_AVX) || defined(PULSE_SIMD_SSE)
+    #include <immintrin.h>
+#endif
+
+namespace PulseEngine::Simd
+{
+    /**
+     * @brief one lane, plain floats. Reference implementation and fallback.
+     */
+    struct ScalarLanes
+    {
+        static constexpr int Width = 1;
+        static constexpr const char* Name = "Scalar";
+        using Float = float;
+        using Mask = bool;
+
+        static Float Set(float v) { return v; }
+        static Float Load(const float* p) { return p[0]; }
+        static Float Gather(const float* base, const uint32_t* idx) { return base[idx[0]]; }
+        static void Store(float* p, Float v) { p[0] = v; }
+
+        static Float Add(Float a, Float b) { return a + b; }
+        static Float Sub(Float a, Float b) { return a - b; }
+        static Float Mul(Float a, Float b) { return a * b; }
+        static Float Div(Float a, Float b) { return a / b; }
+        static Float MulAdd(Float a, Float b, Float c) { return a * b + c; }
+        static Float Min(Float a, Float b) { return std::min(a, b); }
+        static Float Max(Float a, Float b) { return std::max(a, b); }
+        static Float Abs(Float a) { return std::abs(a); }
+        static Float Sqrt(Float a) { return std::sqrt(a); }
+
+        static Mask True() { return true; }
+        static Mask False() { return false; }
+        static Mask Less(Float a, Float b) { return a < b; }
+        static Mask And(Mask a, Mask b) { return a && b; }
+        static Mask Or(Mask a, Mask b) { return a || b; }
+        static Float Select(Mask m, Float ifTrue, Float ifFalse) { return m ? ifTrue : ifFalse; }
+        static int MoveMask(Mask m) { return m ? 1 : 0; }
+    };
+
+#ifdef PULSE_SIMD_SSE
+    /**
+     * @brief four lanes, SSE2.
+     */
+    struct SSELanes
+    {
+        static constexpr int Width = 4;
+        static constexpr const char* Name = "SSE";
+        using Float = __m128;
+        using Mask = __m128;
+
+        static Float Set(float v) { return _mm_set1_ps(v); }
+        static Float Load(const float* p) { return _mm_loadu_ps(p); }
+        static Float Gather(const float* base, const uint32_t* idx) { return _mm_setr_ps(base[idx[0]], base[idx[1]], base[idx[2]], base[idx[3]]); }
+        static void Store(float* p, Float v) { _mm_storeu_ps(p, v); }
+
+        static Float Add(Float a, Float b) { return _mm_add_ps(a, b); }
+        static Float Sub(Float a, Float b) { return _mm_sub_ps(a, b); }
+        static Float Mul(Float a, Float b) { return _mm_mul_ps(a, b); }
+        static Float Div(Float a, Float b) { return _mm_div_ps(a, b); }
+        static Float MulAdd(Float a, Float b, Float c) { return _mm_add_ps(_mm_mul_ps(a, b), c); }
+        static Float Min(Float a, Float b) { return _mm_min_ps(a, b); }
+        static Float Max(Float a, Float b) { return _mm_max_ps(a, b); }
+        static Float Abs(Float a) { return _mm_andnot_ps(_mm_set1_ps(-0.0f), a); }
+        static Float Sqrt(Float a) { return _mm_sqrt_ps(a); }
+
+        static Mask True() { return _mm_castsi128_ps(_mm_set1_epi32(-1)); }
+        static Mask False() { return _mm_setzero_ps(); }
+        static Mask Less(Float a, Float b) { return _mm_cmplt_ps(a, b); }
+        static Mask And(Mask a, Mask b) { return _mm_and_ps(a, b); }
+        static Mask Or(Mask a, Mask b) { return _mm_or_ps(a, b); }
+        static Float Select(Mask m, Float ifTrue, Float ifFalse) { return _mm_or_ps(_mm_and_ps(m, ifTrue), _mm_andnot_ps(m, ifFalse)); }
+        static int MoveMask(Mask m) { return _mm_movemask_ps(m); }
+    };
+#endif
+
+#ifdef PULSE_SIMD_AVX
+    /**
+     * @brief eight lanes, AVX (FMA and hardware gather when AVX2 is available).
+     */
+    struct AVXLanes
+    {
+        static constexpr int Width = 8;
+        static constexpr const char* Name = "AVX";
+        using Float = __m256;
+        using Mask = __m256;
+
+        static Float Set(float v) { return _mm256_set1_ps(v); }
+        static Float Load(const float* p) { return _mm256_loadu_ps(p); }
+        static Float Gather(const float* base, const uint32_t* idx)
+        {
+        #ifdef __AVX2__
+            return _mm256_i32gather_ps(base, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(idx)), 4);
+        #else
+            return _mm256_setr_ps(base[idx[0]], base[idx[1]], base[idx[2]], base[idx[3]],
+                                  base[idx[4]], base[idx[5]], base[idx[6]], base[idx[7]]);
+        #endif
+        }
+        static void Store(float* p, Float v) { _mm256_storeu_ps(p, v); }
+
+        static Float Add(Float a, Float b) { return _mm256_add_ps(a, b); }
+        static Float Sub(Float a, Float b) { return _mm256_sub_ps(a, b); }
+        static Float Mul(Float a, Float b) { return _mm256_mul_ps(a, b); }
+        static Float Div(Float a, Float b) { return _mm256_div_ps(a, b); }
+        static Float MulAdd(Float a, Float b, Float c)
+        {
+        #ifdef __FMA__
+            return _mm256_fmadd_ps(a, b, c);
+        #else
+            return _mm256_add_ps(_mm256_mul_ps(a, b), c);
+        #endif
+        }
+        static Float Min(Float a, Float b) { return _mm256_min_ps(a, b); }
+        static Float Max(Float a, Float b) { return _mm256_max_ps(a, b); }
+        static Float Abs(Float a) { return _mm256_andnot_ps(_mm256_set1_ps(-0.0f), a); }
+        static Float Sqrt(Float a) { return _mm256_sqrt_ps(a); }
+
+        static Mask True() { return _mm256_castsi256_ps(_mm256_set1_epi32(-1)); }
+        static Mask False() { return _mm256_setzero_ps(); }
+        static Mask Less(Float a, Float b) { return _mm256_cmp_ps(a, b, _CMP_LT_OQ); }
+        static Mask And(Mask a, Mask b) { return _mm256_and_ps(a, b); }
+        static Mask Or(Mask a, Mask b) { return _mm256_or_ps(a, b); }
+        static Float Select(Mask m, Float ifTrue, Float ifFalse) { return _mm256_blendv_ps(ifFalse, ifTrue, m); }
+        static int MoveMask(Mask m) { return _mm256_movemask_ps(m); }
+    };
+#endif
+
+#if defined(PULSE_SIMD_AVX)
+    using WideLanes = AVXLanes;
+#elif defined(PULSE_SIMD_SSE)
+    using WideLanes = SSELanes;
+#else
+    using WideLanes = ScalarLanes;
+#endif
+
+    /**
+     * @brief bit set for every lane of a Width-wide group.
+     */
+    template <typename Lanes>
+    constexpr int AllLanesMask() { return (1 << Lanes::Width) - 1; }
+}
+
+#endif // SIMDLANES_H
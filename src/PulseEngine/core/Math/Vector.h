@@ -4,6 +4,7 @@
 #include <cmath>
 #include <iostream>
 #include <stdexcept>
+#include <cassert>
 
 #include "Common/dllExport.h"
 
@@ -47,15 +48,17 @@ namespace PulseEngine
 
 
         
+        // x, y, z are contiguous : plain indexed access, no branch so the loops using it stay vectorizable
         float& operator[](int index)
         {
-            switch (index)
-            {
-                case 0: return x;
-                case 1: return y;
-                case 2: return z;
-                default: throw std::out_of_range("Index out of range for Vector3");
-            }
+            assert(index >= 0 && index < 3 && "Index out of range for Vector3");
+            return (&x)[index];
+        }
+
+        const float& operator[](int index) const
+        {
+            assert(index >= 0 && index < 3 && "Index out of range for Vector3");
+            return (&x)[index];
         }
 
         // Add assignment operator+=
@@ -192,26 +195,14 @@ namespace PulseEngine
         
         const float& operator[] (int index) const
         {
-            switch (index)
-            {
-                case 0: return x;
-                case 1: return y;
-                case 2: return z;
-                case 3: return a;
-                default: throw std::out_of_range("Index out of range for Vector4");
-            }
+            assert(index >= 0 && index < 4 && "Index out of range for Vector4");
+            return (&x)[index];
         }
 
         float& operator[] (int index)
         {
-            switch (index)
-            {
-                case 0: return x;
-                case 1: return y;
-                case 2: return z;
-                case 3: return a;
-                default: throw std::out_of_range("Index out of range for Vector4");
-            }
+            assert(index >= 0 && index < 4 && "Index out of range for Vector4");
+            return (&x)[index];
         }
     };
     /**
@@ -228,26 +219,14 @@ namespace PulseEngine
         
         const int& operator[] (int index) const
         {
-            switch (index)
-            {
-                case 0: return x;
-                case 1: return y;
-                case 2: return z;
-                case 3: return a;
-                default: throw std::out_of_range("Index out of range for iVector4");
-            }
+            assert(index >= 0 && index < 4 && "Index out of range for iVector4");
+            return (&x)[index];
         }
 
         int& operator[] (int index)
         {
-            switch (index)
-            {
-                case 0: return x;
-                case 1: return y;
-                case 2: return z;
-                case 3: return a;
-                default: throw std::out_of_range("Index out of range for iVector4");
-            }
+            assert(index >= 0 && index < 4 && "Index out of range for iVector4");
+            return (&x)[index];
         }
 
     };
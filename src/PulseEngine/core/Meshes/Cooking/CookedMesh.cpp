@@ -0,0 +1,606 @@
+#include "CookedMesh.h"
+#include "Common/common.h"
+#include "PulseEngine/core/FileManager/Pak/PakArchive.h"
+#include "PulseEngine/core/FileManager/Pak/PakManager.h"
+#include "PulseEngine/core/GUID/GuidReader.h"
+#include "PulseEngine/core/Meshes/Mesh.h"
+#include "PulseEngine/core/Meshes/Cooking/MeshOptimizer.h"
+
+#include <assimp/Importer.hpp>
+#include <assimp/scene.h>
+#include <assimp/postprocess.h>
+
+#include <algorithm>
+#include <cctype>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iterator>
+
+namespace fs = std::filesystem;
+using namespace PulseEngine::Cooking;
+
+namespace
+{
+    constexpr std::size_t BUFFER_ALIGNMENT = 16;
+
+    // same flags as the Assimp path of GuidReader::GetMeshFromGuid and Primitive had, the cache ordering is done by
+    // ProcessMesh (MeshOptimizer.h) once the vertices are read
+    constexpr unsigned int MESH_IMPORT_FLAGS =
+        aiProcess_Triangulate |
+        aiProcess_GenSmoothNormals |
+        aiProcess_CalcTangentSpace |
+        aiProcess_JoinIdenticalVertices |
+        aiProcess_LimitBoneWeights |
+        aiProcess_OptimizeMeshes |
+        aiProcess_OptimizeGraph;
+
+    constexpr unsigned int PRIMITIVE_IMPORT_FLAGS =
+        aiProcess_Triangulate |
+        aiProcess_FlipUVs |
+        aiProcess_GenNormals |
+        aiProcess_CalcTangentSpace;
+
+    struct BinaryWriter
+    {
+        std::vector<char> buffer;
+
+        template <typename T>
+        void Write(const T& value)
+        {
+            const char* bytes = reinterpret_cast<const char*>(&value);
+            buffer.insert(buffer.end(), bytes, bytes + sizeof(T));
+        }
+
+        void WriteFloats(const float* values, std::size_t count)
+        {
+            const char* bytes = reinterpret_cast<const char*>(values);
+            buffer.insert(buffer.end(), bytes, bytes + count * sizeof(float));
+        }
+
+        void WriteString(const std::string& value)
+        {
+            Write((uint32_t)value.size());
+            buffer.insert(buffer.end(), value.begin(), value.end());
+        }
+
+        void WriteMatrix(const PulseEngine::Mat4& matrix)
+        {
+            WriteFloats(&matrix.data[0][0], 16);
+        }
+
+        void Align()
+        {
+            buffer.resize((buffer.size() + BUFFER_ALIGNMENT - 1) / BUFFER_ALIGNMENT * BUFFER_ALIGNMENT, 0);
+        }
+    };
+
+    struct BinaryReader
+    {
+        const char* data;
+        std::size_t size;
+        std::size_t cursor = 0;
+        bool failed = false;
+
+        template <typename T>
+        T Read()
+        {
+            T value{};
+            if (!Has(sizeof(T))) return value;
+            std::memcpy(&value, data + cursor, sizeof(T));
+            cursor += sizeof(T);
+            return value;
+        }
+
+        void ReadFloats(float* values, std::size_t count)
+        {
+            if (!Has(count * sizeof(float))) return;
+            std::memcpy(values, data + cursor, count * sizeof(float));
+            cursor += count * sizeof(float);
+        }
+
+        std::string ReadString()
+        {
+            const uint32_t length = Read<uint32_t>();
+            if (!Has(length)) return std::string();
+            std::string value(data + cursor, length);
+            cursor += length;
+            return value;
+        }
+
+        PulseEngine::Mat4 ReadMatrix()
+        {
+            PulseEngine::Mat4 matrix;
+            ReadFloats(&matrix.data[0][0], 16);
+            return matrix;
+        }
+
+        /**
+         * @brief Pointer to count bytes and skip them, nullptr when the file is too short.
+         */
+        const char* Skip(std::size_t count)
+        {
+            if (!Has(count)) return nullptr;
+            const char* bytes = data + cursor;
+            cursor += count;
+            return bytes;
+        }
+
+        void Align()
+        {
+            cursor = (cursor + BUFFER_ALIGNMENT - 1) / BUFFER_ALIGNMENT * BUFFER_ALIGNMENT;
+        }
+
+        bool Has(std::size_t count)
+        {
+            if (failed || cursor > size || count > size - cursor) failed = true;
+            return !failed;
+        }
+    };
+
+    // the vector types have user copy constructors : the vertices are written field by field, in the attribute order
+    void WriteVertex(char* out, const Vertex& vertex)
+    {
+        std::memcpy(out, &vertex.Position.x, 12);
+        std::memcpy(out + 12, &vertex.Normal.x, 12);
+        std::memcpy(out + 24, &vertex.TexCoords.x, 8);
+        std::memcpy(out + 32, &vertex.Tangent.x, 12);
+        std::memcpy(out + 44, &vertex.Bitangent.x, 12);
+    }
+
+    void ReadVertex(const char* in, Vertex& vertex)
+    {
+        std::memcpy(&vertex.Position.x, in, 12);
+        std::memcpy(&vertex.Normal.x, in + 12, 12);
+        std::memcpy(&vertex.TexCoords.x, in + 24, 8);
+        std::memcpy(&vertex.Tangent.x, in + 32, 12);
+        std::memcpy(&vertex.Bitangent.x, in + 44, 12);
+    }
+
+    void WriteSkin(char* out, const SkinWeights& skin)
+    {
+        std::memcpy(out, &skin.BoneIDs.x, 16);
+        std::memcpy(out + 16, &skin.Weights.x, 16);
+    }
+
+    void ReadSkin(const char* in, SkinWeights& skin)
+    {
+        std::memcpy(&skin.BoneIDs.x, in, 16);
+        std::memcpy(&skin.Weights.x, in + 16, 16);
+    }
+
+    void WriteAnimation(BinaryWriter& writer, const AnimationClip& clip)
+    {
+        writer.WriteString(clip.name);
+        writer.Write(clip.duration);
+        writer.Write((int32_t)clip.tickPerSeconds);
+
+        // bone names once per clip, the keyframes reference them by index
+        std::vector<std::string> channels;
+        std::unordered_map<std::string, uint32_t> channelIndex;
+        for (const KeyFrame& frame : clip.keyframes)
+        {
+            for (const auto& [bone, transform] : frame.boneTransforms)
+            {
+                if (channelIndex.emplace(bone, (uint32_t)channels.size()).second) channels.push_back(bone);
+            }
+        }
+        writer.Write((uint32_t)channels.size());
+        for (const std::string& channel : channels) writer.WriteString(channel);
+
+        writer.Write((uint32_t)clip.keyframes.size());
+        for (const KeyFrame& frame : clip.keyframes)
+        {
+            writer.Write(frame.time);
+            writer.Write((uint32_t)frame.boneTransforms.size());
+            for (const auto& [bone, transform] : frame.boneTransforms)
+            {
+                writer.Write(channelIndex[bone]);
+                writer.WriteFloats(&transform.position.x, 3);
+                writer.WriteFloats(&transform.scale.x, 3);
+                writer.WriteFloats(&transform.rotation.x, 4);
+            }
+        }
+    }
+
+    bool ReadAnimation(BinaryReader& reader, AnimationClip& clip)
+    {
+        clip.name = reader.ReadString();
+        clip.duration = reader.Read<double>();
+        clip.tickPerSeconds = reader.Read<int32_t>();
+
+        const uint32_t channelCount = reader.Read<uint32_t>();
+        std::vector<std::string> channels;
+        for (uint32_t i = 0; i < channelCount && !reader.failed; ++i) channels.push_back(reader.ReadString());
+
+        const uint32_t frameCount = reader.Read<uint32_t>();
+        for (uint32_t f = 0; f < frameCount && !reader.failed; ++f)
+        {
+            KeyFrame frame;
+            frame.time = reader.Read<double>();
+            const uint32_t transformCount = reader.Read<uint32_t>();
+            frame.boneTransforms.reserve(transformCount < channels.size() ? transformCount : channels.size());
+            for (uint32_t t = 0; t < transformCount && !reader.failed; ++t)
+            {
+                const uint32_t channel = reader.Read<uint32_t>();
+                TransformAnimation transform;
+                reader.ReadFloats(&transform.position.x, 3);
+                reader.ReadFloats(&transform.scale.x, 3);
+                reader.ReadFloats(&transform.rotation.x, 4);
+                if (channel >= channels.size()) return false;
+                frame.boneTransforms[channels[channel]] = transform;
+            }
+            clip.keyframes.push_back(std::move(frame));
+        }
+        return !reader.failed;
+    }
+
+    /**
+     * @brief Same result as the Assimp path of GuidReader::GetMeshFromGuid, without any GPU upload.
+     */
+    bool FillFromScene(const aiScene* scene, unsigned int importFlags, CookedMesh& out, std::string& error)
+    {
+        out = CookedMesh();
+        out.name = scene->mName.C_Str();
+        out.importFlags = importFlags;
+
+        // animated meshes are skeletal meshes, their bones are resolved through the skeleton
+        SkeletalMesh skeleton(out.name);
+        const bool animated = scene->mNumAnimations > 0;
+        if (animated)
+        {
+            GuidReader::LoadSkeletonFromAssimp(&skeleton, scene);
+            GuidReader::LoadAnimationsFromAssimp(&skeleton, scene);
+        }
+
+        out.meshes.resize(scene->mNumMeshes);
+        for (unsigned int i = 0; i < scene->mNumMeshes; ++i)
+        {
+            const aiMesh* mesh = scene->mMeshes[i];
+            CookedSubMesh& subMesh = out.meshes[i];
+            subMesh.name = mesh->mName.C_Str();
+            subMesh.materialIndex = mesh->mMaterialIndex;
+            if (!Mesh::ExtractFromAssimp(mesh, scene, animated ? &skeleton : nullptr, subMesh.vertices, subMesh.skin, subMesh.indices))
+            {
+                error = "can't read the vertices of " + subMesh.name;
+                return false;
+            }
+
+            // point and line primitives of a mixed mesh are left as they are
+            if (mesh->mPrimitiveTypes == aiPrimitiveType_TRIANGLE)
+                ProcessMesh(subMesh.vertices, subMesh.indices, subMesh.lods, MeshLodSettings(), subMesh.skin.empty() ? nullptr : &subMesh.skin);
+        }
+
+        std::function<void(const aiNode*, int32_t)> addNode = [&](const aiNode* node, int32_t parent)
+        {
+            CookedMeshNode cookedNode;
+            cookedNode.name = node->mName.C_Str();
+            cookedNode.parent = parent;
+            cookedNode.transform = SkeletalMesh::ConvertAiMatrix(node->mTransformation);
+            cookedNode.meshes.assign(node->mMeshes, node->mMeshes + node->mNumMeshes);
+
+            const int32_t index = (int32_t)out.nodes.size();
+            out.nodes.push_back(std::move(cookedNode));
+            for (unsigned int i = 0; i < node->mNumChildren; ++i) addNode(node->mChildren[i], index);
+        };
+        addNode(scene->mRootNode, -1);
+
+        if (animated)
+        {
+            out.bones = std::move(skeleton.skeleton);
+            out.animations = std::move(skeleton.animations);
+        }
+        return true;
+    }
+
+    bool CheckScene(const Assimp::Importer& importer, const aiScene* scene, std::string& error)
+    {
+        if (!scene || scene->mFlags & AI_SCENE_FLAGS_INCOMPLETE || !scene->mRootNode)
+        {
+            error = std::string("Assimp: ") + importer.GetErrorString();
+            return false;
+        }
+        return true;
+    }
+}
+
+std::string PulseEngine::Cooking::GetCookedMeshPath(const std::string& sourcePath)
+{
+    return sourcePath + ".pmdl";
+}
+
+std::string PulseEngine::Cooking::GetImportedMeshPath(const std::string& assetPath)
+{
+    return IMPORTED_MESH_DIRECTORY + PulseEngine::FileSystem::NormalizePakPath(assetPath) + ".pmdl";
+}
+
+bool PulseEngine::Cooking::IsCookableMesh(const std::string& extension)
+{
+    std::string lower = extension;
+    std::transform(lower.begin(), lower.end(), lower.begin(), [](unsigned char c) { return (char)std::tolower(c); });
+    return lower == ".fbx" || lower == ".obj" || lower == ".dae" || lower == ".glb";
+}
+
+unsigned int PulseEngine::Cooking::GetMeshImportFlags(const std::string& assetPath)
+{
+    const std::string path = PulseEngine::FileSystem::NormalizePakPath(assetPath);
+    return path.rfind("engineconfig/models/primitives/", 0) == 0 ? PRIMITIVE_IMPORT_FLAGS : MESH_IMPORT_FLAGS;
+}
+
+bool PulseEngine::Cooking::ImportMesh(const std::string& sourcePath, unsigned int importFlags, CookedMesh& out, std::string& error)
+{
+    Assimp::Importer importer;
+    const aiScene* scene = importer.ReadFile(sourcePath, importFlags);
+    if (!CheckScene(importer, scene, error)) return false;
+    return FillFromScene(scene, importFlags, out, error);
+}
+
+bool PulseEngine::Cooking::ImportMeshFromMemory(const std::vector<char>& bytes, const std::string& extensionHint, unsigned int importFlags,
+                                                CookedMesh& out, std::string& error)
+{
+    Assimp::Importer importer;
+    const aiScene* scene = importer.ReadFileFromMemory(bytes.data(), bytes.size(), importFlags, extensionHint.c_str());
+    if (!CheckScene(importer, scene, error)) return false;
+    return FillFromScene(scene, importFlags, out, error);
+}
+
+bool PulseEngine::Cooking::WriteCookedMesh(const std::string& path, const CookedMesh& mesh)
+{
+    BinaryWriter writer;
+    writer.Write(COOKED_MESH_MAGIC);
+    writer.Write(COOKED_MESH_VERSION);
+    writer.Write(COOKED_VERTEX_SIZE);
+    writer.Write(mesh.importFlags);
+    writer.WriteString(mesh.name);
+
+    writer.Write((uint32_t)mesh.meshes.size());
+    for (const CookedSubMesh& subMesh : mesh.meshes)
+    {
+        writer.WriteString(subMesh.name);
+        writer.Write(subMesh.materialIndex);
+        writer.Write((uint32_t)subMesh.vertices.size());
+        writer.Write((uint32_t)subMesh.skin.size());
+        writer.Write((uint32_t)subMesh.indices.size());
+
+        writer.Align();
+        std::size_t offset = writer.buffer.size();
+        writer.buffer.resize(offset + subMesh.vertices.size() * COOKED_VERTEX_SIZE);
+        for (const Vertex& vertex : subMesh.vertices)
+        {
+            WriteVertex(writer.buffer.data() + offset, vertex);
+            offset += COOKED_VERTEX_SIZE;
+        }
+
+        writer.Align();
+        offset = writer.buffer.size();
+        writer.buffer.resize(offset + subMesh.skin.size() * COOKED_SKIN_SIZE);
+        for (const SkinWeights& skin : subMesh.skin)
+        {
+            WriteSkin(writer.buffer.data() + offset, skin);
+            offset += COOKED_SKIN_SIZE;
+        }
+
+        writer.Align();
+        for (unsigned int index : subMesh.indices) writer.Write((uint32_t)index);
+
+        writer.Write((uint32_t)subMesh.lods.size());
+        for (const MeshLod& lod : subMesh.lods)
+        {
+            writer.Write((uint32_t)lod.indexOffset);
+            writer.Write((uint32_t)lod.indexCount);
+            writer.Write(lod.error);
+        }
+    }
+
+    writer.Write((uint32_t)mesh.nodes.size());
+    for (const CookedMeshNode& node : mesh.nodes)
+    {
+        writer.WriteString(node.name);
+        writer.Write(node.parent);
+        writer.WriteMatrix(node.transform);
+        writer.Write((uint32_t)node.meshes.size());
+        for (uint32_t index : node.meshes) writer.Write(index);
+    }
+
+    writer.Write((uint32_t)mesh.bones.size());
+    for (const Bone& bone : mesh.bones)
+    {
+        writer.WriteString(bone.name);
+        writer.Write((int32_t)bone.index);
+        writer.Write((int32_t)bone.parentIndex);
+        writer.WriteMatrix(bone.offsetMatrix);
+        writer.WriteMatrix(bone.localTransform);
+    }
+
+    writer.Write((uint32_t)mesh.animations.size());
+    for (const AnimationClip& clip : mesh.animations) WriteAnimation(writer, clip);
+
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (!file.is_open()) return false;
+    file.write(writer.buffer.data(), (std::streamsize)writer.buffer.size());
+    return file.good();
+}
+
+bool PulseEngine::Cooking::ReadCookedMesh(const char* data, std::size_t size, CookedMesh& out)
+{
+    BinaryReader reader{ data, size };
+    if (reader.Read<uint32_t>() != COOKED_MESH_MAGIC || reader.Read<uint16_t>() != COOKED_MESH_VERSION) return false;
+    if (reader.Read<uint16_t>() != COOKED_VERTEX_SIZE) return false;
+
+    out = CookedMesh();
+    out.importFlags = reader.Read<uint32_t>();
+    out.name = reader.ReadString();
+
+    const uint32_t meshCount = reader.Read<uint32_t>();
+    for (uint32_t m = 0; m < meshCount && !reader.failed; ++m)
+    {
+        CookedSubMesh subMesh;
+        subMesh.name = reader.ReadString();
+        subMesh.materialIndex = reader.Read<uint32_t>();
+        const uint32_t vertexCount = reader.Read<uint32_t>();
+        const uint32_t skinCount = reader.Read<uint32_t>();
+        const uint32_t indexCount = reader.Read<uint32_t>();
+        if (skinCount != 0 && skinCount != vertexCount) return false;
+
+        reader.Align();
+        const char* vertices = reader.Skip((std::size_t)vertexCount * COOKED_VERTEX_SIZE);
+        reader.Align();
+        const char* skin = reader.Skip((std::size_t)skinCount * COOKED_SKIN_SIZE);
+        reader.Align();
+        const char* indices = reader.Skip((std::size_t)indexCount * sizeof(uint32_t));
+        if (reader.failed) return false;
+
+        subMesh.vertices.resize(vertexCount);
+        for (uint32_t v = 0; v < vertexCount; ++v) ReadVertex(vertices + (std::size_t)v * COOKED_VERTEX_SIZE, subMesh.vertices[v]);
+        subMesh.skin.resize(skinCount);
+        for (uint32_t v = 0; v < skinCount; ++v) ReadSkin(skin + (std::size_t)v * COOKED_SKIN_SIZE, subMesh.skin[v]);
+
+        subMesh.indices.resize(indexCount);
+        if (indexCount > 0) std::memcpy(subMesh.indices.data(), indices, (std::size_t)indexCount * sizeof(uint32_t));
+        for (unsigned int index : subMesh.indices)
+        {
+            if (index >= vertexCount) return false;
+        }
+
+        const uint32_t lodCount = reader.Read<uint32_t>();
+        for (uint32_t l = 0; l < lodCount && !reader.failed; ++l)
+        {
+            MeshLod lod;
+            lod.indexOffset = reader.Read<uint32_t>();
+            lod.indexCount = reader.Read<uint32_t>();
+            lod.error = reader.Read<float>();
+            if ((uint64_t)lod.indexOffset + lod.indexCount > indexCount || lod.indexCount % 3 != 0) return false;
+            subMesh.lods.push_back(lod);
+        }
+        out.meshes.push_back(std::move(subMesh));
+    }
+
+    const uint32_t nodeCount = reader.Read<uint32_t>();
+    for (uint32_t n = 0; n < nodeCount && !reader.failed; ++n)
+    {
+        CookedMeshNode node;
+        node.name = reader.ReadString();
+        node.parent = reader.Read<int32_t>();
+        node.transform = reader.ReadMatrix();
+        const uint32_t count = reader.Read<uint32_t>();
+        for (uint32_t i = 0; i < count && !reader.failed; ++i)
+        {
+            const uint32_t index = reader.Read<uint32_t>();
+            if (index >= out.meshes.size()) return false;
+            node.meshes.push_back(index);
+        }
+        if (node.parent >= (int32_t)n) return false;
+        out.nodes.push_back(std::move(node));
+    }
+
+    const uint32_t boneCount = reader.Read<uint32_t>();
+    for (uint32_t b = 0; b < boneCount && !reader.failed; ++b)
+    {
+        Bone bone;
+        bone.name = reader.ReadString();
+        bone.index = reader.Read<int32_t>();
+        bone.parentIndex = reader.Read<int32_t>();
+        bone.offsetMatrix = reader.ReadMatrix();
+        bone.localTransform = reader.ReadMatrix();
+        if (bone.index < 0 || bone.index >= (int32_t)boneCount || bone.parentIndex >= (int32_t)boneCount) return false;
+        out.bones.push_back(std::move(bone));
+    }
+
+    const uint32_t animationCount = reader.Read<uint32_t>();
+    for (uint32_t a = 0; a < animationCount && !reader.failed; ++a)
+    {
+        AnimationClip clip;
+        if (!ReadAnimation(reader, clip)) return false;
+        out.animations.push_back(std::move(clip));
+    }
+    return !reader.failed;
+}
+
+bool PulseEngine::Cooking::ReadCookedMesh(const std::vector<char>& bytes, CookedMesh& out)
+{
+    return ReadCookedMesh(bytes.data(), bytes.size(), out);
+}
+
+bool PulseEngine::Cooking::ReadCookedMeshFile(const std::string& path, CookedMesh& out)
+{
+    std::ifstream file(path, std::ios::binary);
+    if (!file.is_open()) return false;
+    const std::vector<char> buffer((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    return ReadCookedMesh(buffer, out);
+}
+
+bool PulseEngine::Cooking::CookMesh(const std::string& sourcePath, const std::string& destinationPath, unsigned int importFlags, std::string& error)
+{
+    CookedMesh mesh;
+    if (!ImportMesh(sourcePath, importFlags, mesh, error))
+    {
+        error = sourcePath + ": " + error;
+        return false;
+    }
+
+    std::error_code ec;
+    const fs::path destination(destinationPath);
+    if (destination.has_parent_path()) fs::create_directories(destination.parent_path(), ec);
+
+    if (!WriteCookedMesh(destinationPath, mesh))
+    {
+        error = "can't write " + destinationPath;
+        return false;
+    }
+    return true;
+}
+
+bool PulseEngine::Cooking::LoadMeshAsset(const std::string& assetPath, CookedMesh& out)
+{
+    const unsigned int importFlags = GetMeshImportFlags(assetPath);
+    std::string error;
+
+#ifdef ENGINE_EDITOR
+    const std::string sourcePath = std::string(ASSET_PATH) + assetPath;
+    const std::string importedPath = GetImportedMeshPath(assetPath);
+
+    std::error_code ec;
+    const fs::file_time_type sourceTime = fs::last_write_time(sourcePath, ec);
+    if (ec)
+    {
+        EDITOR_ERROR("Mesh source not found : " << sourcePath)
+        return false;
+    }
+
+    std::error_code importedEc;
+    const fs::file_time_type importedTime = fs::last_write_time(importedPath, importedEc);
+    if (!importedEc && importedTime >= sourceTime && ReadCookedMeshFile(importedPath, out) && out.importFlags == importFlags) return true;
+
+    if (!ImportMesh(sourcePath, importFlags, out, error))
+    {
+        EDITOR_ERROR("Erreur import du mesh " << sourcePath << " : " << error)
+        return false;
+    }
+
+    fs::create_directories(fs::path(importedPath).parent_path(), ec);
+    if (!WriteCookedMesh(importedPath, out))
+    {
+        EDITOR_WARN("Imported mesh couldn't be written : " << importedPath)
+    }
+    return true;
+#else
+    std::vector<char> bytes;
+    if (PulseEngine::FileSystem::ReadAssetFile(GetCookedMeshPath(assetPath), bytes) && ReadCookedMesh(bytes, out) && out.importFlags == importFlags) return true;
+
+    // not cooked (loose files) : import the source, read through the pack like every asset
+    EDITOR_WARN("No cooked mesh for " << assetPath << ", importing the source.")
+    if (!PulseEngine::FileSystem::ReadAssetFile(assetPath, bytes))
+    {
+        EDITOR_ERROR("Mesh source not found : " << assetPath)
+        return false;
+    }
+    const std::string extension = fs::path(assetPath).extension().string();
+    if (!ImportMeshFromMemory(bytes, extension.empty() ? std::string() : extension.substr(1), importFlags, out, error))
+    {
+        EDITOR_ERROR("Erreur import du mesh " << assetPath << " : " << error)
+        return false;
+    }
+    return true;
+#endif
+}
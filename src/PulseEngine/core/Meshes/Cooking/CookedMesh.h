@@ -0,0 +1,117 @@
+/**
+ * @file CookedMesh.h
+ * @brief Import-time cook of the mesh sources (.fbx, .obj...) into .pmdl files read without Assimp.
+ * @details Assimp (triangulation, smooth normals, tangents, vertex welding, graph optimisation) and MeshOptimizer
+ * (triangle order, LODs) only run when a mesh is cooked. The .pmdl keeps their result : final vertex and index buffers
+ * of every sub mesh with its LOD ranges, the node hierarchy, the skeleton and the animation clips.
+ * - the game build cooks "models/cube.fbx" into "models/cube.fbx.pmdl" (AssetBuilder) and reads it from the pack.
+ * - the editor imports the source once into IMPORTED_MESH_DIRECTORY and imports it again only when the source is newer.
+ *
+ * Layout (little endian) : magic "PMDL", uint16 version, uint16 vertex size, uint32 import flags, then the fields in
+ * declaration order, strings as uint32 length + bytes. Vertex, bone data and index buffers start on a 16 bytes boundary
+ * of the file (pack entries are 256 aligned), the vertices in the attribute order of Vertex : they go to the GPU as they
+ * are. The bone data (SkinWeights) is a stream of its own, only written for the sub meshes of an animated mesh.
+ * @version 0.1
+ * @date 2025-12-13
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+#ifndef COOKEDMESH_H
+#define COOKEDMESH_H
+
+#include "Common/dllExport.h"
+#include "PulseEngine/core/Meshes/Vertex.h"
+#include "PulseEngine/core/Meshes/Mesh.h"
+#include "PulseEngine/core/Meshes/SkeletalMesh.h"
+#include "PulseEngine/core/Math/Mat4.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace PulseEngine::Cooking
+{
+    constexpr uint32_t COOKED_MESH_MAGIC = 0x4C444D50; // "PMDL"
+    constexpr uint16_t COOKED_MESH_VERSION = 3;
+    constexpr uint16_t COOKED_VERTEX_SIZE = 14 * 4;     ///< position, normal, uv, tangent, bitangent
+    constexpr uint16_t COOKED_SKIN_SIZE = 8 * 4;        ///< bone ids, weights
+
+    /// @brief Editor import cache, relative to the working directory like the build cache.
+    static const std::string IMPORTED_MESH_DIRECTORY = "BuildCache/Imported/";
+
+    struct CookedSubMesh
+    {
+        std::string name;
+        uint32_t materialIndex = 0;
+        std::vector<Vertex> vertices;
+        std::vector<SkinWeights> skin;      ///< one per vertex, empty when the mesh isn't animated
+        std::vector<unsigned int> indices;  ///< every LOD, one after the other
+        std::vector<MeshLod> lods;          ///< empty : one level, the whole index buffer
+    };
+
+    struct CookedMeshNode
+    {
+        std::string name;
+        int32_t parent = -1;                ///< always before the node
+        PulseEngine::Mat4 transform;        ///< relative to the parent
+        std::vector<uint32_t> meshes;       ///< indices in CookedMesh::meshes
+    };
+
+    struct CookedMesh
+    {
+        std::string name;
+        uint32_t importFlags = 0;           ///< Assimp post process flags the source was imported with
+        std::vector<CookedSubMesh> meshes;
+        std::vector<CookedMeshNode> nodes;
+        std::vector<Bone> bones;            ///< only filled for animated meshes, like the Assimp path
+        std::vector<AnimationClip> animations;
+    };
+
+    /**
+     * @brief "models/cube.fbx" -> "models/cube.fbx.pmdl"
+     */
+    PULSE_ENGINE_DLL_API std::string GetCookedMeshPath(const std::string& sourcePath);
+
+    /**
+     * @brief Editor copy of an imported source : IMPORTED_MESH_DIRECTORY + normalized asset path + ".pmdl".
+     */
+    PULSE_ENGINE_DLL_API std::string GetImportedMeshPath(const std::string& assetPath);
+
+    /**
+     * @brief ".fbx", ".obj", ".dae", ".glb" (any case). Formats with external geometry files (.gltf + .bin) are copied.
+     */
+    PULSE_ENGINE_DLL_API bool IsCookableMesh(const std::string& extension);
+
+    /**
+     * @brief Assimp post process flags of an asset : the engine primitives keep their own set (flipped UVs).
+     */
+    PULSE_ENGINE_DLL_API unsigned int GetMeshImportFlags(const std::string& assetPath);
+
+    /**
+     * @brief Import a source with Assimp, from the disk or from memory (extensionHint : "fbx", "obj"...).
+     */
+    PULSE_ENGINE_DLL_API bool ImportMesh(const std::string& sourcePath, unsigned int importFlags, CookedMesh& out, std::string& error);
+    PULSE_ENGINE_DLL_API bool ImportMeshFromMemory(const std::vector<char>& bytes, const std::string& extensionHint, unsigned int importFlags,
+                                                   CookedMesh& out, std::string& error);
+
+    PULSE_ENGINE_DLL_API bool ReadCookedMesh(const char* data, std::size_t size, CookedMesh& out);
+    PULSE_ENGINE_DLL_API bool ReadCookedMesh(const std::vector<char>& bytes, CookedMesh& out);
+    PULSE_ENGINE_DLL_API bool ReadCookedMeshFile(const std::string& path, CookedMesh& out);
+    PULSE_ENGINE_DLL_API bool WriteCookedMesh(const std::string& path, const CookedMesh& mesh);
+
+    /**
+     * @brief Import a source and write its .pmdl.
+     */
+    PULSE_ENGINE_DLL_API bool CookMesh(const std::string& sourcePath, const std::string& destinationPath, unsigned int importFlags, std::string& error);
+
+    /**
+     * @brief Runtime read of a mesh asset (path relative to ASSET_PATH, the source path).
+     * @details Game : the .pmdl from the pack or the disk, the source is imported only when it was not cooked.
+     * Editor : the imported copy while it is newer than the source, otherwise the source is imported and the copy rewritten.
+     */
+    PULSE_ENGINE_DLL_API bool LoadMeshAsset(const std::string& assetPath, CookedMesh& out);
+}
+
+#endif // COOKEDMESH_H
@@ -0,0 +1,832 @@
+#include "MeshOptimizer.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <numeric>
+#include <unordered_map>
+
+using namespace PulseEngine::Cooking;
+
+namespace
+{
+    constexpr unsigned int INVALID_INDEX = ~0u;
+
+    // ========================================================================
+    //  Vertex cache (Forsyth, "Linear-speed vertex cache optimisation")
+    // ========================================================================
+
+    constexpr int SCORE_CACHE_SIZE = 32;
+    constexpr int MAX_VALENCE_SCORE = 32;
+    constexpr float LAST_TRIANGLE_SCORE = 0.75f;
+    constexpr float CACHE_DECAY_POWER = 1.5f;
+    constexpr float VALENCE_BOOST_SCALE = 2.0f;
+    constexpr float VALENCE_BOOST_POWER = 0.5f;
+
+    struct VertexScoreTable
+    {
+        float cache[SCORE_CACHE_SIZE];
+        float valence[MAX_VALENCE_SCORE];
+
+        VertexScoreTable()
+        {
+            for (int i = 0; i < SCORE_CACHE_SIZE; ++i)
+            {
+                if (i < 3)
+                    cache[i] = LAST_TRIANGLE_SCORE;
+                else
+                    cache[i] = std::pow(1.0f - (float)(i - 3) / (float)(SCORE_CACHE_SIZE - 3), CACHE_DECAY_POWER);
+            }
+            valence[0] = 0.0f;
+            for (int i = 1; i < MAX_VALENCE_SCORE; ++i)
+                valence[i] = VALENCE_BOOST_SCALE * std::pow((float)i, -VALENCE_BOOST_POWER);
+        }
+
+        float Score(int cachePosition, unsigned int remaining) const
+        {
+            if (remaining == 0) return -1.0f;
+            float score = cachePosition >= 0 ? cache[cachePosition] : 0.0f;
+            score += remaining < (unsigned int)MAX_VALENCE_SCORE ? valence[remaining] : VALENCE_BOOST_SCALE * std::pow((float)remaining, -VALENCE_BOOST_POWER);
+            return score;
+        }
+    };
+
+    /**
+     * @brief Triangles using each vertex, packed (offsets[v] .. offsets[v] + counts[v]).
+     */
+    struct TriangleAdjacency
+    {
+        std::vector<unsigned int> counts;
+        std::vector<unsigned int> offsets;
+        std::vector<unsigned int> triangles;
+
+        void Build(const unsigned int* indices, std::size_t indexCount, std::size_t vertexCount)
+        {
+            counts.assign(vertexCount, 0);
+            offsets.assign(vertexCount, 0);
+            triangles.resize(indexCount);
+
+            for (std::size_t i = 0; i < indexCount; ++i) counts[indices[i]]++;
+
+            unsigned int offset = 0;
+            for (std::size_t v = 0; v < vertexCount; ++v)
+            {
+                offsets[v] = offset;
+                offset += counts[v];
+            }
+
+            std::vector<unsigned int> fill = offsets;
+            for (std::size_t i = 0; i < indexCount; ++i)
+                triangles[fill[indices[i]]++] = (unsigned int)(i / 3);
+        }
+    };
+
+    /**
+     * @brief FIFO cache simulation shared by AnalyzeVertexCache and the overdraw clustering.
+     */
+    struct FifoCache
+    {
+        std::vector<unsigned int> timestamps;
+        unsigned int time;
+        unsigned int size;
+
+        FifoCache(std::size_t vertexCount, unsigned int cacheSize) : timestamps(vertexCount, 0), time(cacheSize + 1), size(cacheSize) {}
+
+        unsigned int Touch(unsigned int vertex)
+        {
+            if (time - timestamps[vertex] > size)
+            {
+                timestamps[vertex] = time++;
+                return 1;
+            }
+            return 0;
+        }
+
+        void Reset() { time += size + 1; }
+    };
+
+    // ========================================================================
+    //  Simplification
+    // ========================================================================
+
+    /**
+     * @brief Sum of squared distances to planes, Q(p) = p.A.p + 2 b.p + c.
+     */
+    struct Quadric
+    {
+        double a00 = 0, a11 = 0, a22 = 0, a01 = 0, a02 = 0, a12 = 0;
+        double b0 = 0, b1 = 0, b2 = 0;
+        double c = 0;
+        double weight = 0;  ///< area of the faces, border constraints excluded
+
+        void AddPlane(double nx, double ny, double nz, double d, double w)
+        {
+            a00 += w * nx * nx; a11 += w * ny * ny; a22 += w * nz * nz;
+            a01 += w * nx * ny; a02 += w * nx * nz; a12 += w * ny * nz;
+            b0 += w * nx * d; b1 += w * ny * d; b2 += w * nz * d;
+            c += w * d * d;
+        }
+
+        void Add(const Quadric& other)
+        {
+            a00 += other.a00; a11 += other.a11; a22 += other.a22;
+            a01 += other.a01; a02 += other.a02; a12 += other.a12;
+            b0 += other.b0; b1 += other.b1; b2 += other.b2;
+            c += other.c;
+            weight += other.weight;
+        }
+
+        double Evaluate(double x, double y, double z) const
+        {
+            const double rx = a00 * x + a01 * y + a02 * z;
+            const double ry = a01 * x + a11 * y + a12 * z;
+            const double rz = a02 * x + a12 * y + a22 * z;
+            const double value = rx * x + ry * y + rz * z + 2.0 * (b0 * x + b1 * y + b2 * z) + c;
+            return value > 0.0 ? value : 0.0;
+        }
+    };
+
+    constexpr double BORDER_WEIGHT = 10.0;
+
+    struct Vec3d
+    {
+        double x, y, z;
+    };
+
+    Vec3d Sub(const Vec3d& a, const Vec3d& b) { return { a.x - b.x, a.y - b.y, a.z - b.z }; }
+    Vec3d Cross(const Vec3d& a, const Vec3d& b) { return { a.y * b.z - a.z * b.y, a.z * b.x - a.x * b.z, a.x * b.y - a.y * b.x }; }
+    double Dot(const Vec3d& a, const Vec3d& b) { return a.x * b.x + a.y * b.y + a.z * b.z; }
+    double Length(const Vec3d& a) { return std::sqrt(Dot(a, a)); }
+
+    uint64_t EdgeKey(unsigned int a, unsigned int b)
+    {
+        return a < b ? ((uint64_t)a << 32) | b : ((uint64_t)b << 32) | a;
+    }
+
+    struct Collapse
+    {
+        unsigned int from;
+        unsigned int to;
+        double cost;
+    };
+
+    /**
+     * @brief Simplification state. Topology works on positions : vertices sharing a position ("wedges", split by a UV or
+     * normal seam) are one corner, the index buffer keeps the original vertices.
+     */
+    class Simplifier
+    {
+    public:
+        Simplifier(const std::vector<Vertex>& vertices, const unsigned int* indices, std::size_t indexCount)
+            : result(indices, indices + indexCount)
+        {
+            const std::size_t vertexCount = vertices.size();
+            corner.resize(vertexCount);
+            positions.resize(vertexCount);
+
+            // one corner per distinct position
+            std::unordered_map<uint64_t, std::vector<unsigned int>> byHash;
+            for (unsigned int v = 0; v < vertexCount; ++v)
+            {
+                const PulseEngine::Vector3& p = vertices[v].Position;
+                positions[v] = { p.x, p.y, p.z };
+
+                uint32_t bits[3];
+                std::memcpy(bits, &p.x, sizeof(float));
+                std::memcpy(bits + 1, &p.y, sizeof(float));
+                std::memcpy(bits + 2, &p.z, sizeof(float));
+                const uint64_t hash = ((uint64_t)bits[0] * 73856093ull) ^ ((uint64_t)bits[1] * 19349663ull) ^ ((uint64_t)bits[2] * 83492791ull);
+
+                std::vector<unsigned int>& bucket = byHash[hash];
+                corner[v] = v;
+                for (unsigned int other : bucket)
+                {
+                    const PulseEngine::Vector3& q = vertices[other].Position;
+                    if (q.x == p.x && q.y == p.y && q.z == p.z)
+                    {
+                        corner[v] = corner[other];
+                        break;
+                    }
+                }
+                if (corner[v] == v) bucket.push_back(v);
+            }
+
+            BuildQuadrics();
+        }
+
+        float Run(std::size_t targetIndexCount, float targetError)
+        {
+            const double maxCost = (double)targetError * (double)targetError;
+            double worst = 0.0;
+
+            while (result.size() > targetIndexCount)
+            {
+                BuildAdjacency();
+
+                std::vector<Collapse> candidates;
+                GatherCollapses(candidates);
+                std::sort(candidates.begin(), candidates.end(), [](const Collapse& a, const Collapse& b) { return a.cost < b.cost; });
+
+                std::vector<char> touched(corner.size(), 0);
+                std::size_t triangles = result.size() / 3;
+                std::size_t collapsed = 0;
+
+                for (const Collapse& collapse : candidates)
+                {
+                    if (collapse.cost > maxCost || triangles * 3 <= targetIndexCount) break;
+                    if (touched[collapse.from] || touched[collapse.to]) continue;
+
+                    std::size_t removed = 0;
+                    if (!Apply(collapse, touched, removed)) continue;
+
+                    triangles -= removed;
+                    worst = std::max(worst, collapse.cost);
+                    ++collapsed;
+                }
+
+                RemoveDegenerates();
+                if (collapsed == 0) break;
+            }
+
+            return (float)std::sqrt(worst);
+        }
+
+        std::vector<unsigned int> result;
+
+    private:
+        void BuildQuadrics()
+        {
+            quadrics.assign(corner.size(), Quadric());
+            border.assign(corner.size(), 0);
+
+            std::unordered_map<uint64_t, unsigned int> edgeUse;
+            edgeUse.reserve(result.size());
+            for (std::size_t i = 0; i < result.size(); i += 3)
+            {
+                for (int e = 0; e < 3; ++e)
+                {
+                    const unsigned int a = corner[result[i + e]];
+                    const unsigned int b = corner[result[i + (e + 1) % 3]];
+                    if (a != b) edgeUse[EdgeKey(a, b)]++;
+                }
+            }
+
+            for (std::size_t i = 0; i < result.size(); i += 3)
+            {
+                const unsigned int c[3] = { corner[result[i]], corner[result[i + 1]], corner[result[i + 2]] };
+                const Vec3d normal = Cross(Sub(positions[c[1]], positions[c[0]]), Sub(positions[c[2]], positions[c[0]]));
+                const double length = Length(normal);
+                if (length <= 0.0) continue;
+
+                const Vec3d n = { normal.x / length, normal.y / length, normal.z / length };
+                const double area = length * 0.5;
+                const double d = -Dot(n, positions[c[0]]);
+                for (unsigned int k : c)
+                {
+                    quadrics[k].AddPlane(n.x, n.y, n.z, d, area);
+                    quadrics[k].weight += area;
+                }
+
+                // open borders : a plane through the edge, perpendicular to the face, keeps the outline in place
+                for (int e = 0; e < 3; ++e)
+                {
+                    const unsigned int a = c[e];
+                    const unsigned int b = c[(e + 1) % 3];
+                    if (a == b) continue;
+
+                    const unsigned int use = edgeUse[EdgeKey(a, b)];
+                    if (use == 1)
+                    {
+                        const Vec3d edge = Sub(positions[b], positions[a]);
+                        const Vec3d side = Cross(edge, n);
+                        const double sideLength = Length(side);
+                        if (sideLength <= 0.0) continue;
+
+                        const Vec3d s = { side.x / sideLength, side.y / sideLength, side.z / sideLength };
+                        const double w = Dot(edge, edge) * BORDER_WEIGHT;
+                        const double sd = -Dot(s, positions[a]);
+                        quadrics[a].AddPlane(s.x, s.y, s.z, sd, w);
+                        quadrics[b].AddPlane(s.x, s.y, s.z, sd, w);
+                        border[a] = border[a] == 2 ? 2 : 1;
+                        border[b] = border[b] == 2 ? 2 : 1;
+                    }
+                    else if (use > 2)
+                    {
+                        // non manifold edge : never moved
+                        border[a] = 2;
+                        border[b] = 2;
+                    }
+                }
+            }
+        }
+
+        void BuildAdjacency()
+        {
+            std::vector<unsigned int> corners(result.size());
+            for (std::size_t i = 0; i < result.size(); ++i) corners[i] = corner[result[i]];
+            adjacency.Build(corners.data(), corners.size(), corner.size());
+        }
+
+        void GatherCollapses(std::vector<Collapse>& out) const
+        {
+            out.reserve(result.size());
+            for (std::size_t i = 0; i < result.size(); i += 3)
+            {
+                for (int e = 0; e < 3; ++e)
+                {
+                    const unsigned int a = corner[result[i + e]];
+                    const unsigned int b = corner[result[i + (e + 1) % 3]];
+                    if (a == b) continue;
+
+                    // both directions, the cheapest allowed one is kept
+                    Collapse best{ INVALID_INDEX, INVALID_INDEX, std::numeric_limits<double>::max() };
+                    for (int direction = 0; direction < 2; ++direction)
+                    {
+                        const unsigned int from = direction == 0 ? a : b;
+                        const unsigned int to = direction == 0 ? b : a;
+                        if (border[from] == 2) continue;
+
+                        const double cost = GetCost(from, to);
+                        if (cost < best.cost) best = { from, to, cost };
+                    }
+                    if (best.from != INVALID_INDEX) out.push_back(best);
+                }
+            }
+        }
+
+        double GetCost(unsigned int from, unsigned int to) const
+        {
+            Quadric merged = quadrics[from];
+            merged.Add(quadrics[to]);
+            const Vec3d& p = positions[to];
+            return merged.weight > 0.0 ? merged.Evaluate(p.x, p.y, p.z) / merged.weight : 0.0;
+        }
+
+        bool IsBorderEdge(unsigned int a, unsigned int b) const
+        {
+            unsigned int shared = 0;
+            for (unsigned int k = 0; k < adjacency.counts[a]; ++k)
+            {
+                const std::size_t t = adjacency.triangles[adjacency.offsets[a] + k] * 3;
+                if (corner[result[t]] == b || corner[result[t + 1]] == b || corner[result[t + 2]] == b) ++shared;
+            }
+            return shared == 1;
+        }
+
+        /**
+         * @brief Validate and do the collapse of the corner from onto the corner to.
+         */
+        bool Apply(const Collapse& collapse, std::vector<char>& touched, std::size_t& removed)
+        {
+            const unsigned int from = collapse.from;
+            const unsigned int to = collapse.to;
+
+            // a border corner only slides along its border
+            if (border[from] == 1 && !IsBorderEdge(from, to)) return false;
+
+            const unsigned int begin = adjacency.offsets[from];
+            const unsigned int count = adjacency.counts[from];
+
+            // wedge pairing : each wedge of "from" follows the wedge of "to" it shares a triangle with, a seam
+            // corner can only collapse along the seam (otherwise one of its wedges has no partner)
+            pairing.clear();
+            for (unsigned int k = 0; k < count; ++k)
+            {
+                const std::size_t t = adjacency.triangles[begin + k] * 3;
+                unsigned int fromWedge = INVALID_INDEX;
+                unsigned int toWedge = INVALID_INDEX;
+                for (int e = 0; e < 3; ++e)
+                {
+                    if (corner[result[t + e]] == from) fromWedge = result[t + e];
+                    if (corner[result[t + e]] == to) toWedge = result[t + e];
+                }
+                if (fromWedge == INVALID_INDEX || toWedge == INVALID_INDEX) continue;
+
+                auto it = std::find_if(pairing.begin(), pairing.end(), [fromWedge](const std::pair<unsigned int, unsigned int>& p) { return p.first == fromWedge; });
+                if (it == pairing.end())
+                    pairing.push_back({ fromWedge, toWedge });
+                else if (it->second != toWedge)
+                    return false;
+            }
+            if (pairing.empty()) return false;
+
+            // every wedge still used around "from" needs a partner, and no triangle may flip
+            const Vec3d& target = positions[to];
+            for (unsigned int k = 0; k < count; ++k)
+            {
+                const std::size_t t = adjacency.triangles[begin + k] * 3;
+                bool hasTo = false;
+                for (int e = 0; e < 3; ++e)
+                {
+                    const unsigned int v = result[t + e];
+                    if (corner[v] == to) hasTo = true;
+                    if (corner[v] == from && std::none_of(pairing.begin(), pairing.end(), [v](const std::pair<unsigned int, unsigned int>& p) { return p.first == v; }))
+                        return false;
+                }
+                if (hasTo) continue;
+
+                Vec3d before[3], after[3];
+                for (int e = 0; e < 3; ++e)
+                {
+                    before[e] = positions[corner[result[t + e]]];
+                    after[e] = corner[result[t + e]] == from ? target : before[e];
+                }
+                const Vec3d n0 = Cross(Sub(before[1], before[0]), Sub(before[2], before[0]));
+                const Vec3d n1 = Cross(Sub(after[1], after[0]), Sub(after[2], after[0]));
+                if (Dot(n0, n1) <= 0.25 * Length(n0) * Length(n1)) return false;
+            }
+
+            // apply : the triangles around "from" now use the paired wedges
+            for (unsigned int k = 0; k < count; ++k)
+            {
+                const std::size_t t = adjacency.triangles[begin + k] * 3;
+                bool degenerate = false;
+                for (int e = 0; e < 3; ++e)
+                {
+                    const unsigned int v = result[t + e];
+                    if (corner[v] == to) degenerate = true;
+                    if (corner[v] != from) continue;
+                    for (const auto& pair : pairing)
+                    {
+                        if (pair.first == v) { result[t + e] = pair.second; break; }
+                    }
+                }
+                if (degenerate) ++removed;
+
+                // the one ring of "from" changed : no other collapse touches it during this pass
+                for (int e = 0; e < 3; ++e) touched[corner[result[t + e]]] = 1;
+            }
+
+            quadrics[to].Add(quadrics[from]);
+            if (border[from] == 1 && border[to] == 0) border[to] = 1;
+            touched[from] = 1;
+            touched[to] = 1;
+            return true;
+        }
+
+        void RemoveDegenerates()
+        {
+            std::size_t write = 0;
+            for (std::size_t i = 0; i < result.size(); i += 3)
+            {
+                const unsigned int a = corner[result[i]];
+                const unsigned int b = corner[result[i + 1]];
+                const unsigned int c = corner[result[i + 2]];
+                if (a == b || b == c || a == c) continue;
+
+                result[write] = result[i];
+                result[write + 1] = result[i + 1];
+                result[write + 2] = result[i + 2];
+                write += 3;
+            }
+            result.resize(write);
+        }
+
+        std::vector<unsigned int> corner;       ///< vertex -> first vertex with the same position
+        std::vector<Vec3d> positions;
+        std::vector<Quadric> quadrics;          ///< per corner
+        std::vector<uint8_t> border;            ///< per corner : 0 free, 1 on an open border, 2 locked
+        TriangleAdjacency adjacency;            ///< per corner, rebuilt every pass
+        std::vector<std::pair<unsigned int, unsigned int>> pairing;
+    };
+
+    float GetBoundingRadius(const std::vector<Vertex>& vertices)
+    {
+        if (vertices.empty()) return 0.0f;
+
+        PulseEngine::Vector3 minimum = vertices[0].Position;
+        PulseEngine::Vector3 maximum = vertices[0].Position;
+        for (const Vertex& vertex : vertices)
+        {
+            minimum.x = std::min(minimum.x, vertex.Position.x); maximum.x = std::max(maximum.x, vertex.Position.x);
+            minimum.y = std::min(minimum.y, vertex.Position.y); maximum.y = std::max(maximum.y, vertex.Position.y);
+            minimum.z = std::min(minimum.z, vertex.Position.z); maximum.z = std::max(maximum.z, vertex.Position.z);
+        }
+        const float dx = maximum.x - minimum.x;
+        const float dy = maximum.y - minimum.y;
+        const float dz = maximum.z - minimum.z;
+        return 0.5f * std::sqrt(dx * dx + dy * dy + dz * dz);
+    }
+}
+
+VertexCacheStats PulseEngine::Cooking::AnalyzeVertexCache(const unsigned int* indices, std::size_t indexCount, std::size_t vertexCount, unsigned int cacheSize)
+{
+    VertexCacheStats stats;
+    if (indexCount < 3 || vertexCount == 0) return stats;
+
+    FifoCache cache(vertexCount, cacheSize);
+    std::vector<char> used(vertexCount, 0);
+    std::size_t misses = 0;
+    std::size_t usedCount = 0;
+    for (std::size_t i = 0; i < indexCount; ++i)
+    {
+        misses += cache.Touch(indices[i]);
+        if (!used[indices[i]]) { used[indices[i]] = 1; ++usedCount; }
+    }
+
+    stats.acmr = (float)misses / (float)(indexCount / 3);
+    stats.atvr = usedCount > 0 ? (float)misses / (float)usedCount : 0.0f;
+    return stats;
+}
+
+void PulseEngine::Cooking::OptimizeVertexCache(unsigned int* indices, std::size_t indexCount, std::size_t vertexCount)
+{
+    const std::size_t triangleCount = indexCount / 3;
+    if (triangleCount < 2 || vertexCount == 0) return;
+
+    static const VertexScoreTable table;
+
+    TriangleAdjacency adjacency;
+    adjacency.Build(indices, triangleCount * 3, vertexCount);
+
+    std::vector<int> cachePosition(vertexCount, -1);
+    std::vector<float> vertexScore(vertexCount);
+    for (std::size_t v = 0; v < vertexCount; ++v) vertexScore[v] = table.Score(-1, adjacency.counts[v]);
+
+    std::vector<float> triangleScore(triangleCount);
+    std::vector<char> emitted(triangleCount, 0);
+    for (std::size_t t = 0; t < triangleCount; ++t)
+        triangleScore[t] = vertexScore[indices[t * 3]] + vertexScore[indices[t * 3 + 1]] + vertexScore[indices[t * 3 + 2]];
+
+    std::vector<unsigned int> output(triangleCount * 3);
+    std::vector<unsigned int> cache;
+    std::vector<unsigned int> nextCache;
+    cache.reserve(SCORE_CACHE_SIZE + 3);
+    nextCache.reserve(SCORE_CACHE_SIZE + 3);
+
+    std::size_t best = (std::size_t)(std::max_element(triangleScore.begin(), triangleScore.end()) - triangleScore.begin());
+    std::size_t cursor = 0;
+
+    for (std::size_t written = 0; written < triangleCount; ++written)
+    {
+        // dead end : nothing in the cache has triangles left, continue with the input order
+        if (best == INVALID_INDEX)
+        {
+            while (emitted[cursor]) ++cursor;
+            best = cursor;
+        }
+
+        const unsigned int* triangle = indices + best * 3;
+        output[written * 3] = triangle[0];
+        output[written * 3 + 1] = triangle[1];
+        output[written * 3 + 2] = triangle[2];
+        emitted[best] = 1;
+
+        // the triangle leaves the adjacency of its vertices
+        for (int k = 0; k < 3; ++k)
+        {
+            const unsigned int v = triangle[k];
+            unsigned int* list = adjacency.triangles.data() + adjacency.offsets[v];
+            unsigned int& count = adjacency.counts[v];
+            for (unsigned int i = 0; i < count; ++i)
+            {
+                if (list[i] == best)
+                {
+                    list[i] = list[count - 1];
+                    --count;
+                    break;
+                }
+            }
+        }
+
+        // its vertices go to the front of the cache (LRU)
+        nextCache.clear();
+        for (int k = 0; k < 3; ++k)
+        {
+            if (std::find(nextCache.begin(), nextCache.end(), triangle[k]) == nextCache.end()) nextCache.push_back(triangle[k]);
+        }
+        for (unsigned int v : cache)
+        {
+            if (std::find(nextCache.begin(), nextCache.end(), v) == nextCache.end()) nextCache.push_back(v);
+        }
+
+        for (std::size_t i = 0; i < nextCache.size(); ++i)
+        {
+            const unsigned int v = nextCache[i];
+            cachePosition[v] = i < (std::size_t)SCORE_CACHE_SIZE ? (int)i : -1;
+            vertexScore[v] = table.Score(cachePosition[v], adjacency.counts[v]);
+        }
+
+        // only the triangles of the cached vertices changed score
+        best = INVALID_INDEX;
+        float bestScore = -1.0f;
+        for (unsigned int v : nextCache)
+        {
+            const unsigned int* list = adjacency.triangles.data() + adjacency.offsets[v];
+            for (unsigned int i = 0; i < adjacency.counts[v]; ++i)
+            {
+                const unsigned int t = list[i];
+                const float score = vertexScore[indices[t * 3]] + vertexScore[indices[t * 3 + 1]] + vertexScore[indices[t * 3 + 2]];
+                triangleScore[t] = score;
+                if (score > bestScore)
+                {
+                    bestScore = score;
+                    best = t;
+                }
+            }
+        }
+
+        if (nextCache.size() > (std::size_t)SCORE_CACHE_SIZE) nextCache.resize(SCORE_CACHE_SIZE);
+        cache.swap(nextCache);
+    }
+
+    std::copy(output.begin(), output.end(), indices);
+}
+
+void PulseEngine::Cooking::OptimizeOverdraw(unsigned int* indices, std::size_t indexCount, const std::vector<Vertex>& vertices, float threshold)
+{
+    constexpr unsigned int CACHE_SIZE = 16;
+    const std::size_t triangleCount = indexCount / 3;
+    if (triangleCount < 2 || vertices.empty()) return;
+
+    // hard boundaries : the cache order restarts where a triangle misses its 3 vertices
+    std::vector<std::size_t> hard;
+    {
+        FifoCache cache(vertices.size(), CACHE_SIZE);
+        for (std::size_t t = 0; t < triangleCount; ++t)
+        {
+            const unsigned int misses = cache.Touch(indices[t * 3]) + cache.Touch(indices[t * 3 + 1]) + cache.Touch(indices[t * 3 + 2]);
+            if (misses == 3 || t == 0) hard.push_back(t);
+        }
+        hard.push_back(triangleCount);
+    }
+
+    // soft boundaries : a hard cluster is cut as soon as its running miss ratio is close enough to its own ratio
+    std::vector<std::size_t> clusters;
+    {
+        FifoCache cache(vertices.size(), CACHE_SIZE);
+        for (std::size_t h = 0; h + 1 < hard.size(); ++h)
+        {
+            const std::size_t start = hard[h];
+            const std::size_t end = hard[h + 1];
+
+            cache.Reset();
+            std::size_t clusterMisses = 0;
+            for (std::size_t t = start; t < end; ++t)
+                clusterMisses += cache.Touch(indices[t * 3]) + cache.Touch(indices[t * 3 + 1]) + cache.Touch(indices[t * 3 + 2]);
+            const float clusterAcmr = (float)clusterMisses / (float)(end - start);
+
+            cache.Reset();
+            std::size_t clusterStart = start;
+            std::size_t misses = 0;
+            clusters.push_back(start);
+            for (std::size_t t = start; t < end; ++t)
+            {
+                misses += cache.Touch(indices[t * 3]) + cache.Touch(indices[t * 3 + 1]) + cache.Touch(indices[t * 3 + 2]);
+                const float acmr = (float)misses / (float)(t - clusterStart + 1);
+                if (t + 1 < end && acmr <= clusterAcmr * threshold)
+                {
+                    clusterStart = t + 1;
+                    clusters.push_back(clusterStart);
+                    misses = 0;
+                    cache.Reset();
+                }
+            }
+        }
+        clusters.push_back(triangleCount);
+    }
+
+    // sort key : clusters facing away from the mesh center are drawn first, they hide the others
+    const std::size_t clusterCount = clusters.size() - 1;
+    if (clusterCount < 2) return;
+
+    double centerX = 0.0, centerY = 0.0, centerZ = 0.0, totalArea = 0.0;
+    std::vector<double> clusterX(clusterCount), clusterY(clusterCount), clusterZ(clusterCount), clusterArea(clusterCount);
+    std::vector<Vec3d> clusterNormal(clusterCount);
+    for (std::size_t c = 0; c < clusterCount; ++c)
+    {
+        Vec3d normal = { 0.0, 0.0, 0.0 };
+        double cx = 0.0, cy = 0.0, cz = 0.0, area = 0.0;
+        for (std::size_t t = clusters[c]; t < clusters[c + 1]; ++t)
+        {
+            const PulseEngine::Vector3& a = vertices[indices[t * 3]].Position;
+            const PulseEngine::Vector3& b = vertices[indices[t * 3 + 1]].Position;
+            const PulseEngine::Vector3& d = vertices[indices[t * 3 + 2]].Position;
+            const Vec3d ab = { (double)b.x - a.x, (double)b.y - a.y, (double)b.z - a.z };
+            const Vec3d ad = { (double)d.x - a.x, (double)d.y - a.y, (double)d.z - a.z };
+            const Vec3d n = Cross(ab, ad);
+            const double triangleArea = Length(n);
+
+            normal = { normal.x + n.x, normal.y + n.y, normal.z + n.z };
+            cx += (a.x + b.x + d.x) / 3.0 * triangleArea;
+            cy += (a.y + b.y + d.y) / 3.0 * triangleArea;
+            cz += (a.z + b.z + d.z) / 3.0 * triangleArea;
+            area += triangleArea;
+        }
+
+        clusterNormal[c] = normal;
+        clusterArea[c] = area;
+        clusterX[c] = area > 0.0 ? cx / area : 0.0;
+        clusterY[c] = area > 0.0 ? cy / area : 0.0;
+        clusterZ[c] = area > 0.0 ? cz / area : 0.0;
+        centerX += cx; centerY += cy; centerZ += cz;
+        totalArea += area;
+    }
+    if (totalArea <= 0.0) return;
+    centerX /= totalArea; centerY /= totalArea; centerZ /= totalArea;
+
+    std::vector<float> keys(clusterCount);
+    for (std::size_t c = 0; c < clusterCount; ++c)
+    {
+        const double length = Length(clusterNormal[c]);
+        keys[c] = length > 0.0 ? (float)(((clusterX[c] - centerX) * clusterNormal[c].x + (clusterY[c] - centerY) * clusterNormal[c].y + (clusterZ[c] - centerZ) * clusterNormal[c].z) / length) : 0.0f;
+    }
+
+    std::vector<std::size_t> order(clusterCount);
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&keys](std::size_t a, std::size_t b) { return keys[a] > keys[b]; });
+
+    std::vector<unsigned int> sorted;
+    sorted.reserve(triangleCount * 3);
+    for (std::size_t c : order)
+        sorted.insert(sorted.end(), indices + clusters[c] * 3, indices + clusters[c + 1] * 3);
+    std::copy(sorted.begin(), sorted.end(), indices);
+}
+
+void PulseEngine::Cooking::OptimizeVertexFetch(std::vector<Vertex>& vertices, std::vector<unsigned int>& indices,
+                                               std::vector<SkinWeights>* skin)
+{
+    std::vector<unsigned int> remap(vertices.size(), INVALID_INDEX);
+    unsigned int next = 0;
+    for (unsigned int& index : indices)
+    {
+        if (remap[index] == INVALID_INDEX) remap[index] = next++;
+        index = remap[index];
+    }
+
+    std::vector<Vertex> ordered(next);
+    for (std::size_t v = 0; v < vertices.size(); ++v)
+    {
+        if (remap[v] != INVALID_INDEX) ordered[remap[v]] = vertices[v];
+    }
+    vertices.swap(ordered);
+
+    if (!skin || skin->size() != remap.size()) return;
+    std::vector<SkinWeights> orderedSkin(next);
+    for (std::size_t v = 0; v < remap.size(); ++v)
+    {
+        if (remap[v] != INVALID_INDEX) orderedSkin[remap[v]] = (*skin)[v];
+    }
+    skin->swap(orderedSkin);
+}
+
+float PulseEngine::Cooking::SimplifyMesh(const std::vector<Vertex>& vertices, const unsigned int* indices, std::size_t indexCount,
+                                         std::size_t targetIndexCount, float targetError, std::vector<unsigned int>& outIndices)
+{
+    Simplifier simplifier(vertices, indices, indexCount - indexCount % 3);
+    const float error = simplifier.Run(targetIndexCount, targetError);
+    outIndices.swap(simplifier.result);
+    return error;
+}
+
+void PulseEngine::Cooking::ProcessMesh(std::vector<Vertex>& vertices, std::vector<unsigned int>& indices, std::vector<MeshLod>& outLods, const MeshLodSettings& settings,
+                                       std::vector<SkinWeights>* skin)
+{
+    outLods.clear();
+    indices.resize(indices.size() - indices.size() % 3);
+    if (vertices.empty() || indices.empty()) return;
+
+    OptimizeVertexCache(indices.data(), indices.size(), vertices.size());
+    OptimizeOverdraw(indices.data(), indices.size(), vertices, settings.overdrawThreshold);
+
+    std::vector<std::vector<unsigned int>> levels;
+    std::vector<float> errors;
+    levels.push_back(indices);
+    errors.push_back(0.0f);
+
+    if (indices.size() / 3 >= settings.minTriangles)
+    {
+        const float maxError = settings.maxError * GetBoundingRadius(vertices);
+        for (std::size_t level = 1; level < settings.maxLods; ++level)
+        {
+            const std::size_t previous = levels.back().size();
+            const std::size_t target = (std::size_t)((float)(previous / 3) * settings.reduction) * 3;
+
+            // always from LOD 0 : the error is measured against the original surface
+            std::vector<unsigned int> lod;
+            const float error = SimplifyMesh(vertices, indices.data(), indices.size(), target, maxError, lod);
+
+            // not worth a level when the error limit stopped it early
+            if (lod.empty() || lod.size() * 100 > previous * 85) break;
+
+            OptimizeVertexCache(lod.data(), lod.size(), vertices.size());
+            levels.push_back(std::move(lod));
+            errors.push_back(std::max(error, errors.back()));
+        }
+    }
+
+    indices.clear();
+    for (std::size_t level = 0; level < levels.size(); ++level)
+    {
+        MeshLod lod;
+        lod.indexOffset = (unsigned int)indices.size();
+        lod.indexCount = (unsigned int)levels[level].size();
+        lod.error = errors[level];
+        outLods.push_back(lod);
+        indices.insert(indices.end(), levels[level].begin(), levels[level].end());
+    }
+
+    OptimizeVertexFetch(vertices, indices, skin);
+}
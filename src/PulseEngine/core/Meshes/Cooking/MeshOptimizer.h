@@ -0,0 +1,84 @@
+/**
+ * @file MeshOptimizer.h
+ * @brief Cook-time mesh processing : triangle and vertex order for the GPU, and the LOD chain.
+ * @details Runs on the CPU buffers of a sub mesh, before it is written in the .pmdl :
+ * - vertex cache : triangles reordered so the vertices they share are still in the post-transform cache (Forsyth).
+ * - overdraw : the cache ordered list is cut into clusters, the clusters facing out of the mesh are drawn first
+ *   (Sander et al., "Fast triangle reordering for vertex locality and reduced overdraw").
+ * - vertex fetch : vertices stored in the order the index buffer first uses them.
+ * - LODs : quadric error edge collapse (Garland-Heckbert) onto existing vertices. Only the index buffer changes, every
+ *   LOD shares the vertex buffer of LOD 0. UV/normal seams and open borders only collapse along themselves.
+ * @version 0.1
+ * @date 2025-12-14
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+#ifndef MESHOPTIMIZER_H
+#define MESHOPTIMIZER_H
+
+#include "Common/dllExport.h"
+#include "PulseEngine/core/Meshes/Mesh.h"
+#include "PulseEngine/core/Meshes/Vertex.h"
+
+#include <cstddef>
+#include <vector>
+
+namespace PulseEngine::Cooking
+{
+    struct MeshLodSettings
+    {
+        std::size_t maxLods = 4;            ///< LOD 0 included
+        float reduction = 0.5f;             ///< triangles kept from one LOD to the next
+        float maxError = 0.05f;             ///< simplification error allowed, relative to the bounding radius
+        std::size_t minTriangles = 64;      ///< smaller meshes keep LOD 0 only
+        float overdrawThreshold = 1.05f;    ///< cache efficiency the overdraw pass may give up (1.05 = 5% more misses)
+    };
+
+    /**
+     * @brief Post-transform cache simulation (FIFO).
+     * @details acmr : vertices transformed per triangle (0.5 at best, 3 without any reuse).
+     * atvr : vertices transformed per vertex (1 at best).
+     */
+    struct VertexCacheStats
+    {
+        float acmr = 0.0f;
+        float atvr = 0.0f;
+    };
+
+    PULSE_ENGINE_DLL_API VertexCacheStats AnalyzeVertexCache(const unsigned int* indices, std::size_t indexCount, std::size_t vertexCount, unsigned int cacheSize = 16);
+
+    /**
+     * @brief Reorder the triangles of an indexed triangle list for the post-transform cache, in place.
+     */
+    PULSE_ENGINE_DLL_API void OptimizeVertexCache(unsigned int* indices, std::size_t indexCount, std::size_t vertexCount);
+
+    /**
+     * @brief Reorder the clusters of a cache optimized list to reduce overdraw, in place.
+     * @param threshold how much the cache efficiency may degrade, clusters get smaller as it grows.
+     */
+    PULSE_ENGINE_DLL_API void OptimizeOverdraw(unsigned int* indices, std::size_t indexCount, const std::vector<Vertex>& vertices, float threshold = 1.05f);
+
+    /**
+     * @brief Store the vertices in first use order and remap the indices. Unused vertices are dropped.
+     * @param skin bone data of the vertices, reordered with them. nullptr : static mesh.
+     */
+    PULSE_ENGINE_DLL_API void OptimizeVertexFetch(std::vector<Vertex>& vertices, std::vector<unsigned int>& indices,
+                                                  std::vector<SkinWeights>* skin = nullptr);
+
+    /**
+     * @brief Collapse edges until the list has at most targetIndexCount indices or the next collapse moves the surface
+     * further than targetError (object space).
+     * @return the largest error of the collapses done, in object space.
+     */
+    PULSE_ENGINE_DLL_API float SimplifyMesh(const std::vector<Vertex>& vertices, const unsigned int* indices, std::size_t indexCount,
+                                            std::size_t targetIndexCount, float targetError, std::vector<unsigned int>& outIndices);
+
+    /**
+     * @brief Every pass above on one sub mesh : indices becomes LOD 0 followed by the other LODs, described by outLods.
+     */
+    PULSE_ENGINE_DLL_API void ProcessMesh(std::vector<Vertex>& vertices, std::vector<unsigned int>& indices, std::vector<MeshLod>& outLods,
+                                          const MeshLodSettings& settings = MeshLodSettings(), std::vector<SkinWeights>* skin = nullptr);
+}
+
+#endif // MESHOPTIMIZER_H
@@ -1,6 +1,10 @@
 #include "Mesh.h"
 #include "PulseEngine/core/Meshes/SkeletalMesh.h"
 #include "PulseEngine/core/Graphics/IGraphicsApi.h"
+#include "PulseEngine/core/Threading/GraphicsThread.h"
+
+#include <algorithm>
+#include <cmath>
 
 Mesh::Mesh(const std::vector<float>& vertices)
 {
@@ -18,7 +22,18 @@ Mesh::Mesh()
 
 Mesh::~Mesh()
 {
-    PulseEngineGraphicsAPI->DeleteMesh(&VAO, &VBO, &EBO);
+    if (PulseEngine::Threading::IsGraphicsThread())
+    {
+        PulseEngineGraphicsAPI->DeleteMesh(&VAO, &VBO, &EBO);
+    }
+    else if (VAO)
+    {
+        // deleted by the simulation thread : the buffers go with the next graphics jobs
+        PulseEngine::Threading::RunOnGraphicsThread([vao = VAO, vbo = VBO, ebo = EBO]() mutable
+        {
+            PulseEngineGraphicsAPI->DeleteMesh(&vao, &vbo, &ebo);
+        });
+    }
     // if (skeleton)
     // {
     //     delete skeleton;
@@ -36,12 +51,72 @@ void Mesh::SetupMesh()
     VAO = 0;
     VBO = 0;
     EBO = 0;
-    PulseEngineGraphicsAPI->SetupMesh(&VAO, &VBO, &EBO, vertices, indices);
+    ComputeBounds();
+
+    // built by the simulation thread (scripts) : the buffers are created by the first Draw
+    if (!PulseEngine::Threading::IsGraphicsThread()) return;
+    PulseEngineGraphicsAPI->SetupMesh(&VAO, &VBO, &EBO, vertices, skinWeights, indices);
+}
+
+void Mesh::ComputeBounds()
+{
+    boundsCenter = PulseEngine::Vector3(0.0f, 0.0f, 0.0f);
+    boundsRadius = 0.0f;
+    if (vertices.empty()) return;
+
+    PulseEngine::Vector3 minimum = vertices[0].Position;
+    PulseEngine::Vector3 maximum = vertices[0].Position;
+    for (const Vertex& vertex : vertices)
+    {
+        minimum.x = std::min(minimum.x, vertex.Position.x); maximum.x = std::max(maximum.x, vertex.Position.x);
+        minimum.y = std::min(minimum.y, vertex.Position.y); maximum.y = std::max(maximum.y, vertex.Position.y);
+        minimum.z = std::min(minimum.z, vertex.Position.z); maximum.z = std::max(maximum.z, vertex.Position.z);
+    }
+    boundsCenter = PulseEngine::Vector3((minimum.x + maximum.x) * 0.5f, (minimum.y + maximum.y) * 0.5f, (minimum.z + maximum.z) * 0.5f);
+
+    float radiusSquared = 0.0f;
+    for (const Vertex& vertex : vertices)
+    {
+        const float dx = vertex.Position.x - boundsCenter.x;
+        const float dy = vertex.Position.y - boundsCenter.y;
+        const float dz = vertex.Position.z - boundsCenter.z;
+        radiusSquared = std::max(radiusSquared, dx * dx + dy * dy + dz * dz);
+    }
+    boundsRadius = std::sqrt(radiusSquared);
+}
+
+void Mesh::Draw(Shader* shader, std::size_t lod)
+{
+    if (!VAO && !vertices.empty())
+    {
+        PulseEngineGraphicsAPI->SetupMesh(&VAO, &VBO, &EBO, vertices, skinWeights, indices);
+    }
+
+    if (lods.empty())
+    {
+        PulseEngineGraphicsAPI->RenderMesh(&VAO, &VBO, vertices, indices);
+        return;
+    }
+
+    const MeshLod& range = lods[std::min(lod, lods.size() - 1)];
+    PulseEngineGraphicsAPI->RenderMeshRange(&VAO, range.indexOffset, range.indexCount);
 }
 
-void Mesh::Draw(Shader* shader)
+void Mesh::DrawInstanced(std::size_t lod, unsigned int instanceCount)
 {
-    PulseEngineGraphicsAPI->RenderMesh(&VAO, &VBO, vertices, indices);
+    if (!VAO && !vertices.empty())
+    {
+        PulseEngineGraphicsAPI->SetupMesh(&VAO, &VBO, &EBO, vertices, skinWeights, indices);
+    }
+
+    if (lods.empty())
+    {
+        PulseEngineGraphicsAPI->RenderMeshRangeInstanced(&VAO, 0, static_cast<unsigned int>(indices.size()), instanceCount);
+        return;
+    }
+
+    const MeshLod& range = lods[std::min(lod, lods.size() - 1)];
+    PulseEngineGraphicsAPI->RenderMeshRangeInstanced(&VAO, range.indexOffset, range.indexCount, instanceCount);
 }
 
 Mesh* Mesh::LoadFromAssimp(const aiMesh* mesh, const aiScene* scene, SkeletalMesh* skel)
@@ -49,6 +124,33 @@ Mesh* Mesh::LoadFromAssimp(const aiMesh* mesh, const aiScene* scene, SkeletalMes
     Mesh* newMesh = new Mesh();
     EDITOR_LOG("chargement du mesh")
 
+    if (!ExtractFromAssimp(mesh, scene, skel, newMesh->vertices, newMesh->skinWeights, newMesh->indices))
+    {
+        delete newMesh;
+        return nullptr;
+    }
+
+    EDITOR_LOG("chargement du mesh fini, passage au setup")
+    newMesh->SetupMesh();
+    EDITOR_LOG("setup du mesh fini")
+
+    EDITOR_LOG("Nombre d'indices : " << newMesh->indices.size())
+
+    unsigned int maxIndex = 0;
+    for (unsigned int index : newMesh->indices)
+    {
+        if (index > maxIndex) maxIndex = index;
+    }
+    EDITOR_LOG("Indice max : " << maxIndex << ", Nombre de sommets : " << newMesh->vertices.size())
+    EDITOR_LOG("mesh->HasFaces() ? " << mesh->HasFaces())
+    EDITOR_LOG("mesh->mNumFaces : " << mesh->mNumFaces)
+
+    return newMesh;
+}
+
+bool Mesh::ExtractFromAssimp(const aiMesh* mesh, const aiScene* scene, SkeletalMesh* skel, std::vector<Vertex>& outVertices,
+                             std::vector<SkinWeights>& outSkin, std::vector<unsigned int>& outIndices)
+{
     if (mesh->HasBones())
     {
         EDITOR_LOG("Bones founded")
@@ -59,17 +161,21 @@ Mesh* Mesh::LoadFromAssimp(const aiMesh* mesh, const aiScene* scene, SkeletalMes
     try
     {
         // Indices
+        outIndices.clear();
+        outIndices.reserve(mesh->mNumFaces * 3);
         for (unsigned int i = 0; i < mesh->mNumFaces; ++i)
         {
             aiFace face = mesh->mFaces[i];
             for (unsigned int j = 0; j < face.mNumIndices; ++j)
             {
-                newMesh->indices.push_back(face.mIndices[j]);
+                outIndices.push_back(face.mIndices[j]);
             }
         }
         EDITOR_LOG("face done")
 
         // Sommets
+        outVertices.clear();
+        outVertices.reserve(mesh->mNumVertices);
         for (unsigned int i = 0; i < mesh->mNumVertices; ++i)
         {
             Vertex vertex = {};
@@ -127,15 +233,15 @@ Mesh* Mesh::LoadFromAssimp(const aiMesh* mesh, const aiScene* scene, SkeletalMes
                 vertex.Bitangent = PulseEngine::Vector3(0.0f);
             }
 
-
-            // Initialisation à zéro pour les bones (sera rempli plus tard si bones)
-            vertex.BoneIDs = PulseEngine::iVector4(0);
-            vertex.Weights = PulseEngine::Vector4(0.0f);
-
-            newMesh->vertices.push_back(vertex);
+            outVertices.push_back(vertex);
         }
+
+        // static meshes have no bone stream at all
+        outSkin.clear();
         if (mesh->HasBones() && skel)
         {
+            outSkin.resize(outVertices.size());
+
             std::map<std::string, int> boneMapping;
             int boneCounter = 0;
         
@@ -160,13 +266,13 @@ Mesh* Mesh::LoadFromAssimp(const aiMesh* mesh, const aiScene* scene, SkeletalMes
                     unsigned int vertexID = bone->mWeights[j].mVertexId;
                     float weight = bone->mWeights[j].mWeight;
                 
-                    if (vertexID < newMesh->vertices.size())
+                    if (vertexID < outSkin.size())
                     {
-                        AddBoneDataToVertex(newMesh->vertices[vertexID], boneID, weight);
+                        AddBoneDataToVertex(outSkin[vertexID], boneID, weight);
                     }
                 }
             }
-        for (Vertex &v : newMesh->vertices)
+        for (SkinWeights &v : outSkin)
         {
             if (v.Weights.a == 0.0f && v.Weights.x == 0.0f && v.Weights.y == 0.0f && v.Weights.z == 0.0f)
             {
@@ -181,24 +287,21 @@ Mesh* Mesh::LoadFromAssimp(const aiMesh* mesh, const aiScene* scene, SkeletalMes
     catch (const std::exception& e)
     {
         EDITOR_ERROR("Exception dans le chargement des vertices: " << e.what())
-        return nullptr;
+        return false;
     }
+    return true;
+}
 
-    EDITOR_LOG("chargement du mesh fini, passage au setup")
+Mesh* Mesh::CreateFromBuffers(std::vector<Vertex>&& vertices, std::vector<unsigned int>&& indices, std::vector<MeshLod>&& lods,
+                              std::vector<SkinWeights>&& skin)
+{
+    Mesh* newMesh = new Mesh();
+    newMesh->vertices = std::move(vertices);
+    newMesh->skinWeights = std::move(skin);
+    if (!newMesh->skinWeights.empty()) newMesh->skinWeights.resize(newMesh->vertices.size());
+    newMesh->indices = std::move(indices);
+    newMesh->lods = std::move(lods);
     newMesh->SetupMesh();
-    EDITOR_LOG("setup du mesh fini")
-
-    EDITOR_LOG("Nombre d'indices : " << newMesh->indices.size())
-
-    unsigned int maxIndex = 0;
-    for (unsigned int index : newMesh->indices)
-    {
-        if (index > maxIndex) maxIndex = index;
-    }
-    EDITOR_LOG("Indice max : " << maxIndex << ", Nombre de sommets : " << newMesh->vertices.size())
-    EDITOR_LOG("mesh->HasFaces() ? " << mesh->HasFaces())
-    EDITOR_LOG("mesh->mNumFaces : " << mesh->mNumFaces)
-
     return newMesh;
 }
 
@@ -211,7 +314,7 @@ void Mesh::UpdateMesh(float deltaTime)
     // }
 }
 
-void Mesh::AddBoneDataToVertex(Vertex &vertex, int boneID, float weight)
+void Mesh::AddBoneDataToVertex(SkinWeights &vertex, int boneID, float weight)
 {
     // Step 1: Add the bone
     int smallestWeightIndex = 0;
@@ -16,6 +16,16 @@ class Skeleton;
 class Shader;
 class SkeletalMesh;
 
+/**
+ * @brief One level of detail of a cooked mesh : a range of the shared index buffer.
+ */
+struct MeshLod
+{
+    unsigned int indexOffset = 0;
+    unsigned int indexCount = 0;
+    float error = 0.0f;     ///< largest distance to the LOD 0 surface, in object space
+};
+
 /**
  * @brief Represents a 3D mesh including geometry, bones, and rendering data.
  * This class handles OpenGL buffer setup and rendering, and can import mesh data via Assimp.
@@ -49,8 +59,14 @@ public:
     /**
      * @brief Draws the mesh using the specified shader program.
      * @param shaderProgram OpenGL shader program ID.
+     * @param lod level of detail, clamped to the last one. Meshes without LODs draw their whole index buffer.
+     */
+    void Draw(Shader* shader, std::size_t lod = 0);
+
+    /**
+     * @brief Draw instanceCount copies of one LOD in one call, the shader places them (see MaterialBatcher).
      */
-    void Draw(Shader* shader);
+    void DrawInstanced(std::size_t lod, unsigned int instanceCount);
 
     /**
      * @brief Loads mesh data from an Assimp mesh object.
@@ -60,6 +76,23 @@ public:
      */
     static Mesh* LoadFromAssimp(const aiMesh* mesh, const aiScene* scene, SkeletalMesh* skel = nullptr);
 
+    /**
+     * @brief CPU part of LoadFromAssimp : final vertices, bone data and indices, no GPU upload.
+     * @note Used by the mesh cooker, which runs without graphic context.
+     * @param outSkin one per vertex when the mesh has bones and skel is given, left empty otherwise
+     * @return false if the Assimp data couldn't be read.
+     */
+    static bool ExtractFromAssimp(const aiMesh* mesh, const aiScene* scene, SkeletalMesh* skel, std::vector<Vertex>& outVertices,
+                                  std::vector<SkinWeights>& outSkin, std::vector<unsigned int>& outIndices);
+
+    /**
+     * @brief Create a mesh from final vertex and index buffers (cooked mesh) and upload it.
+     * @param lods ranges of indices, LOD 0 first. Empty : one level, the whole buffer.
+     * @param skin one per vertex for a skinned mesh, empty for a static one
+     */
+    static Mesh* CreateFromBuffers(std::vector<Vertex>&& vertices, std::vector<unsigned int>&& indices, std::vector<MeshLod>&& lods = {},
+                                   std::vector<SkinWeights>&& skin = {});
+
     /**
      * @brief Updates the mesh state (for animation or other time-based effects).
      * @param deltaTime Time elapsed since the last update.
@@ -68,17 +101,17 @@ public:
 
     /**
      * @brief Assigns bone influence data to a vertex.
-     * @param vertex Vertex to modify.
+     * @param vertex Bone data of the vertex to modify.
      * @param boneID ID of the bone.
      * @param weight Influence weight of the bone.
      */
-    static void AddBoneDataToVertex(Vertex& vertex, int boneID, float weight);
+    static void AddBoneDataToVertex(SkinWeights& vertex, int boneID, float weight);
 
     /// Pointer to the skeleton associated with this mesh (for skeletal animation).
     Skeleton* skeleton = nullptr;
 
-    /// Assimp importer used for loading mesh files.
-    Assimp::Importer* importer;
+    /// Assimp importer used for loading mesh files, nullptr for cooked meshes.
+    Assimp::Importer* importer = nullptr;
 
     // disallow copies
     Mesh(const Mesh&) = delete;
@@ -94,6 +127,28 @@ public:
     std::size_t GetGuid() const { return guid; }
     void SetGuid(std::size_t newGuid) { guid = newGuid; }
 
+    std::size_t GetLodCount() const { return lods.empty() ? 1 : lods.size(); }
+    float GetLodError(std::size_t lod) const { return lod < lods.size() ? lods[lod].error : 0.0f; }
+    std::size_t GetLodIndexCount(std::size_t lod) const { return lod < lods.size() ? lods[lod].indexCount : indices.size(); }
+    std::size_t GetLodIndexOffset(std::size_t lod) const { return lod < lods.size() ? lods[lod].indexOffset : 0; }
+
+    /// @brief CPU copy of the buffers, kept after the upload (occlusion culling, bounds).
+    const std::vector<Vertex>& GetVertices() const { return vertices; }
+    const std::vector<unsigned int>& GetIndices() const { return indices; }
+
+    /// @brief Bytes of the vertex, bone data and index buffers.
+    std::size_t GetMemorySize() const
+    {
+        return vertices.size() * sizeof(Vertex) + skinWeights.size() * sizeof(SkinWeights) + indices.size() * sizeof(unsigned int);
+    }
+
+    bool IsSkinned() const { return !skinWeights.empty(); }
+
+    /// @brief Bounding sphere of the vertices, object space. Meaningless while HasBounds is false.
+    bool HasBounds() const { return !vertices.empty(); }
+    const PulseEngine::Vector3& GetBoundsCenter() const { return boundsCenter; }
+    float GetBoundsRadius() const { return boundsRadius; }
+
     // PulseEngine::Vector3 position = PulseEngine::Vector3(0.0f, 0.0f, 0.0f); ///< Position of the mesh in local space.
     // PulseEngine::Vector3 rotation = PulseEngine::Vector3(0.0f, 0.0f, 0.0f); ///< Rotation of the mesh in local space.
     // PulseEngine::Vector3 scale = PulseEngine::Vector3(1.0f, 1.0f, 1.0f); ///< Scale of the mesh in local space.
@@ -107,10 +162,20 @@ private:
      */
     void SetupMesh();
 
-    std::vector<Vertex> vertices;         ///< Final vertex data including bone weights.
+    /**
+     * @brief Bounding sphere (center of the box, farthest vertex) of the vertices.
+     */
+    void ComputeBounds();
+
+    std::vector<Vertex> vertices;         ///< Final vertex data.
+    std::vector<SkinWeights> skinWeights; ///< Bone data, one per vertex, empty for a static mesh.
     std::vector<PulseEngine::Vector3> normals;       ///< Normal vectors (used before conversion).
     std::vector<PulseEngine::Vector2> texCoords;     ///< Texture coordinates (used before conversion).
     std::vector<unsigned int> indices;    ///< Index data for rendering (EBO).
+    std::vector<MeshLod> lods;            ///< Ranges of indices, empty when the mesh has a single level.
+
+    PulseEngine::Vector3 boundsCenter;
+    float boundsRadius = 0.0f;
 
     std::string name;
     
@@ -1,7 +1,170 @@
 #include "RenderableMesh.h"
 #include "PulseEngine/core/Meshes/Mesh.h"
+#include "PulseEngine/core/PulseEngineBackend.h"
+#include "PulseEngine/core/Graphics/IGraphicsApi.h"
+#include "PulseEngine/core/Graphics/RenderSnapshot/RenderSnapshot.h"
+#include "PulseEngine/core/Math/Frustum/AABB.h"
+#include "PulseEngine/core/SceneManager/Occlusion/OcclusionCuller.h"
+#include "camera.h"
+
+#include <algorithm>
+#include <cmath>
+
+float RenderableMesh::lodErrorPixels = 1.0f;
+MeshDrawStats RenderableMesh::drawStats;
+float RenderableMesh::occluderLodError = 0.01f;
+
+namespace
+{
+    // Mat4 is column major : data[col][row], translation in the last column
+    PulseEngine::Vector3 TransformPoint(const PulseEngine::Mat4& world, const PulseEngine::Vector3& p)
+    {
+        return PulseEngine::Vector3(world.data[0][0] * p.x + world.data[1][0] * p.y + world.data[2][0] * p.z + world.data[3][0],
+                                    world.data[0][1] * p.x + world.data[1][1] * p.y + world.data[2][1] * p.z + world.data[3][1],
+                                    world.data[0][2] * p.x + world.data[1][2] * p.y + world.data[2][2] * p.z + world.data[3][2]);
+    }
+
+    /// @brief Largest scale of the three axes : a sphere stays inside a sphere scaled by it.
+    float MaxAxisScale(const PulseEngine::Mat4& world)
+    {
+        float scale = 0.0f;
+        for (int col = 0; col < 3; ++col)
+        {
+            const float length = std::sqrt(world.data[col][0] * world.data[col][0] + world.data[col][1] * world.data[col][1] + world.data[col][2] * world.data[col][2]);
+            scale = std::max(scale, length);
+        }
+        return scale;
+    }
+}
+
+RenderableMesh::~RenderableMesh()
+{
+    for(Mesh* msh : meshes) delete msh;
+    meshes.clear();
+}
 
 void RenderableMesh::AddMesh(Mesh *msh)
 {
     meshes.push_back(msh);
-}
\ No newline at end of file
+}
+
+std::size_t RenderableMesh::GetMemorySize() const
+{
+    std::size_t size = 0;
+    for(const Mesh* msh : meshes) size += msh->GetMemorySize();
+    return size;
+}
+
+bool RenderableMesh::ExpandWorldBounds(AABB &bounds) const
+{
+    const float scale = MaxAxisScale(matrix);
+    bool expanded = false;
+    for (const Mesh* msh : meshes)
+    {
+        if (!msh->HasBounds()) continue;
+
+        const PulseEngine::Vector3 center = TransformPoint(matrix, msh->GetBoundsCenter());
+        const PulseEngine::Vector3 radius(msh->GetBoundsRadius() * scale);
+        bounds.Expand(AABB(center - radius, center + radius));
+        expanded = true;
+    }
+    return expanded;
+}
+
+bool RenderableMesh::RasterizeOccluder(OcclusionCuller &culler) const
+{
+    static_assert(sizeof(unsigned int) == sizeof(uint32_t), "the index buffer is read as uint32_t");
+
+    bool rasterized = false;
+    for (const Mesh* msh : meshes)
+    {
+        if (!msh->HasBounds() || msh->IsSkinned() || msh->GetIndices().empty()) continue;
+
+        std::size_t lod = 0;
+        const float maxError = occluderLodError * msh->GetBoundsRadius();
+        for (std::size_t i = 1; i < msh->GetLodCount(); ++i)
+        {
+            if (msh->GetLodError(i) > maxError) break;
+            lod = i;
+        }
+
+        const std::vector<Vertex>& vertices = msh->GetVertices();
+        const uint32_t* indices = reinterpret_cast<const uint32_t*>(msh->GetIndices().data()) + msh->GetLodIndexOffset(lod);
+        culler.RasterizeTriangles(&vertices[0].Position, sizeof(Vertex), indices, msh->GetLodIndexCount(lod), matrix);
+        rasterized = true;
+    }
+    return rasterized;
+}
+
+void RenderableMesh::Draw(Shader* shader, const PulseEngine::Mat4& world, const RenderView& view) const
+{
+    DrawMeshes(shader, world, view);
+}
+
+void RenderableMesh::DrawMeshes(Shader *shader) const
+{
+    // the live camera, for the draws made outside of a render snapshot
+    RenderView view;
+    if (Camera* camera = PulseEngineInstance->GetActiveCamera()) view.position = camera->Position;
+    view.projection = PulseEngineInstance->projection;
+    view.height = PulseEngineGraphicsAPI->height ? *PulseEngineGraphicsAPI->height : 0;
+
+    DrawMeshes(shader, matrix, view);
+}
+
+void RenderableMesh::DrawMeshes(Shader *shader, const PulseEngine::Mat4& world, const RenderView& view) const
+{
+    for(Mesh* msh : meshes)
+    {
+        const std::size_t lod = SelectLod(msh, world, view);
+        msh->Draw(shader, lod);
+        CountDraw(msh, lod);
+    }
+}
+
+bool RenderableMesh::CollectDraws(const PulseEngine::Mat4 &world, const RenderView &view, std::vector<MeshDraw> &out) const
+{
+    for (const Mesh* msh : meshes)
+        if (msh->GetLodIndexCount(0) == 0) return false;
+
+    for (std::size_t i = 0; i < meshes.size(); ++i)
+    {
+        const std::size_t lod = std::min(SelectLod(meshes[i], world, view), meshes[i]->GetLodCount() - 1);
+        out.push_back({meshes[i], static_cast<std::uint32_t>(i), static_cast<std::uint32_t>(lod)});
+        CountDraw(meshes[i], lod);
+    }
+    return true;
+}
+
+void RenderableMesh::CountDraw(const Mesh *msh, std::size_t lod)
+{
+    drawStats.meshes++;
+    drawStats.triangles += msh->GetLodIndexCount(std::min(lod, msh->GetLodCount() - 1)) / 3;
+    drawStats.trianglesLod0 += msh->GetLodIndexCount(0) / 3;
+}
+
+std::size_t RenderableMesh::SelectLod(const Mesh *msh, const PulseEngine::Mat4& world, const RenderView& view) const
+{
+    if (msh->GetLodCount() < 2 || view.height <= 0) return 0;
+
+    const PulseEngine::Vector3 center = TransformPoint(world, msh->GetBoundsCenter());
+    const float scale = MaxAxisScale(world);
+
+    const PulseEngine::Vector3& eye = view.position;
+    const float dx = center.x - eye.x;
+    const float dy = center.y - eye.y;
+    const float dz = center.z - eye.z;
+    const float distance = std::sqrt(dx * dx + dy * dy + dz * dz) - msh->GetBoundsRadius() * scale;
+    if (distance <= 0.0f) return 0;
+
+    // pixels per world unit at distance 1 : projection[1][1] is cot(fov / 2)
+    const float pixelsPerUnit = view.projection.data[1][1] * (float)view.height * 0.5f / distance;
+
+    std::size_t lod = 0;
+    for (std::size_t i = 1; i < msh->GetLodCount(); ++i)
+    {
+        if (msh->GetLodError(i) * scale * pixelsPerUnit > lodErrorPixels) break;
+        lod = i;
+    }
+    return lod;
+}
@@ -5,16 +5,87 @@
 #include "common/dllExport.h"
 
 class Mesh;
+struct RenderView;
+struct AABB;
+class OcclusionCuller;
+
+/**
+ * @brief A sub-mesh at the LOD RenderableMesh::Draw would pick, for a caller drawing it itself (MaterialBatcher).
+ */
+struct MeshDraw
+{
+    Mesh* mesh = nullptr;
+    std::uint32_t subMesh = 0;      ///< index in its RenderableMesh
+    std::uint32_t lod = 0;
+};
+
+/**
+ * @brief Meshes drawn since the last ResetDrawStats, sent to the profiler by SceneManager.
+ */
+struct MeshDrawStats
+{
+    uint32_t meshes = 0;
+    uint64_t triangles = 0;         ///< with the selected LODs
+    uint64_t trianglesLod0 = 0;     ///< the same meshes at full detail
+};
 
 class PULSE_ENGINE_DLL_API RenderableMesh
 {
 public:
+    /// @brief A LOD is used while its error covers at most this many pixels on screen.
+    static float lodErrorPixels;
+
+    static const MeshDrawStats& GetDrawStats() { return drawStats; }
+    static void ResetDrawStats() { drawStats = MeshDrawStats(); }
+
     RenderableMesh(const std::string& name) : name(name) {}
+    /// @brief The meshes added with AddMesh are owned and deleted with it.
+    virtual ~RenderableMesh();
     virtual void Update() = 0;
     virtual void Render(Shader* shader) const = 0;
 
+    /**
+     * @brief Draw from a render snapshot : world matrix and camera are the ones captured, not the live ones. The
+     * caller binds the bones (SkinningStage::BindPalette) or sets hasSkeleton to false.
+     */
+    void Draw(Shader* shader, const PulseEngine::Mat4& world, const RenderView& view) const;
+
+    /**
+     * @brief The sub-meshes Draw would draw and their LOD, counted in the draw stats : the caller draws them.
+     * @return false, nothing added, when a sub-mesh has no index buffer (drawn as an array, not instanced).
+     */
+    bool CollectDraws(const PulseEngine::Mat4& world, const RenderView& view, std::vector<MeshDraw>& out) const;
+
+    /// @brief Matrices of the skinning palette, 0 : not skinned.
+    virtual std::uint32_t GetBoneCount() const { return 0; }
+    /**
+     * @brief Write the GetBoneCount matrices of the current pose in palette. Called on the workers of SkinningStage
+     * while the simulation waits : reads the mesh, changes nothing.
+     */
+    virtual void EvaluatePose(PulseEngine::Mat4* palette) const {}
+
     void AddMesh(Mesh* msh);
 
+    /**
+     * @brief Expand bounds with the bounding sphere of every mesh placed by matrix, as a box.
+     * @return false, bounds untouched, when no mesh has vertices.
+     */
+    bool ExpandWorldBounds(AABB& bounds) const;
+
+    /**
+     * @brief Rasterize the triangles of every static mesh into culler, placed by matrix, at the coarsest LOD whose
+     * error stays under occluderLodError of the mesh radius. Skinned meshes are skipped : their bind pose is not
+     * what is drawn.
+     * @return false when no mesh was rasterized.
+     */
+    bool RasterizeOccluder(OcclusionCuller& culler) const;
+
+    /// @brief Largest LOD error of an occluder, relative to its bounding radius : a coarser LOD can bulge out of the surface.
+    static float occluderLodError;
+
+    /// @brief Bytes of the vertex and index buffers of every mesh.
+    std::size_t GetMemorySize() const;
+
     void SetName(const std::string& name) {this->name = name;}
     std::string GetName() {return name;}
     
@@ -29,8 +100,23 @@ public:
     PulseEngine::Transform transform;
 
 protected:
+    /**
+     * @brief Draw every mesh at the LOD its screen size needs, from the active camera.
+     */
+    void DrawMeshes(Shader* shader) const;
+    void DrawMeshes(Shader* shader, const PulseEngine::Mat4& world, const RenderView& view) const;
+
+    /**
+     * @brief Coarsest LOD of msh whose error, projected at the distance of its bounds (world matrix : world), stays
+     * under lodErrorPixels seen from view.
+     */
+    std::size_t SelectLod(const Mesh* msh, const PulseEngine::Mat4& world, const RenderView& view) const;
+
     std::vector<Mesh*> meshes;
 
+    static MeshDrawStats drawStats;
+    static void CountDraw(const Mesh* msh, std::size_t lod);
+
 private:
     std::string name;
     std::size_t guid;
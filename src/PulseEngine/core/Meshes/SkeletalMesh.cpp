@@ -1,62 +1,98 @@
 #include "SkeletalMesh.h"
 #include "PulseEngine/core/Meshes/Mesh.h"
+#include "PulseEngine/core/Meshes/Skinning/SkinningStage.h"
 #include "PulseEngine/core/Graphics/IGraphicsApi.h"
 
+#include <algorithm>
+#include <cmath>
+#include <functional>
+
 void SkeletalMesh::Update()
 {
-    PROFILE_TIMER_FUNCTION;
-    if (actualAnimationIndex >= animations.size()) return;
     internalClock += PulseEngineInstance->GetDeltaTime();
+}
 
-    const AnimationClip& clip = animations[actualAnimationIndex];
-    double ticksPerSecond = (clip.tickPerSeconds > 0.0) ? clip.tickPerSeconds : 30.0;
-
-    double timeInTicks = internalClock * ticksPerSecond;
-    double animTime = fmod(timeInTicks, clip.duration);
-
-    const KeyFrame* frame = FindKeyframeAtTime(animTime);
-    if(!frame) return;
-
-    EDITOR_LOG("animtime : " << animTime << " frame : " << frame->time);
+void SkeletalMesh::EvaluatePose(PulseEngine::Mat4 *palette) const
+{
+    const std::size_t boneCount = skeleton.size();
+    const AnimationClip* clip = actualAnimationIndex < animations.size() ? &animations[actualAnimationIndex] : nullptr;
+    const KeyFrame* frame = clip && clip->duration > 0.0 ? FindKeyframeAtTime(
+        std::fmod(internalClock * (clip->tickPerSeconds > 0 ? clip->tickPerSeconds : 30.0), clip->duration)) : nullptr;
 
-    for (Bone& bone : skeleton)
+    // nothing to play, or BindAnimations wasn't called : rest pose
+    if (!frame || evaluationOrder.size() != boneCount || clip->bonePoses.size() != clip->keyframes.size() * boneCount)
     {
-        auto it = frame->boneTransforms.find(bone.name);
-        if (it == frame->boneTransforms.end())
-            continue;
+        std::fill(palette, palette + boneCount, PulseEngine::Mat4(1.0f));
+        return;
+    }
 
-        const TransformAnimation& localTransform = it->second;
+    const TransformAnimation* pose = clip->bonePoses.data() + (frame - clip->keyframes.data()) * boneCount;
 
-        PulseEngine::Mat4 local = PulseEngine::MathUtils::Matrix::ComposeMatrix(
-            localTransform.position,
-            localTransform.rotation,
-            localTransform.scale
-        );
+    // one per worker, reused from mesh to mesh
+    thread_local std::vector<PulseEngine::Mat4> globals;
+    globals.resize(boneCount);
 
-        PulseEngine::Mat4 global = (bone.parentIndex >= 0)
-            ? skeleton[bone.parentIndex].globalTransform * local
-            : local;
+    for (int b : evaluationOrder)
+    {
+        const Bone& bone = skeleton[b];
+        const PulseEngine::Mat4 local = clip->animatedBones[b]
+            ? PulseEngine::MathUtils::Matrix::ComposeMatrix(pose[b].position, pose[b].rotation, pose[b].scale)
+            : bone.localTransform;
 
-        bone.globalTransform = global;
+        globals[b] = bone.parentIndex >= 0 ? globals[bone.parentIndex] * local : local;
+        palette[bone.index] = globals[b] * bone.offsetMatrix;
+    }
+}
 
-        // if (bone.index >= finalBoneMatrices.size())
-        //     finalBoneMatrices.resize(skeleton.size());
+void SkeletalMesh::BindAnimations()
+{
+    // by position in skeleton, which the pose is evaluated in (Bone::index is the palette slot)
+    const std::size_t boneCount = skeleton.size();
+    std::unordered_map<std::string, std::size_t> positions;
+    for (std::size_t b = 0; b < boneCount; ++b) positions.emplace(skeleton[b].name, b);
 
-        finalBoneMatrices[bone.index] = bone.globalTransform * bone.offsetMatrix;
+    for (AnimationClip& clip : animations)
+    {
+        clip.bonePoses.assign(clip.keyframes.size() * boneCount, TransformAnimation());
+        clip.animatedBones.assign(boneCount, 0);
+        for (std::size_t f = 0; f < clip.keyframes.size(); ++f)
+        {
+            for (const auto& [name, transform] : clip.keyframes[f].boneTransforms)
+            {
+                auto bone = positions.find(name);
+                if (bone == positions.end()) continue;
+                clip.bonePoses[f * boneCount + bone->second] = transform;
+                clip.animatedBones[bone->second] = 1;
+            }
+        }
     }
-}
 
+    // the skeleton comes in the order the meshes reference the bones, not the hierarchy's
+    evaluationOrder.clear();
+    evaluationOrder.reserve(boneCount);
+    std::vector<std::uint8_t> state(boneCount, 0);  // 1 : being ordered, 2 : ordered
+    std::function<void(int)> visit = [&](int b)
+    {
+        if (state[b]) return;
+        state[b] = 1;
+        const int parent = skeleton[b].parentIndex;
+        if (parent >= 0 && parent < static_cast<int>(boneCount) && state[parent] != 1) visit(parent);
+        else if (parent >= 0) skeleton[b].parentIndex = -1; // broken hierarchy : evaluated as a root
+        state[b] = 2;
+        evaluationOrder.push_back(b);
+    };
+    for (std::size_t b = 0; b < boneCount; ++b) visit(static_cast<int>(b));
+}
 
 void SkeletalMesh::Render(Shader *shader) const
 {
     PROFILE_TIMER_FUNCTION;
-    shader->SetBool("hasSkeleton", true);
-    PulseEngineGraphicsAPI->SetShaderMat4Array(shader, "u_BoneMatrices", finalBoneMatrices);
+    thread_local std::vector<PulseEngine::Mat4> palette;
+    palette.resize(skeleton.size());
+    if (!palette.empty()) EvaluatePose(palette.data());
 
-    for(Mesh* msh : meshes)
-    {
-        msh->Draw(shader);
-    }
+    SkinningStage::BindPalette(shader, palette, 0);
+    DrawMeshes(shader);
 }
 
 AnimationClip SkeletalMesh::LoadAnimationSimplified(const aiAnimation* anim)
@@ -109,7 +145,7 @@ AnimationClip SkeletalMesh::LoadAnimationSimplified(const aiAnimation* anim)
     return clip;
 }
 
-const KeyFrame* SkeletalMesh::FindKeyframeAtTime(double time)
+const KeyFrame* SkeletalMesh::FindKeyframeAtTime(double time) const
 {
     if (actualAnimationIndex >= animations.size()) return nullptr;
     const AnimationClip& clip = animations[actualAnimationIndex];
@@ -122,21 +158,10 @@ const KeyFrame* SkeletalMesh::FindKeyframeAtTime(double time)
     if (time >= clip.keyframes.back().time)
         return &clip.keyframes.back();
 
-    // Find the two keyframes between which 'time' falls
-    for (size_t i = 0; i < clip.keyframes.size() - 1; ++i)
-    {
-        const KeyFrame& current = clip.keyframes[i];
-        const KeyFrame& next = clip.keyframes[i + 1];
-        if (time >= current.time && time <= next.time)
-        {
-            // For now, just return the current keyframe (no interpolation)
-            return &current;
-
-            // Optional: could do linear interpolation here
-        }
-    }
-
-    return &clip.keyframes.back();
+    // the keyframe 'time' falls after, sorted by time : for now, just the current keyframe (no interpolation)
+    auto next = std::upper_bound(clip.keyframes.begin(), clip.keyframes.end(), time,
+        [](double t, const KeyFrame& frame) { return t < frame.time; });
+    return &*(next - 1);
 }
 
 
@@ -23,8 +23,7 @@ struct Bone
     int parentIndex;                  // Index of parent bone (-1 if root)
     
     PulseEngine::Mat4 offsetMatrix;   // Inverse bind pose
-    PulseEngine::Mat4 localTransform; // From animation (position/rot/scale composed)
-    PulseEngine::Mat4 globalTransform; // Computed world-space transform
+    PulseEngine::Mat4 localTransform; // Bind pose, relative to the parent (used when a clip has no track for the bone)
 
     Bone() : index(-1), parentIndex(-1) {}
 };
@@ -48,6 +47,10 @@ struct PULSE_ENGINE_DLL_API AnimationClip
     std::vector<KeyFrame> keyframes;
     double duration;
     int tickPerSeconds;
+
+    // resolved by SkeletalMesh::BindAnimations : the pose evaluation doesn't look bones up by name
+    std::vector<TransformAnimation> bonePoses;  ///< keyframes.size() poses, one transform per skeleton bone
+    std::vector<std::uint8_t> animatedBones;    ///< per skeleton bone, 0 : no track, bind pose
 };
 
 class PULSE_ENGINE_DLL_API SkeletalMesh : public RenderableMesh
@@ -55,9 +58,25 @@ class PULSE_ENGINE_DLL_API SkeletalMesh : public RenderableMesh
     public:
     SkeletalMesh(const std::string& name) : RenderableMesh(name) {}
 
+    /**
+     * @brief Advance the animation clock. The pose is evaluated by SkinningStage, only for the meshes drawn.
+     */
     void Update() override;
+    /**
+     * @brief Draw outside of a render snapshot (editor) : the pose is evaluated and uploaded for this draw only.
+     */
     void Render(Shader* shader) const override;
-    const KeyFrame* FindKeyframeAtTime(double time);
+
+    std::uint32_t GetBoneCount() const override { return static_cast<std::uint32_t>(skeleton.size()); }
+    void EvaluatePose(PulseEngine::Mat4* palette) const override;
+
+    /**
+     * @brief Index the keyframes of every clip by bone and order the bones parents first, once skeleton and
+     * animations are set.
+     */
+    void BindAnimations();
+
+    const KeyFrame* FindKeyframeAtTime(double time) const;
 
     static AnimationClip LoadAnimationSimplified(const aiAnimation* anim);
     static PulseEngine::Mat4 ConvertAiMatrix(const aiMatrix4x4& from);
@@ -65,10 +84,10 @@ class PULSE_ENGINE_DLL_API SkeletalMesh : public RenderableMesh
 
     std::vector<AnimationClip> animations;
     std::vector<Bone> skeleton;
-    std::vector<PulseEngine::Mat4> finalBoneMatrices;
     std::unordered_map<std::string, int> boneNameToIndex;
     private:
     int actualAnimationIndex = 0;
+    std::vector<int> evaluationOrder;   ///< skeleton indices, a parent before its children
 
     float internalClock = 0.0f;
 };
@@ -0,0 +1,101 @@
+#include "SkinningStage.h"
+#include "common/common.h"
+#include "PulseEngine/core/PulseEngineBackend.h"
+#include "PulseEngine/core/Graphics/IGraphicsApi.h"
+#include "PulseEngine/core/Meshes/RenderableMesh.h"
+#include "PulseEngine/core/Threading/ThreadPool.h"
+#include "shader.h"
+
+bool SkinningStage::parallel = true;
+
+namespace
+{
+    // texture unit of the palettes, vertex stage (see LightManager.cpp for the others)
+    constexpr unsigned int BONE_PALETTE_UNIT = 4;
+
+    // a pose is a few microseconds : a handful of meshes per pick of a worker
+    constexpr std::size_t MESHES_PER_CHUNK = 4;
+
+    SkinningStats stats;
+
+    // graphics thread only
+    struct PaletteBuffer
+    {
+        unsigned int buffer = 0;
+        unsigned int texture = 0;
+        const PulseEngine::Mat4* uploaded = nullptr;    ///< palettes of the snapshot in the buffer
+        std::uint64_t frame = 0;
+    };
+    PaletteBuffer paletteBuffer;
+}
+
+void SkinningStage::EvaluatePoses(const std::vector<SkinningJob> &jobs, std::vector<PulseEngine::Mat4> &palettes)
+{
+    PROFILE_TIMER_FUNCTION;
+    stats = SkinningStats();
+    stats.meshes = jobs.size();
+    stats.bones = palettes.size();
+    if (jobs.empty()) return;
+
+    PulseEngine::Mat4* out = palettes.data();
+    auto evaluate = [&jobs, out](std::size_t i)
+    {
+        const SkinningJob& job = jobs[i];
+        job.mesh->EvaluatePose(out + job.firstBone);
+    };
+
+    if (parallel && jobs.size() > MESHES_PER_CHUNK)
+    {
+        PulseEngine::Threading::ThreadPool& pool = PulseEngine::Threading::ThreadPool::GetInstance();
+        stats.workers = pool.GetWorkerCount();
+        pool.ParallelFor(jobs.size(), evaluate, MESHES_PER_CHUNK);
+    }
+    else
+    {
+        for (std::size_t i = 0; i < jobs.size(); ++i) evaluate(i);
+    }
+
+    PROFILE_COUNTER("Skinning", {
+        {"meshes", (double)stats.meshes},
+        {"bones", (double)stats.bones},
+        {"workers", (double)stats.workers}
+    });
+}
+
+void SkinningStage::BindPalette(Shader *shader, const std::vector<PulseEngine::Mat4> &palettes, std::uint32_t firstBone, std::uint64_t frame)
+{
+    IGraphicsAPI* gAPI = PulseEngineGraphicsAPI;
+    if (palettes.empty())
+    {
+        UnbindPalette(shader);
+        return;
+    }
+
+    if (!paletteBuffer.texture) gAPI->CreateTextureBuffer(&paletteBuffer.buffer, &paletteBuffer.texture, TEXTURE_BUFFER_RGBA32F);
+
+    // every draw of a snapshot shares one upload, the shadow passes included
+    if (frame == 0 || paletteBuffer.frame != frame || paletteBuffer.uploaded != palettes.data())
+    {
+        gAPI->UploadTextureBuffer(paletteBuffer.buffer, palettes.data(), palettes.size() * sizeof(PulseEngine::Mat4));
+        paletteBuffer.uploaded = frame ? palettes.data() : nullptr;
+        paletteBuffer.frame = frame;
+    }
+
+    gAPI->ActivateTexture(BONE_PALETTE_UNIT);
+    gAPI->BindTexture(TEXTURE_BUFFER, paletteBuffer.texture);
+    shader->SetInt("boneMatrices", BONE_PALETTE_UNIT);
+    shader->SetInt("boneOffset", static_cast<int>(firstBone));
+    shader->SetBool("hasSkeleton", true);
+}
+
+void SkinningStage::UnbindPalette(Shader *shader)
+{
+    // the sampler keeps its own unit : left on 0, it would share it with a sampler of another type
+    shader->SetInt("boneMatrices", BONE_PALETTE_UNIT);
+    shader->SetBool("hasSkeleton", false);
+}
+
+const SkinningStats &SkinningStage::GetStats()
+{
+    return stats;
+}
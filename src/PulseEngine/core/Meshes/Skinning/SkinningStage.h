@@ -0,0 +1,72 @@
+/**
+ * @file SkinningStage.h
+ * @brief Bone palettes of the skinned meshes of a frame : posed on the worker threads, uploaded once.
+ * @details RenderSnapshot::Capture hands the skinned meshes it keeps (shadow casters and visible ones, nothing else is
+ * posed) to EvaluatePoses : each one writes its palette at its own offset of one contiguous array, split over the
+ * ThreadPool workers and the simulation thread. The graphics thread uploads that array once per snapshot, as a
+ * buffer texture read by the shaders at boneOffset (see basic.vert), and only sets the offset per draw.
+ * - Static meshes don't carry bone data at all (see SkinWeights) and draw with hasSkeleton false.
+ * @version 0.1
+ * @date 2025-12-14
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+#ifndef SKINNINGSTAGE_H
+#define SKINNINGSTAGE_H
+
+#include "Common/dllExport.h"
+#include "PulseEngine/core/Math/Mat4.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+class RenderableMesh;
+class Shader;
+
+/**
+ * @brief One palette to evaluate : mesh->GetBoneCount() matrices from firstBone.
+ */
+struct SkinningJob
+{
+    const RenderableMesh* mesh = nullptr;
+    std::uint32_t firstBone = 0;
+};
+
+/**
+ * @brief The last EvaluatePoses, simulation side.
+ */
+struct SkinningStats
+{
+    std::size_t meshes = 0;
+    std::size_t bones = 0;
+    std::size_t workers = 0;        ///< ThreadPool workers the poses were split over, 0 : calling thread only
+};
+
+class PULSE_ENGINE_DLL_API SkinningStage
+{
+public:
+    /// @brief false : every pose is evaluated on the calling thread.
+    static bool parallel;
+
+    /**
+     * @brief Pose every job in palettes, already sized for all of them. No graphic call : simulation side.
+     */
+    static void EvaluatePoses(const std::vector<SkinningJob>& jobs, std::vector<PulseEngine::Mat4>& palettes);
+
+    /**
+     * @brief Skin the next draws of shader with the palette at firstBone of palettes, on the graphics thread.
+     * @param frame snapshot the palettes come from : uploaded once for all its draws. 0 : uploaded for this draw.
+     */
+    static void BindPalette(Shader* shader, const std::vector<PulseEngine::Mat4>& palettes, std::uint32_t firstBone, std::uint64_t frame = 0);
+
+    /**
+     * @brief The next draws of shader are static meshes.
+     */
+    static void UnbindPalette(Shader* shader);
+
+    static const SkinningStats& GetStats();
+};
+
+#endif // SKINNINGSTAGE_H
@@ -1,5 +1,6 @@
 #include "StaticMesh.h"
 #include "PulseEngine/core/Meshes/Mesh.h"
+#include "PulseEngine/core/Meshes/Skinning/SkinningStage.h"
 
 void StaticMesh::Update() 
 {
@@ -7,10 +8,6 @@ void StaticMesh::Update()
 
 void StaticMesh::Render(Shader *shader) const
 {
-    shader->SetBool("hasSkeleton", false);
-    shader->SetInt("boneLength", 0);
-    for(Mesh* msh : meshes)
-    {
-        msh->Draw(shader);
-    }
+    SkinningStage::UnbindPalette(shader);
+    DrawMeshes(shader);
 }
\ No newline at end of file
@@ -4,15 +4,23 @@
 
 /**
  * @brief Structure representing a single vertex in 3D space.
- * Includes position, normal, texture coordinates, bone IDs, and weights.
+ * Includes position, normal, texture coordinates, tangent and bitangent. Bone data is a separate stream (SkinWeights),
+ * only skinned meshes have it.
  */
 struct Vertex
 {
     PulseEngine::Vector3 Position;    ///< Vertex position in 3D space.
     PulseEngine::Vector3 Normal;      ///< Vertex normal vector.
     PulseEngine::Vector2 TexCoords;   ///< Texture coordinates (UV).
-    PulseEngine::iVector4 BoneIDs;    ///< IDs of the bones affecting this vertex.
-    PulseEngine::Vector4 Weights = PulseEngine::Vector4(0.0f);     ///< Weights corresponding to each bone.
     PulseEngine::Vector3 Tangent;
     PulseEngine::Vector3 Bitangent;
-};
\ No newline at end of file
+};
+
+/**
+ * @brief Bone influences of one vertex, same index as its Vertex.
+ */
+struct SkinWeights
+{
+    PulseEngine::iVector4 BoneIDs;    ///< IDs of the bones affecting this vertex.
+    PulseEngine::Vector4 Weights = PulseEngine::Vector4(0.0f);     ///< Weights corresponding to each bone.
+};
@@ -3,16 +3,13 @@
 #include "PulseEngine/core/SceneManager/HierarchyNode.h"
 #include "PulseEngine/core/Physics/Collider/BoxCollider.h"
 #include "PulseEngine/core/Entity/Entity.h"
-#include "PulseEngine/core/Graphics/IGraphicsApi.h"
-#include "shader.h"
+#include "PulseEngine/core/Graphics/DebugDraw/DebugDraw.h"
 #include "PulseEngine/core/Math/MathUtils.h"
 
 #include <algorithm>
 
 using namespace PulseEngine::Physics;
 
-Shader* PulseEngine::Physics::Casting::lineShader = nullptr;
-
 PULSE_REGISTER_CLASS_CPP(Casting)
 void PulseEngine::Physics::Casting::Serialize(Archive& ar)
 {
@@ -29,10 +26,6 @@ const char* PulseEngine::Physics::Casting::ToString()
 
 PulseEngine::Physics::Casting::Casting()
 {
-    if(!lineShader)
-    {
-        lineShader = new Shader(std::string(ASSET_PATH) + "EngineConfig/shaders/lineTrace.vert", std::string(ASSET_PATH) + "EngineConfig/shaders/lineTrace.frag", PulseEngineGraphicsAPI);
-    }
 }
 
 PulseEngine::Physics::CastResult *PulseEngine::Physics::Casting::Cast(const PulseEngine::Physics::CastData &castData)
@@ -45,7 +38,8 @@ PulseEngine::Physics::CastResult *PulseEngine::Physics::Casting::Cast(const Puls
     result.start = castData.start;
     result.end = castData.end;
 
-    SceneManager::GetInstance()->GetEntitiesInFrustum(visibles);
+    // no occlusion culling : a cast must still hit what is hidden behind an occluder
+    SceneManager::GetInstance()->GetEntitiesInFrustum(visibles, false);
 
     for(int i = 0; i < stepAmount; ++i)
     {    
@@ -73,25 +67,15 @@ PulseEngine::Physics::CastResult *PulseEngine::Physics::Casting::Cast(const Puls
 
 void PulseEngine::Physics::Casting::RenderCast()
 {
-    if(!PulseEngineGraphicsAPI) return;
-    lineShader->Use();
-    lineShader->SetMat4("view", PulseEngineInstance->lastView);
-    lineShader->SetMat4("projection", PulseEngineInstance->lastProjection);
-    lineShader->SetMat4("model", PulseEngine::MathUtils::Matrix::Identity()); 
-    lineShader->SetVec3("color", PulseEngine::Vector3(0.0f, 1.0f, 0.0f));
-    PulseEngineGraphicsAPI->ActivateWireframe();
     if(result.hitCollider)
     {
         //draw green until we hit a collider. red will be displayed after.
-        PulseEngineGraphicsAPI->DrawLine(result.start, result.impactLocation, PulseEngine::Color(0.0f, 1.0f, 0.0f));
-        lineShader->SetVec3("color", PulseEngine::Vector3(1.0f, 0.0f, 0.0f));
-        PulseEngineGraphicsAPI->DrawLine(result.impactLocation, result.end, PulseEngine::Color(1.0f, 0.0f, 0.0f));
+        PulseEngine::Graphics::DebugDraw::Line(result.start, result.impactLocation, PulseEngine::Color(0.0f, 1.0f, 0.0f));
+        PulseEngine::Graphics::DebugDraw::Line(result.impactLocation, result.end, PulseEngine::Color(1.0f, 0.0f, 0.0f));
     }
     else
     {
         //only draw green if no collider touch until the end of the trace.
-        PulseEngineGraphicsAPI->DrawLine(result.start, result.end, PulseEngine::Color(0.0f, 1.0f, 0.0f));
-
+        PulseEngine::Graphics::DebugDraw::Line(result.start, result.end, PulseEngine::Color(0.0f, 1.0f, 0.0f));
     }
-    PulseEngineGraphicsAPI->DesactivateWireframe();
 }
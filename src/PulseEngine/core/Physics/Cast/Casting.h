@@ -8,7 +8,6 @@
 
 class Entity;
 class Collider;
-class Shader;
 
 namespace PulseEngine::Physics
 {
@@ -44,12 +43,12 @@ namespace PulseEngine::Physics
     public:
         Casting();
         virtual PulseEngine::Physics::CastResult* Cast(const PulseEngine::Physics::CastData& castData); 
+        /// @brief Submit the last cast to DebugDraw : green up to the impact, red after it.
         void RenderCast();
 
 
     private:    
         CastResult result;
-        static Shader* lineShader;
         std::vector<Vector3> debugPoints;
 
     };
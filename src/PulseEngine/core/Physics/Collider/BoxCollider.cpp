@@ -1,12 +1,12 @@
 #include "BoxCollider.h"
 #include "PulseEngine/core/Entity/Entity.h"
 #include "PulseEngine/core/Material/Material.h"
-#include "PulseEngine/core/Graphics/IGraphicsApi.h"
+#include "PulseEngine/core/Graphics/DebugDraw/DebugDraw.h"
 #include "PulseEngine/core/Math/MathUtils.h"
 #include "PulseEngine/core/Math/Mat4.h"
 #include "PulseEngine/core/Math/Vector.h"
-#include "PulseEngine/core/Meshes/Vertex.h"
 #include "PulseEngine/API/EntityAPI/EntityApi.h"
+#include "PulseEngine/core/Physics/Collider/OBBBatch.h"
 
 #include <vector>
 
@@ -52,61 +52,6 @@ BoxCollider::BoxCollider(PulseEngine::Vector3* position, PulseEngine::Vector3* r
     REGISTER_VAR(this->size);
     // AddExposedVariable(EXPOSE_VAR(decalPosition.x, FLOAT3));
     // REGISTER_VAR(decalPosition.x);
-
-    IGraphicsAPI* gAPI = PulseEngineInstance->graphicsAPI;
-    if (!gAPI) return;
-
-    // Calcul du half-size
-    PulseEngine::Vector3 halfSize = GetHalfSize();
-
-    // Définition des vertices du cube
-    PulseEngine::Vector3 vertices[8] = {
-        {-0.5f, -0.5f, -0.5f},
-        { 0.5f, -0.5f, -0.5f},
-        { 0.5f,  0.5f, -0.5f},
-        {-0.5f,  0.5f, -0.5f},
-        {-0.5f, -0.5f,  0.5f},
-        { 0.5f, -0.5f,  0.5f},
-        { 0.5f,  0.5f,  0.5f},
-        {-0.5f,  0.5f,  0.5f}
-    };
-
-    
-    unsigned int indices[24] = {
-        0,1, 1,2, 2,3, 3,0, 
-        4,5, 5,6, 6,7, 7,4, 
-        0,4, 1,5, 2,6, 3,7  
-    };
-
-    meshVertices.clear();
-    meshVertices.reserve(8);
-    for (auto v : vertices)
-    {
-        Vertex vert;
-        vert.Position = v;
-        vert.Normal = PulseEngine::Vector3(0.0f);
-        vert.TexCoords = PulseEngine::Vector2(0.0f);
-        vert.BoneIDs = PulseEngine::iVector4(0);
-        vert.Weights = PulseEngine::Vector4(0.0f);
-        vert.Tangent = PulseEngine::Vector3(0.0f);
-        vert.Bitangent = PulseEngine::Vector3(0.0f);
-        meshVertices.push_back(vert);
-    }
-
-    // Indices
-    meshIndices = std::vector<unsigned int>(std::begin(indices), std::end(indices));
-
-    // Création du mesh OpenGL
-    gAPI->SetupMesh(&VAO, &VBO, &EBO, meshVertices, meshIndices);
-
-    // Chargement du shader de ligne
-    lineTraceShader = new Shader(
-        std::string(ASSET_PATH) + "EngineConfig/shaders/lineTrace.vert",
-        std::string(ASSET_PATH) + "EngineConfig/shaders/lineTrace.frag",
-        gAPI
-    );
-
-
 }
 
 BoxCollider::BoxCollider()
@@ -174,11 +119,6 @@ void BoxCollider::OnUpdate()
 
 void BoxCollider::OnRender()
 {
-    IGraphicsAPI* gAPI = PulseEngineInstance->graphicsAPI;
-    if (!gAPI) return;
-
-    gAPI->ActivateWireframe();
-
     PulseEngine::Mat4 model = PulseEngine::MathUtils::Matrix::Identity();
     model = PulseEngine::MathUtils::Matrix::Translate(model, (*position) + decalPosition);
     model = PulseEngine::MathUtils::Matrix::RotateZ(model, PulseEngine::MathUtils::ToRadians(rotation->z));
@@ -186,20 +126,8 @@ void BoxCollider::OnRender()
     model = PulseEngine::MathUtils::Matrix::RotateX(model, PulseEngine::MathUtils::ToRadians(rotation->x));
     model = PulseEngine::MathUtils::Matrix::Scale(model, size);
 
-    // lineTraceShader->Use();
-    // gAPI->SetShaderMat4(lineTraceShader, "view", PulseEngineInstance->view); 
-    // gAPI->SetShaderMat4(lineTraceShader, "projection", PulseEngineInstance->projection);
-    gAPI->SetShaderMat4(lineTraceShader, "model", model); 
-    gAPI->SetShaderVec3(lineTraceShader, "color", PulseEngine::Vector3(boxColor.r/255.0f,boxColor.g/255.0f,boxColor.b/255.0f)); 
-    std::vector<PulseEngine::Vector3> mshVertPos;
-    for (int i = 0; i < 8; ++i)
-    {
-        PulseEngine::Vector3 v = meshVertices[i].Position;
-        mshVertPos.push_back(v); 
-    }
-    gAPI->RenderLineMesh(&VAO, &VBO, mshVertPos, meshIndices);
-
-    gAPI->DesactivateWireframe();
+    // batched with every other debug line, drawn at the end of the frame
+    PulseEngine::Graphics::DebugDraw::Box(model, PulseEngine::Color(boxColor.r / 255.0f, boxColor.g / 255.0f, boxColor.b / 255.0f));
 }
 
 void BoxCollider::OnEditorDisplay()
@@ -334,6 +262,13 @@ void BoxCollider::ResolveCollision(Collider* other)
     if (!SAT_MinimumTranslation(*otherBox, normal, penetration))
         return;
 
+    ResolveContact(otherBox, normal, penetration);
+}
+
+void BoxCollider::ResolveContact(BoxCollider* otherBox, PulseEngine::Vector3 normal, float penetration)
+{
+    if (this->isTrigger || otherBox->isTrigger) return;
+
     PulseEngine::Vector3 posA = this->GetCenter() + decalPosition;
     PulseEngine::Vector3 posB = otherBox->GetCenter() + otherBox->decalPosition;
 
@@ -487,124 +422,39 @@ PulseEngine::Vector3 BoxCollider::GetAxis(int index) const
 }
 
 
-bool BoxCollider::SAT_MinimumTranslation(const BoxCollider& B, PulseEngine::Vector3& outAxis, float& outDepth) const
+void BoxCollider::GetOBB(PulseEngine::Vector3& outCenter, PulseEngine::Vector3& outHalfExtents, PulseEngine::Vector3 outAxes[3]) const
 {
-    if ((rotation->x - B.rotation->x) < 1e-3f &&
-    (rotation->y - B.rotation->y) < 1e-3f &&
-    (rotation->z - B.rotation->z) < 1e-3f)
-    {
-        return const_cast<BoxCollider*>(&B)->FastCheckCollision(const_cast<BoxCollider*>(this));
-    }
-    // axes locaux (unit)
-    PulseEngine::Vector3 Aaxes[3] = { GetAxis(0), GetAxis(1), GetAxis(2) };
-    PulseEngine::Vector3 Baxes[3] = { B.GetAxis(0), B.GetAxis(1), B.GetAxis(2) };
-
-    // demi-extents locaux
-    PulseEngine::Vector3 halfA = this->GetHalfSize();
-    PulseEngine::Vector3 halfB = B.GetHalfSize();
-
-    // rotation matrix R and AbsR: R[i][j] = dot(Ai, Bj)
-    float R[3][3];
-    float AbsR[3][3];
-    const float EPS = 1e-6f;
-    for (int i = 0; i < 3; ++i)
-    {
-        for (int j = 0; j < 3; ++j)
-        {
-            R[i][j] = PulseEngine::Dot(Aaxes[i], Baxes[j]);
-            AbsR[i][j] = std::abs(R[i][j]) + EPS;
-        }
-    }
-
-    // vector t from A to B in world coords, then expressed in A's frame
-    PulseEngine::Vector3 centerA = this->GetCenter() + this->decalPosition;
-    PulseEngine::Vector3 centerB = B.GetCenter() + B.decalPosition;
-    PulseEngine::Vector3 tWorld = centerB - centerA;
-    PulseEngine::Vector3 t( PulseEngine::Dot(tWorld, Aaxes[0]),
-                            PulseEngine::Dot(tWorld, Aaxes[1]),
-                            PulseEngine::Dot(tWorld, Aaxes[2]) );
-
-    // track minimal penetration
-    float minPen = FLT_MAX;
-    PulseEngine::Vector3 minAxis(0,0,0);
-
-    auto checkAxisA = [&](int i)->bool {
-        float ra = halfA[i];
-        float rb = halfB.x * AbsR[i][0] + halfB.y * AbsR[i][1] + halfB.z * AbsR[i][2];
-        float dist = std::abs(t[i]);
-        const float EPSILON = 0.01f; // ajustable selon ton échelle
-        float overlap = ra + rb - dist + EPSILON;
-        if (overlap < 0.0f) return false;
-
-        if (overlap < minPen) { minPen = overlap; minAxis = Aaxes[i]; }
-        return true;
-    };
-
-    auto checkAxisB = [&](int i)->bool {
-        float ra = halfA.x * AbsR[0][i] + halfA.y * AbsR[1][i] + halfA.z * AbsR[2][i];
-        float rb = halfB[i];
-        float dist = std::abs(t[0] * R[0][i] + t[1] * R[1][i] + t[2] * R[2][i]);
-        float overlap = ra + rb - dist;
-        if (overlap < 0.0f) return false;
-        if (overlap < minPen) { minPen = overlap; minAxis = Baxes[i]; }
-        return true;
-    };
-
-    // test A axes
-    for (int i = 0; i < 3; ++i) if (!checkAxisA(i)) return false;
-
-    // test B axes
-    for (int i = 0; i < 3; ++i) if (!checkAxisB(i)) return false;
+    PulseEngine::Mat4 rotationMatrix = PulseEngine::MathUtils::Matrix::Identity();
+    rotationMatrix = PulseEngine::MathUtils::Matrix::RotateZ(rotationMatrix, PulseEngine::MathUtils::ToRadians(rotation->z));
+    rotationMatrix = PulseEngine::MathUtils::Matrix::RotateY(rotationMatrix, PulseEngine::MathUtils::ToRadians(rotation->y));
+    rotationMatrix = PulseEngine::MathUtils::Matrix::RotateX(rotationMatrix, PulseEngine::MathUtils::ToRadians(rotation->x));
 
-    // test cross products A_i x B_j
-    for (int i = 0; i < 3; ++i)
-    {
-        for (int j = 0; j < 3; ++j)
-        {
-            // axis in world space
-            PulseEngine::Vector3 axis = PulseEngine::Cross(Aaxes[i], Baxes[j]);
-            float axisLen2 = axis.x*axis.x + axis.y*axis.y + axis.z*axis.z;
-            float threshold = 1e-3f * (halfA.GetMagnitude() + halfB.GetMagnitude());
-            if (axisLen2 < threshold*threshold) continue;
-
-            // Express axis in A-frame for projection of t
-            PulseEngine::Vector3 axisAframe = PulseEngine::Vector3(
-                PulseEngine::Dot(axis, Aaxes[0]),
-                PulseEngine::Dot(axis, Aaxes[1]),
-                PulseEngine::Dot(axis, Aaxes[2])
-            );
-
-            // axis components on B axes
-            PulseEngine::Vector3 axisBframe = PulseEngine::Vector3(
-                PulseEngine::Dot(axis, Baxes[0]),
-                PulseEngine::Dot(axis, Baxes[1]),
-                PulseEngine::Dot(axis, Baxes[2])
-            );
-
-            PulseEngine::Vector3 axisN = axis / sqrt(axisLen2);
-            float tProj = std::abs(PulseEngine::Dot(tWorld, axisN));
-
-            float ra = halfA.x * std::abs(axisAframe.x) +
-                       halfA.y * std::abs(axisAframe.y) +
-                       halfA.z * std::abs(axisAframe.z);
-
-            float rb = halfB.x * std::abs(axisBframe.x) +
-                       halfB.y * std::abs(axisBframe.y) +
-                       halfB.z * std::abs(axisBframe.z);
-
-            float overlap = ra + rb - tProj;
-            if (overlap < 0.0f) return false;
-            if (overlap < minPen) { minPen = overlap; minAxis = axis; }
-        }
-    }
+    outAxes[0] = rotationMatrix * PulseEngine::Vector3(1, 0, 0);
+    outAxes[1] = rotationMatrix * PulseEngine::Vector3(0, 1, 0);
+    outAxes[2] = rotationMatrix * PulseEngine::Vector3(0, 0, 1);
 
-    // If we reach here => collision. minAxis points to axis of minimal penetration (world space)
-    // normalize minAxis direction
-    float len = std::sqrt(minAxis.x*minAxis.x + minAxis.y*minAxis.y + minAxis.z*minAxis.z);
-    if (len < 1e-6f) return false;
+    outCenter = GetCenter() + decalPosition;
+    outHalfExtents = GetHalfSize();
+}
 
-    outAxis = minAxis * (1.0f / len);
-    outDepth = minPen;
+bool BoxCollider::SAT_MinimumTranslation(const BoxCollider& B, PulseEngine::Vector3& outAxis, float& outDepth) const
+{
+    // reused between calls to avoid reallocating the arrays for every pair
+    static thread_local PulseEngine::Physics::OBBArray boxes;
+    boxes.Clear();
+
+    PulseEngine::Vector3 center, halfExtents, axes[3];
+    GetOBB(center, halfExtents, axes);
+    boxes.Add(center, halfExtents, axes);
+    B.GetOBB(center, halfExtents, axes);
+    boxes.Add(center, halfExtents, axes);
+
+    PulseEngine::Physics::OBBPair pair { 0, 1 };
+    PulseEngine::Physics::OBBContact contact;
+    PulseEngine::Physics::TestOBBPairs(boxes, &pair, 1, &contact);
+    if (!contact.intersect) return false;
+
+    outAxis = contact.axis;
+    outDepth = contact.depth;
     return true;
 }
-
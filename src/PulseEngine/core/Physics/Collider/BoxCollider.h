@@ -37,8 +37,23 @@ public:
         return "BoxCollider";
     }
 
+    /**
+     * @brief Separating axis test against another box, through the batched OBB kernel (see OBBBatch.h).
+     * @param B The other box.
+     * @param outAxis Minimum translation axis, unit length, oriented from this box toward B.
+     * @param outDepth Penetration depth along outAxis.
+     * @return True if the boxes overlap.
+     */
     bool SAT_MinimumTranslation(const BoxCollider& B, PulseEngine::Vector3& outAxis, float& outDepth) const;
 
+    /**
+     * @brief Computes the oriented box in world space, with a single rotation matrix for the three axes.
+     * @param outCenter Center of the box (decalPosition included).
+     * @param outHalfExtents Half-size of the box.
+     * @param outAxes The three local axes in world space.
+     */
+    void GetOBB(PulseEngine::Vector3& outCenter, PulseEngine::Vector3& outHalfExtents, PulseEngine::Vector3 outAxes[3]) const;
+
     /**
      * @brief Computes the oriented size of the box given a rotation.
      * @param rotation Rotation vector.
@@ -77,6 +92,14 @@ public:
      */
     void ResolveCollision(Collider* other) override;
 
+    /**
+     * @brief Collision response for a contact already found (see ResolveCollision).
+     * @param otherBox The other box.
+     * @param normal Minimum translation axis, unit length, from this box toward otherBox.
+     * @param penetration Penetration depth along normal.
+     */
+    void ResolveContact(BoxCollider* otherBox, PulseEngine::Vector3 normal, float penetration);
+
     /**
      * @brief Applies a fast collision resolution method with another box.
      * @param otherBox Pointer to the other BoxCollider.
@@ -144,7 +167,6 @@ public:
      */
     PulseEngine::Vector3 GetCenter() const;
 
-    Shader* lineTraceShader;
     bool constraintRotation[3] = {false, false ,false};
     bool constraintLocation[3] = {false, false, false};
 
@@ -155,9 +177,6 @@ private:
     PulseEngine::Vector3 size;         ///< Size of the box (width, height, depth).
     bool isTrigger = false;            ///< If true, only detects collisions but doesn’t resolve them.
     bool hasFastCalculus = false;      ///< If true, uses fast collision detection.
-    unsigned int VAO = 0, VBO = 0, EBO = 0;
-    std::vector<Vertex> meshVertices;
-    std::vector<unsigned int> meshIndices;
     
     PulseEngine::Color boxColor = PulseEngine::Color(1.0f, 0.0f, 0.0f);
 
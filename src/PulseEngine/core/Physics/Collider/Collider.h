@@ -55,6 +55,7 @@ class PULSE_ENGINE_DLL_API Collider : public IScript
         virtual PulseEngine::Vector3 GetPosition() const = 0;
         virtual void SetPosition(const PulseEngine::Vector3& position) = 0;
 
+        /// colliders touched during the last physic step, filled from the PhysicManager contact events
         std::vector<Collider*> othersCollider;
         PulseEngine::Transform lastTransform;
         PulseEngine::Vector3 decalPosition;
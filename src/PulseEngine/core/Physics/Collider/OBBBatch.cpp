@@ -0,0 +1,277 @@
+#include "OBBBatch.h"
+#include "PulseEngine/core/Math/Simd/SimdLanes.h"
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+
+using namespace PulseEngine;
+using namespace PulseEngine::Physics;
+
+namespace
+{
+    constexpr float SAT_EPSILON = 1e-6f;            // added to |R| to absorb nearly parallel edges
+    constexpr float CROSS_AXIS_MIN_LENGTH = 1e-3f;  // below, A[i] x B[j] is degenerate and skipped
+
+    /**
+     * @brief Test Lanes::Width pairs at once.
+     * @param ia indices of the boxes A, one per lane
+     * @param ib indices of the boxes B, one per lane
+     * @param outDepth minimum penetration per lane
+     * @param outAxis index of the minimum translation axis per lane (stored as float)
+     * @return bit i set when lane i is separated
+     */
+    template <typename L>
+    int TestLanes(const OBBArray& boxes, const uint32_t* ia, const uint32_t* ib, float* outDepth, float* outAxis)
+    {
+        using F = typename L::Float;
+        using M = typename L::Mask;
+
+        F a[3][3], b[3][3];
+        for (int i = 0; i < 3; ++i)
+        {
+            for (int c = 0; c < 3; ++c)
+            {
+                a[i][c] = L::Gather(boxes.axis[i][c].data(), ia);
+                b[i][c] = L::Gather(boxes.axis[i][c].data(), ib);
+            }
+        }
+
+        const F hA[3] = { L::Gather(boxes.halfX.data(), ia), L::Gather(boxes.halfY.data(), ia), L::Gather(boxes.halfZ.data(), ia) };
+        const F hB[3] = { L::Gather(boxes.halfX.data(), ib), L::Gather(boxes.halfY.data(), ib), L::Gather(boxes.halfZ.data(), ib) };
+
+        const F t[3] = {
+            L::Sub(L::Gather(boxes.centerX.data(), ib), L::Gather(boxes.centerX.data(), ia)),
+            L::Sub(L::Gather(boxes.centerY.data(), ib), L::Gather(boxes.centerY.data(), ia)),
+            L::Sub(L::Gather(boxes.centerZ.data(), ib), L::Gather(boxes.centerZ.data(), ia))
+        };
+
+        // R[i][j] = dot(A[i], B[j]), tA = t expressed in A's frame
+        F R[3][3], absR[3][3], tA[3];
+        const F eps = L::Set(SAT_EPSILON);
+        for (int i = 0; i < 3; ++i)
+        {
+            for (int j = 0; j < 3; ++j)
+            {
+                R[i][j] = L::MulAdd(a[i][2], b[j][2], L::MulAdd(a[i][1], b[j][1], L::Mul(a[i][0], b[j][0])));
+                absR[i][j] = L::Add(L::Abs(R[i][j]), eps);
+            }
+            tA[i] = L::MulAdd(t[2], a[i][2], L::MulAdd(t[1], a[i][1], L::Mul(t[0], a[i][0])));
+        }
+
+        const F zero = L::Set(0.0f);
+        M separated = L::False();
+        F minPen = L::Set(FLT_MAX);
+        F minAxis = zero;
+
+        auto consider = [&](F overlap, M valid, float axisIndex)
+        {
+            separated = L::Or(separated, L::And(valid, L::Less(overlap, zero)));
+            M better = L::And(valid, L::Less(overlap, minPen));
+            minPen = L::Select(better, overlap, minPen);
+            minAxis = L::Select(better, L::Set(axisIndex), minAxis);
+        };
+
+        // axes of A
+        for (int i = 0; i < 3; ++i)
+        {
+            F rb = L::MulAdd(hB[2], absR[i][2], L::MulAdd(hB[1], absR[i][1], L::Mul(hB[0], absR[i][0])));
+            F overlap = L::Sub(L::Add(hA[i], rb), L::Abs(tA[i]));
+            consider(overlap, L::True(), (float)i);
+        }
+
+        // axes of B
+        for (int j = 0; j < 3; ++j)
+        {
+            F ra = L::MulAdd(hA[2], absR[2][j], L::MulAdd(hA[1], absR[1][j], L::Mul(hA[0], absR[0][j])));
+            F dist = L::Abs(L::MulAdd(tA[2], R[2][j], L::MulAdd(tA[1], R[1][j], L::Mul(tA[0], R[0][j]))));
+            F overlap = L::Sub(L::Add(ra, hB[j]), dist);
+            consider(overlap, L::True(), (float)(3 + j));
+        }
+
+        // every lane already separated by a face axis : skip the 9 edge axes
+        if (L::MoveMask(separated) != PulseEngine::Simd::AllLanesMask<L>())
+        {
+            const F one = L::Set(1.0f);
+            const F minLengthSq = L::Set(CROSS_AXIS_MIN_LENGTH * CROSS_AXIS_MIN_LENGTH);
+            for (int i = 0; i < 3; ++i)
+            {
+                const int i1 = (i + 1) % 3, i2 = (i + 2) % 3;
+                for (int j = 0; j < 3; ++j)
+                {
+                    const int j1 = (j + 1) % 3, j2 = (j + 2) % 3;
+
+                    // |A[i] x B[j]|^2 = 1 - dot(A[i], B[j])^2 for unit axes
+                    F lengthSq = L::Sub(one, L::Mul(R[i][j], R[i][j]));
+                    M valid = L::Less(minLengthSq, lengthSq);
+                    F length = L::Sqrt(L::Max(lengthSq, minLengthSq));
+
+                    F ra = L::MulAdd(hA[i1], absR[i2][j], L::Mul(hA[i2], absR[i1][j]));
+                    F rb = L::MulAdd(hB[j1], absR[i][j2], L::Mul(hB[j2], absR[i][j1]));
+                    F dist = L::Abs(L::Sub(L::Mul(tA[i2], R[i1][j]), L::Mul(tA[i1], R[i2][j])));
+                    F overlap = L::Div(L::Sub(L::Add(ra, rb), dist), length);
+                    consider(overlap, valid, (float)(6 + i * 3 + j));
+                }
+            }
+        }
+
+        L::Store(outDepth, minPen);
+        L::Store(outAxis, minAxis);
+        return L::MoveMask(separated);
+    }
+
+    Vector3 AxisOf(const OBBArray& boxes, uint32_t box, int i)
+    {
+        return Vector3(boxes.axis[i][0][box], boxes.axis[i][1][box], boxes.axis[i][2][box]);
+    }
+
+    /**
+     * @brief Rebuild the world axis from its index, and orient it from A toward B.
+     */
+    Vector3 ResolveAxis(const OBBArray& boxes, const OBBPair& pair, int axisIndex)
+    {
+        Vector3 axis;
+        if (axisIndex < 3) axis = AxisOf(boxes, pair.a, axisIndex);
+        else if (axisIndex < 6) axis = AxisOf(boxes, pair.b, axisIndex - 3);
+        else
+        {
+            int i = (axisIndex - 6) / 3;
+            int j = (axisIndex - 6) % 3;
+            axis = AxisOf(boxes, pair.a, i).Cross(AxisOf(boxes, pair.b, j));
+            float length = axis.GetMagnitude();
+            if (length > 1e-6f) axis = axis / length;
+        }
+
+        Vector3 t(boxes.centerX[pair.b] - boxes.centerX[pair.a],
+                  boxes.centerY[pair.b] - boxes.centerY[pair.a],
+                  boxes.centerZ[pair.b] - boxes.centerZ[pair.a]);
+        if (axis.Dot(t) < 0.0f) axis = axis * -1.0f;
+        return axis;
+    }
+
+    template <typename L>
+    void TestPairs(const OBBArray& boxes, const OBBPair* pairs, std::size_t count, OBBContact* outContacts)
+    {
+        constexpr int W = L::Width;
+        uint32_t ia[W], ib[W];
+        float depth[W], axis[W];
+
+        for (std::size_t base = 0; base < count; base += W)
+        {
+            const int active = (int)std::min<std::size_t>(W, count - base);
+            for (int lane = 0; lane < W; ++lane)
+            {
+                // the tail repeats the last pair, its lanes are computed but not written
+                const OBBPair& pair = pairs[base + std::min(lane, active - 1)];
+                ia[lane] = pair.a;
+                ib[lane] = pair.b;
+            }
+
+            int separatedMask = TestLanes<L>(boxes, ia, ib, depth, axis);
+
+            for (int lane = 0; lane < active; ++lane)
+            {
+                OBBContact& out = outContacts[base + lane];
+                out.intersect = (separatedMask & (1 << lane)) == 0;
+                out.axisIndex = (uint8_t)axis[lane];
+                out.depth = out.intersect ? depth[lane] : 0.0f;
+                out.axis = out.intersect ? ResolveAxis(boxes, pairs[base + lane], out.axisIndex) : Vector3(0.0f);
+            }
+        }
+    }
+}
+
+uint32_t OBBArray::Add(const Vector3& center, const Vector3& halfExtents, const Vector3 axes[3])
+{
+    centerX.push_back(center.x);
+    centerY.push_back(center.y);
+    centerZ.push_back(center.z);
+    halfX.push_back(halfExtents.x);
+    halfY.push_back(halfExtents.y);
+    halfZ.push_back(halfExtents.z);
+    for (int i = 0; i < 3; ++i)
+    {
+        axis[i][0].push_back(axes[i].x);
+        axis[i][1].push_back(axes[i].y);
+        axis[i][2].push_back(axes[i].z);
+    }
+    return (uint32_t)(centerX.size() - 1);
+}
+
+void OBBArray::Clear()
+{
+    centerX.clear(); centerY.clear(); centerZ.clear();
+    halfX.clear(); halfY.clear(); halfZ.clear();
+    for (auto& row : axis)
+        for (auto& component : row)
+            component.clear();
+}
+
+void OBBArray::Reserve(std::size_t count)
+{
+    centerX.reserve(count); centerY.reserve(count); centerZ.reserve(count);
+    halfX.reserve(count); halfY.reserve(count); halfZ.reserve(count);
+    for (auto& row : axis)
+        for (auto& component : row)
+            component.reserve(count);
+}
+
+void PulseEngine::Physics::FindOBBCandidatePairs(const OBBArray& boxes, std::vector<OBBPair>& outPairs)
+{
+    outPairs.clear();
+    const std::size_t count = boxes.Size();
+
+    struct SweepEntry
+    {
+        float minX;
+        uint32_t box;
+    };
+    static thread_local std::vector<SweepEntry> sweep;
+    static thread_local std::vector<float> radius;
+    sweep.resize(count);
+    radius.resize(count);
+
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        radius[i] = std::sqrt(boxes.halfX[i] * boxes.halfX[i] + boxes.halfY[i] * boxes.halfY[i] + boxes.halfZ[i] * boxes.halfZ[i]);
+        sweep[i] = { boxes.centerX[i] - radius[i], (uint32_t)i };
+    }
+    std::sort(sweep.begin(), sweep.end(), [](const SweepEntry& l, const SweepEntry& r) { return l.minX < r.minX; });
+
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        const uint32_t a = sweep[i].box;
+        const float maxX = boxes.centerX[a] + radius[a];
+        for (std::size_t j = i + 1; j < count && sweep[j].minX <= maxX; ++j)
+        {
+            const uint32_t b = sweep[j].box;
+            const float dx = boxes.centerX[b] - boxes.centerX[a];
+            const float dy = boxes.centerY[b] - boxes.centerY[a];
+            const float dz = boxes.centerZ[b] - boxes.centerZ[a];
+            const float reach = radius[a] + radius[b];
+            if (dx * dx + dy * dy + dz * dz > reach * reach) continue;
+            outPairs.push_back(a < b ? OBBPair{ a, b } : OBBPair{ b, a });
+        }
+    }
+}
+
+void PulseEngine::Physics::TestOBBPairs(const OBBArray& boxes, const OBBPair* pairs, std::size_t count, OBBContact* outContacts)
+{
+    // a lone pair (BoxCollider::SAT_MinimumTranslation) doesn't fill a register, stay scalar
+    if (count < (std::size_t)PulseEngine::Simd::WideLanes::Width)
+    {
+        TestPairs<PulseEngine::Simd::ScalarLanes>(boxes, pairs, count, outContacts);
+        return;
+    }
+    TestPairs<PulseEngine::Simd::WideLanes>(boxes, pairs, count, outContacts);
+}
+
+void PulseEngine::Physics::TestOBBPairsScalar(const OBBArray& boxes, const OBBPair* pairs, std::size_t count, OBBContact* outContacts)
+{
+    TestPairs<PulseEngine::Simd::ScalarLanes>(boxes, pairs, count, outContacts);
+}
+
+const char* PulseEngine::Physics::GetOBBKernelName()
+{
+    return PulseEngine::Simd::WideLanes::Name;
+}
@@ -0,0 +1,87 @@
+/**
+ * @file OBBBatch.h
+ * @brief Data-oriented OBB vs OBB narrowphase (separating axis theorem on the 15 axes).
+ * @details Boxes are stored once per frame in structure-of-arrays form (center, half extents, 3 world axes),
+ * then candidate pairs are tested 4 or 8 at a time with the widest SIMD lanes available (see SimdLanes.h).
+ * A caller with many boxes fills one array, FindOBBCandidatePairs keeps the pairs whose bounding spheres overlap,
+ * and TestOBBPairs runs them all. The scene has no such caller : gameplay contacts come from the PhysicManager, and
+ * BoxCollider::SAT_MinimumTranslation tests a single pair (one lane only).
+ * Benchmarks/OBBBatchBench.cpp compares both paths with the per-pair SAT BoxCollider had before, results and timing.
+ * @version 0.1
+ * @date 2025-12-04
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+#ifndef OBBBATCH_H
+#define OBBBATCH_H
+
+#include "Common/dllExport.h"
+#include "PulseEngine/core/Math/Vector.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace PulseEngine::Physics
+{
+    /**
+     * @brief Oriented boxes in structure-of-arrays layout, filled once per frame.
+     */
+    struct PULSE_ENGINE_DLL_API OBBArray
+    {
+        std::vector<float> centerX, centerY, centerZ;
+        std::vector<float> halfX, halfY, halfZ;
+        std::vector<float> axis[3][3];  ///< axis[i][c] : component c of the local axis i, in world space
+
+        /**
+         * @brief Add a box and return its index.
+         * @param axes the three local axes of the box in world space, unit length.
+         */
+        uint32_t Add(const Vector3& center, const Vector3& halfExtents, const Vector3 axes[3]);
+        void Clear();
+        void Reserve(std::size_t count);
+        std::size_t Size() const { return centerX.size(); }
+    };
+
+    struct OBBPair
+    {
+        uint32_t a;
+        uint32_t b;
+    };
+
+    /**
+     * @brief Result of one pair test.
+     * @note axisIndex : 0-2 axes of A, 3-5 axes of B, 6-14 cross product A[i] x B[j] with index 6 + i * 3 + j.
+     */
+    struct OBBContact
+    {
+        bool intersect = false;
+        uint8_t axisIndex = 0;
+        Vector3 axis;           ///< minimum translation axis, unit length, oriented from A toward B
+        float depth = 0.0f;     ///< penetration along axis
+    };
+
+    /**
+     * @brief Broadphase for TestOBBPairs : every pair of boxes whose bounding spheres overlap, a < b.
+     * @param outPairs cleared then filled, sorted along x (sweep and prune on the spheres)
+     */
+    PULSE_ENGINE_DLL_API void FindOBBCandidatePairs(const OBBArray& boxes, std::vector<OBBPair>& outPairs);
+
+    /**
+     * @brief Test every pair and write one result per pair into outContacts (same order).
+     */
+    PULSE_ENGINE_DLL_API void TestOBBPairs(const OBBArray& boxes, const OBBPair* pairs, std::size_t count, OBBContact* outContacts);
+
+    /**
+     * @brief Same as TestOBBPairs, but always with the one-lane code (reference for the SIMD path and for benchmarks).
+     */
+    PULSE_ENGINE_DLL_API void TestOBBPairsScalar(const OBBArray& boxes, const OBBPair* pairs, std::size_t count, OBBContact* outContacts);
+
+    /**
+     * @brief Name of the instruction set used by TestOBBPairs ("AVX", "SSE" or "Scalar").
+     */
+    PULSE_ENGINE_DLL_API const char* GetOBBKernelName();
+}
+
+#endif // OBBBATCH_H
@@ -18,6 +18,7 @@ class Collider;
 
 /**
  * @brief For an easy to use backend, the CollisionManager is a static class that manages the collision between two colliders. With that, the "update" method of the engine will not manage collision directly.
+ * @note legacy CPU path : the scene update doesn't call it anymore, gameplay contacts come from the PhysicManager contact events.
  * 
  */
 class CollisionManager
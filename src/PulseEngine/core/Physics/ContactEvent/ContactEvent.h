@@ -0,0 +1,47 @@
+/**
+ * @file ContactEvent.h
+ * @brief Contact notifications produced by the physic step and dispatched to entities, scripts and API subscribers.
+ * @version 0.1
+ * @date 2025-12-02
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+#ifndef __CONTACTEVENT_H__
+#define __CONTACTEVENT_H__
+
+#include <cstdint>
+#include <functional>
+#include "PulseEngine/core/Math/Vector.h"
+
+class Entity;
+
+/**
+ * @brief Phase of a contact between two bodies, as reported by the physic system.
+ */
+enum class ContactEventType : uint8_t
+{
+    BEGIN,      ///< the bodies started touching during this step
+    PERSIST,    ///< the bodies were already touching during the previous step
+    END         ///< the bodies stopped touching during this step
+};
+
+/**
+ * @brief A contact seen from one entity : "self" touches "other".
+ * @note normal points from self toward other.
+ * @note on END events the bodies may already be gone, so normal, point and depth are left to zero.
+ */
+struct ContactEvent
+{
+    ContactEventType type = ContactEventType::BEGIN;
+    Entity* self = nullptr;
+    Entity* other = nullptr;
+    PulseEngine::Vector3 normal;
+    PulseEngine::Vector3 point;
+    float depth = 0.0f;
+};
+
+using ContactCallback = std::function<void(const ContactEvent&)>;
+using ContactSubscriptionId = std::size_t;
+
+#endif // __CONTACTEVENT_H__
@@ -0,0 +1,71 @@
+#include "ContactEventStream.h"
+
+#include <algorithm>
+
+ContactEventStream::ContactEventStream(uint32_t capacity)
+    : events(capacity)
+{
+}
+
+void ContactEventStream::OnContactAdded(const JPH::Body& inBody1, const JPH::Body& inBody2, const JPH::ContactManifold& inManifold, JPH::ContactSettings& ioSettings)
+{
+    Record(inBody1, inBody2, inManifold, ContactEventType::BEGIN);
+}
+
+void ContactEventStream::OnContactPersisted(const JPH::Body& inBody1, const JPH::Body& inBody2, const JPH::ContactManifold& inManifold, JPH::ContactSettings& ioSettings)
+{
+    Record(inBody1, inBody2, inManifold, ContactEventType::PERSIST);
+}
+
+void ContactEventStream::OnContactRemoved(const JPH::SubShapeIDPair& inSubShapePair)
+{
+    // the bodies can already be destroyed here, only their ids are safe to read
+    RawContactEvent event;
+    event.body1 = inSubShapePair.GetBody1ID();
+    event.body2 = inSubShapePair.GetBody2ID();
+    event.type = ContactEventType::END;
+    Push(event);
+}
+
+uint32_t ContactEventStream::GetEventCount() const
+{
+    return std::min<uint32_t>(count.load(std::memory_order_acquire), static_cast<uint32_t>(events.size()));
+}
+
+void ContactEventStream::Reset()
+{
+    count.store(0, std::memory_order_relaxed);
+    dropped.store(0, std::memory_order_relaxed);
+}
+
+void ContactEventStream::Record(const JPH::Body& inBody1, const JPH::Body& inBody2, const JPH::ContactManifold& inManifold, ContactEventType type)
+{
+    RawContactEvent event;
+    event.body1 = inBody1.GetID();
+    event.body2 = inBody2.GetID();
+    event.type = type;
+
+    JPH::Vec3 normal = inManifold.mWorldSpaceNormal;
+    event.normal = PulseEngine::Vector3(normal.GetX(), normal.GetY(), normal.GetZ());
+    event.depth = inManifold.mPenetrationDepth;
+
+    if (!inManifold.mRelativeContactPointsOn1.empty())
+    {
+        JPH::RVec3 point = inManifold.GetWorldSpaceContactPointOn1(0);
+        event.point = PulseEngine::Vector3((float)point.GetX(), (float)point.GetY(), (float)point.GetZ());
+    }
+
+    Push(event);
+}
+
+void ContactEventStream::Push(const RawContactEvent& event)
+{
+    // one atomic increment reserves the slot, every worker writes in its own slot
+    uint32_t slot = count.fetch_add(1, std::memory_order_relaxed);
+    if (slot >= events.size())
+    {
+        dropped.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    events[slot] = event;
+}
@@ -0,0 +1,79 @@
+/**
+ * @file ContactEventStream.h
+ * @brief Jolt contact listener that records begin/persist/end contacts into a per-step buffer.
+ * @details Jolt calls the listener from its worker threads while PhysicsSystem::Update runs.
+ * Each callback reserves a slot with a single atomic increment and writes its event there, so no lock is taken on the hot path.
+ * The buffer is read back on the main thread once the step is over, then reset for the next one.
+ * @version 0.1
+ * @date 2025-12-02
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+#ifndef __CONTACTEVENTSTREAM_H__
+#define __CONTACTEVENTSTREAM_H__
+
+#include <Jolt/Jolt.h>
+#include <Jolt/Physics/Body/Body.h>
+#include <Jolt/Physics/Collision/ContactListener.h>
+
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+#include "PulseEngine/core/Physics/ContactEvent/ContactEvent.h"
+
+/**
+ * @brief Contact as recorded on the worker thread, before the bodies are resolved to entities.
+ */
+struct RawContactEvent
+{
+    JPH::BodyID body1;
+    JPH::BodyID body2;
+    ContactEventType type = ContactEventType::BEGIN;
+    PulseEngine::Vector3 normal;    ///< from body1 toward body2
+    PulseEngine::Vector3 point;     ///< world space, on body1
+    float depth = 0.0f;
+};
+
+class ContactEventStream : public JPH::ContactListener
+{
+public:
+    /**
+     * @param capacity maximum amount of contacts recorded during one step, the extra ones are dropped and counted.
+     */
+    explicit ContactEventStream(uint32_t capacity = 4096);
+
+    // === JPH::ContactListener, called from the physic worker threads ===
+    void OnContactAdded(const JPH::Body& inBody1, const JPH::Body& inBody2, const JPH::ContactManifold& inManifold, JPH::ContactSettings& ioSettings) override;
+    void OnContactPersisted(const JPH::Body& inBody1, const JPH::Body& inBody2, const JPH::ContactManifold& inManifold, JPH::ContactSettings& ioSettings) override;
+    void OnContactRemoved(const JPH::SubShapeIDPair& inSubShapePair) override;
+
+    // === main thread only, outside of PhysicsSystem::Update ===
+
+    /**
+     * @brief Amount of events recorded during the last step (clamped to the capacity).
+     */
+    uint32_t GetEventCount() const;
+    const RawContactEvent& GetEvent(uint32_t index) const { return events[index]; }
+
+    /**
+     * @brief Amount of events that didn't fit in the buffer during the last step.
+     */
+    uint32_t GetDroppedCount() const { return dropped.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Reset the buffer before the next step.
+     */
+    void Reset();
+
+private:
+    void Record(const JPH::Body& inBody1, const JPH::Body& inBody2, const JPH::ContactManifold& inManifold, ContactEventType type);
+    void Push(const RawContactEvent& event);
+
+    std::vector<RawContactEvent> events;
+    std::atomic<uint32_t> count {0};
+    std::atomic<uint32_t> dropped {0};
+};
+
+#endif // __CONTACTEVENTSTREAM_H__
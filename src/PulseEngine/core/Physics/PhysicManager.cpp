@@ -1,4 +1,9 @@
 #include "PhysicManager.h"
+#include "PulseEngine/core/Entity/Entity.h"
+#include "PulseEngine/core/Physics/Collider/BoxCollider.h"
+#include "PulseEngine/CustomScripts/IScripts.h"
+#include "PulseEngine/core/PulseScript/PulseScriptsManager.h"
+#include "PulseEngine/core/PulseScript/utilities.h"
 
 using namespace JPH;
 
@@ -80,6 +85,7 @@ void PhysicManager::InitializePhysicSystem()
     );
 
     bodyInterface = &physicsSystem.GetBodyInterface();
+    physicsSystem.SetContactListener(&contactStream);
 }
 
 // ================================================
@@ -87,7 +93,9 @@ void PhysicManager::InitializePhysicSystem()
 // ================================================
 void PhysicManager::UpdatePhysicSystem(float dt)
 {
+    contactStream.Reset();
     physicsSystem.Update(1/60.0f, 1, tempAllocator.get(), jobSystem.get());
+    DispatchContactEvents();
 
     // Exécuter toutes les commandes thread-safe après la simulation
     std::queue<std::unique_ptr<PhysicsCommand>> commandsCopy;
@@ -176,6 +184,15 @@ BodyID PhysicManager::CreateSphere(const Vec3& pos, float radius, bool dynamic)
     return body->GetID();
 }
 
+void PhysicManager::DestroyBody(BodyID id)
+{
+    if (id.IsInvalid()) return;
+
+    UnregisterBodyOwner(id);
+    bodyInterface->RemoveBody(id);
+    bodyInterface->DestroyBody(id);
+}
+
 // ================================================
 // GET POSITION / ROTATION
 // ================================================
@@ -418,3 +435,138 @@ void PhysicManager::EnqueueCommand(std::unique_ptr<PhysicsCommand> cmd)
     std::lock_guard<std::mutex> lock(commandQueueMutex);
     commandQueue.push(std::move(cmd));
 }
+
+// ================================================
+// CONTACT EVENTS
+// ================================================
+void PhysicManager::RegisterBodyOwner(JPH::BodyID id, Entity* owner)
+{
+    if (id.IsInvalid()) return;
+    bodyOwners[id.GetIndexAndSequenceNumber()] = owner;
+}
+
+void PhysicManager::UnregisterBodyOwner(JPH::BodyID id)
+{
+    auto it = bodyOwners.find(id.GetIndexAndSequenceNumber());
+    if (it == bodyOwners.end()) return;
+
+    if (dispatchingContacts) unregisteredDuringDispatch.insert(it->second);
+    else contactsByEntity.erase(it->second);
+    bodyOwners.erase(it);
+}
+
+Entity* PhysicManager::GetBodyOwner(JPH::BodyID id) const
+{
+    auto it = bodyOwners.find(id.GetIndexAndSequenceNumber());
+    return it != bodyOwners.end() ? it->second : nullptr;
+}
+
+ContactSubscriptionId PhysicManager::SubscribeContacts(ContactCallback callback, Entity* filter)
+{
+    ContactSubscriptionId id = nextSubscriptionId++;
+    contactSubscriptions.push_back({id, filter, std::move(callback)});
+    return id;
+}
+
+void PhysicManager::UnsubscribeContacts(ContactSubscriptionId id)
+{
+    contactSubscriptions.erase(
+        std::remove_if(contactSubscriptions.begin(), contactSubscriptions.end(),
+            [id](const ContactSubscription& sub) { return sub.id == id; }),
+        contactSubscriptions.end());
+}
+
+const std::vector<ContactEvent>& PhysicManager::GetContactEvents(Entity* entity) const
+{
+    static const std::vector<ContactEvent> noContact;
+    auto it = contactsByEntity.find(entity);
+    return it != contactsByEntity.end() ? it->second : noContact;
+}
+
+void PhysicManager::DispatchContactEvents()
+{
+    // keep the vectors allocated from one step to the other, only empty them
+    for (auto& [entity, events] : contactsByEntity)
+    {
+        events.clear();
+        if (entity->collider) entity->collider->othersCollider.clear();
+    }
+
+    if (contactStream.GetDroppedCount() > 0)
+    {
+        EDITOR_WARN(contactStream.GetDroppedCount() << " contact events dropped, the contact buffer is full.");
+    }
+
+    uint32_t eventCount = contactStream.GetEventCount();
+    for (uint32_t i = 0; i < eventCount; ++i)
+    {
+        const RawContactEvent& raw = contactStream.GetEvent(i);
+        Entity* entityA = GetBodyOwner(raw.body1);
+        Entity* entityB = GetBodyOwner(raw.body2);
+        if (!entityA || !entityB) continue;
+
+        ContactEvent eventA;
+        eventA.type = raw.type;
+        eventA.self = entityA;
+        eventA.other = entityB;
+        eventA.normal = raw.normal;
+        eventA.point = raw.point;
+        eventA.depth = raw.depth;
+
+        ContactEvent eventB = eventA;
+        eventB.self = entityB;
+        eventB.other = entityA;
+        eventB.normal = raw.normal * -1.0f;
+
+        contactsByEntity[entityA].push_back(eventA);
+        contactsByEntity[entityB].push_back(eventB);
+    }
+
+    // a callback can unsubscribe itself, so iterate on a copy
+    std::vector<ContactSubscription> subscriptions = contactSubscriptions;
+
+    // a callback can destroy an entity : it stays in contactsByEntity until the end of the dispatch, and its events
+    // (as self or other) are skipped from then on
+    dispatchingContacts = true;
+    auto destroyed = [this](Entity* entity) { return unregisteredDuringDispatch.count(entity) != 0; };
+
+    for (auto& [entity, events] : contactsByEntity)
+    {
+        for (const ContactEvent& event : events)
+        {
+            if (destroyed(entity) || destroyed(event.other)) continue;
+
+            // legacy collider list, still read by BoxCollider and the editor display
+            if (event.type != ContactEventType::END && entity->collider && event.other->collider)
+                entity->collider->othersCollider.push_back(event.other->collider);
+
+            for (IScript* script : entity->GetScripts())
+                script->OnContact(event);
+
+            if (entity->runtimeScripts)
+            {
+                const char* methodName = event.type == ContactEventType::BEGIN ? "OnContactBegin"
+                                       : event.type == ContactEventType::PERSIST ? "OnContactPersist"
+                                       : "OnContactEnd";
+                std::vector<Variable> args;
+                Variable other;
+                other.isGlobal = false;
+                other.name = "other";
+                other.value = event.other->GetName();
+                args.push_back(other);
+                entity->runtimeScripts->ExecuteMethodOnEachScriptIfDefined(methodName, args);
+            }
+
+            for (const ContactSubscription& sub : subscriptions)
+            {
+                if (sub.filter && sub.filter != entity) continue;
+                if (destroyed(entity) || destroyed(event.other)) break;
+                sub.callback(event);
+            }
+        }
+    }
+
+    dispatchingContacts = false;
+    for (Entity* entity : unregisteredDuringDispatch) contactsByEntity.erase(entity);
+    unregisteredDuringDispatch.clear();
+}
@@ -19,12 +19,20 @@
 #include "Common/dllExport.h"
 
 #include <thread>
+#include <algorithm>
 #include <cassert>
 #include <mutex>
 #include <queue>
 #include <memory>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
 
 #include "PulseEngine/core/Physics/PhysicCommand/PhysicsCommand.h"
+#include "PulseEngine/core/Physics/ContactEvent/ContactEvent.h"
+#include "PulseEngine/core/Physics/ContactEvent/ContactEventStream.h"
+
+class Entity;
 
 
 
@@ -41,6 +49,11 @@ public:
     // === API moteur ===
     JPH::BodyID CreateBox(const JPH::Vec3& pos, const JPH::Vec3& halfExtents, bool dynamic);
     JPH::BodyID CreateSphere(const JPH::Vec3& pos, float radius, bool dynamic);
+
+    /**
+     * @brief Remove a body from the simulation and free it, its owner is unregistered too.
+     */
+    void DestroyBody(JPH::BodyID id);
     
     JPH::Vec3 GetBodyPosition(JPH::BodyID id);
     JPH::Quat GetBodyRotation(JPH::BodyID id);
@@ -59,6 +72,28 @@ public:
     bool SetAngularVelocityEuler(JPH::BodyID id, const JPH::Vec3& eulerDegrees);
     bool SetAngularVelocityFromVectors(JPH::BodyID id, const JPH::Vec3& start, const JPH::Vec3& end, float factor = 1.0f);
 
+    // === contact events ===
+
+    /**
+     * @brief Link a body to the entity that owns it, so its contacts can be reported to that entity.
+     */
+    void RegisterBodyOwner(JPH::BodyID id, Entity* owner);
+    void UnregisterBodyOwner(JPH::BodyID id);
+
+    /**
+     * @brief Subscribe to the contact events of the last physic step.
+     * @param callback called on the main thread, once per event, after the step.
+     * @param filter if not null, only the events where filter is "self" are received.
+     * @return the id to give to UnsubscribeContacts.
+     */
+    ContactSubscriptionId SubscribeContacts(ContactCallback callback, Entity* filter = nullptr);
+    void UnsubscribeContacts(ContactSubscriptionId id);
+
+    /**
+     * @brief All the contact events of the last physic step where entity is "self".
+     */
+    const std::vector<ContactEvent>& GetContactEvents(Entity* entity) const;
+
 
 private:
     static const JPH::ObjectLayer NON_MOVING = 0;
@@ -74,6 +109,29 @@ private:
     
     std::mutex commandQueueMutex;
     std::queue<std::unique_ptr<PhysicsCommand>> commandQueue;
+
+    struct ContactSubscription
+    {
+        ContactSubscriptionId id;
+        Entity* filter;
+        ContactCallback callback;
+    };
+
+    /**
+     * @brief Resolve the raw events of the step to entities, then notify colliders, scripts and subscribers.
+     */
+    void DispatchContactEvents();
+    Entity* GetBodyOwner(JPH::BodyID id) const;
+
+    ContactEventStream contactStream;
+    std::unordered_map<JPH::uint32, Entity*> bodyOwners;
+    std::unordered_map<Entity*, std::vector<ContactEvent>> contactsByEntity;
+    std::vector<ContactSubscription> contactSubscriptions;
+
+    // a callback can destroy an entity while contactsByEntity is iterated : forgotten after the dispatch
+    bool dispatchingContacts = false;
+    std::unordered_set<Entity*> unregisteredDuringDispatch;
+    ContactSubscriptionId nextSubscriptionId = 1;
 };
 
 #endif
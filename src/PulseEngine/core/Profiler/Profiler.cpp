@@ -4,6 +4,15 @@
 #include "json.hpp"
 #include "Profiler.h"
 
+#include <processthreadsapi.h>
+#include <mutex>
+
+namespace
+{
+    // the simulation thread and the pool workers trace too
+    std::mutex traceMutex;
+}
+
 std::vector<TraceEvent*> Profiler::traceEvents;
 std::chrono::steady_clock::time_point Profiler::startTime = std::chrono::steady_clock::now();
 
@@ -16,9 +25,21 @@ Profiler& Profiler::GetInstance()
 
 void Profiler::AddTrace(TraceEvent* trace)
 {
+    std::lock_guard<std::mutex> lock(traceMutex);
     traceEvents.push_back(trace);
 }
 
+void Profiler::AddCounter(const std::string& name, const std::vector<std::pair<std::string, double>>& values)
+{
+    using namespace std::chrono;
+    const auto nowUs = duration_cast<microseconds>(steady_clock::now() - startTime).count();
+
+    // same ids as ProfileTimer so the counters sit next to the timers
+    TraceEvent* counter = new TraceEvent(name, "C", nowUs, GetCurrentProcessId(), GetCurrentThreadId());
+    counter->args = values;
+    AddTrace(counter);
+}
+
 Profiler::~Profiler()
 {
     SaveToJson();
@@ -39,6 +60,8 @@ void Profiler::SaveToJson()
         traceJson["ts"] = trace->timeStamp;
         traceJson["tid"] = trace->tid;
         traceJson["pid"] = trace->pid;
+        for (const auto& [key, value] : trace->args)
+            traceJson["args"][key] = value;
         outJson["traceEvents"].push_back(traceJson);
     }
 
@@ -22,6 +22,11 @@ public:
 
 	void AddTrace(TraceEvent* trace);
 
+	/**
+	 * @brief Record the values of a counter at the current time (one graph per name in the trace viewer).
+	 */
+	void AddCounter(const std::string& name, const std::vector<std::pair<std::string, double>>& values);
+
 	Profiler(const Profiler& p) = delete;
 	void operator=(const Profiler& p) = delete;
 	static void SaveToJson();
@@ -2,6 +2,8 @@
 #define TRACEEVENT_H
 
 #include <string>
+#include <utility>
+#include <vector>
 #include "common/common.h"
 #include "common/dllExport.h"
 struct PULSE_ENGINE_DLL_API TraceEvent
@@ -11,6 +13,7 @@ struct PULSE_ENGINE_DLL_API TraceEvent
 	int timeStamp;
 	int tid;
 	int pid;
+	std::vector<std::pair<std::string, double>> args;	///< values of a counter event ("C")
 
 	TraceEvent(std::string n, std::string p, int ts, int t, int pi)
 	{
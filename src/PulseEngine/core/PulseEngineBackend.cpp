@@ -8,8 +8,10 @@
 #include <fstream>
 #include "PulseEngine/core/Meshes/primitive/Primitive.h"
 #include "PulseEngine/core/Material/MaterialManager.h"
+#include "PulseEngine/core/Material/TextureManager.h"
 #include "PulseEngine/core/GUID/GuidReader.h"
 #include "PulseEngine/core/SceneLoader/SceneLoader.h"
+#include "PulseEngine/core/SceneLoader/WorldStreaming/WorldStreamer.h"
 #include "PulseEngine/core/Lights/Lights.h"
 #include "PulseEngine/core/FileManager/FileManager.h"
 #include "PulseEngine/core/Lights/DirectionalLight/DirectionalLight.h"
@@ -17,9 +19,11 @@
 #include "PulseEngine/CustomScripts/ScriptsLoader.h"
 #include "PulseEngine/core/WindowContext/WindowContext.h"
 #include "PulseEngine/core/Graphics/IGraphicsApi.h"
+#include "PulseEngine/core/Graphics/DebugDraw/DebugDraw.h"
 #include "PulseEngine/core/Physics/Collider/Collider.h"
 #include "PulseEngine/core/Physics/Collider/BoxCollider.h"
 #include "PulseEngine/core/Lights/LightManager.h"
+#include "PulseEngine/core/Lights/ShadowCache/ShadowCasterCache.h"
 #include "PulseEngine/core/Physics/CollisionManager.h"
 #include "PulseEngine/core/coroutine/CoroutineManager.h"
 #include "PulseEngine/core/coroutine/Coroutine.h"
@@ -38,6 +42,7 @@
 #ifdef PULSE_GRAPHIC_OPENGL
 #include "PulseEngine/core/Graphics/OpenGLAPI/OpenGLApi.h"
 #endif
+#include "PulseEngine/core/Graphics/NullAPI/NullGraphicsApi.h"
 
 #include "PulseEngine/core/PulseObject/TypeRegister/TypeRegister.h"
 #include "PulseEngine/core/SceneManager/SceneManager.h"
@@ -47,7 +52,11 @@
 #include "PulseEngine/core/PulseScript/NativeInit.h"
 #include "PulseEngine/core/FileManager/Archive/Archive.h"
 #include "PulseEngine/core/FileManager/Archive/DiskArchive.h"
+#include "PulseEngine/core/FileManager/Pak/PakManager.h"
 #include "PulseEngine/core/Physics/PhysicManager.h"
+#include "PulseEngine/core/Graphics/RenderSnapshot/RenderSnapshot.h"
+#include "PulseEngine/core/Threading/GraphicsThread.h"
+#include "PulseEngine/core/Threading/SimulationThread.h"
 
 using namespace PulseEngine::FileSystem;
 using namespace PulseLibs;
@@ -78,7 +87,21 @@ int PulseEngineBackend::Initialize()
     windowContext = new WindowContext();
     activeCamera = new Camera();
 
-    graphicsAPI = new OpenGLAPI();
+    // this thread creates the context and keeps it, see GraphicsThread.h
+    PulseEngine::Threading::SetGraphicsThread();
+    renderSnapshots[0] = new RenderSnapshot();
+    renderSnapshots[1] = new RenderSnapshot();
+
+    if (headless)
+    {
+        NullGraphicsSettings settings;
+        settings.frameLimit = headlessFrameLimit;
+        graphicsAPI = new NullGraphicsAPI(settings);
+    }
+    else
+    {
+        graphicsAPI = new OpenGLAPI();
+    }
 
     if(graphicsAPI == nullptr)
     {
@@ -88,7 +111,7 @@ int PulseEngineBackend::Initialize()
     graphicsAPI->InitializeApi(GetWindowName("editor").c_str(), &width, &height);
     
     #ifdef PULSE_GRAPHIC_OPENGL
-    windowContext->SetGLFWWindow(static_cast<GLFWwindow*>(graphicsAPI->GetNativeHandle()));
+    if (!headless) windowContext->SetGLFWWindow(static_cast<GLFWwindow*>(graphicsAPI->GetNativeHandle()));
     #endif
 
 
@@ -101,6 +124,14 @@ int PulseEngineBackend::Initialize()
     pointLightShadowShader = new Shader(std::string(ASSET_PATH) + "EngineConfig/shaders/pointDepth/pointDepth.vert", std::string(ASSET_PATH) + "EngineConfig/shaders/pointDepth/pointDepth.frag", std::string(ASSET_PATH) + "EngineConfig/shaders/pointDepth/pointDepth.glsl", graphicsAPI);
     debugShader = new Shader(std::string(ASSET_PATH) +"EngineConfig/shaders/debug.vert", std::string(ASSET_PATH) + "EngineConfig/shaders/debug.frag", graphicsAPI);
 
+    // game build : assets are read from the pack first, loose files stay as fallback
+    #ifndef ENGINE_EDITOR
+    if (!PakManager::GetInstance().Mount(DEFAULT_PAK_PATH))
+    {
+        EDITOR_WARN("No asset pack found at " + DEFAULT_PAK_PATH + ", reading loose files.");
+    }
+    #endif
+
     // === initialize each collection found in the asset folder ===
     std::vector<std::filesystem::path> guidFiles = FileManager::GetFilesInDirectoryWithExtension(std::string(ASSET_PATH) + "EngineConfig/Guid", ".puid");
     for (const auto& file : guidFiles) 
@@ -136,6 +167,15 @@ int PulseEngineBackend::Initialize()
     else EDITOR_WARN("Gamemode couldn't be loaded from [enginegm.gamemode]")
     InitNativeMethods();
 
+    // the editor tools read and edit the scene between the passes : one thread
+    #ifndef ENGINE_EDITOR
+    if (threadedSimulation)
+    {
+        simulationThread = new PulseEngine::Threading::SimulationThread([this]() { Simulate(); });
+        EDITOR_INFO("Simulation runs on its own thread.");
+    }
+    #endif
+
     EDITOR_INFO("Finished the initialization of the engine.");
     return 0;
 }
@@ -171,13 +211,35 @@ void PulseEngineBackend::PollEvents()
 void PulseEngineBackend::Update()
 {
     PROFILE_TIMER_FUNCTION;
+    // the simulation of the last frame is done (Render waited for it) : the scene belongs to this thread until Kick
     float currentFrame = PulseEngineGraphicsAPI->GetTime();
     inputSystem->newFrame();
     deltaTime = currentFrame - lastFrame;
     lastFrame = currentFrame;
+    mapLoading -= deltaTime;
+
+    // what needs the graphic context
+    PulseEngine::Threading::ProcessGraphicsJobs();
+    TextureManager::GetInstance().ProcessPendingUploads();
+    SceneLoader::ProcessPendingLoads();
+    WorldStreamer::GetInstance().Update(GetActiveCamera()->Position);
+
+    if (simulationThread)
+    {
+        // RenderShadow and Render draw the snapshot of the last frame meanwhile
+        simulationThread->Kick();
+        return;
+    }
+
+    Simulate();
+    SwapRenderSnapshots();
+}
+
+void PulseEngineBackend::Simulate()
+{
+    PROFILE_TIMER_FUNCTION;
     view = GetActiveCamera()->GetViewMatrix();
     projection = PulseEngine::MathUtils::PerspectiveMat(PulseEngine::MathUtils::ToRadians(GetActiveCamera()->Zoom), static_cast<float>(width) / static_cast<float>(height), 0.1f, 1000.0f);
-    mapLoading -= deltaTime;
     for (auto& light : lights) 
     {
         light->RecalculateLightSpaceMatrix();
@@ -197,6 +259,19 @@ void PulseEngineBackend::Update()
 
     gamemode->Update();
     LateUpdate();
+
+    RenderView camera;
+    camera.view = view;
+    camera.projection = projection;
+    camera.position = GetActiveCamera()->Position;
+    camera.width = width;
+    camera.height = height;
+
+    // removed from the scene before this capture : gone from the snapshot, deleted when it comes to the front
+    deletedEntities.MarkCaptured();
+    RenderSnapshot& snapshot = *renderSnapshots[1 - frontSnapshot];
+    SceneManager::GetInstance()->CaptureRenderSnapshot(snapshot, camera);
+    snapshot.frame = ++simulationFrame;
 }
 
 void PulseEngineBackend::LateUpdate()
@@ -211,8 +286,19 @@ void PulseEngineBackend::Render()
     PROFILE_TIMER_FUNCTION;
     graphicsAPI->StartFrame();
 
-    SceneManager::GetInstance()->RenderScene();
+    // frame 0 : the first simulation is still running, nothing to draw yet
+    if (GetRenderSnapshot().frame != 0) SceneManager::GetInstance()->RenderScene(GetRenderSnapshot());
+
+    // the overlays read the live scene : the simulation must be done, and its snapshot is the one they match
+    if (simulationThread)
+    {
+        simulationThread->Wait();
+        SwapRenderSnapshots();
+    }
+    SceneManager::GetInstance()->RenderSceneOverlays(GetRenderSnapshot());
     gamemode->Render();
+    // every debug line of the frame (colliders, casts, scripts) in one or two draws
+    PulseEngine::Graphics::DebugDraw::Flush(GetRenderSnapshot().view.view, GetRenderSnapshot().view.projection);
 
     // for (Entity* entity : entities)
     // {
@@ -242,7 +328,7 @@ void PulseEngineBackend::Render()
 
         // Draw grid quad in editor only
 #ifdef ENGINE_EDITOR
-        DrawGridQuad(view, projection);
+        DrawGridQuad(GetRenderSnapshot().view.view, GetRenderSnapshot().view.projection);
 #endif
 
     graphicsAPI->EndFrame(true);
@@ -283,6 +369,17 @@ void PulseEngineBackend::SpecificRender(Camera *cam, int specificVBO, std::vecto
     copyrightText->RenderText("Pulse Engine-" + version, 0, 25, 25.0f, PulseEngine::Vector3(0.0f, 0.0f, 0.0f));
     copyrightText->Render();
 
+    // editor views : drawn on the scene thread, the snapshot only carries the camera and the lights
+    RenderSnapshot viewSnapshot;
+    RenderView camera;
+    camera.view = specificView;
+    camera.projection = specificProjection;
+    camera.position = cam->Position;
+    camera.width = static_cast<int>(viewportSize.x);
+    camera.height = static_cast<int>(viewportSize.y);
+    viewSnapshot.Capture(camera, {}, {}, lights);
+    LightManager::PrepareView(viewSnapshot);
+
     for (Entity* entity : entitiesToRender)
     {
         if (!IsRenderable(entity)) continue;
@@ -296,17 +393,11 @@ void PulseEngineBackend::SpecificRender(Camera *cam, int specificVBO, std::vecto
         lastView = specificView;
         lastProjection = specificProjection;
 
-        LightManager::BindLightsToShader(shader, this, entity);
+        LightManager::BindLightsToShader(shader, entity->GetMaterial()->color);
 
         if(!specificShader) {
             entity->DrawEntity();
-            if (entity->collider)
-            {
-                entity->collider->lineTraceShader->Use();
-                entity->collider->lineTraceShader->SetMat4("view", specificView);
-                entity->collider->lineTraceShader->SetMat4("projection", specificProjection);
-                entity->collider->OnRender();
-            }
+            if (entity->collider) entity->collider->OnRender();
         }
         else
         {
@@ -321,6 +412,7 @@ void PulseEngineBackend::SpecificRender(Camera *cam, int specificVBO, std::vecto
 #endif
 
     gamemode->Render();
+    PulseEngine::Graphics::DebugDraw::Flush(specificView, specificProjection);
 
     graphicsAPI->EndFrame();
 }
@@ -330,16 +422,36 @@ void PulseEngineBackend::SpecificRender(Camera *cam, int specificVBO, std::vecto
 
 void PulseEngineBackend::RenderShadow()
 {    
-    shadowShader->Use();
-    for (int i = 0; i < lights.size(); ++i)
+    PROFILE_TIMER_FUNCTION;
+
+    // each light only draws its map again when a caster in its range, or the light itself, moved
+    const RenderSnapshot& snapshot = GetRenderSnapshot();
+    if (snapshot.frame == 0) return;
+    ShadowCasterTracker::GetInstance().Update(snapshot);
+
+    for (const RenderLight& params : snapshot.lights)
     {
-        
-        lights[i]->RenderShadowMap(*shadowShader, *this);
+        params.light->RenderShadowMap(*shadowShader, snapshot, params);
     }
+
+    const ShadowFrameStats& stats = ShadowCasterTracker::GetInstance().GetStats();
+    PROFILE_COUNTER("Shadows", {
+        {"lights", (double)stats.lights},
+        {"renderedLights", (double)stats.renderedLights},
+        {"staticRebuilds", (double)stats.staticRebuilds},
+        {"staticCasters", (double)stats.staticCasters},
+        {"dynamicCasters", (double)stats.dynamicCasters},
+        {"culledCasters", (double)stats.culledCasters}
+    });
 }
 
 void PulseEngineBackend::Shutdown()
 {    
+    // waits for the running step
+    delete simulationThread;
+    simulationThread = nullptr;
+    PulseEngine::Threading::ProcessGraphicsJobs();
+
     graphicsAPI->ShutdownApi();
     if(discordLauncher) discordLauncher->Terminate();
 
@@ -348,18 +460,42 @@ void PulseEngineBackend::Shutdown()
 
 void PulseEngineBackend::ClearScene()
 {
-    entities.clear();
+    for (Entity* entity : entities) physicManager->UnregisterBodyOwner(entity->bodyID);
+    for (LightData* light : lights) physicManager->UnregisterBodyOwner(light->bodyID);
+    // an editor light is in both lists, queued once
+    deletedEntities.PushAll(entities);
+    deletedEntities.PushAll(lights);
+    PulseEngine::Graphics::DebugDraw::Clear();
 }
+
 void PulseEngineBackend::DeleteEntity(Entity *entity)
 {
     auto it = std::find(entities.begin(), entities.end(), entity);
     if (it != entities.end())
     {
-        delete *it;
+        physicManager->UnregisterBodyOwner(entity->bodyID);
         entities.erase(it);
+
+        auto lightIt = std::find(lights.begin(), lights.end(), entity);
+        if (lightIt != lights.end()) lights.erase(lightIt);
+
+        // the snapshot being drawn, or the one being captured, can still show it
+        deletedEntities.Push(entity);
     }
 }
 
+void PulseEngineBackend::SwapRenderSnapshots()
+{
+    frontSnapshot = 1 - frontSnapshot;
+
+    // on the graphics thread : the meshes free their buffers right away
+    deletedEntities.Release([](Entity* entity)
+    {
+        entity->ReleaseMeshes();
+        delete entity;
+    });
+}
+
 void PulseEngineBackend::ProcessInput(GLFWwindow* window)
 {
     // if (glfwGetKey(window, GLFW_KEY_W) == GLFW_PRESS) activeCamera->ProcessKeyboard(FORWARD, deltaTime);
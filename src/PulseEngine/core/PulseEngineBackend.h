@@ -15,6 +15,8 @@
 #define PULSEENGINE_H
 
 #include <string>
+#include <cstdint>
+#include <vector>
 // #include "Common/common.h"
 #include "Common/dllExport.h"
 #include "json.hpp"
@@ -22,6 +24,7 @@
 #include "PulseEngine/core/Input/InputSystem.h"
 #include "PulseEngine/core/Math/Vector.h"
 #include "PulseEngine/core/Math/Mat4.h"
+#include "PulseEngine/core/Threading/DeferredDeleteQueue.h"
 
 #define GUID_COLLECTION_PATH std::string(ASSET_PATH) + "EngineConfig/Guid/"
 #define DEFAULT_SHADOW_MAP_RES 2048
@@ -41,9 +44,12 @@ class IGraphicsAPI;
 class Account;
 class PulseScriptsManager;
 class Gamemode;
+class RenderSnapshot;
 
 class PhysicManager;
 
+namespace PulseEngine::Threading { class SimulationThread; }
+
 /**
  * @brief PulseEngineBackend is the main class of the Pulse Engine.
  * 
@@ -74,7 +80,12 @@ public:
     void Shutdown(); 
     // Editor grid quad rendering
     void DrawGridQuad(PulseEngine::Mat4 viewCam,const PulseEngine::Mat4& specificProjection  );
+    /// @brief Remove every entity and light, deleted as DeleteEntity does. The caller cleans the hierarchy.
     void ClearScene();
+    /**
+     * @brief Remove the entity from the scene and its body owner from the physics. It is deleted with its meshes once
+     * no render snapshot can show it : at the swap after the next capture.
+     */
     void DeleteEntity(Entity* entity);
 
     // === getters ===
@@ -106,6 +117,26 @@ public:
     const void SetGameVersion(const std::string& version) { gameVersion = version; }
     const std::string& GetGameVersion() const { return gameVersion; }
 
+    /**
+     * @brief Run without window nor GPU : NullGraphicsAPI records the frames (CPU benchmarks, CI). Before Initialize.
+     * @param frameLimit IsRunning turns false after this many frames, 0 : never.
+     */
+    void SetHeadless(bool enabled, std::uint64_t frameLimit = 0) { headless = enabled; headlessFrameLimit = frameLimit; }
+    bool IsHeadless() const { return headless; }
+
+    /**
+     * @brief Simulate the next frame on its own thread while this one draws the last (game builds, the editor always
+     * runs on one thread). Before Initialize, "--single-thread" on the command line turns it off.
+     * @details Update kicks the simulation, RenderShadow and Render draw the render snapshot of the last frame, Render
+     * waits for the simulation before the overlays (colliders, script callbacks, HUD) and swaps the snapshots. The
+     * main thread keeps the graphic context : what the simulation needs from it is posted with RunOnGraphicsThread.
+     */
+    void SetThreadedSimulation(bool enabled) { threadedSimulation = enabled; }
+    bool IsSimulationThreaded() const { return simulationThread != nullptr; }
+
+    /// @brief The frame drawn by RenderShadow and Render.
+    const RenderSnapshot& GetRenderSnapshot() const { return *renderSnapshots[frontSnapshot]; }
+
     const float GetDeltaTime() {return deltaTime;}
     PulseEngine::Vector3 GetCameraPosition();
     PulseEngine::Vector3 GetCameraRotation();
@@ -149,6 +180,8 @@ private:
 
     static float deltaTime;
     float lastFrame = 0.0f;
+    bool headless = false;
+    std::uint64_t headlessFrameLimit = 0;
     float mapLoading = 0.0f;
 
     static Camera* activeCamera;
@@ -161,6 +194,23 @@ private:
     Account* account;
 
 
+    /**
+     * @brief Camera, scene, scripts and physics of one frame, then the capture of its render snapshot in the back
+     * buffer. On the simulation thread when it runs.
+     */
+    void Simulate();
+    /// @brief The back snapshot comes to the front, then the entities it can't show are deleted.
+    void SwapRenderSnapshots();
+
+    /// @brief Entities and lights removed from the scene : the front snapshot keeps their pointers until the next swap.
+    PulseEngine::Threading::DeferredDeleteQueue<Entity> deletedEntities;
+
+    bool threadedSimulation = false;
+    PulseEngine::Threading::SimulationThread* simulationThread = nullptr;
+    RenderSnapshot* renderSnapshots[2] = {};
+    int frontSnapshot = 0;
+    std::uint64_t simulationFrame = 0;
+
     void ProcessInput(GLFWwindow* window);
     // glm::vec3 CalculateLighting(const glm::vec3& position, const glm::vec3& normal, const glm::vec3& viewPos, const LightData& light);
     bool IsRenderable(Entity* entity) const;
@@ -50,6 +50,18 @@ void PulseScript::ExecuteScriptFunction(const char *functionName, const std::vec
     itp->ExecuteFunction(std::string(functionName), args, ast);
 }
 
+bool PulseScript::HasScriptFunction(const char *functionName) const
+{
+    for (auto& stmt : ast)
+    {
+        if (auto fdef = dynamic_cast<ASTFunctionDef *>(stmt->content.get()))
+        {
+            if (fdef->name == functionName) return true;
+        }
+    }
+    return false;
+}
+
 std::string PulseScript::ReadFileToString(const std::string& filename) 
 {
     std::ifstream file(filename, std::ios::in | std::ios::binary);
@@ -18,6 +18,7 @@ public:
     ~PulseScript();
     void Execute();
     void ExecuteScriptFunction(const char* functionName, const std::vector<Variable> &args);
+    bool HasScriptFunction(const char* functionName) const;
 
 private:
     std::vector<std::unique_ptr<ASTStatement>> ast;
@@ -49,3 +49,14 @@ bool PulseScriptsManager::ExecuteMethodOnEachScript(const char* methodName, std:
 
     return true;
 }
+
+bool PulseScriptsManager::ExecuteMethodOnEachScriptIfDefined(const char* methodName, std::vector<Variable> args)
+{
+    for(auto& script : scripts)
+    {
+        if(!script.second->HasScriptFunction(methodName)) continue;
+        script.second->ExecuteScriptFunction(methodName, args);
+    }
+
+    return true;
+}
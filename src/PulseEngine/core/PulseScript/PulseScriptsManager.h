@@ -19,6 +19,11 @@ public:
 
     bool ExecuteMethodOnEachScript(const char* methodName, std::vector<Variable> args);
 
+    /**
+     * @brief Same as ExecuteMethodOnEachScript, but skip the scripts that don't declare the method (used for optional callbacks).
+     */
+    bool ExecuteMethodOnEachScriptIfDefined(const char* methodName, std::vector<Variable> args);
+
 private:
     std::unordered_map<std::string, PulseScript*> scripts; // name -> script
 };
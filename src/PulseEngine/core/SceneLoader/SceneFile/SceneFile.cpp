@@ -0,0 +1,373 @@
+#include "SceneFile.h"
+#include "Common/common.h"
+#include "PulseEngine/core/FileManager/FileReader/FileReader.h"
+
+#include <cstring>
+#include <limits>
+#include <unordered_map>
+
+using namespace PulseEngine::SceneFormat;
+
+namespace
+{
+    /// @brief Smallest entity of a version 0 stream : type, guid, muid, name, transform.
+    constexpr std::size_t LEGACY_MIN_ENTITY_SIZE = 4 + 8 + 8 + 4 + sizeof(SceneTransform);
+
+    struct BinaryWriter
+    {
+        std::vector<char> buffer;
+
+        template <typename T>
+        void Write(const T& value)
+        {
+            const char* bytes = reinterpret_cast<const char*>(&value);
+            buffer.insert(buffer.end(), bytes, bytes + sizeof(T));
+        }
+
+        void WriteBytes(const char* data, std::size_t size)
+        {
+            buffer.insert(buffer.end(), data, data + size);
+        }
+
+        void Align(std::size_t alignment)
+        {
+            buffer.resize((buffer.size() + alignment - 1) / alignment * alignment, 0);
+        }
+    };
+
+    struct BinaryReader
+    {
+        const char* data;
+        std::size_t size;
+        std::size_t cursor = 0;
+        bool failed = false;
+
+        template <typename T>
+        T Read()
+        {
+            T value{};
+            if (!Has(sizeof(T))) return value;
+            std::memcpy(&value, data + cursor, sizeof(T));
+            cursor += sizeof(T);
+            return value;
+        }
+
+        std::string ReadString()
+        {
+            const uint32_t length = Read<uint32_t>();
+            if (!Has(length)) return std::string();
+            std::string value(data + cursor, length);
+            cursor += length;
+            return value;
+        }
+
+        bool Has(std::size_t count)
+        {
+            if (failed || count > size - cursor)
+            {
+                failed = true;
+                return false;
+            }
+            return true;
+        }
+    };
+
+    /**
+     * @brief offset + count * stride fits in a file of size bytes, without overflow.
+     */
+    bool BlockFits(uint64_t offset, uint64_t count, uint64_t stride, std::size_t size)
+    {
+        if (offset > size) return false;
+        if (stride != 0 && count > (size - offset) / stride) return false;
+        return true;
+    }
+
+    bool ReadLegacyEntities(BinaryReader& reader, bool wideGuid, SceneFileDesc& scene)
+    {
+        if (wideGuid) scene.guid = reader.Read<uint64_t>();
+        else scene.guid = (uint64_t)(uint32_t)reader.Read<int32_t>();
+
+        const int32_t entityCount = reader.Read<int32_t>();
+        if (reader.failed || entityCount < 0 || (std::size_t)entityCount > (reader.size - reader.cursor) / LEGACY_MIN_ENTITY_SIZE) return false;
+
+        scene.entities.resize((std::size_t)entityCount);
+        for (SceneEntity& entity : scene.entities)
+        {
+            // header written by SaveSceneToFile, then Entity::Serialize : name and Transform::Serialize
+            entity.typeName = reader.ReadString();
+            entity.guid = reader.Read<uint64_t>();
+            entity.muid = reader.Read<uint64_t>();
+            entity.name = reader.ReadString();
+            for (float& value : entity.transform.position) value = reader.Read<float>();
+            for (float& value : entity.transform.rotation) value = reader.Read<float>();
+            for (float& value : entity.transform.scale) value = reader.Read<float>();
+        }
+        return !reader.failed;
+    }
+}
+
+std::vector<char> PulseEngine::SceneFormat::BuildSceneFile(const SceneFileDesc &scene)
+{
+    std::vector<std::string> strings;
+    std::unordered_map<std::string, uint32_t> stringIndices;
+    auto addString = [&](const std::string& value) -> uint32_t
+    {
+        auto it = stringIndices.find(value);
+        if (it != stringIndices.end()) return it->second;
+        const uint32_t index = (uint32_t)strings.size();
+        strings.push_back(value);
+        stringIndices.emplace(value, index);
+        return index;
+    };
+
+    std::vector<uint32_t> types;
+    std::unordered_map<std::string, uint32_t> typeIndices;
+    std::vector<SceneEntityEntry> entries(scene.entities.size());
+
+    SceneFileHeader header;
+    header.guid = scene.guid;
+    header.sceneName = addString(scene.sceneName);
+    for (std::size_t i = 0; i < scene.entities.size(); ++i)
+    {
+        const SceneEntity& entity = scene.entities[i];
+        auto type = typeIndices.find(entity.typeName);
+        if (type == typeIndices.end())
+        {
+            type = typeIndices.emplace(entity.typeName, (uint32_t)types.size()).first;
+            types.push_back(addString(entity.typeName));
+        }
+
+        entries[i].guid = entity.guid;
+        entries[i].muid = entity.muid;
+        entries[i].type = type->second;
+        entries[i].name = addString(entity.name);
+    }
+
+    BinaryWriter writer;
+    writer.Write(header);
+
+    // strings : the table of offsets first, the characters right after it
+    header.stringCount = (uint32_t)strings.size();
+    header.stringsOffset = writer.buffer.size();
+    uint64_t characters = header.stringsOffset + strings.size() * 2 * sizeof(uint32_t);
+    for (const std::string& value : strings)
+    {
+        writer.Write((uint32_t)characters);
+        writer.Write((uint32_t)value.size());
+        characters += value.size();
+    }
+    for (const std::string& value : strings) writer.WriteBytes(value.data(), value.size());
+
+    writer.Align(sizeof(uint32_t));
+    header.typeCount = (uint32_t)types.size();
+    header.typesOffset = writer.buffer.size();
+    for (uint32_t type : types) writer.Write(type);
+
+    writer.Align(sizeof(uint64_t));
+    header.entityCount = (uint32_t)entries.size();
+    header.entitiesOffset = writer.buffer.size();
+    for (const SceneEntityEntry& entry : entries) writer.Write(entry);
+
+    writer.Align(16);
+    header.transformsOffset = writer.buffer.size();
+    for (const SceneEntity& entity : scene.entities) writer.Write(entity.transform);
+
+    header.lightsOffset = writer.buffer.size();
+    header.lightsSize = scene.lights.size();
+    writer.WriteBytes(scene.lights.data(), scene.lights.size());
+
+    std::memcpy(writer.buffer.data(), &header, sizeof(header));
+    return std::move(writer.buffer);
+}
+
+bool PulseEngine::SceneFormat::WriteSceneFile(const std::string &path, const SceneFileDesc &scene)
+{
+    const std::vector<char> bytes = BuildSceneFile(scene);
+    PulseEngine::FileSystem::FileReader file(path);
+    file.WriteAll(bytes);
+    EDITOR_LOG("Scene " << scene.sceneName << " written : " << scene.entities.size() << " entities, " << bytes.size() << " bytes")
+    return true;
+}
+
+bool PulseEngine::SceneFormat::MigrateLegacyScene(const std::vector<char> &bytes, std::vector<char> &out)
+{
+    BinaryReader reader{ bytes.data(), bytes.size() };
+    if (reader.Read<uint32_t>() != LEGACY_SCENE_MAGIC) return false;
+
+    SceneFileDesc scene;
+    scene.sceneName = reader.ReadString();
+    const std::size_t afterName = reader.cursor;
+
+    // SaveSceneToFile wrote an int guid, the editor "new map" a uint64 one
+    if (!ReadLegacyEntities(reader, false, scene))
+    {
+        reader.cursor = afterName;
+        reader.failed = false;
+        scene.entities.clear();
+        if (!ReadLegacyEntities(reader, true, scene)) return false;
+    }
+
+    // the lights follow, read again through a DiskArchive
+    if (reader.size - reader.cursor >= sizeof(int32_t))
+    {
+        const uint32_t magic = LEGACY_SCENE_MAGIC;
+        scene.lights.resize(sizeof(magic));
+        std::memcpy(scene.lights.data(), &magic, sizeof(magic));
+        scene.lights.insert(scene.lights.end(), bytes.begin() + reader.cursor, bytes.end());
+    }
+
+    out = BuildSceneFile(scene);
+    return true;
+}
+
+bool SceneFileReader::Open(std::vector<char> &&data, const std::string &path)
+{
+    uint32_t magic = 0;
+    if (data.size() >= sizeof(magic)) std::memcpy(&magic, data.data(), sizeof(magic));
+
+    if (magic == LEGACY_SCENE_MAGIC)
+    {
+        if (!MigrateLegacyScene(data, bytes))
+        {
+            EDITOR_WARN("Scene " << path << " : version 0 stream couldn't be migrated")
+            return false;
+        }
+        sourceVersion = 0;
+        EDITOR_LOG("Scene " << path << " migrated from version 0, saving it writes version " << SCENE_FILE_VERSION)
+    }
+    else
+    {
+        bytes = std::move(data);
+        sourceVersion = SCENE_FILE_VERSION;
+    }
+
+    return Validate(path);
+}
+
+bool SceneFileReader::Validate(const std::string &path)
+{
+    if (bytes.size() < sizeof(SceneFileHeader))
+    {
+        EDITOR_WARN("Scene " << path << " : file too short")
+        return false;
+    }
+    std::memcpy(&header, bytes.data(), sizeof(header));
+
+    if (header.magic != SCENE_FILE_MAGIC)
+    {
+        EDITOR_WARN("Scene " << path << " : not a scene file")
+        return false;
+    }
+    if (header.version != SCENE_FILE_VERSION || header.headerSize < sizeof(SceneFileHeader))
+    {
+        EDITOR_WARN("Scene " << path << " : version " << header.version << " not supported (" << SCENE_FILE_VERSION << " expected)")
+        return false;
+    }
+
+    const std::size_t size = bytes.size();
+    if (!BlockFits(header.stringsOffset, header.stringCount, 2 * sizeof(uint32_t), size) ||
+        !BlockFits(header.typesOffset, header.typeCount, sizeof(uint32_t), size) ||
+        !BlockFits(header.entitiesOffset, header.entityCount, sizeof(SceneEntityEntry), size) ||
+        !BlockFits(header.transformsOffset, header.entityCount, sizeof(SceneTransform), size) ||
+        !BlockFits(header.lightsOffset, header.lightsSize, 1, size))
+    {
+        EDITOR_WARN("Scene " << path << " : truncated or corrupted file")
+        return false;
+    }
+
+    // every index checked once here, the accessors trust them
+    for (uint32_t i = 0; i < header.stringCount; ++i)
+    {
+        uint32_t location[2];
+        std::memcpy(location, bytes.data() + header.stringsOffset + i * sizeof(location), sizeof(location));
+        if (!BlockFits(location[0], location[1], 1, size))
+        {
+            EDITOR_WARN("Scene " << path << " : string " << i << " out of the file")
+            return false;
+        }
+    }
+    for (uint32_t i = 0; i < header.typeCount; ++i)
+    {
+        uint32_t type;
+        std::memcpy(&type, bytes.data() + header.typesOffset + i * sizeof(type), sizeof(type));
+        if (type >= header.stringCount)
+        {
+            EDITOR_WARN("Scene " << path << " : type " << i << " has no name")
+            return false;
+        }
+    }
+    for (uint32_t i = 0; i < header.entityCount; ++i)
+    {
+        const SceneEntityEntry entry = GetEntry(i);
+        if (entry.type >= header.typeCount || (entry.name != INVALID_STRING && entry.name >= header.stringCount))
+        {
+            EDITOR_WARN("Scene " << path << " : entity " << i << " has an invalid type or name")
+            return false;
+        }
+    }
+    if (header.sceneName != INVALID_STRING && header.sceneName >= header.stringCount)
+    {
+        EDITOR_WARN("Scene " << path << " : invalid scene name")
+        return false;
+    }
+    return true;
+}
+
+SceneEntityEntry SceneFileReader::GetEntry(std::size_t index) const
+{
+    SceneEntityEntry entry;
+    std::memcpy(&entry, bytes.data() + header.entitiesOffset + index * sizeof(SceneEntityEntry), sizeof(entry));
+    return entry;
+}
+
+SceneTransform SceneFileReader::GetTransform(std::size_t index) const
+{
+    SceneTransform transform;
+    std::memcpy(&transform, bytes.data() + header.transformsOffset + index * sizeof(SceneTransform), sizeof(transform));
+    return transform;
+}
+
+SceneEntity SceneFileReader::GetEntity(std::size_t index) const
+{
+    const SceneEntityEntry entry = GetEntry(index);
+
+    SceneEntity entity;
+    entity.guid = entry.guid;
+    entity.muid = entry.muid;
+    entity.name = GetString(entry.name);
+    entity.typeName = GetTypeName(index);
+    entity.transform = GetTransform(index);
+    return entity;
+}
+
+std::string SceneFileReader::GetTypeName(std::size_t index) const
+{
+    const SceneEntityEntry entry = GetEntry(index);
+    uint32_t type;
+    std::memcpy(&type, bytes.data() + header.typesOffset + entry.type * sizeof(type), sizeof(type));
+    return GetString(type);
+}
+
+std::size_t SceneFileReader::FindEntity(uint64_t muid) const
+{
+    for (std::size_t i = 0; i < header.entityCount; ++i)
+    {
+        if (GetEntry(i).muid == muid) return i;
+    }
+    return header.entityCount;
+}
+
+std::string SceneFileReader::GetString(uint32_t index) const
+{
+    if (index >= header.stringCount) return std::string();
+
+    uint32_t location[2];
+    std::memcpy(location, bytes.data() + header.stringsOffset + index * sizeof(location), sizeof(location));
+    return std::string(bytes.data() + location[0], location[1]);
+}
+
+std::vector<char> SceneFileReader::GetLights() const
+{
+    const char* begin = bytes.data() + header.lightsOffset;
+    return std::vector<char>(begin, begin + header.lightsSize);
+}
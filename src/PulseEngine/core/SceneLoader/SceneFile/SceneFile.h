@@ -0,0 +1,142 @@
+/**
+ * @file SceneFile.h
+ * @brief Binary container of the maps (.pmap) : versioned header, string and type tables, entity index, transforms.
+ * @details Every entity can be read on its own : its index entry and its transform are at a known offset, names and
+ * types are indices in the tables. A loader may decode any subset, in any order, from any thread.
+ *
+ * Layout (little endian) :
+ * - SceneFileHeader, fixed size, with the offset of every block below.
+ * - strings : stringCount x { uint32 offset, uint32 length } (offsets from the start of the file), then the characters.
+ * - types : typeCount x uint32 string index (entity class names, TypeRegistry).
+ * - entity index : entityCount x SceneEntityEntry.
+ * - transforms : entityCount x SceneTransform, 16 bytes aligned, same order as the index.
+ * - lights : DiskArchive stream of SceneLoader::SerializeLights (a handful of objects, read in one go).
+ *
+ * Version 0 is the sequential DiskArchive stream ("PLSE") written before this container : Open migrates it in memory,
+ * it is written back in the current version by the next save.
+ * @version 0.1
+ * @date 2025-12-14
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+#ifndef SCENEFILE_H
+#define SCENEFILE_H
+
+#include "Common/dllExport.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace PulseEngine::SceneFormat
+{
+    constexpr uint32_t SCENE_FILE_MAGIC = 0x4E435350;      // "PSCN"
+    constexpr uint32_t LEGACY_SCENE_MAGIC = 0x504C5345;    // "PLSE", DiskArchive stream
+    constexpr uint16_t SCENE_FILE_VERSION = 1;
+    constexpr uint32_t INVALID_STRING = 0xFFFFFFFF;
+
+    struct SceneFileHeader
+    {
+        uint32_t magic = SCENE_FILE_MAGIC;
+        uint16_t version = SCENE_FILE_VERSION;
+        uint16_t headerSize = sizeof(SceneFileHeader);
+        uint64_t guid = 0;
+        uint32_t sceneName = INVALID_STRING;    ///< string index
+        uint32_t stringCount = 0;
+        uint32_t typeCount = 0;
+        uint32_t entityCount = 0;
+        uint64_t stringsOffset = 0;
+        uint64_t typesOffset = 0;
+        uint64_t entitiesOffset = 0;
+        uint64_t transformsOffset = 0;
+        uint64_t lightsOffset = 0;
+        uint64_t lightsSize = 0;
+    };
+    static_assert(sizeof(SceneFileHeader) == 80, "SceneFileHeader layout changed : bump SCENE_FILE_VERSION");
+
+    struct SceneEntityEntry
+    {
+        uint64_t guid = 0;      ///< entity asset (.pEntity)
+        uint64_t muid = 0;      ///< instance in the map
+        uint32_t type = 0;      ///< type index
+        uint32_t name = INVALID_STRING;
+    };
+    static_assert(sizeof(SceneEntityEntry) == 24, "SceneEntityEntry layout changed : bump SCENE_FILE_VERSION");
+
+    struct SceneTransform
+    {
+        float position[3] = { 0.0f, 0.0f, 0.0f };
+        float rotation[3] = { 0.0f, 0.0f, 0.0f };
+        float scale[3] = { 1.0f, 1.0f, 1.0f };
+    };
+    static_assert(sizeof(SceneTransform) == 36, "SceneTransform layout changed : bump SCENE_FILE_VERSION");
+
+    /**
+     * @brief One entity, as written by BuildSceneFile or returned by SceneFileReader::GetEntity.
+     */
+    struct SceneEntity
+    {
+        std::string typeName;
+        uint64_t guid = 0;
+        uint64_t muid = 0;
+        std::string name;
+        SceneTransform transform;
+    };
+
+    struct SceneFileDesc
+    {
+        std::string sceneName;
+        uint64_t guid = 0;
+        std::vector<SceneEntity> entities;
+        std::vector<char> lights;       ///< DiskArchive stream, magic included. Empty : no light.
+    };
+
+    PULSE_ENGINE_DLL_API std::vector<char> BuildSceneFile(const SceneFileDesc& scene);
+    PULSE_ENGINE_DLL_API bool WriteSceneFile(const std::string& path, const SceneFileDesc& scene);
+
+    /**
+     * @brief Version 0 stream -> current container. Bytes after the entities are the lights.
+     */
+    PULSE_ENGINE_DLL_API bool MigrateLegacyScene(const std::vector<char>& bytes, std::vector<char>& out);
+
+    /**
+     * @brief Random access over the bytes of a map. Const accessors are safe from any thread once Open returned.
+     */
+    class PULSE_ENGINE_DLL_API SceneFileReader
+    {
+    public:
+        /**
+         * @brief Check the header and the bounds of every block, older versions are migrated first.
+         */
+        bool Open(std::vector<char>&& bytes, const std::string& path);
+
+        uint16_t GetSourceVersion() const { return sourceVersion; }
+        uint64_t GetGuid() const { return header.guid; }
+        std::string GetSceneName() const { return GetString(header.sceneName); }
+
+        std::size_t GetEntityCount() const { return header.entityCount; }
+        SceneEntityEntry GetEntry(std::size_t index) const;
+        SceneTransform GetTransform(std::size_t index) const;
+        SceneEntity GetEntity(std::size_t index) const;
+        std::string GetTypeName(std::size_t index) const;
+
+        /**
+         * @brief Index of the entity with this muid, GetEntityCount() if none.
+         */
+        std::size_t FindEntity(uint64_t muid) const;
+
+        std::string GetString(uint32_t index) const;
+        std::vector<char> GetLights() const;
+
+    private:
+        bool Validate(const std::string& path);
+
+        std::vector<char> bytes;
+        SceneFileHeader header;
+        uint16_t sourceVersion = 0;
+    };
+}
+
+#endif // SCENEFILE_H
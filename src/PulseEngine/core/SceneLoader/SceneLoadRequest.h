@@ -0,0 +1,121 @@
+/**
+ * @file SceneLoadRequest.h
+ * @brief Load of one map file : read on the ThreadPool, entities built on the main thread with a time budget.
+ * @details Used by SceneLoader for whole scenes and by WorldStreamer for the cells of a streamed world.
+ * - Read (worker) : the map index is read, then the entity files and the meshes are read and decoded by several jobs.
+ * - Process (main thread) : the entities are created and their meshes uploaded, a few milliseconds per call.
+ * - Commit (main thread) : physic bodies are created and the entities are added to the backend and the SceneManager.
+ * @version 0.1
+ * @date 2025-12-14
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+#ifndef SCENELOADREQUEST_H
+#define SCENELOADREQUEST_H
+
+#include "Common/common.h"
+#include "PulseEngine/core/SceneLoader/SceneLoader.h"
+#include "PulseEngine/core/Meshes/Cooking/CookedMesh.h"
+#include "json.hpp"
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+class Entity;
+class PulseEngineBackend;
+
+struct SceneLoadRequest : std::enable_shared_from_this<SceneLoadRequest>
+{
+    /**
+     * @brief One entity of the map, from its entry and its transform in the scene file.
+     */
+    struct EntityRecord
+    {
+        std::string typeName;
+        std::uint64_t guid = 0;
+        std::uint64_t muid = 0;
+        std::string name;
+        PulseEngine::Vector3 position;
+        PulseEngine::Vector3 rotation;
+        PulseEngine::Vector3 scale;
+    };
+
+    /**
+     * @brief New request, its Read job is already submitted to the ThreadPool.
+     * @param muids only these entities of the map are loaded, and not its lights. Empty : the whole map.
+     */
+    static std::shared_ptr<SceneLoadRequest> Start(const std::string& mapPath, PulseEngineBackend* backend, bool waitForTextures,
+                                                   const std::vector<std::uint64_t>& muids = {});
+
+    ~SceneLoadRequest();
+
+    std::shared_ptr<SceneLoadHandle> handle;
+    PulseEngineBackend* backend = nullptr;
+    bool waitForTextures = true;
+    std::atomic<bool> cancelled{ false };
+    std::vector<std::uint64_t> muidFilter;
+
+    // ---- workers, read by the main thread once readDone is set ----
+    std::vector<char> lights;               ///< DiskArchive stream read by Swap
+    std::vector<EntityRecord> records;
+    std::vector<std::uint64_t> entityGuids; ///< unique, split between the ReadEntities jobs
+    nlohmann::json collection;              ///< entity guid collection, read only once the jobs run
+    std::unordered_map<std::uint64_t, nlohmann::json> entityData;   ///< by entity guid, meshMutex
+    std::unordered_map<std::size_t, std::string> meshPaths;         ///< by mesh guid, meshMutex
+    std::unordered_set<std::string> meshSources;                    ///< meshes with a job, meshMutex
+    std::atomic<std::size_t> entityJobs{ 0 };
+    std::atomic<std::size_t> meshJobs{ 0 };
+    std::atomic<std::size_t> meshJobsDone{ 0 };
+    std::atomic<bool> readDone{ false };
+    std::atomic<bool> readFailed{ false };
+
+    std::mutex meshMutex;
+    std::unordered_map<std::string, PulseEngine::Cooking::CookedMesh> meshes;  ///< by mesh path
+
+    // ---- main thread ----
+    std::size_t nextRecord = 0;
+    std::vector<Entity*> staged;            ///< built, not in the scene yet
+
+    void SetState(SceneLoadHandle::State state, float progress)
+    {
+        handle->state = state;
+        handle->progress = progress;
+    }
+
+    bool HasFailed() const { return readDone && readFailed; }
+
+    void Read();
+    /**
+     * @brief Entity files of entityGuids[begin, end), the jobs of their meshes are submitted right away.
+     */
+    void ReadEntities(std::size_t begin, std::size_t end);
+    void ReadMesh(const std::string& meshPath);
+    bool BuildNextEntity();
+
+    /**
+     * @brief Build entities for budgetMs (at least one), once the workers are done.
+     * @return true when every entity is built and the request can be committed.
+     */
+    bool Process(float budgetMs);
+
+    /**
+     * @brief Add the built entities to the scene, with their physic body.
+     * @param outEntities if not null, receives the entities added.
+     */
+    void Commit(std::vector<Entity*>* outEntities = nullptr);
+
+    /**
+     * @brief Replace the whole scene : everything loaded before is cleared, the lights of the map are read.
+     */
+    void Swap();
+    void Cancel();
+};
+
+#endif // SCENELOADREQUEST_H
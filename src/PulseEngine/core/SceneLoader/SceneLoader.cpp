@@ -1,4 +1,7 @@
 #include "SceneLoader.h"
+#include "SceneLoadRequest.h"
+#include "PulseEngine/core/SceneLoader/WorldStreaming/WorldStreamer.h"
+#include "PulseEngine/core/SceneLoader/SceneFile/SceneFile.h"
 #include "PulseEngine/core/GUID/GuidReader.h"
 #include "PulseEngine/core/Entity/Entity.h"
 #include "PulseEngine/core/PulseEngineBackend.h"
@@ -13,89 +16,366 @@
 #include "PulseEngine/core/Lights/PointLight/PointLight.h"
 #include "PulseEngine/API/EntityAPI/EntityApi.h"
 #include "PulseEngine/core/FileManager/Archive/DiskArchive.h"
+#include "PulseEngine/core/FileManager/Pak/PakManager.h"
 #include "PulseEngine/core/PulseObject/TypeRegister/TypeRegister.h"
 #include "PulseEngine/core/SceneManager/SceneManager.h"
 #include "PulseEngine/core/Gamemode/Gamemode.h"
-
+#include "PulseEngine/core/Meshes/Cooking/CookedMesh.h"
+#include "PulseEngine/core/Material/TextureManager.h"
+#include "PulseEngine/core/Threading/ThreadPool.h"
+#include "PulseEngine/core/Threading/GraphicsThread.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
 #include <iostream>
+#include <limits>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
 #include <assimp/Importer.hpp>      // Assimp::Importer
 #include <assimp/scene.h>           // aiScene
 #include <assimp/postprocess.h>     // postprocessing flags
 
 #pragma region SceneLoader
-void SceneLoader::LoadScene(const std::string &mapName, PulseEngineBackend* backend)
+
+namespace
+{
+    std::shared_ptr<SceneLoadRequest> pendingLoad;
+
+    /// @brief Entity files parsed by one SceneLoadRequest::ReadEntities job.
+    constexpr std::size_t ENTITY_FILES_PER_JOB = 8;
+
+    void CollectMeshGuids(const nlohmann::json& meshes, std::unordered_set<std::size_t>& outGuids)
+    {
+        if (!meshes.is_array()) return;
+        for (const nlohmann::json& mesh : meshes)
+        {
+            if (!mesh.is_object() || !mesh.contains("Guid")) continue;
+            const nlohmann::json& guid = mesh["Guid"];
+            if (guid.is_string())
+                outGuids.insert(static_cast<std::size_t>(std::strtoull(guid.get<std::string>().c_str(), nullptr, 10)));
+            else if (guid.is_number_unsigned())
+                outGuids.insert(guid.get<std::size_t>());
+
+            if (mesh.contains("Children")) CollectMeshGuids(mesh["Children"], outGuids);
+        }
+    }
+
+    void DropPendingLoad(const std::string& replacement)
+    {
+        if (!pendingLoad) return;
+
+        EDITOR_WARN("Loading of " << pendingLoad->handle->GetMapName() << " dropped for " << replacement)
+        pendingLoad->Cancel();
+        pendingLoad.reset();
+    }
+
+    /**
+     * @brief Handle of a load already over : map not found, or a streamed world (its cells come later).
+     */
+    std::shared_ptr<SceneLoadHandle> FinishedHandle(const std::string& mapName, SceneLoadHandle::State state)
+    {
+        SceneLoadRequest request;
+        request.handle = std::make_shared<SceneLoadHandle>(mapName);
+        request.SetState(state, state == SceneLoadHandle::State::Swapped ? 1.0f : 0.0f);
+        return request.handle;
+    }
+
+    std::shared_ptr<SceneLoadHandle> StartLoad(const std::string& mapName, PulseEngineBackend* backend, bool waitForTextures)
+    {
+        DropPendingLoad(mapName);
+
+        // streamed world : only its index is read here, WorldStreamer::Update loads the cells around the camera
+        if (WorldStreamer::IsWorldFile(mapName))
+        {
+            const bool opened = WorldStreamer::GetInstance().OpenWorld(mapName, backend);
+            return FinishedHandle(mapName, opened ? SceneLoadHandle::State::Swapped : SceneLoadHandle::State::Failed);
+        }
+
+        if (!PulseEngine::FileSystem::AssetExists(mapName))
+        {
+            EDITOR_WARN("Couldn't open map " << std::string(ASSET_PATH) + mapName)
+            return FinishedHandle(mapName, SceneLoadHandle::State::Failed);
+        }
+
+        pendingLoad = SceneLoadRequest::Start(mapName, backend, waitForTextures);
+        return pendingLoad->handle;
+    }
+}
+
+std::shared_ptr<SceneLoadRequest> SceneLoadRequest::Start(const std::string& mapPath, PulseEngineBackend* backend, bool waitForTextures,
+                                                          const std::vector<std::uint64_t>& muids)
+{
+    auto request = std::make_shared<SceneLoadRequest>();
+    request->handle = std::make_shared<SceneLoadHandle>(mapPath);
+    request->backend = backend;
+    request->waitForTextures = waitForTextures;
+    request->muidFilter = muids;
+
+    PulseEngine::Threading::ThreadPool::GetInstance().Submit([request]() { request->Read(); });
+    return request;
+}
+
+SceneLoadRequest::~SceneLoadRequest() = default;
+
+void SceneLoadRequest::Read()
 {
     PROFILE_TIMER_FUNCTION;
-    std::ifstream scene(std::string(ASSET_PATH) + mapName);
-    if (!scene.is_open())
+    const std::string& mapName = handle->GetMapName();
+
+    std::vector<char> bytes;
+    PulseEngine::SceneFormat::SceneFileReader scene;
+    if (cancelled || !PulseEngine::FileSystem::ReadAssetFile(mapName, bytes) || !scene.Open(std::move(bytes), mapName))
     {
-        EDITOR_WARN("Couldn't open map " << std::string(ASSET_PATH) + mapName)
+        readFailed = true;
+        readDone = true;
         return;
     }
-    backend->ClearScene();
-    SceneManager::GetInstance()->CleanHierarchyFrom(SceneManager::GetInstance()->GetRoot());
 
-    // nlohmann::json sceneData;
-    // scene >> sceneData;
-
-    
-    DiskArchive dar(mapName, Archive::Mode::Loading);
-    int entityCount;
-    std::string receivedMapName;
-    int guid;
-    dar.Serialize("sceneName", receivedMapName);
-    dar.Serialize("guid", guid);
-    dar.Serialize("entitiesCount", entityCount);
-    for(unsigned int i = 0; i < entityCount; i++)
+    // index and transforms only, the entity files are read by the jobs below
+    std::unordered_set<std::uint64_t> wanted(muidFilter.begin(), muidFilter.end());
+    std::unordered_set<std::uint64_t> guids;
+    records.reserve(wanted.empty() ? scene.GetEntityCount() : wanted.size());
+    for (std::size_t i = 0; i < scene.GetEntityCount(); i++)
     {
-        std::string typeName;
-        std::uint64_t guid;
-        std::uint64_t muid;
-        dar.Serialize("typeName", typeName);
-        dar.Serialize("guid", guid);
-        dar.Serialize("muid", muid);
-        
-        if(TypeRegistry::IsRegistered(typeName))
-        {            
-            Entity* po = GuidReader::GetEntityFromGuid(static_cast<std::size_t>(guid));
-            if(!po)
-            {
-                EDITOR_ERROR("entity with guid " << guid << "couldn't be loaded correctly")
-                continue;
-            }
-            po->SetMuid(muid);
-            po->Serialize(dar);
+        const PulseEngine::SceneFormat::SceneEntityEntry entry = scene.GetEntry(i);
+        if (!wanted.empty() && !wanted.count(entry.muid)) continue;
+
+        EntityRecord record;
+        record.typeName = scene.GetTypeName(i);
+        if (!TypeRegistry::IsRegistered(record.typeName)) continue;
+
+        const PulseEngine::SceneFormat::SceneTransform transform = scene.GetTransform(i);
+        record.guid = entry.guid;
+        record.muid = entry.muid;
+        record.name = scene.GetString(entry.name);
+        record.position = PulseEngine::Vector3(transform.position[0], transform.position[1], transform.position[2]);
+        record.rotation = PulseEngine::Vector3(transform.rotation[0], transform.rotation[1], transform.rotation[2]);
+        record.scale = PulseEngine::Vector3(transform.scale[0], transform.scale[1], transform.scale[2]);
+        if (guids.insert(record.guid).second) entityGuids.push_back(record.guid);
+        records.push_back(std::move(record));
+    }
+    if (wanted.empty()) lights = scene.GetLights();
+
+    if (entityGuids.empty() || cancelled || !GuidReader::ReadEntityCollection(collection))
+    {
+        readDone = true;
+        return;
+    }
+
+    // entity files, read once per entity type, a few per job
+    const std::size_t jobCount = (entityGuids.size() + ENTITY_FILES_PER_JOB - 1) / ENTITY_FILES_PER_JOB;
+    entityJobs = jobCount;
+
+    // the jobs keep the request alive when the load is dropped meanwhile
+    std::shared_ptr<SceneLoadRequest> self = shared_from_this();
+    for (std::size_t job = 0; job < jobCount; job++)
+    {
+        const std::size_t begin = job * ENTITY_FILES_PER_JOB;
+        const std::size_t end = std::min(begin + ENTITY_FILES_PER_JOB, entityGuids.size());
+        PulseEngine::Threading::ThreadPool::GetInstance().Submit([self, begin, end]() { self->ReadEntities(begin, end); });
+    }
+}
 
-            backend->entities.push_back(po);
-            SceneManager::GetInstance()->InsertEntity(po);
-            EDITOR_LOG("Spawning " << po->ToString() << " transform -> " << po->transform.ToString())
+void SceneLoadRequest::ReadEntities(std::size_t begin, std::size_t end)
+{
+    PROFILE_TIMER_FUNCTION;
+    std::vector<std::pair<std::uint64_t, nlohmann::json>> read;
+    std::unordered_set<std::size_t> meshGuids;
+    for (std::size_t i = begin; i < end && !cancelled; i++)
+    {
+        nlohmann::json data;
+        if (!GuidReader::ReadEntityData(collection, static_cast<std::size_t>(entityGuids[i]), data)) continue;
+        if (data.contains("Meshes")) CollectMeshGuids(data["Meshes"], meshGuids);
+        read.emplace_back(entityGuids[i], std::move(data));
+    }
+
+    std::vector<std::pair<std::size_t, std::string>> resolved;
+    for (std::size_t meshGuid : meshGuids)
+    {
+        std::string meshPath;
+        if (GuidReader::GetMeshPathFromGuid(meshGuid, meshPath)) resolved.emplace_back(meshGuid, std::move(meshPath));
+    }
+
+    // meshes, one job per source : several mesh guids, and several jobs, may share it
+    std::vector<std::string> newSources;
+    {
+        std::lock_guard<std::mutex> lock(meshMutex);
+        for (auto& data : read) entityData.emplace(data.first, std::move(data.second));
+        for (auto& mesh : resolved)
+        {
+            if (meshSources.insert(mesh.second).second) newSources.push_back(mesh.second);
+            meshPaths.emplace(mesh.first, std::move(mesh.second));
         }
     }
 
-    int lightCount = (int)backend->lights.size();
-    dar.Serialize("lightCount", lightCount);
-    for(unsigned int i = 0; i < lightCount; i++)
+    // counted before this job is, so Process never sees every entity job done with mesh jobs missing
+    meshJobs += newSources.size();
+    std::shared_ptr<SceneLoadRequest> self = shared_from_this();
+    for (const std::string& meshPath : newSources)
     {
-        std::string typeName;
-        dar.Serialize("typeName", typeName);
-        LightData* light = TypeRegistry::CreateInstance<LightData>(typeName);
-        light->Serialize(dar);
+        PulseEngine::Threading::ThreadPool::GetInstance().Submit([self, meshPath]() { self->ReadMesh(meshPath); });
+    }
 
-        backend->lights.push_back(light);
-        SceneManager::GetInstance()->InsertEntity(light);
+    if (--entityJobs == 0)
+    {
+        readDone = true;
     }
+}
 
-    PulseEngineInstance->actualMapPath = mapName;
-     size_t lastSlash = mapName.find_last_of("/\\");
-     if (lastSlash != std::string::npos && lastSlash + 1 < mapName.size()) {
-         PulseEngineInstance->actualMapName = mapName.substr(lastSlash + 1);
-     } else {
-         PulseEngineInstance->actualMapName = mapName;
-     }
+void SceneLoadRequest::ReadMesh(const std::string& meshPath)
+{
+    if (!cancelled)
+    {
+        PulseEngine::Cooking::CookedMesh cooked;
+        if (PulseEngine::Cooking::LoadMeshAsset(meshPath, cooked))
+        {
+            std::lock_guard<std::mutex> lock(meshMutex);
+            meshes.emplace(meshPath, std::move(cooked));
+        }
+    }
+    meshJobsDone++;
+}
 
-    PulseEngineInstance->SetWindowName(PulseEngineInstance->actualMapName);
+bool SceneLoadRequest::BuildNextEntity()
+{
+    if (nextRecord >= records.size()) return false;
+    const EntityRecord& record = records[nextRecord++];
+
+    auto data = entityData.find(record.guid);
+    if (data == entityData.end())
+    {
+        EDITOR_ERROR("entity with guid " << record.guid << "couldn't be loaded correctly")
+        return true;
+    }
+
+    // the meshes were decoded by the workers, only the GPU upload is left
+    GuidReader::MeshProvider meshProvider = [this](std::size_t meshGuid) -> RenderableMesh*
+    {
+        auto path = meshPaths.find(meshGuid);
+        if (path == meshPaths.end()) return nullptr;
+
+        std::lock_guard<std::mutex> lock(meshMutex);
+        auto mesh = meshes.find(path->second);
+        if (mesh == meshes.end()) return nullptr;
+
+        PulseEngine::Cooking::CookedMesh cooked = mesh->second;
+        return GuidReader::CreateMeshFromCooked(meshGuid, path->second, cooked);
+    };
+
+    nlohmann::json entityJson = data->second;
+    Entity* po = GuidReader::GetEntityFromGuid(static_cast<std::size_t>(record.guid), entityJson, meshProvider);
+    if(!po)
+    {
+        EDITOR_ERROR("entity with guid " << record.guid << "couldn't be loaded correctly")
+        return true;
+    }
+
+    // Entity::Serialize without the physic body, made by Commit
+    po->SetMuid(record.muid);
+    po->SetName(record.name);
+    po->transform.position = record.position;
+    po->transform.rotation = record.rotation;
+    po->transform.scale = record.scale;
+    staged.push_back(po);
+    return true;
+}
+
+bool SceneLoadRequest::Process(float budgetMs)
+{
+    if (!readDone || readFailed) return false;
+
+    const std::size_t jobs = meshJobs;
+    const std::size_t jobsDone = meshJobsDone;
+    if (jobsDone < jobs)
+    {
+        SetState(SceneLoadHandle::State::Reading, 0.5f * (float)jobsDone / (float)jobs);
+        return false;
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+    while (BuildNextEntity())
+    {
+        const float elapsedMs = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start).count();
+        if (elapsedMs >= budgetMs) break;
+    }
+
+    const float built = records.empty() ? 1.0f : (float)nextRecord / (float)records.size();
+    SetState(SceneLoadHandle::State::Building, 0.5f + 0.5f * built);
+    return nextRecord >= records.size();
+}
+
+void SceneLoadRequest::Commit(std::vector<Entity*>* outEntities)
+{
+    PROFILE_TIMER_FUNCTION;
+    for (Entity* po : staged)
+    {
+        po->CreatePhysicBody();
+        backend->entities.push_back(po);
+        SceneManager::GetInstance()->InsertEntity(po);
+        if (outEntities) outEntities->push_back(po);
+        EDITOR_LOG("Spawning " << po->ToString() << " transform -> " << po->transform.ToString())
+    }
+    staged.clear();
+
+    // the cooked copies are not needed anymore
+    meshes.clear();
+    entityData.clear();
+}
+
+void SceneLoadRequest::Swap()
+{
+    PROFILE_TIMER_FUNCTION;
+    WorldStreamer::GetInstance().CloseWorld();
+    backend->ClearScene();
+    SceneManager::GetInstance()->CleanHierarchyFrom(SceneManager::GetInstance()->GetRoot());
+
+    Commit();
+    if (!lights.empty())
+    {
+        DiskArchive dar(std::move(lights), handle->GetMapName());
+        SceneLoader::SerializeLights(dar, backend->lights);
+    }
+    SceneLoader::SetActualMap(handle->GetMapName());
+    SetState(SceneLoadHandle::State::Swapped, 1.0f);
+}
+
+void SceneLoadRequest::Cancel()
+{
+    cancelled = true;
+    for (Entity* po : staged)
+    {
+        po->ReleaseMeshes();
+        delete po;
+    }
+    staged.clear();
+    SetState(SceneLoadHandle::State::Failed, handle->GetProgress());
+}
 
+void SceneLoader::LoadScene(const std::string &mapName, PulseEngineBackend* backend)
+{
+    PROFILE_TIMER_FUNCTION;
 
+    // asked by a script on the simulation thread : the meshes and textures need the context, loaded at the next sync
+    if (!PulseEngine::Threading::IsGraphicsThread())
+    {
+        PulseEngine::Threading::RunOnGraphicsThread([mapName, backend]() { LoadScene(mapName, backend); });
+        return;
+    }
+
+    // the workers still read the files and meshes in parallel, this thread waits for them
+    std::shared_ptr<SceneLoadHandle> handle = StartLoad(mapName, backend, false);
+    while (!handle->IsDone())
+    {
+        ProcessPendingLoads(std::numeric_limits<float>::max());
+        if (!handle->IsDone()) std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    // a world is usable once the cells around the camera are in
+    if (WorldStreamer::IsWorldFile(mapName) && WorldStreamer::GetInstance().IsWorldOpen())
+        WorldStreamer::GetInstance().Flush();
 
     // backend->SetWindowName(sceneData["sceneName"]);
     // for (const auto& entityData : sceneData["entities"])
@@ -170,7 +450,110 @@ void SceneLoader::LoadScene(const std::string &mapName, PulseEngineBackend* back
     // }
     // EDITOR_LOG("Scene " << mapName << " loaded successfully.")
     // // Set actualMapName to the substring after the last "/"
+}
+
+std::shared_ptr<SceneLoadHandle> SceneLoader::LoadSceneAsync(const std::string &mapName, PulseEngineBackend *backend)
+{
+    return StartLoad(mapName, backend, true);
+}
+
+std::vector<Entity*> SceneLoader::LoadEntitiesFromScene(const std::string &mapName, PulseEngineBackend *backend, const std::vector<std::uint64_t> &muids)
+{
+    PROFILE_TIMER_FUNCTION;
+    std::vector<Entity*> entities;
+    if (muids.empty()) return entities;
+    if (!PulseEngine::FileSystem::AssetExists(mapName))
+    {
+        EDITOR_WARN("Couldn't open map " << std::string(ASSET_PATH) + mapName)
+        return entities;
+    }
+
+    std::shared_ptr<SceneLoadRequest> request = SceneLoadRequest::Start(mapName, backend, false, muids);
+    while (!request->Process(std::numeric_limits<float>::max()))
+    {
+        if (request->HasFailed())
+        {
+            EDITOR_ERROR("Couldn't read map " << mapName)
+            return entities;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    request->Commit(&entities);
+    return entities;
+}
+
+bool SceneLoader::IsLoadingScene()
+{
+    return pendingLoad != nullptr;
+}
+
+void SceneLoader::ProcessPendingLoads(float budgetMs)
+{
+    if (!pendingLoad) return;
+    PROFILE_TIMER_FUNCTION;
+    SceneLoadRequest& request = *pendingLoad;
+
+    if (request.HasFailed())
+    {
+        EDITOR_ERROR("Couldn't read map " << request.handle->GetMapName())
+        request.SetState(SceneLoadHandle::State::Failed, 0.0f);
+        pendingLoad.reset();
+        return;
+    }
+    if (!request.Process(budgetMs)) return;
+
+    // the textures of the new scene are uploaded by TextureManager, a few per frame
+    if (request.waitForTextures && TextureManager::GetInstance().GetLoadingCount() > 0) return;
+
+    request.Swap();
+    pendingLoad.reset();
+}
+
+void SceneLoader::SerializeLights(Archive& ar, std::vector<LightData*>& lights)
+{
+    int lightCount = (int)lights.size();
+    ar.Serialize("lightCount", lightCount);
+    if (ar.IsSaving())
+    {
+        for(LightData* light : lights)
+        {
+            std::string typeName(light->GetTypeName());
+            ar.Serialize("typeName", typeName);
+            light->Serialize(ar);
+        }
+        return;
+    }
 
+    for(int i = 0; i < lightCount; i++)
+    {
+        std::string typeName;
+        ar.Serialize("typeName", typeName);
+        LightData* light = TypeRegistry::CreateInstance<LightData>(typeName);
+        if (!light)
+        {
+            EDITOR_ERROR("Unknown light type " << typeName << ", the other lights of the map are skipped")
+            return;
+        }
+        light->Serialize(ar);
+        light->CreatePhysicBody();
+
+        lights.push_back(light);
+        SceneManager::GetInstance()->InsertEntity(light);
+    }
+}
+
+void SceneLoader::SetActualMap(const std::string &mapPath)
+{
+    PulseEngineInstance->actualMapPath = mapPath;
+    size_t lastSlash = mapPath.find_last_of("/\\");
+    if (lastSlash != std::string::npos && lastSlash + 1 < mapPath.size()) {
+        PulseEngineInstance->actualMapName = mapPath.substr(lastSlash + 1);
+    } else {
+        PulseEngineInstance->actualMapName = mapPath;
+    }
+
+    PulseEngineInstance->SetWindowName(PulseEngineInstance->actualMapName);
 }
 
 void SceneLoader::LoadEntityScript(const nlohmann::json_abi_v3_12_0::json &script, Entity *entity, IScript* existingScript)
@@ -301,7 +684,7 @@ std::vector<std::string> SceneLoader::GetSceneFiles(const std::string &directory
     std::vector<std::string> sceneFiles;
     for (const auto& entry : std::filesystem::directory_iterator(directory))
     {
-        if (entry.is_regular_file() && entry.path().extension() == ".pmap")
+        if (entry.is_regular_file() && (entry.path().extension() == ".pmap" || entry.path().extension() == WorldStreamer::WORLD_EXTENSION))
         {
             // Normalize path separators and remove everything before "/Scenes/"
             std::string path = entry.path().generic_string(); // uses '/' as separator
@@ -358,44 +741,21 @@ const aiScene* SceneLoader::LoadSceneFromAssimp(std::string path)
 #pragma region SaveScene
 void SceneLoader::SaveSceneToFile(const std::string &mapName, const std::string& mapPath, PulseEngineBackend *backend)
 {
+    if (WorldStreamer::IsWorldFile(mapPath))
+    {
+        WorldStreamer::GetInstance().SaveWorld(mapName, mapPath, backend);
+        return;
+    }
+
     //~second implementation with pulseobject for test
 
-    DiskArchive dar(mapPath, Archive::Mode::Saving);
-    int entitiesSize = 0;
+    std::vector<Entity*> entities;
     for(Entity* en : backend->entities)
     {
         if(dynamic_cast<LightData*>(en) != nullptr) continue;
-        entitiesSize++;
-    }
-    
-    std::string map = mapName;
-    int guid;
-    dar.Serialize("sceneName", map);
-    dar.Serialize("guid", guid);
-    dar.Serialize("entitiesCount", entitiesSize);
-    for(Entity* en : backend->entities)
-    {
-        if(dynamic_cast<LightData*>(en) != nullptr) continue;
-        std::string typeName(en->GetTypeName());
-        std::uint64_t guid = en->GetGuid();
-        std::uint64_t muid = en->GetMuid();
-        dar.Serialize("typeName", typeName);
-        dar.Serialize("guid", guid);
-        dar.Serialize("muid", muid);
-        en->Serialize(dar);
-    }
-
-    int lightCount = (int)backend->lights.size();
-    dar.Serialize("lightCount", lightCount);
-    for(LightData* light : backend->lights)
-    {
-        std::string typeName(light->GetTypeName());
-        dar.Serialize("typeName", typeName);
-        light->Serialize(dar);
+        entities.push_back(en);
     }
-
-    dar.Finalize();
-
+    WriteMapFile(mapName, mapPath, entities, backend->lights);
 
     //~first implementation of saving without pulseobject 
 
@@ -457,6 +817,43 @@ void SceneLoader::SaveSceneToFile(const std::string &mapName, const std::string&
     // sceneFile.close();
 }
 
+void SceneLoader::WriteMapFile(const std::string &mapName, const std::string &mapPath, const std::vector<Entity*>& entities, std::vector<LightData*>& lights)
+{
+    PROFILE_TIMER_FUNCTION;
+    PulseEngine::SceneFormat::SceneFileDesc scene;
+    scene.sceneName = mapName;
+    scene.entities.reserve(entities.size());
+    for(Entity* en : entities)
+    {
+        PulseEngine::SceneFormat::SceneEntity entity;
+        entity.typeName = en->GetTypeName();
+        entity.guid = en->GetGuid();
+        entity.muid = en->GetMuid();
+        entity.name = en->GetName();
+
+        const PulseEngine::Transform& transform = en->transform;
+        const PulseEngine::Vector3* fields[3] = { &transform.position, &transform.rotation, &transform.scale };
+        float* values[3] = { entity.transform.position, entity.transform.rotation, entity.transform.scale };
+        for (int i = 0; i < 3; i++)
+        {
+            values[i][0] = fields[i]->x;
+            values[i][1] = fields[i]->y;
+            values[i][2] = fields[i]->z;
+        }
+        scene.entities.push_back(std::move(entity));
+    }
+
+    // the lights keep their Serialize, they are few and read in one go
+    if (!lights.empty())
+    {
+        DiskArchive dar;
+        SerializeLights(dar, lights);
+        scene.lights = dar.GetBuffer();
+    }
+
+    PulseEngine::SceneFormat::WriteSceneFile(mapPath, scene);
+}
+
 void SceneLoader::SaveEntities(Entity *const &entity, nlohmann::json_abi_v3_12_0::json &sceneData)
 {
     nlohmann::json entityData;
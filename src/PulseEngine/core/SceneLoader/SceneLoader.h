@@ -16,11 +16,49 @@
 #include "Common/dllExport.h"
 #include "json.hpp"
 
+#include <atomic>
+#include <cstdint>
+#include <memory>
+
 class PulseEngineBackend;
+class Archive;
+class LightData;
 
 struct ExposedVariable;
 struct aiScene;
 class IScript;
+struct SceneLoadRequest;
+
+/**
+ * @brief Progress of a scene loaded by SceneLoader::LoadSceneAsync, for loading screens.
+ */
+class PULSE_ENGINE_DLL_API SceneLoadHandle
+{
+public:
+    enum class State
+    {
+        Reading,    ///< workers : map, entity files and meshes are read and decoded
+        Building,   ///< main thread : entities are created and uploaded, a budget per frame
+        Swapped,    ///< the new scene replaced the previous one
+        Failed      ///< map not found, or another load was started
+    };
+
+    explicit SceneLoadHandle(const std::string& mapName) : mapName(mapName) {}
+
+    State GetState() const { return state.load(); }
+    /// @brief 0 -> 1, reading is the first half, building the second one.
+    float GetProgress() const { return progress.load(); }
+    bool IsDone() const { const State current = GetState(); return current == State::Swapped || current == State::Failed; }
+    const std::string& GetMapName() const { return mapName; }
+
+private:
+    friend struct SceneLoadRequest;
+    friend class SceneLoader;
+
+    std::string mapName;
+    std::atomic<State> state{ State::Reading };
+    std::atomic<float> progress{ 0.0f };
+};
 
 class PULSE_ENGINE_DLL_API SceneLoader
 {
@@ -30,6 +68,25 @@ class PULSE_ENGINE_DLL_API SceneLoader
         /// The scene is loaded from a json file, with entities, and scripts attach to them.
         /// The scripts saved will have all the exposed variables saved, from the value set in the editor.
         static void LoadScene(const std::string &mapName, PulseEngineBackend *backend);
+
+        ///====== LoadSceneAsync ======
+        /// Same result as LoadScene without blocking : the map, the entity files and the meshes are read on the
+        /// ThreadPool, then ProcessPendingLoads creates the entities on the main thread, a few milliseconds per frame.
+        /// The current scene keeps rendering, and is replaced in one go once every entity (and texture) is ready.
+        /// Starting another load drops the pending one.
+        /// Streamed worlds (WorldStreamer::WORLD_EXTENSION) are opened at once, their cells are loaded by WorldStreamer.
+        static std::shared_ptr<SceneLoadHandle> LoadSceneAsync(const std::string &mapName, PulseEngineBackend *backend);
+
+        /// Main thread part of LoadSceneAsync, called once per frame by the engine.
+        /// @param budgetMs time spent creating entities (GPU uploads included) in this call, at least one entity is made.
+        static void ProcessPendingLoads(float budgetMs = 4.0f);
+
+        ///====== LoadEntitiesFromScene ======
+        /// Partial load : only the entities of the map with these muids are read, built and added to the current
+        /// scene (the lights of the map are not). The map index is read, the other entities are skipped.
+        static std::vector<Entity*> LoadEntitiesFromScene(const std::string &mapName, PulseEngineBackend *backend, const std::vector<std::uint64_t> &muids);
+
+        static bool IsLoadingScene();
         static std::vector<std::string> GetSceneFiles(const std::string& directory);
 
         static const aiScene* LoadSceneFromAssimp(std::string path);
@@ -40,6 +97,17 @@ class PULSE_ENGINE_DLL_API SceneLoader
         /// The scripts saved will have all the exposed variables saved, from the value set in the editor.
         static void SaveSceneToFile(const std::string &mapName, const std::string& mapPath, PulseEngineBackend *backend);
 
+        ///====== WriteMapFile ======
+        /// Write a map with these entities and lights (SceneFile.h). WorldStreamer writes its cells with it, without lights.
+        static void WriteMapFile(const std::string &mapName, const std::string &mapPath, const std::vector<Entity*>& entities, std::vector<LightData*>& lights);
+
+        /// Lights of a map : count, then type name and LightData::Serialize of each one.
+        /// When loading, the lights are added to lights and to the SceneManager.
+        static void SerializeLights(Archive& ar, std::vector<LightData*>& lights);
+
+        /// Map shown in the window title and saved by the editor.
+        static void SetActualMap(const std::string &mapPath);
+
         static void SaveEntities(Entity *const &entity, nlohmann::json_abi_v3_12_0::json &sceneData);
         static void SaveBaseDataEntity(Entity *const &entity, nlohmann::json_abi_v3_12_0::json &entityData);
         static void LoadEntityScript(const nlohmann::json_abi_v3_12_0::json &script, Entity *entity, IScript* existingScript = nullptr);
@@ -0,0 +1,445 @@
+#include "WorldStreamer.h"
+#include "PulseEngine/core/SceneLoader/SceneLoader.h"
+#include "PulseEngine/core/SceneLoader/SceneLoadRequest.h"
+#include "PulseEngine/core/PulseEngineBackend.h"
+#include "PulseEngine/core/Entity/Entity.h"
+#include "PulseEngine/core/Lights/Lights.h"
+#include "PulseEngine/core/Meshes/RenderableMesh.h"
+#include "PulseEngine/core/Physics/PhysicManager.h"
+#include "PulseEngine/core/SceneManager/SceneManager.h"
+#include "PulseEngine/core/FileManager/Archive/DiskArchive.h"
+#include "PulseEngine/core/FileManager/Pak/PakManager.h"
+#include "camera.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <filesystem>
+#include <limits>
+#include <map>
+#include <thread>
+#include <unordered_set>
+#include <utility>
+
+namespace
+{
+    constexpr int WORLD_INDEX_VERSION = 1;
+    constexpr int MAX_WORLD_CELLS = 1 << 20;
+
+    /**
+     * @brief "Scenes/island.pworld" -> "Scenes/island_cells/"
+     */
+    std::string GetCellDirectory(const std::string& worldPath)
+    {
+        const std::size_t dot = worldPath.find_last_of('.');
+        const std::size_t slash = worldPath.find_last_of("/\\");
+        const bool hasExtension = dot != std::string::npos && (slash == std::string::npos || dot > slash);
+        return (hasExtension ? worldPath.substr(0, dot) : worldPath) + "_cells/";
+    }
+
+    std::string GetCellPath(const std::string& worldPath, int x, int z)
+    {
+        return GetCellDirectory(worldPath) + "cell_" + std::to_string(x) + "_" + std::to_string(z) + ".pmap";
+    }
+
+    std::uint64_t GetEntityMemory(Entity* entity)
+    {
+        std::uint64_t bytes = 0;
+        for (RenderableMesh* mesh : entity->GetMeshes())
+        {
+            if (mesh) bytes += mesh->GetMemorySize();
+        }
+        return bytes;
+    }
+
+    /**
+     * @brief Index file without the lights : header, then the cells.
+     */
+    bool SerializeIndex(Archive& ar, std::string& worldName, float& cellSize, std::vector<WorldCell>& cells)
+    {
+        int version = WORLD_INDEX_VERSION;
+        int cellCount = (int)cells.size();
+        ar.Serialize("worldName", worldName);
+        ar.Serialize("version", version);
+        ar.Serialize("cellSize", cellSize);
+        ar.Serialize("cellCount", cellCount);
+
+        if (ar.IsLoading())
+        {
+            if (version != WORLD_INDEX_VERSION || !(cellSize > 0.0f) || cellCount < 0 || cellCount > MAX_WORLD_CELLS) return false;
+            cells.assign((std::size_t)cellCount, WorldCell());
+        }
+
+        for (WorldCell& cell : cells)
+        {
+            ar.Serialize("x", cell.x);
+            ar.Serialize("z", cell.z);
+            ar.Serialize("path", cell.path);
+            ar.Serialize("entityCount", cell.entityCount);
+            ar.Serialize("minX", cell.bounds.min.x);
+            ar.Serialize("minY", cell.bounds.min.y);
+            ar.Serialize("minZ", cell.bounds.min.z);
+            ar.Serialize("maxX", cell.bounds.max.x);
+            ar.Serialize("maxY", cell.bounds.max.y);
+            ar.Serialize("maxZ", cell.bounds.max.z);
+            ar.Serialize("memoryBytes", cell.memoryBytes);
+        }
+        return true;
+    }
+}
+
+WorldStreamer& WorldStreamer::GetInstance()
+{
+    static WorldStreamer instance;
+    return instance;
+}
+
+bool WorldStreamer::IsWorldFile(const std::string &path)
+{
+    const std::string extension(WORLD_EXTENSION);
+    return path.size() >= extension.size() && path.compare(path.size() - extension.size(), extension.size(), extension) == 0;
+}
+
+bool WorldStreamer::OpenWorld(const std::string &path, PulseEngineBackend *newBackend)
+{
+    PROFILE_TIMER_FUNCTION;
+
+    std::vector<char> bytes;
+    if (!PulseEngine::FileSystem::ReadAssetFile(path, bytes))
+    {
+        EDITOR_WARN("Couldn't open world " << std::string(ASSET_PATH) + path)
+        return false;
+    }
+
+    DiskArchive dar(std::move(bytes), path);
+    std::string worldName;
+    float newCellSize = DEFAULT_CELL_SIZE;
+    std::vector<WorldCell> newCells;
+    if (!SerializeIndex(dar, worldName, newCellSize, newCells))
+    {
+        EDITOR_ERROR("World index " << path << " is invalid or from another version")
+        return false;
+    }
+
+    // the index is valid, the previous scene can go
+    CloseWorld();
+    newBackend->ClearScene();
+    SceneManager::GetInstance()->CleanHierarchyFrom(SceneManager::GetInstance()->GetRoot());
+    SceneLoader::SerializeLights(dar, newBackend->lights);
+
+    backend = newBackend;
+    worldPath = path;
+    cellSize = newCellSize;
+    cells = std::move(newCells);
+    states.assign(cells.size(), CellState());
+    stats = WorldStreamingStats();
+    if (Camera* camera = PulseEngineBackend::GetActiveCamera()) lastCameraPosition = camera->Position;
+
+    SceneLoader::SetActualMap(path);
+    EDITOR_LOG("World " << worldName << " opened : " << cells.size() << " cells of " << cellSize << " units")
+    return true;
+}
+
+void WorldStreamer::CloseWorld()
+{
+    if (!backend) return;
+    PROFILE_TIMER_FUNCTION;
+
+    for (std::size_t i = 0; i < cells.size(); ++i) UnloadCell(i);
+
+    cells.clear();
+    states.clear();
+    worldPath.clear();
+    backend = nullptr;
+    stats = WorldStreamingStats();
+}
+
+void WorldStreamer::Update(const PulseEngine::Vector3 &cameraPosition)
+{
+    Stream(cameraPosition, settings.buildBudgetMs);
+}
+
+void WorldStreamer::Flush()
+{
+    if (!backend) return;
+    PROFILE_TIMER_FUNCTION;
+
+    while (true)
+    {
+        Stream(lastCameraPosition, std::numeric_limits<float>::max());
+        if (stats.loadingCells == 0) break;
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+}
+
+void WorldStreamer::LoadAllCells()
+{
+    if (!backend) return;
+    PROFILE_TIMER_FUNCTION;
+
+    for (std::size_t i = 0; i < cells.size(); ++i)
+    {
+        if (states[i].status == CellStatus::Unloaded || states[i].status == CellStatus::Failed) StartCellLoad(i);
+    }
+
+    while (std::any_of(states.begin(), states.end(), [](const CellState& state) { return state.status == CellStatus::Loading; }))
+    {
+        ProcessLoads(std::numeric_limits<float>::max());
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+}
+
+void WorldStreamer::Stream(const PulseEngine::Vector3 &cameraPosition, float buildBudgetMs)
+{
+    if (!backend) return;
+    PROFILE_TIMER_FUNCTION;
+
+    lastCameraPosition = cameraPosition;
+    stats.cellsLoaded = 0;
+    stats.cellsUnloaded = 0;
+
+    const float unloadRadius = std::max(settings.unloadRadius, settings.loadRadius);
+    std::vector<float> distances(cells.size());
+    for (std::size_t i = 0; i < cells.size(); ++i) distances[i] = DistanceToCell(cameraPosition, i);
+
+    // out of range first : it frees the memory the new cells may need
+    for (std::size_t i = 0; i < cells.size(); ++i)
+    {
+        if (distances[i] <= unloadRadius) continue;
+        if (states[i].status == CellStatus::Resident || states[i].status == CellStatus::Loading) UnloadCell(i);
+        // a cell that couldn't be read is tried again the next time the camera comes close
+        else if (states[i].status == CellStatus::Failed) states[i].status = CellStatus::Unloaded;
+    }
+
+    ProcessLoads(buildBudgetMs);
+
+    std::vector<std::size_t> wanted;
+    for (std::size_t i = 0; i < cells.size(); ++i)
+    {
+        if (states[i].status == CellStatus::Unloaded && distances[i] <= settings.loadRadius) wanted.push_back(i);
+    }
+    std::sort(wanted.begin(), wanted.end(), [&](std::size_t a, std::size_t b) { return distances[a] < distances[b]; });
+
+    std::size_t loading = std::count_if(states.begin(), states.end(), [](const CellState& state) { return state.status == CellStatus::Loading; });
+    std::uint64_t committed = GetCommittedBytes();
+    for (std::size_t cell : wanted)
+    {
+        if (loading >= settings.maxConcurrentLoads) break;
+
+        // make room with the cells of the hysteresis band, the furthest first
+        while (committed + cells[cell].memoryBytes > settings.memoryBudget)
+        {
+            std::size_t evicted = cells.size();
+            for (std::size_t i = 0; i < cells.size(); ++i)
+            {
+                if (states[i].status != CellStatus::Resident || distances[i] <= settings.loadRadius) continue;
+                if (evicted == cells.size() || distances[i] > distances[evicted]) evicted = i;
+            }
+            if (evicted == cells.size()) break;
+
+            UnloadCell(evicted);
+            committed = GetCommittedBytes();
+        }
+
+        // nearest cells are served first, the further ones wait for memory too (a lone cell always fits)
+        if (committed > 0 && committed + cells[cell].memoryBytes > settings.memoryBudget) break;
+
+        StartCellLoad(cell);
+        loading++;
+        committed += cells[cell].memoryBytes;
+    }
+
+    stats.residentCells = std::count_if(states.begin(), states.end(), [](const CellState& state) { return state.status == CellStatus::Resident; });
+    stats.loadingCells = loading;
+    stats.residentBytes = committed;
+
+    PROFILE_COUNTER("World streaming", {
+        {"resident", (double)stats.residentCells},
+        {"loading", (double)stats.loadingCells},
+        {"residentMB", (double)stats.residentBytes / (1024.0 * 1024.0)},
+        {"loaded", (double)stats.cellsLoaded},
+        {"unloaded", (double)stats.cellsUnloaded}
+    });
+}
+
+void WorldStreamer::StartCellLoad(std::size_t cell)
+{
+    CellState& state = states[cell];
+    state.request = SceneLoadRequest::Start(cells[cell].path, backend, false);
+    state.status = CellStatus::Loading;
+}
+
+void WorldStreamer::ProcessLoads(float buildBudgetMs)
+{
+    const auto start = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i < cells.size(); ++i)
+    {
+        CellState& state = states[i];
+        if (state.status != CellStatus::Loading) continue;
+
+        SceneLoadRequest& request = *state.request;
+        if (request.HasFailed())
+        {
+            EDITOR_ERROR("World cell " << cells[i].path << " couldn't be read")
+            state.request.reset();
+            state.status = CellStatus::Failed;
+            continue;
+        }
+
+        const float elapsedMs = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start).count();
+        if (elapsedMs >= buildBudgetMs) break;
+        if (!request.Process(buildBudgetMs - elapsedMs)) continue;
+
+        request.Commit(&state.entities);
+        state.residentBytes = 0;
+        for (Entity* entity : state.entities) state.residentBytes += GetEntityMemory(entity);
+        state.request.reset();
+        state.status = CellStatus::Resident;
+        stats.cellsLoaded++;
+    }
+}
+
+void WorldStreamer::UnloadCell(std::size_t cell)
+{
+    CellState& state = states[cell];
+    if (state.status == CellStatus::Resident) stats.cellsUnloaded++;
+
+    if (state.request)
+    {
+        state.request->Cancel();
+        state.request.reset();
+    }
+    for (Entity* entity : state.entities) DestroyEntity(entity);
+
+    state.entities.clear();
+    state.residentBytes = 0;
+    if (state.status != CellStatus::Failed) state.status = CellStatus::Unloaded;
+}
+
+void WorldStreamer::DestroyEntity(Entity *entity)
+{
+    // deleted meanwhile (editor), or the scene was cleared without the world
+    auto it = std::find(backend->entities.begin(), backend->entities.end(), entity);
+    if (it == backend->entities.end()) return;
+
+    SceneManager::GetInstance()->RemoveEntity(entity);
+    backend->physicManager->DestroyBody(entity->bodyID);
+    // meshes and entity are deleted once the front snapshot stops showing them
+    backend->DeleteEntity(entity);
+}
+
+float WorldStreamer::DistanceToCell(const PulseEngine::Vector3 &position, std::size_t cell) const
+{
+    const WorldCell& c = cells[cell];
+    float minX = (float)c.x * cellSize;
+    float minZ = (float)c.z * cellSize;
+    float maxX = minX + cellSize;
+    float maxZ = minZ + cellSize;
+
+    // entities larger than their cell
+    if (c.bounds.min.x <= c.bounds.max.x)
+    {
+        minX = std::min(minX, c.bounds.min.x);
+        minZ = std::min(minZ, c.bounds.min.z);
+        maxX = std::max(maxX, c.bounds.max.x);
+        maxZ = std::max(maxZ, c.bounds.max.z);
+    }
+
+    const float dx = std::max({ minX - position.x, 0.0f, position.x - maxX });
+    const float dz = std::max({ minZ - position.z, 0.0f, position.z - maxZ });
+    return std::sqrt(dx * dx + dz * dz);
+}
+
+std::uint64_t WorldStreamer::GetCommittedBytes() const
+{
+    std::uint64_t bytes = 0;
+    for (std::size_t i = 0; i < cells.size(); ++i)
+    {
+        if (states[i].status == CellStatus::Resident) bytes += states[i].residentBytes;
+        else if (states[i].status == CellStatus::Loading) bytes += cells[i].memoryBytes;
+    }
+    return bytes;
+}
+
+bool WorldStreamer::SaveWorld(const std::string &worldName, const std::string &path, PulseEngineBackend *saveBackend, float size)
+{
+    PROFILE_TIMER_FUNCTION;
+
+    const bool savingOpenWorld = backend && path == worldPath;
+    if (size <= 0.0f) size = savingOpenWorld ? cellSize : DEFAULT_CELL_SIZE;
+
+    // the cells out of range are not in the backend : load them, or their entities would be lost
+    if (savingOpenWorld)
+    {
+        LoadAllCells();
+        for (std::size_t i = 0; i < cells.size(); ++i)
+        {
+            if (states[i].status == CellStatus::Failed)
+            {
+                EDITOR_ERROR("World " << path << " not saved : cell " << cells[i].path << " couldn't be loaded")
+                return false;
+            }
+        }
+    }
+
+    // ordered by cell, two saves of the same world give the same index
+    std::map<std::pair<int, int>, std::vector<Entity*>> split;
+    for (Entity* entity : saveBackend->entities)
+    {
+        if (dynamic_cast<LightData*>(entity) != nullptr) continue;
+        const PulseEngine::Vector3& position = entity->transform.position;
+        split[{ (int)std::floor(position.x / size), (int)std::floor(position.z / size) }].push_back(entity);
+    }
+
+    std::vector<WorldCell> newCells;
+    std::vector<CellState> newStates;
+    std::vector<LightData*> noLights;
+    for (auto& [coordinates, entities] : split)
+    {
+        WorldCell cell;
+        cell.x = coordinates.first;
+        cell.z = coordinates.second;
+        cell.path = GetCellPath(path, cell.x, cell.z);
+        cell.entityCount = (int)entities.size();
+        for (Entity* entity : entities)
+        {
+            cell.bounds.Expand(entity->GetWorldBounds());
+            cell.memoryBytes += GetEntityMemory(entity);
+        }
+
+        SceneLoader::WriteMapFile(worldName + "_" + std::to_string(cell.x) + "_" + std::to_string(cell.z), cell.path, entities, noLights);
+
+        CellState state;
+        state.status = CellStatus::Resident;
+        state.entities = std::move(entities);
+        state.residentBytes = cell.memoryBytes;
+        newCells.push_back(std::move(cell));
+        newStates.push_back(std::move(state));
+    }
+
+    DiskArchive dar(path, Archive::Mode::Saving);
+    std::string name = worldName;
+    SerializeIndex(dar, name, size, newCells);
+    SceneLoader::SerializeLights(dar, saveBackend->lights);
+    dar.Finalize();
+
+    if (savingOpenWorld)
+    {
+        // cells left empty since the last save
+        std::unordered_set<std::string> written;
+        for (const WorldCell& cell : newCells) written.insert(cell.path);
+        for (const WorldCell& cell : cells)
+        {
+            if (written.count(cell.path)) continue;
+            std::error_code ec;
+            std::filesystem::remove(std::string(ASSET_PATH) + cell.path, ec);
+        }
+
+        cells = std::move(newCells);
+        states = std::move(newStates);
+        cellSize = size;
+    }
+
+    EDITOR_LOG("World " << worldName << " saved : " << split.size() << " cells of " << size << " units")
+    return true;
+}
@@ -0,0 +1,158 @@
+/**
+ * @file WorldStreamer.h
+ * @brief Streamed worlds : a map split into square cells, only the cells around the active camera are in memory.
+ * @details
+ * - A world is an index file (WORLD_EXTENSION) : cell size, then per cell its grid coordinates, its map file, the
+ *   bounds of its entities and the memory of their meshes, then the lights (always loaded, they are few).
+ * - Every cell is a regular .pmap (no lights) next to the index, in "<world>_cells/". SaveWorld writes both, an entity
+ *   goes to the cell under its position.
+ * - Update, once per frame : cells closer to the camera (XZ) than loadRadius are read on the ThreadPool and built on
+ *   the main thread through SceneLoadRequest, cells further than unloadRadius are unloaded. Between the two radii
+ *   nothing changes, so a camera on a cell border does not load and unload it every frame.
+ * - memoryBudget caps the mesh memory of the loaded cells : nearest cells first, cells of the hysteresis band are
+ *   unloaded to make room, further cells wait.
+ * - A cell owns its entities : they enter the SceneManager (hierarchy and spatial partition) and get their physic body
+ *   when the cell is committed, and leave it, body and meshes destroyed, when it is unloaded.
+ * @version 0.1
+ * @date 2025-12-14
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+#ifndef WORLDSTREAMER_H
+#define WORLDSTREAMER_H
+
+#include "Common/common.h"
+#include "Common/dllExport.h"
+#include "PulseEngine/core/Math/Frustum/AABB.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+class Entity;
+class PulseEngineBackend;
+struct SceneLoadRequest;
+
+struct WorldStreamingSettings
+{
+    float loadRadius = 150.0f;                      ///< cells closer than this are loaded
+    float unloadRadius = 200.0f;                    ///< cells further than this are unloaded, >= loadRadius
+    std::uint64_t memoryBudget = 512ull << 20;      ///< mesh bytes of the loaded cells
+    std::size_t maxConcurrentLoads = 2;             ///< cells read and built at the same time
+    float buildBudgetMs = 2.0f;                     ///< main thread time given to the cells being built, per frame
+};
+
+/**
+ * @brief One cell of the world index.
+ */
+struct WorldCell
+{
+    int x = 0;
+    int z = 0;
+    std::string path;                   ///< cell map, relative to ASSET_PATH
+    int entityCount = 0;
+    AABB bounds;                        ///< world bounds of its entities when saved
+    std::uint64_t memoryBytes = 0;      ///< mesh bytes of its entities when saved
+};
+
+struct WorldStreamingStats
+{
+    std::size_t residentCells = 0;
+    std::size_t loadingCells = 0;
+    std::uint64_t residentBytes = 0;    ///< loaded cells, measured, plus the estimate of the cells being loaded
+    std::size_t cellsLoaded = 0;        ///< during the last Update
+    std::size_t cellsUnloaded = 0;
+};
+
+class PULSE_ENGINE_DLL_API WorldStreamer
+{
+public:
+    static constexpr const char* WORLD_EXTENSION = ".pworld";
+    static constexpr float DEFAULT_CELL_SIZE = 64.0f;
+
+    static WorldStreamer& GetInstance();
+    static bool IsWorldFile(const std::string& path);
+
+    WorldStreamer(const WorldStreamer&) = delete;
+    WorldStreamer& operator=(const WorldStreamer&) = delete;
+
+    /**
+     * @brief Replace the scene by the world : the index and the lights are read, no cell is loaded yet.
+     */
+    bool OpenWorld(const std::string& worldPath, PulseEngineBackend* backend);
+
+    /**
+     * @brief Unload every cell, loads in flight are dropped. The lights stay, like for the regular maps.
+     */
+    void CloseWorld();
+    bool IsWorldOpen() const { return backend != nullptr; }
+
+    /**
+     * @brief Load and unload the cells for this camera position. Called once per frame by the engine.
+     */
+    void Update(const PulseEngine::Vector3& cameraPosition);
+
+    /**
+     * @brief Update until every cell needed at the last camera position is loaded (first frame, teleports).
+     */
+    void Flush();
+
+    /**
+     * @brief Load every cell at once, memory budget ignored (editor).
+     */
+    void LoadAllCells();
+
+    /**
+     * @brief Split the entities of the backend into cells and write the index and the cells.
+     * @details Saving the open world loads all its cells first so nothing is lost, then keeps them loaded.
+     * @param cellSize 0 : the one of the open world, or DEFAULT_CELL_SIZE.
+     */
+    bool SaveWorld(const std::string& worldName, const std::string& worldPath, PulseEngineBackend* backend, float cellSize = 0.0f);
+
+    WorldStreamingSettings& GetSettings() { return settings; }
+    const WorldStreamingStats& GetStats() const { return stats; }
+    const std::vector<WorldCell>& GetCells() const { return cells; }
+    float GetCellSize() const { return cellSize; }
+    const std::string& GetWorldPath() const { return worldPath; }
+
+private:
+    enum class CellStatus { Unloaded, Loading, Resident, Failed };
+
+    struct CellState
+    {
+        CellStatus status = CellStatus::Unloaded;
+        std::shared_ptr<SceneLoadRequest> request;
+        std::vector<Entity*> entities;
+        std::uint64_t residentBytes = 0;
+    };
+
+    WorldStreamer() = default;
+    ~WorldStreamer() = default;
+
+    void Stream(const PulseEngine::Vector3& cameraPosition, float buildBudgetMs);
+    void StartCellLoad(std::size_t cell);
+    void UnloadCell(std::size_t cell);
+    /**
+     * @brief Build the loading cells with the budget, the finished ones are committed.
+     */
+    void ProcessLoads(float buildBudgetMs);
+    void DestroyEntity(Entity* entity);
+
+    float DistanceToCell(const PulseEngine::Vector3& position, std::size_t cell) const;
+    std::uint64_t GetCommittedBytes() const;
+
+    PulseEngineBackend* backend = nullptr;
+    std::string worldPath;
+    float cellSize = DEFAULT_CELL_SIZE;
+    std::vector<WorldCell> cells;
+    std::vector<CellState> states;      ///< same order as cells
+
+    PulseEngine::Vector3 lastCameraPosition;
+    WorldStreamingSettings settings;
+    WorldStreamingStats stats;
+};
+
+#endif // WORLDSTREAMER_H
@@ -0,0 +1,334 @@
+#include "OcclusionCuller.h"
+#include "PulseEngine/core/Math/Simd/SimdLanes.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+
+using namespace PulseEngine;
+
+namespace
+{
+    using Lanes = PulseEngine::Simd::WideLanes;
+
+    alignas(32) const float PIXEL_RAMP[8] = { 0.0f, 1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f, 7.0f };
+
+    // unit cube, same corners and faces as the box primitive
+    const Vector3 BOX_CORNERS[8] = {
+        {-0.5f, -0.5f, -0.5f}, { 0.5f, -0.5f, -0.5f}, { 0.5f,  0.5f, -0.5f}, {-0.5f,  0.5f, -0.5f},
+        {-0.5f, -0.5f,  0.5f}, { 0.5f, -0.5f,  0.5f}, { 0.5f,  0.5f,  0.5f}, {-0.5f,  0.5f,  0.5f}
+    };
+    const uint32_t BOX_INDICES[36] = {
+        0, 2, 1,  0, 3, 2,      // back
+        4, 5, 6,  4, 6, 7,      // front
+        0, 1, 5,  0, 5, 4,      // bottom
+        3, 7, 6,  3, 6, 2,      // top
+        0, 4, 7,  0, 7, 3,      // left
+        1, 2, 6,  1, 6, 5       // right
+    };
+
+    float ElapsedMs(std::chrono::steady_clock::time_point start)
+    {
+        return std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start).count();
+    }
+}
+
+OcclusionCuller::OcclusionCuller()
+{
+    int width = WIDTH;
+    int height = HEIGHT;
+
+    Level base;
+    base.width = width;
+    base.height = height;
+    base.maxDepth.assign((std::size_t)width * height, 1.0f);
+    levels.push_back(std::move(base));
+
+    while (width > 1 && height > 1)
+    {
+        width /= 2;
+        height /= 2;
+
+        Level level;
+        level.width = width;
+        level.height = height;
+        level.minDepth.assign((std::size_t)width * height, 1.0f);
+        level.maxDepth.assign((std::size_t)width * height, 1.0f);
+        levels.push_back(std::move(level));
+    }
+}
+
+void OcclusionCuller::BeginFrame(const Mat4& viewProj)
+{
+    this->viewProj = viewProj;
+    std::fill(levels[0].maxDepth.begin(), levels[0].maxDepth.end(), 1.0f);
+    stats = OcclusionStats();
+}
+
+OcclusionCuller::ClipVertex OcclusionCuller::ToClip(const Mat4& modelViewProj, const Vector3& p) const
+{
+    // column major : clip[row] = sum over col of data[col][row] * p[col]
+    const float (*m)[4] = modelViewProj.data;
+    ClipVertex v;
+    v.x = m[0][0] * p.x + m[1][0] * p.y + m[2][0] * p.z + m[3][0];
+    v.y = m[0][1] * p.x + m[1][1] * p.y + m[2][1] * p.z + m[3][1];
+    v.z = m[0][2] * p.x + m[1][2] * p.y + m[2][2] * p.z + m[3][2];
+    v.w = m[0][3] * p.x + m[1][3] * p.y + m[2][3] * p.z + m[3][3];
+    return v;
+}
+
+void OcclusionCuller::RasterizeTriangles(const Vector3* positions, std::size_t positionStride, const uint32_t* indices,
+                                         std::size_t indexCount, const Mat4& model)
+{
+    auto start = std::chrono::steady_clock::now();
+    const Mat4 modelViewProj = viewProj * model;
+    const unsigned char* bytes = reinterpret_cast<const unsigned char*>(positions);
+    auto position = [&](uint32_t index) -> const Vector3& { return *reinterpret_cast<const Vector3*>(bytes + index * positionStride); };
+
+    for (std::size_t i = 0; i + 2 < indexCount; i += 3)
+    {
+        RasterizeClipTriangle(ToClip(modelViewProj, position(indices[i])),
+                              ToClip(modelViewProj, position(indices[i + 1])),
+                              ToClip(modelViewProj, position(indices[i + 2])));
+    }
+
+    stats.occludersDrawn++;
+    stats.rasterMs += ElapsedMs(start);
+}
+
+void OcclusionCuller::RasterizeBox(const Mat4& model)
+{
+    RasterizeTriangles(BOX_CORNERS, BOX_INDICES, 36, model);
+}
+
+void OcclusionCuller::RasterizeClipTriangle(const ClipVertex& a, const ClipVertex& b, const ClipVertex& c)
+{
+    // clip against the near plane (z + w >= 0), a triangle gives at most a quad
+    const ClipVertex input[3] = { a, b, c };
+    ClipVertex polygon[4];
+    int count = 0;
+
+    for (int i = 0; i < 3; ++i)
+    {
+        const ClipVertex& current = input[i];
+        const ClipVertex& next = input[(i + 1) % 3];
+        const float dCurrent = current.z + current.w;
+        const float dNext = next.z + next.w;
+
+        if (dCurrent >= 0.0f)
+            polygon[count++] = current;
+
+        if ((dCurrent >= 0.0f) != (dNext >= 0.0f))
+        {
+            const float t = dCurrent / (dCurrent - dNext);
+            polygon[count++] = {
+                current.x + (next.x - current.x) * t,
+                current.y + (next.y - current.y) * t,
+                current.z + (next.z - current.z) * t,
+                current.w + (next.w - current.w) * t
+            };
+        }
+    }
+    if (count < 3) return;
+
+    float sx[4], sy[4], sz[4];
+    for (int i = 0; i < count; ++i)
+    {
+        const float invW = 1.0f / polygon[i].w;
+        sx[i] = (polygon[i].x * invW * 0.5f + 0.5f) * WIDTH;
+        sy[i] = (polygon[i].y * invW * 0.5f + 0.5f) * HEIGHT;
+        sz[i] = polygon[i].z * invW * 0.5f + 0.5f;
+    }
+
+    for (int i = 1; i + 1 < count; ++i)
+    {
+        const float x[3] = { sx[0], sx[i], sx[i + 1] };
+        const float y[3] = { sy[0], sy[i], sy[i + 1] };
+        const float z[3] = { sz[0], sz[i], sz[i + 1] };
+        RasterizeScreenTriangle(x, y, z);
+        stats.trianglesDrawn++;
+    }
+}
+
+void OcclusionCuller::RasterizeScreenTriangle(const float* xIn, const float* yIn, const float* zIn)
+{
+    float x[3] = { xIn[0], xIn[1], xIn[2] };
+    float y[3] = { yIn[0], yIn[1], yIn[2] };
+    float z[3] = { zIn[0], zIn[1], zIn[2] };
+
+    float area = (x[1] - x[0]) * (y[2] - y[0]) - (x[2] - x[0]) * (y[1] - y[0]);
+    if (std::abs(area) < 1e-6f) return;
+    if (area < 0.0f)
+    {
+        // both windings are drawn, counter clockwise from here
+        std::swap(x[1], x[2]);
+        std::swap(y[1], y[2]);
+        std::swap(z[1], z[2]);
+        area = -area;
+    }
+
+    const int minX = std::max(0, (int)std::floor(std::min({ x[0], x[1], x[2] })));
+    const int maxX = std::min(WIDTH - 1, (int)std::floor(std::max({ x[0], x[1], x[2] })));
+    const int minY = std::max(0, (int)std::floor(std::min({ y[0], y[1], y[2] })));
+    const int maxY = std::min(HEIGHT - 1, (int)std::floor(std::max({ y[0], y[1], y[2] })));
+    if (minX > maxX || minY > maxY) return;
+
+    // edge i goes from vertex i to vertex i + 1, positive inside, sampled at the pixel centers.
+    // Two triangles sharing an edge get exactly opposite values there, so no crack opens between them.
+    float edgeA[3], edgeB[3], edgeC[3];
+    for (int i = 0; i < 3; ++i)
+    {
+        const int j = (i + 1) % 3;
+        edgeA[i] = y[i] - y[j];
+        edgeB[i] = x[j] - x[i];
+        edgeC[i] = x[i] * y[j] - y[i] * x[j];
+    }
+
+    // depth plane, pushed to the farthest value inside the pixel
+    const float dzdx = ((z[1] - z[0]) * (y[2] - y[0]) - (z[2] - z[0]) * (y[1] - y[0])) / area;
+    const float dzdy = ((z[2] - z[0]) * (x[1] - x[0]) - (z[1] - z[0]) * (x[2] - x[0])) / area;
+    const float zOrigin = z[0] - dzdx * x[0] - dzdy * y[0] + 0.5f * (std::abs(dzdx) + std::abs(dzdy));
+
+    const Lanes::Float ramp = Lanes::Load(PIXEL_RAMP);
+    const Lanes::Float a0 = Lanes::Set(edgeA[0]), a1 = Lanes::Set(edgeA[1]), a2 = Lanes::Set(edgeA[2]);
+    const Lanes::Float zero = Lanes::Set(0.0f);
+    const Lanes::Float zdx = Lanes::Set(dzdx);
+
+    float* depth = levels[0].maxDepth.data();
+    const int startX = minX - minX % Lanes::Width;
+
+    for (int row = minY; row <= maxY; ++row)
+    {
+        const float py = row + 0.5f;
+        const Lanes::Float rowE0 = Lanes::Set(edgeB[0] * py + edgeC[0]);
+        const Lanes::Float rowE1 = Lanes::Set(edgeB[1] * py + edgeC[1]);
+        const Lanes::Float rowE2 = Lanes::Set(edgeB[2] * py + edgeC[2]);
+        const Lanes::Float rowZ = Lanes::Set(zOrigin + dzdy * py);
+        float* rowDepth = depth + row * WIDTH;
+
+        for (int column = startX; column <= maxX; column += Lanes::Width)
+        {
+            const Lanes::Float px = Lanes::Add(Lanes::Set(column + 0.5f), ramp);
+            Lanes::Mask outside = Lanes::Less(Lanes::MulAdd(a0, px, rowE0), zero);
+            outside = Lanes::Or(outside, Lanes::Less(Lanes::MulAdd(a1, px, rowE1), zero));
+            outside = Lanes::Or(outside, Lanes::Less(Lanes::MulAdd(a2, px, rowE2), zero));
+            if (Lanes::MoveMask(outside) == PulseEngine::Simd::AllLanesMask<Lanes>()) continue;
+
+            const Lanes::Float pixelDepth = Lanes::MulAdd(zdx, px, rowZ);
+            const Lanes::Float current = Lanes::Load(rowDepth + column);
+            Lanes::Store(rowDepth + column, Lanes::Select(outside, current, Lanes::Min(pixelDepth, current)));
+        }
+    }
+}
+
+void OcclusionCuller::BuildHierarchy()
+{
+    auto start = std::chrono::steady_clock::now();
+
+    for (std::size_t l = 1; l < levels.size(); ++l)
+    {
+        const Level& fine = levels[l - 1];
+        Level& coarse = levels[l];
+
+        for (int ty = 0; ty < coarse.height; ++ty)
+        {
+            for (int tx = 0; tx < coarse.width; ++tx)
+            {
+                const int i00 = (ty * 2) * fine.width + tx * 2;
+                const int i10 = i00 + 1;
+                const int i01 = i00 + fine.width;
+                const int i11 = i01 + 1;
+
+                const int index = ty * coarse.width + tx;
+                coarse.maxDepth[index] = std::max(std::max(fine.maxDepth[i00], fine.maxDepth[i10]), std::max(fine.maxDepth[i01], fine.maxDepth[i11]));
+                coarse.minDepth[index] = std::min(std::min(MinDepthAt((int)l - 1, i00), MinDepthAt((int)l - 1, i10)),
+                                                  std::min(MinDepthAt((int)l - 1, i01), MinDepthAt((int)l - 1, i11)));
+            }
+        }
+    }
+
+    stats.rasterMs += ElapsedMs(start);
+}
+
+float OcclusionCuller::MinDepthAt(int level, int index) const
+{
+    return level == 0 ? levels[0].maxDepth[index] : levels[level].minDepth[index];
+}
+
+bool OcclusionCuller::IsVisible(const AABB& box) const
+{
+    float minX = (float)WIDTH, maxX = 0.0f;
+    float minY = (float)HEIGHT, maxY = 0.0f;
+    float nearest = 1.0f;
+
+    for (int i = 0; i < 8; ++i)
+    {
+        const Vector3 corner((i & 1) ? box.max.x : box.min.x,
+                             (i & 2) ? box.max.y : box.min.y,
+                             (i & 4) ? box.max.z : box.min.z);
+        const ClipVertex clip = ToClip(viewProj, corner);
+
+        // crossing the near plane : too close to be hidden
+        if (clip.z + clip.w < 0.0f || clip.w <= 0.0f) return true;
+
+        const float invW = 1.0f / clip.w;
+        const float sx = (clip.x * invW * 0.5f + 0.5f) * WIDTH;
+        const float sy = (clip.y * invW * 0.5f + 0.5f) * HEIGHT;
+        minX = std::min(minX, sx); maxX = std::max(maxX, sx);
+        minY = std::min(minY, sy); maxY = std::max(maxY, sy);
+        nearest = std::min(nearest, clip.z * invW * 0.5f + 0.5f);
+    }
+
+    // outside of the buffer : the frustum culling already decided
+    if (maxX < 0.0f || minX >= WIDTH || maxY < 0.0f || minY >= HEIGHT) return true;
+
+    const int x0 = std::clamp((int)std::floor(minX), 0, WIDTH - 1);
+    const int x1 = std::clamp((int)std::floor(maxX), 0, WIDTH - 1);
+    const int y0 = std::clamp((int)std::floor(minY), 0, HEIGHT - 1);
+    const int y1 = std::clamp((int)std::floor(maxY), 0, HEIGHT - 1);
+
+    // coarsest useful level : the rectangle covers at most 2x2 texels
+    int level = 0;
+    while (level + 1 < (int)levels.size() && ((x1 >> level) - (x0 >> level) > 1 || (y1 >> level) - (y0 >> level) > 1))
+        ++level;
+
+    bool undecided = false;
+    const Level& coarse = levels[level];
+    for (int ty = y0 >> level; ty <= (y1 >> level); ++ty)
+    {
+        for (int tx = x0 >> level; tx <= (x1 >> level); ++tx)
+        {
+            const int index = ty * coarse.width + tx;
+            if (nearest > coarse.maxDepth[index]) continue;         // behind everything drawn in this texel
+            if (nearest < MinDepthAt(level, index)) return true;    // in front of everything drawn in this texel
+            undecided = true;
+        }
+    }
+    if (!undecided) return false;
+
+    // up to 8x8 texels on a finer level
+    const int fineLevel = std::max(0, level - 2);
+    const Level& fine = levels[fineLevel];
+    for (int ty = y0 >> fineLevel; ty <= (y1 >> fineLevel); ++ty)
+    {
+        for (int tx = x0 >> fineLevel; tx <= (x1 >> fineLevel); ++tx)
+        {
+            if (nearest <= fine.maxDepth[ty * fine.width + tx]) return true;
+        }
+    }
+    return false;
+}
+
+void OcclusionCuller::TestBounds(const AABB* boxes, std::size_t count, uint8_t* outVisible)
+{
+    auto start = std::chrono::steady_clock::now();
+
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        outVisible[i] = IsVisible(boxes[i]) ? 1 : 0;
+        if (!outVisible[i]) stats.objectsCulled++;
+    }
+    stats.objectsTested += (uint32_t)count;
+
+    stats.testMs += ElapsedMs(start);
+}
@@ -0,0 +1,123 @@
+/**
+ * @file OcclusionCuller.h
+ * @brief Software occlusion culling : occluders are rasterized into a small CPU depth buffer, then bounds are tested against it.
+ * @details Everything runs on the CPU (no graphic API needed, works on headless builds).
+ * - Occluders are sampled at the pixel centers and write the farthest depth the triangle reaches inside the pixel,
+ *   so an occluder never hides what is right behind its surface. Silhouettes are exact to half a pixel, as on the GPU.
+ * - The depth buffer is reduced into a min/max hierarchy. A bound is tested on the level where its screen rectangle
+ *   covers at most 2x2 texels : farther than the max -> hidden there, nearer than the min -> visible, otherwise a finer
+ *   level decides.
+ * - Rows are filled Lanes::Width pixels at a time (see SimdLanes.h).
+ *
+ * Depth is the OpenGL window depth (0 near plane, 1 far plane) computed from the view projection given to BeginFrame.
+ * @version 0.1
+ * @date 2025-12-07
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+#ifndef OCCLUSIONCULLER_H
+#define OCCLUSIONCULLER_H
+
+#include "Common/dllExport.h"
+#include "PulseEngine/core/Math/Vector.h"
+#include "PulseEngine/core/Math/Mat4.h"
+#include "PulseEngine/core/Math/Frustum/AABB.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief Counters of the last frame, also sent to the profiler by SceneManager.
+ */
+struct OcclusionStats
+{
+    uint32_t occludersDrawn = 0;
+    uint32_t trianglesDrawn = 0;    ///< after near plane clipping
+    uint32_t objectsTested = 0;
+    uint32_t objectsCulled = 0;
+    float rasterMs = 0.0f;          ///< occluders + hierarchy
+    float testMs = 0.0f;
+};
+
+class PULSE_ENGINE_DLL_API OcclusionCuller
+{
+public:
+    static constexpr int WIDTH = 256;
+    static constexpr int HEIGHT = 128;
+
+    OcclusionCuller();
+
+    /**
+     * @brief Clear the depth buffer and the stats for a new view.
+     * @param viewProj projection * view, column major like every Mat4 of the engine.
+     */
+    void BeginFrame(const PulseEngine::Mat4& viewProj);
+
+    /**
+     * @brief Rasterize an indexed triangle list (3 indices per triangle) transformed by model.
+     * @param positionStride bytes from one position to the next, sizeof(Vertex) to read the positions of a mesh in place.
+     */
+    void RasterizeTriangles(const PulseEngine::Vector3* positions, std::size_t positionStride, const uint32_t* indices,
+                            std::size_t indexCount, const PulseEngine::Mat4& model);
+    void RasterizeTriangles(const PulseEngine::Vector3* positions, const uint32_t* indices, std::size_t indexCount, const PulseEngine::Mat4& model)
+    {
+        RasterizeTriangles(positions, sizeof(PulseEngine::Vector3), indices, indexCount, model);
+    }
+
+    /**
+     * @brief Rasterize the unit cube [-0.5, 0.5] transformed by model.
+     * @note only for a box inside the occluder : a box enclosing it would hide what is seen around its surface.
+     */
+    void RasterizeBox(const PulseEngine::Mat4& model);
+
+    /**
+     * @brief Build the min/max hierarchy, to call once every occluder is drawn and before the tests.
+     */
+    void BuildHierarchy();
+
+    /**
+     * @brief Test a world space box. A box crossing the near plane is always visible.
+     */
+    bool IsVisible(const AABB& box) const;
+
+    /**
+     * @brief Test count boxes, outVisible[i] = 1 when box i is visible. Updates the stats.
+     */
+    void TestBounds(const AABB* boxes, std::size_t count, uint8_t* outVisible);
+
+    const OcclusionStats& GetStats() const { return stats; }
+    bool HasOccluders() const { return stats.occludersDrawn > 0; }
+
+    /**
+     * @brief Depth buffer, WIDTH * HEIGHT floats, row 0 at the bottom of the screen (debug view).
+     */
+    const float* GetDepthBuffer() const { return levels[0].maxDepth.data(); }
+
+private:
+    struct ClipVertex
+    {
+        float x, y, z, w;
+    };
+
+    struct Level
+    {
+        int width = 0;
+        int height = 0;
+        std::vector<float> minDepth;    ///< empty on level 0, min == max there
+        std::vector<float> maxDepth;
+    };
+
+    ClipVertex ToClip(const PulseEngine::Mat4& modelViewProj, const PulseEngine::Vector3& p) const;
+    void RasterizeClipTriangle(const ClipVertex& a, const ClipVertex& b, const ClipVertex& c);
+    void RasterizeScreenTriangle(const float* x, const float* y, const float* z);
+
+    float MinDepthAt(int level, int index) const;
+
+    PulseEngine::Mat4 viewProj;
+    std::vector<Level> levels;
+    OcclusionStats stats;
+};
+
+#endif // OCCLUSIONCULLER_H
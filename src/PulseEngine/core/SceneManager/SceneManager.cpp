@@ -6,15 +6,19 @@
 #include "PulseEngine/core/Lights/LightManager.h"
 #include "PulseEngine/core/SceneManager/SpatialPartition/SpatialPartition.h"
 #include "PulseEngine/core/SceneManager/SpatialPartition/SimpleSpatial/SimpleSpatial.h"
+#include "PulseEngine/core/SceneManager/Occlusion/OcclusionCuller.h"
+#include "PulseEngine/core/Profiler/Profiler.h"
 #include "PulseEngine/core/Physics/Collider/Collider.h"
 #include "PulseEngine/core/Physics/Collider/BoxCollider.h"
-#include "PulseEngine/core/Physics/CollisionManager.h"
 #include "PulseEngine/core/Lights/Lights.h"
 #include "PulseEngine/core/PulseScript/PulseScriptsManager.h"
 #include "PulseEngine/core/PulseScript/utilities.h"
 #include "PulseEngine/core/PulseScript/PulseScript.h"
 #include "PulseEngine/core/Graphics/TextRenderer.h"
 #include "PulseEngine/core/Graphics/IGraphicsApi.h"
+#include "PulseEngine/core/Meshes/RenderableMesh.h"
+#include "PulseEngine/core/Graphics/RenderSnapshot/RenderSnapshot.h"
+#include "PulseEngine/core/Graphics/MaterialBatch/MaterialBatcher.h"
 
 #include <algorithm>
 
@@ -25,6 +29,7 @@ SceneManager *SceneManager::GetInstance()
     {
         sm = new SceneManager;
         sm->spatialPartition = new SimpleSpatialPartition;
+        sm->occlusionCuller = new OcclusionCuller;
     } 
     return sm;
 }
@@ -42,6 +47,34 @@ void SceneManager::InsertEntity(Entity *entity, PulseEngine::Transform *parent)
     spatialPartition->Insert(entity);
 }
 
+void SceneManager::RemoveEntity(Entity *entity)
+{
+    if (!entity) return;
+    spatialPartition->Remove(entity);
+
+    auto itEnt = allEntities.find(&entity->transform);
+    if (itEnt == allEntities.end()) return;
+    HierarchyEntity* entHie = itEnt->second;
+
+    std::vector<HierarchyEntity*>* siblings = &root.children;
+    if (entity->transform.parent)
+    {
+        auto parentIt = allEntities.find(entity->transform.parent);
+        if (parentIt != allEntities.end() && parentIt->second) siblings = &parentIt->second->children;
+    }
+    auto it = FindEntityInNodeChildren(*siblings, entity);
+    if (it != siblings->end()) siblings->erase(it);
+
+    for (HierarchyEntity* child : entHie->children)
+    {
+        child->entity->transform.parent = nullptr;
+        root.children.push_back(child);
+    }
+
+    allEntities.erase(itEnt);
+    delete entHie;
+}
+
 void SceneManager::ChangeEntityParent(Entity *entity, PulseEngine::Transform *newParent)
 {
     if (!entity) { EDITOR_ERROR("ChangeEntityParent: null entity"); return; }
@@ -128,59 +161,142 @@ void SceneManager::UpdateScene()
     for (auto& [transform, node] : allEntities)
         spatialPartition->Update(node->entity);
 
-    //after moving them, we can check for physics collision, and move them back to their original place if they are colliding.
-    for(auto trans : allEntities)
-    {
-        Entity* entA = trans.second->entity;
-        for(auto trans : allEntities)
-        {
-            Entity* entB = trans.second->entity;
-            CollisionManager::ManageCollision(dynamic_cast<Collider*>(entA->collider), dynamic_cast<Collider*>(entB->collider));
-
-        }
-    }
+    // collisions are no longer tested here : the physic step reports them through PhysicManager contact events,
+    // which also fill Collider::othersCollider for the colliders that still read it.
 }
 
-void SceneManager::RenderScene()
+void SceneManager::CaptureRenderSnapshot(RenderSnapshot& snapshot, const RenderView& view)
 {
+    PROFILE_TIMER_FUNCTION;
 
+    // the frustum reads PulseEngineInstance->view/projection : view must be made from them
     std::vector<Entity*> visible;
-
     GetEntitiesInFrustum(visible);
 
-    std::vector<Variable> args;
-    for(Entity* ent : visible)
+    snapshot.Capture(view, PulseEngineInstance->entities, visible, PulseEngineInstance->lights);
+}
+
+void SceneManager::RenderScene(const RenderSnapshot& snapshot)
+{
+    RenderableMesh::ResetDrawStats();
+
+    LightManager::PrepareView(snapshot);
+
+    // instanced by mesh asset and texture arrays, what can't be batched is drawn per object below
+    PulseEngine::Graphics::MaterialBatcher::Render(snapshot, unbatchedObjects);
+
+    const RenderView& camera = snapshot.view;
+    for (std::uint32_t index : unbatchedObjects)
     {
-        if(dynamic_cast<LightData*>(ent)) continue; //a light cant be rendered to scene (for now)
-        Entity* drawable = ent;
-        Shader* shader = drawable->GetMaterial()->GetShader();
+        const RenderObject& object = snapshot.objects[index];
+        if (!object.material) continue;
+        Shader* shader = object.material->GetShader();
 
+        // the API skips what the previous object already bound : same material, same state, same program
+        PulseEngineGraphicsAPI->SetPipelineState(object.pipelineState);
         shader->Use();
-        shader->SetMat4("projection", PulseEngineInstance->projection);
-        shader->SetMat4("view", PulseEngineInstance->view);
-        shader->SetVec3("viewPos", PulseEngineInstance->GetActiveCamera()->Position);
+        shader->SetMat4("projection", camera.projection);
+        shader->SetMat4("view", camera.view);
+        shader->SetVec3("viewPos", camera.position);
+
+        LightManager::BindLightsToShader(shader, object.color);
 
-        LightManager::BindLightsToShader(shader, PulseEngineInstance, drawable);
+        snapshot.DrawObject(object, shader);
+    }
+    // the overlays and the next passes expect the default state
+    PulseEngineGraphicsAPI->SetPipelineState(PipelineState());
+
+    const MeshDrawStats& meshStats = RenderableMesh::GetDrawStats();
+    PROFILE_COUNTER("Mesh LOD", {
+        {"meshes", (double)meshStats.meshes},
+        {"triangles", (double)meshStats.triangles},
+        {"trianglesLod0", (double)meshStats.trianglesLod0}
+    });
+
+    // RenderEntityHierarchy(&root);
+}
 
-        // drawable->DrawEntity();
-        drawable->DrawMeshWithShader(shader);
-        drawable->collider->lineTraceShader->Use();
-        drawable->collider->lineTraceShader->SetMat4("view", PulseEngineInstance->view);
-        drawable->collider->lineTraceShader->SetMat4("projection", PulseEngineInstance->projection);
-        
-        drawable->collider->OnRender();
+void SceneManager::RenderSceneOverlays(const RenderSnapshot& snapshot)
+{
+    std::vector<Variable> args;
+    for (std::uint32_t index : snapshot.visible)
+    {
+        Entity* ent = snapshot.objects[index].entity;
+
+        // submits its box to DebugDraw, flushed by PulseEngineBackend::Render
+        ent->collider->OnRender();
 
         ent->runtimeScripts->ExecuteMethodOnEachScript("Render", args);
     }
+}
 
-    // RenderEntityHierarchy(&root);
+void SceneManager::GetEntitiesInFrustum(std::vector<Entity *> &visible, bool occlusionCulling)
+{
+    spatialPartition->Query(GetCameraFrustum(), visible);
+
+    if (occlusionCulling && occlusionCullingEnabled)
+        CullOccludedEntities(visible);
 }
 
-void SceneManager::GetEntitiesInFrustum(std::vector<Entity *> &visible)
+void SceneManager::CullOccludedEntities(std::vector<Entity *> &visible)
 {
-    Frustum frust;
-    frust.ExtractFromMatrix(PulseEngineInstance->view * PulseEngineInstance->projection);
-    spatialPartition->Query(frust, visible);
+    PROFILE_TIMER_FUNCTION;
+
+    // GetCameraFrustum just refreshed cameraFrustumMatrix
+    occlusionCuller->BeginFrame(cameraFrustumMatrix);
+    // the mesh triangles, not a box : the scaled unit cube sticks out of most shapes and would hide what is seen around them
+    for (Entity* ent : visible)
+    {
+        if (!ent->HasTag(OCCLUDER_TAG)) continue;
+        for (const RenderableMesh* mesh : ent->GetMeshes())
+            mesh->RasterizeOccluder(*occlusionCuller);
+    }
+    if (!occlusionCuller->HasOccluders()) return;
+    occlusionCuller->BuildHierarchy();
+
+    // the occluders themselves are kept, everything else is tested
+    occlusionBounds.clear();
+    for (Entity* ent : visible)
+        occlusionBounds.push_back(ent->GetWorldBounds());
+
+    occlusionVisible.resize(visible.size());
+    occlusionCuller->TestBounds(occlusionBounds.data(), occlusionBounds.size(), occlusionVisible.data());
+
+    std::size_t kept = 0;
+    for (std::size_t i = 0; i < visible.size(); ++i)
+    {
+        if (occlusionVisible[i] || visible[i]->HasTag(OCCLUDER_TAG))
+            visible[kept++] = visible[i];
+    }
+    visible.resize(kept);
+
+    const OcclusionStats& stats = occlusionCuller->GetStats();
+    PROFILE_COUNTER("Occlusion", {
+        {"occluders", (double)stats.occludersDrawn},
+        {"tested", (double)stats.objectsTested},
+        {"culled", (double)stats.objectsCulled},
+        {"rasterMs", (double)stats.rasterMs},
+        {"testMs", (double)stats.testMs}
+    });
+}
+
+const OcclusionStats& SceneManager::GetOcclusionStats() const
+{
+    return occlusionCuller->GetStats();
+}
+
+const Frustum& SceneManager::GetCameraFrustum()
+{
+    // called several times per frame (render, casts, editor), the planes only change with the camera
+    // Mat4 is column major : projection * view, like the shaders
+    PulseEngine::Mat4 viewProj = PulseEngineInstance->projection * PulseEngineInstance->view;
+    if (!cameraFrustumValid || memcmp(viewProj.data, cameraFrustumMatrix.data, sizeof(viewProj.data)) != 0)
+    {
+        cameraFrustum.ExtractFromMatrix(viewProj);
+        cameraFrustumMatrix = viewProj;
+        cameraFrustumValid = true;
+    }
+    return cameraFrustum;
 }
 
 void SceneManager::RegenerateHierarchy(MapTransforms MapTransforms)
@@ -215,6 +331,7 @@ void SceneManager::CleanHierarchyFrom(HierarchyEntity *top)
     for(auto& child : top->children)
     {
         CleanHierarchyFrom(child);
+        spatialPartition->Remove(child->entity);
 
         auto it = allEntities.find(&child->entity->transform);
         if (it != allEntities.end()) {
@@ -251,7 +368,7 @@ void SceneManager::RenderEntityHierarchy(HierarchyEntity *top)
     shader->SetMat4("view", PulseEngineInstance->view);
     shader->SetVec3("viewPos", PulseEngineInstance->GetActiveCamera()->Position);
 
-    LightManager::BindLightsToShader(shader, PulseEngineInstance, drawable);
+    LightManager::BindLightsToShader(shader, drawable->GetMaterial()->color);
 
     top->entity->DrawEntity();
     for(HierarchyEntity* child : top->children)
@@ -15,10 +15,15 @@
 #include "common/common.h"
 #include "common/dllExport.h"
 #include "PulseEngine/core/PulseObject/PulseObject.h"
+#include "PulseEngine/core/Math/Frustum/Frustum.h"
 
 
 class Entity;
 class SpatialPartition;
+class OcclusionCuller;
+struct OcclusionStats;
+class RenderSnapshot;
+struct RenderView;
 
 struct HierarchyEntity
 {
@@ -45,14 +50,53 @@ public:
     static SceneManager* GetInstance();
 
     void InsertEntity(Entity* entity, PulseEngine::Transform* parent = nullptr);
+    /**
+     * @brief Take an entity out of the hierarchy and the spatial partition, its children are attached to the root.
+     * @note the entity itself is not deleted.
+     */
+    void RemoveEntity(Entity* entity);
     void ChangeEntityParent(Entity *entity, PulseEngine::Transform *newParent);
     std::vector<HierarchyEntity *>::iterator FindEntityInNodeChildren(std::vector<HierarchyEntity *> &childRoot, Entity *entity);
     HierarchyEntity* GetRoot() {return &root;}
 
     void UpdateScene();
-    void RenderScene();
 
-    void GetEntitiesInFrustum(std::vector<Entity *> &visible);
+    /**
+     * @brief Cull the scene from view and copy the frame in snapshot, on the simulation side (see RenderSnapshot).
+     */
+    void CaptureRenderSnapshot(RenderSnapshot& snapshot, const RenderView& view);
+
+    /**
+     * @brief Draw the visible entities of snapshot, reads nothing of the live scene.
+     */
+    void RenderScene(const RenderSnapshot& snapshot);
+
+    /**
+     * @brief Collider lines and the "Render" callbacks of the scripts of the visible entities. They read the live
+     * entities : only while the simulation waits, with the snapshot it just captured.
+     */
+    void RenderSceneOverlays(const RenderSnapshot& snapshot);
+
+    /**
+     * @brief Entities inside the camera frustum.
+     * @param occlusionCulling also remove the entities hidden behind the occluders (entities tagged OCCLUDER_TAG).
+     */
+    void GetEntitiesInFrustum(std::vector<Entity *> &visible, bool occlusionCulling = true);
+
+    /**
+     * @brief Entities with this tag draw the triangles of their static meshes, at a low LOD, in the occlusion depth
+     * buffer (buildings, walls, terrain blocks). See RenderableMesh::RasterizeOccluder.
+     */
+    static constexpr const char* OCCLUDER_TAG = "Occluder";
+
+    void SetOcclusionCulling(bool enabled) { occlusionCullingEnabled = enabled; }
+    bool IsOcclusionCullingEnabled() const { return occlusionCullingEnabled; }
+    const OcclusionStats& GetOcclusionStats() const;
+
+    /**
+     * @brief Frustum of the active view/projection, extracted again only when one of them changed.
+     */
+    const Frustum& GetCameraFrustum();
 
     void RegenerateHierarchy(MapTransforms MapTransforms);
 
@@ -66,10 +110,22 @@ private:
     void UpdateEntityHierarchy(HierarchyEntity *top, PulseEngine::Mat4 parentMatrix);
     void RenderEntityHierarchy(HierarchyEntity *top);
 
+    void CullOccludedEntities(std::vector<Entity *> &visible);
+
     MapTransforms allEntities;
     HierarchyEntity root;
     SpatialPartition* spatialPartition;
 
+    Frustum cameraFrustum;
+    PulseEngine::Mat4 cameraFrustumMatrix;
+    bool cameraFrustumValid = false;
+
+    OcclusionCuller* occlusionCuller = nullptr;
+    bool occlusionCullingEnabled = true;
+    std::vector<AABB> occlusionBounds;
+    std::vector<uint8_t> occlusionVisible;
+
+    std::vector<std::uint32_t> unbatchedObjects;    ///< filled by MaterialBatcher::Render, drawn per object
 };
 
 #endif
\ No newline at end of file
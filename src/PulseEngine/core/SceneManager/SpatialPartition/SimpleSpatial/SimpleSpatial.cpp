@@ -5,7 +5,13 @@
 #include "PulseEngine/core/PulseScript/PulseScript.h"
 #include "PulseEngine/core/PulseScript/PulseScriptsManager.h"
 #include "PulseEngine/core/PulseScript/utilities.h"
+#include "PulseEngine/core/Threading/ThreadPool.h"
 
+namespace
+{
+    // some 40 us of culling per job (FrustumCullingBench), a multiple of 32 so the ranges share no mask word (see FrustumCulling.h)
+    constexpr std::size_t BOUNDS_PER_CHUNK = 8192;
+}
 
 void SimpleSpatialPartition::Serialize(Archive& ar)
 {
@@ -36,8 +42,6 @@ void SimpleSpatialPartition::Remove(Entity *entity)
 
 void SimpleSpatialPartition::Update(Entity * entity)
 {
-    entity->collider->othersCollider.clear();
-
     std::vector<Variable> args;
     Variable dt;
     dt.isGlobal = false;
@@ -52,14 +56,42 @@ void SimpleSpatialPartition::Query(const Frustum &frustum, std::vector<Entity *>
         outEntities.clear();
         outEntities.reserve(entities.size());
 
+        bounds.Clear();
+        boundsOwners.clear();
+        bounds.Reserve(entities.size());
+        boundsOwners.reserve(entities.size());
+
         for (Entity* e : entities)
         {
-                outEntities.push_back(e);
             if (!e) continue;
 
-            AABB aabb = AABB(e->GetPosition() - PulseEngine::Vector3(0.5f), e->GetPosition() + PulseEngine::Vector3(0.5f));
-            if (frustum.IntersectsAABB(aabb))
-                outEntities.push_back(e);
+            bounds.Add(e->GetWorldBounds());
+            boundsOwners.push_back(e);
+        }
+
+        visibleMask.resize(PulseEngine::Culling::VisibilityMaskWords(bounds.Size()));
+        const std::size_t count = bounds.Size();
+        PulseEngine::Threading::ThreadPool& pool = PulseEngine::Threading::ThreadPool::GetInstance();
+        if (count > BOUNDS_PER_CHUNK && pool.GetWorkerCount() > 0)
+        {
+            // each job writes the mask words of its own range, the planes are unpacked once for all of them
+            const PulseEngine::Culling::CullingPlanes planes(frustum);
+            cullingCache.Resize(count);
+            pool.ParallelFor((count + BOUNDS_PER_CHUNK - 1) / BOUNDS_PER_CHUNK, [&](std::size_t chunk)
+            {
+                const std::size_t begin = chunk * BOUNDS_PER_CHUNK;
+                PulseEngine::Culling::CullAABBs(planes, bounds, begin, std::min(count, begin + BOUNDS_PER_CHUNK), visibleMask.data(), &cullingCache);
+            });
+        }
+        else
+        {
+            PulseEngine::Culling::CullAABBs(frustum, bounds, visibleMask.data(), &cullingCache);
+        }
+
+        for (std::size_t i = 0; i < boundsOwners.size(); ++i)
+        {
+            if (PulseEngine::Culling::IsVisible(visibleMask.data(), i))
+                outEntities.push_back(boundsOwners[i]);
         }
     }
 
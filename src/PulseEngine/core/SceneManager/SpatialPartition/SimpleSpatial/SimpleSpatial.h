@@ -3,6 +3,7 @@
 
 #include "PulseEngine/core/SceneManager/SpatialPartition/SpatialPartition.h"
 #include "PulseEngine/core/Math/Frustum/Frustum.h"
+#include "PulseEngine/core/Math/Frustum/FrustumCulling.h"
 #include "PulseEngine/core/Entity/Entity.h"
 
 #include <vector>
@@ -36,6 +37,12 @@ public:
 
 private:
     std::vector<Entity*> entities;
+
+    // reused by Query : bounds of the non null entities, in the same order as boundsOwners
+    PulseEngine::Culling::BoundsArray bounds;
+    std::vector<Entity*> boundsOwners;
+    std::vector<uint32_t> visibleMask;
+    PulseEngine::Culling::CullingCache cullingCache;
 };
 
 #endif
\ No newline at end of file
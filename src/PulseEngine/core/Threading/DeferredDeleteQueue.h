@@ -0,0 +1,89 @@
+/**
+ * @file DeferredDeleteQueue.h
+ * @brief Objects removed from the scene, deleted once no render snapshot can show them.
+ * @details The front snapshot keeps pointers to what it draws until the next swap (see PulseEngineBackend) :
+ * - Push : removed from the scene, the back snapshot being captured can still show it,
+ * - MarkCaptured : just before a capture, what was pushed so far is not in it,
+ * - Release : just after the swap, what the new front snapshot can't show is deleted.
+ * An object pushed after a capture waits one more swap. Push and MarkCaptured can run on the simulation thread.
+ * @version 0.1
+ * @date 2025-12-14
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+#ifndef DEFERREDDELETEQUEUE_H
+#define DEFERREDDELETEQUEUE_H
+
+#include <cstddef>
+#include <mutex>
+#include <unordered_set>
+#include <vector>
+
+namespace PulseEngine::Threading
+{
+    template <typename T>
+    class DeferredDeleteQueue
+    {
+    public:
+        /// @brief Queue object, a pointer already queued is ignored (an editor light is both an entity and a light).
+        void Push(T* object)
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (object && queued.insert(object).second) removed.push_back(object);
+        }
+
+        /// @brief Push every object of the list, then empty it.
+        template <typename U>
+        void PushAll(std::vector<U*>& objects)
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            for (U* object : objects)
+            {
+                if (object && queued.insert(object).second) removed.push_back(object);
+            }
+            objects.clear();
+        }
+
+        /// @brief Before the capture of the back snapshot : what is queued now is not in it.
+        void MarkCaptured()
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            uncaptured.insert(uncaptured.end(), removed.begin(), removed.end());
+            removed.clear();
+        }
+
+        /**
+         * @brief After the swap : call destroy on every object queued before the capture of the front snapshot.
+         * @return objects destroyed.
+         */
+        template <typename Destroy>
+        std::size_t Release(Destroy destroy)
+        {
+            std::vector<T*> released;
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                released.swap(uncaptured);
+                // the addresses can be given to new objects from now on
+                for (T* object : released) queued.erase(object);
+            }
+            for (T* object : released) destroy(object);
+            return released.size();
+        }
+
+        /// @brief Objects queued and not destroyed yet.
+        std::size_t GetPendingCount() const
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            return queued.size();
+        }
+
+    private:
+        mutable std::mutex mutex;
+        std::unordered_set<T*> queued;
+        std::vector<T*> removed;        ///< since the last capture, the back snapshot can still show them
+        std::vector<T*> uncaptured;     ///< before the capture of the back snapshot : released at the swap
+    };
+}
+
+#endif // DEFERREDDELETEQUEUE_H
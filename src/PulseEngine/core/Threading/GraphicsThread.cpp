@@ -0,0 +1,46 @@
+#include "GraphicsThread.h"
+
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace
+{
+    // set once before the other threads start, read only afterwards
+    std::thread::id graphicsThread;
+
+    std::mutex jobsMutex;
+    std::vector<std::function<void()>> pendingJobs;
+}
+
+void PulseEngine::Threading::SetGraphicsThread()
+{
+    graphicsThread = std::this_thread::get_id();
+}
+
+bool PulseEngine::Threading::IsGraphicsThread()
+{
+    return graphicsThread == std::thread::id() || graphicsThread == std::this_thread::get_id();
+}
+
+void PulseEngine::Threading::RunOnGraphicsThread(std::function<void()> job)
+{
+    if (IsGraphicsThread())
+    {
+        job();
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(jobsMutex);
+    pendingJobs.push_back(std::move(job));
+}
+
+void PulseEngine::Threading::ProcessGraphicsJobs()
+{
+    std::vector<std::function<void()>> jobs;
+    {
+        std::lock_guard<std::mutex> lock(jobsMutex);
+        jobs.swap(pendingJobs);
+    }
+    for (std::function<void()>& job : jobs) job();
+}
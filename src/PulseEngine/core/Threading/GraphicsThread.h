@@ -0,0 +1,38 @@
+/**
+ * @file GraphicsThread.h
+ * @brief The thread that owns the graphic context, and the jobs the other threads leave for it.
+ * @details The main thread creates the context (PulseEngineBackend::Initialize) and is the only one allowed to call
+ * the graphic API. The simulation thread (see SimulationThread.h) can still create or delete meshes, textures and
+ * entities from the scripts : what needs the context is posted here and run at the next sync point of the frame,
+ * while the simulation waits.
+ * @version 0.1
+ * @date 2025-12-14
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+#ifndef GRAPHICSTHREAD_H
+#define GRAPHICSTHREAD_H
+
+#include "Common/dllExport.h"
+
+#include <functional>
+
+namespace PulseEngine::Threading
+{
+    /// @brief The calling thread owns the graphic context from now on.
+    PULSE_ENGINE_DLL_API void SetGraphicsThread();
+
+    /// @brief True on the graphics thread, and everywhere before SetGraphicsThread (tools, single thread).
+    PULSE_ENGINE_DLL_API bool IsGraphicsThread();
+
+    /**
+     * @brief Run job on the graphics thread : right now when called from it, else at the next ProcessGraphicsJobs.
+     */
+    PULSE_ENGINE_DLL_API void RunOnGraphicsThread(std::function<void()> job);
+
+    /// @brief Run the jobs posted by the other threads, in order. Graphics thread only.
+    PULSE_ENGINE_DLL_API void ProcessGraphicsJobs();
+}
+
+#endif // GRAPHICSTHREAD_H
@@ -0,0 +1,54 @@
+#include "SimulationThread.h"
+
+using namespace PulseEngine::Threading;
+
+SimulationThread::SimulationThread(Step step) : step(std::move(step))
+{
+    thread = std::thread(&SimulationThread::Loop, this);
+}
+
+SimulationThread::~SimulationThread()
+{
+    Wait();
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    kicked.notify_one();
+    thread.join();
+}
+
+void SimulationThread::Kick()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        running = true;
+    }
+    kicked.notify_one();
+}
+
+void SimulationThread::Wait()
+{
+    std::unique_lock<std::mutex> lock(mutex);
+    done.wait(lock, [this] { return !running; });
+}
+
+void SimulationThread::Loop()
+{
+    while (true)
+    {
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            kicked.wait(lock, [this] { return stopping || running; });
+            if (stopping) return;
+        }
+
+        step();
+
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            running = false;
+        }
+        done.notify_all();
+    }
+}
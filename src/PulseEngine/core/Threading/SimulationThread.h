@@ -0,0 +1,62 @@
+/**
+ * @file SimulationThread.h
+ * @brief One worker thread running a step (the simulation of a frame) each time it is kicked.
+ * @details The main thread kicks the step, draws the last frame meanwhile, then waits for it : Kick and Wait
+ * alternate, a step never overlaps the next one. Unlike the ThreadPool jobs the step keeps the same thread every
+ * frame, the scripts and the physics always see one thread.
+ * @version 0.1
+ * @date 2025-12-14
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+#ifndef SIMULATIONTHREAD_H
+#define SIMULATIONTHREAD_H
+
+#include "Common/dllExport.h"
+
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+namespace PulseEngine::Threading
+{
+    class PULSE_ENGINE_DLL_API SimulationThread
+    {
+    public:
+        using Step = std::function<void()>;
+
+        explicit SimulationThread(Step step);
+        /**
+         * @brief Wait for the running step and join the thread.
+         */
+        ~SimulationThread();
+
+        SimulationThread(const SimulationThread&) = delete;
+        SimulationThread& operator=(const SimulationThread&) = delete;
+
+        /**
+         * @brief Start one step on the thread and return. The last step must have been waited.
+         */
+        void Kick();
+
+        /**
+         * @brief Block until the last kicked step is done, returns at once when none runs.
+         */
+        void Wait();
+
+    private:
+        void Loop();
+
+        Step step;
+        std::thread thread;
+        std::mutex mutex;
+        std::condition_variable kicked;
+        std::condition_variable done;
+        bool running = false;
+        bool stopping = false;
+    };
+}
+
+#endif // SIMULATIONTHREAD_H
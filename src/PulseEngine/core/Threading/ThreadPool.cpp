@@ -0,0 +1,127 @@
+#include "ThreadPool.h"
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+
+using namespace PulseEngine::Threading;
+
+ThreadPool& ThreadPool::GetInstance()
+{
+    // the main thread keeps one core
+    static ThreadPool instance(std::max(2u, std::thread::hardware_concurrency()) - 1);
+    return instance;
+}
+
+ThreadPool::ThreadPool(std::size_t workerCount)
+{
+    workers.reserve(workerCount);
+    for (std::size_t i = 0; i < workerCount; ++i)
+        workers.emplace_back(&ThreadPool::WorkerLoop, this);
+}
+
+ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+        std::queue<Job>().swap(jobs);
+    }
+    jobAvailable.notify_all();
+    for (std::thread& worker : workers)
+        worker.join();
+}
+
+void ThreadPool::Submit(Job job)
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        jobs.push(std::move(job));
+    }
+    jobAvailable.notify_one();
+}
+
+void ThreadPool::WaitIdle()
+{
+    std::unique_lock<std::mutex> lock(mutex);
+    idle.wait(lock, [this] { return jobs.empty() && runningJobs == 0; });
+}
+
+void ThreadPool::ParallelFor(std::size_t count, const std::function<void(std::size_t)>& job, std::size_t grain)
+{
+    if (count == 0) return;
+    grain = std::max<std::size_t>(grain, 1);
+    const std::size_t chunks = (count + grain - 1) / grain;
+    if (chunks == 1 || workers.empty())
+    {
+        for (std::size_t i = 0; i < count; ++i) job(i);
+        return;
+    }
+
+    // shared : a worker that starts after the loop is over only reads the counters and leaves
+    struct Loop
+    {
+        std::atomic<std::size_t> next{0};
+        std::atomic<std::size_t> done{0};
+        std::size_t count = 0;
+        std::size_t grain = 1;
+        const std::function<void(std::size_t)>* job = nullptr;
+        std::mutex mutex;
+        std::condition_variable finished;
+    };
+    auto loop = std::make_shared<Loop>();
+    loop->count = count;
+    loop->grain = grain;
+    loop->job = &job;
+
+    auto run = [](Loop& state)
+    {
+        while (true)
+        {
+            const std::size_t first = state.next.fetch_add(state.grain);
+            if (first >= state.count) return;
+            const std::size_t last = std::min(first + state.grain, state.count);
+            for (std::size_t i = first; i < last; ++i) (*state.job)(i);
+
+            if (state.done.fetch_add(last - first) + (last - first) == state.count)
+            {
+                { std::lock_guard<std::mutex> lock(state.mutex); }
+                state.finished.notify_all();
+            }
+        }
+    };
+
+    const std::size_t helpers = std::min(workers.size(), chunks - 1);
+    for (std::size_t i = 0; i < helpers; ++i)
+        Submit([loop, run]() { run(*loop); });
+
+    run(*loop);
+
+    std::unique_lock<std::mutex> lock(loop->mutex);
+    loop->finished.wait(lock, [&loop] { return loop->done.load() == loop->count; });
+}
+
+void ThreadPool::WorkerLoop()
+{
+    while (true)
+    {
+        Job job;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            jobAvailable.wait(lock, [this] { return stopping || !jobs.empty(); });
+            if (stopping) return;
+
+            job = std::move(jobs.front());
+            jobs.pop();
+            ++runningJobs;
+        }
+
+        job();
+
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            --runningJobs;
+            if (jobs.empty() && runningJobs == 0) idle.notify_all();
+        }
+    }
+}
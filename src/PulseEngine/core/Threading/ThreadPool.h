@@ -0,0 +1,77 @@
+/**
+ * @file ThreadPool.h
+ * @brief Fixed pool of worker threads running fire-and-forget jobs (asset decoding, loading...).
+ * @details Jobs run in submission order, on any worker. They must not touch the graphic API :
+ * results meant for the GPU are handed back to the main thread (see TextureManager::ProcessPendingUploads).
+ * Physics keeps its own Jolt job system.
+ * @version 0.1
+ * @date 2025-12-08
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+#ifndef THREADPOOL_H
+#define THREADPOOL_H
+
+#include "Common/dllExport.h"
+
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
+
+namespace PulseEngine::Threading
+{
+    class PULSE_ENGINE_DLL_API ThreadPool
+    {
+    public:
+        using Job = std::function<void()>;
+
+        /**
+         * @brief Pool shared by the engine systems, hardware_concurrency - 1 workers (at least one).
+         */
+        static ThreadPool& GetInstance();
+
+        explicit ThreadPool(std::size_t workerCount);
+        /**
+         * @brief Finish the running jobs, the ones still queued are dropped.
+         */
+        ~ThreadPool();
+
+        ThreadPool(const ThreadPool&) = delete;
+        ThreadPool& operator=(const ThreadPool&) = delete;
+
+        void Submit(Job job);
+
+        /**
+         * @brief Block until the queue is empty and every worker is idle.
+         */
+        void WaitIdle();
+
+        /**
+         * @brief Run job(i) for every i of [0, count), grain at a time, on the workers and the calling thread. Returns
+         * once they are all done.
+         * @details The calling thread takes its share too : jobs queued before (a texture decode) delay the workers,
+         * not the loop. Not to be called from a job, and job must not touch the graphic API.
+         */
+        void ParallelFor(std::size_t count, const std::function<void(std::size_t)>& job, std::size_t grain = 1);
+
+        std::size_t GetWorkerCount() const { return workers.size(); }
+
+    private:
+        void WorkerLoop();
+
+        std::vector<std::thread> workers;
+        std::queue<Job> jobs;
+        std::mutex mutex;
+        std::condition_variable jobAvailable;
+        std::condition_variable idle;
+        std::size_t runningJobs = 0;
+        bool stopping = false;
+    };
+}
+
+#endif // THREADPOOL_H
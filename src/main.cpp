@@ -21,6 +21,7 @@
 
 #include <vector>
 #include <cmath>
+#include <cstdint>
 #include <cstdlib>
 #include <string>
 #include <iostream>
@@ -33,11 +34,26 @@ namespace fs = std::filesystem;
 int main(int argc, char **argv)
 {
     std::string workingDir;
+    std::string projectArg;
+
+    // --headless : no window nor GPU (NullGraphicsAPI), --frames=N : quit after N frames,
+    // --single-thread : the game simulates and draws on the main thread
+    bool headless = false;
+    bool singleThread = false;
+    std::uint64_t frameLimit = 0;
+    for (int i = 1; i < argc; ++i)
+    {
+        const std::string arg = argv[i];
+        if (arg == "--headless") headless = true;
+        else if (arg == "--single-thread") singleThread = true;
+        else if (arg.rfind("--frames=", 0) == 0) frameLimit = std::strtoull(arg.c_str() + 9, nullptr, 10);
+        else if (projectArg.empty()) projectArg = arg;
+    }
 
-    if (argc > 1)
+    if (!projectArg.empty())
     {
 #ifdef ENGINE_EDITOR
-        workingDir = argv[1];
+        workingDir = projectArg;
 #else
         workingDir = fs::current_path().string();
 #endif
@@ -55,6 +71,8 @@ int main(int argc, char **argv)
     EDITOR_INFO("Project dir : " << std::filesystem::current_path())
 
     PulseEngineBackend *engine = PulseEngineBackend::GetInstance();
+    engine->SetHeadless(headless, frameLimit);
+    engine->SetThreadedSimulation(!singleThread);
 
 // during the compilation of the game, some datas are defined in the preprocessor.
 // here, we get them and use them with the engine. (the dll didnt have them, so we need to set them manually)
@@ -85,9 +103,14 @@ int main(int argc, char **argv)
     }
 
 #ifdef ENGINE_EDITOR
-    InterfaceEditor *editor = new InterfaceEditor();
-    engine->editor = editor;
-    editor->InitAfterEngine();
+    // the editor UI draws with ImGui on the GL context, a headless run is the game loop only
+    InterfaceEditor *editor = nullptr;
+    if (!headless)
+    {
+        editor = new InterfaceEditor();
+        engine->editor = editor;
+        editor->InitAfterEngine();
+    }
 #endif
 
     // === Boucle de rendu ===
@@ -100,7 +123,7 @@ int main(int argc, char **argv)
         engine->Render();
 
 #ifdef ENGINE_EDITOR
-        editor->Render();
+        if (editor) editor->Render();
 #endif
 
         engine->graphicsAPI->SwapBuffers();
@@ -7,6 +7,8 @@ Shader::Shader(const std::string& vertexPath, const std::string& fragmentPath, I
 {
     // Charger et compiler les shaders
     graphics = graphicApi;
+    this->vertexPath = vertexPath;
+    this->fragmentPath = fragmentPath;
     EDITOR_LOG("Loading shader from: " << vertexPath << " and " << fragmentPath)
     shaderID = graphics->CreateShader(vertexPath, fragmentPath);
     EDITOR_LOG("Shader program linked with ID: " << shaderID)
@@ -15,12 +17,24 @@ Shader::Shader(const std::string& vertexPath, const std::string& fragmentPath, I
 Shader::Shader(const std::string &vertexPath, const std::string &fragmentPath, const std::string &geometryPath, IGraphicsAPI* graphicApi)
 {
     graphics = graphicApi;
+    this->vertexPath = vertexPath;
+    this->fragmentPath = fragmentPath;
     // Charger et compiler les shaders
     EDITOR_LOG("Loading shader from: " << vertexPath << " and " << fragmentPath)
     shaderID = graphics->CreateShader(vertexPath, fragmentPath, geometryPath);
     EDITOR_LOG("Shader program linked with ID: " << shaderID)
 }
 
+Shader::Shader(const std::string &vertexPath, const std::string &fragmentPath, IGraphicsAPI *graphicApi, const std::vector<std::string> &defines)
+{
+    graphics = graphicApi;
+    this->vertexPath = vertexPath;
+    this->fragmentPath = fragmentPath;
+    EDITOR_LOG("Loading shader variant from: " << vertexPath << " and " << fragmentPath)
+    shaderID = graphics->CreateShader(vertexPath, fragmentPath, defines);
+    EDITOR_LOG("Shader program linked with ID: " << shaderID)
+}
+
 Shader::~Shader()
 {
     // TODO : delete shader in the graphic API